@@ -0,0 +1,512 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Geometry>
+
+#include "kindr/Core"
+
+#ifdef KINDR_BENCHMARK_SOPHUS
+#include <sophus/interpolate.hpp>
+#include <sophus/se3.hpp>
+#include <sophus/so3.hpp>
+#endif
+
+#ifdef KINDR_BENCHMARK_MANIF
+#include <manif/manif.h>
+#endif
+
+/* Runs the same workloads with kindr, raw Eigen geometry and, if they were found by CMake, Sophus and manif, and prints
+ * the overhead of kindr relative to Eigen per workload after the benchmarks. The benchmarks are named
+ * <workload>/<library>. Workloads which a library does not provide, e.g. Euler angles in Sophus and manif, are omitted.
+ */
+
+namespace library_comparison {
+
+enum { NumVectors = 1000000, NumItems = 10000 };
+
+//! Random unit quaternions, tangent vectors and positions shared by all libraries
+struct Data {
+  std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> quaternions;
+  std::vector<Eigen::Vector3d> tangents;
+  std::vector<Eigen::Vector3d> translations;
+  Eigen::Matrix3Xd vectors;
+
+  Data() : vectors(Eigen::Matrix3Xd::Random(3, NumVectors)) {
+    std::mt19937 generator(42);
+    std::normal_distribution<double> normal;
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (int i = 0; i < NumItems; ++i) {
+      quaternions.push_back(Eigen::Quaterniond(normal(generator), normal(generator), normal(generator), normal(generator)).normalized());
+      tangents.push_back(Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator))*1.5);
+      translations.push_back(Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator)));
+    }
+  }
+
+  static const Data& get() {
+    static const Data data;
+    return data;
+  }
+};
+
+/* Rotation of 1M vectors, one call per vector
+ */
+
+static void rotateVectorsKindr(benchmark::State& state) {
+  const Data& data = Data::get();
+  const kindr::RotationQuaternionD rotation(data.quaternions[0]);
+  Eigen::Matrix3Xd rotated(3, NumVectors);
+  for (auto _ : state) {
+    for (int i = 0; i < NumVectors; ++i) {
+      rotated.col(i) = rotation.rotate(Eigen::Vector3d(data.vectors.col(i)));
+    }
+    benchmark::DoNotOptimize(rotated.data());
+  }
+  state.SetItemsProcessed(state.iterations()*NumVectors);
+}
+
+static void rotateVectorsEigen(benchmark::State& state) {
+  const Data& data = Data::get();
+  const Eigen::Quaterniond rotation = data.quaternions[0];
+  Eigen::Matrix3Xd rotated(3, NumVectors);
+  for (auto _ : state) {
+    for (int i = 0; i < NumVectors; ++i) {
+      rotated.col(i) = rotation*Eigen::Vector3d(data.vectors.col(i));
+    }
+    benchmark::DoNotOptimize(rotated.data());
+  }
+  state.SetItemsProcessed(state.iterations()*NumVectors);
+}
+
+/* Rotation of 1M vectors as a batch
+ */
+
+static void rotateBatchKindr(benchmark::State& state) {
+  const Data& data = Data::get();
+  const kindr::RotationQuaternionD rotation(data.quaternions[0]);
+  Eigen::Matrix3Xd rotated(3, NumVectors);
+  for (auto _ : state) {
+    rotation.rotateBatch(data.vectors, rotated);
+    benchmark::DoNotOptimize(rotated.data());
+  }
+  state.SetItemsProcessed(state.iterations()*NumVectors);
+}
+
+static void rotateBatchEigen(benchmark::State& state) {
+  const Data& data = Data::get();
+  const Eigen::Quaterniond rotation = data.quaternions[0];
+  Eigen::Matrix3Xd rotated(3, NumVectors);
+  for (auto _ : state) {
+    rotated.noalias() = rotation.toRotationMatrix()*data.vectors;
+    benchmark::DoNotOptimize(rotated.data());
+  }
+  state.SetItemsProcessed(state.iterations()*NumVectors);
+}
+
+/* Concatenation of 10k poses
+ */
+
+static void composePosesKindr(benchmark::State& state) {
+  const Data& data = Data::get();
+  kindr::AlignedVector<kindr::HomTransformQuatD> poses;
+  for (int i = 0; i < NumItems; ++i) {
+    poses.push_back(kindr::HomTransformQuatD(kindr::Position3D(data.translations[i]), kindr::RotationQuaternionD(data.quaternions[i])));
+  }
+  for (auto _ : state) {
+    kindr::HomTransformQuatD pose;
+    for (int i = 0; i < NumItems; ++i) {
+      pose *= poses[i];
+    }
+    benchmark::DoNotOptimize(pose);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+static void composePosesEigen(benchmark::State& state) {
+  const Data& data = Data::get();
+  std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> poses;
+  for (int i = 0; i < NumItems; ++i) {
+    Eigen::Isometry3d pose(data.quaternions[i]);
+    pose.translation() = data.translations[i];
+    poses.push_back(pose);
+  }
+  for (auto _ : state) {
+    Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+    for (int i = 0; i < NumItems; ++i) {
+      pose = pose*poses[i];
+    }
+    benchmark::DoNotOptimize(pose);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+/* Exponential and logarithmic map of SO(3) of 10k tangent vectors
+ */
+
+static void expLogKindr(benchmark::State& state) {
+  const Data& data = Data::get();
+  for (auto _ : state) {
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    kindr::RotationQuaternionD rotation;
+    for (int i = 0; i < NumItems; ++i) {
+      sum += rotation.exponentialMap(data.tangents[i]).logarithmicMap();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+static void expLogEigen(benchmark::State& state) {
+  const Data& data = Data::get();
+  for (auto _ : state) {
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    for (int i = 0; i < NumItems; ++i) {
+      const double angle = data.tangents[i].norm();
+      const Eigen::Quaterniond rotation = (angle < 1e-12) ? Eigen::Quaterniond::Identity()
+                                                           : Eigen::Quaterniond(Eigen::AngleAxisd(angle, data.tangents[i]/angle));
+      const Eigen::AngleAxisd angleAxis(rotation);
+      sum += angleAxis.angle()*angleAxis.axis();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+/* Spherical linear interpolation between 10k pairs of rotations
+ */
+
+static void interpolateKindr(benchmark::State& state) {
+  const Data& data = Data::get();
+  kindr::AlignedVector<kindr::RotationQuaternionD> rotations(data.quaternions.begin(), data.quaternions.end());
+  for (auto _ : state) {
+    Eigen::Vector4d sum = Eigen::Vector4d::Zero();
+    for (int i = 0; i + 1 < NumItems; ++i) {
+      sum += kindr::slerp(rotations[i], rotations[i + 1], 0.3).vector();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*(NumItems - 1));
+}
+
+static void interpolateEigen(benchmark::State& state) {
+  const Data& data = Data::get();
+  for (auto _ : state) {
+    Eigen::Vector4d sum = Eigen::Vector4d::Zero();
+    for (int i = 0; i + 1 < NumItems; ++i) {
+      sum += data.quaternions[i].slerp(0.3, data.quaternions[i + 1]).coeffs();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*(NumItems - 1));
+}
+
+/* Conversion of 10k rotations to ZYX Euler angles and back
+ */
+
+static void eulerConversionKindr(benchmark::State& state) {
+  const Data& data = Data::get();
+  kindr::AlignedVector<kindr::RotationQuaternionD> rotations(data.quaternions.begin(), data.quaternions.end());
+  for (auto _ : state) {
+    Eigen::Vector4d sum = Eigen::Vector4d::Zero();
+    for (int i = 0; i < NumItems; ++i) {
+      const kindr::EulerAnglesZyxD eulerAngles(rotations[i]);
+      sum += kindr::RotationQuaternionD(eulerAngles).vector();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+static void eulerConversionEigen(benchmark::State& state) {
+  const Data& data = Data::get();
+  for (auto _ : state) {
+    Eigen::Vector4d sum = Eigen::Vector4d::Zero();
+    for (int i = 0; i < NumItems; ++i) {
+      const Eigen::Vector3d eulerAngles = data.quaternions[i].toRotationMatrix().eulerAngles(2, 1, 0);
+      const Eigen::Quaterniond rotation = Eigen::AngleAxisd(eulerAngles(0), Eigen::Vector3d::UnitZ())
+          *Eigen::AngleAxisd(eulerAngles(1), Eigen::Vector3d::UnitY())*Eigen::AngleAxisd(eulerAngles(2), Eigen::Vector3d::UnitX());
+      sum += rotation.coeffs();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+#ifdef KINDR_BENCHMARK_SOPHUS
+
+static void rotateVectorsSophus(benchmark::State& state) {
+  const Data& data = Data::get();
+  const Sophus::SO3d rotation(data.quaternions[0]);
+  Eigen::Matrix3Xd rotated(3, NumVectors);
+  for (auto _ : state) {
+    for (int i = 0; i < NumVectors; ++i) {
+      rotated.col(i) = rotation*Eigen::Vector3d(data.vectors.col(i));
+    }
+    benchmark::DoNotOptimize(rotated.data());
+  }
+  state.SetItemsProcessed(state.iterations()*NumVectors);
+}
+
+static void rotateBatchSophus(benchmark::State& state) {
+  const Data& data = Data::get();
+  const Sophus::SO3d rotation(data.quaternions[0]);
+  Eigen::Matrix3Xd rotated(3, NumVectors);
+  for (auto _ : state) {
+    rotated.noalias() = rotation.matrix()*data.vectors;
+    benchmark::DoNotOptimize(rotated.data());
+  }
+  state.SetItemsProcessed(state.iterations()*NumVectors);
+}
+
+static void composePosesSophus(benchmark::State& state) {
+  const Data& data = Data::get();
+  std::vector<Sophus::SE3d, Eigen::aligned_allocator<Sophus::SE3d>> poses;
+  for (int i = 0; i < NumItems; ++i) {
+    poses.push_back(Sophus::SE3d(data.quaternions[i], data.translations[i]));
+  }
+  for (auto _ : state) {
+    Sophus::SE3d pose;
+    for (int i = 0; i < NumItems; ++i) {
+      pose = pose*poses[i];
+    }
+    benchmark::DoNotOptimize(pose);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+static void expLogSophus(benchmark::State& state) {
+  const Data& data = Data::get();
+  for (auto _ : state) {
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    for (int i = 0; i < NumItems; ++i) {
+      sum += Sophus::SO3d::exp(data.tangents[i]).log();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+static void interpolateSophus(benchmark::State& state) {
+  const Data& data = Data::get();
+  std::vector<Sophus::SO3d, Eigen::aligned_allocator<Sophus::SO3d>> rotations(data.quaternions.begin(), data.quaternions.end());
+  for (auto _ : state) {
+    Eigen::Vector4d sum = Eigen::Vector4d::Zero();
+    for (int i = 0; i + 1 < NumItems; ++i) {
+      sum += Sophus::interpolate(rotations[i], rotations[i + 1], 0.3).unit_quaternion().coeffs();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*(NumItems - 1));
+}
+
+#endif
+
+#ifdef KINDR_BENCHMARK_MANIF
+
+static void rotateVectorsManif(benchmark::State& state) {
+  const Data& data = Data::get();
+  const manif::SO3d rotation(data.quaternions[0]);
+  Eigen::Matrix3Xd rotated(3, NumVectors);
+  for (auto _ : state) {
+    for (int i = 0; i < NumVectors; ++i) {
+      rotated.col(i) = rotation.act(Eigen::Vector3d(data.vectors.col(i)));
+    }
+    benchmark::DoNotOptimize(rotated.data());
+  }
+  state.SetItemsProcessed(state.iterations()*NumVectors);
+}
+
+static void rotateBatchManif(benchmark::State& state) {
+  const Data& data = Data::get();
+  const manif::SO3d rotation(data.quaternions[0]);
+  Eigen::Matrix3Xd rotated(3, NumVectors);
+  for (auto _ : state) {
+    rotated.noalias() = rotation.rotation()*data.vectors;
+    benchmark::DoNotOptimize(rotated.data());
+  }
+  state.SetItemsProcessed(state.iterations()*NumVectors);
+}
+
+static void composePosesManif(benchmark::State& state) {
+  const Data& data = Data::get();
+  std::vector<manif::SE3d, Eigen::aligned_allocator<manif::SE3d>> poses;
+  for (int i = 0; i < NumItems; ++i) {
+    poses.push_back(manif::SE3d(data.translations[i], data.quaternions[i]));
+  }
+  for (auto _ : state) {
+    manif::SE3d pose = manif::SE3d::Identity();
+    for (int i = 0; i < NumItems; ++i) {
+      pose = pose*poses[i];
+    }
+    benchmark::DoNotOptimize(pose);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+static void expLogManif(benchmark::State& state) {
+  const Data& data = Data::get();
+  for (auto _ : state) {
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    for (int i = 0; i < NumItems; ++i) {
+      sum += manif::SO3Tangentd(data.tangents[i]).exp().log().coeffs();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*NumItems);
+}
+
+static void interpolateManif(benchmark::State& state) {
+  const Data& data = Data::get();
+  std::vector<manif::SO3d, Eigen::aligned_allocator<manif::SO3d>> rotations;
+  for (int i = 0; i < NumItems; ++i) {
+    rotations.push_back(manif::SO3d(data.quaternions[i]));
+  }
+  for (auto _ : state) {
+    Eigen::Vector4d sum = Eigen::Vector4d::Zero();
+    for (int i = 0; i + 1 < NumItems; ++i) {
+      // q0*exp(t*log(q0^-1*q1))
+      sum += (rotations[i] + (rotations[i + 1] - rotations[i])*0.3).coeffs();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations()*(NumItems - 1));
+}
+
+#endif
+
+/*! \brief Prints the results like the console reporter and, at the end, the time of every library per workload and
+ *  the overhead of kindr relative to Eigen. The fastest of repeated runs is used.
+ */
+class OverheadReporter : public benchmark::ConsoleReporter {
+ public:
+  void ReportRuns(const std::vector<Run>& reports) override {
+    benchmark::ConsoleReporter::ReportRuns(reports);
+    for (const Run& run : reports) {
+      if (run.run_type != Run::RT_Iteration || run.error_occurred) {
+        continue;
+      }
+      const std::string name = run.benchmark_name();
+      const std::string::size_type separator = name.find('/');
+      if (separator == std::string::npos) {
+        continue;
+      }
+      const std::string workload = name.substr(0, separator);
+      const std::string library = name.substr(separator + 1, name.find('/', separator + 1) - separator - 1);
+      if (std::find(workloads_.begin(), workloads_.end(), workload) == workloads_.end()) {
+        workloads_.push_back(workload);
+      }
+      const double time = run.GetAdjustedCPUTime();
+      std::map<std::string, double>& times = times_[workload];
+      times[library] = times.count(library) ? std::min(times[library], time) : time;
+    }
+  }
+
+  void Finalize() override {
+    benchmark::ConsoleReporter::Finalize();
+    const char* libraries[] = {"kindr", "eigen", "sophus", "manif"};
+    std::printf("\nCPU time per iteration [us] and overhead of kindr relative to Eigen\n");
+    std::printf("%-18s", "workload");
+    for (const char* library : libraries) {
+      std::printf("%12s", library);
+    }
+    std::printf("%12s\n", "overhead");
+    for (const std::string& workload : workloads_) {
+      std::map<std::string, double>& times = times_[workload];
+      std::printf("%-18s", workload.c_str());
+      for (const char* library : libraries) {
+        if (times.count(library)) {
+          std::printf("%12.1f", times[library]);
+        } else {
+          std::printf("%12s", "-");
+        }
+      }
+      if (times.count("kindr") && times.count("eigen")) {
+        std::printf("%+11.1f%%\n", 100.0*(times["kindr"]/times["eigen"] - 1.0));
+      } else {
+        std::printf("%12s\n", "-");
+      }
+    }
+  }
+
+ private:
+  std::vector<std::string> workloads_;
+  std::map<std::string, std::map<std::string, double>> times_;
+};
+
+static void registerBenchmark(const char* name, void (*function)(benchmark::State&)) {
+  benchmark::RegisterBenchmark(name, function)->Unit(benchmark::kMicrosecond);
+}
+
+} // namespace library_comparison
+
+int main(int argc, char** argv) {
+  using namespace library_comparison;
+  registerBenchmark("rotateVectors/kindr", rotateVectorsKindr);
+  registerBenchmark("rotateVectors/eigen", rotateVectorsEigen);
+  registerBenchmark("rotateBatch/kindr", rotateBatchKindr);
+  registerBenchmark("rotateBatch/eigen", rotateBatchEigen);
+  registerBenchmark("composePoses/kindr", composePosesKindr);
+  registerBenchmark("composePoses/eigen", composePosesEigen);
+  registerBenchmark("expLog/kindr", expLogKindr);
+  registerBenchmark("expLog/eigen", expLogEigen);
+  registerBenchmark("interpolate/kindr", interpolateKindr);
+  registerBenchmark("interpolate/eigen", interpolateEigen);
+  registerBenchmark("eulerConversion/kindr", eulerConversionKindr);
+  registerBenchmark("eulerConversion/eigen", eulerConversionEigen);
+#ifdef KINDR_BENCHMARK_SOPHUS
+  registerBenchmark("rotateVectors/sophus", rotateVectorsSophus);
+  registerBenchmark("rotateBatch/sophus", rotateBatchSophus);
+  registerBenchmark("composePoses/sophus", composePosesSophus);
+  registerBenchmark("expLog/sophus", expLogSophus);
+  registerBenchmark("interpolate/sophus", interpolateSophus);
+#endif
+#ifdef KINDR_BENCHMARK_MANIF
+  registerBenchmark("rotateVectors/manif", rotateVectorsManif);
+  registerBenchmark("rotateBatch/manif", rotateBatchManif);
+  registerBenchmark("composePoses/manif", composePosesManif);
+  registerBenchmark("expLog/manif", expLogManif);
+  registerBenchmark("interpolate/manif", interpolateManif);
+#endif
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  OverheadReporter reporter;
+  benchmark::RunSpecifiedBenchmarks(&reporter);
+  benchmark::Shutdown();
+  return 0;
+}
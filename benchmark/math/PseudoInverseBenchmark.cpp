@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <benchmark/benchmark.h>
+
+#include "kindr/math/LinearAlgebra.hpp"
+
+/* Measures the pseudoinverse of contact Jacobians. The dynamic size version allocates in every call, the workspace
+ * versions reuse their decomposition and do not allocate for fixed sizes.
+ */
+
+template <typename Matrix_>
+static Matrix_ getBenchmarkJacobian() {
+  Matrix_ jacobian;
+  for (int i = 0; i < jacobian.rows(); ++i) {
+    for (int j = 0; j < jacobian.cols(); ++j) {
+      jacobian(i, j) = std::sin(1.0 + 0.7*i + 1.3*j*j) + (i == j ? 1.0 : 0.0);
+    }
+  }
+  return jacobian;
+}
+
+template <typename Matrix_>
+static void pseudoInverseDynamic(benchmark::State& state) {
+  Eigen::MatrixXd jacobian = getBenchmarkJacobian<Matrix_>();
+  Eigen::MatrixXd result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(jacobian.data());
+    kindr::pseudoInverse(jacobian, result);
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+
+template <typename Matrix_, kindr::PseudoInverseMethod Method_>
+static void pseudoInverseWorkspace(benchmark::State& state) {
+  Matrix_ jacobian = getBenchmarkJacobian<Matrix_>();
+  Eigen::Matrix<double, Matrix_::ColsAtCompileTime, Matrix_::RowsAtCompileTime> result;
+  kindr::PseudoInverseWorkspace<Matrix_, Method_> workspace;
+  workspace.setDamping(1e-3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(jacobian);
+    workspace.compute(jacobian, result);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+typedef Eigen::Matrix<double, 3, 6> Matrix36;
+typedef Eigen::Matrix<double, 6, 12> Matrix612;
+
+BENCHMARK_TEMPLATE(pseudoInverseDynamic, Matrix36);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Matrix36, kindr::PseudoInverseMethod::JacobiSvd);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Matrix36, kindr::PseudoInverseMethod::CompleteOrthogonalDecomposition);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Matrix36, kindr::PseudoInverseMethod::ClosedForm);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Matrix36, kindr::PseudoInverseMethod::DampedLeastSquares);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Eigen::Matrix3d, kindr::PseudoInverseMethod::ClosedForm);
+BENCHMARK_TEMPLATE(pseudoInverseDynamic, Matrix612);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Matrix612, kindr::PseudoInverseMethod::JacobiSvd);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Matrix612, kindr::PseudoInverseMethod::CompleteOrthogonalDecomposition);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Matrix612, kindr::PseudoInverseMethod::ClosedForm);
+BENCHMARK_TEMPLATE(pseudoInverseWorkspace, Matrix612, kindr::PseudoInverseMethod::DampedLeastSquares);
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/phys_quant/PointKinematics.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+
+/* Transports the velocity and acceleration of a body to state.range(0) moving points, once per point with the
+ * operators of Vector and once in a batch.
+ */
+
+template <typename Scalar_>
+struct PointKinematicsData {
+  kindr::Velocity<Scalar_, 3> velocity = kindr::Velocity<Scalar_, 3>(0.4, -1.2, 0.3);
+  kindr::Acceleration<Scalar_, 3> acceleration = kindr::Acceleration<Scalar_, 3>(-0.5, 0.2, 9.81);
+  kindr::LocalAngularVelocity<Scalar_> angularVelocity = kindr::LocalAngularVelocity<Scalar_>(0.7, -0.2, 1.1);
+  kindr::AngularAcceleration<Scalar_, 3> angularAcceleration = kindr::AngularAcceleration<Scalar_, 3>(-0.3, 0.8, 0.1);
+  kindr::PositionArray<Scalar_> positions;
+  kindr::VelocityArray<Scalar_> relativeVelocities;
+  kindr::AccelerationArray<Scalar_> relativeAccelerations;
+
+  explicit PointKinematicsData(int size) {
+    positions.toImplementation().setRandom(3, size);
+    relativeVelocities.toImplementation().setRandom(3, size);
+    relativeAccelerations.toImplementation().setRandom(3, size);
+  }
+};
+
+template <typename Scalar_>
+static void transportPointKinematicsLoop(benchmark::State& state) {
+  typedef kindr::Velocity<Scalar_, 3> Velocity;
+  typedef kindr::Acceleration<Scalar_, 3> Acceleration;
+  const PointKinematicsData<Scalar_> data(state.range(0));
+  const std::vector<kindr::Position<Scalar_, 3>> positions = data.positions.toStdVector();
+  const std::vector<Velocity> relativeVelocities = data.relativeVelocities.toStdVector();
+  const std::vector<Acceleration> relativeAccelerations = data.relativeAccelerations.toStdVector();
+  const auto w = data.angularVelocity.toImplementation();
+  const auto dw = data.angularAcceleration.toImplementation();
+  std::vector<Velocity> velocities(positions.size());
+  std::vector<Acceleration> accelerations(positions.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < positions.size(); ++i) {
+      const auto& r = positions[i].toImplementation();
+      const Velocity rotational(w.cross(r));
+      velocities[i] = data.velocity + rotational + relativeVelocities[i];
+      accelerations[i] = data.acceleration + Acceleration(dw.cross(r)) + Acceleration(w.cross(rotational.toImplementation()))
+          + Acceleration(2*w.cross(relativeVelocities[i].toImplementation())) + relativeAccelerations[i];
+    }
+    benchmark::DoNotOptimize(velocities.data());
+    benchmark::DoNotOptimize(accelerations.data());
+  }
+}
+
+template <typename Scalar_>
+static void transportPointKinematics(benchmark::State& state) {
+  const PointKinematicsData<Scalar_> data(state.range(0));
+  kindr::VelocityArray<Scalar_> velocities;
+  kindr::AccelerationArray<Scalar_> accelerations;
+  for (auto _ : state) {
+    kindr::transportVelocities(data.velocity, data.angularVelocity, data.positions, data.relativeVelocities, velocities);
+    kindr::transportAccelerations(data.acceleration, data.angularVelocity, data.angularAcceleration, data.positions,
+                                  data.relativeVelocities, data.relativeAccelerations, accelerations);
+    benchmark::DoNotOptimize(velocities.toImplementation().data());
+    benchmark::DoNotOptimize(accelerations.toImplementation().data());
+  }
+}
+
+BENCHMARK_TEMPLATE(transportPointKinematicsLoop, double)->Arg(4)->Arg(16)->Arg(1000);
+BENCHMARK_TEMPLATE(transportPointKinematics, double)->Arg(4)->Arg(16)->Arg(1000);
+BENCHMARK_TEMPLATE(transportPointKinematicsLoop, float)->Arg(4)->Arg(16)->Arg(1000);
+BENCHMARK_TEMPLATE(transportPointKinematics, float)->Arg(4)->Arg(16)->Arg(1000);
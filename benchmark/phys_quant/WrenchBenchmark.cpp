@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/phys_quant/WrenchArray.hpp"
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/SpatialAlgebra.hpp"
+
+/* Transforms the wrenches of state.range(0) contacts to the base frame and sums them, once per contact with the
+ * single wrenches and once in a batch.
+ */
+
+template <typename Scalar_>
+static void setBenchmarkContacts(int size, kindr::PositionArray<Scalar_>& positions, kindr::RotationQuaternionArray<Scalar_>& rotations,
+                                 kindr::WrenchArray<Scalar_>& wrenches) {
+  positions.toImplementation().setRandom(3, size);
+  rotations.resize(size);
+  for (int i = 0; i < size; ++i) {
+    rotations.set(i, kindr::RotationQuaternion<Scalar_>().setRandom());
+  }
+  wrenches.resize(size);
+  wrenches.getForces().toImplementation().setRandom();
+  wrenches.getTorques().toImplementation().setRandom();
+}
+
+template <typename Scalar_>
+static void transformContactWrenchesLoop(benchmark::State& state) {
+  typedef kindr::HomTransformQuat<Scalar_> Pose;
+  kindr::PositionArray<Scalar_> positions;
+  kindr::RotationQuaternionArray<Scalar_> rotations;
+  kindr::WrenchArray<Scalar_> wrenches;
+  setBenchmarkContacts(state.range(0), positions, rotations, wrenches);
+  std::vector<Pose> poses;
+  std::vector<kindr::Wrench6<Scalar_>> contactWrenches, baseWrenches(state.range(0));
+  for (int i = 0; i < state.range(0); ++i) {
+    poses.push_back(Pose(typename Pose::Position(positions[i]), rotations[i]));
+    contactWrenches.push_back(wrenches[i]);
+  }
+  kindr::Wrench6<Scalar_> netWrench;
+  for (auto _ : state) {
+    netWrench.setZero();
+    for (size_t i = 0; i < poses.size(); ++i) {
+      baseWrenches[i] = kindr::transformWrench(poses[i], contactWrenches[i]);
+      netWrench += baseWrenches[i];
+    }
+    benchmark::DoNotOptimize(baseWrenches.data());
+    benchmark::DoNotOptimize(netWrench);
+  }
+}
+
+template <typename Scalar_>
+static void transformContactWrenches(benchmark::State& state) {
+  kindr::PositionArray<Scalar_> positions;
+  kindr::RotationQuaternionArray<Scalar_> rotations;
+  kindr::WrenchArray<Scalar_> contactWrenches, baseWrenches;
+  setBenchmarkContacts(state.range(0), positions, rotations, contactWrenches);
+  kindr::Wrench6<Scalar_> netWrench;
+  for (auto _ : state) {
+    netWrench = kindr::transformContactWrenches(positions, rotations, contactWrenches, baseWrenches);
+    benchmark::DoNotOptimize(baseWrenches.getForces().toImplementation().data());
+    benchmark::DoNotOptimize(netWrench);
+  }
+}
+
+BENCHMARK_TEMPLATE(transformContactWrenchesLoop, double)->Arg(4)->Arg(8);
+BENCHMARK_TEMPLATE(transformContactWrenches, double)->Arg(4)->Arg(8);
+BENCHMARK_TEMPLATE(transformContactWrenchesLoop, float)->Arg(4)->Arg(8);
+BENCHMARK_TEMPLATE(transformContactWrenches, float)->Arg(4)->Arg(8);
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <benchmark/benchmark.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/PoseCovariance.hpp"
+
+/* Compares the covariance propagation of PoseCovariance.hpp and RotationCovariance.hpp with the dense sandwich
+ * products A*P*A^T, for a single covariance and for batches of uncertain landmarks.
+ */
+
+template <typename Scalar_, int Size_>
+static Eigen::Matrix<Scalar_, Size_, Size_> getBenchmarkCovariance() {
+  typedef Eigen::Matrix<Scalar_, Size_, Size_> Matrix;
+  const Matrix factor = Matrix::Random();
+  return factor*factor.transpose() + Scalar_(0.1)*Matrix::Identity();
+}
+
+template <typename Pose_>
+static Pose_ getBenchmarkPose() {
+  typedef typename Pose_::Scalar Scalar;
+  return Pose_(typename Pose_::Position(1.0, -0.5, 0.2), typename Pose_::Rotation(kindr::EulerAnglesZyx<Scalar>(0.3, -0.2, 0.5)));
+}
+
+template <typename Rotation_>
+static void rotateCovarianceDense(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  Rotation_ rotation(kindr::EulerAnglesZyx<Scalar>(0.3, -0.2, 0.5));
+  Matrix3 covariance = getBenchmarkCovariance<Scalar, 3>();
+  Matrix3 result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    benchmark::DoNotOptimize(covariance);
+    const Matrix3 rotationMatrix = kindr::RotationMatrix<Scalar>(rotation).matrix();
+    result.noalias() = rotationMatrix*covariance*rotationMatrix.transpose();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Rotation_>
+static void rotateCovariance(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  Rotation_ rotation(kindr::EulerAnglesZyx<Scalar>(0.3, -0.2, 0.5));
+  Matrix3 covariance = getBenchmarkCovariance<Scalar, 3>();
+  Matrix3 result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    benchmark::DoNotOptimize(covariance);
+    result = kindr::getRotatedCovariance(rotation, covariance);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void transformCovarianceDense(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 6, 6> Matrix6;
+  Pose_ pose = getBenchmarkPose<Pose_>();
+  Matrix6 covariance = getBenchmarkCovariance<Scalar, 6>();
+  Matrix6 result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    benchmark::DoNotOptimize(covariance);
+    const Matrix6 adjoint = kindr::getAdjointMatrix(pose);
+    result.noalias() = adjoint*covariance*adjoint.transpose();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void transformCovariance(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 6, 6> Matrix6;
+  Pose_ pose = getBenchmarkPose<Pose_>();
+  Matrix6 covariance = getBenchmarkCovariance<Scalar, 6>();
+  Matrix6 result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    benchmark::DoNotOptimize(covariance);
+    result = kindr::getTransformedCovariance(pose, covariance);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void transformLandmarksLoop(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic, Eigen::RowMajor> Matrix3X;
+  typedef Eigen::Matrix<Scalar, 6, Eigen::Dynamic, Eigen::RowMajor> Matrix6X;
+  const Pose_ pose = getBenchmarkPose<Pose_>();
+  const Eigen::Matrix<Scalar, 6, 6> covariance = getBenchmarkCovariance<Scalar, 6>();
+  const Matrix3X positions = Matrix3X::Random(3, state.range(0));
+  Matrix6X positionCovariances(6, state.range(0));
+  for (int i = 0; i < positionCovariances.cols(); ++i) {
+    positionCovariances.col(i) = kindr::packCovariance(getBenchmarkCovariance<Scalar, 3>());
+  }
+  Matrix3X transformedPositions(3, state.range(0));
+  Matrix6X transformedCovariances(6, state.range(0));
+  for (auto _ : state) {
+    for (int i = 0; i < positions.cols(); ++i) {
+      const Eigen::Matrix<Scalar, 3, 1> position = positions.col(i);
+      transformedPositions.col(i) = pose.transform(typename Pose_::Position(position)).toImplementation();
+      transformedCovariances.col(i) = kindr::packCovariance(kindr::getTransformedPositionCovariance(
+          pose, covariance, position, kindr::unpackCovariance(positionCovariances.col(i))));
+    }
+    benchmark::DoNotOptimize(transformedCovariances.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Pose_>
+static void transformLandmarks(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic, Eigen::RowMajor> Matrix3X;
+  typedef Eigen::Matrix<Scalar, 6, Eigen::Dynamic, Eigen::RowMajor> Matrix6X;
+  const Pose_ pose = getBenchmarkPose<Pose_>();
+  const Eigen::Matrix<Scalar, 6, 6> covariance = getBenchmarkCovariance<Scalar, 6>();
+  const Matrix3X positions = Matrix3X::Random(3, state.range(0));
+  Matrix6X positionCovariances(6, state.range(0));
+  for (int i = 0; i < positionCovariances.cols(); ++i) {
+    positionCovariances.col(i) = kindr::packCovariance(getBenchmarkCovariance<Scalar, 3>());
+  }
+  Matrix3X transformedPositions(3, state.range(0));
+  Matrix6X transformedCovariances(6, state.range(0));
+  for (auto _ : state) {
+    kindr::transformPositionsWithCovariance(pose, covariance, positions, positionCovariances, transformedPositions, transformedCovariances);
+    benchmark::DoNotOptimize(transformedCovariances.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+BENCHMARK_TEMPLATE(rotateCovarianceDense, kindr::RotationQuaternionD);
+BENCHMARK_TEMPLATE(rotateCovariance, kindr::RotationQuaternionD);
+BENCHMARK_TEMPLATE(rotateCovarianceDense, kindr::RotationMatrixD);
+BENCHMARK_TEMPLATE(rotateCovariance, kindr::RotationMatrixD);
+BENCHMARK_TEMPLATE(transformCovarianceDense, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(transformCovariance, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(transformCovarianceDense, kindr::HomTransformMatrixD);
+BENCHMARK_TEMPLATE(transformCovariance, kindr::HomTransformMatrixD);
+BENCHMARK_TEMPLATE(transformLandmarksLoop, kindr::HomTransformQuatD)->Arg(10000);
+BENCHMARK_TEMPLATE(transformLandmarks, kindr::HomTransformQuatD)->Arg(10000);
+BENCHMARK_TEMPLATE(transformLandmarksLoop, kindr::HomTransformQuatF)->Arg(10000);
+BENCHMARK_TEMPLATE(transformLandmarks, kindr::HomTransformQuatF)->Arg(10000);
@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/PoseDiff.hpp"
+#include "kindr/phys_quant/Wrench.hpp"
+#include "kindr/poses/SpatialAlgebra.hpp"
+#include "kindr/poses/PoseGraph.hpp"
+#include "kindr/poses/PoseTrajectory.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+
+/* Measures the composition of homogeneous transformations, the transformation of positions and the change of frame of
+ * twists and wrenches, i.e. the rotation of both parts and the lever arm term due to the translation.
+ */
+
+template <typename Pose_>
+static Pose_ getBenchmarkPose(double x, double y, double z, double yaw, double pitch, double roll) {
+  typedef typename Pose_::Scalar Scalar;
+  return Pose_(typename Pose_::Position(x, y, z), typename Pose_::Rotation(kindr::EulerAnglesZyx<Scalar>(yaw, pitch, roll)));
+}
+
+template <typename Pose_>
+static void multiplyPoses(benchmark::State& state) {
+  Pose_ lhs = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  Pose_ rhs = getBenchmarkPose<Pose_>(-0.3, 0.8, 0.1, 0.2, 0.4, -0.1);
+  Pose_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    result = lhs*rhs;
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void transform(benchmark::State& state) {
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  typename Pose_::Position position(0.4, -0.1, 0.7);
+  typename Pose_::Position result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    benchmark::DoNotOptimize(position);
+    result = pose.transform(position);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void inverseTransform(benchmark::State& state) {
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  typename Pose_::Position position(0.4, -0.1, 0.7);
+  typename Pose_::Position result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    benchmark::DoNotOptimize(position);
+    result = pose.inverseTransform(position);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void getTransformationMatrix(benchmark::State& state) {
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  typename Pose_::TransformationMatrix result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    result = pose.getTransformationMatrix();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void transformPointsLoop(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Pose_::Scalar, 3, Eigen::Dynamic> Matrix3X;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  const Matrix3X positions = Matrix3X::Random(3, state.range(0));
+  Matrix3X result(3, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    for (int i = 0; i < positions.cols(); ++i) {
+      result.col(i) = pose.transform(typename Pose_::Position(positions.col(i))).toImplementation();
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Pose_>
+static void transformPoints(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Pose_::Scalar, 3, Eigen::Dynamic> Matrix3X;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  const Matrix3X positions = Matrix3X::Random(3, state.range(0));
+  Matrix3X result(3, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    pose.transform(positions, result);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Pose_>
+static void inverseTransformPoints(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Pose_::Scalar, 3, Eigen::Dynamic> Matrix3X;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  const Matrix3X positions = Matrix3X::Random(3, state.range(0));
+  Matrix3X result(3, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    pose.inverseTransform(positions, result);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Pose_>
+static void transformTwist(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> Twist;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  Twist twist(typename Twist::PositionDiff(0.4, -0.1, 0.7), typename Twist::RotationDiff(0.2, 0.3, -0.5));
+  Twist result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    benchmark::DoNotOptimize(twist);
+    const typename Twist::RotationDiff angularVelocity = pose.getRotation().rotate(twist.getRotationalVelocity());
+    result.getRotationalVelocity() = angularVelocity;
+    result.getTranslationalVelocity() = pose.getRotation().rotate(twist.getTranslationalVelocity())
+        + typename Twist::PositionDiff(pose.getPosition().toImplementation().cross(angularVelocity.toImplementation()));
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void transformWrench(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef kindr::Wrench6<Scalar> Wrench;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  Wrench wrench(typename Wrench::Force(4.0, -1.0, 7.0), typename Wrench::Torque(0.2, 0.3, -0.5));
+  Wrench result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    benchmark::DoNotOptimize(wrench);
+    const typename Wrench::Force force = pose.getRotation().rotate(wrench.getForce());
+    result.getForce() = force;
+    result.getTorque() = pose.getRotation().rotate(wrench.getTorque())
+        + typename Wrench::Torque(pose.getPosition().toImplementation().cross(force.toImplementation()));
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void concatenateChain(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  const int numJoints = 6;
+  std::vector<Pose_> links;
+  std::vector<Eigen::Matrix<Scalar, 3, 1>> axes;
+  for (int i = 0; i < numJoints; ++i) {
+    links.push_back(getBenchmarkPose<Pose_>(0.1*i, -0.2, 0.3, 0.3*i, -0.2, 0.1*i));
+    axes.push_back(Eigen::Matrix<Scalar, 3, 1>(0.2*i, 1.0, -0.5).normalized());
+  }
+  Eigen::Matrix<Scalar, 6, 1> jointPositions;
+  jointPositions.setLinSpaced(-1.2, 2.1);
+  Pose_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(jointPositions);
+    result.setIdentity();
+    for (int i = 0; i < numJoints; ++i) {
+      result = result*links[i]*Pose_(typename Pose_::Position(), typename Pose_::Rotation(kindr::AngleAxis<Scalar>(jointPositions(i), axes[i])));
+    }
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Scalar_>
+static kindr::KinematicChain<Scalar_, 6> getBenchmarkChain() {
+  kindr::KinematicChain<Scalar_, 6> chain;
+  for (int i = 0; i < 6; ++i) {
+    chain.setLink(i, getBenchmarkPose<kindr::HomTransformMatrix<Scalar_>>(0.1*i, -0.2, 0.3, 0.3*i, -0.2, 0.1*i),
+                  Eigen::Matrix<Scalar_, 3, 1>(0.2*i, 1.0, -0.5));
+  }
+  return chain;
+}
+
+template <typename Scalar_>
+static void evaluateKinematicChain(benchmark::State& state) {
+  kindr::KinematicChain<Scalar_, 6> chain = getBenchmarkChain<Scalar_>();
+  Eigen::Matrix<Scalar_, 6, 1> jointPositions;
+  jointPositions.setLinSpaced(-1.2, 2.1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(jointPositions);
+    chain.setJointPositions(jointPositions);
+    benchmark::DoNotOptimize(chain.getTranslation(5).data());
+  }
+}
+
+template <typename Scalar_>
+static void updateKinematicChainJoint(benchmark::State& state) {
+  kindr::KinematicChain<Scalar_, 6> chain = getBenchmarkChain<Scalar_>();
+  Scalar_ jointPosition = 0.3;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(jointPosition);
+    chain.setJointPosition(4, jointPosition);
+    benchmark::DoNotOptimize(chain.getTranslation(5).data());
+  }
+}
+
+BENCHMARK_TEMPLATE(concatenateChain, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(concatenateChain, kindr::HomTransformMatrixD);
+BENCHMARK_TEMPLATE(evaluateKinematicChain, double);
+BENCHMARK_TEMPLATE(updateKinematicChainJoint, double);
+BENCHMARK_TEMPLATE(concatenateChain, kindr::HomTransformQuatF);
+BENCHMARK_TEMPLATE(concatenateChain, kindr::HomTransformMatrixF);
+BENCHMARK_TEMPLATE(evaluateKinematicChain, float);
+BENCHMARK_TEMPLATE(updateKinematicChainJoint, float);
+
+template <typename Pose_>
+static Eigen::Matrix<typename Pose_::Scalar, 6, 6> getAdjointMatrix(const Pose_& pose) {
+  typedef typename Pose_::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 3> rotationMatrix = kindr::RotationMatrix<Scalar>(pose.getRotation()).matrix();
+  Eigen::Matrix<Scalar, 6, 6> adjoint = Eigen::Matrix<Scalar, 6, 6>::Zero();
+  adjoint.template topLeftCorner<3,3>() = rotationMatrix;
+  adjoint.template topRightCorner<3,3>() = kindr::getSkewMatrixFromVector(pose.getPosition().toImplementation())*rotationMatrix;
+  adjoint.template bottomRightCorner<3,3>() = rotationMatrix;
+  return adjoint;
+}
+
+template <typename Pose_>
+static void denseAdjointTwist(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  Eigen::Matrix<Scalar, 6, 1> twist;
+  twist << 0.4, -0.1, 0.7, 0.2, 0.3, -0.5;
+  Eigen::Matrix<Scalar, 6, 1> result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    benchmark::DoNotOptimize(twist);
+    result = getAdjointMatrix(pose)*twist;
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void spatialTransformTwist(benchmark::State& state) {
+  typedef kindr::TwistLinearVelocityLocalAngularVelocity<typename Pose_::Scalar> Twist;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  Twist twist(typename Twist::PositionDiff(0.4, -0.1, 0.7), typename Twist::RotationDiff(0.2, 0.3, -0.5));
+  Twist result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    benchmark::DoNotOptimize(twist);
+    result = kindr::transformTwist(pose, twist);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void denseAdjointTwists(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic> Matrix6X;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  const Matrix6X twists = Matrix6X::Random(6, state.range(0));
+  Matrix6X result(6, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    result.noalias() = getAdjointMatrix(pose)*twists;
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+
+template <typename Pose_>
+static void spatialTransformTwists(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic> Matrix6X;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  const Matrix6X twists = Matrix6X::Random(6, state.range(0));
+  Matrix6X result(6, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    kindr::transformTwists(pose, twists, result);
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+
+template <typename Rotation_>
+static void denseRotateJacobian(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 6, Eigen::Dynamic> Matrix6X;
+  const Rotation_ rotation(kindr::EulerAnglesZyx<Scalar>(0.3, -0.2, 0.5));
+  Matrix6X jacobian = Matrix6X::Random(6, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    Eigen::Matrix<Scalar, 6, 6> rotation6 = Eigen::Matrix<Scalar, 6, 6>::Zero();
+    rotation6.template topLeftCorner<3,3>() = kindr::RotationMatrix<Scalar>(rotation).matrix();
+    rotation6.template bottomRightCorner<3,3>() = rotation6.template topLeftCorner<3,3>();
+    jacobian = rotation6*jacobian;
+    benchmark::DoNotOptimize(jacobian.data());
+  }
+}
+
+template <typename Rotation_>
+static void rotateJacobian(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 6, Eigen::Dynamic> Matrix6X;
+  const Rotation_ rotation(kindr::EulerAnglesZyx<Scalar>(0.3, -0.2, 0.5));
+  Matrix6X jacobian = Matrix6X::Random(6, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    kindr::rotateTwistsToGlobal(rotation, jacobian);
+    benchmark::DoNotOptimize(jacobian.data());
+  }
+}
+
+BENCHMARK_TEMPLATE(denseAdjointTwist, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(spatialTransformTwist, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(denseAdjointTwists, kindr::HomTransformQuatD)->Arg(12)->Arg(1000);
+BENCHMARK_TEMPLATE(spatialTransformTwists, kindr::HomTransformQuatD)->Arg(12)->Arg(1000);
+BENCHMARK_TEMPLATE(denseRotateJacobian, kindr::RotationQuaternionD)->Arg(18)->Arg(1000);
+BENCHMARK_TEMPLATE(rotateJacobian, kindr::RotationQuaternionD)->Arg(18)->Arg(1000);
+BENCHMARK_TEMPLATE(denseAdjointTwist, kindr::HomTransformQuatF);
+BENCHMARK_TEMPLATE(spatialTransformTwist, kindr::HomTransformQuatF);
+
+//! Frame tree of 400 frames with a branching factor of four
+template <typename Pose_>
+static kindr::FrameTree<Pose_> getBenchmarkFrameTree() {
+  kindr::FrameTree<Pose_> tree;
+  for (int i = 1; i < 400; ++i) {
+    tree.addFrame((i-1)/4, getBenchmarkPose<Pose_>(0.1, -0.2, 0.3, 0.01*i, -0.2, 0.1));
+  }
+  return tree;
+}
+
+template <typename Pose_>
+static void queryFrameTreeRecompose(benchmark::State& state) {
+  kindr::FrameTree<Pose_> tree = getBenchmarkFrameTree<Pose_>();
+  int frameA = 398, frameB = 237;
+  Pose_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(frameA);
+    benchmark::DoNotOptimize(frameB);
+    Pose_ poseAToRoot, poseBToRoot;
+    for (int i = frameA; i != 0; i = tree.getParent(i)) {
+      poseAToRoot = tree.getPoseToParent(i)*poseAToRoot;
+    }
+    for (int i = frameB; i != 0; i = tree.getParent(i)) {
+      poseBToRoot = tree.getPoseToParent(i)*poseBToRoot;
+    }
+    result = Pose_(typename Pose_::Position(poseAToRoot.inverseTransform(poseBToRoot.getPosition())),
+                   poseAToRoot.getRotation().inverted()*poseBToRoot.getRotation());
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void queryFrameTree(benchmark::State& state) {
+  kindr::FrameTree<Pose_> tree = getBenchmarkFrameTree<Pose_>();
+  int frameA = 398, frameB = 237;
+  Pose_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(frameA);
+    benchmark::DoNotOptimize(frameB);
+    result = tree.getPose(frameA, frameB);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void updateAndQueryFrameTree(benchmark::State& state) {
+  kindr::FrameTree<Pose_> tree = getBenchmarkFrameTree<Pose_>();
+  const Pose_ pose = getBenchmarkPose<Pose_>(0.1, -0.2, 0.3, 0.5, -0.2, 0.1);
+  int frameA = 398, frameB = 237;
+  Pose_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(frameA);
+    tree.setPoseToParent(99, pose);
+    result = tree.getPose(frameA, frameB);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_TEMPLATE(queryFrameTreeRecompose, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(queryFrameTree, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(updateAndQueryFrameTree, kindr::HomTransformQuatD);
+
+template <typename Pose_>
+static void integrateTwistSeparately(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  const kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> twist(Vector3(0.4, -0.3, 0.9), Vector3(1.0, -2.0, 0.5));
+  const Scalar dt = 0.001;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    // First order integration of the position followed by the rotation
+    pose.getPosition() += typename Pose_::Position(pose.getRotation().rotate(Vector3(twist.getTranslationalVelocity().toImplementation()*dt)));
+    pose.getRotation() = pose.getRotation()*typename Pose_::Rotation().exponentialMap(Vector3(twist.getRotationalVelocity().toImplementation()*dt));
+    benchmark::DoNotOptimize(pose);
+  }
+}
+
+template <typename Pose_>
+static void integrateTwist(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  const kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> twist(Vector3(0.4, -0.3, 0.9), Vector3(1.0, -2.0, 0.5));
+  const Scalar dt = 0.001;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    pose = pose.boxPlus(twist*dt);
+    benchmark::DoNotOptimize(pose);
+  }
+}
+
+template <typename Pose_>
+static void exponentialMap(benchmark::State& state) {
+  typename Pose_::Vector6 vector;
+  vector << 0.4, -0.3, 0.9, 0.1, -0.2, 0.05;
+  Pose_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vector);
+    result = result.exponentialMap(vector);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Pose_>
+static void logarithmicMap(benchmark::State& state) {
+  Pose_ pose = getBenchmarkPose<Pose_>(1.0, -0.5, 0.2, 0.3, -0.2, 0.5);
+  typename Pose_::Vector6 result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose);
+    result = pose.logarithmicMap();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+//! Errors and Jacobians of the relative-pose measurements of a chain of poses with state.range(0) edges
+template <typename Pose_>
+static void relativePoseErrors(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef kindr::PoseGraphEdge<Pose_> Edge;
+  const int numEdges = static_cast<int>(state.range(0));
+  std::vector<Pose_, Eigen::aligned_allocator<Pose_>> poses;
+  std::vector<Edge, Eigen::aligned_allocator<Edge>> edges;
+  const Pose_ measurement = getBenchmarkPose<Pose_>(0.1, 0.02, 0.0, 0.3, 0.07, 0.05);
+  for (int i = 0; i <= numEdges; ++i) {
+    poses.push_back(getBenchmarkPose<Pose_>(0.1*i, 0.01*i, 0.2, 0.3*i, -0.1, 0.05*i));
+  }
+  for (int i = 0; i < numEdges; ++i) {
+    edges.push_back(Edge(i, i+1, measurement));
+  }
+  Eigen::Matrix<Scalar, 6, Eigen::Dynamic> errors(6, numEdges);
+  Eigen::Matrix<Scalar, 6, Eigen::Dynamic> jacobiansFirst(6, 6*numEdges), jacobiansSecond(6, 6*numEdges);
+  for (auto _ : state) {
+    kindr::getRelativePoseErrors(poses, edges, errors, jacobiansFirst, jacobiansSecond);
+    benchmark::DoNotOptimize(errors.data());
+    benchmark::DoNotOptimize(jacobiansSecond.data());
+  }
+  state.SetItemsProcessed(state.iterations()*numEdges);
+}
+
+//! Interpolating lookups in a trajectory of state.range(0) samples, sequentially (hinted) or at scattered times
+template <typename Pose_, bool IsSequential_>
+static void lookupTrajectory(benchmark::State& state) {
+  typedef typename Pose_::Scalar Scalar;
+  const int numSamples = static_cast<int>(state.range(0));
+  kindr::PoseTrajectory<Pose_> trajectory(numSamples);
+  for (int i = 0; i < numSamples; ++i) {
+    trajectory.push(Scalar(i), getBenchmarkPose<Pose_>(0.1*i, 0.01*i, 0.2, 0.3*i, -0.1, 0.05*i));
+  }
+  const int numQueries = 1000;
+  std::vector<Scalar> times(numQueries);
+  for (int i = 0; i < numQueries; ++i) {
+    // The scattered times jump by a large prime stride through the trajectory
+    const int sample = IsSequential_ ? (i*(numSamples - 1))/numQueries : static_cast<int>((7919LL*i) % (numSamples - 1));
+    times[i] = Scalar(sample) + Scalar(0.37);
+  }
+  Pose_ result;
+  for (auto _ : state) {
+    for (int i = 0; i < numQueries; ++i) {
+      result = trajectory.getPose(times[i]);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetItemsProcessed(state.iterations()*numQueries);
+}
+
+BENCHMARK_TEMPLATE(relativePoseErrors, kindr::HomTransformQuatD)->Arg(1000)->Arg(50000);
+BENCHMARK_TEMPLATE(lookupTrajectory, kindr::HomTransformQuatD, true)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(lookupTrajectory, kindr::HomTransformQuatD, false)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(integrateTwistSeparately, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(integrateTwist, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(exponentialMap, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(logarithmicMap, kindr::HomTransformQuatD);
+BENCHMARK_TEMPLATE(integrateTwistSeparately, kindr::HomTransformMatrixD);
+BENCHMARK_TEMPLATE(integrateTwist, kindr::HomTransformMatrixD);
+BENCHMARK_TEMPLATE(integrateTwistSeparately, kindr::HomTransformQuatF);
+BENCHMARK_TEMPLATE(integrateTwist, kindr::HomTransformQuatF);
+
+#define KINDR_POSE_BENCHMARK(Pose) \
+  BENCHMARK_TEMPLATE(multiplyPoses, Pose); \
+  BENCHMARK_TEMPLATE(transform, Pose); \
+  BENCHMARK_TEMPLATE(inverseTransform, Pose); \
+  BENCHMARK_TEMPLATE(getTransformationMatrix, Pose); \
+  BENCHMARK_TEMPLATE(transformTwist, Pose); \
+  BENCHMARK_TEMPLATE(transformWrench, Pose); \
+  BENCHMARK_TEMPLATE(transformPointsLoop, Pose)->Arg(1000)->Arg(300000); \
+  BENCHMARK_TEMPLATE(transformPoints, Pose)->Arg(1000)->Arg(300000); \
+  BENCHMARK_TEMPLATE(inverseTransformPoints, Pose)->Arg(1000)->Arg(300000);
+
+KINDR_POSE_BENCHMARK(kindr::HomTransformQuatD)
+KINDR_POSE_BENCHMARK(kindr::HomTransformMatrixD)
+KINDR_POSE_BENCHMARK(kindr::HomTransformQuatF)
+KINDR_POSE_BENCHMARK(kindr::HomTransformMatrixF)
+KINDR_POSE_BENCHMARK(kindr::CachedHomTransformQuatD)
+KINDR_POSE_BENCHMARK(kindr::CachedHomTransformMatrixD)
+KINDR_POSE_BENCHMARK(kindr::CachedHomTransformQuatF)
+KINDR_POSE_BENCHMARK(kindr::CachedHomTransformMatrixF)
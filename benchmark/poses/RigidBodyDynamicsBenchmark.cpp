@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <benchmark/benchmark.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/RigidBodyTree.hpp"
+
+/* Inverse and forward dynamics of a quadruped with a floating base and four legs of three revolute joints, i.e. with
+ * 18 degrees of freedom.
+ */
+
+template <typename Scalar_>
+struct QuadrupedDynamics {
+  typedef kindr::RigidBodyTree<Scalar_, 12> Tree;
+  typedef typename Tree::Vector3 Vector3;
+  typedef typename Tree::Matrix3 Matrix3;
+  typedef typename Tree::Inertia Inertia;
+  typedef kindr::HomTransformQuat<Scalar_> Pose;
+
+  Tree tree;
+  typename Tree::JointVector jointPositions, jointVelocities, jointAccelerations, jointTorques;
+  typename Tree::Twist baseTwist = typename Tree::Twist(Vector3(0.5, -0.1, 0.05), Vector3(0.1, 0.2, -0.3));
+  typename Tree::Twist baseAcceleration = typename Tree::Twist(Vector3(0.2, 0.3, -0.5), Vector3(-0.4, 0.1, 0.2));
+  Vector3 gravity = Vector3(0.0, 0.0, -9.81);
+
+  QuadrupedDynamics() {
+    const Scalar_ hipX[] = {0.3, 0.3, -0.3, -0.3};
+    const Scalar_ hipY[] = {0.2, -0.2, 0.2, -0.2};
+    for (int leg = 0; leg < 4; ++leg) {
+      const int hip = 3*leg;
+      tree.setBody(hip, Tree::Base, Pose(typename Pose::Position(hipX[leg], hipY[leg], 0.0), typename Pose::Rotation()),
+                   Vector3::UnitX(), Tree::JointType::Revolute, Inertia(2.0, typename Pose::Position(0.0, 0.05, 0.0), Matrix3(Vector3(0.002, 0.003, 0.002).asDiagonal())));
+      tree.setBody(hip+1, hip, Pose(typename Pose::Position(0.0, 0.1, 0.0), typename Pose::Rotation()),
+                   Vector3::UnitY(), Tree::JointType::Revolute, Inertia(1.5, typename Pose::Position(0.0, 0.0, -0.12), Matrix3(Vector3(0.01, 0.01, 0.001).asDiagonal())));
+      tree.setBody(hip+2, hip+1, Pose(typename Pose::Position(0.0, 0.0, -0.25), typename Pose::Rotation()),
+                   Vector3::UnitY(), Tree::JointType::Revolute, Inertia(0.3, typename Pose::Position(0.0, 0.0, -0.12), Matrix3(Vector3(0.003, 0.003, 0.0002).asDiagonal())));
+    }
+    tree.setBaseInertia(Inertia(20.0, typename Pose::Position(0.0, 0.0, 0.0), Matrix3(Vector3(0.3, 0.8, 0.9).asDiagonal())));
+    jointPositions = Tree::JointVector::Random();
+    jointVelocities = Tree::JointVector::Random();
+    jointAccelerations = Tree::JointVector::Random();
+    jointTorques = Tree::JointVector::Random();
+    tree.setJointPositions(jointPositions);
+  }
+};
+
+template <typename Scalar_>
+static void inverseDynamicsFloatingBase(benchmark::State& state) {
+  QuadrupedDynamics<Scalar_> robot;
+  for (auto _ : state) {
+    robot.tree.setJointPositions(robot.jointPositions);
+    benchmark::DoNotOptimize(robot.tree.computeInverseDynamics(robot.baseTwist, robot.baseAcceleration, robot.jointVelocities,
+                                                               robot.jointAccelerations, robot.gravity, robot.jointTorques));
+    benchmark::DoNotOptimize(robot.jointTorques.data());
+  }
+}
+
+template <typename Scalar_>
+static void forwardDynamicsFloatingBase(benchmark::State& state) {
+  QuadrupedDynamics<Scalar_> robot;
+  for (auto _ : state) {
+    robot.tree.setJointPositions(robot.jointPositions);
+    benchmark::DoNotOptimize(robot.tree.computeForwardDynamics(robot.baseTwist, robot.jointVelocities, robot.jointTorques,
+                                                               robot.gravity, robot.jointAccelerations));
+    benchmark::DoNotOptimize(robot.jointAccelerations.data());
+  }
+}
+
+BENCHMARK_TEMPLATE(inverseDynamicsFloatingBase, double);
+BENCHMARK_TEMPLATE(inverseDynamicsFloatingBase, float);
+BENCHMARK_TEMPLATE(forwardDynamicsFloatingBase, double);
+BENCHMARK_TEMPLATE(forwardDynamicsFloatingBase, float);
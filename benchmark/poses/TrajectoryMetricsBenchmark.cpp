@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <benchmark/benchmark.h>
+
+#include "kindr/poses/TrajectoryMetrics.hpp"
+
+/* Absolute and relative errors of a trajectory, computed one pose at a time with the pose operators and in batches.
+ */
+
+template <typename Scalar_>
+struct Trajectories {
+  typedef kindr::PoseArray<Scalar_> PoseArray;
+  typedef typename PoseArray::Element Pose;
+
+  PoseArray estimated;
+  PoseArray reference;
+  std::vector<Pose> estimatedPoses;
+  std::vector<Pose> referencePoses;
+  kindr::TrajectoryPairs pairs;
+
+  explicit Trajectories(int size)
+    : estimated(size),
+      reference(size),
+      pairs(kindr::TrajectoryPairs::fromSamples(size, 10)) {
+    for (int i = 0; i < size; ++i) {
+      const Scalar_ t = Scalar_(0.01)*Scalar_(i);
+      const Pose pose(typename Pose::Position(std::cos(t), std::sin(t), Scalar_(0.1)*t), typename Pose::Rotation(kindr::EulerAnglesZyx<Scalar_>(t, 0.0, 0.0)));
+      const Pose noise(typename Pose::Position(Eigen::Matrix<Scalar_, 3, 1>::Random()*Scalar_(0.01)),
+                       typename Pose::Rotation(kindr::RotationVector<Scalar_>(Eigen::Matrix<Scalar_, 3, 1>::Random()*Scalar_(0.01))));
+      reference.set(i, pose);
+      estimated.set(i, pose*noise);
+      referencePoses.push_back(pose);
+      estimatedPoses.push_back(pose*noise);
+    }
+  }
+};
+
+template <typename Scalar_>
+static void absoluteErrorPerPose(benchmark::State& state) {
+  Trajectories<Scalar_> trajectories(state.range(0));
+  const kindr::TrajectoryAlignment<Scalar_> alignment = kindr::alignTrajectories(trajectories.estimated, trajectories.reference);
+  Eigen::Matrix<Scalar_, Eigen::Dynamic, 1> translationErrors(trajectories.estimatedPoses.size());
+  Eigen::Matrix<Scalar_, Eigen::Dynamic, 1> rotationErrors(trajectories.estimatedPoses.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < trajectories.estimatedPoses.size(); ++i) {
+      const typename Trajectories<Scalar_>::Pose& estimated = trajectories.estimatedPoses[i];
+      const typename Trajectories<Scalar_>::Pose& reference = trajectories.referencePoses[i];
+      translationErrors(i) = (alignment.transform(estimated.getPosition()) - reference.getPosition()).norm();
+      rotationErrors(i) = (alignment.getRotation()*estimated.getRotation()).getDisparityAngle(reference.getRotation());
+    }
+    benchmark::DoNotOptimize(translationErrors.data());
+    benchmark::DoNotOptimize(rotationErrors.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Scalar_>
+static void absoluteErrorBatch(benchmark::State& state) {
+  Trajectories<Scalar_> trajectories(state.range(0));
+  const kindr::TrajectoryAlignment<Scalar_> alignment = kindr::alignTrajectories(trajectories.estimated, trajectories.reference);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kindr::computeAbsoluteTrajectoryError(trajectories.estimated, trajectories.reference, alignment));
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Scalar_>
+static void alignment(benchmark::State& state) {
+  Trajectories<Scalar_> trajectories(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kindr::alignTrajectories(trajectories.estimated, trajectories.reference, kindr::AlignmentType::Similarity));
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Scalar_>
+static void relativeErrorPerPose(benchmark::State& state) {
+  Trajectories<Scalar_> trajectories(state.range(0));
+  const kindr::TrajectoryPairs& pairs = trajectories.pairs;
+  Eigen::Matrix<Scalar_, Eigen::Dynamic, 1> translationErrors(pairs.size());
+  Eigen::Matrix<Scalar_, Eigen::Dynamic, 1> rotationErrors(pairs.size());
+  for (auto _ : state) {
+    for (int k = 0; k < pairs.size(); ++k) {
+      const std::vector<typename Trajectories<Scalar_>::Pose>& estimated = trajectories.estimatedPoses;
+      const std::vector<typename Trajectories<Scalar_>::Pose>& reference = trajectories.referencePoses;
+      const typename Trajectories<Scalar_>::Pose error = (reference[pairs.first(k)].inverted()*reference[pairs.second(k)]).inverted()*
+                                                         (estimated[pairs.first(k)].inverted()*estimated[pairs.second(k)]);
+      translationErrors(k) = error.getPosition().norm();
+      rotationErrors(k) = error.getRotation().boxMinus(typename Trajectories<Scalar_>::Pose::Rotation()).norm();
+    }
+    benchmark::DoNotOptimize(translationErrors.data());
+    benchmark::DoNotOptimize(rotationErrors.data());
+  }
+  state.SetItemsProcessed(state.iterations()*pairs.size());
+}
+
+template <typename Scalar_>
+static void relativeErrorBatch(benchmark::State& state) {
+  Trajectories<Scalar_> trajectories(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kindr::computeRelativePoseError(trajectories.estimated, trajectories.reference, trajectories.pairs));
+  }
+  state.SetItemsProcessed(state.iterations()*trajectories.pairs.size());
+}
+
+template <typename Scalar_>
+static void relativeErrorBatchThreadPool(benchmark::State& state) {
+  Trajectories<Scalar_> trajectories(state.range(0));
+  const kindr::ThreadPoolExecutor executor;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kindr::computeRelativePoseError(trajectories.estimated, trajectories.reference, trajectories.pairs, executor));
+  }
+  state.SetItemsProcessed(state.iterations()*trajectories.pairs.size());
+}
+
+BENCHMARK_TEMPLATE(absoluteErrorPerPose, double)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(absoluteErrorBatch, double)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(absoluteErrorBatch, float)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(alignment, double)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(relativeErrorPerPose, double)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(relativeErrorBatch, double)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(relativeErrorBatch, float)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(relativeErrorBatchThreadPool, double)->Arg(100000);
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+/* Compares the fused quaternion products (conjugateMultiply, multiplyConjugate, sandwich) against the composed
+ * expressions q.conjugated()*p, q*p.conjugated() and q*p*q.conjugated(), which materialize every intermediate.
+ */
+
+template <typename Quaternion_>
+Quaternion_ getBenchmarkQuaternion(double w, double x, double y, double z) {
+  const Eigen::Quaternion<typename Quaternion_::Scalar> quaternion(w, x, y, z);
+  return Quaternion_(quaternion.normalized());
+}
+
+template <typename Quaternion_>
+static void conjugateMultiply(benchmark::State& state) {
+  Quaternion_ q = getBenchmarkQuaternion<Quaternion_>(0.8, 0.2, -0.3, 0.4);
+  Quaternion_ p = getBenchmarkQuaternion<Quaternion_>(-0.1, 0.6, 0.5, 0.2);
+  Quaternion_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(p);
+    result = q.conjugateMultiply(p);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Quaternion_>
+static void conjugateMultiplyComposed(benchmark::State& state) {
+  Quaternion_ q = getBenchmarkQuaternion<Quaternion_>(0.8, 0.2, -0.3, 0.4);
+  Quaternion_ p = getBenchmarkQuaternion<Quaternion_>(-0.1, 0.6, 0.5, 0.2);
+  Quaternion_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(p);
+    result = q.conjugated()*p;
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Quaternion_>
+static void multiplyConjugate(benchmark::State& state) {
+  Quaternion_ q = getBenchmarkQuaternion<Quaternion_>(0.8, 0.2, -0.3, 0.4);
+  Quaternion_ p = getBenchmarkQuaternion<Quaternion_>(-0.1, 0.6, 0.5, 0.2);
+  Quaternion_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(p);
+    result = q.multiplyConjugate(p);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Quaternion_>
+static void multiplyConjugateComposed(benchmark::State& state) {
+  Quaternion_ q = getBenchmarkQuaternion<Quaternion_>(0.8, 0.2, -0.3, 0.4);
+  Quaternion_ p = getBenchmarkQuaternion<Quaternion_>(-0.1, 0.6, 0.5, 0.2);
+  Quaternion_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(p);
+    result = q*p.conjugated();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Quaternion_>
+static void sandwich(benchmark::State& state) {
+  typedef kindr::Quaternion<typename Quaternion_::Scalar> Quaternion;
+  Quaternion_ q = getBenchmarkQuaternion<Quaternion_>(0.8, 0.2, -0.3, 0.4);
+  Quaternion p(0.0, 0.6, 0.5, 0.2);
+  Quaternion result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(p);
+    result = q.sandwich(p);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Quaternion_>
+static void sandwichComposed(benchmark::State& state) {
+  typedef kindr::Quaternion<typename Quaternion_::Scalar> Quaternion;
+  Quaternion_ q = getBenchmarkQuaternion<Quaternion_>(0.8, 0.2, -0.3, 0.4);
+  Quaternion p(0.0, 0.6, 0.5, 0.2);
+  Quaternion result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(p);
+    const Quaternion qq(q.toImplementation());
+    result = qq*p*qq.conjugated();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+#define KINDR_FUSED_QUATERNION_BENCHMARK(Quaternion) \
+  BENCHMARK_TEMPLATE(conjugateMultiply, Quaternion); \
+  BENCHMARK_TEMPLATE(conjugateMultiplyComposed, Quaternion); \
+  BENCHMARK_TEMPLATE(multiplyConjugate, Quaternion); \
+  BENCHMARK_TEMPLATE(multiplyConjugateComposed, Quaternion); \
+  BENCHMARK_TEMPLATE(sandwich, Quaternion); \
+  BENCHMARK_TEMPLATE(sandwichComposed, Quaternion);
+
+KINDR_FUSED_QUATERNION_BENCHMARK(kindr::QuaternionD)
+KINDR_FUSED_QUATERNION_BENCHMARK(kindr::UnitQuaternionD)
+KINDR_FUSED_QUATERNION_BENCHMARK(kindr::RotationQuaternionD)
+KINDR_FUSED_QUATERNION_BENCHMARK(kindr::QuaternionF)
+KINDR_FUSED_QUATERNION_BENCHMARK(kindr::RotationQuaternionF)
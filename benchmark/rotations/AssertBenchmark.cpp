@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/Core"
+
+/* Compares the hot-path assertions with the inlined throwing assertion they replace. The kernels are not inlined such
+ * that their code size can be compared with
+ *   nm -S -C --size-sort kindr_assert_benchmarks kindr_assert_benchmarks_no_exceptions | grep assert_benchmark
+ * or with the target kindr_assert_code_size. kindr_assert_benchmarks_no_exceptions is built with KINDR_NO_EXCEPTIONS
+ * and NDEBUG, where the hot-path checks are compiled out.
+ */
+
+namespace assert_benchmark {
+
+template <typename PrimType_>
+__attribute__((noinline)) Eigen::Matrix<PrimType_, 3, 1> normalizedCrossInlineThrow(const Eigen::Matrix<PrimType_, 3, 1>& v1,
+                                                                                     const Eigen::Matrix<PrimType_, 3, 1>& v2) {
+  KINDR_ASSERT_TRUE(std::runtime_error, v1.norm()*v2.norm() != static_cast<PrimType_>(0.0), "At least one vector has zero length.");
+  return v1.cross(v2).normalized();
+}
+
+template <typename PrimType_>
+__attribute__((noinline)) Eigen::Matrix<PrimType_, 3, 1> normalizedCrossHot(const Eigen::Matrix<PrimType_, 3, 1>& v1,
+                                                                             const Eigen::Matrix<PrimType_, 3, 1>& v2) {
+  KINDR_ASSERT_TRUE_HOT(std::runtime_error, v1.norm()*v2.norm() != static_cast<PrimType_>(0.0), "At least one vector has zero length.");
+  return v1.cross(v2).normalized();
+}
+
+template <typename PrimType_>
+__attribute__((noinline)) void setFromVectors(kindr::RotationQuaternion<PrimType_>& rotation,
+                                              const Eigen::Matrix<PrimType_, 3, 1>& v1,
+                                              const Eigen::Matrix<PrimType_, 3, 1>& v2) {
+  rotation.setFromVectors(v1, v2);
+}
+
+template <typename PrimType_>
+__attribute__((noinline)) Eigen::Matrix<PrimType_, 3, 3> mappingFromLocalAngularVelocityToDiff(const kindr::EulerAnglesZyx<PrimType_>& rotation) {
+  return rotation.getMappingFromLocalAngularVelocityToDiff();
+}
+
+} // namespace assert_benchmark
+
+static void normalizedCrossInlineThrow(benchmark::State& state) {
+  Eigen::Vector3d v1(1.0, 2.0, 3.0);
+  const Eigen::Vector3d v2(-0.5, 0.3, 2.0);
+  Eigen::Vector3d result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v1);
+    result = assert_benchmark::normalizedCrossInlineThrow(v1, v2);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+static void normalizedCrossHot(benchmark::State& state) {
+  Eigen::Vector3d v1(1.0, 2.0, 3.0);
+  const Eigen::Vector3d v2(-0.5, 0.3, 2.0);
+  Eigen::Vector3d result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v1);
+    result = assert_benchmark::normalizedCrossHot(v1, v2);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+static void setFromVectors(benchmark::State& state) {
+  Eigen::Vector3d v1(1.0, 2.0, 3.0);
+  const Eigen::Vector3d v2(-0.5, 0.3, 2.0);
+  kindr::RotationQuaternion<double> rotation;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v1);
+    assert_benchmark::setFromVectors(rotation, v1, v2);
+    benchmark::DoNotOptimize(rotation);
+  }
+}
+
+static void mappingFromLocalAngularVelocityToDiff(benchmark::State& state) {
+  kindr::EulerAnglesZyx<double> rotation(0.3, -0.2, 0.5);
+  Eigen::Matrix3d mapping;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    mapping = assert_benchmark::mappingFromLocalAngularVelocityToDiff(rotation);
+    benchmark::DoNotOptimize(mapping);
+  }
+}
+
+BENCHMARK(normalizedCrossInlineThrow);
+BENCHMARK(normalizedCrossHot);
+BENCHMARK(setFromVectors);
+BENCHMARK(mappingFromLocalAngularVelocityToDiff);
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/common/Allocators.hpp"
+#include "kindr/rotations/RotationBatchConversion.hpp"
+
+/* Compares the batch conversion of state.range(0) rotations (kindr::convert) against a loop over the conversion of
+ * single rotations, for arrays of structures and for structure-of-arrays storage.
+ */
+
+template <typename Source_>
+static kindr::AlignedVector<Source_> getBenchmarkRotations(int size) {
+  kindr::AlignedVector<Source_> rotations;
+  for (int i = 0; i < size; ++i) {
+    rotations.push_back(Source_(kindr::RotationQuaternion<typename Source_::Scalar>().setRandom()));
+  }
+  return rotations;
+}
+
+template <typename Dest_, typename Source_>
+static void convertLoop(benchmark::State& state) {
+  const kindr::AlignedVector<Source_> sources = getBenchmarkRotations<Source_>(state.range(0));
+  kindr::AlignedVector<Dest_> destinations(sources.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < sources.size(); ++i) {
+      destinations[i] = Dest_(sources[i]);
+    }
+    benchmark::DoNotOptimize(destinations.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Dest_, typename Source_>
+static void convertArrayOfStructures(benchmark::State& state) {
+  const kindr::AlignedVector<Source_> sources = getBenchmarkRotations<Source_>(state.range(0));
+  kindr::AlignedVector<Dest_> destinations(sources.size());
+  for (auto _ : state) {
+    kindr::convert(sources.data(), destinations.data(), static_cast<int>(sources.size()));
+    benchmark::DoNotOptimize(destinations.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Dest_, typename Source_>
+static void convertStructureOfArrays(benchmark::State& state) {
+  const kindr::AlignedVector<Source_> rotations = getBenchmarkRotations<Source_>(state.range(0));
+  typename kindr::internal::RotationArrayTraits<Source_>::Matrix sources(static_cast<int>(kindr::internal::RotationArrayTraits<Source_>::Rows), state.range(0));
+  for (int i = 0; i < state.range(0); ++i) {
+    kindr::internal::RotationArrayTraits<Source_>::set(sources, i, rotations[i]);
+  }
+  typename kindr::internal::RotationArrayTraits<Dest_>::Matrix destinations(static_cast<int>(kindr::internal::RotationArrayTraits<Dest_>::Rows), state.range(0));
+  for (auto _ : state) {
+    kindr::convert<Dest_, Source_>(sources, destinations);
+    benchmark::DoNotOptimize(destinations.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+#define KINDR_BATCH_CONVERSION_BENCHMARKS(Dest, Source) \
+  BENCHMARK_TEMPLATE(convertLoop, Dest, Source)->Arg(100000); \
+  BENCHMARK_TEMPLATE(convertArrayOfStructures, Dest, Source)->Arg(100000); \
+  BENCHMARK_TEMPLATE(convertStructureOfArrays, Dest, Source)->Arg(100000);
+
+KINDR_BATCH_CONVERSION_BENCHMARKS(kindr::EulerAnglesZyxD, kindr::RotationMatrixD)
+KINDR_BATCH_CONVERSION_BENCHMARKS(kindr::EulerAnglesZyxD, kindr::RotationQuaternionD)
+KINDR_BATCH_CONVERSION_BENCHMARKS(kindr::RotationQuaternionD, kindr::EulerAnglesZyxD)
+KINDR_BATCH_CONVERSION_BENCHMARKS(kindr::RotationQuaternionD, kindr::RotationMatrixD)
+KINDR_BATCH_CONVERSION_BENCHMARKS(kindr::RotationMatrixD, kindr::RotationQuaternionD)
+KINDR_BATCH_CONVERSION_BENCHMARKS(kindr::RotationQuaternionF, kindr::EulerAnglesZyxF)
+KINDR_BATCH_CONVERSION_BENCHMARKS(kindr::EulerAnglesXyzD, kindr::AngleAxisD)
+
+/* Compares the minimal rotations between state.range(0) pairs of unit vectors: setFromVectors() and
+ * setFromUnitVectors() on single rotations against kindr::setFromUnitVectors on structure-of-arrays storage.
+ */
+
+template <typename Scalar_>
+static Eigen::Matrix<Scalar_, 3, Eigen::Dynamic, Eigen::RowMajor> getBenchmarkUnitVectors(int size) {
+  Eigen::Matrix<Scalar_, 3, Eigen::Dynamic, Eigen::RowMajor> vectors = Eigen::Matrix<Scalar_, 3, Eigen::Dynamic, Eigen::RowMajor>::Random(3, size);
+  vectors.colwise().normalize();
+  return vectors;
+}
+
+template <typename Dest_>
+static void setFromVectorsLoop(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Dest_::Scalar, 3, 1> Vector3;
+  const auto from = getBenchmarkUnitVectors<typename Dest_::Scalar>(state.range(0));
+  const auto to = getBenchmarkUnitVectors<typename Dest_::Scalar>(state.range(0));
+  kindr::AlignedVector<Dest_> destinations(from.cols());
+  for (auto _ : state) {
+    for (int i = 0; i < from.cols(); ++i) {
+      destinations[i].setFromVectors(Vector3(from.col(i)), Vector3(to.col(i)));
+    }
+    benchmark::DoNotOptimize(destinations.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Dest_>
+static void setFromUnitVectorsLoop(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Dest_::Scalar, 3, 1> Vector3;
+  const auto from = getBenchmarkUnitVectors<typename Dest_::Scalar>(state.range(0));
+  const auto to = getBenchmarkUnitVectors<typename Dest_::Scalar>(state.range(0));
+  kindr::AlignedVector<Dest_> destinations(from.cols());
+  for (auto _ : state) {
+    for (int i = 0; i < from.cols(); ++i) {
+      destinations[i].setFromUnitVectors(Vector3(from.col(i)), Vector3(to.col(i)));
+    }
+    benchmark::DoNotOptimize(destinations.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename Dest_>
+static void setFromUnitVectorsStructureOfArrays(benchmark::State& state) {
+  const auto from = getBenchmarkUnitVectors<typename Dest_::Scalar>(state.range(0));
+  const auto to = getBenchmarkUnitVectors<typename Dest_::Scalar>(state.range(0));
+  typename kindr::internal::RotationArrayTraits<Dest_>::Matrix destinations(static_cast<int>(kindr::internal::RotationArrayTraits<Dest_>::Rows), state.range(0));
+  for (auto _ : state) {
+    kindr::setFromUnitVectors<Dest_>(from, to, destinations);
+    benchmark::DoNotOptimize(destinations.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+#define KINDR_FROM_UNIT_VECTORS_BENCHMARKS(Dest) \
+  BENCHMARK_TEMPLATE(setFromVectorsLoop, Dest)->Arg(100000); \
+  BENCHMARK_TEMPLATE(setFromUnitVectorsLoop, Dest)->Arg(100000); \
+  BENCHMARK_TEMPLATE(setFromUnitVectorsStructureOfArrays, Dest)->Arg(100000);
+
+KINDR_FROM_UNIT_VECTORS_BENCHMARKS(kindr::RotationQuaternionD)
+KINDR_FROM_UNIT_VECTORS_BENCHMARKS(kindr::RotationMatrixD)
+KINDR_FROM_UNIT_VECTORS_BENCHMARKS(kindr::RotationQuaternionF)
+
+/* Compares the wrapping of state.range(0) angles and the unique form of Euler angles, scalar in a loop against the
+ * vectorized array versions.
+ */
+
+static void wrapPosNegPILoop(benchmark::State& state) {
+  const Eigen::ArrayXd angles = 20.0*Eigen::ArrayXd::Random(state.range(0));
+  Eigen::ArrayXd wrapped(angles.size());
+  for (auto _ : state) {
+    for (int i = 0; i < angles.size(); ++i) {
+      wrapped(i) = kindr::wrapPosNegPI(angles(i));
+    }
+    benchmark::DoNotOptimize(wrapped.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(wrapPosNegPILoop)->Arg(1000)->Arg(100000);
+
+static void wrapPosNegPIArray(benchmark::State& state) {
+  const Eigen::ArrayXd angles = 20.0*Eigen::ArrayXd::Random(state.range(0));
+  Eigen::ArrayXd wrapped(angles.size());
+  for (auto _ : state) {
+    wrapped = kindr::wrapPosNegPIArray(angles);
+    benchmark::DoNotOptimize(wrapped.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(wrapPosNegPIArray)->Arg(1000)->Arg(100000);
+
+template <typename EulerAngles_>
+static void getUniqueLoop(benchmark::State& state) {
+  typedef Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor> AnglesMatrix;
+  const AnglesMatrix angles = 4.0*AnglesMatrix::Random(3, state.range(0));
+  AnglesMatrix unique(3, state.range(0));
+  for (auto _ : state) {
+    for (int i = 0; i < angles.cols(); ++i) {
+      unique.col(i) = EulerAngles_(angles(0, i), angles(1, i), angles(2, i)).getUnique().toImplementation();
+    }
+    benchmark::DoNotOptimize(unique.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK_TEMPLATE(getUniqueLoop, kindr::EulerAnglesZyxD)->Arg(100000);
+
+template <typename EulerAngles_>
+static void setUniqueEulerAngles(benchmark::State& state) {
+  typedef Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor> AnglesMatrix;
+  const AnglesMatrix angles = 4.0*AnglesMatrix::Random(3, state.range(0));
+  AnglesMatrix unique(3, state.range(0));
+  for (auto _ : state) {
+    unique = angles;
+    kindr::setUniqueEulerAngles<EulerAngles_>(unique);
+    benchmark::DoNotOptimize(unique.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK_TEMPLATE(setUniqueEulerAngles, kindr::EulerAnglesZyxD)->Arg(100000);
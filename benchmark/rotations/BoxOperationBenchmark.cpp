@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+/* Measures the exponential and logarithmic maps and the box operations (internal::MapTraits, internal::BoxOperationTraits)
+ * of every rotation parameterization.
+ */
+
+template <typename Rotation_>
+static Rotation_ getBoxOperationRotation(double yaw, double pitch, double roll) {
+  return Rotation_(kindr::EulerAnglesZyx<typename Rotation_::Scalar>(yaw, pitch, roll));
+}
+
+template <typename Rotation_>
+static void exponentialMap(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Rotation_::Scalar, 3, 1> Vector3;
+  Vector3 vector(0.1, -0.3, 0.2);
+  Rotation_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vector);
+    result = result.exponentialMap(vector);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Rotation_>
+static void logarithmicMap(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Rotation_::Scalar, 3, 1> Vector3;
+  Rotation_ rotation = getBoxOperationRotation<Rotation_>(0.3, -0.2, 0.5);
+  Vector3 result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    result = rotation.logarithmicMap();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Rotation_>
+static void boxPlus(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Rotation_::Scalar, 3, 1> Vector3;
+  Rotation_ rotation = getBoxOperationRotation<Rotation_>(0.3, -0.2, 0.5);
+  Vector3 vector(0.1, -0.3, 0.2);
+  Rotation_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    benchmark::DoNotOptimize(vector);
+    result = rotation.boxPlus(vector);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Rotation_>
+static void boxMinus(benchmark::State& state) {
+  typedef Eigen::Matrix<typename Rotation_::Scalar, 3, 1> Vector3;
+  Rotation_ lhs = getBoxOperationRotation<Rotation_>(0.3, -0.2, 0.5);
+  Rotation_ rhs = getBoxOperationRotation<Rotation_>(0.2, 0.4, -0.1);
+  Vector3 result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    result = lhs.boxMinus(rhs);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+#define KINDR_BOX_OPERATION_BENCHMARK(Rotation) \
+  BENCHMARK_TEMPLATE(exponentialMap, Rotation); \
+  BENCHMARK_TEMPLATE(logarithmicMap, Rotation); \
+  BENCHMARK_TEMPLATE(boxPlus, Rotation); \
+  BENCHMARK_TEMPLATE(boxMinus, Rotation);
+
+#define KINDR_BOX_OPERATION_BENCHMARKS(PrimType) \
+  KINDR_BOX_OPERATION_BENCHMARK(kindr::AngleAxis<PrimType>) \
+  KINDR_BOX_OPERATION_BENCHMARK(kindr::RotationVector<PrimType>) \
+  KINDR_BOX_OPERATION_BENCHMARK(kindr::RotationQuaternion<PrimType>) \
+  KINDR_BOX_OPERATION_BENCHMARK(kindr::RotationMatrix<PrimType>) \
+  KINDR_BOX_OPERATION_BENCHMARK(kindr::EulerAnglesZyx<PrimType>) \
+  KINDR_BOX_OPERATION_BENCHMARK(kindr::EulerAnglesXyz<PrimType>)
+
+KINDR_BOX_OPERATION_BENCHMARKS(double)
+KINDR_BOX_OPERATION_BENCHMARKS(float)
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+/* Compares isNear of two rotations of different types with the comparison traits (isNear), also with the bound
+ * precomputed by RotationNearness (isNearWithPrecomputedBound), against the former path,
+ * which converted the right rotation to the left type, concatenated it with the inverse of the left rotation and
+ * extracted the angle through an angle-axis conversion (isNearViaAngleAxis).
+ */
+
+template <typename Rotation_>
+Rotation_ getBenchmarkRotation(double roll, double pitch, double yaw) {
+  return Rotation_(kindr::EulerAnglesZyx<typename Rotation_::Scalar>(yaw, pitch, roll));
+}
+
+template <typename Left_, typename Right_>
+static void isNear(benchmark::State& state) {
+  Left_ lhs = getBenchmarkRotation<Left_>(0.3, -0.2, 0.5);
+  Right_ rhs = getBenchmarkRotation<Right_>(0.3, -0.2, 0.5 + 1e-9);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    benchmark::DoNotOptimize(lhs.isNear(rhs, 1e-6));
+  }
+}
+
+template <typename Left_, typename Right_>
+static void isNearWithPrecomputedBound(benchmark::State& state) {
+  Left_ lhs = getBenchmarkRotation<Left_>(0.3, -0.2, 0.5);
+  Right_ rhs = getBenchmarkRotation<Right_>(0.3, -0.2, 0.5 + 1e-9);
+  const kindr::RotationNearness<Left_, Right_> isNear(1e-6);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    benchmark::DoNotOptimize(isNear(lhs, rhs));
+  }
+}
+
+template <typename Left_, typename Right_>
+static void isNearViaAngleAxis(benchmark::State& state) {
+  typedef kindr::AngleAxis<typename Left_::Scalar> AngleAxis;
+  Left_ lhs = getBenchmarkRotation<Left_>(0.3, -0.2, 0.5);
+  Right_ rhs = getBenchmarkRotation<Right_>(0.3, -0.2, 0.5 + 1e-9);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    benchmark::DoNotOptimize(std::abs(AngleAxis(lhs.inverted()*Left_(rhs)).angle()) < 1e-6);
+  }
+}
+
+#define KINDR_COMPARISON_BENCHMARK(Left, Right) \
+  BENCHMARK_TEMPLATE(isNear, Left, Right); \
+  BENCHMARK_TEMPLATE(isNearWithPrecomputedBound, Left, Right); \
+  BENCHMARK_TEMPLATE(isNearViaAngleAxis, Left, Right);
+
+KINDR_COMPARISON_BENCHMARK(kindr::RotationQuaternionD, kindr::RotationMatrixD)
+KINDR_COMPARISON_BENCHMARK(kindr::RotationMatrixD, kindr::RotationQuaternionD)
+KINDR_COMPARISON_BENCHMARK(kindr::AngleAxisD, kindr::RotationQuaternionD)
+KINDR_COMPARISON_BENCHMARK(kindr::EulerAnglesZyxD, kindr::RotationMatrixD)
+KINDR_COMPARISON_BENCHMARK(kindr::RotationVectorD, kindr::EulerAnglesXyzD)
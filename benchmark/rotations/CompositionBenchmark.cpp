@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+/* Compares chains of three rotations C_AB*C_BC*C_CD evaluated with operator*() (eager) against the lazy composition
+ * C_AB.lazy()*C_BC*C_CD, for rotating a vector and for computing the product.
+ */
+
+template <typename Rotation_>
+Rotation_ getChainRotation(double roll, double pitch, double yaw) {
+  return Rotation_(kindr::EulerAnglesZyx<typename Rotation_::Scalar>(yaw, pitch, roll));
+}
+
+template <typename First_, typename Second_, typename Third_>
+struct RotationChain {
+  typedef typename First_::Scalar Scalar;
+  First_ rotationAB = getChainRotation<First_>(0.3, -0.2, 0.5);
+  Second_ rotationBC = getChainRotation<Second_>(-0.1, 0.4, 0.2);
+  Third_ rotationCD = getChainRotation<Third_>(0.7, 0.1, -0.6);
+  Eigen::Matrix<Scalar, 3, 1> vector = Eigen::Matrix<Scalar, 3, 1>(1.0, -2.0, 0.5);
+};
+
+template <typename First_, typename Second_, typename Third_>
+static void rotateEager(benchmark::State& state) {
+  RotationChain<First_, Second_, Third_> chain;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(chain.rotationAB);
+    benchmark::DoNotOptimize(chain.vector);
+    benchmark::DoNotOptimize((chain.rotationAB*chain.rotationBC*chain.rotationCD).rotate(chain.vector));
+  }
+}
+
+template <typename First_, typename Second_, typename Third_>
+static void rotateLazy(benchmark::State& state) {
+  RotationChain<First_, Second_, Third_> chain;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(chain.rotationAB);
+    benchmark::DoNotOptimize(chain.vector);
+    benchmark::DoNotOptimize((chain.rotationAB.lazy()*chain.rotationBC*chain.rotationCD).rotate(chain.vector));
+  }
+}
+
+template <typename First_, typename Second_, typename Third_>
+static void productEager(benchmark::State& state) {
+  RotationChain<First_, Second_, Third_> chain;
+  First_ product;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(chain.rotationAB);
+    product = chain.rotationAB*chain.rotationBC*chain.rotationCD;
+    benchmark::DoNotOptimize(product);
+  }
+}
+
+template <typename First_, typename Second_, typename Third_>
+static void productLazy(benchmark::State& state) {
+  RotationChain<First_, Second_, Third_> chain;
+  First_ product;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(chain.rotationAB);
+    product = chain.rotationAB.lazy()*chain.rotationBC*chain.rotationCD;
+    benchmark::DoNotOptimize(product);
+  }
+}
+
+#define KINDR_COMPOSITION_BENCHMARK(First, Second, Third) \
+  BENCHMARK_TEMPLATE(rotateEager, First, Second, Third); \
+  BENCHMARK_TEMPLATE(rotateLazy, First, Second, Third); \
+  BENCHMARK_TEMPLATE(productEager, First, Second, Third); \
+  BENCHMARK_TEMPLATE(productLazy, First, Second, Third);
+
+KINDR_COMPOSITION_BENCHMARK(kindr::RotationMatrixD, kindr::RotationMatrixD, kindr::RotationMatrixD)
+KINDR_COMPOSITION_BENCHMARK(kindr::RotationQuaternionD, kindr::RotationQuaternionD, kindr::RotationQuaternionD)
+KINDR_COMPOSITION_BENCHMARK(kindr::RotationMatrixD, kindr::RotationQuaternionD, kindr::EulerAnglesZyxD)
+KINDR_COMPOSITION_BENCHMARK(kindr::EulerAnglesZyxD, kindr::RotationQuaternionD, kindr::RotationMatrixD)
+KINDR_COMPOSITION_BENCHMARK(kindr::AngleAxisD, kindr::AngleAxisD, kindr::AngleAxisD)
+KINDR_COMPOSITION_BENCHMARK(kindr::RotationQuaternionF, kindr::RotationQuaternionF, kindr::RotationQuaternionF)
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+/* Measures the conversion between every pair of rotation parameterizations (internal::ConversionTraits),
+ * including the copy of a parameterization to itself as reference.
+ */
+
+template <typename From_, typename To_>
+static void convert(benchmark::State& state) {
+  From_ from = From_(kindr::EulerAnglesZyx<typename From_::Scalar>(0.3, -0.2, 0.5));
+  To_ to;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(from);
+    to = To_(from);
+    benchmark::DoNotOptimize(to);
+  }
+}
+
+#define KINDR_CONVERSION_BENCHMARKS(PrimType, From) \
+  BENCHMARK_TEMPLATE(convert, From<PrimType>, kindr::AngleAxis<PrimType>); \
+  BENCHMARK_TEMPLATE(convert, From<PrimType>, kindr::RotationVector<PrimType>); \
+  BENCHMARK_TEMPLATE(convert, From<PrimType>, kindr::RotationQuaternion<PrimType>); \
+  BENCHMARK_TEMPLATE(convert, From<PrimType>, kindr::RotationMatrix<PrimType>); \
+  BENCHMARK_TEMPLATE(convert, From<PrimType>, kindr::EulerAnglesZyx<PrimType>); \
+  BENCHMARK_TEMPLATE(convert, From<PrimType>, kindr::EulerAnglesXyz<PrimType>);
+
+#define KINDR_ALL_CONVERSION_BENCHMARKS(PrimType) \
+  KINDR_CONVERSION_BENCHMARKS(PrimType, kindr::AngleAxis) \
+  KINDR_CONVERSION_BENCHMARKS(PrimType, kindr::RotationVector) \
+  KINDR_CONVERSION_BENCHMARKS(PrimType, kindr::RotationQuaternion) \
+  KINDR_CONVERSION_BENCHMARKS(PrimType, kindr::RotationMatrix) \
+  KINDR_CONVERSION_BENCHMARKS(PrimType, kindr::EulerAnglesZyx) \
+  KINDR_CONVERSION_BENCHMARKS(PrimType, kindr::EulerAnglesXyz)
+
+KINDR_ALL_CONVERSION_BENCHMARKS(double)
+KINDR_ALL_CONVERSION_BENCHMARKS(float)
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+/* Compares the multiplication of two rotations with the multiplication traits (multiply) against the former default path,
+ * which converted both rotations to rotation quaternions, multiplied them and converted the result back (multiplyViaQuaternion).
+ */
+
+template <typename Rotation_>
+Rotation_ getBenchmarkRotation(double roll, double pitch, double yaw) {
+  return Rotation_(kindr::EulerAnglesZyx<typename Rotation_::Scalar>(yaw, pitch, roll));
+}
+
+template <typename Left_, typename Right_>
+static void multiply(benchmark::State& state) {
+  Left_ lhs = getBenchmarkRotation<Left_>(0.3, -0.2, 0.5);
+  Right_ rhs = getBenchmarkRotation<Right_>(-0.1, 0.4, 0.2);
+  Left_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    result = lhs*rhs;
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <typename Left_, typename Right_>
+static void multiplyViaQuaternion(benchmark::State& state) {
+  typedef kindr::RotationQuaternion<typename Left_::Scalar> RotationQuaternion;
+  Left_ lhs = getBenchmarkRotation<Left_>(0.3, -0.2, 0.5);
+  Right_ rhs = getBenchmarkRotation<Right_>(-0.1, 0.4, 0.2);
+  Left_ result;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    result = Left_(RotationQuaternion(RotationQuaternion(lhs).toImplementation()*RotationQuaternion(rhs).toImplementation()));
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+#define KINDR_MULTIPLICATION_BENCHMARK(Left, Right) \
+  BENCHMARK_TEMPLATE(multiply, Left, Right); \
+  BENCHMARK_TEMPLATE(multiplyViaQuaternion, Left, Right);
+
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationMatrixD, kindr::RotationMatrixD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationQuaternionD, kindr::RotationQuaternionD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::AngleAxisD, kindr::AngleAxisD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationVectorD, kindr::RotationVectorD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::EulerAnglesZyxD, kindr::EulerAnglesZyxD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::EulerAnglesXyzD, kindr::EulerAnglesXyzD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationMatrixD, kindr::RotationQuaternionD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationMatrixD, kindr::EulerAnglesZyxD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationQuaternionD, kindr::RotationMatrixD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::EulerAnglesZyxD, kindr::RotationMatrixD)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationMatrixF, kindr::RotationMatrixF)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationQuaternionF, kindr::RotationQuaternionF)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::AngleAxisF, kindr::AngleAxisF)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationVectorF, kindr::RotationVectorF)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::EulerAnglesZyxF, kindr::EulerAnglesZyxF)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::EulerAnglesXyzF, kindr::EulerAnglesXyzF)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationMatrixF, kindr::RotationQuaternionF)
+KINDR_MULTIPLICATION_BENCHMARK(kindr::RotationQuaternionF, kindr::RotationMatrixF)
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationRenormalization.hpp"
+
+/* Compares the renormalization policies for long chains of compositions, e.g. the integration of angular velocities.
+ * The throughput is measured per composition, the counter "error" is the distance from the rotation group after
+ * one million compositions, see RenormalizingRotation::getNormalizationError().
+ */
+
+template <typename Rotation_, kindr::RenormalizationPolicy Policy_, int Period_>
+static void composeChain(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  const Rotation_ increment(kindr::EulerAnglesZyx<Scalar>(0.011, -0.007, 0.013));
+  kindr::RenormalizingRotation<Rotation_> chain(Rotation_(), Policy_, Period_);
+  for (auto _ : state) {
+    for (int i = 0; i < 1000; ++i) {
+      chain *= increment;
+    }
+    benchmark::DoNotOptimize(chain);
+  }
+  state.SetItemsProcessed(state.iterations()*1000);
+
+  kindr::RenormalizingRotation<Rotation_> accuracyChain(Rotation_(), Policy_, Period_);
+  for (int i = 0; i < 1000000; ++i) {
+    accuracyChain *= increment;
+  }
+  state.counters["error"] = static_cast<double>(accuracyChain.getNormalizationError());
+}
+
+#define KINDR_RENORMALIZATION_BENCHMARK(Rotation) \
+  BENCHMARK_TEMPLATE(composeChain, Rotation, kindr::RenormalizationPolicy::Never, 1); \
+  BENCHMARK_TEMPLATE(composeChain, Rotation, kindr::RenormalizationPolicy::Exact, 1); \
+  BENCHMARK_TEMPLATE(composeChain, Rotation, kindr::RenormalizationPolicy::Exact, 100); \
+  BENCHMARK_TEMPLATE(composeChain, Rotation, kindr::RenormalizationPolicy::FirstOrder, 1); \
+  BENCHMARK_TEMPLATE(composeChain, Rotation, kindr::RenormalizationPolicy::FirstOrder, 10);
+
+KINDR_RENORMALIZATION_BENCHMARK(kindr::RotationQuaternionD)
+KINDR_RENORMALIZATION_BENCHMARK(kindr::RotationQuaternionF)
+KINDR_RENORMALIZATION_BENCHMARK(kindr::RotationMatrixD)
+KINDR_RENORMALIZATION_BENCHMARK(kindr::RotationMatrixF)
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+/* Compares the rotation of a 3xN block of vectors with the rotation traits of each parameterization (rotate) against
+ * rotating every column with the direct kernel (rotateColumnwise) and against the former default path, which converted
+ * the rotation to a rotation matrix for every call (rotateViaMatrix). The number of columns for which the matrix path
+ * becomes cheaper than the direct kernel is the crossover point that is hard-coded in the rotation traits
+ * (see internal::DirectRotationTraits::minColsForMatrix).
+ * The inverse rotation (inverseRotate) is compared against the former path, which inverted the rotation first (inverseRotateViaInverted).
+ * A rotation prepared outside of the loop (rotatePrepared) shows the cost if the conversion is hoisted out of the loop.
+ */
+
+template <typename Rotation_>
+Rotation_ getBenchmarkRotation() {
+  return Rotation_(kindr::EulerAnglesZyx<typename Rotation_::Scalar>(0.3, -0.2, 0.5));
+}
+
+template <typename Rotation_, int Cols_>
+static void rotate(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Cols_> Matrix3X;
+  Rotation_ rotation = getBenchmarkRotation<Rotation_>();
+  const Matrix3X m = Matrix3X::Random();
+  Matrix3X rotated;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    rotated = rotation.rotate(m);
+    benchmark::DoNotOptimize(rotated);
+  }
+}
+
+template <typename Rotation_, int Cols_>
+static void rotateColumnwise(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Cols_> Matrix3X;
+  Rotation_ rotation = getBenchmarkRotation<Rotation_>();
+  const Matrix3X m = Matrix3X::Random();
+  Matrix3X rotated;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    for (int i = 0; i < Cols_; ++i) {
+      rotated.col(i) = kindr::internal::RotationTraits<kindr::RotationBase<Rotation_>>::rotateVector(rotation, m.col(i));
+    }
+    benchmark::DoNotOptimize(rotated);
+  }
+}
+
+template <typename Rotation_, int Cols_>
+static void rotateViaMatrix(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Cols_> Matrix3X;
+  Rotation_ rotation = getBenchmarkRotation<Rotation_>();
+  const Matrix3X m = Matrix3X::Random();
+  Matrix3X rotated;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    rotated = kindr::RotationMatrix<Scalar>(rotation).toImplementation()*m;
+    benchmark::DoNotOptimize(rotated);
+  }
+}
+
+template <typename Rotation_, int Cols_>
+static void rotatePrepared(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Cols_> Matrix3X;
+  const kindr::PreparedRotation<Rotation_> rotation = getBenchmarkRotation<Rotation_>().prepared();
+  const Matrix3X m = Matrix3X::Random();
+  Matrix3X rotated;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(m);
+    rotated = rotation.rotate(m);
+    benchmark::DoNotOptimize(rotated);
+  }
+}
+
+template <typename Rotation_, int Cols_>
+static void inverseRotate(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Cols_> Matrix3X;
+  Rotation_ rotation = getBenchmarkRotation<Rotation_>();
+  const Matrix3X m = Matrix3X::Random();
+  Matrix3X rotated;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    rotated = rotation.inverseRotate(m);
+    benchmark::DoNotOptimize(rotated);
+  }
+}
+
+template <typename Rotation_, int Cols_>
+static void inverseRotateViaInverted(benchmark::State& state) {
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Cols_> Matrix3X;
+  Rotation_ rotation = getBenchmarkRotation<Rotation_>();
+  const Matrix3X m = Matrix3X::Random();
+  Matrix3X rotated;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    rotated = kindr::RotationMatrix<Scalar>(rotation.inverted()).toImplementation()*m;
+    benchmark::DoNotOptimize(rotated);
+  }
+}
+
+#define KINDR_ROTATE_BENCHMARK(Rotation, Cols) \
+  BENCHMARK_TEMPLATE(rotate, Rotation, Cols); \
+  BENCHMARK_TEMPLATE(rotateColumnwise, Rotation, Cols); \
+  BENCHMARK_TEMPLATE(rotateViaMatrix, Rotation, Cols); \
+  BENCHMARK_TEMPLATE(rotatePrepared, Rotation, Cols); \
+  BENCHMARK_TEMPLATE(inverseRotate, Rotation, Cols); \
+  BENCHMARK_TEMPLATE(inverseRotateViaInverted, Rotation, Cols);
+
+#define KINDR_ROTATE_BENCHMARKS(Rotation) \
+  KINDR_ROTATE_BENCHMARK(Rotation, 1) \
+  KINDR_ROTATE_BENCHMARK(Rotation, 2) \
+  KINDR_ROTATE_BENCHMARK(Rotation, 3) \
+  KINDR_ROTATE_BENCHMARK(Rotation, 4) \
+  KINDR_ROTATE_BENCHMARK(Rotation, 8)
+
+KINDR_ROTATE_BENCHMARKS(kindr::RotationQuaternionD)
+KINDR_ROTATE_BENCHMARKS(kindr::AngleAxisD)
+KINDR_ROTATE_BENCHMARKS(kindr::RotationVectorD)
+KINDR_ROTATE_BENCHMARKS(kindr::EulerAnglesZyxD)
+KINDR_ROTATE_BENCHMARKS(kindr::EulerAnglesXyzD)
+KINDR_ROTATE_BENCHMARKS(kindr::RotationQuaternionF)
+KINDR_ROTATE_BENCHMARKS(kindr::AngleAxisF)
+KINDR_ROTATE_BENCHMARKS(kindr::RotationVectorF)
+KINDR_ROTATE_BENCHMARKS(kindr::EulerAnglesZyxF)
+KINDR_ROTATE_BENCHMARKS(kindr::EulerAnglesXyzF)
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/RotationConversion.hpp"
+
+/* Compares the conversions of RotationAdapter with hand-written copies of the coefficients. Both should take the
+ * same time, the reinterpretation with mapAsKindr() should take no time at all.
+ */
+
+template <typename PrimType_>
+static void eigenQuaternionToKindrByHand(benchmark::State& state) {
+  Eigen::Quaternion<PrimType_> quaternion(kindr::RotationQuaternion<PrimType_>(kindr::EulerAnglesZyx<PrimType_>(0.3, -0.2, 0.5)).toImplementation());
+  kindr::RotationQuaternion<PrimType_> rotation;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(quaternion);
+    rotation.toImplementation().coeffs() << quaternion.x(), quaternion.y(), quaternion.z(), quaternion.w();
+    benchmark::DoNotOptimize(rotation);
+  }
+}
+
+template <typename PrimType_>
+static void eigenQuaternionToKindr(benchmark::State& state) {
+  Eigen::Quaternion<PrimType_> quaternion(kindr::RotationQuaternion<PrimType_>(kindr::EulerAnglesZyx<PrimType_>(0.3, -0.2, 0.5)).toImplementation());
+  kindr::RotationQuaternion<PrimType_> rotation;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(quaternion);
+    rotation = kindr::toKindr(quaternion);
+    benchmark::DoNotOptimize(rotation);
+  }
+}
+
+template <typename PrimType_>
+static void eigenQuaternionMapAsKindr(benchmark::State& state) {
+  Eigen::Quaternion<PrimType_> quaternion(kindr::RotationQuaternion<PrimType_>(kindr::EulerAnglesZyx<PrimType_>(0.3, -0.2, 0.5)).toImplementation());
+  const Eigen::Matrix<PrimType_, 3, 1> vector(1.0, 2.0, 3.0);
+  Eigen::Matrix<PrimType_, 3, 1> rotated;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(quaternion);
+    rotated = kindr::mapAsKindr(quaternion).rotate(vector);
+    benchmark::DoNotOptimize(rotated);
+  }
+}
+
+template <typename PrimType_>
+static void eigenQuaternionRotateByHand(benchmark::State& state) {
+  Eigen::Quaternion<PrimType_> quaternion(kindr::RotationQuaternion<PrimType_>(kindr::EulerAnglesZyx<PrimType_>(0.3, -0.2, 0.5)).toImplementation());
+  const Eigen::Matrix<PrimType_, 3, 1> vector(1.0, 2.0, 3.0);
+  Eigen::Matrix<PrimType_, 3, 1> rotated;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(quaternion);
+    rotated = quaternion*vector;
+    benchmark::DoNotOptimize(rotated);
+  }
+}
+
+template <typename PrimType_>
+static void kindrToEigenQuaternion(benchmark::State& state) {
+  const kindr::RotationQuaternion<PrimType_> rotation(kindr::EulerAnglesZyx<PrimType_>(0.3, -0.2, 0.5));
+  Eigen::Quaternion<PrimType_> quaternion;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotation);
+    kindr::fromKindr(quaternion, rotation);
+    benchmark::DoNotOptimize(quaternion);
+  }
+}
+
+BENCHMARK_TEMPLATE(eigenQuaternionToKindrByHand, double);
+BENCHMARK_TEMPLATE(eigenQuaternionToKindr, double);
+BENCHMARK_TEMPLATE(eigenQuaternionRotateByHand, double);
+BENCHMARK_TEMPLATE(eigenQuaternionMapAsKindr, double);
+BENCHMARK_TEMPLATE(kindrToEigenQuaternion, double);
+BENCHMARK_TEMPLATE(eigenQuaternionToKindrByHand, float);
+BENCHMARK_TEMPLATE(eigenQuaternionToKindr, float);
+BENCHMARK_TEMPLATE(eigenQuaternionRotateByHand, float);
+BENCHMARK_TEMPLATE(eigenQuaternionMapAsKindr, float);
+BENCHMARK_TEMPLATE(kindrToEigenQuaternion, float);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/RotationQuaternionArray.hpp"
+
+/* Compares the batch operations of RotationQuaternionArray (structure of arrays) against a loop over a
+ * std::vector of rotation quaternions (array of structures) for a trajectory with state.range(0) samples.
+ */
+
+template <typename PrimType_>
+static std::vector<kindr::RotationQuaternion<PrimType_>> getBenchmarkRotations(int size) {
+  std::vector<kindr::RotationQuaternion<PrimType_>> rotations;
+  for (int i = 0; i < size; ++i) {
+    rotations.push_back(kindr::RotationQuaternion<PrimType_>(kindr::RotationVector<PrimType_>(Eigen::Matrix<PrimType_, 3, 1>::Random())));
+  }
+  return rotations;
+}
+
+template <typename PrimType_>
+static void multiplyArray(benchmark::State& state) {
+  const kindr::RotationQuaternionArray<PrimType_> lhs(getBenchmarkRotations<PrimType_>(state.range(0)));
+  const kindr::RotationQuaternionArray<PrimType_> rhs(getBenchmarkRotations<PrimType_>(state.range(0)));
+  kindr::RotationQuaternionArray<PrimType_> result;
+  for (auto _ : state) {
+    lhs.multiply(rhs, result);
+    benchmark::DoNotOptimize(result.toImplementation().data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename PrimType_>
+static void multiplyLoop(benchmark::State& state) {
+  const std::vector<kindr::RotationQuaternion<PrimType_>> lhs = getBenchmarkRotations<PrimType_>(state.range(0));
+  const std::vector<kindr::RotationQuaternion<PrimType_>> rhs = getBenchmarkRotations<PrimType_>(state.range(0));
+  std::vector<kindr::RotationQuaternion<PrimType_>> result(lhs.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < lhs.size(); ++i) {
+      result[i] = lhs[i]*rhs[i];
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename PrimType_>
+static void rotateArray(benchmark::State& state) {
+  const kindr::RotationQuaternionArray<PrimType_> rotations(getBenchmarkRotations<PrimType_>(state.range(0)));
+  const kindr::PositionArray<PrimType_> positions(Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>::Random(3, state.range(0)));
+  kindr::PositionArray<PrimType_> result;
+  for (auto _ : state) {
+    rotations.rotate(positions, result);
+    benchmark::DoNotOptimize(result.toImplementation().data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename PrimType_>
+static void rotateLoop(benchmark::State& state) {
+  const std::vector<kindr::RotationQuaternion<PrimType_>> rotations = getBenchmarkRotations<PrimType_>(state.range(0));
+  const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> positions = Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>::Random(3, state.range(0));
+  Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> result(3, state.range(0));
+  for (auto _ : state) {
+    for (size_t i = 0; i < rotations.size(); ++i) {
+      result.col(i) = rotations[i].rotate(Eigen::Matrix<PrimType_, 3, 1>(positions.col(i)));
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename PrimType_>
+static void logarithmicMapArray(benchmark::State& state) {
+  const kindr::RotationQuaternionArray<PrimType_> rotations(getBenchmarkRotations<PrimType_>(state.range(0)));
+  typename kindr::RotationQuaternionArray<PrimType_>::Matrix3X result;
+  for (auto _ : state) {
+    result = rotations.logarithmicMap();
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+template <typename PrimType_>
+static void logarithmicMapLoop(benchmark::State& state) {
+  const std::vector<kindr::RotationQuaternion<PrimType_>> rotations = getBenchmarkRotations<PrimType_>(state.range(0));
+  Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> result(3, state.range(0));
+  for (auto _ : state) {
+    for (size_t i = 0; i < rotations.size(); ++i) {
+      result.col(i) = rotations[i].logarithmicMap();
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+#define KINDR_ARRAY_BENCHMARKS(PrimType) \
+  BENCHMARK_TEMPLATE(multiplyArray, PrimType)->Arg(10000); \
+  BENCHMARK_TEMPLATE(multiplyLoop, PrimType)->Arg(10000); \
+  BENCHMARK_TEMPLATE(rotateArray, PrimType)->Arg(10000); \
+  BENCHMARK_TEMPLATE(rotateLoop, PrimType)->Arg(10000); \
+  BENCHMARK_TEMPLATE(logarithmicMapArray, PrimType)->Arg(10000); \
+  BENCHMARK_TEMPLATE(logarithmicMapLoop, PrimType)->Arg(10000);
+
+KINDR_ARRAY_BENCHMARKS(double)
+KINDR_ARRAY_BENCHMARKS(float)
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/Core"
+
+/* Compares the conversions with StandardTrigonometry, which are the ConversionTraits, and with FastTrigonometry,
+ * see kindr::convertRotation().
+ */
+
+template <typename From_, typename To_, typename Trigonometry_>
+static void convert(benchmark::State& state) {
+  From_ from = From_(kindr::EulerAnglesZyx<typename From_::Scalar>(0.3, -0.2, 0.5));
+  To_ to;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(from);
+    to = kindr::convertRotation<To_, Trigonometry_>(from);
+    benchmark::DoNotOptimize(to);
+  }
+}
+
+template <typename Scalar_, typename Trigonometry_>
+static void sincos(benchmark::State& state) {
+  Scalar_ angle = Scalar_(0.7), sine, cosine;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(angle);
+    Trigonometry_::sincos(angle, sine, cosine);
+    benchmark::DoNotOptimize(sine);
+    benchmark::DoNotOptimize(cosine);
+  }
+}
+
+template <typename Scalar_, typename Trigonometry_>
+static void atan2(benchmark::State& state) {
+  Scalar_ y = Scalar_(0.7), x = Scalar_(-0.4), angle;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(y);
+    benchmark::DoNotOptimize(x);
+    angle = Trigonometry_::atan2(y, x);
+    benchmark::DoNotOptimize(angle);
+  }
+}
+
+#define KINDR_TRIGONOMETRY_BENCHMARKS(PrimType, Trigonometry) \
+  BENCHMARK_TEMPLATE(sincos, PrimType, Trigonometry); \
+  BENCHMARK_TEMPLATE(atan2, PrimType, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::EulerAnglesZyx<PrimType>, kindr::RotationQuaternion<PrimType>, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::EulerAnglesZyx<PrimType>, kindr::RotationMatrix<PrimType>, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::RotationQuaternion<PrimType>, kindr::EulerAnglesZyx<PrimType>, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::RotationMatrix<PrimType>, kindr::EulerAnglesZyx<PrimType>, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::AngleAxis<PrimType>, kindr::RotationQuaternion<PrimType>, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::RotationQuaternion<PrimType>, kindr::AngleAxis<PrimType>, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::RotationVector<PrimType>, kindr::RotationQuaternion<PrimType>, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::RotationQuaternion<PrimType>, kindr::RotationVector<PrimType>, Trigonometry); \
+  BENCHMARK_TEMPLATE(convert, kindr::EulerAnglesZyx<PrimType>, kindr::AngleAxis<PrimType>, Trigonometry);
+
+KINDR_TRIGONOMETRY_BENCHMARKS(float, kindr::StandardTrigonometry)
+KINDR_TRIGONOMETRY_BENCHMARKS(float, kindr::FastTrigonometry)
+KINDR_TRIGONOMETRY_BENCHMARKS(double, kindr::StandardTrigonometry)
+KINDR_TRIGONOMETRY_BENCHMARKS(double, kindr::FastTrigonometry)
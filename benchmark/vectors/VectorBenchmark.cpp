@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/Core"
+
+/* Compares arithmetic on typed physical quantities with the same arithmetic on plain Eigen vectors. The physical types
+ * are resolved at compile time, hence both variants are expected to compile to identical code. The kernels are not
+ * inlined such that their code size can be compared with
+ *   nm -S -C --size-sort kindr_benchmarks | grep vector_benchmark
+ * or with the target kindr_vector_code_size.
+ */
+
+namespace vector_benchmark {
+
+__attribute__((noinline)) Eigen::Vector3d integrateEigen(const Eigen::Vector3d& position, const Eigen::Vector3d& velocity,
+                                                          const Eigen::Vector3d& time) {
+  return position + velocity.cwiseProduct(time);
+}
+
+__attribute__((noinline)) kindr::Position3D integrateTyped(const kindr::Position3D& position, const kindr::Velocity3D& velocity,
+                                                            const kindr::Time3D& time) {
+  return position + velocity.elementwiseMultiplication(time);
+}
+
+__attribute__((noinline)) Eigen::Vector3d powerEigen(const Eigen::Vector3d& force, const Eigen::Vector3d& velocity) {
+  return force.cwiseProduct(velocity);
+}
+
+__attribute__((noinline)) kindr::Vector<kindr::PhysicalType::Power, double, 3> powerTyped(const kindr::Force3D& force,
+                                                                                          const kindr::Velocity3D& velocity) {
+  return force.elementwiseMultiplication(velocity);
+}
+
+__attribute__((noinline)) void addEigenDynamic(Eigen::VectorXd& position, const Eigen::VectorXd& offset, double factor) {
+  position.noalias() += factor*offset;
+}
+
+__attribute__((noinline)) void addTypedDynamic(kindr::Position<double, Eigen::Dynamic>& position,
+                                               const kindr::Position<double, Eigen::Dynamic>& offset, double factor) {
+  position.addInPlace(offset, factor);
+}
+
+__attribute__((noinline)) void integrateEigenDynamic(Eigen::VectorXd& position, const Eigen::VectorXd& velocity,
+                                                     const Eigen::VectorXd& time) {
+  position.noalias() += velocity.cwiseProduct(time);
+}
+
+__attribute__((noinline)) void integrateTypedDynamicNoAlias(kindr::Position<double, Eigen::Dynamic>& position,
+                                                            const kindr::Velocity<double, Eigen::Dynamic>& velocity,
+                                                            const kindr::Time<double, Eigen::Dynamic>& time) {
+  position.noalias() += velocity.lazy().elementwiseMultiplication(time.lazy());
+}
+
+} // namespace vector_benchmark
+
+static void integrateEigen(benchmark::State& state) {
+  Eigen::Vector3d position(1.0, 2.0, 3.0);
+  const Eigen::Vector3d velocity(-0.5, 0.3, 2.0);
+  const Eigen::Vector3d time = Eigen::Vector3d::Constant(0.01);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(position);
+    position = vector_benchmark::integrateEigen(position, velocity, time);
+  }
+}
+
+static void integrateTyped(benchmark::State& state) {
+  kindr::Position3D position(1.0, 2.0, 3.0);
+  const kindr::Velocity3D velocity(-0.5, 0.3, 2.0);
+  const kindr::Time3D time(0.01, 0.01, 0.01);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(position);
+    position = vector_benchmark::integrateTyped(position, velocity, time);
+  }
+}
+
+static void powerEigen(benchmark::State& state) {
+  Eigen::Vector3d force(1.0, 2.0, 3.0);
+  const Eigen::Vector3d velocity(-0.5, 0.3, 2.0);
+  Eigen::Vector3d power;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(force);
+    power = vector_benchmark::powerEigen(force, velocity);
+    benchmark::DoNotOptimize(power);
+  }
+}
+
+static void powerTyped(benchmark::State& state) {
+  kindr::Force3D force(1.0, 2.0, 3.0);
+  const kindr::Velocity3D velocity(-0.5, 0.3, 2.0);
+  kindr::Vector<kindr::PhysicalType::Power, double, 3> power;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(force);
+    power = vector_benchmark::powerTyped(force, velocity);
+    benchmark::DoNotOptimize(power);
+  }
+}
+
+static void addEigenDynamic(benchmark::State& state) {
+  Eigen::VectorXd position = Eigen::VectorXd::Zero(state.range(0));
+  const Eigen::VectorXd offset = Eigen::VectorXd::Constant(state.range(0), 0.5);
+  for (auto _ : state) {
+    vector_benchmark::addEigenDynamic(position, offset, 0.01);
+    benchmark::DoNotOptimize(position.data());
+  }
+}
+
+static void addTypedDynamic(benchmark::State& state) {
+  kindr::Position<double, Eigen::Dynamic> position(static_cast<int>(state.range(0)));
+  const kindr::Position<double, Eigen::Dynamic> offset(Eigen::VectorXd::Constant(state.range(0), 0.5));
+  for (auto _ : state) {
+    vector_benchmark::addTypedDynamic(position, offset, 0.01);
+    benchmark::DoNotOptimize(position.toImplementation().data());
+  }
+}
+
+static void integrateEigenDynamic(benchmark::State& state) {
+  Eigen::VectorXd position = Eigen::VectorXd::Zero(state.range(0));
+  const Eigen::VectorXd velocity = Eigen::VectorXd::Constant(state.range(0), 0.5);
+  const Eigen::VectorXd time = Eigen::VectorXd::Constant(state.range(0), 0.01);
+  for (auto _ : state) {
+    vector_benchmark::integrateEigenDynamic(position, velocity, time);
+    benchmark::DoNotOptimize(position.data());
+  }
+}
+
+static void integrateTypedDynamicNoAlias(benchmark::State& state) {
+  kindr::Position<double, Eigen::Dynamic> position(static_cast<int>(state.range(0)));
+  const kindr::Velocity<double, Eigen::Dynamic> velocity(Eigen::VectorXd::Constant(state.range(0), 0.5));
+  const kindr::Time<double, Eigen::Dynamic> time(Eigen::VectorXd::Constant(state.range(0), 0.01));
+  for (auto _ : state) {
+    vector_benchmark::integrateTypedDynamicNoAlias(position, velocity, time);
+    benchmark::DoNotOptimize(position.toImplementation().data());
+  }
+}
+
+BENCHMARK(integrateEigen);
+BENCHMARK(integrateTyped);
+BENCHMARK(powerEigen);
+BENCHMARK(powerTyped);
+BENCHMARK(addEigenDynamic)->Arg(18)->Arg(100);
+BENCHMARK(addTypedDynamic)->Arg(18)->Arg(100);
+BENCHMARK(integrateEigenDynamic)->Arg(18)->Arg(100);
+BENCHMARK(integrateTypedDynamicNoAlias)->Arg(18)->Arg(100);
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "kindr/common/assert_macros.hpp"
+
+/*! \file Allocators.hpp
+ *  \brief Containers with aligned storage for kindr types and a monotonic arena for temporaries.
+ *
+ *  kindr types such as RotationQuaternion, HomogeneousTransformation or a 4D Vector wrap fixed-size Eigen members,
+ *  which must be aligned if they are vectorized. All of them declare EIGEN_MAKE_ALIGNED_OPERATOR_NEW, which covers
+ *  heap allocations with new. Standard containers have to use the aligned allocator, e.g. through AlignedVector and
+ *  AlignedMap. ArenaVector and ArenaMap allocate from a MonotonicArena instead, which is reset once per cycle of a
+ *  real-time loop and does not allocate once it has grown to the peak demand of a cycle.
+ */
+
+namespace kindr {
+
+//! std::vector with aligned storage, e.g. AlignedVector<HomTransformQuatD>
+template<typename T>
+using AlignedVector = std::vector<T, Eigen::aligned_allocator<T>>;
+
+//! std::map with aligned storage
+template<typename Key_, typename T, typename Compare_ = std::less<Key_>>
+using AlignedMap = std::map<Key_, T, Compare_, Eigen::aligned_allocator<std::pair<const Key_, T>>>;
+
+
+/*! \class MonotonicArena
+ * \brief Memory arena that hands out aligned memory by bumping a pointer and releases it all at once.
+ *
+ *  Deallocation is a no-op, the memory is reused only after reset(). If a block is exhausted, a new block of at least
+ *  twice the size is allocated. reset() then merges the blocks into a single block of the total capacity, such that
+ *  the next cycle with the same allocations runs without touching the heap. The arena is not thread-safe.
+ * \ingroup common
+ */
+class MonotonicArena {
+ public:
+  /*! \brief Constructor.
+   *  \param capacity   initial capacity in bytes
+   */
+  explicit MonotonicArena(std::size_t capacity = 65536) {
+    addBlock(capacity);
+  }
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator =(const MonotonicArena&) = delete;
+
+  ~MonotonicArena() {
+    release();
+  }
+
+  /*! \brief Allocates memory.
+   *  \param size        number of bytes
+   *  \param alignment   alignment in bytes, must be a power of two
+   *  \returns pointer to the memory
+   */
+  void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, alignment > 0 && (alignment & (alignment - 1)) == 0, "The alignment must be a power of two.");
+    Block& block = blocks_.back();
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(block.data_);
+    const std::uintptr_t aligned = (begin + block.offset_ + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    if (aligned + size > begin + block.size_) {
+      const std::size_t doubled = 2*block.size_;
+      addBlock(doubled > size + alignment ? doubled : size + alignment);
+      return allocate(size, alignment);
+    }
+    block.offset_ = aligned + size - begin;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  /*! \brief Does nothing, the memory is released by reset().
+   */
+  inline void deallocate(void* /*pointer*/, std::size_t /*size*/) {
+  }
+
+  /*! \brief Releases all allocations.
+   *  If the arena has grown, its blocks are replaced by a single block of the total capacity.
+   */
+  void reset() {
+    if (blocks_.size() > 1) {
+      const std::size_t capacity = getCapacity();
+      release();
+      addBlock(capacity);
+    } else {
+      blocks_.back().offset_ = 0;
+    }
+  }
+
+  /*! \brief Gets the capacity of all blocks.
+   *  \returns the capacity in bytes
+   */
+  std::size_t getCapacity() const {
+    std::size_t capacity = 0;
+    for (const Block& block : blocks_) {
+      capacity += block.size_;
+    }
+    return capacity;
+  }
+
+  /*! \brief Gets the number of blocks, which is one unless the arena has grown since the last reset().
+   *  \returns the number of blocks
+   */
+  inline int getNumBlocks() const {
+    return static_cast<int>(blocks_.size());
+  }
+
+ protected:
+  struct Block {
+    char* data_;
+    std::size_t size_;
+    std::size_t offset_;
+  };
+
+  void addBlock(std::size_t size) {
+    Block block;
+    block.data_ = static_cast<char*>(Eigen::internal::aligned_malloc(size));
+    block.size_ = size;
+    block.offset_ = 0;
+    blocks_.push_back(block);
+  }
+
+  void release() {
+    for (const Block& block : blocks_) {
+      Eigen::internal::aligned_free(block.data_);
+    }
+    blocks_.clear();
+  }
+
+  std::vector<Block> blocks_;
+};
+
+
+/*! \class ArenaAllocator
+ * \brief Standard allocator which allocates from a MonotonicArena with the alignment of the type.
+ * \ingroup common
+ */
+template<typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept
+      : arena_(&arena) {
+  }
+
+  template<typename OtherT_>
+  ArenaAllocator(const ArenaAllocator<OtherT_>& other) noexcept
+      : arena_(other.getArena()) {
+  }
+
+  inline T* allocate(std::size_t n) {
+    return static_cast<T*>(arena_->allocate(n*sizeof(T), alignof(T)));
+  }
+
+  inline void deallocate(T* pointer, std::size_t n) noexcept {
+    arena_->deallocate(pointer, n*sizeof(T));
+  }
+
+  inline MonotonicArena* getArena() const noexcept {
+    return arena_;
+  }
+
+ protected:
+  MonotonicArena* arena_;
+};
+
+template<typename T, typename OtherT_>
+inline bool operator ==(const ArenaAllocator<T>& lhs, const ArenaAllocator<OtherT_>& rhs) noexcept {
+  return lhs.getArena() == rhs.getArena();
+}
+
+template<typename T, typename OtherT_>
+inline bool operator !=(const ArenaAllocator<T>& lhs, const ArenaAllocator<OtherT_>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+//! std::vector allocating from a MonotonicArena, e.g. ArenaVector<RotationQuaternionD> rotations(ArenaAllocator<RotationQuaternionD>(arena));
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+//! std::map allocating from a MonotonicArena
+template<typename Key_, typename T, typename Compare_ = std::less<Key_>>
+using ArenaMap = std::map<Key_, T, Compare_, ArenaAllocator<std::pair<const Key_, T>>>;
+
+} // namespace kindr
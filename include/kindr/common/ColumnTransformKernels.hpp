@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include <Eigen/Core>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+
+namespace kindr {
+namespace internal {
+
+/*! \class ColumnTransformKernels
+ *  \brief Computes R*p + t for the columns p of a large 3xN matrix.
+ *
+ *  The columns are split into chunks for an executor. A chunk is computed in a single pass with one Eigen product,
+ *  fused with the column-wise addition of the translation unless it is zero. If the output aliases the input, the chunk
+ *  is computed in tiles of TileSize columns through a fixed-size temporary on the stack, which is read completely
+ *  before it is written.
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class ColumnTransformKernels {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> Matrix3X;
+
+  //! Number of columns of a tile, the tile fits into the L1 cache
+  enum { TileSize = 256 };
+
+  //! Minimum number of columns of a chunk that is handed to an executor
+  enum { GrainSize = 64*TileSize };
+
+  /*! \brief Transforms the columns [begin, end).
+   *  \param rotationMatrix          rotation matrix R
+   *  \param translation             translation t
+   *  \param positions               first coefficient of the input
+   *  \param positionsStride         distance between two input columns
+   *  \param transformed             first coefficient of the output
+   *  \param transformedStride       distance between two output columns
+   */
+  static void transform(const Matrix3& rotationMatrix, const Vector3& translation,
+                        const Scalar* positions, int positionsStride, Scalar* transformed, int transformedStride,
+                        int begin, int end) {
+    typedef Eigen::Map<const Matrix3X, 0, Eigen::OuterStride<>> InputMap;
+    typedef Eigen::Map<Matrix3X, 0, Eigen::OuterStride<>> OutputMap;
+    const int size = end - begin;
+    if (size <= 0) {
+      return;
+    }
+    const Scalar* source = positions + static_cast<std::ptrdiff_t>(begin)*positionsStride;
+    Scalar* destination = transformed + static_cast<std::ptrdiff_t>(begin)*transformedStride;
+    const InputMap input(source, 3, size, Eigen::OuterStride<>(positionsStride));
+    OutputMap output(destination, 3, size, Eigen::OuterStride<>(transformedStride));
+    const Scalar* inputEnd = source + static_cast<std::ptrdiff_t>(size - 1)*positionsStride + 3;
+    const Scalar* outputEnd = destination + static_cast<std::ptrdiff_t>(size - 1)*transformedStride + 3;
+    const bool aliased = source < outputEnd && destination < inputEnd;
+    const bool translate = !translation.isZero(0);
+
+    if (!aliased) {
+      if (positionsStride == 3 && transformedStride == 3) {
+        assign(Eigen::Map<Matrix3X>(destination, 3, size), rotationMatrix, Eigen::Map<const Matrix3X>(source, 3, size), translation, translate);
+      } else {
+        assign(output, rotationMatrix, input, translation, translate);
+      }
+      return;
+    }
+
+    typedef Eigen::Matrix<PrimType_, 3, TileSize> Tile;
+    Tile tile;
+    for (int start = 0; start < size; start += TileSize) {
+      const int length = std::min<int>(TileSize, size - start);
+      if (length == TileSize) {
+        assign(tile, rotationMatrix, input.template middleCols<TileSize>(start), translation, translate);
+      } else {
+        assign(tile.leftCols(length), rotationMatrix, input.middleCols(start, length), translation, translate);
+      }
+      output.middleCols(start, length) = tile.leftCols(length);
+    }
+  }
+
+  /*! \brief Transforms all columns of a matrix, the chunks of columns are distributed by an executor.
+   *  \param rotationMatrix   rotation matrix R
+   *  \param translation      translation t
+   *  \param positions        3xN matrix of positions
+   *  \param transformed      3xN matrix of transformed positions, may be positions itself
+   *  \param executor         executor, see SerialExecutor
+   */
+  template<typename Executor_>
+  static void transform(const Matrix3& rotationMatrix, const Vector3& translation,
+                        const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed,
+                        const Executor_& executor) {
+    KINDR_ASSERT_TRUE(std::runtime_error, positions.cols() == transformed.cols(), "The number of positions and transformed positions must be equal.");
+    const Scalar* input = positions.data();
+    Scalar* output = transformed.data();
+    const int inputStride = static_cast<int>(positions.outerStride());
+    const int outputStride = static_cast<int>(transformed.outerStride());
+    executor.parallelFor(0, static_cast<int>(positions.cols()), GrainSize, [&](int begin, int end) {
+      transform(rotationMatrix, translation, input, inputStride, output, outputStride, begin, end);
+    });
+  }
+
+ private:
+  /*! \brief Assigns R*p + t to the columns of the destination.
+   *  The coefficient-based product is fused with the translation into a single pass over the columns, which is faster
+   *  than Eigen's blocked product followed by a second pass for the translation.
+   */
+  template<typename Destination_, typename Source_>
+  inline static void assign(Destination_&& destination, const Matrix3& rotationMatrix, const Source_& source,
+                            const Vector3& translation, bool translate) {
+    if (translate) {
+      destination.noalias() = rotationMatrix.lazyProduct(source).colwise() + translation;
+    } else {
+      destination.noalias() = rotationMatrix.lazyProduct(source);
+    }
+  }
+};
+
+} // namespace internal
+} // namespace kindr
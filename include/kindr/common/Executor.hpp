@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kindr {
+
+/*! \class SerialExecutor
+ *  \brief Executes a range of work items on the calling thread.
+ *
+ *  The batch operations of kindr distribute their work with an executor. An executor is any class with the method
+ *
+ *      template<typename Function_> void parallelFor(int begin, int end, int grainSize, const Function_& function) const;
+ *
+ *  which calls function(chunkBegin, chunkEnd) for disjoint chunks covering [begin, end), each with at least grainSize
+ *  items except for the last one, and returns when all chunks are done. The chunks may run concurrently, the function
+ *  must not throw. A thin wrapper with this method lets the batch operations run on the task system of an application.
+ *
+ *  kindr provides the SerialExecutor (default), the OpenMpExecutor (if compiled with OpenMP) and the ThreadPoolExecutor.
+ */
+class SerialExecutor {
+ public:
+  template<typename Function_>
+  void parallelFor(int begin, int end, int /*grainSize*/, const Function_& function) const {
+    if (begin < end) {
+      function(begin, end);
+    }
+  }
+};
+
+#ifdef _OPENMP
+/*! \class OpenMpExecutor
+ *  \brief Executes the chunks of a range on the OpenMP thread team with dynamic scheduling.
+ *  Only available if the code is compiled with OpenMP support.
+ */
+class OpenMpExecutor {
+ public:
+  template<typename Function_>
+  void parallelFor(int begin, int end, int grainSize, const Function_& function) const {
+    grainSize = std::max(1, grainSize);
+    const int numChunks = (end - begin + grainSize - 1)/grainSize;
+    #pragma omp parallel for schedule(dynamic)
+    for (int chunk = 0; chunk < numChunks; ++chunk) {
+      const int chunkBegin = begin + chunk*grainSize;
+      function(chunkBegin, std::min(end, chunkBegin + grainSize));
+    }
+  }
+};
+#endif
+
+/*! \class ThreadPoolExecutor
+ *  \brief Executes the chunks of a range on a fixed pool of threads with work stealing.
+ *
+ *  The chunks of a call are dealt to the queues of the workers. A worker takes chunks from the front of its own queue
+ *  and steals from the back of the other queues when its queue is empty. The calling thread takes part in the work
+ *  until all chunks of its call are done, hence nested calls from within a chunk do not deadlock.
+ *  The pool is created once and should be shared, e.g. one pool with one thread per core for the whole application,
+ *  such that the cores are not oversubscribed.
+ */
+class ThreadPoolExecutor {
+ public:
+  /*! \brief Constructor starting the workers.
+   *  \param numThreads   number of threads including the calling thread, 0 for the number of hardware threads
+   */
+  explicit ThreadPoolExecutor(int numThreads = 0)
+    : numThreads_(numThreads > 0 ? numThreads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()))),
+      numQueuedTasks_(0),
+      stop_(false) {
+    for (int i = 0; i < numThreads_ - 1; ++i) {
+      queues_.emplace_back(new Queue());
+    }
+    for (int i = 0; i < numThreads_ - 1; ++i) {
+      workers_.emplace_back([this, i]() { work(i); });
+    }
+  }
+
+  ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+  ThreadPoolExecutor& operator =(const ThreadPoolExecutor&) = delete;
+
+  /*! \brief Destructor joining the workers.
+   */
+  ~ThreadPoolExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /*! \brief Gets the number of threads including the calling thread.
+   *  \returns number of threads
+   */
+  inline int getNumThreads() const {
+    return numThreads_;
+  }
+
+  template<typename Function_>
+  void parallelFor(int begin, int end, int grainSize, const Function_& function) const {
+    if (begin >= end) {
+      return;
+    }
+    grainSize = std::max(1, grainSize);
+    const int numChunks = (end - begin + grainSize - 1)/grainSize;
+    if (queues_.empty() || numChunks == 1) {
+      function(begin, end);
+      return;
+    }
+    Job job;
+    job.function = &function;
+    job.invoke = [](const void* f, int chunkBegin, int chunkEnd) { (*static_cast<const Function_*>(f))(chunkBegin, chunkEnd); };
+    job.numRemainingTasks = numChunks;
+    for (int chunk = 0; chunk < numChunks; ++chunk) {
+      const int chunkBegin = begin + chunk*grainSize;
+      Queue& queue = *queues_[chunk % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(Task{&job, chunkBegin, std::min(end, chunkBegin + grainSize)});
+      ++numQueuedTasks_;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+    }
+    condition_.notify_all();
+
+    // help until the own chunks are done
+    Task task;
+    while (job.numRemainingTasks.load() > 0) {
+      if (pop(-1, task)) {
+        run(task);
+      } else {
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.condition.wait(lock, [&job]() { return job.numRemainingTasks.load() == 0; });
+      }
+    }
+    // wait until the thread that finished the last chunk has released the job
+    std::lock_guard<std::mutex> lock(job.mutex);
+  }
+
+ private:
+  struct Job {
+    const void* function;
+    void (*invoke)(const void*, int, int);
+    std::atomic<int> numRemainingTasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+  };
+
+  struct Task {
+    Job* job;
+    int begin;
+    int end;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  //! Takes a task from the front of the own queue or steals one from the back of another queue
+  bool pop(int index, Task& task) const {
+    const int numQueues = static_cast<int>(queues_.size());
+    for (int k = 0; k < numQueues; ++k) {
+      const int other = (index < 0) ? k : (index + k) % numQueues;
+      Queue& queue = *queues_[other];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        if (other == index) {
+          task = queue.tasks.front();
+          queue.tasks.pop_front();
+        } else {
+          task = queue.tasks.back();
+          queue.tasks.pop_back();
+        }
+        --numQueuedTasks_;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void run(const Task& task) {
+    Job& job = *task.job;
+    job.invoke(job.function, task.begin, task.end);
+    // the job must not be touched after the mutex is released, the calling thread may return immediately
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (--job.numRemainingTasks == 0) {
+      job.condition.notify_all();
+    }
+  }
+
+  void work(int index) const {
+    Task task;
+    while (true) {
+      if (pop(index, task)) {
+        run(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() { return stop_ || numQueuedTasks_.load() > 0; });
+      if (stop_ && numQueuedTasks_.load() == 0) {
+        return;
+      }
+    }
+  }
+
+  int numThreads_;
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  mutable std::atomic<int> numQueuedTasks_;
+  mutable std::mutex mutex_;
+  mutable std::condition_variable condition_;
+  bool stop_;
+};
+
+} // namespace kindr
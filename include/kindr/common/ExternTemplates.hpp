@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+/* Explicit instantiations of the rotations, time derivatives, physical quantities, poses and conversions for double and
+ * float, which are compiled once into the optional library kindr_instantiations (CMake option BUILD_KINDR_LIBRARY).
+ *
+ * A translation unit which defines KINDR_USE_PRECOMPILED_INSTANTIATIONS before including kindr/Core declares them as
+ * extern templates, such that the compiler does not instantiate the members again and the program has to be linked
+ * against kindr_instantiations. With optimization, the compiler may still instantiate inline members for inlining.
+ */
+
+/*! \brief Applies the macros to the class templates and conversion traits which are instantiated for a primitive type.
+ *  \param CLASS_        macro taking the class template and the primitive type
+ *  \param VECTOR_       macro taking the physical type of a 3D vector and the primitive type
+ *  \param POSE_         macro taking the rotation of a homogeneous transformation with a 3D position and the primitive type
+ *  \param CONVERSION_   macro taking the destination and the source rotation and the primitive type
+ *  \param PrimType_     primitive type
+ */
+#define KINDR_FOR_EACH_PRECOMPILED_TEMPLATE(CLASS_, VECTOR_, POSE_, CONVERSION_, PrimType_) \
+  CLASS_(AngleAxis, PrimType_) \
+  CLASS_(RotationVector, PrimType_) \
+  CLASS_(RotationQuaternion, PrimType_) \
+  CLASS_(RotationMatrix, PrimType_) \
+  CLASS_(EulerAnglesZyx, PrimType_) \
+  CLASS_(EulerAnglesXyz, PrimType_) \
+  CLASS_(LocalAngularVelocity, PrimType_) \
+  CLASS_(GlobalAngularVelocity, PrimType_) \
+  CLASS_(RotationQuaternionDiff, PrimType_) \
+  CLASS_(RotationMatrixDiff, PrimType_) \
+  CLASS_(EulerAnglesZyxDiff, PrimType_) \
+  CLASS_(EulerAnglesXyzDiff, PrimType_) \
+  VECTOR_(Typeless, PrimType_) \
+  VECTOR_(Time, PrimType_) \
+  VECTOR_(Position, PrimType_) \
+  VECTOR_(Velocity, PrimType_) \
+  VECTOR_(Acceleration, PrimType_) \
+  VECTOR_(AngularVelocity, PrimType_) \
+  VECTOR_(AngularAcceleration, PrimType_) \
+  VECTOR_(Force, PrimType_) \
+  VECTOR_(Torque, PrimType_) \
+  VECTOR_(Momentum, PrimType_) \
+  VECTOR_(AngularMomentum, PrimType_) \
+  POSE_(RotationQuaternion, PrimType_) \
+  POSE_(RotationMatrix, PrimType_) \
+  CONVERSION_(AngleAxis, AngleAxis, PrimType_) \
+  CONVERSION_(AngleAxis, RotationVector, PrimType_) \
+  CONVERSION_(AngleAxis, RotationQuaternion, PrimType_) \
+  CONVERSION_(AngleAxis, RotationMatrix, PrimType_) \
+  CONVERSION_(AngleAxis, EulerAnglesXyz, PrimType_) \
+  CONVERSION_(AngleAxis, EulerAnglesZyx, PrimType_) \
+  CONVERSION_(RotationVector, RotationVector, PrimType_) \
+  CONVERSION_(RotationVector, AngleAxis, PrimType_) \
+  CONVERSION_(RotationVector, RotationQuaternion, PrimType_) \
+  CONVERSION_(RotationVector, RotationMatrix, PrimType_) \
+  CONVERSION_(RotationQuaternion, AngleAxis, PrimType_) \
+  CONVERSION_(RotationQuaternion, RotationVector, PrimType_) \
+  CONVERSION_(RotationQuaternion, RotationQuaternion, PrimType_) \
+  CONVERSION_(RotationQuaternion, RotationMatrix, PrimType_) \
+  CONVERSION_(RotationQuaternion, EulerAnglesXyz, PrimType_) \
+  CONVERSION_(RotationQuaternion, EulerAnglesZyx, PrimType_) \
+  CONVERSION_(RotationMatrix, AngleAxis, PrimType_) \
+  CONVERSION_(RotationMatrix, RotationVector, PrimType_) \
+  CONVERSION_(RotationMatrix, RotationQuaternion, PrimType_) \
+  CONVERSION_(RotationMatrix, RotationMatrix, PrimType_) \
+  CONVERSION_(RotationMatrix, EulerAnglesXyz, PrimType_) \
+  CONVERSION_(RotationMatrix, EulerAnglesZyx, PrimType_) \
+  CONVERSION_(EulerAnglesZyx, AngleAxis, PrimType_) \
+  CONVERSION_(EulerAnglesZyx, RotationVector, PrimType_) \
+  CONVERSION_(EulerAnglesZyx, RotationQuaternion, PrimType_) \
+  CONVERSION_(EulerAnglesZyx, RotationMatrix, PrimType_) \
+  CONVERSION_(EulerAnglesZyx, EulerAnglesXyz, PrimType_) \
+  CONVERSION_(EulerAnglesZyx, EulerAnglesZyx, PrimType_) \
+  CONVERSION_(EulerAnglesXyz, AngleAxis, PrimType_) \
+  CONVERSION_(EulerAnglesXyz, RotationVector, PrimType_) \
+  CONVERSION_(EulerAnglesXyz, RotationQuaternion, PrimType_) \
+  CONVERSION_(EulerAnglesXyz, RotationMatrix, PrimType_) \
+  CONVERSION_(EulerAnglesXyz, EulerAnglesXyz, PrimType_) \
+  CONVERSION_(EulerAnglesXyz, EulerAnglesZyx, PrimType_)
+
+/*! \brief Applies the macros to the instantiations for double and float, see KINDR_FOR_EACH_PRECOMPILED_TEMPLATE.
+ */
+#define KINDR_FOR_EACH_PRECOMPILED_INSTANTIATION(CLASS_, VECTOR_, POSE_, CONVERSION_) \
+  KINDR_FOR_EACH_PRECOMPILED_TEMPLATE(CLASS_, VECTOR_, POSE_, CONVERSION_, double) \
+  KINDR_FOR_EACH_PRECOMPILED_TEMPLATE(CLASS_, VECTOR_, POSE_, CONVERSION_, float)
+
+#ifdef KINDR_USE_PRECOMPILED_INSTANTIATIONS
+
+#define KINDR_EXTERN_CLASS(Class_, PrimType_) extern template class Class_<PrimType_>;
+#define KINDR_EXTERN_VECTOR(PhysicalType_, PrimType_) extern template class Vector<PhysicalType::PhysicalType_, PrimType_, 3>;
+#define KINDR_EXTERN_POSE(Rotation_, PrimType_) extern template class HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, Rotation_<PrimType_>>;
+#define KINDR_EXTERN_CONVERSION(Dest_, Source_, PrimType_) extern template class internal::ConversionTraits<Dest_<PrimType_>, Source_<PrimType_>>;
+
+namespace kindr {
+KINDR_FOR_EACH_PRECOMPILED_INSTANTIATION(KINDR_EXTERN_CLASS, KINDR_EXTERN_VECTOR, KINDR_EXTERN_POSE, KINDR_EXTERN_CONVERSION)
+} // namespace kindr
+
+#undef KINDR_EXTERN_CLASS
+#undef KINDR_EXTERN_VECTOR
+#undef KINDR_EXTERN_POSE
+#undef KINDR_EXTERN_CONVERSION
+
+#endif
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "kindr/common/assert_macros.hpp"
+
+#ifdef KINDR_ENABLE_INSTRUMENTATION_TIMING
+#ifndef KINDR_ENABLE_INSTRUMENTATION
+#define KINDR_ENABLE_INSTRUMENTATION
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+/*! \file Instrumentation.hpp
+ *
+ *  Opt-in counters of the operations in the central traits dispatch, e.g. to find out how many conversions a control
+ *  cycle triggers. If KINDR_ENABLE_INSTRUMENTATION is defined (CMake option KINDR_ENABLE_INSTRUMENTATION), every
+ *  instrumented operation increments a counter of the calling thread. If KINDR_ENABLE_INSTRUMENTATION_TIMING is
+ *  defined as well, the ticks spent in the operation are accumulated, which are read with rdtsc on x86 and from
+ *  std::chrono::steady_clock otherwise. The ticks of nested operations are included in the outer ones, e.g. the
+ *  conversions of a multiplication round trip. Without these definitions, KINDR_INSTRUMENT expands to nothing and the
+ *  counters stay zero. The definitions must be the same in all translation units of a program.
+ *
+ *  The counters are thread-local, such that they are updated and read without locks. A thread reads its own counters
+ *  with getThreadInstrumentationCounters(), e.g. at the end of each cycle, and can install a hook which is called
+ *  with the signature of the instrumented function, e.g. to record the call sites of multiplication round trips.
+ */
+
+namespace kindr {
+
+//! Instrumented operations
+enum class InstrumentedOperation {
+  //! conversion between two parameterizations of a rotation
+  Conversion = 0,
+  //! fix() of a rotation, e.g. the normalization of a quaternion
+  Fixing,
+  //! getUnique() of a rotation
+  Unique,
+  //! multiplication of two rotations via an intermediate parameterization, i.e. with conversions
+  MultiplicationRoundTrip,
+  NumOperations
+};
+
+/*! \class InstrumentationCounters
+ *  \brief Number of calls and ticks spent per instrumented operation.
+ */
+class InstrumentationCounters {
+ public:
+  enum { NumOperations = static_cast<int>(InstrumentedOperation::NumOperations) };
+
+  InstrumentationCounters() {
+    reset();
+  }
+
+  //! Sets all counters to zero
+  void reset() {
+    for (int i = 0; i < NumOperations; ++i) {
+      counts_[i] = 0;
+      ticks_[i] = 0;
+    }
+  }
+
+  //! \returns the number of calls of an operation
+  inline std::uint64_t getCount(InstrumentedOperation operation) const {
+    return counts_[static_cast<int>(operation)];
+  }
+
+  //! \returns the ticks spent in an operation, which are only counted with KINDR_ENABLE_INSTRUMENTATION_TIMING
+  inline std::uint64_t getTicks(InstrumentedOperation operation) const {
+    return ticks_[static_cast<int>(operation)];
+  }
+
+  inline void add(InstrumentedOperation operation, std::uint64_t count, std::uint64_t ticks) {
+    counts_[static_cast<int>(operation)] += count;
+    ticks_[static_cast<int>(operation)] += ticks;
+  }
+
+  /*! \brief Gets the counts since an earlier snapshot of the counters, e.g. of one control cycle.
+   *  \param other   earlier snapshot
+   *  \returns difference
+   */
+  InstrumentationCounters operator -(const InstrumentationCounters& other) const {
+    InstrumentationCounters difference;
+    for (int i = 0; i < NumOperations; ++i) {
+      difference.counts_[i] = counts_[i] - other.counts_[i];
+      difference.ticks_[i] = ticks_[i] - other.ticks_[i];
+    }
+    return difference;
+  }
+
+ private:
+  std::uint64_t counts_[NumOperations];
+  std::uint64_t ticks_[NumOperations];
+};
+
+/*! \brief Hook which is called by the instrumented operations of a thread.
+ *  \param operation   operation
+ *  \param function    signature of the instrumented function, which contains the types involved
+ */
+typedef void (*InstrumentationHook)(InstrumentedOperation operation, const char* function);
+
+namespace internal {
+
+struct InstrumentationState {
+  InstrumentationCounters counters_;
+  InstrumentationHook hook_ = nullptr;
+};
+
+inline InstrumentationState& getThreadInstrumentationState() {
+  static thread_local InstrumentationState state;
+  return state;
+}
+
+} // namespace internal
+
+//! \returns true if kindr was compiled with KINDR_ENABLE_INSTRUMENTATION
+constexpr bool isInstrumentationEnabled() {
+#ifdef KINDR_ENABLE_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+//! \returns the counters of the calling thread
+inline const InstrumentationCounters& getThreadInstrumentationCounters() {
+  return internal::getThreadInstrumentationState().counters_;
+}
+
+//! Sets the counters of the calling thread to zero
+inline void resetThreadInstrumentationCounters() {
+  internal::getThreadInstrumentationState().counters_.reset();
+}
+
+/*! \brief Installs a hook for the instrumented operations of the calling thread.
+ *  \param hook   hook or nullptr to remove it
+ */
+inline void setThreadInstrumentationHook(InstrumentationHook hook) {
+  internal::getThreadInstrumentationState().hook_ = hook;
+}
+
+namespace internal {
+
+#ifdef KINDR_ENABLE_INSTRUMENTATION
+/*! \class InstrumentationScope
+ *  \brief Counts an operation on construction and accumulates its ticks on destruction.
+ */
+class InstrumentationScope {
+ public:
+  inline InstrumentationScope(InstrumentedOperation operation, const char* function)
+    : operation_(operation) {
+    InstrumentationState& state = getThreadInstrumentationState();
+    if (KINDR_UNLIKELY(state.hook_ != nullptr)) {
+      state.hook_(operation, function);
+    }
+#ifdef KINDR_ENABLE_INSTRUMENTATION_TIMING
+    start_ = getTicks();
+#else
+    state.counters_.add(operation_, 1, 0);
+#endif
+  }
+
+#ifdef KINDR_ENABLE_INSTRUMENTATION_TIMING
+  inline ~InstrumentationScope() {
+    getThreadInstrumentationState().counters_.add(operation_, 1, getTicks() - start_);
+  }
+
+  inline static std::uint64_t getTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+  }
+#endif
+
+ private:
+  InstrumentedOperation operation_;
+#ifdef KINDR_ENABLE_INSTRUMENTATION_TIMING
+  std::uint64_t start_;
+#endif
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KINDR_INSTRUMENT(OPERATION) \
+  const kindr::internal::InstrumentationScope kindr_instrumentation_scope(kindr::InstrumentedOperation::OPERATION, __PRETTY_FUNCTION__)
+#else
+#define KINDR_INSTRUMENT(OPERATION) \
+  const kindr::internal::InstrumentationScope kindr_instrumentation_scope(kindr::InstrumentedOperation::OPERATION, __FUNCTION__)
+#endif
+#else
+//! Instruments the enclosing scope as an operation, expands to nothing without KINDR_ENABLE_INSTRUMENTATION
+#define KINDR_INSTRUMENT(OPERATION)
+#endif
+
+} // namespace internal
+} // namespace kindr
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include <Eigen/Core>
+
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/phys_quant/Wrench.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Twist.hpp"
+#include "kindr/rotations/RotationQuaternion.hpp"
+#include "kindr/rotations/RotationMatrix.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+/*! \class SeqLockTraits
+ *  \brief Flattens a fixed-size value into an array of scalars, which is the trivially copyable layout stored by a SeqLock.
+ *
+ *  Specializations exist for fixed-size Eigen matrices, vectors, rotation quaternions and matrices, homogeneous
+ *  transformations, twists with angular velocities, wrenches and std::pair of those with the same scalar, e.g. a pose
+ *  and a twist. Other types can be published by specializing the traits.
+ *  (only for advanced users)
+ */
+template<typename Value_>
+class SeqLockTraits {
+ public:
+//  typedef ... Scalar;
+//  enum { Size = ... };
+//  inline static void get(const Value_& value, Scalar* coefficients);
+//  inline static void set(Value_& value, const Scalar* coefficients);
+};
+
+template<typename PrimType_, int Rows_, int Cols_, int Options_, int MaxRows_, int MaxCols_>
+class SeqLockTraits<Eigen::Matrix<PrimType_, Rows_, Cols_, Options_, MaxRows_, MaxCols_>> {
+  typedef Eigen::Matrix<PrimType_, Rows_, Cols_, Options_, MaxRows_, MaxCols_> Matrix;
+  static_assert(Rows_ != Eigen::Dynamic && Cols_ != Eigen::Dynamic, "Only fixed-size matrices can be stored in a SeqLock.");
+ public:
+  typedef PrimType_ Scalar;
+  enum { Size = Rows_*Cols_ };
+  inline static void get(const Matrix& value, Scalar* coefficients) {
+    Eigen::Map<Matrix> map(coefficients);
+    map = value;
+  }
+  inline static void set(Matrix& value, const Scalar* coefficients) {
+    value = Eigen::Map<const Matrix>(coefficients);
+  }
+};
+
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_>
+class SeqLockTraits<Vector<PhysicalType_, PrimType_, Dimension_>> {
+  typedef SeqLockTraits<Eigen::Matrix<PrimType_, Dimension_, 1>> ImplementationTraits;
+ public:
+  typedef PrimType_ Scalar;
+  enum { Size = Dimension_ };
+  inline static void get(const Vector<PhysicalType_, PrimType_, Dimension_>& value, Scalar* coefficients) {
+    ImplementationTraits::get(value.toImplementation(), coefficients);
+  }
+  inline static void set(Vector<PhysicalType_, PrimType_, Dimension_>& value, const Scalar* coefficients) {
+    ImplementationTraits::set(value.toImplementation(), coefficients);
+  }
+};
+
+template<typename PrimType_>
+class SeqLockTraits<RotationQuaternion<PrimType_>> {
+  typedef SeqLockTraits<Eigen::Matrix<PrimType_, 4, 1>> ImplementationTraits;
+ public:
+  typedef PrimType_ Scalar;
+  enum { Size = 4 };
+  inline static void get(const RotationQuaternion<PrimType_>& value, Scalar* coefficients) {
+    ImplementationTraits::get(value.toImplementation().coeffs(), coefficients);
+  }
+  inline static void set(RotationQuaternion<PrimType_>& value, const Scalar* coefficients) {
+    value.toImplementation().coeffs() = Eigen::Map<const Eigen::Matrix<PrimType_, 4, 1>>(coefficients);
+  }
+};
+
+template<typename PrimType_>
+class SeqLockTraits<RotationMatrix<PrimType_>> {
+  typedef SeqLockTraits<Eigen::Matrix<PrimType_, 3, 3>> ImplementationTraits;
+ public:
+  typedef PrimType_ Scalar;
+  enum { Size = 9 };
+  inline static void get(const RotationMatrix<PrimType_>& value, Scalar* coefficients) {
+    ImplementationTraits::get(value.toImplementation(), coefficients);
+  }
+  inline static void set(RotationMatrix<PrimType_>& value, const Scalar* coefficients) {
+    ImplementationTraits::set(value.toImplementation(), coefficients);
+  }
+};
+
+/*! \brief Concatenates the coefficients of two values with the same scalar.
+ *
+ *  (only for advanced users)
+ */
+template<typename First_, typename Second_>
+class SeqLockPairTraits {
+  typedef SeqLockTraits<First_> FirstTraits;
+  typedef SeqLockTraits<Second_> SecondTraits;
+  static_assert(std::is_same<typename FirstTraits::Scalar, typename SecondTraits::Scalar>::value, "The values of a SeqLock must have the same scalar.");
+ public:
+  typedef typename FirstTraits::Scalar Scalar;
+  enum { Size = FirstTraits::Size + SecondTraits::Size };
+  inline static void get(const First_& first, const Second_& second, Scalar* coefficients) {
+    FirstTraits::get(first, coefficients);
+    SecondTraits::get(second, coefficients + FirstTraits::Size);
+  }
+  inline static void set(First_& first, Second_& second, const Scalar* coefficients) {
+    FirstTraits::set(first, coefficients);
+    SecondTraits::set(second, coefficients + FirstTraits::Size);
+  }
+};
+
+template<typename PrimType_, typename Position_, typename Rotation_>
+class SeqLockTraits<HomogeneousTransformation<PrimType_, Position_, Rotation_>> {
+  typedef HomogeneousTransformation<PrimType_, Position_, Rotation_> Pose;
+  typedef SeqLockPairTraits<Position_, Rotation_> PartTraits;
+ public:
+  typedef PrimType_ Scalar;
+  enum { Size = PartTraits::Size };
+  inline static void get(const Pose& value, Scalar* coefficients) {
+    PartTraits::get(value.getPosition(), value.getRotation(), coefficients);
+  }
+  inline static void set(Pose& value, const Scalar* coefficients) {
+    PartTraits::set(value.getPosition(), value.getRotation(), coefficients);
+  }
+};
+
+//! Twists with an angular velocity as rotational part, [linear velocity; angular velocity]
+template<typename Twist_>
+class SeqLockTwistTraits {
+  typedef SeqLockTraits<Eigen::Matrix<typename Twist_::Scalar, 3, 1>> ImplementationTraits;
+ public:
+  typedef typename Twist_::Scalar Scalar;
+  enum { Size = 6 };
+  inline static void get(const Twist_& value, Scalar* coefficients) {
+    ImplementationTraits::get(value.getTranslationalVelocity().toImplementation(), coefficients);
+    ImplementationTraits::get(value.getRotationalVelocity().toImplementation(), coefficients + 3);
+  }
+  inline static void set(Twist_& value, const Scalar* coefficients) {
+    ImplementationTraits::set(value.getTranslationalVelocity().toImplementation(), coefficients);
+    ImplementationTraits::set(value.getRotationalVelocity().toImplementation(), coefficients + 3);
+  }
+};
+
+template<typename PrimType_>
+class SeqLockTraits<TwistLinearVelocityLocalAngularVelocity<PrimType_>>
+    : public SeqLockTwistTraits<TwistLinearVelocityLocalAngularVelocity<PrimType_>> {
+};
+
+template<typename PrimType_>
+class SeqLockTraits<TwistLinearVelocityGlobalAngularVelocity<PrimType_>>
+    : public SeqLockTwistTraits<TwistLinearVelocityGlobalAngularVelocity<PrimType_>> {
+};
+
+template<typename PrimType_>
+class SeqLockTraits<Wrench6<PrimType_>> {
+  typedef SeqLockTraits<Eigen::Matrix<PrimType_, 3, 1>> ImplementationTraits;
+ public:
+  typedef PrimType_ Scalar;
+  enum { Size = 6 };
+  inline static void get(const Wrench6<PrimType_>& value, Scalar* coefficients) {
+    ImplementationTraits::get(value.getForce().toImplementation(), coefficients);
+    ImplementationTraits::get(value.getTorque().toImplementation(), coefficients + 3);
+  }
+  inline static void set(Wrench6<PrimType_>& value, const Scalar* coefficients) {
+    ImplementationTraits::set(value.getForce().toImplementation(), coefficients);
+    ImplementationTraits::set(value.getTorque().toImplementation(), coefficients + 3);
+  }
+};
+
+template<typename First_, typename Second_>
+class SeqLockTraits<std::pair<First_, Second_>> {
+  typedef SeqLockPairTraits<First_, Second_> PartTraits;
+ public:
+  typedef typename PartTraits::Scalar Scalar;
+  enum { Size = PartTraits::Size };
+  inline static void get(const std::pair<First_, Second_>& value, Scalar* coefficients) {
+    PartTraits::get(value.first, value.second, coefficients);
+  }
+  inline static void set(std::pair<First_, Second_>& value, const Scalar* coefficients) {
+    PartTraits::set(value.first, value.second, coefficients);
+  }
+};
+
+} // namespace internal
+
+/*! \class SeqLock
+ *  \brief Publishes a fixed-size value from one writer thread to any number of reader threads without locks.
+ *
+ *  The value is stored as the coefficients of internal::SeqLockTraits in relaxed atomics together with a sequence
+ *  counter, which is odd while a store is in progress. store() never waits. A reader copies the coefficients and
+ *  retries if the counter changed in the meantime, so it never sees a torn value, never writes shared memory and thus
+ *  never slows down the writer or the other readers. A reader only retries if it overlaps a store, which takes a few
+ *  nanoseconds for a pose; tryLoad() makes a single attempt and never waits. Example:
+ *  \code{cpp}
+ *  kindr::SeqLock<std::pair<kindr::HomTransformQuatD, kindr::TwistLocalD>> state;
+ *  state.store(std::make_pair(pose, twist));  // estimator thread
+ *  const auto snapshot = state.load();        // consumer threads
+ *  \endcode
+ *  Only one thread may call store() at a time.
+ *
+ *  \tparam Value_ value type, see internal::SeqLockTraits
+ */
+template<typename Value_>
+class SeqLock {
+  typedef internal::SeqLockTraits<Value_> Traits;
+ public:
+  typedef Value_ Value;
+  typedef typename Traits::Scalar Scalar;
+
+  /*! \brief Constructor storing a value.
+   *  \param value   initial value
+   */
+  explicit SeqLock(const Value& value = Value())
+    : sequence_(0) {
+    Scalar coefficients[Traits::Size];
+    Traits::get(value, coefficients);
+    for (int i = 0; i < Traits::Size; ++i) {
+      coefficients_[i].store(coefficients[i], std::memory_order_relaxed);
+    }
+  }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  /*! \brief Publishes a value. Must not be called concurrently.
+   *  \param value   value
+   */
+  void store(const Value& value) {
+    Scalar coefficients[Traits::Size];
+    Traits::get(value, coefficients);
+    const std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < Traits::Size; ++i) {
+      coefficients_[i].store(coefficients[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /*! \brief Gets a consistent copy of the last published value.
+   *  \param value   the value is written here
+   *  \returns the number of stores since the construction, e.g. to detect new values
+   */
+  std::uint64_t load(Value& value) const {
+    Scalar coefficients[Traits::Size];
+    std::uint64_t sequence;
+    while (!tryCopy(coefficients, sequence)) {
+    }
+    Traits::set(value, coefficients);
+    return sequence/2;
+  }
+
+  /*! \brief Gets a consistent copy of the last published value.
+   *  \returns value
+   */
+  Value load() const {
+    Value value;
+    load(value);
+    return value;
+  }
+
+  /*! \brief Tries once to get a consistent copy of the last published value.
+   *  \param value   the value is written here on success and left unchanged otherwise
+   *  \returns false if a store was in progress
+   */
+  bool tryLoad(Value& value) const {
+    Scalar coefficients[Traits::Size];
+    std::uint64_t sequence;
+    if (!tryCopy(coefficients, sequence)) {
+      return false;
+    }
+    Traits::set(value, coefficients);
+    return true;
+  }
+
+  /*! \brief Gets the number of stores since the construction.
+   *  \returns number of stores
+   */
+  std::uint64_t getVersion() const {
+    return sequence_.load(std::memory_order_acquire)/2;
+  }
+
+ private:
+  bool tryCopy(Scalar* coefficients, std::uint64_t& sequence) const {
+    sequence = sequence_.load(std::memory_order_acquire);
+    if (sequence & 1u) {
+      return false;
+    }
+    for (int i = 0; i < Traits::Size; ++i) {
+      coefficients[i] = coefficients_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return sequence_.load(std::memory_order_relaxed) == sequence;
+  }
+
+  //! Aligned to a cache line, such that the lock shares no cache line with other data
+  alignas(64) std::atomic<std::uint64_t> sequence_;
+  std::atomic<Scalar> coefficients_[Traits::Size];
+};
+
+} // namespace kindr
@@ -32,8 +32,35 @@
 #include <stdexcept>
 #include <sstream>
 #include <typeinfo>
+#ifdef KINDR_NO_EXCEPTIONS
+#include <cstdlib>
+#include <iostream>
+#endif
 #include "source_file_pos.hpp"
 
+/*! \file assert_macros.hpp
+ *
+ *  By default, failed assertions throw the given exception type. If KINDR_NO_EXCEPTIONS is defined
+ *  (CMake option KINDR_NO_EXCEPTIONS), a failed assertion prints its message to std::cerr and aborts
+ *  instead, so that kindr can be used with -fno-exceptions. In this mode the checks in hot paths,
+ *  which use KINDR_ASSERT_TRUE_HOT, become debug-only and vanish if NDEBUG is defined.
+ *
+ *  In CUDA device code (__CUDA_ARCH__ defined) neither streams nor exceptions are available. There, the
+ *  assertions fall back to the device assert(), which traps the kernel and vanishes if NDEBUG is defined.
+ *  The messages are dropped.
+ */
+
+//! Branch prediction hints
+#if defined(__GNUC__) || defined(__clang__)
+#define KINDR_LIKELY(x) __builtin_expect(!!(x), 1)
+#define KINDR_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define KINDR_COLD __attribute__((noinline, cold))
+#else
+#define KINDR_LIKELY(x) (x)
+#define KINDR_UNLIKELY(x) (x)
+#define KINDR_COLD
+#endif
+
 //! Macro for defining an exception with a given parent
 //  (std::runtime_error should be top parent)
 // adapted from ros/drivers/laser/hokuyo_driver/hokuyo.h
@@ -50,7 +77,7 @@ namespace kindr {
   namespace internal {
 
     template<typename KINDR_EXCEPTION_T>
-    inline void kindr_throw_exception(std::string const & exceptionType, kindr::internal::source_file_pos sfp, std::string const & message)
+    [[noreturn]] inline void kindr_throw_exception(std::string const & exceptionType, kindr::internal::source_file_pos sfp, std::string const & message)
     {
       std::stringstream kindr_assert_stringstream;
 #ifdef _WIN32
@@ -59,11 +86,16 @@ namespace kindr {
 #else
       kindr_assert_stringstream << exceptionType <<  sfp.toString() << std::string{" "} << message;
 #endif
+#ifdef KINDR_NO_EXCEPTIONS
+      std::cerr << kindr_assert_stringstream.str() << std::endl;
+      std::abort();
+#else
       throw(KINDR_EXCEPTION_T(kindr_assert_stringstream.str()));
+#endif
     }
 
     template<typename KINDR_EXCEPTION_T>
-    inline void kindr_throw_exception(std::string const & exceptionType, std::string const & function, std::string const & file,
+    [[noreturn]] inline void kindr_throw_exception(std::string const & exceptionType, std::string const & function, std::string const & file,
                    int line, std::string const & message)
     {
       kindr_throw_exception<KINDR_EXCEPTION_T>(exceptionType, kindr::internal::source_file_pos(function,file,line),message);
@@ -101,13 +133,30 @@ namespace kindr {
   }
 
 #define KINDR_ASSERT_TRUE(exceptionType, condition, message)       \
-  if(!(condition))                            \
+  if(KINDR_UNLIKELY(!(condition)))                          \
     {                                 \
       std::stringstream kindr_assert_stringstream;             \
       kindr_assert_stringstream << "assert(" << #condition << ") failed: " << message; \
       kindr::internal::kindr_throw_exception<exceptionType>("[" #exceptionType "] ", __FUNCTION__,__FILE__,__LINE__, kindr_assert_stringstream.str()); \
     }
 
+//! Assertion for hot paths such as constructors and conversions. The message is formatted in a cold,
+//  out-of-line function so that the inlined code only contains the comparison and a call.
+//  With KINDR_NO_EXCEPTIONS the check is debug-only.
+#ifdef KINDR_NO_EXCEPTIONS
+#define KINDR_ASSERT_TRUE_HOT(exceptionType, condition, message) KINDR_ASSERT_TRUE_DBG(exceptionType, condition, message)
+#else
+#define KINDR_ASSERT_TRUE_HOT(exceptionType, condition, message)   \
+  if(KINDR_UNLIKELY(!(condition)))                \
+    {                                 \
+      [&](const char* kindr_assert_function) KINDR_COLD {     \
+        std::stringstream kindr_assert_stringstream;           \
+        kindr_assert_stringstream << "assert(" << #condition << ") failed: " << message; \
+        kindr::internal::kindr_throw_exception<exceptionType>("[" #exceptionType "] ", kindr_assert_function,__FILE__,__LINE__, kindr_assert_stringstream.str()); \
+      }(__FUNCTION__);                          \
+    }
+#endif
+
 #define KINDR_ASSERT_FALSE(exceptionType, condition, message)        \
   if((condition))                           \
     {                                 \
@@ -313,4 +362,60 @@ namespace kindr {
 #define KINDR_ASSERT_NEAR_DBG(exceptionType, value, testValue, abs_error, message)
 #endif
 
+#if defined(__CUDA_ARCH__)
+#include <cassert>
+
+#undef KINDR_THROW
+#undef KINDR_THROW_SFP
+#undef KINDR_ASSERT_TRUE
+#undef KINDR_ASSERT_TRUE_HOT
+#undef KINDR_ASSERT_FALSE
+#undef KINDR_ASSERT_GE_LT
+#undef KINDR_ASSERT_LT
+#undef KINDR_ASSERT_GE
+#undef KINDR_ASSERT_LE
+#undef KINDR_ASSERT_GT
+#undef KINDR_ASSERT_EQ
+#undef KINDR_ASSERT_NE
+#undef KINDR_ASSERT_NEAR
+#undef KINDR_OUT
+#undef KINDR_THROW_DBG
+#undef KINDR_ASSERT_TRUE_DBG
+#undef KINDR_ASSERT_FALSE_DBG
+#undef KINDR_ASSERT_GE_LT_DBG
+#undef KINDR_ASSERT_LT_DBG
+#undef KINDR_ASSERT_GT_DBG
+#undef KINDR_ASSERT_LE_DBG
+#undef KINDR_ASSERT_GE_DBG
+#undef KINDR_ASSERT_NE_DBG
+#undef KINDR_ASSERT_EQ_DBG
+#undef KINDR_ASSERT_NEAR_DBG
+
+#define KINDR_THROW(exceptionType, message) { assert(false); }
+#define KINDR_THROW_SFP(exceptionType, SourceFilePos, message) { assert(false); }
+#define KINDR_ASSERT_TRUE(exceptionType, condition, message) { assert((condition)); }
+#define KINDR_ASSERT_TRUE_HOT(exceptionType, condition, message) { assert((condition)); }
+#define KINDR_ASSERT_FALSE(exceptionType, condition, message) { assert(!(condition)); }
+#define KINDR_ASSERT_GE_LT(exceptionType, value, lowerBound, upperBound, message) { assert((value) >= (lowerBound) && (value) < (upperBound)); }
+#define KINDR_ASSERT_LT(exceptionType, value, upperBound, message) { assert((value) < (upperBound)); }
+#define KINDR_ASSERT_GE(exceptionType, value, lowerBound, message) { assert((value) >= (lowerBound)); }
+#define KINDR_ASSERT_LE(exceptionType, value, upperBound, message) { assert((value) <= (upperBound)); }
+#define KINDR_ASSERT_GT(exceptionType, value, lowerBound, message) { assert((value) > (lowerBound)); }
+#define KINDR_ASSERT_EQ(exceptionType, value, testValue, message) { assert((value) == (testValue)); }
+#define KINDR_ASSERT_NE(exceptionType, value, testValue, message) { assert((value) != (testValue)); }
+#define KINDR_ASSERT_NEAR(exceptionType, value, testValue, abs_error, message) { assert(!((value) - (testValue) > (abs_error) || (testValue) - (value) > (abs_error))); }
+#define KINDR_OUT(X)
+#define KINDR_THROW_DBG(exceptionType, message) { assert(false); }
+#define KINDR_ASSERT_TRUE_DBG(exceptionType, condition, message) { assert((condition)); }
+#define KINDR_ASSERT_FALSE_DBG(exceptionType, condition, message) { assert(!(condition)); }
+#define KINDR_ASSERT_GE_LT_DBG(exceptionType, value, lowerBound, upperBound, message) { assert((value) >= (lowerBound) && (value) < (upperBound)); }
+#define KINDR_ASSERT_LT_DBG(exceptionType, value, upperBound, message) { assert((value) < (upperBound)); }
+#define KINDR_ASSERT_GT_DBG(exceptionType, value, lowerBound, message) { assert((value) > (lowerBound)); }
+#define KINDR_ASSERT_LE_DBG(exceptionType, value, upperBound, message) { assert((value) <= (upperBound)); }
+#define KINDR_ASSERT_GE_DBG(exceptionType, value, lowerBound, message) { assert((value) >= (lowerBound)); }
+#define KINDR_ASSERT_NE_DBG(exceptionType, value, testValue, message) { assert((value) != (testValue)); }
+#define KINDR_ASSERT_EQ_DBG(exceptionType, value, testValue, message) { assert((value) == (testValue)); }
+#define KINDR_ASSERT_NEAR_DBG(exceptionType, value, testValue, abs_error, message) { assert(!((value) - (testValue) > (abs_error) || (testValue) - (value) > (abs_error))); }
+#endif
+
 #endif /* KINDR_ASSERT_MACROS_HPP_ */
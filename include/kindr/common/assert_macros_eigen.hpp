@@ -192,5 +192,18 @@ inline bool compareRelativePeriodic(SCALAR a, SCALAR b, double periodlength, dou
 } // namespace kindr
 
 
+//! In CUDA device code the relative comparisons are skipped and the finiteness checks use the device assert().
+#if defined(__CUDA_ARCH__)
+#undef KINDR_ASSERT_MATRIX_NEAR_DBG
+#undef KINDR_ASSERT_SCALAR_NEAR_DBG
+#undef PRINT
+#undef KINDR_ASSERT_MAT_IS_FINITE
+#undef KINDR_ASSERT_MAT_IS_FINITE_DBG
+#define KINDR_ASSERT_MATRIX_NEAR_DBG(exceptionType, A, B, PERCENT_TOLERANCE, MSG)
+#define KINDR_ASSERT_SCALAR_NEAR_DBG(exceptionType, A, B, PERCENT_TOLERANCE, MESSAGE)
+#define PRINT(MESSAGE)
+#define KINDR_ASSERT_MAT_IS_FINITE(exceptionType, matrix, message) { assert((matrix).allFinite()); }
+#define KINDR_ASSERT_MAT_IS_FINITE_DBG(exceptionType, matrix, message) { assert((matrix).allFinite()); }
+#endif
 
 #endif /* ASSERT_MACROS_EIGEN_HPP_ */
@@ -35,6 +35,11 @@
 #include <random>
 #include <Eigen/Core>
 
+/*! \brief Marks the functions which can be called from CUDA device code.
+ *  Like EIGEN_DEVICE_FUNC, it expands to __host__ __device__ if compiled with nvcc and to nothing otherwise.
+ */
+#define KINDR_DEVICE_FUNC EIGEN_DEVICE_FUNC
+
 namespace kindr {
 
 /*! \brief Floating-point modulo
@@ -47,22 +52,23 @@ T floatingPointModulo(T x, T y)
 {
     static_assert(!std::numeric_limits<T>::is_exact , "floatingPointModulo: floating-point type expected");
 
-    if (y == 0.0)
+    if (y == T(0))
         return x;
 
-    double m= x - y * floor(x/y);
+    using std::floor;
+    const T m= x - y * floor(x/y);
 
     // handle boundary cases resulted from floating-point cut off:
 
-    if (y > 0)              // modulo range: [0..y)
+    if (y > T(0))              // modulo range: [0..y)
     {
         if (m>=y)           // mod(-1e-16             , 360.    ): m= 360.
-            return 0;
+            return T(0);
 
-        if (m<0 )
+        if (m<T(0) )
         {
             if (y+m == y)
-                return 0  ; // just in case...
+                return T(0)  ; // just in case...
             else
                 return y+m; // Mod(106.81415022205296 , 2*M_PI ): m= -1.421e-14
         }
@@ -70,12 +76,12 @@ T floatingPointModulo(T x, T y)
     else                    // modulo range: (y..0]
     {
         if (m<=y)           // mod(1e-16              , -360.   ): m= -360.
-            return 0;
+            return T(0);
 
-        if (m>0 )
+        if (m>T(0) )
         {
             if (y+m == y)
-                return 0  ; // just in case...
+                return T(0)  ; // just in case...
             else
                 return y+m; // mod(-106.81415022205296, -2*M_PI): m= 1.421e-14
         }
@@ -95,7 +101,7 @@ inline T wrapAngle(T angle, T x1, T x2)
 template<typename T>
 inline T wrapPosNegPI(T angle)
 {
-    return floatingPointModulo(angle + T(M_PI), T(2.0*M_PI)  ) - M_PI;
+    return floatingPointModulo(angle + T(M_PI), T(2.0*M_PI)  ) - T(M_PI);
 }
 
 //! wrap angle to [0..2*PI)
@@ -105,6 +111,86 @@ inline T wrapTwoPI(T angle)
     return floatingPointModulo(angle, T(2.0*M_PI));
 }
 
+namespace internal {
+
+/*! \brief Computes floatingPointModulo(x - x1, y) + x1 for all coefficients of an array, y must be positive.
+ *
+ * The remainders which leave [0..y) due to floating-point cut off are clamped instead of handled with branches, such
+ * that the whole computation is a single vectorized pass. For x within the rounding error of a multiple of y, the
+ * result may therefore be the other end of the range than the one of the scalar version, e.g. 0 instead of y-1.421e-14.
+ */
+template<typename Derived_>
+inline typename Derived_::PlainObject wrapArray(const Eigen::ArrayBase<Derived_>& x, typename Derived_::Scalar x1, typename Derived_::Scalar y)
+{
+    typedef typename Derived_::Scalar T;
+    static_assert(!std::numeric_limits<T>::is_exact , "wrapArray: floating-point type expected");
+    assert(y > T(0));
+
+    const T inverse = T(1)/y;
+    const T largest = std::nextafter(y, T(0));
+    return ((x - x1) - y*((x - x1)*inverse).floor()).max(T(0)).min(largest) + x1;
+}
+
+} // namespace internal
+
+/*! \brief Floating-point modulo of all coefficients of an array for a positive divisor, see floatingPointModulo().
+ * \returns the remainders in [0..y)
+ */
+template<typename Derived_>
+inline typename Derived_::PlainObject floatingPointModuloArray(const Eigen::ArrayBase<Derived_>& x, typename Derived_::Scalar y)
+{
+    return internal::wrapArray(x, typename Derived_::Scalar(0), y);
+}
+
+//! wrap all angles of an array to [x1..x2)
+template<typename Derived_>
+inline typename Derived_::PlainObject wrapAngleArray(const Eigen::ArrayBase<Derived_>& angles, typename Derived_::Scalar x1, typename Derived_::Scalar x2)
+{
+    return internal::wrapArray(angles, x1, x2 - x1);
+}
+
+//! wrap all angles of an array to [-PI..PI)
+template<typename Derived_>
+inline typename Derived_::PlainObject wrapPosNegPIArray(const Eigen::ArrayBase<Derived_>& angles)
+{
+    typedef typename Derived_::Scalar T;
+    return internal::wrapArray(angles, T(-M_PI), T(2.0*M_PI));
+}
+
+//! wrap all angles of an array to [0..2*PI)
+template<typename Derived_>
+inline typename Derived_::PlainObject wrapTwoPIArray(const Eigen::ArrayBase<Derived_>& angles)
+{
+    typedef typename Derived_::Scalar T;
+    return internal::wrapArray(angles, T(0), T(2.0*M_PI));
+}
+
+/*! \brief Unwraps a sequence of angles such that consecutive angles differ by at most PI (like matlab's unwrap()).
+ *
+ * The multiples of 2*PI to remove at each step are computed vectorized, only their running sum is sequential. The
+ * angles are shifted by exact multiples of 2*PI, such that no rounding error accumulates over long sequences.
+ * \param angles  row or column of angles
+ * \returns the unwrapped angles
+ */
+template<typename Derived_>
+inline typename Derived_::PlainObject unwrapAngleArray(const Eigen::ArrayBase<Derived_>& angles)
+{
+    typedef typename Derived_::Scalar T;
+    typename Derived_::PlainObject unwrapped = angles;
+    const Eigen::Index size = unwrapped.size();
+    if (size < 2) {
+        return unwrapped;
+    }
+    const T twoPi = T(2.0*M_PI);
+    const Eigen::Array<T, Eigen::Dynamic, 1> turns = ((unwrapped.tail(size - 1) - unwrapped.head(size - 1))/twoPi).round();
+    T sum = T(0);
+    for (Eigen::Index i = 1; i < size; ++i) {
+        sum += turns(i - 1);
+        unwrapped(i) -= twoPi*sum;
+    }
+    return unwrapped;
+}
+
 
 template <typename PrimType_,  int Rows_>
 static inline void setUniformRandom(Eigen::Matrix<PrimType_, Rows_, 1>& vector, PrimType_ min, PrimType_ max) {
@@ -172,32 +258,65 @@ class GenericNumTraits {
 
 };
 
+/*! \brief Numeric traits, which take the precisions of other scalar types (e.g. automatic differentiation types
+ *  like ceres::Jet) from Eigen::NumTraits.
+ */
 template<typename T>
-class NumTraits : GenericNumTraits<T> {
+class NumTraits : public GenericNumTraits<T> {
  public:
+  static inline T epsilon() { return T(Eigen::NumTraits<T>::epsilon()); }
+  static inline T dummy_precision() { return T(Eigen::NumTraits<T>::dummy_precision()); }
 };
 
 template<>
-class NumTraits<float> : GenericNumTraits<float>
+class NumTraits<float> : public GenericNumTraits<float>
 {
  public:
   static inline float dummy_precision() { return 1e-5f; }
 };
 
 template<>
-class NumTraits<double> : GenericNumTraits<double>
+class NumTraits<double> : public GenericNumTraits<double>
 {
  public:
   static inline double dummy_precision() { return 1e-12; }
 };
 
 template<>
-class NumTraits<long double> : GenericNumTraits<long double>
+class NumTraits<long double> : public GenericNumTraits<long double>
 {
  public:
   static inline long double dummy_precision() { return 1e-15l; }
 };
 
+/*! \brief Checks if a value is smaller than the fourth root of the machine epsilon.
+ *
+ *  Below this threshold, second order Taylor expansions of sin(x)/x and similar terms are exact up to machine precision.
+ */
+template <typename Scalar_ = double>
+KINDR_DEVICE_FUNC inline bool isLessThenEpsilons4thRoot(Scalar_ x){
+  using std::pow;
+#if defined(__CUDA_ARCH__)
+  // device code has neither function-local statics nor std::numeric_limits
+  const Scalar_ epsilon4thRoot = pow(Eigen::NumTraits<Scalar_>::epsilon(), Scalar_(1.0/4.0));
+#else
+  static const Scalar_ epsilon4thRoot = pow(NumTraits<Scalar_>::epsilon(), 1.0/4.0);
+#endif
+  return x < epsilon4thRoot;
+}
+
+/*! \brief Gets the threshold of the cosine of the pitch below which Euler angles are extracted as in the gimbal lock.
+ *
+ *  The threshold is the square root of the machine epsilon. Above it, yaw and roll lose at most as many digits in
+ *  atan2 of the small elements of the rotation matrix as setting one of them to zero in the gimbal lock costs.
+ */
+template <typename Scalar_ = double>
+inline Scalar_ getGimbalLockThreshold() {
+  using std::sqrt;
+  static const Scalar_ epsilonSqrt = sqrt(NumTraits<Scalar_>::epsilon());
+  return epsilonSqrt;
+}
+
 
 } // namespace internal
 } // namespace kindr
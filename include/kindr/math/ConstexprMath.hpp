@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+namespace kindr {
+namespace internal {
+
+/* Elementary functions which can be evaluated at compile time. They are restricted to a single return statement
+ * (C++11 constexpr) and intended for constants, e.g. fixed rotations, and not for the use at runtime.
+ */
+
+/*! \brief Gets pi in the precision of the scalar type.
+ *  \returns pi
+ */
+template<typename Scalar_>
+constexpr Scalar_ constexprPi() {
+  return static_cast<Scalar_>(3.141592653589793238462643383279502884L);
+}
+
+template<typename Scalar_>
+constexpr Scalar_ constexprSqrtNewton(Scalar_ x, Scalar_ current, Scalar_ previous, int iterations) {
+  return (current == previous || iterations == 0) ? current : constexprSqrtNewton(x, static_cast<Scalar_>(0.5)*(current + x/current), current, iterations - 1);
+}
+
+/*! \brief Computes the square root with Newton's method, starting above the root such that the iteration decreases monotonically.
+ *  \param x   non-negative argument
+ *  \returns square root of x, zero for non-positive arguments
+ */
+template<typename Scalar_>
+constexpr Scalar_ constexprSqrt(Scalar_ x) {
+  return x > static_cast<Scalar_>(0) ? constexprSqrtNewton(x, x > static_cast<Scalar_>(1) ? x : static_cast<Scalar_>(1), static_cast<Scalar_>(0), 128) : static_cast<Scalar_>(0);
+}
+
+/*! \brief Wraps an angle to [-pi, pi].
+ *  \param angle   angle in radians (|angle| < 1e18)
+ *  \returns wrapped angle
+ */
+template<typename Scalar_>
+constexpr Scalar_ constexprWrapAngle(Scalar_ angle) {
+  return angle - 2*constexprPi<Scalar_>()*static_cast<Scalar_>(static_cast<long long>(angle/(2*constexprPi<Scalar_>()) + (angle >= static_cast<Scalar_>(0) ? static_cast<Scalar_>(0.5) : static_cast<Scalar_>(-0.5))));
+}
+
+template<typename Scalar_>
+constexpr Scalar_ constexprSinSeries(Scalar_ squaredAngle, Scalar_ term, int n) {
+  // term = (-1)^n angle^(2n+1)/(2n+1)!, the remainder is below the precision of double for |angle| <= pi/2 and n > 12
+  return n > 12 ? term : term + constexprSinSeries(squaredAngle, -term*squaredAngle/static_cast<Scalar_>((2*n + 2)*(2*n + 3)), n + 1);
+}
+
+template<typename Scalar_>
+constexpr Scalar_ constexprSinReduced(Scalar_ angle) {
+  // sin(angle) = sin(pi - angle) maps [-pi, pi] to [-pi/2, pi/2]
+  return angle > constexprPi<Scalar_>()/2 ? constexprSinSeries((constexprPi<Scalar_>() - angle)*(constexprPi<Scalar_>() - angle), constexprPi<Scalar_>() - angle, 0)
+       : angle < -constexprPi<Scalar_>()/2 ? constexprSinSeries((-constexprPi<Scalar_>() - angle)*(-constexprPi<Scalar_>() - angle), -constexprPi<Scalar_>() - angle, 0)
+       : constexprSinSeries(angle*angle, angle, 0);
+}
+
+/*! \brief Computes the sine with a Taylor series.
+ *  \param angle   angle in radians
+ *  \returns sine
+ */
+template<typename Scalar_>
+constexpr Scalar_ constexprSin(Scalar_ angle) {
+  return constexprSinReduced(constexprWrapAngle(angle));
+}
+
+/*! \brief Computes the cosine with a Taylor series.
+ *  \param angle   angle in radians
+ *  \returns cosine
+ */
+template<typename Scalar_>
+constexpr Scalar_ constexprCos(Scalar_ angle) {
+  return constexprSinReduced(constexprWrapAngle(angle + constexprPi<Scalar_>()/2));
+}
+
+} // namespace internal
+} // namespace kindr
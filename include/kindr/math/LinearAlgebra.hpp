@@ -27,6 +27,14 @@
 */
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+#include <Eigen/QR>
 #include <Eigen/SVD>
 
 namespace kindr {
@@ -54,6 +62,296 @@ inline static Eigen::Matrix<PrimType_, 3, 1> getVectorFromSkewMatrix(const Eigen
   return Eigen::Matrix<PrimType_, 3, 1> (matrix(2,1), matrix(0,2), matrix(1,0));
 }
 
+/*!
+ * \brief Backends of the Moore–Penrose pseudoinverse
+ *
+ * JacobiSvd:                       Accurate and rank revealing, the default.
+ * BdcSvd:                          Divide and conquer SVD, faster than JacobiSvd for large matrices (more than about
+ *                                  16 columns) but allocates internally.
+ * CompleteOrthogonalDecomposition: Rank revealing QR based decomposition, cheaper than an SVD.
+ * ClosedForm:                      Requires full rank. Inverts small square matrices (up to 4x4) with cofactors and
+ *                                  solves the normal equations with a Cholesky decomposition otherwise.
+ * DampedLeastSquares:              J^T (J J^T + lambda^2 I)^-1 with the damping factor lambda of the workspace,
+ *                                  well defined close to singularities.
+ */
+enum class PseudoInverseMethod {
+  JacobiSvd,
+  BdcSvd,
+  CompleteOrthogonalDecomposition,
+  ClosedForm,
+  DampedLeastSquares
+};
+
+namespace internal {
+
+/*! \brief Work matrix type with dynamic size but the same maximal size as Matrix_ (or its transpose), i.e. it does
+ *  not allocate for fixed size inputs but allows thin decompositions and branching on the shape at runtime.
+ */
+template<typename Matrix_, bool Transpose_ = false>
+struct PseudoInverseWorkMatrix {
+  static constexpr int MaxRows = Transpose_ ? Matrix_::MaxColsAtCompileTime : Matrix_::MaxRowsAtCompileTime;
+  static constexpr int MaxCols = Transpose_ ? Matrix_::MaxRowsAtCompileTime : Matrix_::MaxColsAtCompileTime;
+  typedef Eigen::Matrix<typename Matrix_::Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, MaxRows, MaxCols> type;
+};
+
+/*! \brief Work matrix type which stores Matrix_ or its transpose such that it has at least as many rows as columns.
+ */
+template<typename Matrix_>
+struct PseudoInverseTallWorkMatrix {
+  static constexpr int MaxRows = Matrix_::MaxRowsAtCompileTime;
+  static constexpr int MaxCols = Matrix_::MaxColsAtCompileTime;
+  static constexpr bool IsFixed = MaxRows != Eigen::Dynamic && MaxCols != Eigen::Dynamic;
+  static constexpr int MaxTall = IsFixed ? (MaxRows > MaxCols ? MaxRows : MaxCols) : Eigen::Dynamic;
+  static constexpr int MaxShort = IsFixed ? (MaxRows < MaxCols ? MaxRows : MaxCols) : Eigen::Dynamic;
+  typedef Eigen::Matrix<typename Matrix_::Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, MaxTall, MaxShort> type;
+};
+
+template<typename Matrix_, typename Svd_>
+class SvdPseudoInverseBackend {
+ public:
+  typedef typename Matrix_::Scalar Scalar;
+
+  SvdPseudoInverseBackend(Eigen::Index rows, Eigen::Index cols)
+      : svd_(rows, cols, Eigen::ComputeThinU | Eigen::ComputeThinV),
+        singularValuesInverse_(std::min(rows, cols)) {
+  }
+
+  template<typename MatrixA_, typename MatrixB_>
+  bool compute(const MatrixA_& a, MatrixB_& result, Scalar epsilon, Scalar /*damping*/) {
+    svd_.compute(a, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    const auto& singularValues = svd_.singularValues();
+    if (singularValues.size() == 0) {
+      result.setZero(a.cols(), a.rows());
+      return true;
+    }
+    // The singular values are sorted in decreasing order
+    const Scalar tolerance = epsilon * std::max(a.cols(), a.rows()) * singularValues(0);
+    singularValuesInverse_ = (singularValues.array() > tolerance).select(singularValues.array().inverse(), Scalar(0));
+    result.noalias() = svd_.matrixV() * singularValuesInverse_.asDiagonal() * svd_.matrixU().transpose();
+    return true;
+  }
+
+ private:
+  Svd_ svd_;
+  typename Svd_::SingularValuesType singularValuesInverse_;
+};
+
+template<typename Matrix_>
+class CodPseudoInverseBackend {
+ public:
+  typedef typename Matrix_::Scalar Scalar;
+  typedef typename PseudoInverseTallWorkMatrix<Matrix_>::type TallMatrix;
+  typedef typename PseudoInverseWorkMatrix<TallMatrix, true>::type TallInverseMatrix;
+
+  CodPseudoInverseBackend(Eigen::Index rows, Eigen::Index cols)
+      : cod_(std::max(rows, cols), std::min(rows, cols)),
+        pseudoInverse_(std::min(rows, cols), std::max(rows, cols)) {
+  }
+
+  template<typename MatrixA_, typename MatrixB_>
+  bool compute(const MatrixA_& a, MatrixB_& result, Scalar epsilon, Scalar /*damping*/) {
+    // Wide matrices are decomposed transposed since the decomposition only allocates if its rank is lower than the
+    // number of columns.
+    const bool isWide = a.rows() < a.cols();
+    cod_.setThreshold(epsilon * std::max(a.cols(), a.rows()));
+    if (isWide) {
+      cod_.compute(a.transpose());
+    } else {
+      cod_.compute(a);
+    }
+    pseudoInverse_ = cod_.pseudoInverse();
+    if (isWide) {
+      result = pseudoInverse_.transpose();
+    } else {
+      result = pseudoInverse_;
+    }
+    return true;
+  }
+
+ private:
+  Eigen::CompleteOrthogonalDecomposition<TallMatrix> cod_;
+  TallInverseMatrix pseudoInverse_;
+};
+
+template<typename Matrix_, bool IsClosedForm_>
+class NormalEquationsPseudoInverseBackend {
+ public:
+  typedef typename Matrix_::Scalar Scalar;
+  typedef typename PseudoInverseTallWorkMatrix<Matrix_>::type TallMatrix;
+  static constexpr int MaxGramSize = TallMatrix::MaxColsAtCompileTime;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, MaxGramSize, MaxGramSize> GramMatrix;
+  typedef typename PseudoInverseWorkMatrix<TallMatrix, true>::type SolutionMatrix;
+
+  //! Small square matrices of a fixed size are inverted in closed form
+  static constexpr bool IsSmallSquare = IsClosedForm_ && Matrix_::RowsAtCompileTime == Matrix_::ColsAtCompileTime
+      && Matrix_::RowsAtCompileTime != Eigen::Dynamic && Matrix_::RowsAtCompileTime <= 4;
+
+  NormalEquationsPseudoInverseBackend(Eigen::Index rows, Eigen::Index cols)
+      : gram_(std::min(rows, cols), std::min(rows, cols)),
+        llt_(std::min(rows, cols)),
+        solution_(std::min(rows, cols), std::max(rows, cols)) {
+  }
+
+  template<typename MatrixA_, typename MatrixB_>
+  bool compute(const MatrixA_& a, MatrixB_& result, Scalar epsilon, Scalar damping) {
+    return compute(a, result, epsilon, damping, std::integral_constant<bool, IsSmallSquare>());
+  }
+
+ private:
+  template<typename MatrixA_, typename MatrixB_>
+  bool compute(const MatrixA_& a, MatrixB_& result, Scalar epsilon, Scalar /*damping*/, std::true_type /*isSmallSquare*/) {
+    // The determinant threshold is relative to the scale of the matrix
+    bool isInvertible = false;
+    const Scalar threshold = epsilon * a.rows() * std::pow(a.cwiseAbs().maxCoeff(), Scalar(a.rows()));
+    a.computeInverseWithCheck(result, isInvertible, threshold);
+    return isInvertible;
+  }
+
+  template<typename MatrixA_, typename MatrixB_>
+  bool compute(const MatrixA_& a, MatrixB_& result, Scalar epsilon, Scalar damping, std::false_type /*isSmallSquare*/) {
+    // J^T (J J^T + lambda^2 I)^-1 for wide and (J^T J + lambda^2 I)^-1 J^T for tall matrices
+    const bool isWide = a.rows() < a.cols();
+    if (isWide) {
+      gram_.noalias() = a * a.transpose();
+    } else {
+      gram_.noalias() = a.transpose() * a;
+    }
+    gram_.diagonal().array() += damping * damping;
+    llt_.compute(gram_);
+    if (llt_.info() != Eigen::Success) {
+      return false;
+    }
+    if (IsClosedForm_) {
+      // The reciprocal condition number of the Gram matrix is estimated from its Cholesky factor. It is the squared
+      // ratio of the smallest to the largest singular value of a, i.e. a is rank deficient if this ratio is below
+      // sqrt(epsilon * n), since the normal equations lose twice as many digits as a decomposition of a.
+      if (llt_.rcond() <= epsilon * std::max(a.cols(), a.rows())) {
+        return false;
+      }
+    }
+    if (isWide) {
+      solution_ = a;
+    } else {
+      solution_ = a.transpose();
+    }
+    llt_.solveInPlace(solution_);
+    if (isWide) {
+      result = solution_.transpose();
+    } else {
+      result = solution_;
+    }
+    return true;
+  }
+
+  GramMatrix gram_;
+  Eigen::LLT<GramMatrix> llt_;
+  SolutionMatrix solution_;
+};
+
+template<typename Matrix_, PseudoInverseMethod Method_>
+struct PseudoInverseBackend;
+
+template<typename Matrix_>
+struct PseudoInverseBackend<Matrix_, PseudoInverseMethod::JacobiSvd> {
+  typedef typename PseudoInverseWorkMatrix<Matrix_>::type WorkMatrix;
+  typedef SvdPseudoInverseBackend<Matrix_, Eigen::JacobiSVD<WorkMatrix>> type;
+};
+
+template<typename Matrix_>
+struct PseudoInverseBackend<Matrix_, PseudoInverseMethod::BdcSvd> {
+  typedef typename PseudoInverseWorkMatrix<Matrix_>::type WorkMatrix;
+  typedef SvdPseudoInverseBackend<Matrix_, Eigen::BDCSVD<WorkMatrix>> type;
+};
+
+template<typename Matrix_>
+struct PseudoInverseBackend<Matrix_, PseudoInverseMethod::CompleteOrthogonalDecomposition> {
+  typedef CodPseudoInverseBackend<Matrix_> type;
+};
+
+template<typename Matrix_>
+struct PseudoInverseBackend<Matrix_, PseudoInverseMethod::ClosedForm> {
+  typedef NormalEquationsPseudoInverseBackend<Matrix_, true> type;
+};
+
+template<typename Matrix_>
+struct PseudoInverseBackend<Matrix_, PseudoInverseMethod::DampedLeastSquares> {
+  typedef NormalEquationsPseudoInverseBackend<Matrix_, false> type;
+};
+
+} // namespace internal
+
+/*!
+ * \brief Reusable workspace for the Moore–Penrose pseudoinverse of matrices of type Matrix_
+ *
+ * Holds the decomposition of the chosen method. For fixed size matrices nothing is allocated on the heap
+ * (except by BdcSvd), for dynamic size matrices the storage is allocated in the constructor and reused as long as
+ * the size does not change.
+ *
+ * Example (3x6 contact Jacobian in a control loop):
+ * \code{cpp}
+ * kindr::PseudoInverseWorkspace<Eigen::Matrix<double, 3, 6>, kindr::PseudoInverseMethod::DampedLeastSquares> workspace;
+ * workspace.setDamping(1e-3);
+ * Eigen::Matrix<double, 6, 3> inverse;
+ * workspace.compute(jacobian, inverse);
+ * \endcode
+ */
+template<typename Matrix_, PseudoInverseMethod Method_ = PseudoInverseMethod::JacobiSvd>
+class PseudoInverseWorkspace {
+ public:
+  typedef typename Matrix_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, Matrix_::ColsAtCompileTime, Matrix_::RowsAtCompileTime> InverseType;
+  static constexpr PseudoInverseMethod Method = Method_;
+
+  /*! Constructor
+   * \param rows  number of rows of the matrices to invert (only needed for dynamic sizes)
+   * \param cols  number of columns of the matrices to invert (only needed for dynamic sizes)
+   */
+  explicit PseudoInverseWorkspace(Eigen::Index rows = std::max(static_cast<int>(Matrix_::RowsAtCompileTime), 0),
+                                  Eigen::Index cols = std::max(static_cast<int>(Matrix_::ColsAtCompileTime), 0))
+      : backend_(rows, cols),
+        epsilon_(std::numeric_limits<Scalar>::epsilon()),
+        damping_(0) {
+  }
+
+  /*! \brief Relative tolerance below which singular values (or pivots) are treated as zero.
+   */
+  Scalar getEpsilon() const {
+    return epsilon_;
+  }
+
+  void setEpsilon(Scalar epsilon) {
+    epsilon_ = epsilon;
+  }
+
+  /*! \brief Damping factor lambda of the damped least squares method.
+   */
+  Scalar getDamping() const {
+    return damping_;
+  }
+
+  void setDamping(Scalar damping) {
+    damping_ = damping;
+  }
+
+  /*!
+   * \brief Computes the pseudoinverse of a
+   * \param a: Matrix to invert
+   * \param result: Result is written here
+   * \return false if the closed form or damped least squares method failed because a is (close to) rank deficient
+   */
+  template<typename MatrixA_, typename MatrixB_>
+  bool compute(const Eigen::MatrixBase<MatrixA_>& a, MatrixB_& result) {
+    static_assert(std::is_same<typename MatrixA_::Scalar, Scalar>::value && std::is_same<typename MatrixB_::Scalar, Scalar>::value,
+                  "[kindr::PseudoInverseWorkspace] Matrices must be of the same Scalar type!");
+    return backend_.compute(a.derived(), result, epsilon_, damping_);
+  }
+
+ private:
+  typename internal::PseudoInverseBackend<Matrix_, Method_>::type backend_;
+  Scalar epsilon_;
+  Scalar damping_;
+};
+
 /*!
  * \brief Computes the Moore–Penrose pseudoinverse
  * info: http://eigen.tuxfamily.org/bz/show_bug.cgi?id=257
@@ -77,23 +375,23 @@ bool static pseudoInverse(const _Matrix_TypeA_ &a, _Matrix_TypeB_ &result,
                 "[kindr::pseudoInverse] Matrices must be of the same Scalar type!");
   static_assert(rowsA == colsB && colsA == rowsB, "[kindr::pseudoInverse] Result type has wrong size!");
 
-  // If one dimension is dynamic, compute everything as dynamic size
-  constexpr auto m = Eigen::JacobiSVD< _Matrix_TypeA_ >::DiagSizeAtCompileTime;
-
-  // JacobiSVD needs to be computed on dynamic size if we need ComputeThinU, ComputeThinV, see:
-  // https://eigen.tuxfamily.org/dox/classEigen_1_1JacobiSVD.html
-  Eigen::JacobiSVD< Eigen::Matrix<typename _Matrix_TypeA_::Scalar, Eigen::Dynamic, Eigen::Dynamic> > svd(a, Eigen::ComputeThinU | Eigen::ComputeThinV);
-
-  typename _Matrix_TypeA_::Scalar tolerance =
-    epsilon * std::max(a.cols(), a.rows()) * svd.singularValues().array().abs().maxCoeff();
-
-  // Sigma for ThinU and ThinV
-  Eigen::Matrix<typename _Matrix_TypeA_::Scalar, m, m> sigmaThin = Eigen::Matrix<typename _Matrix_TypeA_::Scalar, m, 1>(
-    (svd.singularValues().array().abs() > tolerance).select(svd.singularValues().array().inverse(), 0)).asDiagonal();
-
-  result = svd.matrixV() * sigmaThin * svd.matrixU().transpose();
+  // The workspace only allocates for dynamic sizes
+  PseudoInverseWorkspace<typename _Matrix_TypeA_::PlainObject> workspace(a.rows(), a.cols());
+  workspace.setEpsilon(epsilon);
+  return workspace.compute(a, result);
+}
 
-  return true;
+/*!
+ * \brief Computes the Moore–Penrose pseudoinverse reusing a workspace, see PseudoInverseWorkspace
+ * \param a: Matrix to invert
+ * \param result: Result is written here
+ * \param workspace: Workspace holding the decomposition of the chosen method
+ * \return true if successful
+ */
+template<typename _Matrix_TypeA_, typename _Matrix_TypeB_, typename _Matrix_TypeW_, PseudoInverseMethod _Method_>
+bool static pseudoInverse(const _Matrix_TypeA_ &a, _Matrix_TypeB_ &result, PseudoInverseWorkspace<_Matrix_TypeW_, _Method_>& workspace)
+{
+  return workspace.compute(a, result);
 }
 
 
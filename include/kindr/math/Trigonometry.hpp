@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace kindr {
+
+/*! \brief Trigonometric functions of the standard library, the default of the conversions, see convertRotation().
+ *  \ingroup rotations
+ */
+struct StandardTrigonometry {
+  template<typename Scalar_>
+  static inline Scalar_ sin(Scalar_ angle) {
+    return std::sin(angle);
+  }
+
+  template<typename Scalar_>
+  static inline Scalar_ cos(Scalar_ angle) {
+    return std::cos(angle);
+  }
+
+  template<typename Scalar_>
+  static inline void sincos(Scalar_ angle, Scalar_& sine, Scalar_& cosine) {
+    sine = std::sin(angle);
+    cosine = std::cos(angle);
+  }
+
+  template<typename Scalar_>
+  static inline Scalar_ atan2(Scalar_ y, Scalar_ x) {
+    return std::atan2(y, x);
+  }
+};
+
+/*! \brief Polynomial approximations of the trigonometric functions for targets without a fast math library,
+ *  e.g. microcontrollers with a single precision FPU.
+ *
+ *  The functions need neither tables nor initialization and have no data-dependent branches; the case distinctions
+ *  of the range reduction are multiplications with 0 or 1. The polynomials are the single precision minimax
+ *  approximations of Cephes.
+ *  Maximum absolute errors against std, measured on dense grids:
+ *   - sin, cos, sincos: 3e-9 in double and 2e-7 in float for |angle| <= 1e4. The angle is reduced to [-pi/4, pi/4]
+ *     with a three-term Cody-Waite reduction and a quadrant index of type int.
+ *   - atan2: 1e-8 rad in double and 3e-7 rad in float. The argument is reduced to [-tan(pi/8), tan(pi/8)] with a
+ *     single division. atan2(0, 0) is 0 and the sign of a zero y is respected for x < 0 like std::atan2.
+ *  The float errors include the rounding of the evaluation, i.e. a few ulp. The bounds assume IEEE arithmetic: with
+ *  -ffast-math the compiler may reassociate the range reduction, the float error of sin and cos then stays below 5e-7
+ *  for |angle| <= 10 but grows with the angle, and the sign of zero is not respected.
+ *  \ingroup rotations
+ */
+struct FastTrigonometry {
+  template<typename Scalar_>
+  static inline Scalar_ sin(Scalar_ angle) {
+    Scalar_ sine, cosine;
+    sincos(angle, sine, cosine);
+    return sine;
+  }
+
+  template<typename Scalar_>
+  static inline Scalar_ cos(Scalar_ angle) {
+    Scalar_ sine, cosine;
+    sincos(angle, sine, cosine);
+    return cosine;
+  }
+
+  template<typename Scalar_>
+  static inline void sincos(Scalar_ angle, Scalar_& sine, Scalar_& cosine) {
+    // angle = quadrant*pi/2 + r with |r| <= pi/4, pi/2 is split into three constants whose products with the quadrant are exact.
+    // The quadrant is rounded by a conversion to int, which unlike adding and subtracting 1.5*2^23 is not folded by -ffast-math.
+    const int quadrant = static_cast<int>(angle*Scalar_(0.636619772367581343) + std::copysign(Scalar_(0.5), angle));
+    const Scalar_ q = static_cast<Scalar_>(quadrant);
+    const Scalar_ r = ((angle - q*Scalar_(1.5703125)) - q*Scalar_(4.837512969970703125e-4)) - q*Scalar_(7.54978995489188216e-8);
+    const Scalar_ r2 = r*r;
+    const Scalar_ s = r + r*r2*((Scalar_(-1.9515295891e-4)*r2 + Scalar_(8.3321608736e-3))*r2 + Scalar_(-1.6666654611e-1));
+    const Scalar_ c = Scalar_(1) - Scalar_(0.5)*r2 + r2*r2*((Scalar_(2.443315711809948e-5)*r2 + Scalar_(-1.388731625493765e-3))*r2 + Scalar_(4.166664568298827e-2));
+    // sin(r + quadrant*pi/2) is s, c, -s, -c for the quadrants 0, 1, 2, 3 and cos is c, -s, -c, s. The quadrant is
+    // applied with factors 0 and 1 instead of conditionals, which compilers tend to turn into branches.
+    const Scalar_ swap = static_cast<Scalar_>(quadrant & 1);
+    const Scalar_ sinSign = static_cast<Scalar_>(1 - (quadrant & 2));
+    const Scalar_ cosSign = static_cast<Scalar_>(1 - ((quadrant + 1) & 2));
+    sine = sinSign*(s + swap*(c - s));
+    cosine = cosSign*(c - swap*(c - s));
+  }
+
+  template<typename Scalar_>
+  static inline Scalar_ atan2(Scalar_ y, Scalar_ x) {
+    using std::abs;
+    const Scalar_ pi = Scalar_(3.141592653589793238);
+    const Scalar_ absX = abs(x), absY = abs(y);
+    const Scalar_ numerator = std::min(absX, absY);
+    const Scalar_ denominator = std::max(std::max(absX, absY), std::numeric_limits<Scalar_>::min());
+    // tan(phi) = numerator/denominator in [0, 1] and phi = pi/4 + atan((n - d)/(d + n)) above tan(pi/8)
+    const Scalar_ upper = static_cast<Scalar_>(numerator > Scalar_(0.4142135623730950488)*denominator);
+    const Scalar_ t = (numerator - upper*denominator)/(denominator + upper*numerator);
+    const Scalar_ t2 = t*t;
+    Scalar_ angle = t + t*t2*(((Scalar_(8.05374449538e-2)*t2 + Scalar_(-1.38776856032e-1))*t2 + Scalar_(1.99777106478e-1))*t2 + Scalar_(-3.33329491539e-1))
+        + upper*Scalar_(0.25)*pi;
+    // reflections at the diagonal and the y-axis, which are exact for the factors 0 and 1
+    const Scalar_ steep = static_cast<Scalar_>(absY > absX);
+    angle = steep*Scalar_(0.5)*pi + (Scalar_(1) - Scalar_(2)*steep)*angle;
+    const Scalar_ negative = static_cast<Scalar_>(x < Scalar_(0));
+    angle = negative*pi + (Scalar_(1) - Scalar_(2)*negative)*angle;
+    return std::copysign(angle, y);
+  }
+};
+
+} // namespace kindr
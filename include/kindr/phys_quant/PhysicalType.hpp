@@ -60,6 +60,99 @@ enum class PhysicalType {
   AngularMomentum // 17
 };
 
+namespace internal {
+
+/*! \brief Number of physical types, i.e. the value following the last entry of PhysicalType.
+ */
+constexpr int NumberOfPhysicalTypes = static_cast<int>(PhysicalType::AngularMomentum) + 1;
+
+/*! \class PhysicalTypeExponents
+ * \brief Exponents of the base dimensions mass (M), length (L), time (T) and angle (A) of a physical type.
+ *
+ * The angle is kept as a base dimension such that Angle and Typeless as well as Torque (M L^2 T^-2 A^-1) and Energy
+ * (M L^2 T^-2) are distinct. Products and quotients of vectors take the physical type whose exponents are the sum or
+ * difference of the exponents of the operands, see PhysicalTypeProduct and PhysicalTypeQuotient.
+ */
+template<enum PhysicalType PhysicalType_>
+class PhysicalTypeExponents;
+
+#define KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(TYPE, MASS, LENGTH, TIME, ANGLE) \
+    template<> \
+    class PhysicalTypeExponents<PhysicalType::TYPE> { \
+     public: \
+      static constexpr int Mass = MASS; \
+      static constexpr int Length = LENGTH; \
+      static constexpr int Time = TIME; \
+      static constexpr int Angle = ANGLE; \
+    };
+
+//                                   type                 M   L   T   A
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Typeless,            0,  0,  0,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Time,                0,  0,  1,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Mass,                1,  0,  0,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Inertia,             1,  2,  0, -2)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Power,               1,  2, -3,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Energy,              1,  2, -2,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Jerk,                0,  1, -3,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Acceleration,        0,  1, -2,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Velocity,            0,  1, -1,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Position,            0,  1,  0,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Force,               1,  1, -2,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Momentum,            1,  1, -1,  0)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(AngularJerk,         0,  0, -3,  1)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(AngularAcceleration, 0,  0, -2,  1)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(AngularVelocity,     0,  0, -1,  1)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Angle,               0,  0,  0,  1)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(Torque,              1,  2, -2, -1)
+KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS(AngularMomentum,     1,  2, -1, -1)
+
+#undef KINDR_SPECIALIZE_PHYS_TYPE_EXPONENTS
+
+/*! \class PhysicalTypeFromExponents
+ * \brief Finds the physical type with the given exponents, Typeless if there is none.
+ */
+template<int Mass_, int Length_, int Time_, int Angle_, int Index_ = 0>
+class PhysicalTypeFromExponents {
+ private:
+  typedef PhysicalTypeExponents<static_cast<PhysicalType>(Index_)> Exponents;
+ public:
+  static constexpr PhysicalType Type = (Exponents::Mass == Mass_ && Exponents::Length == Length_ && Exponents::Time == Time_ && Exponents::Angle == Angle_) ?
+      static_cast<PhysicalType>(Index_) : PhysicalTypeFromExponents<Mass_, Length_, Time_, Angle_, Index_ + 1>::Type;
+};
+
+template<int Mass_, int Length_, int Time_, int Angle_>
+class PhysicalTypeFromExponents<Mass_, Length_, Time_, Angle_, NumberOfPhysicalTypes> {
+ public:
+  static constexpr PhysicalType Type = PhysicalType::Typeless;
+};
+
+/*! \class PhysicalTypeProduct
+ * \brief Physical type of the product of two physical types.
+ */
+template<enum PhysicalType PhysicalType1_, enum PhysicalType PhysicalType2_>
+class PhysicalTypeProduct {
+ private:
+  typedef PhysicalTypeExponents<PhysicalType1_> Exponents1;
+  typedef PhysicalTypeExponents<PhysicalType2_> Exponents2;
+ public:
+  static constexpr PhysicalType Type = PhysicalTypeFromExponents<Exponents1::Mass + Exponents2::Mass, Exponents1::Length + Exponents2::Length,
+                                                                 Exponents1::Time + Exponents2::Time, Exponents1::Angle + Exponents2::Angle>::Type;
+};
+
+/*! \class PhysicalTypeQuotient
+ * \brief Physical type of the quotient of two physical types.
+ */
+template<enum PhysicalType PhysicalType1_, enum PhysicalType PhysicalType2_>
+class PhysicalTypeQuotient {
+ private:
+  typedef PhysicalTypeExponents<PhysicalType1_> Exponents1;
+  typedef PhysicalTypeExponents<PhysicalType2_> Exponents2;
+ public:
+  static constexpr PhysicalType Type = PhysicalTypeFromExponents<Exponents1::Mass - Exponents2::Mass, Exponents1::Length - Exponents2::Length,
+                                                                 Exponents1::Time - Exponents2::Time, Exponents1::Angle - Exponents2::Angle>::Type;
+};
+
+} // namespace internal
 
 } // namespace kindr
 
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/vectors/VectorArray.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+/*! \class PointKinematicsTraits
+ *  \brief Transports the velocity and acceleration of a rigid body to a set of points, see transportVelocities() and
+ *  transportAccelerations().
+ *
+ *  For a few points, e.g. the feet of a legged robot, the rows of the structure-of-arrays inputs are read with one
+ *  pointer each and the cross products of a point are evaluated in registers like in ContactWrenchTraits. Larger
+ *  batches are evaluated with coefficient-wise expressions on the rows, which Eigen vectorizes. The k-th output row only
+ *  depends on the k-th row of the relative velocities or accelerations, hence the output may be one of them.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class PointKinematicsTraits {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  //! Minimum number of points which are transported with expressions on the rows
+  enum { RowwiseSize = 16 };
+
+  /*! \param relativeVelocities   velocities of the points relative to the body, nullptr for points fixed on the body
+   */
+  static void transportVelocities(const Vector3& velocity, const Vector3& angularVelocity, const PositionArray<PrimType_>& positions,
+                                  const VelocityArray<PrimType_>* relativeVelocities, VelocityArray<PrimType_>& velocities) {
+    const int size = positions.size();
+    KINDR_ASSERT_TRUE_HOT(std::runtime_error, relativeVelocities == nullptr || relativeVelocities->size() == size,
+                          "The number of positions and relative velocities must be equal.");
+    velocities.resize(size);
+    Rows rows;
+    rows.stride = size;
+    rows.positions = positions.toImplementation().data();
+    rows.relativeVelocities = relativeVelocities == nullptr ? nullptr : relativeVelocities->toImplementation().data();
+    rows.relativeAccelerations = nullptr;
+    rows.output = velocities.toImplementation().data();
+    if (relativeVelocities == nullptr) {
+      transport<false, false>(rows, velocity, angularVelocity, Vector3::Zero());
+    } else {
+      transport<false, true>(rows, velocity, angularVelocity, Vector3::Zero());
+    }
+  }
+
+  /*! \param relativeVelocities      velocities of the points relative to the body, nullptr for points fixed on the body
+   *  \param relativeAccelerations   accelerations of the points relative to the body, nullptr for points fixed on the body
+   */
+  static void transportAccelerations(const Vector3& acceleration, const Vector3& angularVelocity, const Vector3& angularAcceleration,
+                                     const PositionArray<PrimType_>& positions, const VelocityArray<PrimType_>* relativeVelocities,
+                                     const AccelerationArray<PrimType_>* relativeAccelerations, AccelerationArray<PrimType_>& accelerations) {
+    const int size = positions.size();
+    KINDR_ASSERT_TRUE_HOT(std::runtime_error, (relativeVelocities == nullptr) == (relativeAccelerations == nullptr),
+                          "The relative velocities and accelerations must be given together.");
+    KINDR_ASSERT_TRUE_HOT(std::runtime_error, relativeVelocities == nullptr || (relativeVelocities->size() == size && relativeAccelerations->size() == size),
+                          "The number of positions, relative velocities and relative accelerations must be equal.");
+    accelerations.resize(size);
+    Rows rows;
+    rows.stride = size;
+    rows.positions = positions.toImplementation().data();
+    rows.relativeVelocities = relativeVelocities == nullptr ? nullptr : relativeVelocities->toImplementation().data();
+    rows.relativeAccelerations = relativeAccelerations == nullptr ? nullptr : relativeAccelerations->toImplementation().data();
+    rows.output = accelerations.toImplementation().data();
+    if (relativeVelocities == nullptr) {
+      transport<true, false>(rows, acceleration, angularVelocity, angularAcceleration);
+    } else {
+      transport<true, true>(rows, acceleration, angularVelocity, angularAcceleration);
+    }
+  }
+
+ private:
+  //! Rows of the structure-of-arrays inputs and output, the i-th coefficient of the row k is at [k*stride+i]
+  struct Rows {
+    int stride;
+    const PrimType_* positions;
+    const PrimType_* relativeVelocities;
+    const PrimType_* relativeAccelerations;
+    PrimType_* output;
+  };
+
+  typedef Eigen::Map<const Eigen::Array<PrimType_, 1, Eigen::Dynamic>> ConstRow;
+  typedef Eigen::Map<Eigen::Array<PrimType_, 1, Eigen::Dynamic>> Row;
+
+  /*! Computes v + w x r (+ v_rel) or, for accelerations,
+   *  a + dw x r + w x (w x r) (+ 2 w x v_rel + a_rel)
+   */
+  template<bool Acceleration_, bool Moving_>
+  static void transport(const Rows& rows, const Vector3& linear, const Vector3& angularVelocity, const Vector3& angularAcceleration) {
+    if (rows.stride < RowwiseSize) {
+      transportPoints<Acceleration_, Moving_>(rows, linear, angularVelocity, angularAcceleration);
+    } else {
+      transportRows<Acceleration_, Moving_>(rows, linear, angularVelocity, angularAcceleration);
+    }
+  }
+
+  template<bool Acceleration_, bool Moving_>
+  static void transportPoints(const Rows& rows, const Vector3& linear, const Vector3& angularVelocity, const Vector3& angularAcceleration) {
+    const int n = rows.stride;
+    // copies, since the output may alias the arguments for the compiler
+    const PrimType_ lx = linear.x(), ly = linear.y(), lz = linear.z();
+    const PrimType_ wx = angularVelocity.x(), wy = angularVelocity.y(), wz = angularVelocity.z();
+    const PrimType_ ax = angularAcceleration.x(), ay = angularAcceleration.y(), az = angularAcceleration.z();
+    for (int i = 0; i < n; ++i) {
+      const PrimType_ rx = rows.positions[i];
+      const PrimType_ ry = rows.positions[n+i];
+      const PrimType_ rz = rows.positions[2*n+i];
+
+      // w x r
+      const PrimType_ cx = wy*rz - wz*ry;
+      const PrimType_ cy = wz*rx - wx*rz;
+      const PrimType_ cz = wx*ry - wy*rx;
+      PrimType_ ox, oy, oz;
+      if (Acceleration_) {
+        // tangential dw x r and centripetal w x (w x r)
+        ox = lx + ay*rz - az*ry + wy*cz - wz*cy;
+        oy = ly + az*rx - ax*rz + wz*cx - wx*cz;
+        oz = lz + ax*ry - ay*rx + wx*cy - wy*cx;
+        if (Moving_) {
+          // Coriolis 2 w x v_rel and relative acceleration
+          const PrimType_ vx = rows.relativeVelocities[i];
+          const PrimType_ vy = rows.relativeVelocities[n+i];
+          const PrimType_ vz = rows.relativeVelocities[2*n+i];
+          ox += PrimType_(2)*(wy*vz - wz*vy) + rows.relativeAccelerations[i];
+          oy += PrimType_(2)*(wz*vx - wx*vz) + rows.relativeAccelerations[n+i];
+          oz += PrimType_(2)*(wx*vy - wy*vx) + rows.relativeAccelerations[2*n+i];
+        }
+      } else {
+        ox = lx + cx;
+        oy = ly + cy;
+        oz = lz + cz;
+        if (Moving_) {
+          ox += rows.relativeVelocities[i];
+          oy += rows.relativeVelocities[n+i];
+          oz += rows.relativeVelocities[2*n+i];
+        }
+      }
+      rows.output[i] = ox;
+      rows.output[n+i] = oy;
+      rows.output[2*n+i] = oz;
+    }
+  }
+
+  template<bool Acceleration_, bool Moving_>
+  static void transportRows(const Rows& rows, const Vector3& linear, const Vector3& angularVelocity, const Vector3& angularAcceleration) {
+    const int n = rows.stride;
+    const PrimType_ wx = angularVelocity.x(), wy = angularVelocity.y(), wz = angularVelocity.z();
+    const PrimType_ ax = angularAcceleration.x(), ay = angularAcceleration.y(), az = angularAcceleration.z();
+    const ConstRow rx(rows.positions, n), ry(rows.positions + n, n), rz(rows.positions + 2*n, n);
+    Row ox(rows.output, n), oy(rows.output + n, n), oz(rows.output + 2*n, n);
+
+    // w x r, evaluated lazily within the expressions
+    const auto cx = wy*rz - wz*ry;
+    const auto cy = wz*rx - wx*rz;
+    const auto cz = wx*ry - wy*rx;
+    if (Acceleration_) {
+      if (Moving_) {
+        const ConstRow vx(rows.relativeVelocities, n), vy(rows.relativeVelocities + n, n), vz(rows.relativeVelocities + 2*n, n);
+        const ConstRow dvx(rows.relativeAccelerations, n), dvy(rows.relativeAccelerations + n, n), dvz(rows.relativeAccelerations + 2*n, n);
+        ox = linear.x() + ay*rz - az*ry + wy*cz - wz*cy + PrimType_(2)*(wy*vz - wz*vy) + dvx;
+        oy = linear.y() + az*rx - ax*rz + wz*cx - wx*cz + PrimType_(2)*(wz*vx - wx*vz) + dvy;
+        oz = linear.z() + ax*ry - ay*rx + wx*cy - wy*cx + PrimType_(2)*(wx*vy - wy*vx) + dvz;
+      } else {
+        ox = linear.x() + ay*rz - az*ry + wy*cz - wz*cy;
+        oy = linear.y() + az*rx - ax*rz + wz*cx - wx*cz;
+        oz = linear.z() + ax*ry - ay*rx + wx*cy - wy*cx;
+      }
+    } else {
+      if (Moving_) {
+        const ConstRow vx(rows.relativeVelocities, n), vy(rows.relativeVelocities + n, n), vz(rows.relativeVelocities + 2*n, n);
+        ox = linear.x() + cx + vx;
+        oy = linear.y() + cy + vy;
+        oz = linear.z() + cz + vz;
+      } else {
+        ox = linear.x() + cx;
+        oy = linear.y() + cy;
+        oz = linear.z() + cz;
+      }
+    }
+  }
+};
+
+} // namespace internal
+
+/*! \brief Transports the velocity of a rigid body to a set of points fixed on the body.
+ *
+ *  The body moves with the velocity v of its reference point A and the angular velocity w. The velocity of the i-th
+ *  point with position r_i relative to A is v_i = v + w x r_i. All vectors must be expressed in the same frame, i.e. a
+ *  LocalAngularVelocity goes with positions and velocities in the body frame and a GlobalAngularVelocity with the world
+ *  frame. This replaces a loop over the operators of Vector, e.g.
+ *  \code{cpp}
+ *  kindr::VelocityArrayD footVelocities;
+ *  kindr::transportVelocities(baseVelocity, baseAngularVelocity, footPositions, footVelocities);
+ *  \endcode
+ *  \param velocity          velocity v of the reference point
+ *  \param angularVelocity   angular velocity w of the body
+ *  \param positions         positions r_i of the points relative to the reference point
+ *  \param velocities        resized to the number of points, the velocities v_i are written here
+ */
+template<typename PrimType_>
+void transportVelocities(const Velocity<PrimType_, 3>& velocity, const AngularVelocity<PrimType_, 3>& angularVelocity,
+                         const PositionArray<PrimType_>& positions, VelocityArray<PrimType_>& velocities) {
+  internal::PointKinematicsTraits<PrimType_>::transportVelocities(velocity.toImplementation(), angularVelocity.toImplementation(),
+                                                                  positions, nullptr, velocities);
+}
+
+/*! \brief Transports the velocity of a rigid body to a set of points moving relative to the body, see
+ *  transportVelocities(). The velocity of the i-th point is v_i = v + w x r_i + v_rel_i.
+ *  \param velocity             velocity v of the reference point
+ *  \param angularVelocity      angular velocity w of the body
+ *  \param positions            positions r_i of the points relative to the reference point
+ *  \param relativeVelocities   velocities v_rel_i of the points relative to the body, i.e. the derivatives of r_i in the rotating frame
+ *  \param velocities           resized to the number of points, the velocities v_i are written here
+ */
+template<typename PrimType_>
+void transportVelocities(const Velocity<PrimType_, 3>& velocity, const AngularVelocity<PrimType_, 3>& angularVelocity,
+                         const PositionArray<PrimType_>& positions, const VelocityArray<PrimType_>& relativeVelocities,
+                         VelocityArray<PrimType_>& velocities) {
+  internal::PointKinematicsTraits<PrimType_>::transportVelocities(velocity.toImplementation(), angularVelocity.toImplementation(),
+                                                                  positions, &relativeVelocities, velocities);
+}
+
+/*! \brief Transports the acceleration of a rigid body to a set of points fixed on the body, see transportVelocities().
+ *
+ *  The acceleration of the i-th point is a_i = a + dw x r_i + w x (w x r_i), i.e. the acceleration a of the reference
+ *  point plus the tangential and the centripetal acceleration.
+ *  \param acceleration          acceleration a of the reference point
+ *  \param angularVelocity       angular velocity w of the body
+ *  \param angularAcceleration   angular acceleration dw of the body
+ *  \param positions             positions r_i of the points relative to the reference point
+ *  \param accelerations         resized to the number of points, the accelerations a_i are written here
+ */
+template<typename PrimType_>
+void transportAccelerations(const Acceleration<PrimType_, 3>& acceleration, const AngularVelocity<PrimType_, 3>& angularVelocity,
+                            const AngularAcceleration<PrimType_, 3>& angularAcceleration, const PositionArray<PrimType_>& positions,
+                            AccelerationArray<PrimType_>& accelerations) {
+  internal::PointKinematicsTraits<PrimType_>::transportAccelerations(acceleration.toImplementation(), angularVelocity.toImplementation(),
+                                                                     angularAcceleration.toImplementation(), positions, nullptr, nullptr, accelerations);
+}
+
+/*! \brief Transports the acceleration of a rigid body to a set of points moving relative to the body, see
+ *  transportAccelerations(). The Coriolis term and the relative acceleration are added, i.e.
+ *  a_i = a + dw x r_i + w x (w x r_i) + 2 w x v_rel_i + a_rel_i.
+ *  \param acceleration            acceleration a of the reference point
+ *  \param angularVelocity         angular velocity w of the body
+ *  \param angularAcceleration     angular acceleration dw of the body
+ *  \param positions               positions r_i of the points relative to the reference point
+ *  \param relativeVelocities      velocities v_rel_i of the points relative to the body
+ *  \param relativeAccelerations   accelerations a_rel_i of the points relative to the body
+ *  \param accelerations           resized to the number of points, the accelerations a_i are written here
+ */
+template<typename PrimType_>
+void transportAccelerations(const Acceleration<PrimType_, 3>& acceleration, const AngularVelocity<PrimType_, 3>& angularVelocity,
+                            const AngularAcceleration<PrimType_, 3>& angularAcceleration, const PositionArray<PrimType_>& positions,
+                            const VelocityArray<PrimType_>& relativeVelocities, const AccelerationArray<PrimType_>& relativeAccelerations,
+                            AccelerationArray<PrimType_>& accelerations) {
+  internal::PointKinematicsTraits<PrimType_>::transportAccelerations(acceleration.toImplementation(), angularVelocity.toImplementation(),
+                                                                     angularAcceleration.toImplementation(), positions, &relativeVelocities,
+                                                                     &relativeAccelerations, accelerations);
+}
+
+} // namespace kindr
@@ -105,14 +105,25 @@ public:
   }
 
   inline void setVector(const Vector6& wrench) {
-    *this = Wrench6(wrench);
+    getVectorMap() = wrench;
   }
 
   inline Vector6 getVector() const {
-    Vector6 vector;
-    vector.template head<3>() = getForce().toImplementation();
-    vector.template tail<3>() = getTorque().toImplementation();
-    return vector;
+    return getVectorMap();
+  }
+
+  /*! \brief Gets a writable view of the wrench as the 6D-vector [force; torque] without copying.
+   *  \returns view of the wrench
+   */
+  inline Eigen::Map<Vector6> getVectorMap() {
+    return Eigen::Map<Vector6>(force_.toImplementation().data());
+  }
+
+  /*! \brief Gets a read-only view of the wrench as the 6D-vector [force; torque] without copying.
+   *  \returns view of the wrench
+   */
+  inline Eigen::Map<const Vector6> getVectorMap() const {
+    return Eigen::Map<const Vector6>(force_.toImplementation().data());
   }
 
   Wrench6& setZero() {
@@ -231,8 +242,11 @@ public:
     return out;
   }
 protected:
+  //! Consecutive members are laid out in order and padded only for alignment, hence force and torque are contiguous
   Force force_;
   Torque torque_;
+  static_assert(sizeof(Force) == 3*sizeof(PrimType_) && sizeof(Torque) == 3*sizeof(PrimType_) && alignof(Torque) == alignof(PrimType_),
+                "The force and the torque of the wrench must be stored contiguously.");
 };
 
 typedef Wrench6<double> WrenchD;
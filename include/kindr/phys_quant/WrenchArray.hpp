@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/phys_quant/Wrench.hpp"
+#include "kindr/vectors/VectorArray.hpp"
+#include "kindr/rotations/RotationQuaternionArray.hpp"
+
+namespace kindr {
+
+/*! \class WrenchArray
+ *  \brief Batch of wrenches stored in structure-of-arrays layout, i.e. a ForceArray and a TorqueArray of the same size.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class WrenchArray {
+ public:
+  typedef PrimType_ Scalar;
+  typedef ForceArray<PrimType_> Forces;
+  typedef TorqueArray<PrimType_> Torques;
+  typedef Wrench6<PrimType_> Element;
+
+  /*! \brief Default constructor creating an empty batch.
+   */
+  WrenchArray() = default;
+
+  /*! \brief Constructor creating a batch of zero wrenches.
+   *  \param size   number of wrenches
+   */
+  explicit WrenchArray(int size)
+    : forces_(size),
+      torques_(size) {
+  }
+
+  /*! \brief Constructor using forces and torques of the same size.
+   *  \param forces    forces
+   *  \param torques   torques
+   */
+  WrenchArray(const Forces& forces, const Torques& torques)
+    : forces_(forces),
+      torques_(torques) {
+    KINDR_ASSERT_TRUE(std::runtime_error, forces.size() == torques.size(), "The number of forces and torques must be equal.");
+  }
+
+  /*! \brief Gets the number of wrenches.
+   *  \returns number of wrenches
+   */
+  inline int size() const {
+    return forces_.size();
+  }
+
+  /*! \brief Resizes the batch. The content is undefined afterwards.
+   *  \param size   number of wrenches
+   */
+  inline void resize(int size) {
+    forces_.resize(size);
+    torques_.resize(size);
+  }
+
+  /*! \brief Sets all wrenches to zero.
+   *  \returns reference
+   */
+  WrenchArray& setZero() {
+    forces_.setZero();
+    torques_.setZero();
+    return *this;
+  }
+
+  /*! \brief Gets the i-th wrench.
+   *  \returns wrench
+   */
+  inline Element operator [](int i) const {
+    return Element(forces_[i], torques_[i]);
+  }
+
+  /*! \brief Sets the i-th wrench.
+   *  \param i        index
+   *  \param wrench   wrench
+   */
+  inline void set(int i, const Element& wrench) {
+    forces_.set(i, wrench.getForce());
+    torques_.set(i, wrench.getTorque());
+  }
+
+  inline Forces& getForces() {
+    return forces_;
+  }
+
+  inline const Forces& getForces() const {
+    return forces_;
+  }
+
+  inline Torques& getTorques() {
+    return torques_;
+  }
+
+  inline const Torques& getTorques() const {
+    return torques_;
+  }
+
+  /*! \brief Sums the wrenches, which must be referred to the same point.
+   *  \returns sum
+   */
+  Element getSum() const {
+    return Element(typename Element::Vector3(forces_.toImplementation().rowwise().sum()),
+                   typename Element::Vector3(torques_.toImplementation().rowwise().sum()));
+  }
+
+ private:
+  Forces forces_;
+  Torques torques_;
+};
+
+typedef WrenchArray<double> WrenchArrayD;
+typedef WrenchArray<float> WrenchArrayF;
+
+
+namespace internal {
+
+/*! \class ContactWrenchTraits
+ *  \brief Transforms contact wrenches to the base frame, see transformContactWrenches().
+ *
+ *  The rows of the structure-of-arrays inputs are read with one pointer each and every contact is transformed and
+ *  accumulated in registers in a single pass. For the few contacts of a legged robot this is faster than coefficient-wise
+ *  expressions on blocks of the rows, whose setup costs more than the transformation of a contact.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class ContactWrenchTraits {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  /*! \param contactTorques   torques in the contact frames, nullptr for point contacts
+   *  \returns the net wrench referred to the origin of the base frame
+   */
+  static Wrench6<PrimType_> transform(const PositionArray<PrimType_>& positions, const RotationQuaternionArray<PrimType_>& rotations,
+                                      const ForceArray<PrimType_>& contactForces, const TorqueArray<PrimType_>* contactTorques,
+                                      WrenchArray<PrimType_>& baseWrenches) {
+    const int size = positions.size();
+    KINDR_ASSERT_TRUE_HOT(std::runtime_error, rotations.size() == size && contactForces.size() == size
+                          && (contactTorques == nullptr || contactTorques->size() == size),
+                          "The number of positions, rotations, forces and torques must be equal.");
+    baseWrenches.resize(size);
+    Rows rows;
+    rows.stride = size;
+    rows.quaternions = rotations.toImplementation().data();
+    rows.positions = positions.toImplementation().data();
+    rows.forces = contactForces.toImplementation().data();
+    rows.torques = contactTorques == nullptr ? nullptr : contactTorques->toImplementation().data();
+    rows.baseForces = baseWrenches.getForces().toImplementation().data();
+    rows.baseTorques = baseWrenches.getTorques().toImplementation().data();
+    Vector3 netForce, netTorque;
+    if (contactTorques == nullptr) {
+      transform<false>(rows, netForce, netTorque);
+    } else {
+      transform<true>(rows, netForce, netTorque);
+    }
+    return Wrench6<PrimType_>(netForce, netTorque);
+  }
+
+ private:
+  //! Rows of the structure-of-arrays inputs and outputs, the i-th coefficient of the row k is at [k*stride+i]
+  struct Rows {
+    int stride;
+    const PrimType_* quaternions;
+    const PrimType_* positions;
+    const PrimType_* forces;
+    const PrimType_* torques;
+    PrimType_* baseForces;
+    PrimType_* baseTorques;
+  };
+
+  template<bool HasTorques_>
+  static void transform(const Rows& rows, Vector3& netForce, Vector3& netTorque) {
+    const int n = rows.stride;
+    PrimType_ netForceX = 0, netForceY = 0, netForceZ = 0, netTorqueX = 0, netTorqueY = 0, netTorqueZ = 0;
+    for (int i = 0; i < n; ++i) {
+      const PrimType_ w = rows.quaternions[i];
+      const PrimType_ x = rows.quaternions[n+i];
+      const PrimType_ y = rows.quaternions[2*n+i];
+      const PrimType_ z = rows.quaternions[3*n+i];
+      PrimType_ fx, fy, fz;
+      rotate(w, x, y, z, rows.forces[i], rows.forces[n+i], rows.forces[2*n+i], fx, fy, fz);
+
+      // r x F
+      const PrimType_ rx = rows.positions[i];
+      const PrimType_ ry = rows.positions[n+i];
+      const PrimType_ rz = rows.positions[2*n+i];
+      PrimType_ tx = ry*fz - rz*fy;
+      PrimType_ ty = rz*fx - rx*fz;
+      PrimType_ tz = rx*fy - ry*fx;
+      if (HasTorques_) {
+        PrimType_ cx, cy, cz;
+        rotate(w, x, y, z, rows.torques[i], rows.torques[n+i], rows.torques[2*n+i], cx, cy, cz);
+        tx += cx;
+        ty += cy;
+        tz += cz;
+      }
+
+      rows.baseForces[i] = fx;
+      rows.baseForces[n+i] = fy;
+      rows.baseForces[2*n+i] = fz;
+      rows.baseTorques[i] = tx;
+      rows.baseTorques[n+i] = ty;
+      rows.baseTorques[2*n+i] = tz;
+      netForceX += fx;
+      netForceY += fy;
+      netForceZ += fz;
+      netTorqueX += tx;
+      netTorqueY += ty;
+      netTorqueZ += tz;
+    }
+    netForce = Vector3(netForceX, netForceY, netForceZ);
+    netTorque = Vector3(netTorqueX, netTorqueY, netTorqueZ);
+  }
+
+  //! Rotates a vector with a unit quaternion, v' = v + w*t + u x t with t = 2*u x v
+  static inline void rotate(PrimType_ w, PrimType_ x, PrimType_ y, PrimType_ z, PrimType_ vx, PrimType_ vy, PrimType_ vz,
+                            PrimType_& rx, PrimType_& ry, PrimType_& rz) {
+    const PrimType_ tx = PrimType_(2)*(y*vz - z*vy);
+    const PrimType_ ty = PrimType_(2)*(z*vx - x*vz);
+    const PrimType_ tz = PrimType_(2)*(x*vy - y*vx);
+    rx = vx + w*tx + y*tz - z*ty;
+    ry = vy + w*ty + z*tx - x*tz;
+    rz = vz + w*tz + x*ty - y*tx;
+  }
+};
+
+} // namespace internal
+
+/*! \brief Transforms the wrenches of a set of contacts to the base frame and sums them in a single pass.
+ *
+ *  The wrench of the i-th contact acts at the origin of the contact frame C_i, whose position and orientation in the
+ *  base frame B are r_i and q_BC_i. The transformed wrench [q_BC_i*f_i; q_BC_i*t_i + r_i x q_BC_i*f_i] is expressed
+ *  in B and referred to its origin. This replaces a loop over getForce()/getTorque() of the single contacts, e.g.
+ *  \code{cpp}
+ *  kindr::WrenchArrayD baseWrenches;
+ *  const kindr::WrenchD netWrench = kindr::transformContactWrenches(positions, rotations, contactWrenches, baseWrenches);
+ *  \endcode
+ *  \param positions         positions r_i of the contact frames in the base frame
+ *  \param rotations         rotations q_BC_i from the contact frames to the base frame
+ *  \param contactWrenches   wrenches in the contact frames
+ *  \param baseWrenches      resized to the number of contacts, the wrenches in the base frame are written here
+ *  \returns the net wrench in the base frame, i.e. the sum of the base wrenches
+ */
+template<typename PrimType_>
+Wrench6<PrimType_> transformContactWrenches(const PositionArray<PrimType_>& positions, const RotationQuaternionArray<PrimType_>& rotations,
+                                            const WrenchArray<PrimType_>& contactWrenches, WrenchArray<PrimType_>& baseWrenches) {
+  return internal::ContactWrenchTraits<PrimType_>::transform(positions, rotations, contactWrenches.getForces(), &contactWrenches.getTorques(), baseWrenches);
+}
+
+/*! \brief Transforms the forces of a set of point contacts to the base frame and sums them in a single pass, see
+ *  transformContactWrenches().
+ *  \param positions       positions r_i of the contact frames in the base frame
+ *  \param rotations       rotations q_BC_i from the contact frames to the base frame
+ *  \param contactForces   forces in the contact frames
+ *  \param baseWrenches    resized to the number of contacts, the wrenches [q_BC_i*f_i; r_i x q_BC_i*f_i] are written here
+ *  \returns the net wrench in the base frame
+ */
+template<typename PrimType_>
+Wrench6<PrimType_> transformContactForces(const PositionArray<PrimType_>& positions, const RotationQuaternionArray<PrimType_>& rotations,
+                                          const ForceArray<PrimType_>& contactForces, WrenchArray<PrimType_>& baseWrenches) {
+  return internal::ContactWrenchTraits<PrimType_>::transform(positions, rotations, contactForces, nullptr, baseWrenches);
+}
+
+} // namespace kindr
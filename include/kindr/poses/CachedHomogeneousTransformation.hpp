@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/PoseBase.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+
+namespace kindr {
+
+
+/*! \class CachedHomogeneousTransformation
+ * \brief Homogeneous transformation that caches its transformation matrix.
+ *
+ *  The transformation matrix is computed eagerly by the constructors and the setters and reused by all queries, so
+ *  that const queries never write and concurrent reads of one pose are safe. Accessing the position or the rotation
+ *  through a non-const getter invalidates the matrix; it is recomputed by the next non-const query. A const query
+ *  of an invalidated matrix throws, while transformations of positions fall back to the position and the rotation.
+ *  References obtained from the non-const getters must therefore not be held across queries.
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \tparam Position_ the type of the position
+ * \tparam Rotation_ the type of the rotation
+ * \ingroup poses
+ */
+template<typename PrimType_, typename Position_, typename Rotation_>
+class CachedHomogeneousTransformation : public PoseBase<CachedHomogeneousTransformation<PrimType_, Position_, Rotation_> > {
+ protected:
+  Position_ position_;
+  Rotation_ rotation_;
+  Eigen::Matrix<PrimType_, 4, 4> transformationMatrix_;
+  bool isTransformationMatrixValid_;
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef PrimType_ Scalar;
+  typedef Position_ Position;
+  typedef Rotation_ Rotation;
+  typedef Eigen::Matrix<PrimType_, 4, 4> TransformationMatrix;
+  typedef Eigen::Block<const TransformationMatrix, 3, 4> TransformationMatrixCompact;
+  typedef Eigen::Block<const TransformationMatrix, 3, 3> RotationMatrixBlock;
+  typedef Eigen::Block<const TransformationMatrix, 3, 1> TranslationBlock;
+
+
+  explicit CachedHomogeneousTransformation(): position_(), rotation_(), isTransformationMatrixValid_(false) {
+    transformationMatrix_.template bottomRows<1>() << Scalar(0), Scalar(0), Scalar(0), Scalar(1);
+    updateTransformationMatrix();
+  }
+
+  inline explicit CachedHomogeneousTransformation(const Position& position, const Rotation& rotation) :
+    position_(position), rotation_(rotation), isTransformationMatrixValid_(false) {
+    transformationMatrix_.template bottomRows<1>() << Scalar(0), Scalar(0), Scalar(0), Scalar(1);
+    updateTransformationMatrix();
+  }
+
+  /*! \brief Constructor using another pose.
+   *  \param other   other pose
+   */
+  template<typename OtherDerived_>
+  inline explicit CachedHomogeneousTransformation(const PoseBase<OtherDerived_>& other)
+    : position_(Position(other.derived().getPosition())), rotation_(Rotation(other.derived().getRotation())),
+      isTransformationMatrixValid_(false)
+  {
+    transformationMatrix_.template bottomRows<1>() << Scalar(0), Scalar(0), Scalar(0), Scalar(1);
+    updateTransformationMatrix();
+  }
+
+  /*! \brief Assignment operator
+   *  \param other   other transformation
+   *  \returns reference
+   */
+  CachedHomogeneousTransformation& operator =(const CachedHomogeneousTransformation& other) {
+    position_ = other.position_;
+    rotation_ = other.rotation_;
+    transformationMatrix_ = other.transformationMatrix_;
+    isTransformationMatrixValid_ = other.isTransformationMatrixValid_;
+    return *this;
+  }
+
+  /*! \brief Gets the position and invalidates the cached transformation matrix.
+   *  \returns reference to the position
+   */
+  inline Position_ & getPosition() {
+    isTransformationMatrixValid_ = false;
+    return position_;
+  }
+
+  inline const Position_ & getPosition() const {
+    return position_;
+  }
+
+  /*! \brief Sets the position and updates the cached transformation matrix.
+   *  \param position   position
+   *  \returns reference
+   */
+  CachedHomogeneousTransformation& setPosition(const Position_& position) {
+    position_ = position;
+    updateTransformationMatrix();
+    return *this;
+  }
+
+  /*! \brief Gets the rotation and invalidates the cached transformation matrix.
+   *  \returns reference to the rotation
+   */
+  inline Rotation_ & getRotation() {
+    isTransformationMatrixValid_ = false;
+    return rotation_;
+  }
+
+  inline const Rotation_ & getRotation() const {
+    return rotation_;
+  }
+
+  /*! \brief Sets the rotation and updates the cached transformation matrix.
+   *  \param rotation   rotation
+   *  \returns reference
+   */
+  CachedHomogeneousTransformation& setRotation(const Rotation_& rotation) {
+    rotation_ = rotation;
+    updateTransformationMatrix();
+    return *this;
+  }
+
+  /*! \brief Concenation operator.
+   *  This is explicitly specified, because RotationBase provides also an operator*.
+   *  \returns the concenation of two tansformations
+   */
+  using PoseBase<CachedHomogeneousTransformation<PrimType_, Position_, Rotation_> >::operator*;
+
+  /*! \brief Checks whether the cached transformation matrix matches the position and the rotation.
+   *  \returns false if the position or the rotation was accessed through a non-const getter since the last update
+   */
+  inline bool isTransformationMatrixValid() const {
+    return isTransformationMatrixValid_;
+  }
+
+  /*! \brief Gets the cached 4x4 homogeneous transformation matrix and recomputes it if it was invalidated.
+   *  \returns reference to the transformation matrix
+   */
+  inline const TransformationMatrix& getTransformationMatrix() {
+    if (!isTransformationMatrixValid_) {
+      updateTransformationMatrix();
+    }
+    return transformationMatrix_;
+  }
+
+  /*! \brief Gets the cached 4x4 homogeneous transformation matrix.
+   *  Throws if the matrix was invalidated by a non-const getter, since a const query does not recompute it.
+   *  \returns reference to the transformation matrix
+   */
+  inline const TransformationMatrix& getTransformationMatrix() const {
+    KINDR_ASSERT_TRUE(std::runtime_error, isTransformationMatrixValid_, "The cached transformation matrix is outdated, query it through a non-const pose.");
+    return transformationMatrix_;
+  }
+
+  /*! \brief Gets the affine-compact 3x4 transformation matrix [C t] as a view on the cached matrix.
+   *  \returns the compact transformation matrix
+   */
+  inline TransformationMatrixCompact getTransformationMatrixCompact() {
+    return getTransformationMatrix().template topRows<3>();
+  }
+
+  inline TransformationMatrixCompact getTransformationMatrixCompact() const {
+    return getTransformationMatrix().template topRows<3>();
+  }
+
+  /*! \brief Gets the rotation matrix as a view on the cached matrix.
+   *  \returns the rotation matrix
+   */
+  inline RotationMatrixBlock getRotationMatrix() {
+    return getTransformationMatrix().template topLeftCorner<3,3>();
+  }
+
+  inline RotationMatrixBlock getRotationMatrix() const {
+    return getTransformationMatrix().template topLeftCorner<3,3>();
+  }
+
+  /*! \brief Gets the translation as a view on the cached matrix.
+   *  \returns the translation
+   */
+  inline TranslationBlock getTranslation() {
+    return getTransformationMatrix().template topRightCorner<3,1>();
+  }
+
+  inline TranslationBlock getTranslation() const {
+    return getTransformationMatrix().template topRightCorner<3,1>();
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream & operator << (std::ostream & out, const CachedHomogeneousTransformation & pose) {
+    if (pose.isTransformationMatrixValid()) {
+      out << pose.getTransformationMatrix();
+    } else {
+      out << CachedHomogeneousTransformation(pose.position_, pose.rotation_).getTransformationMatrix();
+    }
+    return out;
+  }
+
+  /*! \brief Sets the pose to identity
+   *  \returns reference
+   */
+  CachedHomogeneousTransformation& setIdentity() {
+    position_.setZero();
+    rotation_.setIdentity();
+    transformationMatrix_.setIdentity();
+    isTransformationMatrixValid_ = true;
+    return *this;
+  }
+
+ protected:
+  inline void updateTransformationMatrix() {
+    transformationMatrix_.template topLeftCorner<3,3>() = RotationMatrix<Scalar>(rotation_).toImplementation();
+    transformationMatrix_.template topRightCorner<3,1>() = position_.toImplementation();
+    isTransformationMatrixValid_ = true;
+  }
+};
+
+template <typename PrimType_>
+using CachedHomTransformQuat = CachedHomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationQuaternion<PrimType_>>;
+typedef CachedHomTransformQuat<double> CachedHomTransformQuatD;
+typedef CachedHomTransformQuat<float> CachedHomTransformQuatF;
+
+template <typename PrimType_>
+using CachedHomTransformMatrix = CachedHomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationMatrix<PrimType_>>;
+typedef CachedHomTransformMatrix<double> CachedHomTransformMatrixD;
+typedef CachedHomTransformMatrix<float> CachedHomTransformMatrixF;
+
+
+namespace internal {
+
+template<typename PrimType_, typename Position_, typename Rotation_>
+class get_position<CachedHomogeneousTransformation<PrimType_, Position_, Rotation_>> {
+ public:
+  //! Position
+  typedef Position_ Position;
+};
+
+template<typename PrimType_, typename Position_, typename Rotation_>
+class TransformationTraits<CachedHomogeneousTransformation<PrimType_, Position_, Rotation_>> {
+ private:
+  typedef CachedHomogeneousTransformation<PrimType_, Position_, Rotation_> Pose;
+  typedef typename get_position<Pose>::Position Translation;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> Matrix3X;
+ public:
+  //! Uses the cached rotation matrix unless it was invalidated, since a const pose cannot recompute it
+  inline static Matrix3 getRotationMatrix(const Pose & pose) {
+    return pose.isTransformationMatrixValid() ? Matrix3(pose.getRotationMatrix()) : Matrix3(RotationMatrix<PrimType_>(pose.getRotation()).toImplementation());
+  }
+  inline static Translation transform(const Pose & pose, const Translation & position){
+    return Translation(getRotationMatrix(pose)*position.toImplementation() + pose.getPosition().toImplementation());
+  }
+  inline static Translation inverseTransform(const Pose & pose, const Translation & position){
+    return Translation(getRotationMatrix(pose).transpose()*(position.toImplementation() - pose.getPosition().toImplementation()));
+  }
+  inline static void transform(const Pose & pose, const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed) {
+    transformColumns<PrimType_>(getRotationMatrix(pose), pose.getPosition().toImplementation(), positions, transformed);
+  }
+  inline static void inverseTransform(const Pose & pose, const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed) {
+    const Matrix3 rotationMatrix = getRotationMatrix(pose).transpose();
+    const Vector3 translation = -rotationMatrix*pose.getPosition().toImplementation();
+    transformColumns<PrimType_>(rotationMatrix, translation, positions, transformed);
+  }
+};
+
+
+/*! \brief Multiplication of two cached transformations with the same parameterization
+ */
+template<typename PrimType_, typename Position_, typename Rotation_>
+class MultiplicationTraits<PoseBase<CachedHomogeneousTransformation<PrimType_, Position_, Rotation_>>, PoseBase<CachedHomogeneousTransformation<PrimType_, Position_, Rotation_>> > {
+ public:
+  typedef CachedHomogeneousTransformation<PrimType_, Position_, Rotation_> Pose;
+  //! The position of the concatenation is computed with the cached rotation matrix of the left-hand side
+  inline static Pose mult(const Pose& lhs, const Pose& rhs) {
+    const Position_ position(TransformationTraits<Pose>::getRotationMatrix(lhs)*rhs.getPosition().toImplementation() + lhs.getPosition().toImplementation());
+    const Rotation_ rotation = lhs.getRotation()*rhs.getRotation();
+    return Pose(position, rotation);
+  }
+};
+
+
+} // namespace internal
+} // namespace kindr
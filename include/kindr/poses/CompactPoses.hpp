@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/vectors/VectorArray.hpp"
+#include "kindr/rotations/CompactRotations.hpp"
+#include "kindr/poses/PoseBase.hpp"
+
+
+namespace kindr {
+
+
+/*! \class CompactPosition
+ *  \brief Position relative to the origin of a tile stored as three half-precision floats (6 bytes).
+ *
+ *  A map or a message is divided into tiles, which store their origin with full precision once. The offsets of the
+ *  positions from the origin of their tile are rounded to float16 with 11 significant bits, such that the error of a
+ *  component of an offset in [-r, r] is at most r/2048, e.g. 0.5 mm for r = 1 m or 8 mm for r = 16 m. The offsets
+ *  must not exceed getMaxOffset().
+ * \ingroup poses
+ */
+class CompactPosition {
+ public:
+  /*! \brief Default constructor encoding the origin of the tile.
+   */
+  CompactPosition()
+    : offset_{Eigen::half(0.0f), Eigen::half(0.0f), Eigen::half(0.0f)} {
+  }
+
+  /*! \brief Constructor encoding a position.
+   *  \param position     position
+   *  \param tileOrigin   origin of the tile
+   */
+  template<typename PrimType_>
+  CompactPosition(const Position<PrimType_, 3>& position, const Position<PrimType_, 3>& tileOrigin) {
+    setOffset((position - tileOrigin).toImplementation());
+  }
+
+  /*! \brief Decodes the position.
+   *  \param tileOrigin   origin of the tile
+   *  \returns position
+   */
+  template<typename PrimType_>
+  Position<PrimType_, 3> getPosition(const Position<PrimType_, 3>& tileOrigin) const {
+    return tileOrigin + Position<PrimType_, 3>(getOffset<PrimType_>());
+  }
+
+  /*! \brief Encodes the offset from the origin of the tile.
+   *  \param offset   offset
+   */
+  template<typename Vector3_>
+  inline void setOffset(const Vector3_& offset) {
+    for (int i = 0; i < 3; ++i) {
+      KINDR_ASSERT_TRUE(std::runtime_error, std::abs(static_cast<double>(offset(i))) <= getMaxOffset(), "The offset " << offset(i) << " from the tile origin is too large for float16.");
+    }
+    setOffsetUnchecked(offset);
+  }
+
+  /*! \brief Encodes the offset from the origin of the tile without checking it, e.g. after checking a whole batch.
+   *  \param offset   offset, which must not exceed getMaxOffset()
+   */
+  template<typename Vector3_>
+  inline void setOffsetUnchecked(const Vector3_& offset) {
+    for (int i = 0; i < 3; ++i) {
+      offset_[i] = Eigen::half(static_cast<float>(offset(i)));
+    }
+  }
+
+  //! \returns the offset from the origin of the tile
+  template<typename PrimType_>
+  inline Eigen::Matrix<PrimType_, 3, 1> getOffset() const {
+    return Eigen::Matrix<PrimType_, 3, 1>(PrimType_(static_cast<float>(offset_[0])), PrimType_(static_cast<float>(offset_[1])),
+                                          PrimType_(static_cast<float>(offset_[2])));
+  }
+
+  //! \returns the largest offset, which is the largest finite float16
+  static double getMaxOffset() {
+    return 65504.0;
+  }
+
+  //! \returns the error bound of a component for offsets in [-range, range]
+  static double getMaxError(double range) {
+    return range/2048.0;
+  }
+
+ protected:
+  Eigen::half offset_[3];
+};
+
+
+/*! \class CompactPose
+ *  \brief Pose stored as a CompactPosition and a CompactRotationQuaternion48 (12 bytes).
+ *
+ *  Compared to the 56 bytes of a HomTransformQuatD, the position has the error of CompactPosition relative to the origin
+ *  of its tile and the rotation an angle error of at most 1.5e-4 rad.
+ * \ingroup poses
+ */
+class CompactPose {
+ public:
+  CompactPose() = default;
+
+  /*! \brief Constructor encoding a pose.
+   *  \param pose         pose
+   *  \param tileOrigin   origin of the tile
+   */
+  template<typename Pose_>
+  CompactPose(const PoseBase<Pose_>& pose, const Position<typename Pose_::Scalar, 3>& tileOrigin)
+    : position_(Position<typename Pose_::Scalar, 3>(pose.derived().getPosition()), tileOrigin),
+      rotation_(pose.derived().getRotation()) {
+  }
+
+  /*! \brief Decodes the pose.
+   *  \param tileOrigin   origin of the tile
+   *  \returns pose, e.g. HomTransformQuatD
+   */
+  template<typename Pose_>
+  Pose_ getPose(const Position<typename Pose_::Scalar, 3>& tileOrigin) const {
+    typedef typename Pose_::Scalar Scalar;
+    return Pose_(typename Pose_::Position(position_.getPosition(tileOrigin)),
+                 typename Pose_::Rotation(rotation_.getRotationQuaternion<Scalar>()));
+  }
+
+  //! \returns the position
+  inline const CompactPosition& getPosition() const {
+    return position_;
+  }
+
+  //! \returns the rotation
+  inline const CompactRotationQuaternion48& getRotation() const {
+    return rotation_;
+  }
+
+ protected:
+  CompactPosition position_;
+  CompactRotationQuaternion48 rotation_;
+};
+
+
+/*! \brief Encodes a batch of positions of a tile.
+ *  The offsets are checked before the batch is distributed, since the chunks on the executor must not throw.
+ *  \param positions    positions
+ *  \param tileOrigin   origin of the tile
+ *  \param compact      encoded positions, which are resized
+ *  \param executor     executor distributing chunks of positions to threads, see SerialExecutor
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+void encode(const PositionArray<PrimType_>& positions, const Position<PrimType_, 3>& tileOrigin, std::vector<CompactPosition>& compact,
+            const Executor_& executor = Executor_()) {
+  compact.resize(positions.size());
+  const typename PositionArray<PrimType_>::Implementation& p = positions.toImplementation();
+  const Eigen::Matrix<PrimType_, 3, 1> origin = tileOrigin.toImplementation();
+  KINDR_ASSERT_TRUE(std::runtime_error, ((p.colwise() - origin).cwiseAbs().array() <= PrimType_(CompactPosition::getMaxOffset())).all(),
+                    "An offset from the tile origin is too large for float16.");
+  CompactPosition* destinations = compact.data();
+  executor.parallelFor(0, positions.size(), internal::CompactEncodingGrainSize, [&p, &origin, destinations](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      destinations[i].setOffsetUnchecked(p.col(i) - origin);
+    }
+  });
+}
+
+/*! \brief Decodes a batch of positions of a tile.
+ *  \param compact      encoded positions
+ *  \param tileOrigin   origin of the tile
+ *  \param positions    positions, which are resized
+ *  \param executor     executor distributing chunks of positions to threads, see SerialExecutor
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+void decode(const std::vector<CompactPosition>& compact, const Position<PrimType_, 3>& tileOrigin, PositionArray<PrimType_>& positions,
+            const Executor_& executor = Executor_()) {
+  positions.resize(static_cast<int>(compact.size()));
+  typename PositionArray<PrimType_>::Implementation& p = positions.toImplementation();
+  const Eigen::Matrix<PrimType_, 3, 1> origin = tileOrigin.toImplementation();
+  const CompactPosition* sources = compact.data();
+  executor.parallelFor(0, positions.size(), internal::CompactEncodingGrainSize, [&p, &origin, sources](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      p.col(i) = origin + sources[i].template getOffset<PrimType_>();
+    }
+  });
+}
+
+
+} // namespace kindr
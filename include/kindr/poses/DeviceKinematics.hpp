@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+#include <algorithm>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+/*! \file DeviceKinematics.hpp
+ *
+ *  The subset of kindr which can be called from CUDA kernels. It covers RotationQuaternion, RotationMatrix,
+ *  Position and HomogeneousTransformation: construction and element access, rotation and transformation of
+ *  vectors, and the exponential and logarithmic maps of the rotations. The functions are marked with
+ *  KINDR_DEVICE_FUNC, which expands to __host__ __device__ with nvcc, and compute the same results as the
+ *  corresponding member functions on the host. The rest of the interface stays host-only since it relies on
+ *  executors, streams and the conversion machinery.
+ *
+ *  If compiled with nvcc, transformPositions() transforms a batch of positions stored in device memory.
+ */
+
+namespace kindr {
+namespace device {
+
+//! Rotates a vector by a rotation quaternion without computing the rotation matrix.
+template<typename PrimType_>
+KINDR_DEVICE_FUNC inline Eigen::Matrix<PrimType_, 3, 1> rotate(const RotationQuaternion<PrimType_>& rotation, const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  return internal::RotationTraits<RotationBase<RotationQuaternion<PrimType_>>>::rotateVector(rotation, vector);
+}
+
+//! Rotates a vector by the inverse of a rotation quaternion.
+template<typename PrimType_>
+KINDR_DEVICE_FUNC inline Eigen::Matrix<PrimType_, 3, 1> inverseRotate(const RotationQuaternion<PrimType_>& rotation, const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  return internal::RotationTraits<RotationBase<RotationQuaternion<PrimType_>>>::inverseRotateVector(rotation, vector);
+}
+
+//! Rotates a vector by a rotation matrix.
+template<typename PrimType_>
+KINDR_DEVICE_FUNC inline Eigen::Matrix<PrimType_, 3, 1> rotate(const RotationMatrix<PrimType_>& rotation, const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  return rotation.toImplementation()*vector;
+}
+
+//! Rotates a vector by the transpose of a rotation matrix.
+template<typename PrimType_>
+KINDR_DEVICE_FUNC inline Eigen::Matrix<PrimType_, 3, 1> inverseRotate(const RotationMatrix<PrimType_>& rotation, const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  return rotation.toImplementation().transpose()*vector;
+}
+
+//! Transforms a position, i.e. computes C*r + t.
+template<typename PrimType_, typename Rotation_>
+KINDR_DEVICE_FUNC inline Position<PrimType_, 3> transform(const HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, Rotation_>& pose,
+                                                          const Position<PrimType_, 3>& position) {
+  return Position<PrimType_, 3>(Eigen::Matrix<PrimType_, 3, 1>(
+      device::rotate(pose.getRotation(), position.toImplementation()) + pose.getPosition().toImplementation()));
+}
+
+//! Transforms a position in reverse, i.e. computes C^T*(r - t).
+template<typename PrimType_, typename Rotation_>
+KINDR_DEVICE_FUNC inline Position<PrimType_, 3> inverseTransform(const HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, Rotation_>& pose,
+                                                                 const Position<PrimType_, 3>& position) {
+  return Position<PrimType_, 3>(device::inverseRotate(pose.getRotation(),
+      Eigen::Matrix<PrimType_, 3, 1>(position.toImplementation() - pose.getPosition().toImplementation())));
+}
+
+//! Gets the rotation from a rotation vector, see RotationBase::exponentialMap().
+template<typename Rotation_>
+KINDR_DEVICE_FUNC inline Rotation_ exponentialMap(const Eigen::Matrix<typename Rotation_::Scalar, 3, 1>& vector) {
+  return internal::MapTraits<RotationBase<Rotation_>>::set_exponential_map(vector);
+}
+
+//! Gets the unique rotation vector (norm in [0,pi]) of a rotation quaternion, see RotationBase::logarithmicMap().
+template<typename PrimType_>
+KINDR_DEVICE_FUNC inline Eigen::Matrix<PrimType_, 3, 1> logarithmicMap(const RotationQuaternion<PrimType_>& rotation) {
+  return internal::MapTraits<RotationBase<RotationQuaternion<PrimType_>>>::get_logarithmic_map(rotation);
+}
+
+//! Gets the unique rotation vector (norm in [0,pi]) of a rotation matrix through the rotation quaternion.
+template<typename PrimType_>
+KINDR_DEVICE_FUNC inline Eigen::Matrix<PrimType_, 3, 1> logarithmicMap(const RotationMatrix<PrimType_>& rotation) {
+  return device::logarithmicMap(RotationQuaternion<PrimType_>(Eigen::Quaternion<PrimType_>(rotation.toImplementation())));
+}
+
+/*! \brief Transforms the position with the given index of a batch.
+ *  The positions are stored as consecutive x, y, z triplets, i.e. like the columns of an Eigen::Matrix3X.
+ *  This is the body of the batch kernel and can be used in custom kernels.
+ */
+template<typename PrimType_, typename Rotation_>
+KINDR_DEVICE_FUNC inline void transformPosition(const HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, Rotation_>& pose,
+                                                const PrimType_* positions, PrimType_* transformed, int index) {
+  const Eigen::Map<const Eigen::Matrix<PrimType_, 3, 1>> position(positions + 3*index);
+  Eigen::Map<Eigen::Matrix<PrimType_, 3, 1>> result(transformed + 3*index);
+  result = device::rotate(pose.getRotation(), Eigen::Matrix<PrimType_, 3, 1>(position)) + pose.getPosition().toImplementation();
+}
+
+#if defined(__CUDACC__)
+
+//! Grid-stride kernel which transforms a batch of positions.
+template<typename PrimType_, typename Rotation_>
+__global__ void transformPositionsKernel(const HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, Rotation_> pose,
+                                         const PrimType_* positions, PrimType_* transformed, int size) {
+  for (int i = blockIdx.x*blockDim.x + threadIdx.x; i < size; i += blockDim.x*gridDim.x) {
+    transformPosition(pose, positions, transformed, i);
+  }
+}
+
+/*! \brief Transforms a batch of positions in device memory.
+ *  The positions and the output are arrays of 3*size scalars in device memory. The kernel is launched
+ *  asynchronously on the given stream.
+ */
+template<typename PrimType_, typename Rotation_>
+inline void transformPositions(const HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, Rotation_>& pose,
+                               const PrimType_* positions, PrimType_* transformed, int size, cudaStream_t stream = 0) {
+  if (size <= 0) {
+    return;
+  }
+  const int threads = 256;
+  const int blocks = std::min((size + threads - 1)/threads, 4096);
+  transformPositionsKernel<<<blocks, threads, 0, stream>>>(pose, positions, transformed, size);
+  const cudaError_t error = cudaGetLastError();
+  KINDR_ASSERT_TRUE(std::runtime_error, error == cudaSuccess, "Kernel launch failed: " << cudaGetErrorString(error));
+}
+
+#endif
+
+} // namespace device
+} // namespace kindr
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+#include <vector>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Allocators.hpp"
+#include "kindr/poses/PoseBase.hpp"
+
+
+namespace kindr {
+
+
+/*! \class FrameTree
+ * \brief Tree of coordinate frames connected by poses, which caches the pose of every frame with respect to the root.
+ *
+ *  Frame 0 is the root frame. Every other frame is attached to a parent frame by the pose T_P_F, which transforms
+ *  positions expressed in the frame F to positions expressed in its parent P. The poses T_R_F of the frames with
+ *  respect to the root R are composed lazily on the first query and cached. Changing an edge invalidates only the
+ *  cached poses of the subtree below it, and the pose T_A_B between two arbitrary frames is obtained from the two
+ *  cached root poses as T_R_A^-1 * T_R_B.
+ *
+ *  Since the pose queries update the cache, they are non-const and a tree must not be queried from several threads
+ *  without synchronization. The references returned by the getters are invalidated by addFrame.
+ * \tparam Pose_ the type of the pose, e.g. HomTransformQuatD
+ * \ingroup poses
+ */
+template<typename Pose_>
+class FrameTree {
+ public:
+  typedef Pose_ Pose;
+  typedef typename Pose_::Position Position;
+  typedef typename Pose_::Rotation Rotation;
+
+  //! Index of the root frame
+  enum { RootFrame = 0 };
+
+  /*! \brief Default constructor.
+   *
+   *  Creates a tree which only consists of the root frame.
+   */
+  FrameTree() {
+    Frame root;
+    root.parent_ = -1;
+    root.poseToRoot_.setIdentity();
+    root.poseToParent_.setIdentity();
+    root.isPoseToRootValid_ = true;
+    frames_.push_back(root);
+  }
+
+  /*! \brief Adds a frame to the tree.
+   *  \param parent         index of the parent frame
+   *  \param poseToParent   pose T_P_F of the new frame F with respect to its parent P
+   *  \returns the index of the new frame
+   */
+  int addFrame(int parent, const Pose_& poseToParent) {
+    checkFrame(parent);
+    Frame frame;
+    frame.parent_ = parent;
+    frame.poseToParent_ = poseToParent;
+    frame.isPoseToRootValid_ = false;
+    frames_.push_back(frame);
+    const int index = static_cast<int>(frames_.size()) - 1;
+    frames_[parent].children_.push_back(index);
+    return index;
+  }
+
+  /*! \brief Changes the pose of a frame with respect to its parent and invalidates the cached poses of its subtree.
+   *  \param frame          index of the frame
+   *  \param poseToParent   pose T_P_F of the frame F with respect to its parent P
+   */
+  void setPoseToParent(int frame, const Pose_& poseToParent) {
+    checkFrame(frame);
+    KINDR_ASSERT_TRUE(std::runtime_error, frame != RootFrame, "The root frame has no parent.");
+    frames_[frame].poseToParent_ = poseToParent;
+    invalidate(frame);
+  }
+
+  /*! \brief Gets the pose of a frame with respect to its parent.
+   *  \param frame   index of the frame
+   *  \returns reference to the pose T_P_F
+   */
+  inline const Pose_& getPoseToParent(int frame) const {
+    checkFrame(frame);
+    return frames_[frame].poseToParent_;
+  }
+
+  /*! \brief Gets the pose of a frame with respect to the root frame.
+   *  Only the poses between the frame and its closest ancestor with a valid cache are composed and cached.
+   *  \param frame   index of the frame
+   *  \returns reference to the cached pose T_R_F
+   */
+  const Pose_& getPoseToRoot(int frame) {
+    checkFrame(frame);
+    if (!frames_[frame].isPoseToRootValid_) {
+      // Collect the frames without a valid cache, the root is always valid
+      path_.clear();
+      for (int i = frame; !frames_[i].isPoseToRootValid_; i = frames_[i].parent_) {
+        path_.push_back(i);
+      }
+      for (typename std::vector<int>::const_reverse_iterator it = path_.rbegin(); it != path_.rend(); ++it) {
+        const Frame& parent = frames_[frames_[*it].parent_];
+        frames_[*it].poseToRoot_ = parent.poseToRoot_*frames_[*it].poseToParent_;
+        frames_[*it].isPoseToRootValid_ = true;
+      }
+    }
+    return frames_[frame].poseToRoot_;
+  }
+
+  /*! \brief Gets the pose of a frame B with respect to a frame A.
+   *  \param frameA   index of the frame A in which the pose is expressed
+   *  \param frameB   index of the frame B
+   *  \returns the pose T_A_B = T_R_A^-1 * T_R_B
+   */
+  Pose_ getPose(int frameA, int frameB) {
+    const Pose_& poseAToRoot = getPoseToRoot(frameA);
+    const Pose_& poseBToRoot = getPoseToRoot(frameB);
+    const Rotation rotationRootToA = poseAToRoot.getRotation().inverted();
+    return Pose_(Position(rotationRootToA.rotate(poseBToRoot.getPosition() - poseAToRoot.getPosition())),
+                 rotationRootToA*poseBToRoot.getRotation());
+  }
+
+  /*! \brief Gets the parent of a frame.
+   *  \returns the index of the parent or -1 for the root frame
+   */
+  inline int getParent(int frame) const {
+    checkFrame(frame);
+    return frames_[frame].parent_;
+  }
+
+  /*! \brief Gets the children of a frame.
+   *  \returns the indices of the children
+   */
+  inline const std::vector<int>& getChildren(int frame) const {
+    checkFrame(frame);
+    return frames_[frame].children_;
+  }
+
+  /*! \brief Gets the number of frames including the root frame.
+   *  \returns the number of frames
+   */
+  inline int getNumFrames() const {
+    return static_cast<int>(frames_.size());
+  }
+
+ protected:
+  struct Frame {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    int parent_;
+    std::vector<int> children_;
+    Pose_ poseToParent_;
+    Pose_ poseToRoot_;
+    bool isPoseToRootValid_;
+  };
+
+  inline void checkFrame(int frame) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, frame >= 0 && frame < static_cast<int>(frames_.size()), "The frame index is out of range.");
+  }
+
+  /*! \brief Invalidates the cached poses of a frame and its subtree.
+   *  The subtree of a frame with an invalid cache is invalid as well, such that these branches are skipped.
+   */
+  void invalidate(int frame) {
+    path_.clear();
+    path_.push_back(frame);
+    while (!path_.empty()) {
+      const int i = path_.back();
+      path_.pop_back();
+      if (frames_[i].isPoseToRootValid_) {
+        frames_[i].isPoseToRootValid_ = false;
+        path_.insert(path_.end(), frames_[i].children_.begin(), frames_[i].children_.end());
+      }
+    }
+  }
+
+  AlignedVector<Frame> frames_;
+  //! Work buffer for traversals, kept to avoid allocations
+  std::vector<int> path_;
+};
+
+
+} // namespace kindr
@@ -30,9 +30,11 @@
 
 #include "kindr/common/common.hpp"
 #include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/common/ColumnTransformKernels.hpp"
 #include "kindr/phys_quant/PhysicalQuantities.hpp"
 #include "kindr/rotations/Rotation.hpp"
 #include "kindr/poses/PoseBase.hpp"
+#include "kindr/poses/PoseFwd.hpp"
 
 
 namespace kindr {
@@ -44,18 +46,20 @@ class HomogeneousTransformation : public PoseBase<HomogeneousTransformation<Prim
   Position_ position_;
   Rotation_ rotation_;
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
   typedef PrimType_ Scalar;
   typedef Position_ Position;
   typedef Rotation_ Rotation;
   typedef Eigen::Matrix<PrimType_, 4, 4> TransformationMatrix;
+  typedef Eigen::Matrix<PrimType_, 3, 4> TransformationMatrixCompact;
 
 
-  explicit HomogeneousTransformation(): position_(), rotation_() {
+  KINDR_DEVICE_FUNC explicit HomogeneousTransformation(): position_(), rotation_() {
 
   }
 
-  inline explicit HomogeneousTransformation(const Position& position, const Rotation& rotation) :
+  KINDR_DEVICE_FUNC inline explicit HomogeneousTransformation(const Position& position, const Rotation& rotation) :
     position_(position),rotation_(rotation) {
   }
 
@@ -79,19 +83,19 @@ class HomogeneousTransformation : public PoseBase<HomogeneousTransformation<Prim
     return *this;
   }
 
-  inline Position_ & getPosition() {
+  KINDR_DEVICE_FUNC inline Position_ & getPosition() {
     return position_;
   }
 
-  inline const Position_ & getPosition() const {
+  KINDR_DEVICE_FUNC inline const Position_ & getPosition() const {
     return position_;
   }
 
-  inline Rotation_ & getRotation() {
+  KINDR_DEVICE_FUNC inline Rotation_ & getRotation() {
     return rotation_;
   }
 
-  inline const Rotation_ & getRotation() const {
+  KINDR_DEVICE_FUNC inline const Rotation_ & getRotation() const {
     return rotation_;
   }
 
@@ -101,14 +105,56 @@ class HomogeneousTransformation : public PoseBase<HomogeneousTransformation<Prim
    */
   using PoseBase<HomogeneousTransformation<PrimType_, Position_, Rotation_> >::operator*;
 
+  /*! \brief Gets the 4x4 homogeneous transformation matrix.
+   *  \returns the transformation matrix
+   */
   inline TransformationMatrix getTransformationMatrix() const {
-    TransformationMatrix mat = TransformationMatrix::Zero();
-    mat.template topLeftCorner<3,3>() =  RotationMatrix<Scalar>(getRotation()).toImplementation();
+    TransformationMatrix mat;
+    mat.template topLeftCorner<3,3>() = RotationMatrix<Scalar>(getRotation()).toImplementation();
     mat.template topRightCorner<3,1>() = getPosition().toImplementation();
+    mat(3,0) = Scalar(0);
+    mat(3,1) = Scalar(0);
+    mat(3,2) = Scalar(0);
     mat(3,3) = Scalar(1);
     return mat;
   }
 
+  /*! \brief Gets the affine-compact 3x4 transformation matrix [C t], i.e. without the constant last row.
+   *  \returns the compact transformation matrix
+   */
+  inline TransformationMatrixCompact getTransformationMatrixCompact() const {
+    TransformationMatrixCompact mat;
+    mat.template leftCols<3>() = RotationMatrix<Scalar>(getRotation()).toImplementation();
+    mat.template rightCols<1>() = getPosition().toImplementation();
+    return mat;
+  }
+
+  /*! \brief Transforms the columns of a large 3xN matrix, e.g. a point cloud, into a preallocated matrix.
+   *  The columns are processed in chunks, see internal::ColumnTransformKernels. The output may be the input itself.
+   *  \param positions      3xN matrix of positions
+   *  \param transformed    3xN matrix of transformed positions
+   *  \param executor       executor distributing chunks of columns to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void transformBatch(const Eigen::Ref<const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>>& positions, Eigen::Ref<Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>> transformed,
+                      const Executor_& executor = Executor_()) const {
+    internal::ColumnTransformKernels<PrimType_>::transform(RotationMatrix<PrimType_>(getRotation()).toImplementation(), getPosition().toImplementation(),
+                                                           positions, transformed, executor);
+  }
+
+  /*! \brief Transforms the columns of a large 3xN matrix in reverse into a preallocated matrix, see transformBatch().
+   *  \param positions      3xN matrix of positions
+   *  \param transformed    3xN matrix of transformed positions
+   *  \param executor       executor distributing chunks of columns to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void inverseTransformBatch(const Eigen::Ref<const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>>& positions, Eigen::Ref<Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>> transformed,
+                             const Executor_& executor = Executor_()) const {
+    const Eigen::Matrix<PrimType_, 3, 3> rotationMatrix = RotationMatrix<PrimType_>(getRotation()).toImplementation().transpose();
+    internal::ColumnTransformKernels<PrimType_>::transform(rotationMatrix, (-rotationMatrix*getPosition().toImplementation()).eval(),
+                                                           positions, transformed, executor);
+  }
+
   /*! \brief Used for printing the object with std::cout.
    *  \returns std::stream object
    */
@@ -127,22 +173,6 @@ class HomogeneousTransformation : public PoseBase<HomogeneousTransformation<Prim
   }
 };
 
-template <typename PrimType_>
-using HomTransformQuat = HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationQuaternion<PrimType_>>;
-typedef HomTransformQuat<double> HomTransformQuatD;
-typedef HomTransformQuat<float> HomTransformQuatF;
-
-// For backwards comp.
-template <typename PrimType_>
-using HomogeneousTransformationPosition3RotationQuaternion = HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationQuaternion<PrimType_>>;
-typedef HomogeneousTransformationPosition3RotationQuaternion<double> HomogeneousTransformationPosition3RotationQuaternionD;
-typedef HomogeneousTransformationPosition3RotationQuaternion<float> HomogeneousTransformationPosition3RotationQuaternionF;
-
-template <typename PrimType_>
-using HomTransformMatrix = HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationMatrix<PrimType_>>;
-typedef HomTransformMatrix<double> HomTransformMatrixD;
-typedef HomTransformMatrix<float> HomTransformMatrixF;
-
 
 namespace internal {
 
@@ -153,11 +183,35 @@ class get_position<HomogeneousTransformation<PrimType_, Position_, Rotation_>> {
   typedef Position_ Position;
 };
 
+/*! \brief Computes C*r + t for all columns r of a 3xN matrix.
+ *  Each column is read completely before it is written, such that transformed may alias positions.
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline void transformColumns(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation,
+                             const Eigen::Ref<const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>>& positions,
+                             Eigen::Ref<Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>> transformed) {
+  KINDR_ASSERT_TRUE(std::runtime_error, positions.cols() == transformed.cols(), "The number of positions and transformed positions must be equal.");
+  const int size = static_cast<int>(positions.cols());
+  for (int i = 0; i < size; ++i) {
+    const PrimType_ x = positions(0, i);
+    const PrimType_ y = positions(1, i);
+    const PrimType_ z = positions(2, i);
+    transformed(0, i) = rotationMatrix(0, 0)*x + rotationMatrix(0, 1)*y + rotationMatrix(0, 2)*z + translation(0);
+    transformed(1, i) = rotationMatrix(1, 0)*x + rotationMatrix(1, 1)*y + rotationMatrix(1, 2)*z + translation(1);
+    transformed(2, i) = rotationMatrix(2, 0)*x + rotationMatrix(2, 1)*y + rotationMatrix(2, 2)*z + translation(2);
+  }
+}
+
 template<typename PrimType_, typename Position_, typename Rotation_>
 class TransformationTraits<HomogeneousTransformation<PrimType_, Position_, Rotation_>> {
  private:
   typedef HomogeneousTransformation<PrimType_, Position_, Rotation_> Pose;
   typedef typename get_position<Pose>::Position Translation;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> Matrix3X;
  public:
   inline static Translation transform(const Pose & pose, const Translation & position){
     return pose.getRotation().rotate(position) + pose.getPosition();
@@ -165,6 +219,22 @@ class TransformationTraits<HomogeneousTransformation<PrimType_, Position_, Rotat
   inline static Translation inverseTransform(const Pose & pose, const Translation & position){
     return pose.getRotation().inverseRotate((position-pose.getPosition()));
   }
+
+  /*! \brief Transforms a batch of positions.
+   *  The rotation is converted to a rotation matrix once for the whole batch.
+   */
+  inline static void transform(const Pose & pose, const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed) {
+    const Matrix3 rotationMatrix = RotationMatrix<PrimType_>(pose.getRotation()).toImplementation();
+    transformColumns<PrimType_>(rotationMatrix, pose.getPosition().toImplementation(), positions, transformed);
+  }
+
+  /*! \brief Transforms a batch of positions in reverse, i.e. computes C^T*(r-t) as C^T*r - C^T*t.
+   */
+  inline static void inverseTransform(const Pose & pose, const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed) {
+    const Matrix3 rotationMatrix = RotationMatrix<PrimType_>(pose.getRotation()).toImplementation().transpose();
+    const Vector3 translation = -rotationMatrix*pose.getPosition().toImplementation();
+    transformColumns<PrimType_>(rotationMatrix, translation, positions, transformed);
+  }
 };
 
 
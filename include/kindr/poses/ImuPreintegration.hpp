@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+
+/*! \file ImuPreintegration.hpp
+ *  \brief Preintegration of gyroscope and accelerometer samples between two keyframes.
+ *
+ *  The samples are measured in the body frame B_k and corrected with the biases of the linearization point. With
+ *  w_k = w_meas_k - b_g and a_k = a_meas_k - b_a the relative motion with respect to the body frame B_0 of the first
+ *  sample is accumulated as
+ *    dp <- dp + dv*dt + 0.5*dR*a_k*dt^2,    dv <- dv + dR*a_k*dt,    dR <- dR*exp(w_k*dt),
+ *  where dR rotates vectors from B_k to B_0 as RotationBase::rotate does. Gravity is not included. The first-order
+ *  Jacobians of dR, dv and dp with respect to the biases are accumulated in the same pass, such that a change of the
+ *  bias estimate can be applied without integrating the samples again, where dR is perturbed on the right:
+ *    dR(b_g + db_g) = dR*exp(dR/db_g*db_g).
+ */
+
+namespace kindr {
+
+/*! \class ImuPreintegrator
+ * \brief Accumulates the rotation, velocity and position increments of IMU samples and their bias Jacobians.
+ *
+ * The increments are kept as Eigen matrices and each sample costs one exponential map whose sine and cosine are
+ * shared with the right Jacobian. Rotation increments below about 0.01 rad, which are the usual case for IMU rates, are
+ * evaluated with Taylor series instead of trigonometric functions.
+ *
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \ingroup poses
+ */
+template<typename PrimType_>
+class ImuPreintegrator {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> Matrix3X;
+
+  /*! \brief Constructor.
+   *  \param gyroscopeBias       bias of the gyroscope at the linearization point
+   *  \param accelerometerBias   bias of the accelerometer at the linearization point
+   */
+  explicit ImuPreintegrator(const LocalAngularVelocity<PrimType_>& gyroscopeBias = LocalAngularVelocity<PrimType_>(),
+                            const Acceleration<PrimType_, 3>& accelerometerBias = Acceleration<PrimType_, 3>()) {
+    reset(gyroscopeBias, accelerometerBias);
+  }
+
+  /*! \brief Discards all samples and sets the biases of the linearization point.
+   *  \param gyroscopeBias       bias of the gyroscope
+   *  \param accelerometerBias   bias of the accelerometer
+   */
+  void reset(const LocalAngularVelocity<PrimType_>& gyroscopeBias, const Acceleration<PrimType_, 3>& accelerometerBias) {
+    gyroscopeBias_ = gyroscopeBias.toImplementation();
+    accelerometerBias_ = accelerometerBias.toImplementation();
+    deltaTime_ = PrimType_(0.0);
+    deltaRotation_.setIdentity();
+    deltaVelocity_.setZero();
+    deltaPosition_.setZero();
+    rotationJacobianGyroscopeBias_.setZero();
+    velocityJacobianGyroscopeBias_.setZero();
+    velocityJacobianAccelerometerBias_.setZero();
+    positionJacobianGyroscopeBias_.setZero();
+    positionJacobianAccelerometerBias_.setZero();
+  }
+
+  /*! \brief Integrates one sample.
+   *  \param angularVelocity   measured angular velocity of the gyroscope
+   *  \param acceleration      measured (specific) acceleration of the accelerometer
+   *  \param dt                duration of the sample
+   */
+  void integrate(const LocalAngularVelocity<PrimType_>& angularVelocity, const Acceleration<PrimType_, 3>& acceleration, PrimType_ dt) {
+    integrateSample(angularVelocity.toImplementation(), acceleration.toImplementation(), dt);
+  }
+
+  /*! \brief Integrates a batch of samples with the same duration.
+   *  \param angularVelocities   3xN matrix, each column is a measured angular velocity
+   *  \param accelerations       3xN matrix, each column is a measured acceleration
+   *  \param dt                  duration of each sample
+   */
+  void integrate(const Eigen::Ref<const Matrix3X>& angularVelocities, const Eigen::Ref<const Matrix3X>& accelerations, PrimType_ dt) {
+    KINDR_ASSERT_TRUE(std::runtime_error, angularVelocities.cols() == accelerations.cols(),
+                      "The number of angular velocities must be equal to the number of accelerations.");
+    for (int i = 0; i < angularVelocities.cols(); ++i) {
+      integrateSample(angularVelocities.col(i), accelerations.col(i), dt);
+    }
+  }
+
+  //! \returns the sum of the durations of the samples
+  inline PrimType_ getDeltaTime() const {
+    return deltaTime_;
+  }
+
+  //! \returns the rotation from the body frame of the last sample to the body frame of the first sample
+  RotationQuaternion<PrimType_> getDeltaRotation() const {
+    return RotationQuaternion<PrimType_>(Eigen::Quaternion<PrimType_>(deltaRotation_).normalized());
+  }
+
+  //! \returns the velocity increment expressed in the body frame of the first sample
+  Velocity<PrimType_, 3> getDeltaVelocity() const {
+    return Velocity<PrimType_, 3>(deltaVelocity_);
+  }
+
+  //! \returns the position increment expressed in the body frame of the first sample
+  Position<PrimType_, 3> getDeltaPosition() const {
+    return Position<PrimType_, 3>(deltaPosition_);
+  }
+
+  /*! \brief Gets the rotation increment corrected to first order for other biases.
+   *  \param gyroscopeBias   bias of the gyroscope
+   *  \returns rotation
+   */
+  RotationQuaternion<PrimType_> getDeltaRotation(const LocalAngularVelocity<PrimType_>& gyroscopeBias) const {
+    const Vector3 correction = rotationJacobianGyroscopeBias_*(gyroscopeBias.toImplementation() - gyroscopeBias_);
+    return getDeltaRotation()*RotationQuaternion<PrimType_>().exponentialMap(correction);
+  }
+
+  /*! \brief Gets the velocity increment corrected to first order for other biases.
+   *  \param gyroscopeBias       bias of the gyroscope
+   *  \param accelerometerBias   bias of the accelerometer
+   *  \returns velocity
+   */
+  Velocity<PrimType_, 3> getDeltaVelocity(const LocalAngularVelocity<PrimType_>& gyroscopeBias, const Acceleration<PrimType_, 3>& accelerometerBias) const {
+    return Velocity<PrimType_, 3>(Vector3(deltaVelocity_
+        + velocityJacobianGyroscopeBias_*(gyroscopeBias.toImplementation() - gyroscopeBias_)
+        + velocityJacobianAccelerometerBias_*(accelerometerBias.toImplementation() - accelerometerBias_)));
+  }
+
+  /*! \brief Gets the position increment corrected to first order for other biases.
+   *  \param gyroscopeBias       bias of the gyroscope
+   *  \param accelerometerBias   bias of the accelerometer
+   *  \returns position
+   */
+  Position<PrimType_, 3> getDeltaPosition(const LocalAngularVelocity<PrimType_>& gyroscopeBias, const Acceleration<PrimType_, 3>& accelerometerBias) const {
+    return Position<PrimType_, 3>(Vector3(deltaPosition_
+        + positionJacobianGyroscopeBias_*(gyroscopeBias.toImplementation() - gyroscopeBias_)
+        + positionJacobianAccelerometerBias_*(accelerometerBias.toImplementation() - accelerometerBias_)));
+  }
+
+  //! \returns the bias of the gyroscope at the linearization point
+  LocalAngularVelocity<PrimType_> getGyroscopeBias() const {
+    return LocalAngularVelocity<PrimType_>(gyroscopeBias_);
+  }
+
+  //! \returns the bias of the accelerometer at the linearization point
+  Acceleration<PrimType_, 3> getAccelerometerBias() const {
+    return Acceleration<PrimType_, 3>(accelerometerBias_);
+  }
+
+  //! \returns the rotation increment as matrix
+  inline const Matrix3& getDeltaRotationMatrix() const {
+    return deltaRotation_;
+  }
+
+  //! \returns the Jacobian of the rotation increment with respect to the gyroscope bias
+  inline const Matrix3& getRotationJacobianGyroscopeBias() const {
+    return rotationJacobianGyroscopeBias_;
+  }
+
+  //! \returns the Jacobian of the velocity increment with respect to the gyroscope bias
+  inline const Matrix3& getVelocityJacobianGyroscopeBias() const {
+    return velocityJacobianGyroscopeBias_;
+  }
+
+  //! \returns the Jacobian of the velocity increment with respect to the accelerometer bias
+  inline const Matrix3& getVelocityJacobianAccelerometerBias() const {
+    return velocityJacobianAccelerometerBias_;
+  }
+
+  //! \returns the Jacobian of the position increment with respect to the gyroscope bias
+  inline const Matrix3& getPositionJacobianGyroscopeBias() const {
+    return positionJacobianGyroscopeBias_;
+  }
+
+  //! \returns the Jacobian of the position increment with respect to the accelerometer bias
+  inline const Matrix3& getPositionJacobianAccelerometerBias() const {
+    return positionJacobianAccelerometerBias_;
+  }
+
+ protected:
+  template<typename AngularVelocity_, typename Acceleration_>
+  inline void integrateSample(const Eigen::MatrixBase<AngularVelocity_>& measuredAngularVelocity,
+                              const Eigen::MatrixBase<Acceleration_>& measuredAcceleration, PrimType_ dt) {
+    using std::sin;
+    using std::cos;
+    using std::sqrt;
+    const Vector3 rotationVector = (measuredAngularVelocity - gyroscopeBias_)*dt;
+    const Vector3 acceleration = measuredAcceleration - accelerometerBias_;
+
+    // exp(v) = I + a*[v]x + b*[v]x^2 and Jr(v) = I - b*[v]x + c*[v]x^2 with the angle t = |v| and
+    // a = sin(t)/t, b = (1-cos(t))/t^2, c = (t-sin(t))/t^3.
+    // Below the threshold the neglected t^6 terms of the Taylor series are below the machine precision.
+    static const PrimType_ smallAngleSquared = std::cbrt(PrimType_(5040.0)*std::numeric_limits<PrimType_>::epsilon());
+    const PrimType_ angleSquared = rotationVector.squaredNorm();
+    PrimType_ a, b, c;
+    if (angleSquared < smallAngleSquared) {
+      const PrimType_ angleToTheFourth = angleSquared*angleSquared;
+      a = PrimType_(1.0) - angleSquared*PrimType_(1.0/6.0) + angleToTheFourth*PrimType_(1.0/120.0);
+      b = PrimType_(0.5) - angleSquared*PrimType_(1.0/24.0) + angleToTheFourth*PrimType_(1.0/720.0);
+      c = PrimType_(1.0/6.0) - angleSquared*PrimType_(1.0/120.0) + angleToTheFourth*PrimType_(1.0/5040.0);
+    }
+    else {
+      const PrimType_ angle = sqrt(angleSquared);
+      const PrimType_ sinAngle = sin(angle);
+      a = sinAngle/angle;
+      b = (PrimType_(1.0) - cos(angle))/angleSquared;
+      c = (angle - sinAngle)/(angleSquared*angle);
+    }
+    const Matrix3 skew = getSkewMatrixFromVector(rotationVector);
+    const Matrix3 skewSquared = rotationVector*rotationVector.transpose() - angleSquared*Matrix3::Identity();
+    const Matrix3 incrementRotation = Matrix3::Identity() + a*skew + b*skewSquared;
+    const Matrix3 incrementRightJacobian = Matrix3::Identity() - b*skew + c*skewSquared;
+
+    // The increments of velocity and position use the rotation before the sample
+    const Vector3 rotatedAcceleration = deltaRotation_*acceleration;
+    const Matrix3 rotatedAccelerationSkewJacobian = deltaRotation_*getSkewMatrixFromVector(acceleration)*rotationJacobianGyroscopeBias_;
+    const PrimType_ halfDtSquared = PrimType_(0.5)*dt*dt;
+
+    deltaPosition_ += deltaVelocity_*dt + halfDtSquared*rotatedAcceleration;
+    positionJacobianAccelerometerBias_ += velocityJacobianAccelerometerBias_*dt - halfDtSquared*deltaRotation_;
+    positionJacobianGyroscopeBias_ += velocityJacobianGyroscopeBias_*dt - halfDtSquared*rotatedAccelerationSkewJacobian;
+
+    deltaVelocity_ += rotatedAcceleration*dt;
+    velocityJacobianAccelerometerBias_ -= deltaRotation_*dt;
+    velocityJacobianGyroscopeBias_ -= rotatedAccelerationSkewJacobian*dt;
+
+    rotationJacobianGyroscopeBias_ = incrementRotation.transpose()*rotationJacobianGyroscopeBias_ - incrementRightJacobian*dt;
+    deltaRotation_ = deltaRotation_*incrementRotation;
+    deltaTime_ += dt;
+  }
+
+  Vector3 gyroscopeBias_;
+  Vector3 accelerometerBias_;
+  PrimType_ deltaTime_;
+  Matrix3 deltaRotation_;
+  Vector3 deltaVelocity_;
+  Vector3 deltaPosition_;
+  Matrix3 rotationJacobianGyroscopeBias_;
+  Matrix3 velocityJacobianGyroscopeBias_;
+  Matrix3 velocityJacobianAccelerometerBias_;
+  Matrix3 positionJacobianGyroscopeBias_;
+  Matrix3 positionJacobianAccelerometerBias_;
+};
+
+//! \brief IMU preintegrator with primitive type double
+typedef ImuPreintegrator<double> ImuPreintegratorD;
+//! \brief IMU preintegrator with primitive type float
+typedef ImuPreintegrator<float> ImuPreintegratorF;
+
+} // namespace kindr
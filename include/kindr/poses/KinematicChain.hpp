@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+#include <array>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+
+namespace kindr {
+
+
+/*! \class KinematicChain
+ * \brief Serial kinematic chain with a fixed number of one degree-of-freedom joints.
+ *
+ *  The transformation from the frame of joint i to the frame of joint i-1 is T_{i-1,i}(q_i) = T_i * J_i(q_i), where
+ *  T_i is a fixed link transformation and J_i(q_i) is a rotation about or a translation along the joint axis.
+ *  The link data and the prefix transformations T_{0,i} are stored in fixed-size arrays, such that the evaluation
+ *  does not allocate memory. The rotation of each link is precomputed in the form C_i, C_i*[n]x and C_i*[n]x^2,
+ *  which turns the joint rotation into a linear combination and leaves one matrix product per joint.
+ *  Changing a single joint position only reevaluates the transformations after this joint.
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \tparam NumJoints_ the number of joints
+ * \ingroup poses
+ */
+template<typename PrimType_, int NumJoints_>
+class KinematicChain {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, NumJoints_, 1> JointPositions;
+  typedef HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationMatrix<PrimType_>> Pose;
+
+  //! Type of a joint
+  enum class JointType {
+    Revolute,
+    Prismatic
+  };
+
+  //! Number of joints
+  enum { NumJoints = NumJoints_ };
+
+  /*! \brief Default constructor.
+   *
+   *  Creates a chain of revolute joints about the z-axis with identity link transformations and zero joint positions.
+   */
+  KinematicChain() {
+    for (int i = 0; i < NumJoints_; ++i) {
+      setLink(i, Pose(), Vector3::UnitZ(), JointType::Revolute);
+    }
+    jointPositions_.setZero();
+    updateFrom(0);
+  }
+
+  /*! \brief Sets the fixed transformation and the joint axis of a link.
+   *  The transformations are not reevaluated until the joint positions are set.
+   *  \param index            index of the joint
+   *  \param linkTransform    fixed transformation T_i from the frame before joint i to the frame after joint i-1
+   *  \param axis             joint axis expressed in the joint frame (normalized internally)
+   *  \param type             type of the joint
+   */
+  template<typename OtherDerived_>
+  void setLink(int index, const PoseBase<OtherDerived_>& linkTransform, const Vector3& axis, JointType type = JointType::Revolute) {
+    KINDR_ASSERT_TRUE(std::runtime_error, index >= 0 && index < NumJoints_, "The joint index is out of range.");
+    KINDR_ASSERT_TRUE(std::runtime_error, axis.norm() > internal::NumTraits<Scalar>::dummy_precision(), "The joint axis must not be zero.");
+    const Matrix3 linkRotationMatrix = RotationMatrix<PrimType_>(linkTransform.derived().getRotation()).toImplementation();
+    const Vector3 unitAxis = axis.normalized();
+    const Matrix3 skewAxis = getSkewMatrixFromVector(unitAxis);
+    linkRotationMatrices_[index] = linkRotationMatrix;
+    linkRotationMatricesSkew_[index] = linkRotationMatrix*skewAxis;
+    linkRotationMatricesSkewSquared_[index] = linkRotationMatricesSkew_[index]*skewAxis;
+    linkTranslations_[index] = linkTransform.derived().getPosition().toImplementation();
+    linkAxes_[index] = linkRotationMatrix*unitAxis;
+    jointTypes_[index] = type;
+  }
+
+  /*! \brief Sets all joint positions and evaluates all prefix transformations in one pass.
+   *  \param jointPositions   joint angles [rad] or displacements [m]
+   */
+  void setJointPositions(const JointPositions& jointPositions) {
+    jointPositions_ = jointPositions;
+    updateFrom(0);
+  }
+
+  /*! \brief Sets a single joint position and reevaluates only the transformations after this joint.
+   *  \param index            index of the joint
+   *  \param jointPosition    joint angle [rad] or displacement [m]
+   */
+  void setJointPosition(int index, Scalar jointPosition) {
+    KINDR_ASSERT_TRUE(std::runtime_error, index >= 0 && index < NumJoints_, "The joint index is out of range.");
+    jointPositions_(index) = jointPosition;
+    updateFrom(index);
+  }
+
+  /*! \brief Reevaluates all prefix transformations, e.g. after changing link transformations.
+   */
+  void update() {
+    updateFrom(0);
+  }
+
+  inline const JointPositions& getJointPositions() const {
+    return jointPositions_;
+  }
+
+  inline JointType getJointType(int index) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, index >= 0 && index < NumJoints_, "The joint index is out of range.");
+    return jointTypes_[index];
+  }
+
+  /*! \brief Gets the rotation matrix of the prefix transformation T_{0,i+1}, i.e. of the frame after joint i.
+   *  \returns reference to the rotation matrix
+   */
+  inline const Matrix3& getRotationMatrix(int index) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, index >= 0 && index < NumJoints_, "The joint index is out of range.");
+    return rotationMatrices_[index];
+  }
+
+  /*! \brief Gets the translation of the prefix transformation T_{0,i+1}, i.e. of the frame after joint i.
+   *  \returns reference to the translation
+   */
+  inline const Vector3& getTranslation(int index) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, index >= 0 && index < NumJoints_, "The joint index is out of range.");
+    return translations_[index];
+  }
+
+  /*! \brief Gets the prefix transformation T_{0,i+1}, i.e. from the frame after joint i to the base frame.
+   *  \returns the transformation
+   */
+  inline Pose getTransform(int index) const {
+    return Pose(typename Pose::Position(getTranslation(index)), typename Pose::Rotation(getRotationMatrix(index)));
+  }
+
+  /*! \brief Gets the transformation from the last frame to the base frame.
+   *  \returns the transformation
+   */
+  inline Pose getEndEffectorTransform() const {
+    return getTransform(NumJoints_-1);
+  }
+
+ protected:
+  inline void updateFrom(int index) {
+    for (int i = index; i < NumJoints_; ++i) {
+      // Rotation and translation of the link in the parent frame including the joint motion
+      Matrix3 localRotationMatrix;
+      Vector3 localTranslation;
+      if (jointTypes_[i] == JointType::Revolute) {
+        using std::sin;
+        using std::cos;
+        const Scalar sinAngle = sin(jointPositions_(i));
+        const Scalar cosAngle = cos(jointPositions_(i));
+        localRotationMatrix = linkRotationMatrices_[i] + sinAngle*linkRotationMatricesSkew_[i] + (Scalar(1)-cosAngle)*linkRotationMatricesSkewSquared_[i];
+        localTranslation = linkTranslations_[i];
+      } else {
+        localRotationMatrix = linkRotationMatrices_[i];
+        localTranslation = linkTranslations_[i] + jointPositions_(i)*linkAxes_[i];
+      }
+
+      if (i == 0) {
+        rotationMatrices_[i] = localRotationMatrix;
+        translations_[i] = localTranslation;
+      } else {
+        rotationMatrices_[i].noalias() = rotationMatrices_[i-1]*localRotationMatrix;
+        translations_[i].noalias() = rotationMatrices_[i-1]*localTranslation;
+        translations_[i] += translations_[i-1];
+      }
+    }
+  }
+
+  std::array<Matrix3, NumJoints_> linkRotationMatrices_;
+  std::array<Matrix3, NumJoints_> linkRotationMatricesSkew_;
+  std::array<Matrix3, NumJoints_> linkRotationMatricesSkewSquared_;
+  std::array<Vector3, NumJoints_> linkTranslations_;
+  std::array<Vector3, NumJoints_> linkAxes_;
+  std::array<JointType, NumJoints_> jointTypes_;
+  JointPositions jointPositions_;
+  std::array<Matrix3, NumJoints_> rotationMatrices_;
+  std::array<Vector3, NumJoints_> translations_;
+};
+
+
+} // namespace kindr
@@ -29,6 +29,10 @@
 #pragma once
 
 #include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/CachedHomogeneousTransformation.hpp"
+#include "kindr/poses/KinematicChain.hpp"
+#include "kindr/poses/FrameTree.hpp"
+#include "kindr/poses/PoseComposition.hpp"
 
 namespace kindr {
 
@@ -46,13 +50,12 @@ class MultiplicationTraits<PoseBase<Left_>, PoseBase<Right_> > {
   typedef typename Left_::Position Position;
   typedef typename Left_::Rotation Rotation;
   typedef typename Left_::Scalar Scalar;
-  typedef HomogeneousTransformation<Scalar, Position, Rotation> HomTrans;
  public:
   //! Default multiplication of rotations converts the representations of the rotations to rotation quaternions and multiplies them
   inline static Left_ mult(const PoseBase<Left_>& lhs, const PoseBase<Right_>& rhs) {
     const Position position = lhs.derived().getPosition()+lhs.derived().getRotation().rotate(rhs.derived().getPosition());
     const Rotation rotation = lhs.derived().getRotation()*rhs.derived().getRotation();
-    return Left_(HomTrans(position, rotation));
+    return Left_(position, rotation);
   }
 };
 
@@ -96,5 +99,157 @@ class ComparisonTraits<PoseBase<Left_>, PoseBase<Right_>>{
 };
 
 
+/*! \brief Coefficients of the exponential and logarithmic maps of SE(3) for the rotation vector w with angle a = |w|.
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class SE3MapCoefficients {
+ public:
+  //! cos(a/2), the real part of the unit quaternion of exp(w)
+  PrimType_ cosHalfAngle_;
+  //! sin(a/2)/a, the factor of w in the imaginary part of the unit quaternion of exp(w)
+  PrimType_ sinHalfAngleOverAngle_;
+  //! sin(a)/a, the coefficient of [w]x in exp(w)
+  PrimType_ sinc_;
+  //! (1-cos(a))/a^2, the coefficient of [w]x^2 in exp(w) and of [w]x in J(w)
+  PrimType_ cosc_;
+  //! (a-sin(a))/a^3, the coefficient of [w]x^2 in J(w)
+  PrimType_ sinc3_;
+
+  //! The series for small angles use the squared norm of w, whose derivative is also defined at zero
+  template<typename Vector3_>
+  explicit SE3MapCoefficients(const Vector3_& w) {
+    using std::sin;
+    using std::cos;
+    const PrimType_ angle = w.norm();
+    if (isLessThenEpsilons4thRoot(angle)) {
+      const PrimType_ angleSquared = w.squaredNorm();
+      cosHalfAngle_ = PrimType_(1) - angleSquared/PrimType_(8);
+      sinHalfAngleOverAngle_ = PrimType_(0.5) - angleSquared/PrimType_(48);
+      sinc_ = PrimType_(1) - angleSquared/PrimType_(6);
+      cosc_ = PrimType_(0.5) - angleSquared/PrimType_(24);
+      sinc3_ = PrimType_(1.0/6.0) - angleSquared/PrimType_(120);
+    } else {
+      // All coefficients follow from the half angle, 1-cos(a) = 2*sin^2(a/2) avoids the cancellation for small angles
+      const PrimType_ inverseAngle = PrimType_(1)/angle;
+      cosHalfAngle_ = cos(PrimType_(0.5)*angle);
+      sinHalfAngleOverAngle_ = sin(PrimType_(0.5)*angle)*inverseAngle;
+      sinc_ = PrimType_(2)*sinHalfAngleOverAngle_*cosHalfAngle_;
+      cosc_ = PrimType_(2)*sinHalfAngleOverAngle_*sinHalfAngleOverAngle_;
+      sinc3_ = (PrimType_(1) - sinc_)*inverseAngle*inverseAngle;
+    }
+  }
+
+  //! Gets the unit quaternion of exp(w)
+  template<typename Vector3_>
+  inline RotationQuaternion<PrimType_> getRotation(const Vector3_& w) const {
+    return RotationQuaternion<PrimType_>(cosHalfAngle_, sinHalfAngleOverAngle_*w.x(), sinHalfAngleOverAngle_*w.y(), sinHalfAngleOverAngle_*w.z());
+  }
+
+  //! Computes J(w)*v = v + (1-cos(a))/a^2 * w x v + (a-sin(a))/a^3 * w x (w x v)
+  template<typename Vector3_>
+  inline Vector3_ getJacobianTimes(const Vector3_& w, const Vector3_& v) const {
+    const Vector3_ wCrossV = w.cross(v);
+    return v + cosc_*wCrossV + sinc3_*w.cross(wCrossV);
+  }
+
+  //! Computes exp(w)*v = v + sin(a)/a * w x v + (1-cos(a))/a^2 * w x (w x v)
+  template<typename Vector3_>
+  inline Vector3_ getRotationTimes(const Vector3_& w, const Vector3_& v) const {
+    const Vector3_ wCrossV = w.cross(v);
+    return v + sinc_*wCrossV + cosc_*w.cross(wCrossV);
+  }
+
+  /*! \brief Computes J(w)^-1*v = v - 1/2 * w x v + (1 - a/2*cot(a/2))/a^2 * w x (w x v) for a in [0, pi].
+   */
+  template<typename Vector3_>
+  inline static Vector3_ getInverseJacobianTimes(const Vector3_& w, const Vector3_& v) {
+    using std::tan;
+    const PrimType_ angle = w.norm();
+    PrimType_ factor;
+    if (isLessThenEpsilons4thRoot(angle)) {
+      factor = PrimType_(1.0/12.0) + w.squaredNorm()/PrimType_(720);
+    } else {
+      const PrimType_ halfAngle = PrimType_(0.5)*angle;
+      factor = (PrimType_(1) - halfAngle/tan(halfAngle))/(angle*angle);
+    }
+    const Vector3_ wCrossV = w.cross(v);
+    return v - PrimType_(0.5)*wCrossV + factor*w.cross(wCrossV);
+  }
+};
+
+/*! \brief Exponential and logarithmic maps of SE(3) of poses consisting of a position and a rotation.
+ */
+template<typename Pose_>
+class MapTraits<PoseBase<Pose_>> {
+ public:
+  typedef typename Pose_::Scalar Scalar;
+  typedef typename Pose_::Position Position;
+  typedef typename Pose_::Rotation Rotation;
+  typedef Eigen::Matrix<Scalar, 6, 1> Vector6;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  inline static Pose_ set_exponential_map(const Vector6& vector) {
+    const Vector3 translationalPart = vector.template head<3>();
+    const Vector3 rotationalPart = vector.template tail<3>();
+    const SE3MapCoefficients<Scalar> coefficients(rotationalPart);
+    return Pose_(Position(coefficients.getJacobianTimes(rotationalPart, translationalPart)), Rotation(coefficients.getRotation(rotationalPart)));
+  }
+
+  inline static Vector6 get_logarithmic_map(const Pose_& pose) {
+    const Vector3 rotationalPart = pose.getRotation().logarithmicMap();
+    Vector6 vector;
+    vector.template head<3>() = SE3MapCoefficients<Scalar>::getInverseJacobianTimes(rotationalPart, Vector3(pose.getPosition().toImplementation()));
+    vector.template tail<3>() = rotationalPart;
+    return vector;
+  }
+};
+
+/*! \brief Box operations of SE(3) with the perturbation applied from the left, i.e. T.boxPlus(v) = exp(v)*T.
+ */
+template<typename Left_, typename Right_>
+class BoxOperationTraits<PoseBase<Left_>, PoseBase<Right_>> {
+ public:
+  typedef typename Left_::Scalar Scalar;
+  typedef typename Left_::Position Position;
+  typedef typename Left_::Rotation Rotation;
+  typedef Eigen::Matrix<Scalar, 6, 1> Vector6;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  //! log(T1*T2^-1) = log((C1*C2^-1, t1 - C1*C2^-1*t2))
+  inline static Vector6 box_minus(const PoseBase<Left_>& lhs, const PoseBase<Right_>& rhs) {
+    const Rotation rotation = lhs.derived().getRotation()*Rotation(rhs.derived().getRotation()).inverted();
+    const Vector3 rotationalPart = rotation.logarithmicMap();
+    const Vector3 translation = lhs.derived().getPosition().toImplementation() - rotation.rotate(Vector3(rhs.derived().getPosition().toImplementation()));
+    Vector6 vector;
+    vector.template head<3>() = SE3MapCoefficients<Scalar>::getInverseJacobianTimes(rotationalPart, translation);
+    vector.template tail<3>() = rotationalPart;
+    return vector;
+  }
+
+  //! exp(v)*T = (exp(w)*C, exp(w)*t + J(w)*v), where exp(w)*t is evaluated directly
+  inline static Left_ box_plus(const PoseBase<Left_>& pose, const Vector6& vector) {
+    const Vector3 translationalPart = vector.template head<3>();
+    const Vector3 rotationalPart = vector.template tail<3>();
+    const SE3MapCoefficients<Scalar> coefficients(rotationalPart);
+    const Vector3 position = coefficients.getRotationTimes(rotationalPart, Vector3(pose.derived().getPosition().toImplementation()))
+        + coefficients.getJacobianTimes(rotationalPart, translationalPart);
+    return Left_(Position(position), Rotation(coefficients.getRotation(rotationalPart))*pose.derived().getRotation());
+  }
+
+  //! T*exp(v) = (C*exp(w), t + C*J(w)*v)
+  inline static Left_ box_plus_local(const PoseBase<Left_>& pose, const Vector6& vector) {
+    const Vector3 translationalPart = vector.template head<3>();
+    const Vector3 rotationalPart = vector.template tail<3>();
+    const SE3MapCoefficients<Scalar> coefficients(rotationalPart);
+    const Rotation& rotation = pose.derived().getRotation();
+    const Vector3 position = pose.derived().getPosition().toImplementation()
+        + rotation.rotate(coefficients.getJacobianTimes(rotationalPart, translationalPart));
+    return Left_(Position(position), rotation*Rotation(coefficients.getRotation(rotationalPart)));
+  }
+};
+
+
 } // namespace internal
 } // namespace kindr
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/poses/Pose.hpp"
+#include "kindr/rotations/RotationQuaternionArray.hpp"
+#include "kindr/vectors/VectorArray.hpp"
+
+namespace kindr {
+
+/*! \class PoseArray
+ *  \brief Batch of poses stored in structure-of-arrays layout.
+ *
+ *  The positions are stored in a PositionArray and the rotations in a RotationQuaternionArray, such that the batch
+ *  operations use the vectorized kernels of these arrays. The i-th pose is HomTransformQuat(positions[i], rotations[i]).
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class PoseArray {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomTransformQuat<PrimType_> Element;
+  typedef PositionArray<PrimType_> Positions;
+  typedef RotationQuaternionArray<PrimType_> Rotations;
+
+  /*! \brief Default constructor creating an empty batch.
+   */
+  PoseArray() = default;
+
+  /*! \brief Constructor creating a batch of identity poses.
+   *  \param size   number of poses
+   */
+  explicit PoseArray(int size)
+    : positions_(size),
+      rotations_(size) {
+  }
+
+  /*! \brief Constructor using the positions and the rotations.
+   *  \param positions   positions
+   *  \param rotations   rotations, the batch has the same size
+   */
+  PoseArray(const Positions& positions, const Rotations& rotations)
+    : positions_(positions),
+      rotations_(rotations) {
+    KINDR_ASSERT_TRUE(std::runtime_error, positions.size() == rotations.size(), "The positions and the rotations have different sizes.");
+  }
+
+  /*! \brief Constructor using a std::vector of poses.
+   *  \param poses   poses
+   */
+  explicit PoseArray(const std::vector<Element>& poses)
+    : positions_(static_cast<int>(poses.size())),
+      rotations_(static_cast<int>(poses.size())) {
+    for (int i = 0; i < size(); ++i) {
+      set(i, poses[i]);
+    }
+  }
+
+  /*! \brief Gets the number of poses.
+   *  \returns number of poses
+   */
+  inline int size() const {
+    return positions_.size();
+  }
+
+  /*! \brief Resizes the batch. The content is undefined afterwards.
+   *  \param size   number of poses
+   */
+  inline void resize(int size) {
+    positions_.resize(size);
+    rotations_.resize(size);
+  }
+
+  /*! \brief Gets the i-th pose.
+   *  \returns pose
+   */
+  inline Element operator [](int i) const {
+    return Element(positions_[i], rotations_[i]);
+  }
+
+  /*! \brief Sets the i-th pose.
+   *  \param i      index
+   *  \param pose   pose
+   */
+  inline void set(int i, const Element& pose) {
+    positions_.set(i, pose.getPosition());
+    rotations_.set(i, pose.getRotation());
+  }
+
+  inline const Positions& getPositions() const {
+    return positions_;
+  }
+
+  inline Positions& getPositions() {
+    return positions_;
+  }
+
+  inline const Rotations& getRotations() const {
+    return rotations_;
+  }
+
+  inline Rotations& getRotations() {
+    return rotations_;
+  }
+
+  /*! \brief Inverts all poses.
+   *  \param executor   executor distributing chunks of poses to threads, see SerialExecutor
+   *  \returns reference
+   */
+  template<typename Executor_ = SerialExecutor>
+  PoseArray& invert(const Executor_& executor = Executor_()) {
+    rotations_.inverseRotate(positions_, positions_, executor);
+    positions_.toImplementation() *= Scalar(-1);
+    rotations_.invert();
+    return *this;
+  }
+
+  /*! \brief Composes the poses pairwise without allocating memory if the result has the correct size.
+   *  The result may be the other batch, but not this batch.
+   *  \param other      batch of the same size
+   *  \param result     the composition this[i]*other[i] of the poses
+   *  \param executor   executor distributing chunks of poses to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void multiply(const PoseArray& other, PoseArray& result, const Executor_& executor = Executor_()) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, size() == other.size(), "The batches have different sizes.");
+    KINDR_ASSERT_TRUE(std::runtime_error, &result != this, "The result must not be the left operand.");
+    // r = r1 + C1*r2, C = C1*C2
+    rotations_.rotate(other.positions_, result.positions_, executor);
+    result.positions_.toImplementation() += positions_.toImplementation();
+    rotations_.multiply(other.rotations_, result.rotations_, executor);
+  }
+
+  /*! \brief Composes the poses pairwise.
+   *  \param other   batch of the same size
+   *  \returns the composition this[i]*other[i] of the poses
+   */
+  PoseArray operator *(const PoseArray& other) const {
+    PoseArray result;
+    multiply(other, result);
+    return result;
+  }
+
+  /*! \brief Gathers a subset of the poses.
+   *  \param indices   indices of the poses
+   *  \param result    the poses this[indices[k]]
+   */
+  void gather(const Eigen::Ref<const Eigen::VectorXi>& indices, PoseArray& result) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, &result != this, "The result must not be this batch.");
+    const int count = static_cast<int>(indices.size());
+    result.resize(count);
+    for (int k = 0; k < count; ++k) {
+      KINDR_ASSERT_TRUE_DBG(std::runtime_error, indices(k) >= 0 && indices(k) < size(), "The index " << indices(k) << " is out of range.");
+    }
+    // row by row, such that the result is written contiguously
+    for (int row = 0; row < 3; ++row) {
+      gatherRow(positions_.toImplementation().row(row).data(), indices, result.positions_.toImplementation().row(row).data());
+    }
+    for (int row = 0; row < 4; ++row) {
+      gatherRow(rotations_.toImplementation().row(row).data(), indices, result.rotations_.toImplementation().row(row).data());
+    }
+  }
+
+  /*! \brief Gets the relative poses between pairs of poses, e.g. the motions of a trajectory over a window.
+   *  \param first      indices of the first poses T_W_A
+   *  \param second     indices of the second poses T_W_B, with the same size
+   *  \param result     the relative poses T_A_B = this[first[k]]^-1*this[second[k]]
+   *  \param executor   executor distributing chunks of poses to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void getRelativePoses(const Eigen::Ref<const Eigen::VectorXi>& first, const Eigen::Ref<const Eigen::VectorXi>& second,
+                        PoseArray& result, const Executor_& executor = Executor_()) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, first.size() == second.size(), "The index vectors have different sizes.");
+    PoseArray inverses;
+    gather(first, inverses);
+    inverses.invert(executor);
+    gather(second, result);
+    inverses.multiply(result, result, executor);
+  }
+
+ private:
+  static void gatherRow(const Scalar* input, const Eigen::Ref<const Eigen::VectorXi>& indices, Scalar* output) {
+    for (int k = 0; k < indices.size(); ++k) {
+      output[k] = input[indices(k)];
+    }
+  }
+
+  Positions positions_;
+  Rotations rotations_;
+};
+
+typedef PoseArray<double> PoseArrayD;
+typedef PoseArray<float> PoseArrayF;
+
+} // namespace kindr
@@ -30,9 +30,17 @@
 
 
 #include "kindr/common/common.hpp"
+#include "kindr/rotations/RotationBase.hpp"
 
 
 namespace kindr {
+
+template<typename PrimType_>
+class TwistLinearVelocityLocalAngularVelocity;
+
+template<typename... Poses_>
+class PoseComposition;
+
 //! Generic pose interface
 /*! \ingroup poses
  */
@@ -49,6 +57,8 @@ class TransformationTraits {
  public:
 //  inline static Position transform(const Pose& pose, const Position& position);
 //  inline static Position inverseTransform(const Pose& pose, const Position& position);
+//  inline static void transform(const Pose& pose, const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed);
+//  inline static void inverseTransform(const Pose& pose, const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed);
 };
 
 /*! \class get_position
@@ -78,6 +88,11 @@ class get_position {
 template<typename Derived_>
 class PoseBase {
  public:
+  //! Matrix of positions stored column-wise
+  typedef Eigen::Matrix<typename internal::get_position<Derived_>::Position::Scalar, 3, Eigen::Dynamic> Matrix3X;
+  //! Vector [v; w] of the Lie algebra se(3) with translational part v and rotational part w
+  typedef Eigen::Matrix<typename internal::get_position<Derived_>::Position::Scalar, 6, 1> Vector6;
+
   /*! \brief Default constructor.
    *
    *  Creates a pose with all position coordinates set to zero and an identity orientation.
@@ -107,6 +122,15 @@ class PoseBase {
     return static_cast<const Derived_&>(*this);
   }
 
+  /*! \brief Gets the derived pose.
+   *
+   *  (only for advanced users)
+   *  \returns the derived pose
+   */
+  Derived_& derived() {
+    return static_cast<Derived_&>(*this);
+  }
+
   /*! \brief Gets the derived pose.
    *
    *  (only for advanced users)
@@ -131,6 +155,58 @@ class PoseBase {
     return internal::TransformationTraits<Derived_>::inverseTransform(this->derived(), position);
   }
 
+  /*! \brief Transforms a batch of positions stored column-wise.
+   *  \param positions   3xN matrix of positions
+   *  \returns the 3xN matrix of transformed positions
+   */
+  Matrix3X transform(const Eigen::Ref<const Matrix3X>& positions) const {
+    Matrix3X transformed(3, positions.cols());
+    internal::TransformationTraits<Derived_>::transform(this->derived(), positions, transformed);
+    return transformed;
+  }
+
+  /*! \brief Transforms a batch of positions stored column-wise into a preallocated matrix.
+   *  The output may be the input itself or a column block of a larger matrix, which allows to split a large batch
+   *  into chunks that are transformed independently, e.g. by several threads.
+   *  \param positions     3xN matrix of positions
+   *  \param transformed   3xN matrix of transformed positions
+   */
+  void transform(const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed) const {
+    internal::TransformationTraits<Derived_>::transform(this->derived(), positions, transformed);
+  }
+
+  /*! \brief Transforms a batch of positions stored column-wise in reverse.
+   *  \param positions   3xN matrix of positions
+   *  \returns the 3xN matrix of transformed positions
+   */
+  Matrix3X inverseTransform(const Eigen::Ref<const Matrix3X>& positions) const {
+    Matrix3X transformed(3, positions.cols());
+    internal::TransformationTraits<Derived_>::inverseTransform(this->derived(), positions, transformed);
+    return transformed;
+  }
+
+  /*! \brief Transforms a batch of positions stored column-wise in reverse into a preallocated matrix.
+   *  \param positions     3xN matrix of positions
+   *  \param transformed   3xN matrix of transformed positions
+   */
+  void inverseTransform(const Eigen::Ref<const Matrix3X>& positions, Eigen::Ref<Matrix3X> transformed) const {
+    internal::TransformationTraits<Derived_>::inverseTransform(this->derived(), positions, transformed);
+  }
+
+  /*! \brief Transforms a batch of positions stored column-wise in place.
+   *  \param positions   3xN matrix of positions, overwritten by the transformed positions
+   */
+  void transformInPlace(Eigen::Ref<Matrix3X> positions) const {
+    internal::TransformationTraits<Derived_>::transform(this->derived(), positions, positions);
+  }
+
+  /*! \brief Transforms a batch of positions stored column-wise in reverse in place.
+   *  \param positions   3xN matrix of positions, overwritten by the transformed positions
+   */
+  void inverseTransformInPlace(Eigen::Ref<Matrix3X> positions) const {
+    internal::TransformationTraits<Derived_>::inverseTransform(this->derived(), positions, positions);
+  }
+
   /*! \brief Concatenates two transformations.
    *  \returns the concatenation of two transformations
    */
@@ -139,6 +215,94 @@ class PoseBase {
     return internal::MultiplicationTraits<PoseBase<Derived_>,PoseBase<OtherDerived_>>::mult(this->derived(), other.derived()); // todo: 1. ok? 2. may be optimized
   }
 
+  /*! \brief Starts a lazy concatenation with this transformation as first factor, e.g. T_AB.lazy()*T_BC*T_CD,
+   *  which is only computed when it is assigned to a pose, see PoseComposition.
+   *  \returns composition
+   */
+  PoseComposition<Derived_> lazy() const {
+    return PoseComposition<Derived_>(this->derived());
+  }
+
+  /*! \brief Concatenates this transformation with another one from the right, i.e. T = T*T2.
+   *  The concatenation is computed as by operator*() and assigned to this transformation.
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  Derived_& operator *=(const PoseBase<OtherDerived_>& other) {
+    this->derived() = internal::MultiplicationTraits<PoseBase<Derived_>,PoseBase<OtherDerived_>>::mult(this->derived(), other.derived());
+    return this->derived();
+  }
+
+  /*! \brief Gets the inverse transformation T^-1 = (C^T, -C^T*t).
+   *  \returns the inverse transformation
+   */
+  Derived_ inverted() const {
+    typedef typename Derived_::Position Position;
+    const typename Derived_::Rotation rotation = this->derived().getRotation().inverted();
+    return Derived_(Position(-rotation.rotate(this->derived().getPosition())), rotation);
+  }
+
+  /*! \brief Inverts the transformation.
+   *  \returns reference
+   */
+  Derived_& invert() {
+    this->derived() = inverted();
+    return this->derived();
+  }
+
+  /*! \brief Gets the pose from the exponential map of SE(3).
+   *  The rotational part w is mapped by the exponential map of SO(3) and the translational part v by the left
+   *  Jacobian J(w) of SO(3), i.e. exp([v; w]) = (exp(w), J(w)*v).
+   *  \param vector  [v; w]
+   *  \returns the pose
+   */
+  Derived_ exponentialMap(const Vector6& vector) const {
+    return internal::MapTraits<PoseBase<Derived_>>::set_exponential_map(vector);
+  }
+
+  /*! \brief Gets the logarithmic map of SE(3), i.e. the inverse of exponentialMap().
+   *  \returns vector [v; w]
+   */
+  Vector6 logarithmicMap() const {
+    return internal::MapTraits<PoseBase<Derived_>>::get_logarithmic_map(this->derived());
+  }
+
+  /*! \brief Applies the box minus operation log(T*T2^-1), which corresponds to the convention of boxPlus().
+   *  \returns vector [v; w]
+   */
+  template<typename OtherDerived_>
+  Vector6 boxMinus(const PoseBase<OtherDerived_>& other) const {
+    return internal::BoxOperationTraits<PoseBase<Derived_>, PoseBase<OtherDerived_>>::box_minus(this->derived(), other.derived());
+  }
+
+  /*! \brief Applies the box plus operation exp([v; w])*T.
+   *  As for rotations, the perturbation is applied from the left, i.e. [v; w] is a twist multiplied by the time step
+   *  which is expressed in the frame the pose maps to and referred to its origin (spatial twist).
+   *  The result is computed without forming intermediate poses.
+   *  \returns pose
+   */
+  Derived_ boxPlus(const Vector6& vector) const {
+    return internal::BoxOperationTraits<PoseBase<Derived_>, PoseBase<Derived_>>::box_plus(this->derived(), vector);
+  }
+
+  /*! \brief Applies the box plus operation exp([v; w])*T in place.
+   *  \returns reference
+   */
+  Derived_& boxPlusInPlace(const Vector6& vector) {
+    this->derived() = internal::BoxOperationTraits<PoseBase<Derived_>, PoseBase<Derived_>>::box_plus(this->derived(), vector);
+    return this->derived();
+  }
+
+  /*! \brief Integrates a constant twist expressed in the frame of the body, i.e. computes T*exp([v; w]).
+   *  This is the exact integration of the body velocity over a time step, e.g. pose.boxPlus(twist*dt).
+   *  \param twist  linear and angular velocity of the body expressed in its local frame, multiplied by the time step
+   *  \returns pose
+   */
+  template<typename PrimType_>
+  Derived_ boxPlus(const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twist) const {
+    return internal::BoxOperationTraits<PoseBase<Derived_>, PoseBase<Derived_>>::box_plus_local(this->derived(), twist.getVector());
+  }
+
   /*! \brief Compares two poses.
    *  \returns true if the poses are exactly equal
    */
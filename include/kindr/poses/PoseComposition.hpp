@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/poses/PoseBase.hpp"
+#include "kindr/rotations/RotationComposition.hpp"
+
+namespace kindr {
+
+/*! \class PoseComposition
+ *  \brief Lazy concatenation T_1*T_2*...*T_n of poses, e.g. T_AB.lazy()*T_BC*T_CD.
+ *
+ *  Like RotationComposition for rotations: a single position is transformed by the factors from right to left, which
+ *  needs no concatenated pose. The product is only computed when the composition is assigned to a pose, evaluated with
+ *  eval() or used to transform a batch of positions. The rotations of the factors are then concatenated in the
+ *  intermediate type of the rotation of the result, see internal::get_composition_intermediate, and converted once.
+ *
+ *  The factors are stored by value.
+ *  \tparam Poses_  types of the factors
+ *  \ingroup poses
+ */
+template<typename... Poses_>
+class PoseComposition {
+ public:
+  typedef std::tuple<Poses_...> Factors;
+  typedef typename std::tuple_element<0, Factors>::type First;
+  typedef typename First::Scalar Scalar;
+  typedef typename First::Position Position;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  //! Number of factors
+  enum { Size = sizeof...(Poses_) };
+
+  /*! \brief Constructor.
+   *  \param poses   factors
+   */
+  explicit PoseComposition(const Poses_&... poses)
+    : factors_(poses...) {
+  }
+
+  /*! \brief Constructor.
+   *  \param factors   tuple of factors
+   */
+  explicit PoseComposition(const Factors& factors)
+    : factors_(factors) {
+  }
+
+  //! \returns the factors
+  inline const Factors& getFactors() const {
+    return factors_;
+  }
+
+  /*! \brief Appends a pose.
+   *  \returns the composition this*other
+   */
+  template<typename OtherDerived_>
+  PoseComposition<Poses_..., OtherDerived_> operator *(const PoseBase<OtherDerived_>& other) const {
+    return PoseComposition<Poses_..., OtherDerived_>(std::tuple_cat(factors_, std::tuple<OtherDerived_>(other.derived())));
+  }
+
+  /*! \brief Appends the factors of another composition.
+   *  \returns the composition this*other
+   */
+  template<typename... OtherPoses_>
+  PoseComposition<Poses_..., OtherPoses_...> operator *(const PoseComposition<OtherPoses_...>& other) const {
+    return PoseComposition<Poses_..., OtherPoses_...>(std::tuple_cat(factors_, other.getFactors()));
+  }
+
+  /*! \brief Computes the product in a pose type.
+   *  \returns the product
+   */
+  template<typename Pose_>
+  Pose_ eval() const {
+    typedef typename internal::get_composition_intermediate<typename Pose_::Rotation>::Intermediate Intermediate;
+    Intermediate rotation(std::get<0>(factors_).getRotation());
+    Vector3 position = std::get<0>(factors_).getPosition().toImplementation();
+    multiplyFrom(rotation, position, std::integral_constant<int, 1>());
+    return Pose_(typename Pose_::Position(position), typename Pose_::Rotation(rotation));
+  }
+
+  /*! \brief Computes the product in the type of the first factor, as operator*() of the poses.
+   *  \returns the product
+   */
+  First eval() const {
+    return eval<First>();
+  }
+
+  /*! \brief Computes the product on assignment to a pose.
+   *  \returns the product
+   */
+  template<typename Pose_, typename = typename std::enable_if<std::is_base_of<PoseBase<Pose_>, Pose_>::value>::type>
+  operator Pose_() const {
+    return eval<Pose_>();
+  }
+
+  /*! \brief Transforms a position by the factors from right to left.
+   *  \returns the transformed position
+   */
+  Position transform(const Position& position) const {
+    return transformFrom(position, std::integral_constant<int, 0>());
+  }
+
+  /*! \brief Transforms a position by the inverse of the product.
+   *  \returns the transformed position
+   */
+  Position inverseTransform(const Position& position) const {
+    return inverseTransformFrom(position, std::integral_constant<int, 0>());
+  }
+
+  /*! \brief Transforms a batch of positions stored column-wise by the product.
+   *  \returns the 3xN matrix of transformed positions
+   */
+  Matrix3X transform(const Eigen::Ref<const Matrix3X>& positions) const {
+    return eval().transform(positions);
+  }
+
+  /*! \brief Transforms a batch of positions stored column-wise by the inverse of the product.
+   *  \returns the 3xN matrix of transformed positions
+   */
+  Matrix3X inverseTransform(const Eigen::Ref<const Matrix3X>& positions) const {
+    return eval().inverseTransform(positions);
+  }
+
+ private:
+  //! Transforms by the factors Index_, ..., Size-1 from right to left
+  template<int Index_>
+  Position transformFrom(const Position& position, std::integral_constant<int, Index_>) const {
+    return Position(std::get<Index_>(factors_).transform(transformFrom(position, std::integral_constant<int, Index_ + 1>())));
+  }
+
+  Position transformFrom(const Position& position, std::integral_constant<int, Size>) const {
+    return position;
+  }
+
+  //! Transforms by the inverses of the factors Index_, ..., Size-1 from left to right
+  template<int Index_>
+  Position inverseTransformFrom(const Position& position, std::integral_constant<int, Index_>) const {
+    return inverseTransformFrom(Position(std::get<Index_>(factors_).inverseTransform(position)), std::integral_constant<int, Index_ + 1>());
+  }
+
+  Position inverseTransformFrom(const Position& position, std::integral_constant<int, Size>) const {
+    return position;
+  }
+
+  //! Concatenates the factors Index_, ..., Size-1 to the rotation and position of the product from the right
+  template<typename Intermediate_, int Index_, typename std::enable_if<(Index_ < Size), int>::type = 0>
+  void multiplyFrom(Intermediate_& rotation, Vector3& position, std::integral_constant<int, Index_>) const {
+    const typename std::tuple_element<Index_, Factors>::type& pose = std::get<Index_>(factors_);
+    position += rotation.rotate(Vector3(pose.getPosition().toImplementation()));
+    rotation = Intermediate_(typename Intermediate_::Implementation(rotation.toImplementation()*Intermediate_(pose.getRotation()).toImplementation()));
+    multiplyFrom(rotation, position, std::integral_constant<int, Index_ + 1>());
+  }
+
+  template<typename Intermediate_, int Index_, typename std::enable_if<(Index_ == Size), int>::type = 0>
+  void multiplyFrom(Intermediate_& /*rotation*/, Vector3& /*position*/, std::integral_constant<int, Index_>) const {
+  }
+
+  Factors factors_;
+};
+
+} // namespace kindr
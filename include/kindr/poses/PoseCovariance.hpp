@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/RotationCovariance.hpp"
+#include "kindr/poses/PoseBase.hpp"
+#include "kindr/poses/PoseJacobians.hpp"
+
+namespace kindr {
+
+/* Propagation of covariances through poses.
+ * The uncertainty of a pose T = (C, r) is a perturbation d = [dv; dw] ~ N(0, P) in the convention of
+ * PoseBase::boxPlus, i.e. the true pose is exp(d)*T with the translational part dv in the first and the rotational
+ * part dw in the last three components. The covariances are propagated to first order with the adjoint
+ * Ad_T = [C, [r]x*C; 0, C] and the Jacobians of PoseJacobians.hpp, and the uncertainties of different arguments are
+ * assumed to be uncorrelated. The results are exactly symmetric, see RotationCovariance.hpp.
+ */
+
+namespace internal {
+
+/*! \brief Gets Ad_T*P*Ad_T^T for T = (C, r) and a symmetric 6x6 matrix P.
+ *  Ad_T = [I, [r]x; 0, I]*diag(C, C), hence the blocks of P are rotated first and then sheared, which takes about half
+ *  of the multiplications of the dense product with the 6x6 adjoint.
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 6, 6> getAdjointSandwich(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix,
+                                                         const Eigen::Matrix<PrimType_, 3, 1>& translation,
+                                                         const Eigen::Matrix<PrimType_, 6, 6>& covariance) {
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  const Matrix3 skewMatrix = getSkewMatrixFromVector(translation);
+  // the blocks of diag(C, C)*P*diag(C, C)^T
+  const Matrix3 vv = getSymmetricProduct<PrimType_, 3, 3>(rotationMatrix, covariance.template topLeftCorner<3, 3>());
+  const Matrix3 vw = rotationMatrix*covariance.template topRightCorner<3, 3>()*rotationMatrix.transpose();
+  const Matrix3 ww = getSymmetricProduct<PrimType_, 3, 3>(rotationMatrix, covariance.template bottomRightCorner<3, 3>());
+  // the shear [I, [r]x; 0, I] only changes the upper blocks
+  const Matrix3 coupling = vw + skewMatrix*ww;
+  Eigen::Matrix<PrimType_, 6, 6> result;
+  result.template topLeftCorner<3, 3>() = vv + skewMatrix*vw.transpose() + coupling*skewMatrix.transpose();
+  result.template topRightCorner<3, 3>() = coupling;
+  result.template bottomRightCorner<3, 3>() = ww;
+  result.template triangularView<Eigen::StrictlyLower>() = result.transpose();
+  return result;
+}
+
+} // namespace internal
+
+/*! \brief Gets the covariance Ad_T*P*Ad_T^T of a perturbation after it has been moved by a pose T, e.g. to express the
+ *  covariance of a perturbation of the frame B in the frame I.
+ *  \param pose         pose T
+ *  \param covariance   symmetric 6x6 covariance P
+ *  \returns transformed covariance
+ */
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 6, 6> getTransformedCovariance(const PoseBase<Pose_>& pose,
+                                                                              const Eigen::Matrix<typename Pose_::Scalar, 6, 6>& covariance) {
+  typedef typename Pose_::Scalar Scalar;
+  return internal::getAdjointSandwich<Scalar>(RotationMatrix<Scalar>(pose.derived().getRotation()).toImplementation(),
+                                              pose.derived().getPosition().toImplementation(), covariance);
+}
+
+/*! \brief Gets the covariance of the inverse of an uncertain pose.
+ *  (exp(d)*T)^-1 = exp(-Ad_T^-1*d)*T^-1, hence the covariance is Ad_T^-1*P*Ad_T^-1^T.
+ *  \param pose         pose T
+ *  \param covariance   covariance P of the perturbation of T
+ *  \returns covariance of the perturbation of T^-1
+ */
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 6, 6> getInvertedCovariance(const PoseBase<Pose_>& pose,
+                                                                           const Eigen::Matrix<typename Pose_::Scalar, 6, 6>& covariance) {
+  typedef typename Pose_::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 3> transposed = RotationMatrix<Scalar>(pose.derived().getRotation()).toImplementation().transpose();
+  const Eigen::Matrix<Scalar, 3, 1> translation = -transposed*pose.derived().getPosition().toImplementation();
+  return internal::getAdjointSandwich<Scalar>(transposed, translation, covariance);
+}
+
+/*! \brief Gets the covariance of the concatenation T1*T2 of two uncertain poses.
+ *  exp(d1)*T1*exp(d2)*T2 = exp(d1 + Ad_T1*d2)*T1*T2 to first order, hence the covariance is P1 + Ad_T1*P2*Ad_T1^T.
+ *  \param pose1          pose T1
+ *  \param covariance1    covariance P1 of the perturbation of T1
+ *  \param covariance2    covariance P2 of the perturbation of T2
+ *  \returns covariance of the perturbation of T1*T2
+ */
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 6, 6> getComposedCovariance(const PoseBase<Pose_>& pose1,
+                                                                           const Eigen::Matrix<typename Pose_::Scalar, 6, 6>& covariance1,
+                                                                           const Eigen::Matrix<typename Pose_::Scalar, 6, 6>& covariance2) {
+  return covariance1 + getTransformedCovariance(pose1, covariance2);
+}
+
+/*! \brief Gets the covariance of the box plus T.boxPlus(d) = exp(d)*T of an uncertain pose and an uncertain vector.
+ *  exp(d + dd)*exp(dt)*T = exp(J(d)*dd + Ad_exp(d)*dt)*exp(d)*T to first order with the Jacobian J(d) of the
+ *  exponential map of SE(3), hence the covariance is Ad_exp(d)*P*Ad_exp(d)^T + J(d)*Pd*J(d)^T.
+ *  \param covariance         covariance P of the perturbation of T
+ *  \param vector             vector d = [v; w]
+ *  \param vectorCovariance   covariance Pd of d
+ *  \returns covariance of the perturbation of exp(d)*T
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 6, 6> getBoxPlusCovariance(const Eigen::Matrix<PrimType_, 6, 6>& covariance,
+                                                            const Eigen::Matrix<PrimType_, 6, 1>& vector,
+                                                            const Eigen::Matrix<PrimType_, 6, 6>& vectorCovariance) {
+  const Eigen::Matrix<PrimType_, 3, 1> translationalPart = vector.template head<3>();
+  const Eigen::Matrix<PrimType_, 3, 1> rotationalPart = vector.template tail<3>();
+  const Eigen::Matrix<PrimType_, 3, 3> rotationMatrix = RotationMatrix<PrimType_>().exponentialMap(rotationalPart).toImplementation();
+  const Eigen::Matrix<PrimType_, 3, 1> translation = getJacobianOfExponentialMap(rotationalPart)*translationalPart;
+  return internal::getAdjointSandwich<PrimType_>(rotationMatrix, translation, covariance)
+      + internal::getSymmetricProduct<PrimType_, 6, 6>(getJacobianOfExponentialMap(vector), vectorCovariance);
+}
+
+/*! \brief Gets the covariance of a position y = T*p transformed by an uncertain pose.
+ *  exp(d)*T*(p + dp) = y + dv - [y]x*dw + C*dp to first order, hence the covariance is B*P*B^T + C*Pp*C^T with
+ *  B = [I, -[y]x].
+ *  \param pose                 pose T = (C, r)
+ *  \param covariance           covariance P of the perturbation of T
+ *  \param position             position p
+ *  \param positionCovariance   covariance Pp of p
+ *  \returns covariance of T*p
+ */
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 3, 3> getTransformedPositionCovariance(const PoseBase<Pose_>& pose,
+                                                                                     const Eigen::Matrix<typename Pose_::Scalar, 6, 6>& covariance,
+                                                                                     const Eigen::Matrix<typename Pose_::Scalar, 3, 1>& position,
+                                                                                     const Eigen::Matrix<typename Pose_::Scalar, 3, 3>& positionCovariance) {
+  typedef typename Pose_::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 3> rotationMatrix = RotationMatrix<Scalar>(pose.derived().getRotation()).toImplementation();
+  const Eigen::Matrix<Scalar, 3, 1> transformed = rotationMatrix*position + pose.derived().getPosition().toImplementation();
+  Eigen::Matrix<Scalar, 3, 6> jacobian;
+  jacobian << Eigen::Matrix<Scalar, 3, 3>::Identity(), -getSkewMatrixFromVector(transformed);
+  return internal::getSymmetricProduct<Scalar, 3, 6>(jacobian, covariance)
+      + internal::getSymmetricProduct<Scalar, 3, 3>(rotationMatrix, positionCovariance);
+}
+
+/*! \brief Transforms many uncertain positions, e.g. landmarks, by an uncertain pose, see getTransformedPositionCovariance().
+ *
+ *  Per position, the packed covariance B*P*B^T + C*Pp*C^T is a quadratic polynomial in y = T*p and linear in Pp. It is
+ *  the product of a 6x16 matrix, which depends only on T and P, with [1; y; packed(y*y^T); packed(Pp)].
+ *  \param pose                   pose T = (C, r)
+ *  \param covariance             covariance P of the perturbation of T
+ *  \param positions              row-major 3xN matrix of positions p
+ *  \param positionCovariances    row-major 6xN matrix of packed covariances of the positions, see packCovariance()
+ *  \param transformedPositions   row-major 3xN matrix, the transformed positions T*p are written here
+ *  \param transformedCovariances row-major 6xN matrix, the packed covariances of the transformed positions are written here
+ *  \param executor               executor on which the positions are split, see Executor.hpp
+ */
+template<typename Pose_, typename Executor_ = SerialExecutor>
+void transformPositionsWithCovariance(const PoseBase<Pose_>& pose,
+                                      const Eigen::Matrix<typename Pose_::Scalar, 6, 6>& covariance,
+                                      const Eigen::Ref<const Eigen::Matrix<typename Pose_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>>& positions,
+                                      const Eigen::Ref<const internal::PackedCovarianceMatrix<typename Pose_::Scalar>>& positionCovariances,
+                                      Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>> transformedPositions,
+                                      Eigen::Ref<internal::PackedCovarianceMatrix<typename Pose_::Scalar>> transformedCovariances,
+                                      const Executor_& executor = Executor_()) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  enum { BlockSize = internal::BatchConversionBlockSize };
+  KINDR_ASSERT_TRUE(std::runtime_error, positionCovariances.cols() == positions.cols(), "The number of covariances must be equal to the number of positions.");
+  KINDR_ASSERT_TRUE(std::runtime_error, transformedPositions.cols() == positions.cols() && transformedCovariances.cols() == positions.cols(),
+                    "The number of transformed positions and covariances must be equal to the number of positions.");
+  const Matrix3 rotationMatrix = RotationMatrix<Scalar>(pose.derived().getRotation()).toImplementation();
+  const Eigen::Matrix<Scalar, 3, 1> translation = pose.derived().getPosition().toImplementation();
+
+  // B*P*B^T = Pvv - [y]x*Pvw^T - Pvw*[y]x^T + [y]x*Pww*[y]x^T with [y]x = sum_k y_k*[e_k]x
+  const Matrix3 translationalBlock = covariance.template topLeftCorner<3, 3>();
+  const Matrix3 couplingBlock = covariance.template topRightCorner<3, 3>();
+  Eigen::Matrix<Scalar, 6, 16> coefficients;
+  coefficients.col(0) = packCovariance(translationalBlock);
+  for (int k = 0; k < 3; ++k) {
+    const Matrix3 skewMatrix = getSkewMatrixFromVector(Eigen::Matrix<Scalar, 3, 1>(Eigen::Matrix<Scalar, 3, 1>::Unit(k)));
+    const Matrix3 coupling = couplingBlock*skewMatrix.transpose();
+    coefficients.col(1 + k) = -packCovariance(Matrix3(coupling + coupling.transpose()));
+  }
+  coefficients.template middleCols<6>(4) = internal::getPackedSkewSandwichMatrix<Scalar>(covariance.template bottomRightCorner<3, 3>());
+  coefficients.template rightCols<6>() = internal::getPackedSandwichMatrix<Scalar>(rotationMatrix);
+
+  executor.parallelFor(0, static_cast<int>(positions.cols()), internal::CovarianceBatchGrainSize, [&](int begin, int end) {
+    Eigen::Matrix<Scalar, 16, Eigen::Dynamic, Eigen::RowMajor, 16, BlockSize> terms;
+    for (int start = begin; start < end; start += BlockSize) {
+      const int length = std::min<int>(BlockSize, end - start);
+      terms.resize(16, length);
+      auto transformed = transformedPositions.middleCols(start, length);
+      transformed.noalias() = rotationMatrix*positions.middleCols(start, length);
+      transformed.colwise() += translation;
+      terms.row(0).setOnes();
+      terms.template middleRows<3>(1) = transformed;
+      auto monomials = terms.template middleRows<6>(4);
+      internal::setPackedMonomials(transformed, monomials, length);
+      terms.template bottomRows<6>() = positionCovariances.middleCols(start, length);
+      transformedCovariances.middleCols(start, length).noalias() = coefficients*terms;
+    }
+  });
+}
+
+} // namespace kindr
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Allocators.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/PoseJacobians.hpp"
+
+/*! \file PoseGraph.hpp
+ *  \brief Batched relative-pose residuals of a pose graph.
+ *
+ *  An edge (i, j, T_ij) measures the pose of the node j with respect to the node i. Its error is
+ *    e = boxMinus(T_i^-1*T_j, T_ij) = log(T_i^-1*T_j*T_ij^-1)
+ *  with the Jacobians with respect to the perturbations T_i <- exp(d_i)*T_i and T_j <- exp(d_j)*T_j of PoseBase::boxPlus
+ *    de/dd_j = J^-1(e)*Ad_{T_i^-1}    and    de/dd_i = -de/dd_j,
+ *  where J^-1 is the Jacobian of the logarithmic map of SE(3). The errors of all edges are written to the columns of a
+ *  6xE matrix and the Jacobians to consecutive 6x6 blocks of 6x6E matrices, and the edges are split on an executor.
+ */
+
+namespace kindr {
+
+/*! \class PoseGraphEdge
+ * \brief Relative-pose measurement between two nodes of a pose graph.
+ * \tparam Pose_ the type of the pose, e.g. HomTransformQuatD
+ * \ingroup poses
+ */
+template<typename Pose_>
+class PoseGraphEdge {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef Pose_ Pose;
+
+  /*! \brief Constructor.
+   *  \param first         index i of the first node
+   *  \param second        index j of the second node
+   *  \param measurement   measured pose T_ij of the node j with respect to the node i
+   */
+  PoseGraphEdge(int first, int second, const Pose_& measurement)
+      : first_(first),
+        second_(second),
+        measurement_(measurement) {
+  }
+
+  inline int getFirst() const {
+    return first_;
+  }
+
+  inline int getSecond() const {
+    return second_;
+  }
+
+  inline const Pose_& getMeasurement() const {
+    return measurement_;
+  }
+
+ protected:
+  int first_;
+  int second_;
+  Pose_ measurement_;
+};
+
+namespace internal {
+
+//! Number of edges below which the batch is not split
+enum { PoseGraphGrainSize = 256 };
+
+template<typename Pose_>
+inline void checkPoseGraphEdges(const AlignedVector<Pose_>& poses,
+                                const AlignedVector<PoseGraphEdge<Pose_>>& edges) {
+  const int numPoses = static_cast<int>(poses.size());
+  for (const PoseGraphEdge<Pose_>& edge : edges) {
+    KINDR_ASSERT_TRUE(std::runtime_error, edge.getFirst() >= 0 && edge.getFirst() < numPoses && edge.getSecond() >= 0 && edge.getSecond() < numPoses,
+                      "The edge (" << edge.getFirst() << ", " << edge.getSecond() << ") refers to a node out of the " << numPoses << " poses.");
+  }
+}
+
+/*! \brief Computes the error of an edge and optionally the Jacobian with respect to the second pose.
+ *  The error is evaluated as boxMinus() does, but the sine and cosine of its angle are taken from the unit quaternion
+ *  of the error rotation, such that J^-1 of the translational part and the Jacobian need no further trigonometric
+ *  functions.
+ *
+ *  (only for advanced users)
+ */
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 6, 1> getRelativePoseError(const Pose_& first, const Pose_& second, const Pose_& measurement,
+                                                                           Eigen::Matrix<typename Pose_::Scalar, 6, 6>* jacobianSecond) {
+  typedef typename Pose_::Scalar Scalar;
+  typedef typename Pose_::Rotation Rotation;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  // T_i^-1*T_j*T_ij^-1 = (C, r) with C = C_i^-1*C_j*C_ij^-1 and r = C_i^-1*(r_j - r_i) - C*r_ij
+  const Rotation firstRotationInverse = first.getRotation().inverted();
+  const Rotation rotation = firstRotationInverse*second.getRotation()*Rotation(measurement.getRotation()).inverted();
+  const Vector3 translation = firstRotationInverse.rotate(Vector3(second.getPosition().toImplementation() - first.getPosition().toImplementation()))
+      - rotation.rotate(Vector3(measurement.getPosition().toImplementation()));
+
+  // The quaternion (cos(a/2), sin(a/2)*n) with positive real part yields the angle a in [0, pi] and sin(a), cos(a)
+  const RotationQuaternion<Scalar> quaternion(rotation);
+  const Vector3 rotationalPart = quaternion.logarithmicMap();
+  using std::abs;
+  const Scalar halfAngleCosine = abs(quaternion.w());
+  const Scalar halfAngleSine = quaternion.toImplementation().vec().norm();
+  const SE3JacobianCoefficients<Scalar> coefficients(rotationalPart.norm(), Scalar(2)*halfAngleSine*halfAngleCosine,
+                                                     halfAngleCosine*halfAngleCosine - halfAngleSine*halfAngleSine);
+  const Matrix3 inverseJacobian = coefficients.getInverseJacobian(rotationalPart);
+  Eigen::Matrix<Scalar, 6, 1> error;
+  error.template head<3>() = inverseJacobian*translation;
+  error.template tail<3>() = rotationalPart;
+
+  if (jacobianSecond != nullptr) {
+    // J^-1(e)*Ad_{T_i^-1} with Ad_{T_i^-1} = [C_i^T, -C_i^T*[r_i]x; 0, C_i^T]
+    const Matrix3 rotationMatrixInverse = RotationMatrix<Scalar>(firstRotationInverse).toImplementation();
+    const Matrix3 inverseJacobianTimesRotation = inverseJacobian*rotationMatrixInverse;
+    const Matrix3 coupling = inverseJacobian*coefficients.getCoupling(Vector3(error.template head<3>()), rotationalPart)*inverseJacobianTimesRotation;
+    jacobianSecond->template topLeftCorner<3,3>() = inverseJacobianTimesRotation;
+    jacobianSecond->template topRightCorner<3,3>() = -inverseJacobianTimesRotation*getSkewMatrixFromVector(Vector3(first.getPosition().toImplementation())) - coupling;
+    jacobianSecond->template bottomLeftCorner<3,3>().setZero();
+    jacobianSecond->template bottomRightCorner<3,3>() = inverseJacobianTimesRotation;
+  }
+  return error;
+}
+
+} // namespace internal
+
+
+/*! \brief Computes the error boxMinus(T_i^-1*T_j, T_ij) of a relative-pose measurement.
+ *  \param first         pose T_i of the first node
+ *  \param second        pose T_j of the second node
+ *  \param measurement   measured pose T_ij of the second node with respect to the first node
+ *  \returns the error [v; w]
+ */
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 6, 1> getRelativePoseError(const PoseBase<Pose_>& first, const PoseBase<Pose_>& second, const PoseBase<Pose_>& measurement) {
+  return internal::getRelativePoseError(first.derived(), second.derived(), measurement.derived(), nullptr);
+}
+
+/*! \brief Computes the error boxMinus(T_i^-1*T_j, T_ij) of a relative-pose measurement and its Jacobians.
+ *  \param first            pose T_i of the first node
+ *  \param second           pose T_j of the second node
+ *  \param measurement      measured pose T_ij of the second node with respect to the first node
+ *  \param jacobianFirst    6x6 Jacobian of the error with respect to the perturbation of T_i
+ *  \param jacobianSecond   6x6 Jacobian of the error with respect to the perturbation of T_j
+ *  \returns the error [v; w]
+ */
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 6, 1> getRelativePoseError(const PoseBase<Pose_>& first, const PoseBase<Pose_>& second, const PoseBase<Pose_>& measurement,
+                                                                           Eigen::Matrix<typename Pose_::Scalar, 6, 6>& jacobianFirst,
+                                                                           Eigen::Matrix<typename Pose_::Scalar, 6, 6>& jacobianSecond) {
+  const Eigen::Matrix<typename Pose_::Scalar, 6, 1> error = internal::getRelativePoseError(first.derived(), second.derived(), measurement.derived(), &jacobianSecond);
+  jacobianFirst = -jacobianSecond;
+  return error;
+}
+
+/*! \brief Computes the errors of all edges of a pose graph.
+ *  \param poses      poses of the nodes
+ *  \param edges      relative-pose measurements
+ *  \param errors     6xE matrix, the column e is set to the error of the edge e
+ *  \param executor   executor on which the edges are split, see Executor.hpp
+ */
+template<typename Pose_, typename Executor_ = SerialExecutor>
+void getRelativePoseErrors(const AlignedVector<Pose_>& poses,
+                           const AlignedVector<PoseGraphEdge<Pose_>>& edges,
+                           Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>> errors,
+                           const Executor_& executor = Executor_()) {
+  KINDR_ASSERT_TRUE(std::runtime_error, errors.cols() == static_cast<int>(edges.size()), "The number of errors must be equal to the number of edges.");
+  internal::checkPoseGraphEdges(poses, edges);
+  executor.parallelFor(0, static_cast<int>(edges.size()), internal::PoseGraphGrainSize, [&](int begin, int end) {
+    for (int e = begin; e < end; ++e) {
+      const PoseGraphEdge<Pose_>& edge = edges[e];
+      errors.col(e) = internal::getRelativePoseError(poses[edge.getFirst()], poses[edge.getSecond()], edge.getMeasurement(), nullptr);
+    }
+  });
+}
+
+/*! \brief Computes the errors of all edges of a pose graph and their Jacobians.
+ *  \param poses            poses of the nodes
+ *  \param edges            relative-pose measurements
+ *  \param errors           6xE matrix, the column e is set to the error of the edge e
+ *  \param jacobiansFirst   6x6E matrix, the block of the columns 6e to 6e+5 is set to the Jacobian of the error of
+ *                          the edge e with respect to the perturbation of its first pose
+ *  \param jacobiansSecond  6x6E matrix with the Jacobians with respect to the perturbation of the second poses
+ *  \param executor         executor on which the edges are split, see Executor.hpp
+ */
+template<typename Pose_, typename Executor_ = SerialExecutor>
+void getRelativePoseErrors(const AlignedVector<Pose_>& poses,
+                           const AlignedVector<PoseGraphEdge<Pose_>>& edges,
+                           Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>> errors,
+                           Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>> jacobiansFirst,
+                           Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>> jacobiansSecond,
+                           const Executor_& executor = Executor_()) {
+  typedef Eigen::Matrix<typename Pose_::Scalar, 6, 6> Matrix6;
+  const int numEdges = static_cast<int>(edges.size());
+  KINDR_ASSERT_TRUE(std::runtime_error, errors.cols() == numEdges, "The number of errors must be equal to the number of edges.");
+  KINDR_ASSERT_TRUE(std::runtime_error, jacobiansFirst.cols() == 6*numEdges && jacobiansSecond.cols() == 6*numEdges, "The Jacobians must have six columns per edge.");
+  internal::checkPoseGraphEdges(poses, edges);
+  executor.parallelFor(0, numEdges, internal::PoseGraphGrainSize, [&](int begin, int end) {
+    Matrix6 jacobianSecond;
+    for (int e = begin; e < end; ++e) {
+      const PoseGraphEdge<Pose_>& edge = edges[e];
+      errors.col(e) = internal::getRelativePoseError(poses[edge.getFirst()], poses[edge.getSecond()], edge.getMeasurement(), &jacobianSecond);
+      jacobiansSecond.template middleCols<6>(6*e) = jacobianSecond;
+      jacobiansFirst.template middleCols<6>(6*e) = -jacobianSecond;
+    }
+  });
+}
+
+} // namespace kindr
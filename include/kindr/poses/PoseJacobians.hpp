@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/RotationJacobians.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/PoseBase.hpp"
+
+namespace kindr {
+
+/* Jacobians of the exponential and logarithmic map of SE(3) and the adjoint of a pose.
+ * The 6D vectors [v; w] have the translational part v in the first and the rotational part w in the last three
+ * components, as for PoseBase::exponentialMap(). The Jacobians follow the perturbation convention of
+ * PoseBase::boxPlus, i.e. a pose T is perturbed by exp(d)*T, such that exp(x + d) = exp(J(x)*d)*exp(x) and
+ * log(exp(d)*exp(x)) = x + J^-1(x)*d.
+ */
+
+namespace internal {
+
+/*! \brief Coefficients of the Jacobians of the exponential and logarithmic map of SE(3) for the rotation vector w with
+ *  angle a = |w|, computed from a single evaluation of sin(a) and cos(a).
+ *
+ *  The upper right block of the Jacobian of the exponential map is
+ *    Q(v, w) = 1/2*V + c1*(W*V + V*W + W*V*W) + c2*(W*W*V + V*W*W - 3*W*V*W) + c3*(W*V*W*W + W*W*V*W)
+ *  with V = [v]x, W = [w]x, c1 = (a - sin(a))/a^3, c2 = (a^2 + 2*cos(a) - 2)/(2*a^4) and
+ *  c3 = (2*a - 3*sin(a) + a*cos(a))/(2*a^5).
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class SE3JacobianCoefficients {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+
+  //! a
+  PrimType_ angle_;
+  //! sin(a)
+  PrimType_ sine_;
+  //! cos(a)
+  PrimType_ cosine_;
+  //! 1/a^2 - cot(a/2)/(2*a), the coefficient of [w]x^2 in J^-1(w)
+  PrimType_ inverseJacobianFactor_;
+
+  explicit SE3JacobianCoefficients(PrimType_ angle) {
+    using std::sin;
+    using std::cos;
+    if (isLessThenEpsilons4thRoot(angle)) {
+      initialize(angle, angle, PrimType_(1));
+    } else {
+      initialize(angle, sin(angle), cos(angle));
+    }
+  }
+
+  /*! \brief Constructor with the precomputed sine and cosine of the angle, e.g. from the unit quaternion of exp(w).
+   */
+  SE3JacobianCoefficients(PrimType_ angle, PrimType_ sine, PrimType_ cosine) {
+    initialize(angle, sine, cosine);
+  }
+
+  //! Gets J^-1(w) = I - 1/2*[w]x + f*[w]x^2 of SO(3) with [w]x^2 = w*w^T - a^2*I
+  inline Matrix3 getInverseJacobian(const Vector3& w) const {
+    Matrix3 matrix = inverseJacobianFactor_*(w*w.transpose()) - PrimType_(0.5)*getSkewMatrixFromVector(w);
+    matrix.diagonal().array() += PrimType_(1) - inverseJacobianFactor_*w.squaredNorm();
+    return matrix;
+  }
+
+  //! Gets Q(v, w)
+  inline Matrix3 getCoupling(const Vector3& v, const Vector3& w) const {
+    const PrimType_ a2 = angle_*angle_;
+    const PrimType_ a4 = a2*a2;
+    PrimType_ c1, c2, c3;
+    if (angle_ < PrimType_(0.5)) {
+      // The closed forms cancel up to the 5th power of the angle, their series are exact to machine precision here
+      c1 = PrimType_(1.0/6.0) - a2/PrimType_(120) + a4/PrimType_(5040) - a4*a2/PrimType_(362880) + a4*a4/PrimType_(39916800);
+      c2 = PrimType_(1.0/24.0) - a2/PrimType_(720) + a4/PrimType_(40320) - a4*a2/PrimType_(3628800) + a4*a4/PrimType_(479001600);
+      c3 = PrimType_(1.0/120.0) - a2/PrimType_(2520) + a4/PrimType_(120960) - a4*a2/PrimType_(9979200) + a4*a4/PrimType_(1245404160);
+    } else {
+      const PrimType_ inverseAngle = PrimType_(1)/angle_;
+      const PrimType_ inverseA4 = PrimType_(1)/a4;
+      c1 = (angle_ - sine_)*inverseAngle*inverseAngle*inverseAngle;
+      c2 = (PrimType_(0.5)*a2 + cosine_ - PrimType_(1))*inverseA4;
+      c3 = (angle_ - PrimType_(1.5)*sine_ + PrimType_(0.5)*angle_*cosine_)*inverseA4*inverseAngle;
+    }
+    // With d = w^T*v, u = w x v and [w]x*[v]x = v*w^T - d*I the products of skew matrices reduce to
+    // W*V*W = -d*W, W*W*V + V*W*W = [w x u]x - 2*d*W and W*V*W*W + W*W*V*W = -2*d*(w*w^T - a^2*I)
+    const PrimType_ d = w.dot(v);
+    Matrix3 matrix = c1*(v*w.transpose() + w*v.transpose()) - (PrimType_(2)*c3*d)*(w*w.transpose())
+        + getSkewMatrixFromVector(Vector3(PrimType_(0.5)*v + c2*w.cross(w.cross(v)) + ((c2 - c1)*d)*w));
+    matrix.diagonal().array() += PrimType_(2)*d*(c3*w.squaredNorm() - c1);
+    return matrix;
+  }
+
+ private:
+  inline void initialize(PrimType_ angle, PrimType_ sine, PrimType_ cosine) {
+    angle_ = angle;
+    sine_ = sine;
+    cosine_ = cosine;
+    if (isLessThenEpsilons4thRoot(angle)) {
+      inverseJacobianFactor_ = PrimType_(1.0/12.0) + angle*angle/PrimType_(720);
+    } else {
+      // (1+cos(a))/sin(a) = sin(a)/(1-cos(a)) = cot(a/2), the second form is well defined at a = pi where sin(a) = 0
+      const PrimType_ halfAngleCotangent = (cosine >= PrimType_(0)) ? (PrimType_(1) + cosine)/sine : sine/(PrimType_(1) - cosine);
+      inverseJacobianFactor_ = PrimType_(1)/(angle*angle) - halfAngleCotangent/(PrimType_(2)*angle);
+    }
+  }
+};
+
+} // namespace internal
+
+/*!
+ * \brief Gets the 6x6 Jacobian of the exponential map of SE(3).
+ *  J([v; w]) = [J(w), Q(v, w); 0, J(w)] with the Jacobian J(w) of the exponential map of SO(3)
+ * \param   vector 6x1-matrix [v; w]
+ * \return  matrix  (6x6-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 6, 6> getJacobianOfExponentialMap(const Eigen::Matrix<PrimType_, 6, 1>& vector) {
+  const Eigen::Matrix<PrimType_, 3, 1> translationalPart = vector.template head<3>();
+  const Eigen::Matrix<PrimType_, 3, 1> rotationalPart = vector.template tail<3>();
+  const Eigen::Matrix<PrimType_, 3, 3> jacobian = getJacobianOfExponentialMap(rotationalPart);
+  Eigen::Matrix<PrimType_, 6, 6> matrix;
+  matrix << jacobian, internal::SE3JacobianCoefficients<PrimType_>(rotationalPart.norm()).getCoupling(translationalPart, rotationalPart),
+            Eigen::Matrix<PrimType_, 3, 3>::Zero(), jacobian;
+  return matrix;
+}
+
+/*!
+ * \brief Gets the 6x6 Jacobian of the logarithmic map of SE(3), i.e. the inverse of the Jacobian of the exponential map.
+ *  J^-1([v; w]) = [J^-1(w), -J^-1(w)*Q(v, w)*J^-1(w); 0, J^-1(w)]
+ * \param   vector 6x1-matrix [v; w], the logarithmic map of the pose (norm of w in [0,pi))
+ * \return  matrix  (6x6-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 6, 6> getJacobianOfLogarithmicMap(const Eigen::Matrix<PrimType_, 6, 1>& vector) {
+  const Eigen::Matrix<PrimType_, 3, 1> translationalPart = vector.template head<3>();
+  const Eigen::Matrix<PrimType_, 3, 1> rotationalPart = vector.template tail<3>();
+  const internal::SE3JacobianCoefficients<PrimType_> coefficients(rotationalPart.norm());
+  const Eigen::Matrix<PrimType_, 3, 3> inverseJacobian = coefficients.getInverseJacobian(rotationalPart);
+  Eigen::Matrix<PrimType_, 6, 6> matrix;
+  matrix << inverseJacobian, -inverseJacobian*coefficients.getCoupling(translationalPart, rotationalPart)*inverseJacobian,
+            Eigen::Matrix<PrimType_, 3, 3>::Zero(), inverseJacobian;
+  return matrix;
+}
+
+/*!
+ * \brief Gets the 6x6 adjoint matrix of a pose T = (C, r), which satisfies T*exp(d)*T^-1 = exp(Ad_T*d).
+ *  Ad_T = [C, [r]x*C; 0, C], see also transformTwist().
+ * \param   pose
+ * \return  matrix  (6x6-matrix)
+ */
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 6, 6> getAdjointMatrix(const PoseBase<Pose_>& pose) {
+  typedef typename Pose_::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 3> rotationMatrix = RotationMatrix<Scalar>(pose.derived().getRotation()).toImplementation();
+  const Eigen::Matrix<Scalar, 3, 1> translation = pose.derived().getPosition().toImplementation();
+  Eigen::Matrix<Scalar, 6, 6> matrix;
+  matrix << rotationMatrix, getSkewMatrixFromVector(translation)*rotationMatrix,
+            Eigen::Matrix<Scalar, 3, 3>::Zero(), rotationMatrix;
+  return matrix;
+}
+
+} // namespace kindr
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Allocators.hpp"
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/Twist.hpp"
+
+
+namespace kindr {
+
+
+/*! \class PoseTrajectory
+ * \brief Ring buffer of timestamped poses and twists with interpolating lookup.
+ *
+ *  The samples are stored contiguously in buffers of fixed capacity, which are allocated once on construction, such
+ *  that appending a sample never allocates. If the buffer is full, the oldest sample is overwritten. Optionally, the
+ *  samples older than a time window before the newest sample are evicted on every append.
+ *
+ *  A lookup first tests the interval of the previous lookup and its successor, which makes sequential lookups O(1),
+ *  and falls back to a binary search over the sample times otherwise. The position and the twist are interpolated
+ *  linearly, the rotation along the geodesic r0.boxPlus(t*(r1.boxMinus(r0))), which is the slerp for quaternions.
+ *  Since the lookups update the cached interval, they are non-const and a trajectory must not be looked up from
+ *  several threads without synchronization.
+ * \tparam Pose_    the type of the pose, e.g. HomTransformQuatD
+ * \tparam Twist_   the type of the twist, which needs getVector() and setVector()
+ * \ingroup poses
+ */
+template<typename Pose_, typename Twist_ = TwistLinearVelocityLocalAngularVelocity<typename Pose_::Scalar>>
+class PoseTrajectory {
+ public:
+  typedef Pose_ Pose;
+  typedef Twist_ Twist;
+  typedef typename Pose_::Scalar Scalar;
+  typedef typename Pose_::Position Position;
+  typedef typename Pose_::Rotation Rotation;
+
+  /*! \brief Constructor allocating the buffers.
+   *  \param capacity   maximal number of samples
+   *  \param window     samples older than the newest sample by more than the window are evicted on append
+   */
+  explicit PoseTrajectory(int capacity, Scalar window = std::numeric_limits<Scalar>::infinity())
+    : times_(capacity),
+      poses_(capacity),
+      twists_(capacity),
+      window_(window),
+      begin_(0),
+      size_(0),
+      hint_(0) {
+    KINDR_ASSERT_TRUE(std::runtime_error, capacity > 0, "The capacity must be positive.");
+  }
+
+  /*! \brief Appends a sample without allocating, which overwrites the oldest sample if the buffer is full.
+   *  \param time    time of the sample, which must be larger than the time of the newest sample
+   *  \param pose    pose
+   *  \param twist   twist
+   */
+  void push(Scalar time, const Pose_& pose, const Twist_& twist) {
+    KINDR_ASSERT_TRUE(std::runtime_error, size_ == 0 || time > getEndTime(), "The sample times must be strictly increasing.");
+    if (size_ == getCapacity()) {
+      popFront(1);
+    }
+    const int index = getIndex(size_);
+    times_[index] = time;
+    poses_[index] = pose;
+    twists_[index] = twist;
+    ++size_;
+    if (time - getStartTime() > window_) {
+      evictBefore(time - window_);
+    }
+  }
+
+  /*! \brief Appends a sample with zero twist.
+   *  \param time    time of the sample, which must be larger than the time of the newest sample
+   *  \param pose    pose
+   */
+  void push(Scalar time, const Pose_& pose) {
+    Twist_ twist;
+    twist.setZero();
+    push(time, pose, twist);
+  }
+
+  /*! \brief Removes the samples which are not needed for lookups at or after a time.
+   *  The newest sample at or before the time is kept for the interpolation.
+   *  \param time   time
+   */
+  void evictBefore(Scalar time) {
+    if (size_ > 0 && getStartTime() <= time) {
+      popFront(findLastSampleAtOrBefore(time, 0, size_ - 1));
+    }
+  }
+
+  /*! \brief Removes all samples.
+   */
+  void clear() {
+    begin_ = 0;
+    size_ = 0;
+    hint_ = 0;
+  }
+
+  /*! \brief Interpolates the pose and the twist at a time with a single search.
+   *  \param time    time in [getStartTime(), getEndTime()]
+   *  \param pose    interpolated pose
+   *  \param twist   interpolated twist
+   */
+  void lookup(Scalar time, Pose_& pose, Twist_& twist) {
+    const int i = findInterval(time);
+    if (i + 1 == size_) {
+      pose = poses_[getIndex(i)];
+      twist = twists_[getIndex(i)];
+      return;
+    }
+    const Scalar t = getInterpolationParameter(i, time);
+    pose = interpolatePose(i, t);
+    twist = interpolateTwist(i, t);
+  }
+
+  /*! \brief Interpolates the pose at a time.
+   *  \param time   time in [getStartTime(), getEndTime()]
+   *  \returns the pose
+   */
+  Pose_ getPose(Scalar time) {
+    const int i = findInterval(time);
+    return (i + 1 == size_) ? poses_[getIndex(i)] : interpolatePose(i, getInterpolationParameter(i, time));
+  }
+
+  /*! \brief Interpolates the twist at a time.
+   *  \param time   time in [getStartTime(), getEndTime()]
+   *  \returns the twist
+   */
+  Twist_ getTwist(Scalar time) {
+    const int i = findInterval(time);
+    return (i + 1 == size_) ? twists_[getIndex(i)] : interpolateTwist(i, getInterpolationParameter(i, time));
+  }
+
+  /*! \brief Checks if a time can be looked up.
+   *  \returns true if the time is in [getStartTime(), getEndTime()]
+   */
+  inline bool contains(Scalar time) const {
+    return size_ > 0 && time >= getStartTime() && time <= getEndTime();
+  }
+
+  //! \returns the time of the oldest sample
+  inline Scalar getStartTime() const {
+    return getSampleTime(0);
+  }
+
+  //! \returns the time of the newest sample
+  inline Scalar getEndTime() const {
+    return getSampleTime(size_ - 1);
+  }
+
+  //! \returns the time of the i-th oldest sample
+  inline Scalar getSampleTime(int i) const {
+    return times_[getIndex(i)];
+  }
+
+  //! \returns the pose of the i-th oldest sample
+  inline const Pose_& getSamplePose(int i) const {
+    return poses_[getIndex(i)];
+  }
+
+  //! \returns the twist of the i-th oldest sample
+  inline const Twist_& getSampleTwist(int i) const {
+    return twists_[getIndex(i)];
+  }
+
+  //! \returns the number of samples
+  inline int size() const {
+    return size_;
+  }
+
+  //! \returns true if there are no samples
+  inline bool empty() const {
+    return size_ == 0;
+  }
+
+  //! \returns the maximal number of samples
+  inline int getCapacity() const {
+    return static_cast<int>(times_.size());
+  }
+
+  //! \returns the time window
+  inline Scalar getWindow() const {
+    return window_;
+  }
+
+ protected:
+  //! \returns the buffer index of the i-th oldest sample
+  inline int getIndex(int i) const {
+    const int index = begin_ + i;
+    return (index < getCapacity()) ? index : index - getCapacity();
+  }
+
+  void popFront(int count) {
+    begin_ = getIndex(count);
+    size_ -= count;
+    hint_ = (hint_ > count) ? hint_ - count : 0;
+  }
+
+  /*! \brief Finds the interval [t_i, t_i+1] which contains the time.
+   *  \returns i, or the index of the newest sample if the time is equal to it and there is no interval
+   */
+  int findInterval(Scalar time) {
+    KINDR_ASSERT_TRUE(std::runtime_error, contains(time), "The time " << time << " is outside of the trajectory.");
+    // Sequential lookups stay in the same interval or move to the next one
+    if (hint_ + 1 < size_ && getSampleTime(hint_) <= time) {
+      if (time <= getSampleTime(hint_ + 1)) {
+        return hint_;
+      }
+      if (hint_ + 2 < size_ && time <= getSampleTime(hint_ + 2)) {
+        return ++hint_;
+      }
+    }
+    hint_ = findLastSampleAtOrBefore(time, 0, std::max(size_ - 2, 0));
+    return hint_;
+  }
+
+  /*! \brief Binary search for the newest sample at or before a time.
+   *  \returns the largest i in [lower, upper] with getSampleTime(i) <= time, or lower if there is none
+   */
+  int findLastSampleAtOrBefore(Scalar time, int lower, int upper) const {
+    while (lower < upper) {
+      const int middle = (lower + upper + 1)/2;
+      if (time < getSampleTime(middle)) {
+        upper = middle - 1;
+      }
+      else {
+        lower = middle;
+      }
+    }
+    return lower;
+  }
+
+  inline Scalar getInterpolationParameter(int i, Scalar time) const {
+    return (time - getSampleTime(i))/(getSampleTime(i + 1) - getSampleTime(i));
+  }
+
+  Pose_ interpolatePose(int i, Scalar t) const {
+    const Pose_& pose0 = poses_[getIndex(i)];
+    const Pose_& pose1 = poses_[getIndex(i + 1)];
+    const Rotation& rotation0 = pose0.getRotation();
+    return Pose_(Position((Scalar(1) - t)*pose0.getPosition().toImplementation() + t*pose1.getPosition().toImplementation()),
+                 rotation0.boxPlus(t*pose1.getRotation().boxMinus(rotation0)));
+  }
+
+  Twist_ interpolateTwist(int i, Scalar t) const {
+    Twist_ twist;
+    twist.setVector((Scalar(1) - t)*twists_[getIndex(i)].getVector() + t*twists_[getIndex(i + 1)].getVector());
+    return twist;
+  }
+
+  std::vector<Scalar> times_;
+  AlignedVector<Pose_> poses_;
+  AlignedVector<Twist_> twists_;
+  Scalar window_;
+  //! Buffer index of the oldest sample
+  int begin_;
+  int size_;
+  //! Interval of the previous lookup
+  int hint_;
+};
+
+
+//! \brief Trajectory of homogeneous transformations with quaternions and local twists with primitive type double
+typedef PoseTrajectory<HomTransformQuatD> PoseTrajectoryD;
+//! \brief Trajectory of homogeneous transformations with quaternions and local twists with primitive type float
+typedef PoseTrajectory<HomTransformQuatF> PoseTrajectoryF;
+
+
+} // namespace kindr
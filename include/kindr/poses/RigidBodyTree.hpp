@@ -0,0 +1,472 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <array>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Twist.hpp"
+#include "kindr/poses/SpatialInertia.hpp"
+
+
+namespace kindr {
+
+
+/*! \class RigidBodyTree
+ * \brief Tree of rigid bodies connected by one degree-of-freedom joints with recursive Newton-Euler inverse dynamics
+ *  and articulated-body forward dynamics.
+ *
+ *  Body i is attached to its parent body, or to the base, by joint i. Like in KinematicChain, the transformation from
+ *  the frame of body i to the frame of the parent is T_{p,i} = T_i * J_i(q_i) with a fixed link transformation T_i
+ *  and a rotation about or a translation along the joint axis n_i. The parent of a body must have a smaller index, such
+ *  that the bodies are ordered from the base to the leaves. All quantities of a body are expressed in and referred to
+ *  its own frame, i.e. the twists [v; w] are body twists and the accelerations are their derivatives, and the spatial
+ *  operations are carried out on 3D vectors and matrices as in SpatialAlgebra.hpp.
+ *
+ *  The base is either fixed or floating. A floating base, e.g. the torso of a legged robot, adds six degrees of
+ *  freedom, whose twist and acceleration are expressed in the base frame. Gravity is given in the base frame and
+ *  enters as an acceleration of the base. The link data, the local transformations and the intermediate quantities of
+ *  the recursions are stored in fixed-size arrays, such that the algorithms do not allocate memory.
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \tparam NumBodies_ the number of bodies and joints without the base
+ * \ingroup poses
+ */
+template<typename PrimType_, int NumBodies_>
+class RigidBodyTree {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 6, 6> Matrix6;
+  typedef Eigen::Matrix<PrimType_, 6, 1> Vector6;
+  typedef Eigen::Matrix<PrimType_, NumBodies_, 1> JointVector;
+  typedef HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationMatrix<PrimType_>> Pose;
+  typedef TwistLinearVelocityLocalAngularVelocity<PrimType_> Twist;
+  typedef Wrench6<PrimType_> Wrench;
+  typedef SpatialInertia<PrimType_> Inertia;
+
+  //! Type of a joint
+  enum class JointType {
+    Revolute,
+    Prismatic
+  };
+
+  //! Number of bodies without the base
+  enum { NumBodies = NumBodies_ };
+
+  //! Parent index of the bodies which are attached to the base
+  enum { Base = -1 };
+
+  /*! \brief Default constructor.
+   *
+   *  Creates a chain of massless bodies with revolute joints about the z-axis, identity link transformations and zero
+   *  joint positions.
+   */
+  RigidBodyTree() {
+    for (int i = 0; i < NumBodies_; ++i) {
+      setBody(i, i-1, Pose(), Vector3::UnitZ(), JointType::Revolute, Inertia());
+    }
+    jointPositions_.setZero();
+    update();
+  }
+
+  /*! \brief Sets the parent, the fixed transformation, the joint and the inertia of a body.
+   *  The transformations are not reevaluated until the joint positions are set.
+   *  \param index            index of the body and the joint
+   *  \param parent           index of the parent body, smaller than index, or Base
+   *  \param linkTransform    fixed transformation T_i from the frame before joint i to the frame of the parent
+   *  \param axis             joint axis expressed in the joint frame (normalized internally)
+   *  \param type             type of the joint
+   *  \param inertia          inertia expressed in and referred to the frame of the body
+   */
+  template<typename OtherDerived_>
+  void setBody(int index, int parent, const PoseBase<OtherDerived_>& linkTransform, const Vector3& axis, JointType type, const Inertia& inertia) {
+    KINDR_ASSERT_TRUE(std::runtime_error, index >= 0 && index < NumBodies_, "The body index is out of range.");
+    KINDR_ASSERT_TRUE(std::runtime_error, parent >= Base && parent < index, "The parent must have a smaller index than the body.");
+    KINDR_ASSERT_TRUE(std::runtime_error, axis.norm() > internal::NumTraits<Scalar>::dummy_precision(), "The joint axis must not be zero.");
+    const Matrix3 linkRotationMatrix = RotationMatrix<PrimType_>(linkTransform.derived().getRotation()).toImplementation();
+    const Vector3 unitAxis = axis.normalized();
+    const Matrix3 skewAxis = getSkewMatrixFromVector(unitAxis);
+    parents_[index] = parent;
+    linkRotationMatrices_[index] = linkRotationMatrix;
+    linkRotationMatricesSkew_[index] = linkRotationMatrix*skewAxis;
+    linkRotationMatricesSkewSquared_[index] = linkRotationMatricesSkew_[index]*skewAxis;
+    linkTranslations_[index] = linkTransform.derived().getPosition().toImplementation();
+    axes_[index] = unitAxis;
+    jointTypes_[index] = type;
+    inertias_[index] = inertia;
+  }
+
+  /*! \brief Sets the inertia of a floating base, which is expressed in and referred to the base frame.
+   *  \param inertia   inertia of the base
+   */
+  void setBaseInertia(const Inertia& inertia) {
+    baseInertia_ = inertia;
+  }
+
+  /*! \brief Sets all joint positions and evaluates the local transformations.
+   *  \param jointPositions   joint angles [rad] or displacements [m]
+   */
+  void setJointPositions(const JointVector& jointPositions) {
+    jointPositions_ = jointPositions;
+    update();
+  }
+
+  /*! \brief Reevaluates the local transformations, e.g. after changing link transformations.
+   */
+  void update() {
+    for (int i = 0; i < NumBodies_; ++i) {
+      if (jointTypes_[i] == JointType::Revolute) {
+        using std::sin;
+        using std::cos;
+        const Scalar sinAngle = sin(jointPositions_(i));
+        const Scalar cosAngle = cos(jointPositions_(i));
+        rotationMatrices_[i] = linkRotationMatrices_[i] + sinAngle*linkRotationMatricesSkew_[i] + (Scalar(1)-cosAngle)*linkRotationMatricesSkewSquared_[i];
+        translations_[i] = linkTranslations_[i];
+      } else {
+        rotationMatrices_[i] = linkRotationMatrices_[i];
+        translations_[i].noalias() = linkRotationMatrices_[i]*axes_[i];
+        translations_[i] = linkTranslations_[i] + jointPositions_(i)*translations_[i];
+      }
+    }
+  }
+
+  inline const JointVector& getJointPositions() const {
+    return jointPositions_;
+  }
+
+  inline int getParent(int index) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, index >= 0 && index < NumBodies_, "The body index is out of range.");
+    return parents_[index];
+  }
+
+  inline JointType getJointType(int index) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, index >= 0 && index < NumBodies_, "The body index is out of range.");
+    return jointTypes_[index];
+  }
+
+  inline const Inertia& getInertia(int index) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, index >= 0 && index < NumBodies_, "The body index is out of range.");
+    return inertias_[index];
+  }
+
+  inline const Inertia& getBaseInertia() const {
+    return baseInertia_;
+  }
+
+  /*! \brief Gets the transformation T_{p,i} from the frame of a body to the frame of its parent.
+   *  \returns the transformation
+   */
+  inline Pose getLocalTransform(int index) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, index >= 0 && index < NumBodies_, "The body index is out of range.");
+    return Pose(typename Pose::Position(translations_[index]), typename Pose::Rotation(rotationMatrices_[index]));
+  }
+
+  /*! \brief Computes the joint torques of a fixed base with the recursive Newton-Euler algorithm.
+   *  \param jointVelocities      joint velocities
+   *  \param jointAccelerations   joint accelerations
+   *  \param gravity              gravitational acceleration expressed in the base frame
+   *  \param jointTorques         joint torques [Nm] or forces [N] which produce the accelerations
+   */
+  void computeInverseDynamics(const JointVector& jointVelocities, const JointVector& jointAccelerations, const Vector3& gravity,
+                              JointVector& jointTorques) {
+    inverseDynamics(Vector3::Zero(), Vector3::Zero(), -gravity, Vector3::Zero(), jointVelocities, jointAccelerations, jointTorques);
+  }
+
+  /*! \brief Computes the joint torques and the base wrench of a floating base with the recursive Newton-Euler algorithm.
+   *  \param baseTwist            twist of the base expressed in the base frame
+   *  \param baseAcceleration     spatial acceleration of the base, i.e. the derivative of baseTwist
+   *  \param jointVelocities      joint velocities
+   *  \param jointAccelerations   joint accelerations
+   *  \param gravity              gravitational acceleration expressed in the base frame
+   *  \param jointTorques         joint torques [Nm] or forces [N] which produce the accelerations
+   *  \returns the external wrench on the base, expressed in and referred to the base frame, which produces the
+   *           accelerations together with the joint torques
+   */
+  Wrench computeInverseDynamics(const Twist& baseTwist, const Twist& baseAcceleration, const JointVector& jointVelocities,
+                                const JointVector& jointAccelerations, const Vector3& gravity, JointVector& jointTorques) {
+    linearVelocities_[0] = baseTwist.getTranslationalVelocity().toImplementation();
+    angularVelocities_[0] = baseTwist.getRotationalVelocity().toImplementation();
+    inverseDynamics(linearVelocities_[0], angularVelocities_[0], Vector3(baseAcceleration.getTranslationalVelocity().toImplementation() - gravity),
+                    baseAcceleration.getRotationalVelocity().toImplementation(), jointVelocities, jointAccelerations, jointTorques);
+    return Wrench(forces_[0], torques_[0]);
+  }
+
+  /*! \brief Computes the joint accelerations of a fixed base with the articulated-body algorithm.
+   *  Throws unless the articulated inertia about every joint axis is positive, which fails e.g. for the massless bodies
+   *  of the default constructor.
+   *  \param jointVelocities      joint velocities
+   *  \param jointTorques         joint torques [Nm] or forces [N]
+   *  \param gravity              gravitational acceleration expressed in the base frame
+   *  \param jointAccelerations   joint accelerations
+   */
+  void computeForwardDynamics(const JointVector& jointVelocities, const JointVector& jointTorques, const Vector3& gravity,
+                              JointVector& jointAccelerations) {
+    forwardDynamics(Vector3::Zero(), Vector3::Zero(), jointVelocities, jointTorques, gravity, false, jointAccelerations);
+  }
+
+  /*! \brief Computes the joint accelerations and the base acceleration of a floating base with the articulated-body
+   *  algorithm. Throws unless the articulated inertia about every joint axis is positive and the articulated inertia of
+   *  the base is positive definite, which fails e.g. for the zero base inertia of the default constructor.
+   *  \param baseTwist            twist of the base expressed in the base frame
+   *  \param jointVelocities      joint velocities
+   *  \param jointTorques         joint torques [Nm] or forces [N]
+   *  \param gravity              gravitational acceleration expressed in the base frame
+   *  \param jointAccelerations   joint accelerations
+   *  \returns the spatial acceleration of the base, i.e. the derivative of baseTwist
+   */
+  Twist computeForwardDynamics(const Twist& baseTwist, const JointVector& jointVelocities, const JointVector& jointTorques,
+                               const Vector3& gravity, JointVector& jointAccelerations) {
+    forwardDynamics(baseTwist.getTranslationalVelocity().toImplementation(), baseTwist.getRotationalVelocity().toImplementation(),
+                    jointVelocities, jointTorques, gravity, true, jointAccelerations);
+    return Twist(Vector3(linearAccelerations_[0] + gravity), angularAccelerations_[0]);
+  }
+
+ protected:
+  //! Velocity [v; w] of body i from the velocity of its parent p, i.e. X_{i,p}*[v_p; w_p] + s_i*qd_i
+  inline void propagateVelocity(int i, const JointVector& jointVelocities) {
+    const int k = i+1;
+    const int p = parents_[i]+1;
+    const Matrix3& rotationMatrix = rotationMatrices_[i];
+    angularVelocities_[k].noalias() = rotationMatrix.transpose()*angularVelocities_[p];
+    linearVelocities_[k].noalias() = rotationMatrix.transpose()*(linearVelocities_[p] - translations_[i].cross(angularVelocities_[p]));
+    if (jointTypes_[i] == JointType::Revolute) {
+      angularVelocities_[k] += axes_[i]*jointVelocities(i);
+    } else {
+      linearVelocities_[k] += axes_[i]*jointVelocities(i);
+    }
+  }
+
+  //! Velocity-product acceleration [v; w] x s_i*qd_i of body i
+  inline void getBiasAcceleration(int i, const JointVector& jointVelocities, Vector3& linear, Vector3& angular) const {
+    const int k = i+1;
+    const Vector3 jointVelocity = axes_[i]*jointVelocities(i);
+    if (jointTypes_[i] == JointType::Revolute) {
+      linear = linearVelocities_[k].cross(jointVelocity);
+      angular = angularVelocities_[k].cross(jointVelocity);
+    } else {
+      linear = angularVelocities_[k].cross(jointVelocity);
+      angular.setZero();
+    }
+  }
+
+  //! Bias force v x* I*v of a body with the twist stored at index k
+  inline void getBiasWrench(const Inertia& inertia, int k, Vector3& force, Vector3& torque) const {
+    Vector3 linearMomentum, angularMomentum;
+    inertia.multiply(linearVelocities_[k], angularVelocities_[k], linearMomentum, angularMomentum);
+    force = angularVelocities_[k].cross(linearMomentum);
+    torque = angularVelocities_[k].cross(angularMomentum) + linearVelocities_[k].cross(linearMomentum);
+  }
+
+  //! Net force I*a + v x* I*v of a body with the twist and the acceleration stored at index k
+  inline void getNetWrench(const Inertia& inertia, int k, Vector3& force, Vector3& torque) const {
+    Vector3 inertialForce, inertialTorque;
+    getBiasWrench(inertia, k, force, torque);
+    inertia.multiply(linearAccelerations_[k], angularAccelerations_[k], inertialForce, inertialTorque);
+    force += inertialForce;
+    torque += inertialTorque;
+  }
+
+  //! Adds X_{i,p}^T*[f; t], i.e. the wrench of body i in the frame of its parent, to the wrench stored at index p
+  inline void accumulateWrench(int i, const Vector3& force, const Vector3& torque, Vector3& parentForce, Vector3& parentTorque) const {
+    const Vector3 rotatedForce = rotationMatrices_[i]*force;
+    parentForce += rotatedForce;
+    parentTorque.noalias() += rotationMatrices_[i]*torque;
+    parentTorque += translations_[i].cross(rotatedForce);
+  }
+
+  /*! Recursive Newton-Euler algorithm, the base acceleration includes gravity. The base wrench is left at index 0,
+   *  for a fixed base it is the wrench on the base without its own inertia.
+   */
+  void inverseDynamics(const Vector3& baseLinearVelocity, const Vector3& baseAngularVelocity,
+                       const Vector3& baseLinearAcceleration, const Vector3& baseAngularAcceleration,
+                       const JointVector& jointVelocities, const JointVector& jointAccelerations, JointVector& jointTorques) {
+    linearVelocities_[0] = baseLinearVelocity;
+    angularVelocities_[0] = baseAngularVelocity;
+    linearAccelerations_[0] = baseLinearAcceleration;
+    angularAccelerations_[0] = baseAngularAcceleration;
+    getNetWrench(baseInertia_, 0, forces_[0], torques_[0]);
+
+    // velocities, accelerations and net forces from the base to the leaves
+    for (int i = 0; i < NumBodies_; ++i) {
+      const int k = i+1;
+      const int p = parents_[i]+1;
+      propagateVelocity(i, jointVelocities);
+      const Matrix3& rotationMatrix = rotationMatrices_[i];
+      Vector3 linear, angular;
+      getBiasAcceleration(i, jointVelocities, linear, angular);
+      angularAccelerations_[k].noalias() = rotationMatrix.transpose()*angularAccelerations_[p];
+      angularAccelerations_[k] += angular;
+      linearAccelerations_[k].noalias() = rotationMatrix.transpose()*(linearAccelerations_[p] - translations_[i].cross(angularAccelerations_[p]));
+      linearAccelerations_[k] += linear;
+      if (jointTypes_[i] == JointType::Revolute) {
+        angularAccelerations_[k] += axes_[i]*jointAccelerations(i);
+      } else {
+        linearAccelerations_[k] += axes_[i]*jointAccelerations(i);
+      }
+      getNetWrench(inertias_[i], k, forces_[k], torques_[k]);
+    }
+
+    // joint torques and transmitted forces from the leaves to the base
+    for (int i = NumBodies_-1; i >= 0; --i) {
+      const int k = i+1;
+      const int p = parents_[i]+1;
+      jointTorques(i) = axes_[i].dot(jointTypes_[i] == JointType::Revolute ? torques_[k] : forces_[k]);
+      accumulateWrench(i, forces_[k], torques_[k], forces_[p], torques_[p]);
+    }
+  }
+
+  /*! Articulated-body algorithm. The accelerations of the bodies are relative to the free fall, the base acceleration
+   *  at index 0 is solved for a floating base and -gravity for a fixed base.
+   */
+  void forwardDynamics(const Vector3& baseLinearVelocity, const Vector3& baseAngularVelocity, const JointVector& jointVelocities,
+                       const JointVector& jointTorques, const Vector3& gravity, bool isFloating, JointVector& jointAccelerations) {
+    linearVelocities_[0] = baseLinearVelocity;
+    angularVelocities_[0] = baseAngularVelocity;
+    articulatedInertias_[0] = baseInertia_.getMatrix();
+    getBiasWrench(baseInertia_, 0, forces_[0], torques_[0]);
+
+    // velocities, bias accelerations and the rigid-body inertias and bias forces from the base to the leaves
+    for (int i = 0; i < NumBodies_; ++i) {
+      const int k = i+1;
+      propagateVelocity(i, jointVelocities);
+      getBiasAcceleration(i, jointVelocities, linearAccelerations_[k], angularAccelerations_[k]);
+      articulatedInertias_[k] = inertias_[i].getMatrix();
+      getBiasWrench(inertias_[i], k, forces_[k], torques_[k]);
+    }
+
+    // articulated inertias and bias forces from the leaves to the base
+    for (int i = NumBodies_-1; i >= 0; --i) {
+      const int k = i+1;
+      const int p = parents_[i]+1;
+      const Matrix6& inertia = articulatedInertias_[k];
+      Vector6& u = jointInertias_[i];
+      u = (jointTypes_[i] == JointType::Revolute) ? Vector6(inertia.template rightCols<3>()*axes_[i]) : Vector6(inertia.template leftCols<3>()*axes_[i]);
+      const Scalar d = (jointTypes_[i] == JointType::Revolute) ? u.template tail<3>().dot(axes_[i]) : u.template head<3>().dot(axes_[i]);
+      KINDR_ASSERT_TRUE(std::runtime_error, d > Scalar(0), "The articulated inertia of joint " << i << " must be positive, but is " << d << ".");
+      jointInverseInertias_(i) = Scalar(1)/d;
+      jointBiasTorques_(i) = jointTorques(i) - axes_[i].dot(jointTypes_[i] == JointType::Revolute ? torques_[k] : forces_[k]);
+
+      // Ia = IA - U*U^T/D and pa = pA + Ia*c + U*u/D in the frame of the body
+      Matrix6 articulatedInertia = inertia;
+      articulatedInertia.noalias() -= (jointInverseInertias_(i)*u)*u.transpose();
+      Vector6 bias;
+      bias << linearAccelerations_[k], angularAccelerations_[k];
+      Vector6 biasForce = articulatedInertia*bias + (jointBiasTorques_(i)*jointInverseInertias_(i))*u;
+      biasForce.template head<3>() += forces_[k];
+      biasForce.template tail<3>() += torques_[k];
+      accumulateInertia(i, articulatedInertia, articulatedInertias_[p]);
+      accumulateWrench(i, biasForce.template head<3>(), biasForce.template tail<3>(), forces_[p], torques_[p]);
+    }
+
+    // base acceleration relative to the free fall
+    if (isFloating) {
+      Vector6 baseBiasForce;
+      baseBiasForce << forces_[0], torques_[0];
+      const Eigen::LDLT<Matrix6> baseInertia(articulatedInertias_[0]);
+      KINDR_ASSERT_TRUE(std::runtime_error, baseInertia.info() == Eigen::Success
+                        && (baseInertia.vectorD().array() > internal::NumTraits<Scalar>::dummy_precision()*baseInertia.vectorD().cwiseAbs().maxCoeff()).all(),
+                        "The articulated inertia of the floating base must be positive definite.");
+      const Vector6 baseAcceleration = -baseInertia.solve(baseBiasForce);
+      linearAccelerations_[0] = baseAcceleration.template head<3>();
+      angularAccelerations_[0] = baseAcceleration.template tail<3>();
+    } else {
+      linearAccelerations_[0] = -gravity;
+      angularAccelerations_[0].setZero();
+    }
+
+    // joint accelerations and accelerations of the bodies from the base to the leaves
+    for (int i = 0; i < NumBodies_; ++i) {
+      const int k = i+1;
+      const int p = parents_[i]+1;
+      const Matrix3& rotationMatrix = rotationMatrices_[i];
+      angularAccelerations_[k].noalias() += rotationMatrix.transpose()*angularAccelerations_[p];
+      linearAccelerations_[k].noalias() += rotationMatrix.transpose()*(linearAccelerations_[p] - translations_[i].cross(angularAccelerations_[p]));
+      const Vector6& u = jointInertias_[i];
+      jointAccelerations(i) = jointInverseInertias_(i)*(jointBiasTorques_(i) - u.template head<3>().dot(linearAccelerations_[k])
+                                                        - u.template tail<3>().dot(angularAccelerations_[k]));
+      if (jointTypes_[i] == JointType::Revolute) {
+        angularAccelerations_[k] += axes_[i]*jointAccelerations(i);
+      } else {
+        linearAccelerations_[k] += axes_[i]*jointAccelerations(i);
+      }
+    }
+  }
+
+  /*! Adds X_{i,p}^T*Ia*X_{i,p} to the articulated inertia of the parent. With the blocks [A, B; B^T, D] of Ia rotated
+   *  into the parent frame, this is [A, B - A*[r]x; B^T + [r]x*A, D + [r]x*B - B^T*[r]x - [r]x*A*[r]x].
+   */
+  inline void accumulateInertia(int i, const Matrix6& inertia, Matrix6& parentInertia) const {
+    const Matrix3& rotationMatrix = rotationMatrices_[i];
+    const Matrix3 skew = getSkewMatrixFromVector(translations_[i]);
+    const Matrix3 a = rotationMatrix*inertia.template topLeftCorner<3, 3>()*rotationMatrix.transpose();
+    const Matrix3 b = rotationMatrix*inertia.template topRightCorner<3, 3>()*rotationMatrix.transpose();
+    const Matrix3 d = rotationMatrix*inertia.template bottomRightCorner<3, 3>()*rotationMatrix.transpose();
+    const Matrix3 shearedB = b - a*skew;
+    parentInertia.template topLeftCorner<3, 3>() += a;
+    parentInertia.template topRightCorner<3, 3>() += shearedB;
+    parentInertia.template bottomLeftCorner<3, 3>() += shearedB.transpose();
+    parentInertia.template bottomRightCorner<3, 3>() += d + skew*shearedB - b.transpose()*skew;
+  }
+
+  std::array<int, NumBodies_> parents_;
+  std::array<Matrix3, NumBodies_> linkRotationMatrices_;
+  std::array<Matrix3, NumBodies_> linkRotationMatricesSkew_;
+  std::array<Matrix3, NumBodies_> linkRotationMatricesSkewSquared_;
+  std::array<Vector3, NumBodies_> linkTranslations_;
+  std::array<Vector3, NumBodies_> axes_;
+  std::array<JointType, NumBodies_> jointTypes_;
+  std::array<Inertia, NumBodies_> inertias_;
+  Inertia baseInertia_;
+  JointVector jointPositions_;
+  std::array<Matrix3, NumBodies_> rotationMatrices_;
+  std::array<Vector3, NumBodies_> translations_;
+
+  // Quantities of the recursions, the base is stored at index 0 and body i at index i+1
+  std::array<Vector3, NumBodies_+1> linearVelocities_;
+  std::array<Vector3, NumBodies_+1> angularVelocities_;
+  std::array<Vector3, NumBodies_+1> linearAccelerations_;
+  std::array<Vector3, NumBodies_+1> angularAccelerations_;
+  std::array<Vector3, NumBodies_+1> forces_;
+  std::array<Vector3, NumBodies_+1> torques_;
+  std::array<Matrix6, NumBodies_+1> articulatedInertias_;
+  std::array<Vector6, NumBodies_> jointInertias_;
+  JointVector jointInverseInertias_;
+  JointVector jointBiasTorques_;
+};
+
+
+} // namespace kindr
@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/PoseBase.hpp"
+#include "kindr/poses/Twist.hpp"
+#include "kindr/phys_quant/Wrench.hpp"
+
+/*! \file SpatialAlgebra.hpp
+ *  \brief Spatial (6D) motion and force algebra on twists and wrenches.
+ *
+ *  The operators work on the 3+3 components instead of 6x6 matrices. A pose T_A_B with rotation matrix C and
+ *  translation r maps a twist [v; w] and a wrench [f; t] expressed in and referred to the frame B to the frame A by
+ *    Ad_T * [v; w] = [C*v + r x C*w; C*w]      and      Ad_T^-T * [f; t] = [C*f; C*t + r x C*f].
+ *  Twists are expected to have an angular velocity as rotational part, i.e. TwistLinearVelocityLocalAngularVelocity
+ *  or TwistLinearVelocityGlobalAngularVelocity. The batched versions take 6xN matrices with the linear velocity or
+ *  force in the first three and the angular velocity or torque in the last three rows, e.g. the columns of a
+ *  geometric Jacobian, and may be applied with different rotations and translations, e.g. the prefix
+ *  transformations of a KinematicChain, to transfer quantities across a kinematic tree. The single-quantity
+ *  versions taking a pose rotate with its own rotation, whereas the batched versions convert it to a matrix once.
+ *  The in-place block rotations only change the frame in which the columns are expressed, e.g. to assemble a body
+ *  Jacobian in the local or the global frame.
+ */
+
+namespace kindr {
+
+namespace internal {
+
+/*! \brief Computes [C*a + r x C*b; C*b] for both 3D parts of a 6D vector.
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline void transformSpatialColumns(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation,
+                                    const Eigen::Ref<const Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>>& vectors,
+                                    Eigen::Ref<Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>> transformed, bool isWrench) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  KINDR_ASSERT_TRUE(std::runtime_error, vectors.cols() == transformed.cols(), "The number of vectors and transformed vectors must be equal.");
+  for (int i = 0; i < vectors.cols(); ++i) {
+    const Vector3 top = rotationMatrix*vectors.template block<3,1>(0, i);
+    const Vector3 bottom = rotationMatrix*vectors.template block<3,1>(3, i);
+    if (isWrench) {
+      transformed.template block<3,1>(0, i) = top;
+      transformed.template block<3,1>(3, i) = bottom + translation.cross(top);
+    } else {
+      transformed.template block<3,1>(0, i) = top + translation.cross(bottom);
+      transformed.template block<3,1>(3, i) = bottom;
+    }
+  }
+}
+
+/*! \brief Computes [C^T*(a - r x b); C^T*b] (twists) or [C^T*a; C^T*(b - r x a)] (wrenches).
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline void inverseTransformSpatialColumns(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation,
+                                           const Eigen::Ref<const Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>>& vectors,
+                                           Eigen::Ref<Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>> transformed, bool isWrench) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  KINDR_ASSERT_TRUE(std::runtime_error, vectors.cols() == transformed.cols(), "The number of vectors and transformed vectors must be equal.");
+  for (int i = 0; i < vectors.cols(); ++i) {
+    const Vector3 top = vectors.template block<3,1>(0, i);
+    const Vector3 bottom = vectors.template block<3,1>(3, i);
+    if (isWrench) {
+      transformed.template block<3,1>(0, i) = rotationMatrix.transpose()*top;
+      transformed.template block<3,1>(3, i) = rotationMatrix.transpose()*(bottom - translation.cross(top));
+    } else {
+      transformed.template block<3,1>(0, i) = rotationMatrix.transpose()*(top - translation.cross(bottom));
+      transformed.template block<3,1>(3, i) = rotationMatrix.transpose()*bottom;
+    }
+  }
+}
+
+template<typename Pose_>
+inline Eigen::Matrix<typename Pose_::Scalar, 3, 3> getSpatialRotationMatrix(const PoseBase<Pose_>& pose) {
+  return RotationMatrix<typename Pose_::Scalar>(pose.derived().getRotation()).toImplementation();
+}
+
+/*! \brief Rotates the columns of a 3xN view, i.e. a block or a map, in place.
+ *
+ *  The columns are processed in fixed-size chunks whose lazy products unroll completely, which is faster than a
+ *  general matrix product for three rows. The view is taken by value to keep its compile-time strides.
+ *  (only for advanced users)
+ */
+template<typename PrimType_, typename Columns_>
+inline void rotateColumns(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, Columns_ columns) {
+  enum { ChunkSize = 8 };
+  int i = 0;
+  for (; i + ChunkSize <= columns.cols(); i += ChunkSize) {
+    const Eigen::Matrix<PrimType_, 3, ChunkSize> rotated = rotationMatrix.lazyProduct(columns.template middleCols<ChunkSize>(i));
+    columns.template middleCols<ChunkSize>(i) = rotated;
+  }
+  for (; i < columns.cols(); ++i) {
+    const Eigen::Matrix<PrimType_, 3, 1> rotated = rotationMatrix*columns.col(i);
+    columns.col(i) = rotated;
+  }
+}
+
+/*! \brief Rotates the linear and/or the angular 3xN block of a 6xN matrix in place.
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline void rotateSpatialBlocks(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, Eigen::Ref<Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>> vectors,
+                                bool rotateLinear, bool rotateAngular) {
+  if (rotateLinear && rotateAngular && vectors.outerStride() == 6) {
+    // diag(C, C) acts on the contiguous 3D parts of a dense 6xN matrix as on a single 3x2N matrix
+    rotateColumns(rotationMatrix, Eigen::Map<Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>>(vectors.data(), 3, 2*vectors.cols()));
+    return;
+  }
+  if (rotateLinear) {
+    rotateColumns(rotationMatrix, vectors.template topRows<3>());
+  }
+  if (rotateAngular) {
+    rotateColumns(rotationMatrix, vectors.template bottomRows<3>());
+  }
+}
+
+} // namespace internal
+
+
+/*! \brief Changes the frame of a twist, i.e. computes Ad_T * twist.
+ *  \param rotationMatrix   rotation matrix C of T_A_B
+ *  \param translation      translation r of T_A_B, i.e. the position of the origin of B in A
+ *  \param twist            twist expressed in and referred to the frame B
+ *  \returns the twist expressed in and referred to the frame A
+ */
+template<typename Twist_>
+inline Twist_ transformTwist(const Eigen::Matrix<typename Twist_::Scalar, 3, 3>& rotationMatrix, const Eigen::Matrix<typename Twist_::Scalar, 3, 1>& translation, const Twist_& twist) {
+  typedef Eigen::Matrix<typename Twist_::Scalar, 3, 1> Vector3;
+  const Vector3 angularVelocity = rotationMatrix*twist.getRotationalVelocity().toImplementation();
+  const Vector3 linearVelocity = rotationMatrix*twist.getTranslationalVelocity().toImplementation() + translation.cross(angularVelocity);
+  return Twist_(typename Twist_::PositionDiff(linearVelocity), typename Twist_::RotationDiff(angularVelocity));
+}
+
+/*! \brief Changes the frame of a twist, i.e. computes Ad_T * twist.
+ *  \param pose    pose T_A_B
+ *  \param twist   twist expressed in and referred to the frame B
+ *  \returns the twist expressed in and referred to the frame A
+ */
+template<typename Pose_, typename Twist_>
+inline Twist_ transformTwist(const PoseBase<Pose_>& pose, const Twist_& twist) {
+  typedef Eigen::Matrix<typename Twist_::Scalar, 3, 1> Vector3;
+  const Vector3 angularVelocity = pose.derived().getRotation().rotate(twist.getRotationalVelocity().toImplementation());
+  const Vector3 linearVelocity = pose.derived().getRotation().rotate(twist.getTranslationalVelocity().toImplementation())
+      + pose.derived().getPosition().toImplementation().cross(angularVelocity);
+  return Twist_(typename Twist_::PositionDiff(linearVelocity), typename Twist_::RotationDiff(angularVelocity));
+}
+
+/*! \brief Changes the frame of a twist in reverse, i.e. computes Ad_T^-1 * twist.
+ *  \param rotationMatrix   rotation matrix C of T_A_B
+ *  \param translation      translation r of T_A_B
+ *  \param twist            twist expressed in and referred to the frame A
+ *  \returns the twist expressed in and referred to the frame B
+ */
+template<typename Twist_>
+inline Twist_ inverseTransformTwist(const Eigen::Matrix<typename Twist_::Scalar, 3, 3>& rotationMatrix, const Eigen::Matrix<typename Twist_::Scalar, 3, 1>& translation, const Twist_& twist) {
+  typedef Eigen::Matrix<typename Twist_::Scalar, 3, 1> Vector3;
+  const Vector3& angularVelocity = twist.getRotationalVelocity().toImplementation();
+  const Vector3 linearVelocity = rotationMatrix.transpose()*(twist.getTranslationalVelocity().toImplementation() - translation.cross(angularVelocity));
+  return Twist_(typename Twist_::PositionDiff(linearVelocity), typename Twist_::RotationDiff(Vector3(rotationMatrix.transpose()*angularVelocity)));
+}
+
+/*! \brief Changes the frame of a twist in reverse, i.e. computes Ad_T^-1 * twist.
+ *  \param pose    pose T_A_B
+ *  \param twist   twist expressed in and referred to the frame A
+ *  \returns the twist expressed in and referred to the frame B
+ */
+template<typename Pose_, typename Twist_>
+inline Twist_ inverseTransformTwist(const PoseBase<Pose_>& pose, const Twist_& twist) {
+  typedef Eigen::Matrix<typename Twist_::Scalar, 3, 1> Vector3;
+  const Vector3& angularVelocity = twist.getRotationalVelocity().toImplementation();
+  const Vector3 linearVelocity = pose.derived().getRotation().inverseRotate(Vector3(twist.getTranslationalVelocity().toImplementation()
+      - pose.derived().getPosition().toImplementation().cross(angularVelocity)));
+  return Twist_(typename Twist_::PositionDiff(linearVelocity), typename Twist_::RotationDiff(pose.derived().getRotation().inverseRotate(angularVelocity)));
+}
+
+/*! \brief Changes the frame of a wrench, i.e. computes Ad_T^-T * wrench.
+ *  \param rotationMatrix   rotation matrix C of T_A_B
+ *  \param translation      translation r of T_A_B
+ *  \param wrench           wrench expressed in and referred to the frame B
+ *  \returns the wrench expressed in and referred to the frame A
+ */
+template<typename PrimType_>
+inline Wrench6<PrimType_> transformWrench(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation, const Wrench6<PrimType_>& wrench) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  const Vector3 force = rotationMatrix*wrench.getForce().toImplementation();
+  const Vector3 torque = rotationMatrix*wrench.getTorque().toImplementation() + translation.cross(force);
+  return Wrench6<PrimType_>(force, torque);
+}
+
+/*! \brief Changes the frame of a wrench, i.e. computes Ad_T^-T * wrench.
+ *  \param pose     pose T_A_B
+ *  \param wrench   wrench expressed in and referred to the frame B
+ *  \returns the wrench expressed in and referred to the frame A
+ */
+template<typename Pose_>
+inline Wrench6<typename Pose_::Scalar> transformWrench(const PoseBase<Pose_>& pose, const Wrench6<typename Pose_::Scalar>& wrench) {
+  typedef Eigen::Matrix<typename Pose_::Scalar, 3, 1> Vector3;
+  const Vector3 force = pose.derived().getRotation().rotate(wrench.getForce().toImplementation());
+  const Vector3 torque = pose.derived().getRotation().rotate(wrench.getTorque().toImplementation())
+      + pose.derived().getPosition().toImplementation().cross(force);
+  return Wrench6<typename Pose_::Scalar>(force, torque);
+}
+
+/*! \brief Changes the frame of a wrench in reverse, i.e. computes Ad_T^T * wrench.
+ *  \param rotationMatrix   rotation matrix C of T_A_B
+ *  \param translation      translation r of T_A_B
+ *  \param wrench           wrench expressed in and referred to the frame A
+ *  \returns the wrench expressed in and referred to the frame B
+ */
+template<typename PrimType_>
+inline Wrench6<PrimType_> inverseTransformWrench(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation, const Wrench6<PrimType_>& wrench) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  const Vector3& force = wrench.getForce().toImplementation();
+  const Vector3 torque = rotationMatrix.transpose()*(wrench.getTorque().toImplementation() - translation.cross(force));
+  return Wrench6<PrimType_>(Vector3(rotationMatrix.transpose()*force), torque);
+}
+
+/*! \brief Changes the frame of a wrench in reverse, i.e. computes Ad_T^T * wrench.
+ *  \param pose     pose T_A_B
+ *  \param wrench   wrench expressed in and referred to the frame A
+ *  \returns the wrench expressed in and referred to the frame B
+ */
+template<typename Pose_>
+inline Wrench6<typename Pose_::Scalar> inverseTransformWrench(const PoseBase<Pose_>& pose, const Wrench6<typename Pose_::Scalar>& wrench) {
+  typedef Eigen::Matrix<typename Pose_::Scalar, 3, 1> Vector3;
+  const Vector3& force = wrench.getForce().toImplementation();
+  const Vector3 torque = pose.derived().getRotation().inverseRotate(Vector3(wrench.getTorque().toImplementation()
+      - pose.derived().getPosition().toImplementation().cross(force)));
+  return Wrench6<typename Pose_::Scalar>(Vector3(pose.derived().getRotation().inverseRotate(force)), torque);
+}
+
+/*! \brief Spatial cross product of two motions, i.e. [v1; w1] x [v2; w2] = [w1 x v2 + v1 x w2; w1 x w2].
+ *  \param lhs   first twist
+ *  \param rhs   second twist
+ *  \returns the cross product, which is the derivative of rhs moving with the velocity lhs
+ */
+template<typename Twist_>
+inline Twist_ crossMotion(const Twist_& lhs, const Twist_& rhs) {
+  typedef Eigen::Matrix<typename Twist_::Scalar, 3, 1> Vector3;
+  const Vector3& linearVelocityLeft = lhs.getTranslationalVelocity().toImplementation();
+  const Vector3& angularVelocityLeft = lhs.getRotationalVelocity().toImplementation();
+  const Vector3 linearVelocity = angularVelocityLeft.cross(rhs.getTranslationalVelocity().toImplementation())
+      + linearVelocityLeft.cross(rhs.getRotationalVelocity().toImplementation());
+  const Vector3 angularVelocity = angularVelocityLeft.cross(rhs.getRotationalVelocity().toImplementation());
+  return Twist_(typename Twist_::PositionDiff(linearVelocity), typename Twist_::RotationDiff(angularVelocity));
+}
+
+/*! \brief Spatial cross product of a motion and a force, i.e. [v; w] x* [f; t] = [w x f; w x t + v x f].
+ *  \param twist    twist
+ *  \param wrench   wrench
+ *  \returns the cross product, which is the derivative of the wrench moving with the velocity of the twist
+ */
+template<typename Twist_>
+inline Wrench6<typename Twist_::Scalar> crossForce(const Twist_& twist, const Wrench6<typename Twist_::Scalar>& wrench) {
+  typedef Eigen::Matrix<typename Twist_::Scalar, 3, 1> Vector3;
+  const Vector3& linearVelocity = twist.getTranslationalVelocity().toImplementation();
+  const Vector3& angularVelocity = twist.getRotationalVelocity().toImplementation();
+  const Vector3& force = wrench.getForce().toImplementation();
+  return Wrench6<typename Twist_::Scalar>(Vector3(angularVelocity.cross(force)),
+                                          Vector3(angularVelocity.cross(wrench.getTorque().toImplementation()) + linearVelocity.cross(force)));
+}
+
+/*! \brief Changes the frame of the twists stored column-wise in a 6xN matrix, e.g. of a geometric Jacobian.
+ *  The output may alias the input.
+ *  \param rotationMatrix   rotation matrix C of T_A_B
+ *  \param translation      translation r of T_A_B
+ *  \param twists           6xN matrix of twists [v; w] in the frame B
+ *  \param transformed      6xN matrix of twists in the frame A
+ */
+template<typename PrimType_>
+inline void transformTwists(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation,
+                            const Eigen::Ref<const Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>>& twists,
+                            Eigen::Ref<Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>> transformed) {
+  internal::transformSpatialColumns<PrimType_>(rotationMatrix, translation, twists, transformed, false);
+}
+
+//! \brief Changes the frame of the twists stored column-wise in a 6xN matrix, see above.
+template<typename Pose_>
+inline void transformTwists(const PoseBase<Pose_>& pose,
+                            const Eigen::Ref<const Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>>& twists,
+                            Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>> transformed) {
+  internal::transformSpatialColumns<typename Pose_::Scalar>(internal::getSpatialRotationMatrix(pose), pose.derived().getPosition().toImplementation(), twists, transformed, false);
+}
+
+/*! \brief Changes the frame of the twists stored column-wise in a 6xN matrix in reverse. The output may alias the input.
+ *  \param rotationMatrix   rotation matrix C of T_A_B
+ *  \param translation      translation r of T_A_B
+ *  \param twists           6xN matrix of twists [v; w] in the frame A
+ *  \param transformed      6xN matrix of twists in the frame B
+ */
+template<typename PrimType_>
+inline void inverseTransformTwists(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation,
+                                   const Eigen::Ref<const Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>>& twists,
+                                   Eigen::Ref<Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>> transformed) {
+  internal::inverseTransformSpatialColumns<PrimType_>(rotationMatrix, translation, twists, transformed, false);
+}
+
+//! \brief Changes the frame of the twists stored column-wise in a 6xN matrix in reverse, see above.
+template<typename Pose_>
+inline void inverseTransformTwists(const PoseBase<Pose_>& pose,
+                                   const Eigen::Ref<const Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>>& twists,
+                                   Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>> transformed) {
+  internal::inverseTransformSpatialColumns<typename Pose_::Scalar>(internal::getSpatialRotationMatrix(pose), pose.derived().getPosition().toImplementation(), twists, transformed, false);
+}
+
+/*! \brief Changes the frame of the wrenches stored column-wise in a 6xN matrix. The output may alias the input.
+ *  \param rotationMatrix   rotation matrix C of T_A_B
+ *  \param translation      translation r of T_A_B
+ *  \param wrenches         6xN matrix of wrenches [f; t] in the frame B
+ *  \param transformed      6xN matrix of wrenches in the frame A
+ */
+template<typename PrimType_>
+inline void transformWrenches(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation,
+                              const Eigen::Ref<const Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>>& wrenches,
+                              Eigen::Ref<Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>> transformed) {
+  internal::transformSpatialColumns<PrimType_>(rotationMatrix, translation, wrenches, transformed, true);
+}
+
+//! \brief Changes the frame of the wrenches stored column-wise in a 6xN matrix, see above.
+template<typename Pose_>
+inline void transformWrenches(const PoseBase<Pose_>& pose,
+                              const Eigen::Ref<const Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>>& wrenches,
+                              Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>> transformed) {
+  internal::transformSpatialColumns<typename Pose_::Scalar>(internal::getSpatialRotationMatrix(pose), pose.derived().getPosition().toImplementation(), wrenches, transformed, true);
+}
+
+/*! \brief Changes the frame of the wrenches stored column-wise in a 6xN matrix in reverse. The output may alias the input.
+ *  \param rotationMatrix   rotation matrix C of T_A_B
+ *  \param translation      translation r of T_A_B
+ *  \param wrenches         6xN matrix of wrenches [f; t] in the frame A
+ *  \param transformed      6xN matrix of wrenches in the frame B
+ */
+template<typename PrimType_>
+inline void inverseTransformWrenches(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 1>& translation,
+                                     const Eigen::Ref<const Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>>& wrenches,
+                                     Eigen::Ref<Eigen::Matrix<PrimType_, 6, Eigen::Dynamic>> transformed) {
+  internal::inverseTransformSpatialColumns<PrimType_>(rotationMatrix, translation, wrenches, transformed, true);
+}
+
+//! \brief Changes the frame of the wrenches stored column-wise in a 6xN matrix in reverse, see above.
+template<typename Pose_>
+inline void inverseTransformWrenches(const PoseBase<Pose_>& pose,
+                                     const Eigen::Ref<const Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>>& wrenches,
+                                     Eigen::Ref<Eigen::Matrix<typename Pose_::Scalar, 6, Eigen::Dynamic>> transformed) {
+  internal::inverseTransformSpatialColumns<typename Pose_::Scalar>(internal::getSpatialRotationMatrix(pose), pose.derived().getPosition().toImplementation(), wrenches, transformed, true);
+}
+
+/*! \brief Rotates the twists stored column-wise in a 6xN matrix, e.g. of a body Jacobian, from the local to the global frame
+ *  in place, i.e. applies diag(C, C) without forming it. Wrenches are rotated the same way.
+ *  \param rotationLocalToGlobal   rotation C from the local frame B to the global frame I
+ *  \param twists                  6xN matrix of twists [v; w] expressed in B, overwritten by the twists expressed in I
+ */
+template<typename Rotation_>
+inline void rotateTwistsToGlobal(const RotationBase<Rotation_>& rotationLocalToGlobal,
+                                 Eigen::Ref<Eigen::Matrix<typename Rotation_::Scalar, 6, Eigen::Dynamic>> twists) {
+  typedef typename Rotation_::Scalar Scalar;
+  internal::rotateSpatialBlocks<Scalar>(RotationMatrix<Scalar>(rotationLocalToGlobal.derived()).toImplementation(), twists, true, true);
+}
+
+/*! \brief Rotates the twists stored column-wise in a 6xN matrix from the global to the local frame in place, see above.
+ *  \param rotationLocalToGlobal   rotation C from the local frame B to the global frame I
+ *  \param twists                  6xN matrix of twists [v; w] expressed in I, overwritten by the twists expressed in B
+ */
+template<typename Rotation_>
+inline void rotateTwistsToLocal(const RotationBase<Rotation_>& rotationLocalToGlobal,
+                                Eigen::Ref<Eigen::Matrix<typename Rotation_::Scalar, 6, Eigen::Dynamic>> twists) {
+  typedef typename Rotation_::Scalar Scalar;
+  internal::rotateSpatialBlocks<Scalar>(RotationMatrix<Scalar>(rotationLocalToGlobal.derived()).toImplementation().transpose(), twists, true, true);
+}
+
+/*! \brief Converts the angular velocities of the twists stored column-wise in a 6xN matrix from GlobalAngularVelocity to
+ *  LocalAngularVelocity in place and keeps the linear velocities, i.e. the block version of Twist::getVector(rotation).
+ *  \param rotationLocalToGlobal   rotation C from the local frame B to the global frame I
+ *  \param twists                  6xN matrix of twists [v; w_I], overwritten by [v; w_B]
+ */
+template<typename Rotation_>
+inline void convertTwistsToLocalAngularVelocity(const RotationBase<Rotation_>& rotationLocalToGlobal,
+                                                Eigen::Ref<Eigen::Matrix<typename Rotation_::Scalar, 6, Eigen::Dynamic>> twists) {
+  typedef typename Rotation_::Scalar Scalar;
+  internal::rotateSpatialBlocks<Scalar>(RotationMatrix<Scalar>(rotationLocalToGlobal.derived()).toImplementation().transpose(), twists, false, true);
+}
+
+/*! \brief Converts the angular velocities of the twists stored column-wise in a 6xN matrix from LocalAngularVelocity to
+ *  GlobalAngularVelocity in place and keeps the linear velocities.
+ *  \param rotationLocalToGlobal   rotation C from the local frame B to the global frame I
+ *  \param twists                  6xN matrix of twists [v; w_B], overwritten by [v; w_I]
+ */
+template<typename Rotation_>
+inline void convertTwistsToGlobalAngularVelocity(const RotationBase<Rotation_>& rotationLocalToGlobal,
+                                                 Eigen::Ref<Eigen::Matrix<typename Rotation_::Scalar, 6, Eigen::Dynamic>> twists) {
+  typedef typename Rotation_::Scalar Scalar;
+  internal::rotateSpatialBlocks<Scalar>(RotationMatrix<Scalar>(rotationLocalToGlobal.derived()).toImplementation(), twists, false, true);
+}
+
+} // namespace kindr
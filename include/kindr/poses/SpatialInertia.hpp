@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/poses/SpatialAlgebra.hpp"
+
+namespace kindr {
+
+/*! \class SpatialInertia
+ * \brief Spatial (6D) inertia of a rigid body in the compact form of mass, first moment of mass and rotational inertia.
+ *
+ *  The inertia is expressed in and referred to a frame B with the center of mass c. It stores the mass m, the first
+ *  moment of mass h = m*c and the rotational inertia about the origin of B, i.e. I_O = I_c - m*[c]x^2, which are 10
+ *  numbers instead of the 36 coefficients of the 6x6 matrix. The momentum of a body moving with the twist [v; w] is
+ *    I * [v; w] = [m*v + w x h; I_O*w + h x v],
+ *  i.e. the 6x6 matrix is [m*1, -[h]x; [h]x, I_O] in the order of the twists and wrenches of kindr, which is linear
+ *  before angular.
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \ingroup poses
+ */
+template<typename PrimType_>
+class SpatialInertia {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 6, 6> Matrix6;
+  typedef Position<PrimType_, 3> Position3;
+
+  /*! \brief Default constructor creating a zero inertia, i.e. of a massless body.
+   */
+  SpatialInertia()
+    : mass_(0),
+      firstMoment_(Vector3::Zero()),
+      rotationalInertia_(Matrix3::Zero()) {
+  }
+
+  /*! \brief Constructor using the mass properties about the center of mass.
+   *  \param mass                                mass m
+   *  \param centerOfMass                        center of mass c in the frame B
+   *  \param rotationalInertiaAtCenterOfMass     rotational inertia I_c about the center of mass, expressed in B
+   */
+  SpatialInertia(Scalar mass, const Position3& centerOfMass, const Matrix3& rotationalInertiaAtCenterOfMass)
+    : mass_(mass),
+      firstMoment_(mass*centerOfMass.toImplementation()) {
+    const Matrix3 skew = getSkewMatrixFromVector(centerOfMass.toImplementation());
+    rotationalInertia_ = rotationalInertiaAtCenterOfMass - mass*skew*skew;
+  }
+
+  /*! \brief Creates an inertia from the compact form.
+   *  \param mass                 mass m
+   *  \param firstMoment          first moment of mass h = m*c
+   *  \param rotationalInertia    rotational inertia I_O about the origin of B
+   *  \returns inertia
+   */
+  static SpatialInertia fromFirstMoment(Scalar mass, const Vector3& firstMoment, const Matrix3& rotationalInertia) {
+    SpatialInertia inertia;
+    inertia.mass_ = mass;
+    inertia.firstMoment_ = firstMoment;
+    inertia.rotationalInertia_ = rotationalInertia;
+    return inertia;
+  }
+
+  inline Scalar getMass() const {
+    return mass_;
+  }
+
+  inline const Vector3& getFirstMoment() const {
+    return firstMoment_;
+  }
+
+  /*! \brief Gets the rotational inertia about the origin of the frame.
+   *  \returns rotational inertia I_O
+   */
+  inline const Matrix3& getRotationalInertia() const {
+    return rotationalInertia_;
+  }
+
+  /*! \brief Gets the center of mass. The mass must not be zero.
+   *  \returns center of mass c
+   */
+  Position3 getCenterOfMass() const {
+    KINDR_ASSERT_TRUE(std::runtime_error, mass_ > Scalar(0), "The center of mass of a massless body is undefined.");
+    return Position3(firstMoment_/mass_);
+  }
+
+  /*! \brief Gets the rotational inertia about the center of mass. The mass must not be zero.
+   *  \returns rotational inertia I_c
+   */
+  Matrix3 getRotationalInertiaAtCenterOfMass() const {
+    const Matrix3 skew = getSkewMatrixFromVector(getCenterOfMass().toImplementation());
+    return rotationalInertia_ + mass_*skew*skew;
+  }
+
+  /*! \brief Gets the 6x6 matrix [m*1, -[h]x; [h]x, I_O].
+   *  \returns matrix
+   */
+  Matrix6 getMatrix() const {
+    const Matrix3 skew = getSkewMatrixFromVector(firstMoment_);
+    Matrix6 matrix;
+    matrix.template topLeftCorner<3, 3>() = mass_*Matrix3::Identity();
+    matrix.template topRightCorner<3, 3>() = -skew;
+    matrix.template bottomLeftCorner<3, 3>() = skew;
+    matrix.template bottomRightCorner<3, 3>() = rotationalInertia_;
+    return matrix;
+  }
+
+  /*! \brief Computes the momentum [m*v + w x h; I_O*w + h x v] of the linear and angular velocity v and w.
+   *  \param linearVelocity    linear velocity v
+   *  \param angularVelocity   angular velocity w
+   *  \param linearMomentum    linear momentum
+   *  \param angularMomentum   angular momentum about the origin of B
+   */
+  inline void multiply(const Vector3& linearVelocity, const Vector3& angularVelocity, Vector3& linearMomentum, Vector3& angularMomentum) const {
+    linearMomentum = mass_*linearVelocity + angularVelocity.cross(firstMoment_);
+    angularMomentum.noalias() = rotationalInertia_*angularVelocity;
+    angularMomentum += firstMoment_.cross(linearVelocity);
+  }
+
+  /*! \brief Multiplies the inertia with a twist or a spatial acceleration.
+   *  \param twist   twist [v; w] with an angular velocity as rotational part, expressed in and referred to B
+   *  \returns the momentum or the force [f; t] as wrench
+   */
+  template<typename Twist_>
+  Wrench6<PrimType_> operator *(const Twist_& twist) const {
+    Vector3 force, torque;
+    multiply(twist.getTranslationalVelocity().toImplementation(), twist.getRotationalVelocity().toImplementation(), force, torque);
+    return Wrench6<PrimType_>(force, torque);
+  }
+
+  /*! \brief Computes the kinetic energy of the body moving with a twist.
+   *  \param twist   twist [v; w] expressed in and referred to B
+   *  \returns kinetic energy 1/2*[v; w]^T*I*[v; w]
+   */
+  template<typename Twist_>
+  Scalar getKineticEnergy(const Twist_& twist) const {
+    return Scalar(0.5)*(*this*twist).getVector().dot(twist.getVector());
+  }
+
+  /*! \brief Addition of two inertias of rigidly connected bodies expressed in the same frame.
+   *  \returns sum
+   */
+  SpatialInertia operator +(const SpatialInertia& other) const {
+    return fromFirstMoment(mass_ + other.mass_, firstMoment_ + other.firstMoment_, rotationalInertia_ + other.rotationalInertia_);
+  }
+
+  /*! \brief Addition and assignment of an inertia expressed in the same frame.
+   *  \returns reference
+   */
+  SpatialInertia& operator +=(const SpatialInertia& other) {
+    mass_ += other.mass_;
+    firstMoment_ += other.firstMoment_;
+    rotationalInertia_ += other.rotationalInertia_;
+    return *this;
+  }
+
+  /*! \brief Changes the frame of the inertia.
+   *
+   *  The inertia of the frame A is X^T*I*X with the motion transformation X = Ad_T^-1 of T_A_B. The rotated moment is
+   *  h' = C*h and the inertia is I_O' = C*I_O*C^T - [r]x*[h']x - [h' + m*r]x*[r]x.
+   *  \param rotationMatrix   rotation matrix C of T_A_B
+   *  \param translation      translation r of T_A_B
+   *  \returns the inertia expressed in and referred to the frame A
+   */
+  SpatialInertia transform(const Matrix3& rotationMatrix, const Vector3& translation) const {
+    const Vector3 rotatedFirstMoment = rotationMatrix*firstMoment_;
+    const Vector3 firstMoment = rotatedFirstMoment + mass_*translation;
+    const Matrix3 skewTranslation = getSkewMatrixFromVector(translation);
+    Matrix3 rotationalInertia = rotationMatrix*rotationalInertia_*rotationMatrix.transpose();
+    rotationalInertia.noalias() -= skewTranslation*getSkewMatrixFromVector(rotatedFirstMoment);
+    rotationalInertia.noalias() -= getSkewMatrixFromVector(firstMoment)*skewTranslation;
+    return fromFirstMoment(mass_, firstMoment, rotationalInertia);
+  }
+
+  /*! \brief Changes the frame of the inertia in reverse.
+   *  \param rotationMatrix   rotation matrix C of T_A_B
+   *  \param translation      translation r of T_A_B
+   *  \returns the inertia of the frame A expressed in and referred to the frame B
+   */
+  SpatialInertia inverseTransform(const Matrix3& rotationMatrix, const Vector3& translation) const {
+    return transform(rotationMatrix.transpose(), Vector3(-rotationMatrix.transpose()*translation));
+  }
+
+ private:
+  Scalar mass_;
+  Vector3 firstMoment_;
+  Matrix3 rotationalInertia_;
+};
+
+typedef SpatialInertia<double> SpatialInertiaD;
+typedef SpatialInertia<float> SpatialInertiaF;
+
+
+/*! \brief Changes the frame of a spatial inertia, see SpatialInertia::transform().
+ *  \param pose      pose T_A_B
+ *  \param inertia   inertia expressed in and referred to the frame B
+ *  \returns the inertia expressed in and referred to the frame A
+ */
+template<typename Pose_>
+inline SpatialInertia<typename Pose_::Scalar> transformInertia(const PoseBase<Pose_>& pose, const SpatialInertia<typename Pose_::Scalar>& inertia) {
+  return inertia.transform(internal::getSpatialRotationMatrix(pose), pose.derived().getPosition().toImplementation());
+}
+
+/*! \brief Changes the frame of a spatial inertia in reverse, see SpatialInertia::inverseTransform().
+ *  \param pose      pose T_A_B
+ *  \param inertia   inertia expressed in and referred to the frame A
+ *  \returns the inertia expressed in and referred to the frame B
+ */
+template<typename Pose_>
+inline SpatialInertia<typename Pose_::Scalar> inverseTransformInertia(const PoseBase<Pose_>& pose, const SpatialInertia<typename Pose_::Scalar>& inertia) {
+  return inertia.inverseTransform(internal::getSpatialRotationMatrix(pose), pose.derived().getPosition().toImplementation());
+}
+
+/*! \brief Computes the velocity-dependent bias force v x* I*v, i.e. the Coriolis and centrifugal terms of the
+ *  Newton-Euler equation.
+ *  \param inertia   inertia of the body
+ *  \param twist     twist v of the body
+ *  \returns the bias force, expressed in and referred to the frame of the inertia
+ */
+template<typename Twist_>
+inline Wrench6<typename Twist_::Scalar> getBiasWrench(const SpatialInertia<typename Twist_::Scalar>& inertia, const Twist_& twist) {
+  return crossForce(twist, Wrench6<typename Twist_::Scalar>(inertia*twist));
+}
+
+/*! \brief Computes the net force I*a + v x* I*v which accelerates a rigid body, i.e. the Newton-Euler equation in
+ *  spatial form.
+ *  \param inertia        inertia of the body
+ *  \param twist          twist v of the body
+ *  \param acceleration   spatial acceleration a of the body, i.e. the derivative of the twist in the body frame
+ *  \returns the net force acting on the body, expressed in and referred to the frame of the inertia
+ */
+template<typename Twist_>
+inline Wrench6<typename Twist_::Scalar> getNetWrench(const SpatialInertia<typename Twist_::Scalar>& inertia, const Twist_& twist, const Twist_& acceleration) {
+  return inertia*acceleration + getBiasWrench(inertia, twist);
+}
+
+} // namespace kindr
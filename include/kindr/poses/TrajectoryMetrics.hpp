@@ -0,0 +1,508 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include <Eigen/Core>
+#include <Eigen/SVD>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/poses/PoseArray.hpp"
+
+namespace kindr {
+
+/*! \brief Degrees of freedom of a trajectory alignment.
+ *  \ingroup poses
+ */
+enum class AlignmentType {
+  Rigid,      ///< rotation and translation, for trajectories with metric scale
+  Similarity  ///< rotation, translation and scale, e.g. for monocular visual odometry
+};
+
+
+/*! \class TrajectoryAlignment
+ *  \brief Similarity transformation p -> s*C*p + r which aligns an estimated trajectory with a reference trajectory.
+ *
+ *  A pose T_W_B of the estimated trajectory is mapped to the pose with the position s*C*r_W_B + r and the rotation C*C_W_B.
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class TrajectoryAlignment {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<PrimType_> Rotation;
+  typedef kindr::Position<PrimType_, 3> Position;
+
+  /*! \brief Default constructor using the identity.
+   */
+  TrajectoryAlignment()
+    : scale_(Scalar(1)) {
+  }
+
+  /*! \brief Constructor.
+   *  \param rotation      rotation C
+   *  \param translation   translation r
+   *  \param scale         positive scale s
+   */
+  TrajectoryAlignment(const Rotation& rotation, const Position& translation, Scalar scale = Scalar(1))
+    : rotation_(rotation),
+      translation_(translation),
+      scale_(scale) {
+  }
+
+  inline const Rotation& getRotation() const {
+    return rotation_;
+  }
+
+  inline const Position& getTranslation() const {
+    return translation_;
+  }
+
+  inline Scalar getScale() const {
+    return scale_;
+  }
+
+  /*! \brief Gets the inverse alignment, which maps the reference trajectory onto the estimated trajectory.
+   *  \returns p -> 1/s*C^T*(p - r)
+   */
+  TrajectoryAlignment inverted() const {
+    const Rotation inverseRotation = rotation_.inverted();
+    return TrajectoryAlignment(inverseRotation, Position(-inverseRotation.rotate(translation_.toImplementation())/scale_), Scalar(1)/scale_);
+  }
+
+  /*! \brief Aligns a position.
+   *  \param position   position of the estimated trajectory
+   *  \returns s*C*position + r
+   */
+  Position transform(const Position& position) const {
+    return Position(scale_*rotation_.rotate(position.toImplementation()) + translation_.toImplementation());
+  }
+
+  /*! \brief Aligns a batch of poses without allocating memory if the result has the correct size.
+   *  \param poses      poses of the estimated trajectory
+   *  \param aligned    the aligned poses, must not be the input
+   *  \param executor   executor distributing chunks of poses to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void transform(const PoseArray<PrimType_>& poses, PoseArray<PrimType_>& aligned, const Executor_& executor = Executor_()) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, &aligned != &poses, "The aligned poses must not be the input.");
+    aligned.resize(poses.size());
+    const Eigen::Matrix<PrimType_, 3, 3> scaledRotation = getScaledRotationMatrix();
+    const Eigen::Matrix<PrimType_, 4, 4> leftProduct = getLeftProductMatrix();
+    const Eigen::Matrix<PrimType_, 3, 1> translation = translation_.toImplementation();
+    const auto& positions = poses.getPositions().toImplementation();
+    const auto& quaternions = poses.getRotations().toImplementation();
+    auto& alignedPositions = aligned.getPositions().toImplementation();
+    auto& alignedQuaternions = aligned.getRotations().toImplementation();
+    executor.parallelFor(0, poses.size(), GrainSize, [&](int begin, int end) {
+      const int length = end - begin;
+      alignedPositions.middleCols(begin, length).noalias() = scaledRotation*positions.middleCols(begin, length);
+      alignedPositions.middleCols(begin, length).colwise() += translation;
+      alignedQuaternions.middleCols(begin, length).noalias() = leftProduct*quaternions.middleCols(begin, length);
+    });
+  }
+
+  //! \returns the matrix s*C
+  Eigen::Matrix<PrimType_, 3, 3> getScaledRotationMatrix() const {
+    return scale_*RotationMatrix<PrimType_>(rotation_).matrix();
+  }
+
+  //! \returns the matrix of the Hamilton product C*q as matrix product with the quaternions q = [w; x; y; z]
+  Eigen::Matrix<PrimType_, 4, 4> getLeftProductMatrix() const {
+    const PrimType_ w = rotation_.w(), x = rotation_.x(), y = rotation_.y(), z = rotation_.z();
+    Eigen::Matrix<PrimType_, 4, 4> leftProduct;
+    leftProduct << w, -x, -y, -z,
+                   x,  w, -z,  y,
+                   y,  z,  w, -x,
+                   z, -y,  x,  w;
+    return leftProduct;
+  }
+
+  //! Minimum number of poses of a chunk that is handed to an executor
+  enum { GrainSize = 8192 };
+
+ private:
+  Rotation rotation_;
+  Position translation_;
+  Scalar scale_;
+};
+
+
+/*! \brief Statistics of the errors of a trajectory.
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+struct TrajectoryErrorStatistics {
+  typedef PrimType_ Scalar;
+
+  int size = 0;
+  Scalar rmse = Scalar(0);
+  Scalar mean = Scalar(0);
+  Scalar median = Scalar(0);
+  Scalar standardDeviation = Scalar(0);
+  Scalar minimum = Scalar(0);
+  Scalar maximum = Scalar(0);
+
+  /*! \brief Computes the statistics of errors.
+   *  \param errors   errors
+   *  \returns statistics, zero if there are no errors
+   */
+  static TrajectoryErrorStatistics compute(const Eigen::Ref<const Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>>& errors) {
+    TrajectoryErrorStatistics statistics;
+    statistics.size = static_cast<int>(errors.size());
+    if (statistics.size == 0) {
+      return statistics;
+    }
+    const Scalar count = static_cast<Scalar>(statistics.size);
+    statistics.rmse = std::sqrt(errors.squaredNorm()/count);
+    statistics.mean = errors.sum()/count;
+    statistics.standardDeviation = std::sqrt((errors.array() - statistics.mean).square().sum()/count);
+    statistics.minimum = errors.minCoeff();
+    statistics.maximum = errors.maxCoeff();
+    Eigen::Matrix<PrimType_, Eigen::Dynamic, 1> sorted = errors;
+    const int middle = statistics.size/2;
+    std::nth_element(sorted.data(), sorted.data() + middle, sorted.data() + statistics.size);
+    statistics.median = sorted(middle);
+    if (statistics.size % 2 == 0) {
+      statistics.median = (statistics.median + *std::max_element(sorted.data(), sorted.data() + middle))/Scalar(2);
+    }
+    return statistics;
+  }
+};
+
+
+/*! \brief Translation and rotation errors of the poses or of the relative motions of a trajectory.
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+struct TrajectoryError {
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, 1> VectorX;
+
+  //! norms of the translation errors
+  VectorX translationErrors;
+  //! angles of the rotation errors in [0,pi]
+  VectorX rotationErrors;
+
+  inline int size() const {
+    return static_cast<int>(translationErrors.size());
+  }
+
+  TrajectoryErrorStatistics<PrimType_> getTranslationStatistics() const {
+    return TrajectoryErrorStatistics<PrimType_>::compute(translationErrors);
+  }
+
+  TrajectoryErrorStatistics<PrimType_> getRotationStatistics() const {
+    return TrajectoryErrorStatistics<PrimType_>::compute(rotationErrors);
+  }
+};
+
+
+/*! \brief Pairs of poses (first[k], second[k]) of a trajectory over which relative errors are computed.
+ *  \ingroup poses
+ */
+struct TrajectoryPairs {
+  Eigen::VectorXi first;
+  Eigen::VectorXi second;
+
+  inline int size() const {
+    return static_cast<int>(first.size());
+  }
+
+  /*! \brief Gets the pairs which are a fixed number of samples apart, e.g. the consecutive samples for the drift per frame.
+   *  \param size     number of poses of the trajectory
+   *  \param delta    positive number of samples between the poses of a pair
+   *  \param stride   positive number of samples between the first poses of consecutive pairs
+   *  \returns pairs (i, i+delta)
+   */
+  static TrajectoryPairs fromSamples(int size, int delta, int stride = 1) {
+    KINDR_ASSERT_TRUE(std::runtime_error, delta > 0 && stride > 0, "The delta and the stride must be positive.");
+    TrajectoryPairs pairs;
+    const int count = (size > delta) ? (size - delta - 1)/stride + 1 : 0;
+    pairs.first = Eigen::VectorXi::LinSpaced(count, 0, (count - 1)*stride);
+    pairs.second = pairs.first.array() + delta;
+    return pairs;
+  }
+
+  /*! \brief Gets the pairs which are a time interval apart.
+   *  \param times      non-decreasing times of the poses
+   *  \param duration   positive duration of the interval
+   *  \param stride     positive number of samples between the first poses of consecutive pairs
+   *  \returns pairs (i, j) with the first time j with times[j] >= times[i] + duration
+   */
+  template<typename Derived_>
+  static TrajectoryPairs fromTimes(const Eigen::MatrixBase<Derived_>& times, typename Derived_::Scalar duration, int stride = 1) {
+    KINDR_ASSERT_TRUE(std::runtime_error, duration > 0 && stride > 0, "The duration and the stride must be positive.");
+    return fromOffsets([&times](int i) { return times(i); }, static_cast<int>(times.size()), duration, stride);
+  }
+
+  /*! \brief Gets the pairs which are a travelled distance apart, i.e. the segments of the KITTI odometry benchmark.
+   *  \param positions   positions of the reference trajectory
+   *  \param distance    positive length of the path between the poses of a pair
+   *  \param stride      positive number of samples between the first poses of consecutive pairs
+   *  \returns pairs (i, j) with the first j with a path length from i of at least distance
+   */
+  template<typename PrimType_>
+  static TrajectoryPairs fromDistances(const PositionArray<PrimType_>& positions, PrimType_ distance, int stride = 1) {
+    KINDR_ASSERT_TRUE(std::runtime_error, distance > 0 && stride > 0, "The distance and the stride must be positive.");
+    const int size = positions.size();
+    Eigen::Matrix<PrimType_, Eigen::Dynamic, 1> pathLengths(size);
+    if (size > 0) {
+      pathLengths(0) = PrimType_(0);
+      for (int i = 1; i < size; ++i) {
+        pathLengths(i) = pathLengths(i - 1) + (positions.toImplementation().col(i) - positions.toImplementation().col(i - 1)).norm();
+      }
+    }
+    return fromOffsets([&pathLengths](int i) { return pathLengths(i); }, size, distance, stride);
+  }
+
+ private:
+  //! Pairs each sample i with the first sample j with offset(j) >= offset(i) + delta of a non-decreasing offset
+  template<typename Offset_, typename Scalar_>
+  static TrajectoryPairs fromOffsets(const Offset_& offset, int size, Scalar_ delta, int stride) {
+    std::vector<int> first;
+    std::vector<int> second;
+    int j = 0;
+    for (int i = 0; i < size; i += stride) {
+      j = std::max(j, i + 1);
+      while (j < size && offset(j) < offset(i) + delta) {
+        ++j;
+      }
+      if (j == size) {
+        break;
+      }
+      first.push_back(i);
+      second.push_back(j);
+    }
+    TrajectoryPairs pairs;
+    pairs.first = Eigen::Map<const Eigen::VectorXi>(first.data(), first.size());
+    pairs.second = Eigen::Map<const Eigen::VectorXi>(second.data(), second.size());
+    return pairs;
+  }
+};
+
+
+namespace internal {
+
+/*! \brief Computes the distances of the positions and the disparity angles of the rotations of aligned poses and reference poses.
+ *  The distance and the disparity angle are the translation and the rotation of T_ref^-1*T_aligned, such that the errors
+ *  are computed without composing the poses, in blocks of which the aligned poses stay on the stack.
+ */
+template<typename PrimType_, typename Executor_>
+void getPoseErrors(const TrajectoryAlignment<PrimType_>& alignment, const PoseArray<PrimType_>& estimated, const PoseArray<PrimType_>& reference,
+                   TrajectoryError<PrimType_>& result, const Executor_& executor) {
+  enum { BlockSize = 128 };
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic, Eigen::RowMajor, 3, BlockSize> PositionBlock;
+  typedef Eigen::Matrix<PrimType_, 4, Eigen::Dynamic, Eigen::RowMajor, 4, BlockSize> QuaternionBlock;
+  typedef Eigen::Array<PrimType_, 1, Eigen::Dynamic, Eigen::RowMajor, 1, BlockSize> BlockRow;
+  KINDR_ASSERT_TRUE(std::runtime_error, estimated.size() == reference.size(), "The trajectories have different sizes.");
+  const Eigen::Matrix<PrimType_, 3, 3> scaledRotation = alignment.getScaledRotationMatrix();
+  const Eigen::Matrix<PrimType_, 4, 4> leftProduct = alignment.getLeftProductMatrix();
+  const Eigen::Matrix<PrimType_, 3, 1> translation = alignment.getTranslation().toImplementation();
+  const auto& positions = estimated.getPositions().toImplementation();
+  const auto& quaternions = estimated.getRotations().toImplementation();
+  const auto& referencePositions = reference.getPositions().toImplementation();
+  const auto& referenceQuaternions = reference.getRotations().toImplementation();
+  result.translationErrors.resize(estimated.size());
+  result.rotationErrors.resize(estimated.size());
+  executor.parallelFor(0, estimated.size(), TrajectoryAlignment<PrimType_>::GrainSize, [&](int begin, int end) {
+    for (int start = begin; start < end; start += BlockSize) {
+      const int length = std::min<int>(BlockSize, end - start);
+      PositionBlock alignedPositions = scaledRotation*positions.middleCols(start, length);
+      alignedPositions.colwise() += translation;
+      result.translationErrors.segment(start, length) = (alignedPositions - referencePositions.middleCols(start, length)).colwise().norm().transpose();
+      // the disparity angle 4*asin(chord/2) from the chord between the quaternions, see DisparityAngleTraits
+      const QuaternionBlock alignedQuaternions = leftProduct*quaternions.middleCols(start, length);
+      const auto referenceBlock = referenceQuaternions.middleCols(start, length);
+      const BlockRow dot = alignedQuaternions.cwiseProduct(referenceBlock).colwise().sum().array();
+      const BlockRow difference = (alignedQuaternions - referenceBlock).colwise().squaredNorm().array();
+      const BlockRow sum = (alignedQuaternions + referenceBlock).colwise().squaredNorm().array();
+      const BlockRow chord = (dot < PrimType_(0)).select(sum, difference).sqrt();
+      result.rotationErrors.segment(start, length) = (PrimType_(4)*(PrimType_(0.5)*chord).min(PrimType_(1)).asin()).matrix().transpose();
+    }
+  });
+}
+
+//! Mean and covariance of corresponding positions, the chunks of an executor are accumulated separately and summed afterwards
+template<typename PrimType_, typename Executor_>
+void accumulateCorrespondences(const PositionArray<PrimType_>& source, const PositionArray<PrimType_>& target, const Executor_& executor,
+                               Eigen::Matrix<PrimType_, 3, 1>& sourceMean, Eigen::Matrix<PrimType_, 3, 1>& targetMean,
+                               Eigen::Matrix<PrimType_, 3, 3>& covariance, PrimType_& sourceVariance) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  enum { BlockSize = 128 };
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic, Eigen::RowMajor, 3, BlockSize> PositionBlock;
+  const auto& x = source.toImplementation();
+  const auto& y = target.toImplementation();
+  const PrimType_ count = static_cast<PrimType_>(source.size());
+  std::mutex mutex;
+  sourceMean.setZero();
+  targetMean.setZero();
+  executor.parallelFor(0, source.size(), TrajectoryAlignment<PrimType_>::GrainSize, [&](int begin, int end) {
+    const Vector3 sourceSum = x.middleCols(begin, end - begin).rowwise().sum();
+    const Vector3 targetSum = y.middleCols(begin, end - begin).rowwise().sum();
+    std::lock_guard<std::mutex> lock(mutex);
+    sourceMean += sourceSum;
+    targetMean += targetSum;
+  });
+  sourceMean /= count;
+  targetMean /= count;
+  // a second pass over the centered positions avoids the cancellation of sum(y*x^T) - n*my*mx^T
+  covariance.setZero();
+  sourceVariance = PrimType_(0);
+  executor.parallelFor(0, source.size(), TrajectoryAlignment<PrimType_>::GrainSize, [&](int begin, int end) {
+    Eigen::Matrix<PrimType_, 3, 3> partialCovariance = Eigen::Matrix<PrimType_, 3, 3>::Zero();
+    PrimType_ partialVariance = PrimType_(0);
+    for (int start = begin; start < end; start += BlockSize) {
+      const int length = std::min<int>(BlockSize, end - start);
+      const PositionBlock centeredSource = x.middleCols(start, length).colwise() - sourceMean;
+      const PositionBlock centeredTarget = y.middleCols(start, length).colwise() - targetMean;
+      // dot products of the contiguous rows
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          partialCovariance(i, j) += centeredTarget.row(i).dot(centeredSource.row(j));
+        }
+      }
+      partialVariance += centeredSource.squaredNorm();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    covariance += partialCovariance;
+    sourceVariance += partialVariance;
+  });
+  covariance /= count;
+  sourceVariance /= count;
+}
+
+} // namespace internal
+
+
+/*! \brief Computes the alignment which minimizes the squared distances between corresponding positions.
+ *  Closed-form least-squares solution of Umeyama (Least-squares estimation of transformation parameters between two
+ *  point patterns, 1991), which is equivalent to the quaternion solution of Horn for rigid alignments.
+ *  \param estimated   positions of the estimated trajectory
+ *  \param reference   corresponding positions of the reference trajectory, with the same size
+ *  \param type        degrees of freedom of the alignment
+ *  \param executor    executor distributing chunks of positions to threads, see SerialExecutor
+ *  \returns alignment mapping the estimated positions onto the reference positions
+ *  \ingroup poses
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+TrajectoryAlignment<PrimType_> alignTrajectories(const PositionArray<PrimType_>& estimated, const PositionArray<PrimType_>& reference,
+                                                 AlignmentType type = AlignmentType::Rigid, const Executor_& executor = Executor_()) {
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  KINDR_ASSERT_TRUE(std::runtime_error, estimated.size() == reference.size(), "The trajectories have different sizes.");
+  KINDR_ASSERT_TRUE(std::runtime_error, estimated.size() > 0, "The trajectories are empty.");
+  Eigen::Matrix<PrimType_, 3, 1> estimatedMean, referenceMean;
+  Matrix3 covariance;
+  PrimType_ estimatedVariance;
+  internal::accumulateCorrespondences(estimated, reference, executor, estimatedMean, referenceMean, covariance, estimatedVariance);
+
+  const Eigen::JacobiSVD<Matrix3> svd(covariance, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  // a reflection is replaced by the closest rotation
+  Eigen::Matrix<PrimType_, 3, 1> signs = Eigen::Matrix<PrimType_, 3, 1>::Ones();
+  if (svd.matrixU().determinant()*svd.matrixV().determinant() < PrimType_(0)) {
+    signs(2) = PrimType_(-1);
+  }
+  const Matrix3 rotation = svd.matrixU()*signs.asDiagonal()*svd.matrixV().transpose();
+  PrimType_ scale = PrimType_(1);
+  if (type == AlignmentType::Similarity) {
+    KINDR_ASSERT_TRUE(std::runtime_error, estimatedVariance > PrimType_(0), "The scale of a trajectory without motion is undefined.");
+    scale = svd.singularValues().dot(signs)/estimatedVariance;
+  }
+  const kindr::Position<PrimType_, 3> translation(referenceMean - scale*rotation*estimatedMean);
+  return TrajectoryAlignment<PrimType_>(RotationQuaternion<PrimType_>(RotationMatrix<PrimType_>(rotation)), translation, scale);
+}
+
+/*! \brief Computes the alignment of the positions of two trajectories, see alignTrajectories() for positions.
+ *  \ingroup poses
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+TrajectoryAlignment<PrimType_> alignTrajectories(const PoseArray<PrimType_>& estimated, const PoseArray<PrimType_>& reference,
+                                                 AlignmentType type = AlignmentType::Rigid, const Executor_& executor = Executor_()) {
+  return alignTrajectories(estimated.getPositions(), reference.getPositions(), type, executor);
+}
+
+/*! \brief Computes the absolute trajectory error (ATE), i.e. the errors of the aligned estimated poses.
+ *  The error of a pose is T_ref^-1*T_aligned, the position error is the distance of the positions.
+ *  \param estimated   poses of the estimated trajectory
+ *  \param reference   corresponding poses of the reference trajectory, with the same size
+ *  \param alignment   alignment of the estimated trajectory, see alignTrajectories()
+ *  \param executor    executor distributing chunks of poses to threads, see SerialExecutor
+ *  \returns errors per pose
+ *  \ingroup poses
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+TrajectoryError<PrimType_> computeAbsoluteTrajectoryError(const PoseArray<PrimType_>& estimated, const PoseArray<PrimType_>& reference,
+                                                          const TrajectoryAlignment<PrimType_>& alignment, const Executor_& executor = Executor_()) {
+  TrajectoryError<PrimType_> result;
+  internal::getPoseErrors(alignment, estimated, reference, result, executor);
+  return result;
+}
+
+/*! \brief Aligns the trajectories and computes the absolute trajectory error (ATE).
+ *  \param estimated   poses of the estimated trajectory
+ *  \param reference   corresponding poses of the reference trajectory, with the same size
+ *  \param type        degrees of freedom of the alignment
+ *  \param executor    executor distributing chunks of poses to threads, see SerialExecutor
+ *  \returns errors per pose
+ *  \ingroup poses
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+TrajectoryError<PrimType_> computeAbsoluteTrajectoryError(const PoseArray<PrimType_>& estimated, const PoseArray<PrimType_>& reference,
+                                                          AlignmentType type, const Executor_& executor = Executor_()) {
+  return computeAbsoluteTrajectoryError(estimated, reference, alignTrajectories(estimated, reference, type, executor), executor);
+}
+
+/*! \brief Computes the relative pose error (RPE), i.e. the errors of the motions of the estimated trajectory between pairs of poses.
+ *  The error of a pair (i, j) is (T_ref_i^-1*T_ref_j)^-1*(T_est_i^-1*T_est_j), which does not depend on an alignment.
+ *  \param estimated   poses of the estimated trajectory
+ *  \param reference   corresponding poses of the reference trajectory, with the same size
+ *  \param pairs       pairs of poses, see TrajectoryPairs
+ *  \param executor    executor distributing chunks of pairs to threads, see SerialExecutor
+ *  \returns errors per pair
+ *  \ingroup poses
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+TrajectoryError<PrimType_> computeRelativePoseError(const PoseArray<PrimType_>& estimated, const PoseArray<PrimType_>& reference,
+                                                    const TrajectoryPairs& pairs, const Executor_& executor = Executor_()) {
+  KINDR_ASSERT_TRUE(std::runtime_error, estimated.size() == reference.size(), "The trajectories have different sizes.");
+  PoseArray<PrimType_> estimatedMotions, referenceMotions;
+  estimated.getRelativePoses(pairs.first, pairs.second, estimatedMotions, executor);
+  reference.getRelativePoses(pairs.first, pairs.second, referenceMotions, executor);
+  TrajectoryError<PrimType_> result;
+  internal::getPoseErrors(TrajectoryAlignment<PrimType_>(), estimatedMotions, referenceMotions, result, executor);
+  return result;
+}
+
+} // namespace kindr
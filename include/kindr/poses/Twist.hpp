@@ -37,8 +37,13 @@
 namespace kindr {
 
 template<typename PrimType_, typename PositionDiff_, typename RotationDiff_>
-class Twist : public PoseDiffBase<Twist<PrimType_, PositionDiff_, RotationDiff_> >, private PositionDiff_, private RotationDiff_ {
+class Twist : public PoseDiffBase<Twist<PrimType_, PositionDiff_, RotationDiff_> > {
+ protected:
+  //! The translational and the rotational velocity are consecutive members, see getVectorMap()
+  PositionDiff_ positionDiff_;
+  RotationDiff_ rotationDiff_;
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
   typedef PrimType_ Scalar;
   typedef PositionDiff_ PositionDiff;
@@ -49,24 +54,41 @@ class Twist : public PoseDiffBase<Twist<PrimType_, PositionDiff_, RotationDiff_>
   Twist() = default;
 
   Twist(const PositionDiff& position, const RotationDiff& rotation) :
-    PositionDiff(position),RotationDiff(rotation) {
+    positionDiff_(position),rotationDiff_(rotation) {
   }
 
 
   inline PositionDiff_ & getTranslationalVelocity() {
-    return static_cast<PositionDiff_ &>(*this);
+    return positionDiff_;
   }
 
   inline const PositionDiff_ & getTranslationalVelocity() const {
-    return static_cast<const PositionDiff_ &>(*this);
+    return positionDiff_;
   }
 
   inline RotationDiff_ & getRotationalVelocity() {
-    return static_cast<RotationDiff_ &>(*this);
+    return rotationDiff_;
   }
 
   inline const RotationDiff_ & getRotationalVelocity() const {
-    return static_cast<const RotationDiff_ &>(*this);
+    return rotationDiff_;
+  }
+
+  /*! \brief Gets a writable view of the twist as the 6D-vector [translational velocity; rotational velocity] without copying.
+   *  Only available if both velocities are 3D vectors, which are stored contiguously.
+   *  \returns view of the twist
+   */
+  inline Eigen::Map<Vector6> getVectorMap() {
+    checkContiguousLayout();
+    return Eigen::Map<Vector6>(positionDiff_.toImplementation().data());
+  }
+
+  /*! \brief Gets a read-only view of the twist as the 6D-vector [translational velocity; rotational velocity] without copying.
+   *  \returns view of the twist
+   */
+  inline Eigen::Map<const Vector6> getVectorMap() const {
+    checkContiguousLayout();
+    return Eigen::Map<const Vector6>(positionDiff_.toImplementation().data());
   }
 
   template<typename Rotation_>
@@ -90,10 +112,20 @@ class Twist : public PoseDiffBase<Twist<PrimType_, PositionDiff_, RotationDiff_>
    *  \returns reference
    */
   Twist& setZero() {
-    PositionDiff::setZero();
-    RotationDiff::setZero();
+    positionDiff_.setZero();
+    rotationDiff_.setZero();
     return *this;
   }
+
+ private:
+  /*! \brief Consecutive members are laid out in order and padded only for alignment, hence the velocities are
+   *  contiguous if both consist of exactly three scalars aligned as scalars.
+   */
+  static void checkContiguousLayout() {
+    static_assert(sizeof(PositionDiff_) == 3*sizeof(PrimType_) && sizeof(RotationDiff_) == 3*sizeof(PrimType_),
+                  "The velocities of the twist are not both 3D vectors.");
+    static_assert(alignof(RotationDiff_) == alignof(PrimType_), "The rotational velocity may be padded.");
+  }
 };
 
 template<typename PrimType_>
@@ -155,17 +187,23 @@ class TwistLinearVelocityLocalAngularVelocity: public Twist<PrimType_,
    * @returns the twist in a 6D-vector [linear velocity, angular velocity]'
    */
   inline Vector6 getVector() const {
-    Vector6 vector = Vector6::Zero();
-    vector.template block<3,1>(0,0) = this->getTranslationalVelocity().toImplementation();
-    vector.template block<3,1>(3,0) = this->getRotationalVelocity().toImplementation();
-    return vector;
+    return this->getVectorMap();
   }
 
   /*! Sets the twist by a 6D-vector [linear velocity, angular velocity]'
    */
   inline void setVector(const Vector6& vector6) {
-    this->getTranslationalVelocity().toImplementation() = vector6.template head<3>();
-    this->getRotationalVelocity().toImplementation() = vector6.template tail<3>();
+    this->getVectorMap() = vector6;
+  }
+
+  /*! \brief Multiplies the twist with a scalar, e.g. a time step.
+   *  \param factor   factor
+   *  \returns product
+   */
+  template<typename PrimTypeFactor_>
+  TwistLinearVelocityLocalAngularVelocity operator*(PrimTypeFactor_ factor) const {
+    return TwistLinearVelocityLocalAngularVelocity(Vector3(this->getTranslationalVelocity().toImplementation()*(PrimType_)factor),
+              Vector3(this->getRotationalVelocity().toImplementation()*(PrimType_)factor));
   }
 
 };
@@ -211,17 +249,23 @@ class TwistLinearVelocityGlobalAngularVelocity: public Twist<PrimType_,
    * @returns the twist in a 6D-vector [linear velocity, angular velocity]'
    */
   inline Vector6 getVector() const {
-    Vector6 vector = Vector6::Zero();
-    vector.template block<3,1>(0,0) = this->getTranslationalVelocity().toImplementation();
-    vector.template block<3,1>(3,0) = this->getRotationalVelocity().toImplementation();
-    return vector;
+    return this->getVectorMap();
   }
 
   /*! Sets the twist by a 6D-vector [linear velocity, angular velocity]'
    */
   inline void setVector(const Vector6& vector6) {
-    this->getTranslationalVelocity().toImplementation() = vector6.template head<3>();
-    this->getRotationalVelocity().toImplementation() = vector6.template tail<3>();
+    this->getVectorMap() = vector6;
+  }
+
+  /*! \brief Multiplies the twist with a scalar, e.g. a time step.
+   *  \param factor   factor
+   *  \returns product
+   */
+  template<typename PrimTypeFactor_>
+  TwistLinearVelocityGlobalAngularVelocity operator*(PrimTypeFactor_ factor) const {
+    return TwistLinearVelocityGlobalAngularVelocity(Vector3(this->getTranslationalVelocity().toImplementation()*(PrimType_)factor),
+              Vector3(this->getRotationalVelocity().toImplementation()*(PrimType_)factor));
   }
 
 };
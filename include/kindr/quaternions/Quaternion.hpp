@@ -56,6 +56,8 @@ class Quaternion : public QuaternionBase<Quaternion<PrimType_>>, private Eigen::
  private:
   typedef Eigen::Quaternion<PrimType_> Base;
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   //! the implementation type, i.e., Eigen::Quaternion<>
   typedef Base Implementation;
   //! the scalar type, i.e., the type of the coefficients
@@ -66,7 +68,7 @@ class Quaternion : public QuaternionBase<Quaternion<PrimType_>>, private Eigen::
   typedef Eigen::Matrix<PrimType_,4,1> Vector4;
 
   //! Default constructor creates a quaternion with all coefficients equal to zero
-  Quaternion()
+  KINDR_DEVICE_FUNC Quaternion()
     : Base(Implementation(0,0,0,0)) {
   }
 
@@ -76,7 +78,7 @@ class Quaternion : public QuaternionBase<Quaternion<PrimType_>>, private Eigen::
    *  \param y     third entry of the quaternion
    *  \param z     fourth entry of the quaternion
    */
-  Quaternion(Scalar w, Scalar x, Scalar y, Scalar z)
+  KINDR_DEVICE_FUNC Quaternion(Scalar w, Scalar x, Scalar y, Scalar z)
     : Base(w,x,y,z) {
   }
 
@@ -96,7 +98,7 @@ class Quaternion : public QuaternionBase<Quaternion<PrimType_>>, private Eigen::
   }
 
   // create from Eigen::Quaternion
-  explicit Quaternion(const Base& other)
+  KINDR_DEVICE_FUNC explicit Quaternion(const Base& other)
     : Base(other) {
   }
 
@@ -163,45 +165,45 @@ class Quaternion : public QuaternionBase<Quaternion<PrimType_>>, private Eigen::
 	return *this;
   }
 
-  inline Implementation& toImplementation() {
+  KINDR_DEVICE_FUNC inline Implementation& toImplementation() {
     return static_cast<Implementation&>(*this);
   }
-  inline const Implementation& toImplementation() const {
+  KINDR_DEVICE_FUNC inline const Implementation& toImplementation() const {
     return static_cast<const Implementation&>(*this);
   }
 
   using QuaternionBase<Quaternion<PrimType_>>::operator==;
   using QuaternionBase<Quaternion<PrimType_>>::operator*;
 
-  inline Scalar w() const {
+  KINDR_DEVICE_FUNC inline Scalar w() const {
     return Base::w();
   }
 
-  inline Scalar x() const {
+  KINDR_DEVICE_FUNC inline Scalar x() const {
     return Base::x();
   }
 
-  inline Scalar y() const {
+  KINDR_DEVICE_FUNC inline Scalar y() const {
     return Base::y();
   }
 
-  inline Scalar z() const {
+  KINDR_DEVICE_FUNC inline Scalar z() const {
     return Base::z();
   }
 
-  inline Scalar& w() { // todo: attention: no assertion for unitquaternions!
+  KINDR_DEVICE_FUNC inline Scalar& w() { // todo: attention: no assertion for unitquaternions!
     return Base::w();
   }
 
-  inline Scalar& x() {
+  KINDR_DEVICE_FUNC inline Scalar& x() {
     return Base::x();
   }
 
-  inline Scalar& y() {
+  KINDR_DEVICE_FUNC inline Scalar& y() {
     return Base::y();
   }
 
-  inline Scalar& z() {
+  KINDR_DEVICE_FUNC inline Scalar& z() {
     return Base::z();
   }
 
@@ -219,7 +221,7 @@ class Quaternion : public QuaternionBase<Quaternion<PrimType_>>, private Eigen::
     return vector4;
   }
 
-  inline Scalar norm() const {
+  KINDR_DEVICE_FUNC inline Scalar norm() const {
     return Base::norm();
   }
 
@@ -293,6 +295,8 @@ class UnitQuaternion : public UnitQuaternionBase<UnitQuaternion<PrimType_>> {
   Quaternion<PrimType_> unitQuternion_;
   typedef UnitQuaternionBase<UnitQuaternion<PrimType_>> Base;
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   //! the implementation type, i.e., Eigen::Quaternion<>
   typedef typename Quaternion<PrimType_>::Implementation Implementation;
   //! the scalar type, i.e., the type of the coefficients
@@ -303,7 +307,7 @@ class UnitQuaternion : public UnitQuaternionBase<UnitQuaternion<PrimType_>> {
   typedef Eigen::Matrix<PrimType_,4,1> Vector4;
 
   //! Default Constructor initializes the unit quaternion to identity
-  UnitQuaternion()
+  KINDR_DEVICE_FUNC UnitQuaternion()
     : unitQuternion_(Implementation::Identity()) {
   }
 
@@ -314,7 +318,7 @@ class UnitQuaternion : public UnitQuaternionBase<UnitQuaternion<PrimType_>> {
    * \param   y   vector index 2
    * \param   z   vector index 3
    */
-  UnitQuaternion(Scalar w, Scalar x, Scalar y, Scalar z)
+  KINDR_DEVICE_FUNC UnitQuaternion(Scalar w, Scalar x, Scalar y, Scalar z)
     : unitQuternion_(w,x,y,z) {
     KINDR_ASSERT_SCALAR_NEAR_DBG(std::runtime_error, norm(), static_cast<Scalar>(1.0), static_cast<Scalar>(1e-2), "Input quaternion has not unit length.");
   }
@@ -348,7 +352,7 @@ class UnitQuaternion : public UnitQuaternionBase<UnitQuaternion<PrimType_>> {
   /*!
    * \param other Eigen::Quaternion
    */
-  explicit UnitQuaternion(const Implementation& other)
+  KINDR_DEVICE_FUNC explicit UnitQuaternion(const Implementation& other)
     : unitQuternion_(other) {
     KINDR_ASSERT_SCALAR_NEAR_DBG(std::runtime_error, norm(), static_cast<Scalar>(1.0), static_cast<Scalar>(1e-2), "Input quaternion has not unit length.");
   }
@@ -398,35 +402,35 @@ class UnitQuaternion : public UnitQuaternionBase<UnitQuaternion<PrimType_>> {
 //	  return this->uq == other.uq;
 //  }
 
-  inline Scalar w() const {
+  KINDR_DEVICE_FUNC inline Scalar w() const {
     return unitQuternion_.w();
   }
 
-  inline Scalar x() const {
+  KINDR_DEVICE_FUNC inline Scalar x() const {
     return unitQuternion_.x();
   }
 
-  inline Scalar y() const {
+  KINDR_DEVICE_FUNC inline Scalar y() const {
     return unitQuternion_.y();
   }
 
-  inline Scalar z() const {
+  KINDR_DEVICE_FUNC inline Scalar z() const {
     return unitQuternion_.z();
   }
 
-  inline Scalar& w() { // todo: attention: no assertion for unitquaternions!
+  KINDR_DEVICE_FUNC inline Scalar& w() { // todo: attention: no assertion for unitquaternions!
     return unitQuternion_.w();
   }
 
-  inline Scalar& x() {
+  KINDR_DEVICE_FUNC inline Scalar& x() {
     return unitQuternion_.x();
   }
 
-  inline Scalar& y() {
+  KINDR_DEVICE_FUNC inline Scalar& y() {
     return unitQuternion_.y();
   }
 
-  inline Scalar& z() {
+  KINDR_DEVICE_FUNC inline Scalar& z() {
     return unitQuternion_.z();
   }
 
@@ -470,15 +474,15 @@ class UnitQuaternion : public UnitQuaternionBase<UnitQuaternion<PrimType_>> {
 //    return UnitQuaternion(Base::conjugate());
 //  }
 
-  Scalar norm() const {
+  KINDR_DEVICE_FUNC Scalar norm() const {
     return unitQuternion_.norm();
   }
 
-  const Implementation& toImplementation() const {
+  KINDR_DEVICE_FUNC const Implementation& toImplementation() const {
     return unitQuternion_.toImplementation();
   }
 
-  Implementation& toImplementation() {
+  KINDR_DEVICE_FUNC Implementation& toImplementation() {
     return unitQuternion_.toImplementation();
   }
 
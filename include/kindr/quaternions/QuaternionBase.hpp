@@ -27,6 +27,8 @@
 */
 #pragma once
 
+#include <Eigen/Geometry>
+
 #include "kindr/common/common.hpp"
 
 namespace kindr {
@@ -51,6 +53,51 @@ class MultiplicationTraits {
   }
 };
 
+/*! \brief Fused quaternion products with conjugated operands
+ *  The operands are Eigen quaternions. Products with a conjugate use Eigen's (vectorized) product on the conjugate
+ *  expression. The sandwich product uses the closed form unless Eigen vectorizes the quaternion product for the scalar,
+ *  in which case two packet products are faster.
+ * \class FusedMultiplicationTraits
+ */
+template<typename Implementation_>
+class FusedMultiplicationTraits {
+ public:
+  typedef typename Implementation_::Scalar Scalar;
+  static constexpr bool kUseVectorizedSandwich = Eigen::internal::packet_traits<Scalar>::Vectorizable && sizeof(Scalar) == 4;
+
+  //! \returns a*conj(b)
+  template<typename Left_, typename Right_>
+  inline static Implementation_ multiplyConjugate(const Left_& a, const Right_& b) {
+    return Implementation_(a*b.conjugate());
+  }
+
+  //! \returns conj(a)*b
+  template<typename Left_, typename Right_>
+  inline static Implementation_ conjugateMultiply(const Left_& a, const Right_& b) {
+    return Implementation_(a.conjugate()*b);
+  }
+
+  /*! \returns q*p*conj(q)
+   *  With q = (s, u) and p = (t, v) this is (t*|q|^2, (s^2 - u.u)*v + 2*(u.v)*u + 2*s*(u x v)).
+   */
+  template<typename Left_, typename Right_>
+  inline static Implementation_ sandwich(const Left_& q, const Right_& p) {
+    if (kUseVectorizedSandwich) {
+      return Implementation_(q*p*q.conjugate());
+    }
+    const Scalar s = q.w(), ux = q.x(), uy = q.y(), uz = q.z();
+    const Scalar t = p.w(), vx = p.x(), vy = p.y(), vz = p.z();
+    const Scalar uu = ux*ux + uy*uy + uz*uz;
+    const Scalar a = s*s - uu;
+    const Scalar b = static_cast<Scalar>(2)*(ux*vx + uy*vy + uz*vz);
+    const Scalar c = static_cast<Scalar>(2)*s;
+    return Implementation_(t*(s*s + uu),
+                           a*vx + b*ux + c*(uy*vz - uz*vy),
+                           a*vy + b*uy + c*(uz*vx - ux*vz),
+                           a*vz + b*uz + c*(ux*vy - uy*vx));
+  }
+};
+
 //! Comparison trait to implement to compare two quaternions
 template<typename Quaternion_>
 class ComparisonTraits {
@@ -139,6 +186,33 @@ class QuaternionBase {
 //    return quat_internal::MultiplicationTraits<Derived_, OtherDerived_>::mult(this->derived(), static_cast<Derived_>(other));
 //  }
 
+  /*! \brief multiplies the quaternion with the conjugate of another quaternion
+   * \returns this*other.conjugated()
+   * \param other   other quaternion
+   */
+  template<typename OtherDerived_>
+  Derived_ multiplyConjugate(const QuaternionBase<OtherDerived_>& other) const {
+    return Derived_(quat_internal::FusedMultiplicationTraits<typename Derived_::Implementation>::multiplyConjugate(this->derived().toImplementation(), other.derived().toImplementation()));
+  }
+
+  /*! \brief multiplies the conjugate of the quaternion with another quaternion
+   * \returns this->conjugated()*other
+   * \param other   other quaternion
+   */
+  template<typename OtherDerived_>
+  Derived_ conjugateMultiply(const QuaternionBase<OtherDerived_>& other) const {
+    return Derived_(quat_internal::FusedMultiplicationTraits<typename Derived_::Implementation>::conjugateMultiply(this->derived().toImplementation(), other.derived().toImplementation()));
+  }
+
+  /*! \brief computes the sandwich product of another quaternion with this quaternion
+   * \returns (*this)*other*this->conjugated() in a single pass
+   * \param other   quaternion in the middle of the product
+   */
+  template<typename OtherDerived_>
+  OtherDerived_ sandwich(const QuaternionBase<OtherDerived_>& other) const {
+    return OtherDerived_(quat_internal::FusedMultiplicationTraits<typename OtherDerived_::Implementation>::sandwich(this->derived().toImplementation(), other.derived().toImplementation()));
+  }
+
   /*! \brief compares the quaternion with another quaternion
    * \param other   other quaternion
    * \returns true if the quaternions are equal
@@ -210,6 +284,42 @@ class UnitQuaternionBase : public QuaternionBase<Derived_> {
   OtherDerived_ operator *(const QuaternionBase<OtherDerived_>& other) const {
     return OtherDerived_(quat_internal::MultiplicationTraits<Derived_, OtherDerived_>::mult(this->derived(), other.derived()));
   }
+
+  /*! \brief multiplies the unit quaternion with the conjugate of another unit quaternion
+   * \returns this*other.conjugated()
+   * \param other   other unit quaternion
+   */
+  template<typename OtherDerived_>
+  Derived_ multiplyConjugate(const UnitQuaternionBase<OtherDerived_>& other) const {
+    return Base::multiplyConjugate(other);
+  }
+
+  /*! \brief multiplies the unit quaternion with the conjugate of a quaternion
+   * \returns this*other.conjugated()
+   * \param other   other quaternion
+   */
+  template<typename OtherDerived_>
+  OtherDerived_ multiplyConjugate(const QuaternionBase<OtherDerived_>& other) const {
+    return OtherDerived_(quat_internal::FusedMultiplicationTraits<typename OtherDerived_::Implementation>::multiplyConjugate(this->derived().toImplementation(), other.derived().toImplementation()));
+  }
+
+  /*! \brief multiplies the inverse of the unit quaternion with another unit quaternion
+   * \returns this->inverted()*other
+   * \param other   other unit quaternion
+   */
+  template<typename OtherDerived_>
+  Derived_ conjugateMultiply(const UnitQuaternionBase<OtherDerived_>& other) const {
+    return Base::conjugateMultiply(other);
+  }
+
+  /*! \brief multiplies the inverse of the unit quaternion with a quaternion
+   * \returns this->inverted()*other
+   * \param other   other quaternion
+   */
+  template<typename OtherDerived_>
+  OtherDerived_ conjugateMultiply(const QuaternionBase<OtherDerived_>& other) const {
+    return OtherDerived_(quat_internal::FusedMultiplicationTraits<typename OtherDerived_::Implementation>::conjugateMultiply(this->derived().toImplementation(), other.derived().toImplementation()));
+  }
 };
 
 
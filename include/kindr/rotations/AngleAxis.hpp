@@ -130,7 +130,7 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
    */
   template<typename OtherDerived_>
   inline explicit AngleAxis(const RotationBase<OtherDerived_>& other)
-    : angleAxis_(internal::ConversionTraits<AngleAxis, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    : angleAxis_(internal::convertRotation<AngleAxis, OtherDerived_>(other.derived()).toImplementation()) {
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -139,7 +139,7 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
    */
   template<typename OtherDerived_>
   AngleAxis& operator =(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<AngleAxis, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<AngleAxis, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -149,7 +149,7 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
    */
   template<typename OtherDerived_>
   AngleAxis& operator ()(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<AngleAxis, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<AngleAxis, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -250,33 +250,34 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
    *  \returns copy of the angle axis rotation which is unique
    */
   AngleAxis getUnique() const {
+    KINDR_INSTRUMENT(Unique);
     const Scalar anglePosNegPi = kindr::wrapPosNegPI(angle());
     AngleAxis aa(anglePosNegPi, axis()); // first wraps angle into [-pi,pi)
-    if(aa.angle() > 0.0)  {
+    if(aa.angle() > Scalar(0))  {
         return aa;
     }
-    else if(aa.angle() < 0.0) {
-      if(aa.angle() != -M_PI) {
+    else if(aa.angle() < Scalar(0)) {
+      if(aa.angle() != -Scalar(M_PI)) {
         return AngleAxis(-aa.angle(),-aa.axis());
       }
       else { // angle == -pi, so axis must be viewed further, because -pi,axis does the same as -pi,-axis
-        if(aa.axis()[0] < 0.0) {
+        if(aa.axis()[0] < Scalar(0)) {
           return AngleAxis(-aa.angle(),-aa.axis());
         }
-        else if(aa.axis()[0] > 0) {
+        else if(aa.axis()[0] > Scalar(0)) {
           return AngleAxis(-aa.angle(),aa.axis());
         }
         else { // v1 == 0
 
-          if(aa.axis()[1] < 0.0) {
+          if(aa.axis()[1] < Scalar(0)) {
             return AngleAxis(-aa.angle(),-aa.axis());
           }
-          else if(aa.axis()[1] > 0) {
+          else if(aa.axis()[1] > Scalar(0)) {
             return AngleAxis(-aa.angle(),aa.axis());
           }
           else { // v2 == 0
 
-            if(aa.axis()[2] < 0.0) { // v3 must be -1 or 1
+            if(aa.axis()[2] < Scalar(0)) { // v3 must be -1 or 1
               return AngleAxis(-aa.angle(),-aa.axis());
             }
             else  {
@@ -419,11 +420,57 @@ class ConversionTraits<AngleAxis<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>
  * Multiplication Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Map Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class MapTraits<RotationBase<AngleAxis<PrimType_>>> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  inline static AngleAxis<PrimType_> set_exponential_map(const Vector3& vector) {
+    return AngleAxis<PrimType_>(RotationVector<PrimType_>(vector));
+  }
+
+  /*! \brief Gets the unique rotation vector, which is scaled axis if the angle is in [0,pi).
+   */
+  inline static Vector3 get_logarithmic_map(const AngleAxis<PrimType_>& rotation) {
+    return RotationVector<PrimType_>(rotation).getUnique().toImplementation();
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Rotation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class RotationTraits<RotationBase<AngleAxis<PrimType_>>> : public DirectRotationTraits<AngleAxis<PrimType_>, 2> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
 
+  /*! \brief Rotates a vector with Rodrigues' formula without computing the rotation matrix.
+   *  v' = cos(a)*v + sin(a)*(n x v) + (1-cos(a))*(n.v)*n
+   */
+  inline static Vector3 rotateVector(const AngleAxis<PrimType_>& rotation, const Vector3& vector) {
+    using std::cos;
+    using std::sin;
+    const Vector3& axis = rotation.axis();
+    const PrimType_ c = cos(rotation.angle());
+    const PrimType_ s = sin(rotation.angle());
+    return c*vector + s*axis.cross(vector) + ((PrimType_(1.0)-c)*axis.dot(vector))*axis;
+  }
 
+  /*! \brief Rotates a vector by the negative angle without computing the inverse rotation.
+   *  v' = cos(a)*v - sin(a)*(n x v) + (1-cos(a))*(n.v)*n
+   */
+  inline static Vector3 inverseRotateVector(const AngleAxis<PrimType_>& rotation, const Vector3& vector) {
+    using std::cos;
+    using std::sin;
+    const Vector3& axis = rotation.axis();
+    const PrimType_ c = cos(rotation.angle());
+    const PrimType_ s = sin(rotation.angle());
+    return c*vector - s*axis.cross(vector) + ((PrimType_(1.0)-c)*axis.dot(vector))*axis;
+  }
+};
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Comparison Traits
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/rotations/EulerAnglesZyx.hpp"
+#include "kindr/rotations/EulerAnglesXyz.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+//! Number of samples below which the batch is not split
+enum { EulerAnglesRateGrainSize = 1024 };
+
+/*! \brief Applies a mapping of the rate mapping of each column of eulerAngles to the same column of input.
+ *  \param mapping   functor (rateMapping, input column) -> output column
+ */
+template<typename EulerAngles_, typename Executor_, typename Mapping_>
+inline void mapEulerAnglesRates(const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& eulerAngles,
+                                const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& input,
+                                Eigen::Ref<Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>> output,
+                                const Executor_& executor, const Mapping_& mapping) {
+  typedef typename EulerAngles_::Scalar Scalar;
+  typedef typename EulerAngles_::RateMapping RateMapping;
+  KINDR_ASSERT_TRUE(std::runtime_error, input.cols() == eulerAngles.cols() && output.cols() == eulerAngles.cols(),
+                    "The number of rates must be equal to the number of Euler angles.");
+  executor.parallelFor(0, static_cast<int>(eulerAngles.cols()), EulerAnglesRateGrainSize, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      // The angles are stored in the order of the constructor arguments of the rate mapping
+      const RateMapping rateMapping(eulerAngles(0, i), eulerAngles(1, i), eulerAngles(2, i));
+      output.col(i) = mapping(rateMapping, Eigen::Matrix<Scalar, 3, 1>(input.col(i)));
+    }
+  });
+}
+
+} // namespace internal
+
+/*! \brief Computes the local angular velocities of time derivatives of Euler angles.
+ *
+ *  The sine and cosine of each angle are evaluated once per sample and no 3x3 mapping is built.
+ *  Example:
+ *  \code{cpp}
+ *  kindr::getLocalAngularVelocitiesFromEulerAnglesDiffs<kindr::EulerAnglesZyxD>(yawPitchRoll, yawPitchRollDiffs, angularVelocities);
+ *  \endcode
+ *
+ *  \tparam EulerAngles_         EulerAnglesZyx or EulerAnglesXyz
+ *  \param eulerAngles           3xN matrix, each column are Euler angles as stored by EulerAngles_
+ *  \param eulerAnglesDiffs      3xN matrix of time derivatives of the Euler angles
+ *  \param angularVelocities     3xN matrix, the local angular velocities are written here
+ *  \param executor              executor on which the samples are split, see Executor.hpp
+ */
+template<typename EulerAngles_, typename Executor_ = SerialExecutor>
+void getLocalAngularVelocitiesFromEulerAnglesDiffs(const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& eulerAngles,
+                                                   const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& eulerAnglesDiffs,
+                                                   Eigen::Ref<Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>> angularVelocities,
+                                                   const Executor_& executor = Executor_()) {
+  typedef typename EulerAngles_::RateMapping RateMapping;
+  internal::mapEulerAnglesRates<EulerAngles_>(eulerAngles, eulerAnglesDiffs, angularVelocities, executor,
+      [](const RateMapping& rateMapping, const typename RateMapping::Vector3& diff) { return rateMapping.getLocalAngularVelocity(diff); });
+}
+
+/*! \brief Computes the global angular velocities of time derivatives of Euler angles.
+ *  \see getLocalAngularVelocitiesFromEulerAnglesDiffs
+ */
+template<typename EulerAngles_, typename Executor_ = SerialExecutor>
+void getGlobalAngularVelocitiesFromEulerAnglesDiffs(const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& eulerAngles,
+                                                    const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& eulerAnglesDiffs,
+                                                    Eigen::Ref<Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>> angularVelocities,
+                                                    const Executor_& executor = Executor_()) {
+  typedef typename EulerAngles_::RateMapping RateMapping;
+  internal::mapEulerAnglesRates<EulerAngles_>(eulerAngles, eulerAnglesDiffs, angularVelocities, executor,
+      [](const RateMapping& rateMapping, const typename RateMapping::Vector3& diff) { return rateMapping.getGlobalAngularVelocity(diff); });
+}
+
+/*! \brief Computes the time derivatives of Euler angles from local angular velocities.
+ *  Throws (or asserts with KINDR_NO_EXCEPTIONS) at a gimbal lock.
+ *  \see getLocalAngularVelocitiesFromEulerAnglesDiffs
+ */
+template<typename EulerAngles_, typename Executor_ = SerialExecutor>
+void getEulerAnglesDiffsFromLocalAngularVelocities(const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& eulerAngles,
+                                                   const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& angularVelocities,
+                                                   Eigen::Ref<Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>> eulerAnglesDiffs,
+                                                   const Executor_& executor = Executor_()) {
+  typedef typename EulerAngles_::RateMapping RateMapping;
+  internal::mapEulerAnglesRates<EulerAngles_>(eulerAngles, angularVelocities, eulerAnglesDiffs, executor,
+      [](const RateMapping& rateMapping, const typename RateMapping::Vector3& angularVelocity) { return rateMapping.getDiffFromLocalAngularVelocity(angularVelocity); });
+}
+
+/*! \brief Computes the time derivatives of Euler angles from global angular velocities.
+ *  Throws (or asserts with KINDR_NO_EXCEPTIONS) at a gimbal lock.
+ *  \see getLocalAngularVelocitiesFromEulerAnglesDiffs
+ */
+template<typename EulerAngles_, typename Executor_ = SerialExecutor>
+void getEulerAnglesDiffsFromGlobalAngularVelocities(const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& eulerAngles,
+                                                    const Eigen::Ref<const Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>>& angularVelocities,
+                                                    Eigen::Ref<Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic>> eulerAnglesDiffs,
+                                                    const Executor_& executor = Executor_()) {
+  typedef typename EulerAngles_::RateMapping RateMapping;
+  internal::mapEulerAnglesRates<EulerAngles_>(eulerAngles, angularVelocities, eulerAnglesDiffs, executor,
+      [](const RateMapping& rateMapping, const typename RateMapping::Vector3& angularVelocity) { return rateMapping.getDiffFromGlobalAngularVelocity(angularVelocity); });
+}
+
+} // namespace kindr
@@ -39,6 +39,164 @@
 namespace kindr {
 
 
+namespace internal {
+
+/*! \class EulerAnglesXyzRateMapping
+ *  \brief Mappings between the time derivatives of Euler angles (X-Y'-Z'') and the angular velocity and acceleration.
+ *
+ *  The sines and cosines of the angles are evaluated once in the constructor and shared by all mappings, which are
+ *  applied without building the 3x3 matrices.
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class EulerAnglesXyzRateMapping {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+
+  /*! \brief Constructor.
+   *  \param x   roll
+   *  \param y   pitch
+   *  \param z   yaw
+   */
+  EulerAnglesXyzRateMapping(PrimType_ x, PrimType_ y, PrimType_ z) {
+    using std::sin;
+    using std::cos;
+    sinX_ = sin(x);
+    cosX_ = cos(x);
+    sinY_ = sin(y);
+    cosY_ = cos(y);
+    sinZ_ = sin(z);
+    cosZ_ = cos(z);
+  }
+
+  //! \returns the local angular velocity of the time derivative [dx; dy; dz]
+  inline Vector3 getLocalAngularVelocity(const Vector3& diff) const {
+    return Vector3(cosY_*cosZ_*diff(0) + sinZ_*diff(1),
+                   cosZ_*diff(1) - cosY_*sinZ_*diff(0),
+                   sinY_*diff(0) + diff(2));
+  }
+
+  //! \returns the global angular velocity of the time derivative [dx; dy; dz]
+  inline Vector3 getGlobalAngularVelocity(const Vector3& diff) const {
+    return Vector3(diff(0) + sinY_*diff(2),
+                   cosX_*diff(1) - sinX_*cosY_*diff(2),
+                   sinX_*diff(1) + cosX_*cosY_*diff(2));
+  }
+
+  //! \returns the time derivative [dx; dy; dz] of the local angular velocity
+  inline Vector3 getDiffFromLocalAngularVelocity(const Vector3& angularVelocity) const {
+    const PrimType_ diffX = (cosZ_*angularVelocity(0) - sinZ_*angularVelocity(1))*getInverseCosY();
+    return Vector3(diffX,
+                   sinZ_*angularVelocity(0) + cosZ_*angularVelocity(1),
+                   angularVelocity(2) - sinY_*diffX);
+  }
+
+  //! \returns the time derivative [dx; dy; dz] of the global angular velocity
+  inline Vector3 getDiffFromGlobalAngularVelocity(const Vector3& angularVelocity) const {
+    const PrimType_ diffZ = (cosX_*angularVelocity(2) - sinX_*angularVelocity(1))*getInverseCosY();
+    return Vector3(angularVelocity(0) - sinY_*diffZ,
+                   cosX_*angularVelocity(1) + sinX_*angularVelocity(2),
+                   diffZ);
+  }
+
+  /*! \returns the local angular acceleration of the second time derivative [ddx; ddy; ddz]
+   *  \param diff    time derivative [dx; dy; dz]
+   *  \param ddiff   second time derivative [ddx; ddy; ddz]
+   */
+  inline Vector3 getLocalAngularAcceleration(const Vector3& diff, const Vector3& ddiff) const {
+    return getLocalAngularVelocity(ddiff) + getLocalAngularAccelerationOfDiff(diff);
+  }
+
+  /*! \returns the global angular acceleration of the second time derivative [ddx; ddy; ddz]
+   *  \param diff    time derivative [dx; dy; dz]
+   *  \param ddiff   second time derivative [ddx; ddy; ddz]
+   */
+  inline Vector3 getGlobalAngularAcceleration(const Vector3& diff, const Vector3& ddiff) const {
+    return getGlobalAngularVelocity(ddiff) + getGlobalAngularAccelerationOfDiff(diff);
+  }
+
+  /*! \returns the second time derivative [ddx; ddy; ddz] of the local angular acceleration
+   *  \param diff                  time derivative [dx; dy; dz]
+   *  \param angularAcceleration   local angular acceleration
+   */
+  inline Vector3 getDDiffFromLocalAngularAcceleration(const Vector3& diff, const Vector3& angularAcceleration) const {
+    return getDiffFromLocalAngularVelocity(angularAcceleration - getLocalAngularAccelerationOfDiff(diff));
+  }
+
+  /*! \returns the second time derivative [ddx; ddy; ddz] of the global angular acceleration
+   *  \param diff                  time derivative [dx; dy; dz]
+   *  \param angularAcceleration   global angular acceleration
+   */
+  inline Vector3 getDDiffFromGlobalAngularAcceleration(const Vector3& diff, const Vector3& angularAcceleration) const {
+    return getDiffFromGlobalAngularVelocity(angularAcceleration - getGlobalAngularAccelerationOfDiff(diff));
+  }
+
+  Matrix3 getMappingFromDiffToLocalAngularVelocity() const {
+    Matrix3 mat;
+    mat << cosY_*cosZ_, sinZ_, 0.0,
+           -cosY_*sinZ_, cosZ_, 0.0,
+           sinY_, 0.0, 1.0;
+    return mat;
+  }
+
+  Matrix3 getMappingFromLocalAngularVelocityToDiff() const {
+    const PrimType_ inverseCosY = getInverseCosY();
+    Matrix3 mat;
+    mat << inverseCosY*cosZ_, -inverseCosY*sinZ_, 0.0,
+           sinZ_, cosZ_, 0.0,
+           -inverseCosY*cosZ_*sinY_, inverseCosY*sinZ_*sinY_, 1.0;
+    return mat;
+  }
+
+  Matrix3 getMappingFromDiffToGlobalAngularVelocity() const {
+    Matrix3 mat;
+    mat << 1.0, 0.0, sinY_,
+           0.0, cosX_, -sinX_*cosY_,
+           0.0, sinX_, cosX_*cosY_;
+    return mat;
+  }
+
+  Matrix3 getMappingFromGlobalAngularVelocityToDiff() const {
+    const PrimType_ inverseCosY = getInverseCosY();
+    Matrix3 mat;
+    mat << 1.0, inverseCosY*sinY_*sinX_, -inverseCosY*sinY_*cosX_,
+           0.0, cosX_, sinX_,
+           0.0, -inverseCosY*sinX_, inverseCosY*cosX_;
+    return mat;
+  }
+
+ private:
+  inline PrimType_ getInverseCosY() const {
+    KINDR_ASSERT_TRUE_HOT(std::runtime_error, cosY_ != PrimType_(0.0), "Gimbal lock: cos(y) is zero!");
+    return PrimType_(1.0)/cosY_;
+  }
+
+  //! \returns the local angular acceleration due to the change of the mapping, i.e. dE/dt*diff
+  inline Vector3 getLocalAngularAccelerationOfDiff(const Vector3& diff) const {
+    return Vector3(cosZ_*diff(2)*diff(1) - (sinY_*cosZ_*diff(1) + cosY_*sinZ_*diff(2))*diff(0),
+                   (sinY_*sinZ_*diff(1) - cosY_*cosZ_*diff(2))*diff(0) - sinZ_*diff(2)*diff(1),
+                   cosY_*diff(1)*diff(0));
+  }
+
+  //! \returns the global angular acceleration due to the change of the mapping, i.e. dE/dt*diff
+  inline Vector3 getGlobalAngularAccelerationOfDiff(const Vector3& diff) const {
+    return Vector3(cosY_*diff(1)*diff(2),
+                   -sinX_*diff(0)*diff(1) - (cosX_*cosY_*diff(0) - sinX_*sinY_*diff(1))*diff(2),
+                   cosX_*diff(0)*diff(1) - (sinX_*cosY_*diff(0) + cosX_*sinY_*diff(1))*diff(2));
+  }
+
+  PrimType_ sinX_;
+  PrimType_ cosX_;
+  PrimType_ sinY_;
+  PrimType_ cosY_;
+  PrimType_ sinZ_;
+  PrimType_ cosZ_;
+};
+
+} // namespace internal
+
 /*! \class EulerAnglesXyz
  *  \brief Implementation of Euler angles (X-Y'-Z'' / roll-pitch-yaw) rotation based on Eigen::Matrix<Scalar,3,1>
  *
@@ -72,6 +230,9 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
    *  Float/Double
    */
   typedef PrimType_ Scalar;
+  /*! \brief The mappings between the time derivative and the angular velocity.
+   */
+  typedef internal::EulerAnglesXyzRateMapping<PrimType_> RateMapping;
 
   /*! \brief Rotation Vector as 3x1-matrix
    */
@@ -104,7 +265,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
    */
   template<typename OtherDerived_>
   inline explicit EulerAnglesXyz(const RotationBase<OtherDerived_>& other)
-    : xyz_(internal::ConversionTraits<EulerAnglesXyz, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    : xyz_(internal::convertRotation<EulerAnglesXyz, OtherDerived_>(other.derived()).toImplementation()) {
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -113,7 +274,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
    */
   template<typename OtherDerived_>
   EulerAnglesXyz& operator =(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<EulerAnglesXyz, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<EulerAnglesXyz, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -123,7 +284,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
    */
   template<typename OtherDerived_>
   EulerAnglesXyz& operator ()(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<EulerAnglesXyz, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<EulerAnglesXyz, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -254,58 +415,61 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
    *  \returns copy of the Euler angles rotation which is unique
    */
   EulerAnglesXyz getUnique() const {
-    Base xyz(kindr::floatingPointModulo(x()+M_PI,2*M_PI)-M_PI,
-             kindr::floatingPointModulo(y()+M_PI,2*M_PI)-M_PI,
-             kindr::floatingPointModulo(z()+M_PI,2*M_PI)-M_PI); // wrap all angles into [-pi,pi)
+    KINDR_INSTRUMENT(Unique);
+    Base xyz(kindr::wrapPosNegPI(x()),
+             kindr::wrapPosNegPI(y()),
+             kindr::wrapPosNegPI(z())); // wrap all angles into [-pi,pi)
 
-    const double tol = 1e-3;
+    const Scalar pi = static_cast<Scalar>(M_PI);
+    const Scalar halfPi = static_cast<Scalar>(M_PI/2);
+    const Scalar tol = static_cast<Scalar>(1e-3);
 
     // wrap angles into [-pi,pi),[-pi/2,pi/2),[-pi,pi)
-    if(xyz.y() < -M_PI/2 - tol)
+    if(xyz.y() < -halfPi - tol)
     {
-      if(xyz.x() < 0) {
-        xyz.x() = xyz.x() + M_PI;
+      if(xyz.x() < Scalar(0)) {
+        xyz.x() = xyz.x() + pi;
       } else {
-        xyz.x() = xyz.x() - M_PI;
+        xyz.x() = xyz.x() - pi;
       }
 
-      xyz.y() = -(xyz.y() + M_PI);
+      xyz.y() = -(xyz.y() + pi);
 
-      if(xyz.z() < 0) {
-        xyz.z() = xyz.z() + M_PI;
+      if(xyz.z() < Scalar(0)) {
+        xyz.z() = xyz.z() + pi;
       } else {
-        xyz.z() = xyz.z() - M_PI;
+        xyz.z() = xyz.z() - pi;
       }
     }
-    else if(-M_PI/2 - tol <= xyz.y() && xyz.y() <= -M_PI/2 + tol)
+    else if(-halfPi - tol <= xyz.y() && xyz.y() <= -halfPi + tol)
     {
       xyz.x() -= xyz.z();
-      xyz.z() = 0;
+      xyz.z() = Scalar(0);
     }
-    else if(-M_PI/2 + tol < xyz.y() && xyz.y() < M_PI/2 - tol)
+    else if(-halfPi + tol < xyz.y() && xyz.y() < halfPi - tol)
     {
       // ok
     }
-    else if(M_PI/2 - tol <= xyz.y() && xyz.y() <= M_PI/2 + tol)
+    else if(halfPi - tol <= xyz.y() && xyz.y() <= halfPi + tol)
     {
       // todo: M_PI/2 should not be in range, other formula?
       xyz.x() += xyz.z();
-      xyz.z() = 0;
+      xyz.z() = Scalar(0);
     }
     else // M_PI/2 + tol < xyz.y()
     {
-      if(xyz.x() < 0) {
-        xyz.x() = xyz.x() + M_PI;
+      if(xyz.x() < Scalar(0)) {
+        xyz.x() = xyz.x() + pi;
       } else {
-        xyz.x() = xyz.x() - M_PI;
+        xyz.x() = xyz.x() - pi;
       }
 
-      xyz.y() = -(xyz.y() - M_PI);
+      xyz.y() = -(xyz.y() - pi);
 
-      if(xyz.z() < 0) {
-        xyz.z() = xyz.z() + M_PI;
+      if(xyz.z() < Scalar(0)) {
+        xyz.z() = xyz.z() + pi;
       } else {
-        xyz.z() = xyz.z() - M_PI;
+        xyz.z() = xyz.z() - pi;
       }
     }
 
@@ -320,96 +484,30 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
     return *this;
   }
 
-  typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToLocalAngularVelocity() const {
-    using std::sin;
-    using std::cos;
-    Eigen::Matrix<PrimType_, 3, 3> mat =  Eigen::Matrix<PrimType_, 3, 3>::Zero();
-    const PrimType_ x = this->x();
-    const PrimType_ y = this->y();
-    const PrimType_ z = this->z();
-
-    const PrimType_ t2 = cos(y);
-    const PrimType_ t3 = sin(z);
-    const PrimType_ t4 = cos(z);
-    mat(0, 0) = t2*t4;
-    mat(0, 1) = t3;
-    mat(1, 0) = -t2*t3;
-    mat(1, 1) = t4;
-    mat(2, 0) = sin(y);
-    mat(2, 2) = 1.0;
+  /*! \brief Gets the sines and cosines of the angles for the mappings between the time derivative and the angular
+   *  velocity. Use it to apply several mappings or to avoid building the matrices.
+   *  \returns mapping
+   */
+  RateMapping getRateMapping() const {
+    return RateMapping(x(), y(), z());
+  }
 
-    return mat;
+  typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToLocalAngularVelocity() const {
+    return getRateMapping().getMappingFromDiffToLocalAngularVelocity();
   }
 
   typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromLocalAngularVelocityToDiff() const {
-    using std::sin;
-    using std::cos;
-    Eigen::Matrix<PrimType_, 3, 3> mat =  Eigen::Matrix<PrimType_, 3, 3>::Zero();
-    const PrimType_ x = this->x();
-    const PrimType_ y = this->y();
-    const PrimType_ z = this->z();
-
-    const PrimType_ t2 = cos(y);
-    KINDR_ASSERT_TRUE(std::runtime_error, t2 != PrimType_(0.0), "Gimbal lock: cos(y) is zero!");
-    const PrimType_ t3 = 1.0/t2;
-    const PrimType_ t4 = sin(z);
-    const PrimType_ t5 = cos(z);
-    const PrimType_ t6 = sin(y);
-    mat(0,0) = t3*t5;
-    mat(0,1) = -t3*t4;
-    mat(1,0) = t4;
-    mat(1,1) = t5;
-    mat(2,0) = -t3*t5*t6;
-    mat(2,1) = t3*t4*t6;
-    mat(2,2) = 1.0;
-
-    return mat;
+    return getRateMapping().getMappingFromLocalAngularVelocityToDiff();
   }
 
   typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromGlobalAngularVelocityToDiff() const {
-    using std::sin;
-    using std::cos;
-    Eigen::Matrix<PrimType_, 3, 3> mat =  Eigen::Matrix<PrimType_, 3, 3>::Zero();
-    const PrimType_ x = this->x();
-    const PrimType_ y = this->y();
-    const PrimType_ z = this->z();
-    const PrimType_ t2 = cos(y);
-    KINDR_ASSERT_TRUE(std::runtime_error, t2 != PrimType_(0.0), "Gimbal lock: cos(y) is zero!");
-    const PrimType_ t3 = 1.0/t2;
-    const PrimType_ t4 = sin(y);
-    const PrimType_ t5 = cos(x);
-    const PrimType_ t6 = sin(x);
-    mat(0,0) = 1.0;
-    mat(0,1) = t3*t4*t6;
-    mat(0,2) = -t3*t4*t5;
-    mat(1,1) = t5;
-    mat(1,2) = t6;
-    mat(2,1) = -t3*t6;
-    mat(2,2) = t3*t5;
-    return mat;
+    return getRateMapping().getMappingFromGlobalAngularVelocityToDiff();
   }
 
-
   typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToGlobalAngularVelocity() const {
-    using std::sin;
-    using std::cos;
-    Eigen::Matrix<PrimType_, 3, 3> mat =  Eigen::Matrix<PrimType_, 3, 3>::Zero();
-    const PrimType_ x = this->x();
-    const PrimType_ y = this->y();
-    const PrimType_ z = this->z();
-    const PrimType_ t2 = sin(x);
-    const PrimType_ t3 = cos(x);
-    const PrimType_ t4 = cos(y);
-    mat(0,0) = 1.0;
-    mat(0,2) = sin(y);
-    mat(1,1) = t3;
-    mat(1,2) = -t2*t4;
-    mat(2,1) = t2;
-    mat(2,2) = t3*t4;
-    return mat;
+    return getRateMapping().getMappingFromDiffToGlobalAngularVelocity();
   }
 
-
   /*! \brief Concenation operator.
    *  This is explicitly specified, because Eigen::Matrix provides also an operator*.
    *  \returns the concenation of two rotations
@@ -476,6 +574,27 @@ class get_matrix3X<EulerAnglesXyz<PrimType_>>{
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Conversion Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/*! \brief Gets the Euler angles [roll; pitch; yaw] from the elements of a rotation matrix
+ *  (only for advanced users)
+ *
+ *  The angles are extracted in closed form with roll and yaw in [-pi,pi] and pitch in [-pi/2,pi/2].
+ *  In gimbal lock (pitch = +-pi/2), only the sum or the difference of roll and yaw is defined
+ *  and yaw is set to zero if the cosine of the pitch is below getGimbalLockThreshold().
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 3, 1> getEulerAnglesXyzFromRotationMatrixElements(PrimType_ r00, PrimType_ r01, PrimType_ r02, PrimType_ r10,
+                                                                                  PrimType_ r11, PrimType_ r12, PrimType_ r22) {
+  using std::atan2;
+  using std::sqrt;
+  const PrimType_ cosPitch = sqrt(r00*r00 + r01*r01);
+  const PrimType_ pitch = atan2(r02, cosPitch);
+  if (cosPitch < getGimbalLockThreshold<PrimType_>()) {
+    return Eigen::Matrix<PrimType_, 3, 1>((r02 < PrimType_(0.0)) ? atan2(-r10, r11) : atan2(r10, r11), pitch, PrimType_(0.0));
+  }
+  return Eigen::Matrix<PrimType_, 3, 1>(atan2(-r12, r22), pitch, atan2(-r01, r00));
+}
+
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesXyz<DestPrimType_>, AngleAxis<SourcePrimType_>> {
  public:
@@ -497,8 +616,14 @@ template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesXyz<DestPrimType_>, RotationQuaternion<SourcePrimType_>> {
  public:
   inline static EulerAnglesXyz<DestPrimType_> convert(const RotationQuaternion<SourcePrimType_>& q) {
-     Eigen::Matrix<DestPrimType_, 3, 1>  vec = q.toImplementation().toRotationMatrix().eulerAngles(0, 1, 2).template cast<DestPrimType_>();
-     return EulerAnglesXyz<DestPrimType_>(vec(0), vec(1), vec(2));
+    // only the required elements of the rotation matrix are computed
+    const SourcePrimType_ one = SourcePrimType_(1.0);
+    const SourcePrimType_ two = SourcePrimType_(2.0);
+    const SourcePrimType_ w = q.w(), x = q.x(), y = q.y(), z = q.z();
+    return EulerAnglesXyz<DestPrimType_>(getEulerAnglesXyzFromRotationMatrixElements<SourcePrimType_>(
+        one - two*(y*y + z*z), two*(x*y - w*z), two*(x*z + w*y),
+        two*(x*y + w*z), one - two*(x*x + z*z), two*(y*z - w*x),
+        one - two*(x*x + y*y)).template cast<DestPrimType_>());
   }
 };
 
@@ -507,7 +632,9 @@ template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesXyz<DestPrimType_>, RotationMatrix<SourcePrimType_>> {
  public:
   inline static EulerAnglesXyz<DestPrimType_> convert(const RotationMatrix<SourcePrimType_>& R) {
-    return EulerAnglesXyz<DestPrimType_>(RotationQuaternion<DestPrimType_>(R));
+    const Eigen::Matrix<SourcePrimType_, 3, 3>& m = R.toImplementation();
+    return EulerAnglesXyz<DestPrimType_>(getEulerAnglesXyzFromRotationMatrixElements<SourcePrimType_>(
+        m(0,0), m(0,1), m(0,2), m(1,0), m(1,1), m(1,2), m(2,2)).template cast<DestPrimType_>());
   }
 };
 
@@ -534,7 +661,59 @@ class ConversionTraits<EulerAnglesXyz<DestPrimType_>, EulerAnglesZyx<SourcePrimT
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Rotation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class RotationTraits<RotationBase<EulerAnglesXyz<PrimType_>>> : public DirectRotationTraits<EulerAnglesXyz<PrimType_>, 2> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
 
+  /*! \brief Rotates a vector by the three elementary rotations without computing the rotation matrix.
+   *  v' = C_x(roll)*C_y(pitch)*C_z(yaw)*v
+   */
+  inline static Vector3 rotateVector(const EulerAnglesXyz<PrimType_>& rotation, const Vector3& vector) {
+    using std::cos;
+    using std::sin;
+    const PrimType_ cx = cos(rotation.x());
+    const PrimType_ sx = sin(rotation.x());
+    const PrimType_ cy = cos(rotation.y());
+    const PrimType_ sy = sin(rotation.y());
+    const PrimType_ cz = cos(rotation.z());
+    const PrimType_ sz = sin(rotation.z());
+
+    // Rotation about z
+    const PrimType_ x1 = cz*vector.x() - sz*vector.y();
+    const PrimType_ y1 = sz*vector.x() + cz*vector.y();
+    const PrimType_ z1 = vector.z();
+    // Rotation about y
+    const PrimType_ x2 = cy*x1 + sy*z1;
+    const PrimType_ z2 = cy*z1 - sy*x1;
+    // Rotation about x
+    return Vector3(x2, cx*y1 - sx*z2, sx*y1 + cx*z2);
+  }
+
+  /*! \brief Rotates a vector by the transposed elementary rotations without computing the inverse rotation.
+   *  v' = C_z(yaw)^T*C_y(pitch)^T*C_x(roll)^T*v
+   */
+  inline static Vector3 inverseRotateVector(const EulerAnglesXyz<PrimType_>& rotation, const Vector3& vector) {
+    using std::cos;
+    using std::sin;
+    const PrimType_ cx = cos(rotation.x());
+    const PrimType_ sx = sin(rotation.x());
+    const PrimType_ cy = cos(rotation.y());
+    const PrimType_ sy = sin(rotation.y());
+    const PrimType_ cz = cos(rotation.z());
+    const PrimType_ sz = sin(rotation.z());
+
+    // Inverse rotation about x
+    const PrimType_ x1 = vector.x();
+    const PrimType_ y1 = cx*vector.y() + sx*vector.z();
+    const PrimType_ z1 = cx*vector.z() - sx*vector.y();
+    // Inverse rotation about y
+    const PrimType_ x2 = cy*x1 - sy*z1;
+    const PrimType_ z2 = sy*x1 + cy*z1;
+    // Inverse rotation about z
+    return Vector3(cz*x2 + sz*y1, cz*y1 - sz*x2, z2);
+  }
+};
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Comparison Traits
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/EulerAnglesXyz.hpp"
+#include "kindr/rotations/EulerAnglesXyzDiff.hpp"
+
+namespace kindr {
+
+/*! \class EulerAnglesXyzDDiff
+ * \brief Implementation of second time derivatives of Euler angles (X,Y',Z'' / roll,pitch,yaw) based on Eigen::Matrix<Scalar, 3, 1>
+ *
+ * The mappings to and from the angular acceleration are evaluated in closed form with the sines and cosines of
+ * EulerAnglesXyz::RateMapping, which also provides the first derivative mappings.
+ *
+ * The following two typedefs are provided for convenience:
+ *   - EulerAnglesXyzDDiffD for primitive type double
+ *   - EulerAnglesXyzDDiffF for primitive type float
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \ingroup rotations
+ */
+template<typename PrimType_>
+class EulerAnglesXyzDDiff {
+ private:
+  /*! \brief The base type.
+   */
+  typedef Eigen::Matrix<PrimType_, 3, 1> Base;
+
+  /*! \brief data container [roll; pitch; yaw]
+   */
+  Base xyzDDiff_;
+
+ public:
+  /*! \brief The implementation type.
+   *  The implementation type is always an Eigen object.
+   */
+  typedef Base Implementation;
+
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  /*! \brief The angular acceleration type.
+   */
+  typedef AngularAcceleration<PrimType_, 3> AngularAcceleration3;
+
+  /*! \brief Default constructor.
+   */
+  EulerAnglesXyzDDiff()
+    : xyzDDiff_(Base::Zero()) {
+  }
+
+  /*! \brief Constructor using three scalars.
+   *  \param roll     second time derivative of first rotation angle around X axis
+   *  \param pitch    second time derivative of second rotation angle around Y' axis
+   *  \param yaw      second time derivative of third rotation angle around Z'' axis
+   */
+  EulerAnglesXyzDDiff(Scalar roll, Scalar pitch, Scalar yaw)
+    : xyzDDiff_(roll,pitch,yaw) {
+  }
+
+  /*! \brief Constructor using Eigen::Matrix.
+   *  \param other   Eigen::Matrix<Scalar, 3, 1> [roll; pitch; yaw]
+   */
+  explicit EulerAnglesXyzDDiff(const Base& other)
+    : xyzDDiff_(other) {
+  }
+
+  /*! \brief Gets the second time derivative from the angular acceleration expressed in the local (body) frame.
+   *  Throws (or asserts with KINDR_NO_EXCEPTIONS) at a gimbal lock.
+   *  \param eulerAngles           Euler angles
+   *  \param eulerAnglesDiff       time derivative of the Euler angles
+   *  \param angularAcceleration   local angular acceleration
+   *  \returns second time derivative
+   */
+  static EulerAnglesXyzDDiff fromLocalAngularAcceleration(const EulerAnglesXyz<PrimType_>& eulerAngles,
+                                                          const EulerAnglesXyzDiff<PrimType_>& eulerAnglesDiff,
+                                                          const AngularAcceleration3& angularAcceleration) {
+    return EulerAnglesXyzDDiff(eulerAngles.getRateMapping().getDDiffFromLocalAngularAcceleration(eulerAnglesDiff.toImplementation(), angularAcceleration.toImplementation()));
+  }
+
+  /*! \brief Gets the second time derivative from the angular acceleration expressed in the global (inertial) frame.
+   *  Throws (or asserts with KINDR_NO_EXCEPTIONS) at a gimbal lock.
+   *  \param eulerAngles           Euler angles
+   *  \param eulerAnglesDiff       time derivative of the Euler angles
+   *  \param angularAcceleration   global angular acceleration
+   *  \returns second time derivative
+   */
+  static EulerAnglesXyzDDiff fromGlobalAngularAcceleration(const EulerAnglesXyz<PrimType_>& eulerAngles,
+                                                           const EulerAnglesXyzDiff<PrimType_>& eulerAnglesDiff,
+                                                           const AngularAcceleration3& angularAcceleration) {
+    return EulerAnglesXyzDDiff(eulerAngles.getRateMapping().getDDiffFromGlobalAngularAcceleration(eulerAnglesDiff.toImplementation(), angularAcceleration.toImplementation()));
+  }
+
+  /*! \brief Gets the angular acceleration expressed in the local (body) frame.
+   *  \param eulerAngles       Euler angles
+   *  \param eulerAnglesDiff   time derivative of the Euler angles
+   *  \returns local angular acceleration
+   */
+  AngularAcceleration3 getLocalAngularAcceleration(const EulerAnglesXyz<PrimType_>& eulerAngles,
+                                                   const EulerAnglesXyzDiff<PrimType_>& eulerAnglesDiff) const {
+    return AngularAcceleration3(eulerAngles.getRateMapping().getLocalAngularAcceleration(eulerAnglesDiff.toImplementation(), xyzDDiff_));
+  }
+
+  /*! \brief Gets the angular acceleration expressed in the global (inertial) frame.
+   *  \param eulerAngles       Euler angles
+   *  \param eulerAnglesDiff   time derivative of the Euler angles
+   *  \returns global angular acceleration
+   */
+  AngularAcceleration3 getGlobalAngularAcceleration(const EulerAnglesXyz<PrimType_>& eulerAngles,
+                                                    const EulerAnglesXyzDiff<PrimType_>& eulerAnglesDiff) const {
+    return AngularAcceleration3(eulerAngles.getRateMapping().getGlobalAngularAcceleration(eulerAnglesDiff.toImplementation(), xyzDDiff_));
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation for direct manipulation (recommended only for advanced users)
+   */
+  inline Base& toImplementation() {
+    return xyzDDiff_;
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation for direct manipulation (recommended only for advanced users)
+   */
+  inline const Base& toImplementation() const {
+    return xyzDDiff_;
+  }
+
+  inline Base& vector() {
+    return toImplementation();
+  }
+
+  inline const Base& vector() const {
+    return toImplementation();
+  }
+
+  /*! \brief Reading access to second time derivative of yaw (Z'') angle.
+   *  \returns second time derivative of yaw angle (scalar) with reading access
+   */
+  inline Scalar yaw() const {
+    return toImplementation()(2);
+  }
+
+  /*! \brief Reading access to second time derivative of pitch (Y') angle.
+   *  \returns second time derivative of pitch angle (scalar) with reading access
+   */
+  inline Scalar pitch() const {
+    return toImplementation()(1);
+  }
+
+  /*! \brief Reading access to second time derivative of roll (X) angle.
+   *  \returns second time derivative of roll angle (scalar) with reading access
+   */
+  inline Scalar roll() const {
+    return toImplementation()(0);
+  }
+
+  /*! \brief Writing access to second time derivative of yaw (Z'') angle.
+   *  \returns second time derivative of yaw angle (scalar) with writing access
+   */
+  inline Scalar& yaw() {
+    return toImplementation()(2);
+  }
+
+  /*! \brief Writing access to second time derivative of pitch (Y') angle.
+   *  \returns second time derivative of pitch angle (scalar) with writing access
+   */
+  inline Scalar& pitch() {
+    return toImplementation()(1);
+  }
+
+  /*! \brief Writing access to second time derivative of roll (X) angle.
+   *  \returns second time derivative of roll angle (scalar) with writing access
+   */
+  inline Scalar& roll() {
+    return toImplementation()(0);
+  }
+
+  /*! \brief Reading access to second time derivative of yaw (Z'') angle.
+   *  \returns second time derivative of yaw angle (scalar) with reading access
+   */
+  inline Scalar z() const {
+    return toImplementation()(2);
+  }
+
+  /*! \brief Reading access to second time derivative of pitch (Y') angle.
+   *  \returns second time derivative of pitch angle (scalar) with reading access
+   */
+  inline Scalar y() const {
+    return toImplementation()(1);
+  }
+
+  /*! \brief Reading access to second time derivative of roll (X) angle.
+   *  \returns second time derivative of roll angle (scalar) with reading access
+   */
+  inline Scalar x() const {
+    return toImplementation()(0);
+  }
+
+  /*! \brief Writing access to second time derivative of yaw (Z'') angle.
+   *  \returns second time derivative of yaw angle (scalar) with writing access
+   */
+  inline Scalar& z() {
+    return toImplementation()(2);
+  }
+
+  /*! \brief Writing access to second time derivative of pitch (Y') angle.
+   *  \returns second time derivative of pitch angle (scalar) with writing access
+   */
+  inline Scalar& y() {
+    return toImplementation()(1);
+  }
+
+  /*! \brief Writing access to second time derivative of roll (X) angle.
+   *  \returns second time derivative of roll angle (scalar) with writing access
+   */
+  inline Scalar& x() {
+    return toImplementation()(0);
+  }
+
+  /*! \brief Sets all second time derivatives to zero.
+   *  \returns reference
+   */
+  EulerAnglesXyzDDiff& setZero() {
+    this->toImplementation().setZero();
+    return *this;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *
+   *   Prints: roll pitch yaw
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const EulerAnglesXyzDDiff& ddiff) {
+    out << ddiff.toImplementation().transpose();
+    return out;
+  }
+};
+
+//! \brief Second time derivative of Euler angles with x-y-z convention and primitive type double
+typedef EulerAnglesXyzDDiff<double> EulerAnglesXyzDDiffD;
+//! \brief Second time derivative of Euler angles with x-y-z convention and primitive type float
+typedef EulerAnglesXyzDDiff<float> EulerAnglesXyzDDiffF;
+
+} // namespace kindr
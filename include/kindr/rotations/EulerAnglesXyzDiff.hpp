@@ -241,7 +241,7 @@ class EulerAnglesXyzDiff : public RotationDiffBase<EulerAnglesXyzDiff<PrimType_>
      const PrimType_ dy = this->y();
      const PrimType_ dz = this->z();
      const PrimType_ t2 = cos(y);
-     KINDR_ASSERT_TRUE(std::runtime_error, t2 != PrimType_(0), "Gimbal lock: cos(y) is zero!");
+     KINDR_ASSERT_TRUE_HOT(std::runtime_error, t2 != PrimType_(0), "Gimbal lock: cos(y) is zero!");
      const PrimType_ t3 = 1.0/t2;
      const PrimType_ t4 = cos(z);
      const PrimType_ t5 = 1.0/(t2*t2);
@@ -294,7 +294,7 @@ class EulerAnglesXyzDiff : public RotationDiffBase<EulerAnglesXyzDiff<PrimType_>
      const PrimType_ t3 = sin(y);
      const PrimType_ t4 = cos(y);
      const PrimType_ t5 = cos(x);
-     KINDR_ASSERT_TRUE(std::runtime_error, t4 != PrimType_(0), "Gimbal lock: cos(y) is zero!");
+     KINDR_ASSERT_TRUE_HOT(std::runtime_error, t4 != PrimType_(0), "Gimbal lock: cos(y) is zero!");
      const PrimType_ t6 = 1.0/(t4*t4);
      const PrimType_ t7 = t3*t3;
      const PrimType_ t8 = 1.0/t4;
@@ -358,7 +358,15 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<EulerAnglesXyzDiff<PrimType_>, LocalAngularVelocity<PrimType_>, EulerAnglesXyz<PrimType_>> {
  public:
   inline static EulerAnglesXyzDiff<PrimType_> convert(const EulerAnglesXyz<PrimType_>& eulerAngles, const LocalAngularVelocity<PrimType_>& angularVelocity) {
-    return EulerAnglesXyzDiff<PrimType_>(eulerAngles.getMappingFromLocalAngularVelocityToDiff()*angularVelocity.vector());
+    return EulerAnglesXyzDiff<PrimType_>(eulerAngles.getRateMapping().getDiffFromLocalAngularVelocity(angularVelocity.vector()));
+  }
+};
+
+template<typename PrimType_>
+class RotationDiffConversionTraits<EulerAnglesXyzDiff<PrimType_>, GlobalAngularVelocity<PrimType_>, EulerAnglesXyz<PrimType_>> {
+ public:
+  inline static EulerAnglesXyzDiff<PrimType_> convert(const EulerAnglesXyz<PrimType_>& eulerAngles, const GlobalAngularVelocity<PrimType_>& angularVelocity) {
+    return EulerAnglesXyzDiff<PrimType_>(eulerAngles.getRateMapping().getDiffFromGlobalAngularVelocity(angularVelocity.vector()));
   }
 };
 
@@ -38,6 +38,164 @@
 
 namespace kindr {
 
+namespace internal {
+
+/*! \class EulerAnglesZyxRateMapping
+ *  \brief Mappings between the time derivatives of Euler angles (Z-Y'-X'') and the angular velocity and acceleration.
+ *
+ *  The sines and cosines of the angles are evaluated once in the constructor and shared by all mappings, which are
+ *  applied without building the 3x3 matrices.
+ *
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class EulerAnglesZyxRateMapping {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+
+  /*! \brief Constructor.
+   *  \param z   yaw
+   *  \param y   pitch
+   *  \param x   roll
+   */
+  EulerAnglesZyxRateMapping(PrimType_ z, PrimType_ y, PrimType_ x) {
+    using std::sin;
+    using std::cos;
+    sinZ_ = sin(z);
+    cosZ_ = cos(z);
+    sinY_ = sin(y);
+    cosY_ = cos(y);
+    sinX_ = sin(x);
+    cosX_ = cos(x);
+  }
+
+  //! \returns the local angular velocity of the time derivative [dz; dy; dx]
+  inline Vector3 getLocalAngularVelocity(const Vector3& diff) const {
+    return Vector3(diff(2) - sinY_*diff(0),
+                   cosY_*sinX_*diff(0) + cosX_*diff(1),
+                   cosY_*cosX_*diff(0) - sinX_*diff(1));
+  }
+
+  //! \returns the global angular velocity of the time derivative [dz; dy; dx]
+  inline Vector3 getGlobalAngularVelocity(const Vector3& diff) const {
+    return Vector3(cosZ_*cosY_*diff(2) - sinZ_*diff(1),
+                   sinZ_*cosY_*diff(2) + cosZ_*diff(1),
+                   diff(0) - sinY_*diff(2));
+  }
+
+  //! \returns the time derivative [dz; dy; dx] of the local angular velocity
+  inline Vector3 getDiffFromLocalAngularVelocity(const Vector3& angularVelocity) const {
+    const PrimType_ diffZ = (sinX_*angularVelocity(1) + cosX_*angularVelocity(2))*getInverseCosY();
+    return Vector3(diffZ,
+                   cosX_*angularVelocity(1) - sinX_*angularVelocity(2),
+                   angularVelocity(0) + sinY_*diffZ);
+  }
+
+  //! \returns the time derivative [dz; dy; dx] of the global angular velocity
+  inline Vector3 getDiffFromGlobalAngularVelocity(const Vector3& angularVelocity) const {
+    const PrimType_ diffX = (cosZ_*angularVelocity(0) + sinZ_*angularVelocity(1))*getInverseCosY();
+    return Vector3(angularVelocity(2) + sinY_*diffX,
+                   cosZ_*angularVelocity(1) - sinZ_*angularVelocity(0),
+                   diffX);
+  }
+
+  /*! \returns the local angular acceleration of the second time derivative [ddz; ddy; ddx]
+   *  \param diff    time derivative [dz; dy; dx]
+   *  \param ddiff   second time derivative [ddz; ddy; ddx]
+   */
+  inline Vector3 getLocalAngularAcceleration(const Vector3& diff, const Vector3& ddiff) const {
+    return getLocalAngularVelocity(ddiff) + getLocalAngularAccelerationOfDiff(diff);
+  }
+
+  /*! \returns the global angular acceleration of the second time derivative [ddz; ddy; ddx]
+   *  \param diff    time derivative [dz; dy; dx]
+   *  \param ddiff   second time derivative [ddz; ddy; ddx]
+   */
+  inline Vector3 getGlobalAngularAcceleration(const Vector3& diff, const Vector3& ddiff) const {
+    return getGlobalAngularVelocity(ddiff) + getGlobalAngularAccelerationOfDiff(diff);
+  }
+
+  /*! \returns the second time derivative [ddz; ddy; ddx] of the local angular acceleration
+   *  \param diff                  time derivative [dz; dy; dx]
+   *  \param angularAcceleration   local angular acceleration
+   */
+  inline Vector3 getDDiffFromLocalAngularAcceleration(const Vector3& diff, const Vector3& angularAcceleration) const {
+    return getDiffFromLocalAngularVelocity(angularAcceleration - getLocalAngularAccelerationOfDiff(diff));
+  }
+
+  /*! \returns the second time derivative [ddz; ddy; ddx] of the global angular acceleration
+   *  \param diff                  time derivative [dz; dy; dx]
+   *  \param angularAcceleration   global angular acceleration
+   */
+  inline Vector3 getDDiffFromGlobalAngularAcceleration(const Vector3& diff, const Vector3& angularAcceleration) const {
+    return getDiffFromGlobalAngularVelocity(angularAcceleration - getGlobalAngularAccelerationOfDiff(diff));
+  }
+
+  Matrix3 getMappingFromDiffToLocalAngularVelocity() const {
+    Matrix3 mat;
+    mat << -sinY_, 0.0, 1.0,
+           cosY_*sinX_, cosX_, 0.0,
+           cosX_*cosY_, -sinX_, 0.0;
+    return mat;
+  }
+
+  Matrix3 getMappingFromLocalAngularVelocityToDiff() const {
+    const PrimType_ inverseCosY = getInverseCosY();
+    Matrix3 mat;
+    mat << 0.0, inverseCosY*sinX_, inverseCosY*cosX_,
+           0.0, cosX_, -sinX_,
+           1.0, inverseCosY*sinX_*sinY_, inverseCosY*cosX_*sinY_;
+    return mat;
+  }
+
+  Matrix3 getMappingFromDiffToGlobalAngularVelocity() const {
+    Matrix3 mat;
+    mat << 0.0, -sinZ_, cosZ_*cosY_,
+           0.0, cosZ_, sinZ_*cosY_,
+           1.0, 0.0, -sinY_;
+    return mat;
+  }
+
+  Matrix3 getMappingFromGlobalAngularVelocityToDiff() const {
+    const PrimType_ inverseCosY = getInverseCosY();
+    Matrix3 mat;
+    mat << inverseCosY*sinY_*cosZ_, inverseCosY*sinY_*sinZ_, 1.0,
+           -sinZ_, cosZ_, 0.0,
+           inverseCosY*cosZ_, inverseCosY*sinZ_, 0.0;
+    return mat;
+  }
+
+ private:
+  inline PrimType_ getInverseCosY() const {
+    KINDR_ASSERT_TRUE_HOT(std::runtime_error, cosY_ != PrimType_(0.0), "Gimbal lock: cos(y) is zero!");
+    return PrimType_(1.0)/cosY_;
+  }
+
+  //! \returns the local angular acceleration due to the change of the mapping, i.e. dE/dt*diff
+  inline Vector3 getLocalAngularAccelerationOfDiff(const Vector3& diff) const {
+    return Vector3(-cosY_*diff(1)*diff(0),
+                   (cosY_*cosX_*diff(2) - sinY_*sinX_*diff(1))*diff(0) - sinX_*diff(2)*diff(1),
+                   -(sinY_*cosX_*diff(1) + cosY_*sinX_*diff(2))*diff(0) - cosX_*diff(2)*diff(1));
+  }
+
+  //! \returns the global angular acceleration due to the change of the mapping, i.e. dE/dt*diff
+  inline Vector3 getGlobalAngularAccelerationOfDiff(const Vector3& diff) const {
+    return Vector3(-(sinZ_*cosY_*diff(0) + cosZ_*sinY_*diff(1))*diff(2) - cosZ_*diff(0)*diff(1),
+                   (cosZ_*cosY_*diff(0) - sinZ_*sinY_*diff(1))*diff(2) - sinZ_*diff(0)*diff(1),
+                   -cosY_*diff(1)*diff(2));
+  }
+
+  PrimType_ sinZ_;
+  PrimType_ cosZ_;
+  PrimType_ sinY_;
+  PrimType_ cosY_;
+  PrimType_ sinX_;
+  PrimType_ cosX_;
+};
+
+} // namespace internal
+
 /*! \class EulerAnglesZyx
  *  \brief Implementation of Euler angles (Z-Y'-X'' / yaw-pitch-roll) rotation based on Eigen::Matrix<Scalar, 3, 1>
  *
@@ -69,6 +227,9 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
    *  Float/Double
    */
   typedef PrimType_ Scalar;
+  /*! \brief The mappings between the time derivative and the angular velocity.
+   */
+  typedef internal::EulerAnglesZyxRateMapping<PrimType_> RateMapping;
 
   /*! \brief Euler angles as 3x1-matrix
    */
@@ -101,7 +262,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
    */
   template<typename OtherDerived_>
   inline explicit EulerAnglesZyx(const RotationBase<OtherDerived_>& other)
-    : zyx_(internal::ConversionTraits<EulerAnglesZyx, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    : zyx_(internal::convertRotation<EulerAnglesZyx, OtherDerived_>(other.derived()).toImplementation()) {
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -110,7 +271,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
    */
   template<typename OtherDerived_>
   EulerAnglesZyx& operator =(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<EulerAnglesZyx, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<EulerAnglesZyx, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -121,7 +282,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
    */
   template<typename OtherDerived_>
   EulerAnglesZyx& operator ()(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<EulerAnglesZyx, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<EulerAnglesZyx, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -323,58 +484,63 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
    *  \returns copy of the Euler angles rotation which is unique
    */
   EulerAnglesZyx getUnique() const {
-    Base zyx(kindr::floatingPointModulo(z()+M_PI,2*M_PI)-M_PI,
-             kindr::floatingPointModulo(y()+M_PI,2*M_PI)-M_PI,
-             kindr::floatingPointModulo(x()+M_PI,2*M_PI)-M_PI); // wrap all angles into [-pi,pi)
+    KINDR_INSTRUMENT(Unique);
+    Base zyx(kindr::wrapPosNegPI(z()),
+             kindr::wrapPosNegPI(y()),
+             kindr::wrapPosNegPI(x())); // wrap all angles into [-pi,pi)
 
-    const double tol = 1e-3;
+    const Scalar pi = static_cast<Scalar>(M_PI);
+    const Scalar halfPi = static_cast<Scalar>(M_PI/2);
+    const Scalar tol = static_cast<Scalar>(1e-3);
 
     // wrap angles into [-pi,pi),[-pi/2,pi/2),[-pi,pi)
-    if(zyx.y() < -M_PI/2 - tol)
+    if(zyx.y() < -halfPi - tol)
     {
-      if(zyx.x() < 0) {
-        zyx.x() = zyx.x() + M_PI;
+      if(zyx.x() < Scalar(0)) {
+        zyx.x() = zyx.x() + pi;
       } else {
-        zyx.x() = zyx.x() - M_PI;
+        zyx.x() = zyx.x() - pi;
       }
 
-      zyx.y() = -(zyx.y() + M_PI);
+      zyx.y() = -(zyx.y() + pi);
 
-      if(zyx.z() < 0) {
-        zyx.z() = zyx.z() + M_PI;
+      if(zyx.z() < Scalar(0)) {
+        zyx.z() = zyx.z() + pi;
       } else {
-        zyx.z() = zyx.z() - M_PI;
+        zyx.z() = zyx.z() - pi;
       }
     }
-    else if(-M_PI/2 - tol <= zyx.y() && zyx.y() <= -M_PI/2 + tol)
+    else if(-halfPi - tol <= zyx.y() && zyx.y() <= -halfPi + tol)
     {
-      zyx.x() -= zyx.z();
-      zyx.z() = 0;
+      // at the gimbal lock, the rotation only depends on yaw + roll
+      zyx.x() += zyx.z();
+      zyx.z() = Scalar(0);
     }
-    else if(-M_PI/2 + tol < zyx.y() && zyx.y() < M_PI/2 - tol)
+    else if(-halfPi + tol < zyx.y() && zyx.y() < halfPi - tol)
     {
       // ok
     }
-    else if(M_PI/2 - tol <= zyx.y() && zyx.y() <= M_PI/2 + tol)
+    else if(halfPi - tol <= zyx.y() && zyx.y() <= halfPi + tol)
     {
       // todo: M_PI/2 should not be in range, other formula?
-      zyx.x() += zyx.z();
-      zyx.z() = 0;
+      // at the gimbal lock, the rotation only depends on yaw - roll
+      zyx.x() -= zyx.z();
+      zyx.z() = Scalar(0);
     }
     else // M_PI/2 + tol < zyx.y()
     {
-      if(zyx.x() < 0) {
-        zyx.x() = zyx.x() + M_PI;
+      if(zyx.x() < Scalar(0)) {
+        zyx.x() = zyx.x() + pi;
       } else {
-        zyx.x() = zyx.x() - M_PI;
+        zyx.x() = zyx.x() - pi;
       }
 
-      zyx.y() = -(zyx.y() - M_PI);
+      zyx.y() = -(zyx.y() - pi);
 
-      if(zyx.z() < 0) {
-        zyx.z() = zyx.z() + M_PI;
+      if(zyx.z() < Scalar(0)) {
+        zyx.z() = zyx.z() + pi;
       } else {
-        zyx.z() = zyx.z() - M_PI;
+        zyx.z() = zyx.z() - pi;
       }
     }
 
@@ -390,46 +556,28 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
   }
 
 
+  /*! \brief Gets the sines and cosines of the angles for the mappings between the time derivative and the angular
+   *  velocity. Use it to apply several mappings or to avoid building the matrices.
+   *  \returns mapping
+   */
+  RateMapping getRateMapping() const {
+    return RateMapping(z(), y(), x());
+  }
+
   typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToLocalAngularVelocity() const {
-    using std::sin;
-    using std::cos;
-    Eigen::Matrix<PrimType_, 3, 3> mat =  Eigen::Matrix<PrimType_, 3, 3>::Zero();
-    const PrimType_ x = this->x();
-    const PrimType_ y = this->y();
-    const PrimType_ z = this->z();
-    const PrimType_ t2 = cos(x);
-    const PrimType_ t3 = cos(y);
-    const PrimType_ t4 = sin(x);
-    mat(0, 0) = -sin(y);
-    mat(0, 2) = 1.0;
-    mat(1, 0) = t3*t4;
-    mat(1, 1) = t2;
-    mat(2, 0) = t2*t3;
-    mat(2, 1) = -t4;
-    return mat;
+    return getRateMapping().getMappingFromDiffToLocalAngularVelocity();
   }
 
   typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromLocalAngularVelocityToDiff() const {
-    using std::sin;
-    using std::cos;
-    Eigen::Matrix<PrimType_, 3, 3> mat =  Eigen::Matrix<PrimType_, 3, 3>::Zero();
-    const PrimType_ x = this->x();
-    const PrimType_ y = this->y();
-    const PrimType_ z = this->z();
-    const PrimType_ t2 = cos(y);
-    const PrimType_ t3 = 1.0/t2;
-    KINDR_ASSERT_TRUE(std::runtime_error, t2 != PrimType_(0.0), "Gimbal lock: cos(y) is zero!");
-    const PrimType_ t4 = cos(x);
-    const PrimType_ t5 = sin(x);
-    const PrimType_ t6 = sin(y);
-    mat(0,1) = t3*t5;
-    mat(0,2) = t3*t4;
-    mat(1,1) = t4;
-    mat(1,2) = -t5;
-    mat(2,0) = 1.0;
-    mat(2,1) = t3*t5*t6;
-    mat(2,2) = t3*t4*t6;
-    return mat;
+    return getRateMapping().getMappingFromLocalAngularVelocityToDiff();
+  }
+
+  typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToGlobalAngularVelocity() const {
+    return getRateMapping().getMappingFromDiffToGlobalAngularVelocity();
+  }
+
+  typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromGlobalAngularVelocityToDiff() const {
+    return getRateMapping().getMappingFromGlobalAngularVelocityToDiff();
   }
 
   /*! \brief Concenation operator.
@@ -498,6 +646,27 @@ class get_matrix3X<EulerAnglesZyx<PrimType_>>{
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Conversion Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/*! \brief Gets the Euler angles [yaw; pitch; roll] from the elements of a rotation matrix
+ *  (only for advanced users)
+ *
+ *  The angles are extracted in closed form with yaw and roll in [-pi,pi] and pitch in [-pi/2,pi/2].
+ *  In gimbal lock (pitch = +-pi/2), only the difference or the sum of yaw and roll is defined
+ *  and roll is set to zero if the cosine of the pitch is below getGimbalLockThreshold().
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 3, 1> getEulerAnglesZyxFromRotationMatrixElements(PrimType_ r00, PrimType_ r01, PrimType_ r10, PrimType_ r11,
+                                                                                  PrimType_ r20, PrimType_ r21, PrimType_ r22) {
+  using std::atan2;
+  using std::sqrt;
+  const PrimType_ cosPitch = sqrt(r00*r00 + r10*r10);
+  const PrimType_ pitch = atan2(-r20, cosPitch);
+  if (cosPitch < getGimbalLockThreshold<PrimType_>()) {
+    return Eigen::Matrix<PrimType_, 3, 1>(atan2(-r01, r11), pitch, PrimType_(0.0));
+  }
+  return Eigen::Matrix<PrimType_, 3, 1>(atan2(r10, r00), pitch, atan2(r21, r22));
+}
+
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesZyx<DestPrimType_>, AngleAxis<SourcePrimType_>> {
  public:
@@ -510,7 +679,9 @@ template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesZyx<DestPrimType_>, RotationMatrix<SourcePrimType_>> {
  public:
   inline static EulerAnglesZyx<DestPrimType_> convert(const RotationMatrix<SourcePrimType_>& R) {
-    return EulerAnglesZyx<DestPrimType_>(RotationQuaternion<DestPrimType_>(R));
+    const Eigen::Matrix<SourcePrimType_, 3, 3>& m = R.toImplementation();
+    return EulerAnglesZyx<DestPrimType_>(getEulerAnglesZyxFromRotationMatrixElements<SourcePrimType_>(
+        m(0,0), m(0,1), m(1,0), m(1,1), m(2,0), m(2,1), m(2,2)).template cast<DestPrimType_>());
   }
 };
 
@@ -526,8 +697,14 @@ template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesZyx<DestPrimType_>, RotationQuaternion<SourcePrimType_>> {
  public:
   inline static EulerAnglesZyx<DestPrimType_> convert(const RotationQuaternion<SourcePrimType_>& q) {
-    const Eigen::Matrix<DestPrimType_, 3, 1> vec = (q.toImplementation().toRotationMatrix().eulerAngles(2, 1, 0)).template cast<DestPrimType_>();
-    return EulerAnglesZyx<DestPrimType_>(vec(0), vec(1), vec(2));
+    // only the required elements of the rotation matrix are computed
+    const SourcePrimType_ one = SourcePrimType_(1.0);
+    const SourcePrimType_ two = SourcePrimType_(2.0);
+    const SourcePrimType_ w = q.w(), x = q.x(), y = q.y(), z = q.z();
+    return EulerAnglesZyx<DestPrimType_>(getEulerAnglesZyxFromRotationMatrixElements<SourcePrimType_>(
+        one - two*(y*y + z*z), two*(x*y - w*z),
+        two*(x*y + w*z), one - two*(x*x + z*z),
+        two*(x*z - w*y), two*(y*z + w*x), one - two*(x*x + y*y)).template cast<DestPrimType_>());
   }
 };
 
@@ -554,7 +731,59 @@ class ConversionTraits<EulerAnglesZyx<DestPrimType_>, EulerAnglesZyx<SourcePrimT
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Rotation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class RotationTraits<RotationBase<EulerAnglesZyx<PrimType_>>> : public DirectRotationTraits<EulerAnglesZyx<PrimType_>, 2> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
 
+  /*! \brief Rotates a vector by the three elementary rotations without computing the rotation matrix.
+   *  v' = C_z(yaw)*C_y(pitch)*C_x(roll)*v
+   */
+  inline static Vector3 rotateVector(const EulerAnglesZyx<PrimType_>& rotation, const Vector3& vector) {
+    using std::cos;
+    using std::sin;
+    const PrimType_ cx = cos(rotation.x());
+    const PrimType_ sx = sin(rotation.x());
+    const PrimType_ cy = cos(rotation.y());
+    const PrimType_ sy = sin(rotation.y());
+    const PrimType_ cz = cos(rotation.z());
+    const PrimType_ sz = sin(rotation.z());
+
+    // Rotation about x
+    const PrimType_ x1 = vector.x();
+    const PrimType_ y1 = cx*vector.y() - sx*vector.z();
+    const PrimType_ z1 = sx*vector.y() + cx*vector.z();
+    // Rotation about y
+    const PrimType_ x2 = cy*x1 + sy*z1;
+    const PrimType_ z2 = cy*z1 - sy*x1;
+    // Rotation about z
+    return Vector3(cz*x2 - sz*y1, sz*x2 + cz*y1, z2);
+  }
+
+  /*! \brief Rotates a vector by the transposed elementary rotations without computing the inverse rotation.
+   *  v' = C_x(roll)^T*C_y(pitch)^T*C_z(yaw)^T*v
+   */
+  inline static Vector3 inverseRotateVector(const EulerAnglesZyx<PrimType_>& rotation, const Vector3& vector) {
+    using std::cos;
+    using std::sin;
+    const PrimType_ cx = cos(rotation.x());
+    const PrimType_ sx = sin(rotation.x());
+    const PrimType_ cy = cos(rotation.y());
+    const PrimType_ sy = sin(rotation.y());
+    const PrimType_ cz = cos(rotation.z());
+    const PrimType_ sz = sin(rotation.z());
+
+    // Inverse rotation about z
+    const PrimType_ x1 = cz*vector.x() + sz*vector.y();
+    const PrimType_ y1 = cz*vector.y() - sz*vector.x();
+    const PrimType_ z1 = vector.z();
+    // Inverse rotation about y
+    const PrimType_ x2 = cy*x1 - sy*z1;
+    const PrimType_ z2 = sy*x1 + cy*z1;
+    // Inverse rotation about x
+    return Vector3(x2, cx*y1 + sx*z2, cx*z2 - sx*y1);
+  }
+};
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Comparison Traits
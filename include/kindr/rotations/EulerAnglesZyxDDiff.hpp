@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/EulerAnglesZyx.hpp"
+#include "kindr/rotations/EulerAnglesZyxDiff.hpp"
+
+namespace kindr {
+
+/*! \class EulerAnglesZyxDDiff
+ * \brief Implementation of second time derivatives of Euler angles (Z,Y',X'' / yaw,pitch,roll) based on Eigen::Matrix<Scalar, 3, 1>
+ *
+ * The mappings to and from the angular acceleration are evaluated in closed form with the sines and cosines of
+ * EulerAnglesZyx::RateMapping, which also provides the first derivative mappings.
+ *
+ * The following two typedefs are provided for convenience:
+ *   - EulerAnglesZyxDDiffD for primitive type double
+ *   - EulerAnglesZyxDDiffF for primitive type float
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \ingroup rotations
+ */
+template<typename PrimType_>
+class EulerAnglesZyxDDiff {
+ private:
+  /*! \brief The base type.
+   */
+  typedef Eigen::Matrix<PrimType_, 3, 1> Base;
+
+  /*! \brief data container [yaw; pitch; roll]
+   */
+  Base zyxDDiff_;
+
+ public:
+  /*! \brief The implementation type.
+   *  The implementation type is always an Eigen object.
+   */
+  typedef Base Implementation;
+
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  /*! \brief The angular acceleration type.
+   */
+  typedef AngularAcceleration<PrimType_, 3> AngularAcceleration3;
+
+  /*! \brief Default constructor.
+   */
+  EulerAnglesZyxDDiff()
+    : zyxDDiff_(Base::Zero()) {
+  }
+
+  /*! \brief Constructor using three scalars.
+   *  \param yaw      second time derivative of first rotation angle around Z axis
+   *  \param pitch    second time derivative of second rotation angle around Y' axis
+   *  \param roll     second time derivative of third rotation angle around X'' axis
+   */
+  EulerAnglesZyxDDiff(Scalar yaw, Scalar pitch, Scalar roll)
+    : zyxDDiff_(yaw,pitch,roll) {
+  }
+
+  /*! \brief Constructor using Eigen::Matrix.
+   *  \param other   Eigen::Matrix<Scalar, 3, 1> [yaw; pitch; roll]
+   */
+  explicit EulerAnglesZyxDDiff(const Base& other)
+    : zyxDDiff_(other) {
+  }
+
+  /*! \brief Gets the second time derivative from the angular acceleration expressed in the local (body) frame.
+   *  Throws (or asserts with KINDR_NO_EXCEPTIONS) at a gimbal lock.
+   *  \param eulerAngles           Euler angles
+   *  \param eulerAnglesDiff       time derivative of the Euler angles
+   *  \param angularAcceleration   local angular acceleration
+   *  \returns second time derivative
+   */
+  static EulerAnglesZyxDDiff fromLocalAngularAcceleration(const EulerAnglesZyx<PrimType_>& eulerAngles,
+                                                          const EulerAnglesZyxDiff<PrimType_>& eulerAnglesDiff,
+                                                          const AngularAcceleration3& angularAcceleration) {
+    return EulerAnglesZyxDDiff(eulerAngles.getRateMapping().getDDiffFromLocalAngularAcceleration(eulerAnglesDiff.toImplementation(), angularAcceleration.toImplementation()));
+  }
+
+  /*! \brief Gets the second time derivative from the angular acceleration expressed in the global (inertial) frame.
+   *  Throws (or asserts with KINDR_NO_EXCEPTIONS) at a gimbal lock.
+   *  \param eulerAngles           Euler angles
+   *  \param eulerAnglesDiff       time derivative of the Euler angles
+   *  \param angularAcceleration   global angular acceleration
+   *  \returns second time derivative
+   */
+  static EulerAnglesZyxDDiff fromGlobalAngularAcceleration(const EulerAnglesZyx<PrimType_>& eulerAngles,
+                                                           const EulerAnglesZyxDiff<PrimType_>& eulerAnglesDiff,
+                                                           const AngularAcceleration3& angularAcceleration) {
+    return EulerAnglesZyxDDiff(eulerAngles.getRateMapping().getDDiffFromGlobalAngularAcceleration(eulerAnglesDiff.toImplementation(), angularAcceleration.toImplementation()));
+  }
+
+  /*! \brief Gets the angular acceleration expressed in the local (body) frame.
+   *  \param eulerAngles       Euler angles
+   *  \param eulerAnglesDiff   time derivative of the Euler angles
+   *  \returns local angular acceleration
+   */
+  AngularAcceleration3 getLocalAngularAcceleration(const EulerAnglesZyx<PrimType_>& eulerAngles,
+                                                   const EulerAnglesZyxDiff<PrimType_>& eulerAnglesDiff) const {
+    return AngularAcceleration3(eulerAngles.getRateMapping().getLocalAngularAcceleration(eulerAnglesDiff.toImplementation(), zyxDDiff_));
+  }
+
+  /*! \brief Gets the angular acceleration expressed in the global (inertial) frame.
+   *  \param eulerAngles       Euler angles
+   *  \param eulerAnglesDiff   time derivative of the Euler angles
+   *  \returns global angular acceleration
+   */
+  AngularAcceleration3 getGlobalAngularAcceleration(const EulerAnglesZyx<PrimType_>& eulerAngles,
+                                                    const EulerAnglesZyxDiff<PrimType_>& eulerAnglesDiff) const {
+    return AngularAcceleration3(eulerAngles.getRateMapping().getGlobalAngularAcceleration(eulerAnglesDiff.toImplementation(), zyxDDiff_));
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation for direct manipulation (recommended only for advanced users)
+   */
+  inline Base& toImplementation() {
+    return zyxDDiff_;
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation for direct manipulation (recommended only for advanced users)
+   */
+  inline const Base& toImplementation() const {
+    return zyxDDiff_;
+  }
+
+  inline Base& vector() {
+    return toImplementation();
+  }
+
+  inline const Base& vector() const {
+    return toImplementation();
+  }
+
+  /*! \brief Reading access to second time derivative of yaw (Z) angle.
+   *  \returns second time derivative of yaw angle (scalar) with reading access
+   */
+  inline Scalar yaw() const {
+    return toImplementation()(0);
+  }
+
+  /*! \brief Reading access to second time derivative of pitch (Y') angle.
+   *  \returns second time derivative of pitch angle (scalar) with reading access
+   */
+  inline Scalar pitch() const {
+    return toImplementation()(1);
+  }
+
+  /*! \brief Reading access to second time derivative of roll (X'') angle.
+   *  \returns second time derivative of roll angle (scalar) with reading access
+   */
+  inline Scalar roll() const {
+    return toImplementation()(2);
+  }
+
+  /*! \brief Writing access to second time derivative of yaw (Z) angle.
+   *  \returns second time derivative of yaw angle (scalar) with writing access
+   */
+  inline Scalar& yaw() {
+    return toImplementation()(0);
+  }
+
+  /*! \brief Writing access to second time derivative of pitch (Y') angle.
+   *  \returns second time derivative of pitch angle (scalar) with writing access
+   */
+  inline Scalar& pitch() {
+    return toImplementation()(1);
+  }
+
+  /*! \brief Writing access to second time derivative of roll (X'') angle.
+   *  \returns second time derivative of roll angle (scalar) with writing access
+   */
+  inline Scalar& roll() {
+    return toImplementation()(2);
+  }
+
+  /*! \brief Reading access to second time derivative of yaw (Z) angle.
+   *  \returns second time derivative of yaw angle (scalar) with reading access
+   */
+  inline Scalar z() const {
+    return toImplementation()(0);
+  }
+
+  /*! \brief Reading access to second time derivative of pitch (Y') angle.
+   *  \returns second time derivative of pitch angle (scalar) with reading access
+   */
+  inline Scalar y() const {
+    return toImplementation()(1);
+  }
+
+  /*! \brief Reading access to second time derivative of roll (X'') angle.
+   *  \returns second time derivative of roll angle (scalar) with reading access
+   */
+  inline Scalar x() const {
+    return toImplementation()(2);
+  }
+
+  /*! \brief Writing access to second time derivative of yaw (Z) angle.
+   *  \returns second time derivative of yaw angle (scalar) with writing access
+   */
+  inline Scalar& z() {
+    return toImplementation()(0);
+  }
+
+  /*! \brief Writing access to second time derivative of pitch (Y') angle.
+   *  \returns second time derivative of pitch angle (scalar) with writing access
+   */
+  inline Scalar& y() {
+    return toImplementation()(1);
+  }
+
+  /*! \brief Writing access to second time derivative of roll (X'') angle.
+   *  \returns second time derivative of roll angle (scalar) with writing access
+   */
+  inline Scalar& x() {
+    return toImplementation()(2);
+  }
+
+  /*! \brief Sets all second time derivatives to zero.
+   *  \returns reference
+   */
+  EulerAnglesZyxDDiff& setZero() {
+    this->toImplementation().setZero();
+    return *this;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *
+   *   Prints: yaw pitch roll
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const EulerAnglesZyxDDiff& ddiff) {
+    out << ddiff.toImplementation().transpose();
+    return out;
+  }
+};
+
+//! \brief Second time derivative of Euler angles with z-y-x convention and primitive type double
+typedef EulerAnglesZyxDDiff<double> EulerAnglesZyxDDiffD;
+//! \brief Second time derivative of Euler angles with z-y-x convention and primitive type float
+typedef EulerAnglesZyxDDiff<float> EulerAnglesZyxDDiffF;
+
+} // namespace kindr
@@ -265,7 +265,15 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<EulerAnglesZyxDiff<PrimType_>, LocalAngularVelocity<PrimType_>, EulerAnglesZyx<PrimType_>> {
  public:
   inline static EulerAnglesZyxDiff<PrimType_> convert(const EulerAnglesZyx<PrimType_>& eulerAngles, const LocalAngularVelocity<PrimType_>& angularVelocity) {
-    return EulerAnglesZyxDiff<PrimType_>(eulerAngles.getMappingFromLocalAngularVelocityToDiff()*angularVelocity.vector());
+    return EulerAnglesZyxDiff<PrimType_>(eulerAngles.getRateMapping().getDiffFromLocalAngularVelocity(angularVelocity.vector()));
+  }
+};
+
+template<typename PrimType_>
+class RotationDiffConversionTraits<EulerAnglesZyxDiff<PrimType_>, GlobalAngularVelocity<PrimType_>, EulerAnglesZyx<PrimType_>> {
+ public:
+  inline static EulerAnglesZyxDiff<PrimType_> convert(const EulerAnglesZyx<PrimType_>& eulerAngles, const GlobalAngularVelocity<PrimType_>& angularVelocity) {
+    return EulerAnglesZyxDiff<PrimType_>(eulerAngles.getRateMapping().getDiffFromGlobalAngularVelocity(angularVelocity.vector()));
   }
 };
 
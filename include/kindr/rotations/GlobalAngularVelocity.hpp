@@ -226,7 +226,11 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<GlobalAngularVelocity<PrimType_>, RotationQuaternionDiff<PrimType_>, RotationQuaternion<PrimType_>> {
  public:
   inline static GlobalAngularVelocity<PrimType_> convert(const RotationQuaternion<PrimType_>& rquat, const RotationQuaternionDiff<PrimType_>& rquatdiff) {
-    return GlobalAngularVelocity<PrimType_>(2.0*rquat.getGlobalQuaternionDiffMatrix()*rquatdiff.toQuaternion().vector());
+    // 2*H*dq without building H, see RotationQuaternion::getGlobalQuaternionDiffMatrix()
+    return GlobalAngularVelocity<PrimType_>(
+        PrimType_(2.0)*(-rquat.x()*rquatdiff.w() + rquat.w()*rquatdiff.x() - rquat.z()*rquatdiff.y() + rquat.y()*rquatdiff.z()),
+        PrimType_(2.0)*(-rquat.y()*rquatdiff.w() + rquat.z()*rquatdiff.x() + rquat.w()*rquatdiff.y() - rquat.x()*rquatdiff.z()),
+        PrimType_(2.0)*(-rquat.z()*rquatdiff.w() - rquat.y()*rquatdiff.x() + rquat.x()*rquatdiff.y() + rquat.w()*rquatdiff.z()));
   }
 };
 
@@ -235,7 +239,12 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<GlobalAngularVelocity<PrimType_>, RotationMatrixDiff<PrimType_>, RotationMatrix<PrimType_>> {
  public:
   inline static GlobalAngularVelocity<PrimType_> convert(const RotationMatrix<PrimType_>& rotationMatrix, const RotationMatrixDiff<PrimType_>& rotationMatrixDiff) {
-    return GlobalAngularVelocity<PrimType_>(getVectorFromSkewMatrix<PrimType_>(rotationMatrixDiff.matrix()*rotationMatrix.inverted().matrix()));
+    // Only the three entries of dR*R^T that form the skew vector are computed
+    const Eigen::Matrix<PrimType_, 3, 3>& matrix = rotationMatrix.toImplementation();
+    const Eigen::Matrix<PrimType_, 3, 3>& matrixDiff = rotationMatrixDiff.matrix();
+    return GlobalAngularVelocity<PrimType_>(matrixDiff.row(2).dot(matrix.row(1)),
+                                            matrixDiff.row(0).dot(matrix.row(2)),
+                                            matrixDiff.row(1).dot(matrix.row(0)));
   }
 };
 
@@ -244,7 +253,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<GlobalAngularVelocity<PrimType_>, EulerAnglesZyxDiff<PrimType_>, EulerAnglesZyx<PrimType_>> {
  public:
   inline static GlobalAngularVelocity<PrimType_> convert(const EulerAnglesZyx<PrimType_>& eulerAngles, const EulerAnglesZyxDiff<PrimType_>& eulerAnglesDiff) {
-    return GlobalAngularVelocity<PrimType_>(eulerAngles.getMappingFromDiffToGlobalAngularVelocity()*eulerAnglesDiff.toImplementation());
+    return GlobalAngularVelocity<PrimType_>(eulerAngles.getRateMapping().getGlobalAngularVelocity(eulerAnglesDiff.toImplementation()));
 
   }
 };
@@ -253,7 +262,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<GlobalAngularVelocity<PrimType_>, EulerAnglesXyzDiff<PrimType_>, EulerAnglesXyz<PrimType_>> {
  public:
   inline static GlobalAngularVelocity<PrimType_> convert(const EulerAnglesXyz<PrimType_>& eulerAngles, const EulerAnglesXyzDiff<PrimType_>& eulerAnglesDiff) {
-    return GlobalAngularVelocity<PrimType_>(eulerAngles.getMappingFromDiffToGlobalAngularVelocity()*eulerAnglesDiff.toImplementation());
+    return GlobalAngularVelocity<PrimType_>(eulerAngles.getRateMapping().getGlobalAngularVelocity(eulerAnglesDiff.toImplementation()));
 
 
   }
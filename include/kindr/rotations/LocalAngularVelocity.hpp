@@ -38,6 +38,7 @@
 #include "kindr/rotations/Rotation.hpp"
 #include "kindr/quaternions/Quaternion.hpp"
 #include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/vectors/VectorMap.hpp"
 
 namespace kindr {
 
@@ -203,6 +204,10 @@ typedef LocalAngularVelocity<double>  LocalAngularVelocityD;
 //! \brief 3D angular velocity with primitive type float
 typedef LocalAngularVelocity<float>  LocalAngularVelocityF;
 
+//! \brief View of a local angular velocity stored in external memory
+template<typename PrimType_, typename Stride_ = Eigen::InnerStride<1>>
+using LocalAngularVelocityMap = VectorMap<LocalAngularVelocity<PrimType_>, Stride_>;
+
 
 
 namespace internal {
@@ -222,7 +227,11 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<LocalAngularVelocity<PrimType_>, RotationQuaternionDiff<PrimType_>, RotationQuaternion<PrimType_>> {
  public:
   inline static LocalAngularVelocity<PrimType_> convert(const RotationQuaternion<PrimType_>& rquat, const RotationQuaternionDiff<PrimType_>& rquatdiff) {
-    return LocalAngularVelocity<PrimType_>(2.0*rquat.getLocalQuaternionDiffMatrix()*rquatdiff.toQuaternion().vector());
+    // 2*HBar*dq without building HBar, see RotationQuaternion::getLocalQuaternionDiffMatrix()
+    return LocalAngularVelocity<PrimType_>(
+        PrimType_(2.0)*(-rquat.x()*rquatdiff.w() + rquat.w()*rquatdiff.x() + rquat.z()*rquatdiff.y() - rquat.y()*rquatdiff.z()),
+        PrimType_(2.0)*(-rquat.y()*rquatdiff.w() - rquat.z()*rquatdiff.x() + rquat.w()*rquatdiff.y() + rquat.x()*rquatdiff.z()),
+        PrimType_(2.0)*(-rquat.z()*rquatdiff.w() + rquat.y()*rquatdiff.x() - rquat.x()*rquatdiff.y() + rquat.w()*rquatdiff.z()));
   }
 };
 
@@ -231,7 +240,12 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<LocalAngularVelocity<PrimType_>, RotationMatrixDiff<PrimType_>, RotationMatrix<PrimType_>> {
  public:
   inline static LocalAngularVelocity<PrimType_> convert(const RotationMatrix<PrimType_>& rotationMatrix, const RotationMatrixDiff<PrimType_>& rotationMatrixDiff) {
-    return LocalAngularVelocity<PrimType_>(getVectorFromSkewMatrix<PrimType_>(rotationMatrix.inverted().matrix()*rotationMatrixDiff.matrix()));
+    // Only the three entries of R^T*dR that form the skew vector are computed
+    const Eigen::Matrix<PrimType_, 3, 3>& matrix = rotationMatrix.toImplementation();
+    const Eigen::Matrix<PrimType_, 3, 3>& matrixDiff = rotationMatrixDiff.matrix();
+    return LocalAngularVelocity<PrimType_>(matrix.col(2).dot(matrixDiff.col(1)),
+                                           matrix.col(0).dot(matrixDiff.col(2)),
+                                           matrix.col(1).dot(matrixDiff.col(0)));
   }
 };
 
@@ -241,7 +255,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<LocalAngularVelocity<PrimType_>, EulerAnglesZyxDiff<PrimType_>, EulerAnglesZyx<PrimType_>> {
  public:
   inline static LocalAngularVelocity<PrimType_> convert(const EulerAnglesZyx<PrimType_>& eulerAngles, const EulerAnglesZyxDiff<PrimType_>& eulerAnglesDiff) {
-    return LocalAngularVelocity<PrimType_>(eulerAngles.getMappingFromDiffToLocalAngularVelocity()*eulerAnglesDiff.toImplementation());
+    return LocalAngularVelocity<PrimType_>(eulerAngles.getRateMapping().getLocalAngularVelocity(eulerAnglesDiff.toImplementation()));
 
   }
 };
@@ -250,7 +264,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<LocalAngularVelocity<PrimType_>, EulerAnglesXyzDiff<PrimType_>, EulerAnglesXyz<PrimType_>> {
  public:
   inline static LocalAngularVelocity<PrimType_> convert(const EulerAnglesXyz<PrimType_>& eulerAngles, const EulerAnglesXyzDiff<PrimType_>& eulerAnglesDiff) {
-    return LocalAngularVelocity<PrimType_>(eulerAngles.getMappingFromDiffToLocalAngularVelocity()*eulerAnglesDiff.toImplementation());
+    return LocalAngularVelocity<PrimType_>(eulerAngles.getRateMapping().getLocalAngularVelocity(eulerAnglesDiff.toImplementation()));
 
 
   }
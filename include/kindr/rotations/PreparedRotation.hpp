@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRight_ HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/ColumnTransformKernels.hpp"
+#include "kindr/vectors/Vector.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class PreparedRotation
+ *  \brief Rotation together with its rotation matrix, for rotating many vectors by the same rotation.
+ *
+ *  The rotation is converted to a rotation matrix and its transpose once when the handle is created, e.g. with
+ *  RotationBase::prepared(), such that rotate() and inverseRotate() are plain matrix products in every call.
+ *  The handle is a snapshot and has to be prepared again after the rotation has changed. Vectors with a physical
+ *  type keep their type when they are rotated.
+ *
+ *  \tparam Rotation_  type of the rotation
+ *  \ingroup rotations
+ */
+template<typename Rotation_>
+class PreparedRotation {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+
+  /*! \brief Constructor.
+   *  \param rotation   rotation
+   */
+  explicit PreparedRotation(const Rotation_& rotation)
+    : rotation_(rotation),
+      matrix_(RotationMatrix<Scalar>(rotation).toImplementation()),
+      conjugateMatrix_(matrix_.transpose()) {
+  }
+
+  /*! \brief Gets the rotation the handle was prepared from.
+   *  \returns rotation
+   */
+  inline const Rotation_& getRotation() const {
+    return rotation_;
+  }
+
+  /*! \brief Gets the cached rotation matrix.
+   *  \returns rotation matrix
+   */
+  inline const Matrix3& matrix() const {
+    return matrix_;
+  }
+
+  /*! \brief Gets the cached transpose of the rotation matrix, i.e. the matrix of the inverse rotation.
+   *  \returns transposed rotation matrix
+   */
+  inline const Matrix3& conjugateMatrix() const {
+    return conjugateMatrix_;
+  }
+
+  /*! \brief Gets the rotation matrix.
+   *  \returns rotation matrix
+   */
+  RotationMatrix<Scalar> getRotationMatrix() const {
+    return RotationMatrix<Scalar>(matrix_);
+  }
+
+  /*! \brief Gets the prepared inverse rotation by swapping the cached matrices.
+   *  \returns prepared inverse rotation
+   */
+  PreparedRotation inverted() const {
+    return PreparedRotation(rotation_.inverted(), conjugateMatrix_, matrix_);
+  }
+
+  /*! \brief Rotates a vector or the columns of a matrix, which may be an Eigen expression, e.g. 2*v.
+   *  \param matrix   3xN matrix or expression
+   *  \returns evaluated rotated matrix
+   */
+  template<typename OtherDerived_>
+  Eigen::Matrix<Scalar, 3, OtherDerived_::ColsAtCompileTime> rotate(const Eigen::MatrixBase<OtherDerived_>& matrix) const {
+    EIGEN_STATIC_ASSERT(OtherDerived_::RowsAtCompileTime == 3 || OtherDerived_::RowsAtCompileTime == Eigen::Dynamic, YOU_MIXED_MATRICES_OF_DIFFERENT_SIZES)
+    return matrix_*matrix;
+  }
+
+  /*! \brief Rotates a vector or the columns of a matrix, which may be an Eigen expression, in reverse.
+   *  \param matrix   3xN matrix or expression
+   *  \returns evaluated reverse rotated matrix
+   */
+  template<typename OtherDerived_>
+  Eigen::Matrix<Scalar, 3, OtherDerived_::ColsAtCompileTime> inverseRotate(const Eigen::MatrixBase<OtherDerived_>& matrix) const {
+    EIGEN_STATIC_ASSERT(OtherDerived_::RowsAtCompileTime == 3 || OtherDerived_::RowsAtCompileTime == Eigen::Dynamic, YOU_MIXED_MATRICES_OF_DIFFERENT_SIZES)
+    return conjugateMatrix_*matrix;
+  }
+
+  /*! \brief Rotates a vector with a physical type, e.g. a Position.
+   *  \param vector   vector
+   *  \returns rotated vector of the same type
+   */
+  template<enum PhysicalType PhysicalType_>
+  Vector<PhysicalType_, Scalar, 3> rotate(const Vector<PhysicalType_, Scalar, 3>& vector) const {
+    return Vector<PhysicalType_, Scalar, 3>(matrix_*vector.toImplementation());
+  }
+
+  /*! \brief Rotates a vector with a physical type in reverse.
+   *  \param vector   vector
+   *  \returns reverse rotated vector of the same type
+   */
+  template<enum PhysicalType PhysicalType_>
+  Vector<PhysicalType_, Scalar, 3> inverseRotate(const Vector<PhysicalType_, Scalar, 3>& vector) const {
+    return Vector<PhysicalType_, Scalar, 3>(conjugateMatrix_*vector.toImplementation());
+  }
+
+  /*! \brief Rotates the columns of a large 3xN matrix into a preallocated matrix, see RotationBase::rotateBatch().
+   *  \param vectors        3xN matrix
+   *  \param rotated        3xN matrix of rotated vectors
+   *  \param executor       executor distributing chunks of columns to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void rotateBatch(const Eigen::Ref<const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>>& vectors,
+                   Eigen::Ref<Eigen::Matrix<Scalar, 3, Eigen::Dynamic>> rotated,
+                   const Executor_& executor = Executor_()) const {
+    internal::ColumnTransformKernels<Scalar>::transform(matrix_, Eigen::Matrix<Scalar, 3, 1>::Zero(), vectors, rotated, executor);
+  }
+
+  /*! \brief Rotates the columns of a large 3xN matrix in reverse into a preallocated matrix.
+   *  \param vectors        3xN matrix
+   *  \param rotated        3xN matrix of reverse rotated vectors
+   *  \param executor       executor distributing chunks of columns to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void inverseRotateBatch(const Eigen::Ref<const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>>& vectors,
+                          Eigen::Ref<Eigen::Matrix<Scalar, 3, Eigen::Dynamic>> rotated,
+                          const Executor_& executor = Executor_()) const {
+    internal::ColumnTransformKernels<Scalar>::transform(conjugateMatrix_, Eigen::Matrix<Scalar, 3, 1>::Zero(), vectors, rotated, executor);
+  }
+
+ private:
+  PreparedRotation(const Rotation_& rotation, const Matrix3& matrix, const Matrix3& conjugateMatrix)
+    : rotation_(rotation),
+      matrix_(matrix),
+      conjugateMatrix_(conjugateMatrix) {
+  }
+
+  //! Rotation the handle was prepared from
+  Rotation_ rotation_;
+  //! Rotation matrix
+  Matrix3 matrix_;
+  //! Transpose of the rotation matrix
+  Matrix3 conjugateMatrix_;
+};
+
+} // namespace kindr
@@ -28,33 +28,17 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "kindr/common/common.hpp"
 #include "kindr/math/LinearAlgebra.hpp"
 #include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/RotationFwd.hpp"
 #include "kindr/rotations/RotationBase.hpp"
 #include "kindr/vectors/VectorBase.hpp"
 
 namespace kindr {
 
-template<typename PrimType_>
-class AngleAxis;
-
-template<typename PrimType_>
-class RotationVector;
-
-template<typename PrimType_>
-class RotationQuaternion;
-
-template<typename PrimType_>
-class RotationMatrix;
-
-template<typename PrimType_>
-class EulerAnglesZyx;
-
-template<typename PrimType_>
-class EulerAnglesXyz;
-
-
 namespace internal {
 
 template<typename PrimType_>
@@ -68,18 +52,43 @@ class get_scalar<Eigen::Matrix<PrimType_, 3, 1>> {
  * Multiplication Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/*! \brief Gets the parameterization in which two rotations are multiplied
+ *  \class get_multiplication_intermediate
+ *  (only for advanced users)
+ *
+ *  Rotations are multiplied as rotation quaternions except if the result is a rotation matrix and the right-hand side
+ *  is cheaply convertible to a rotation matrix. In this case, the matrices are multiplied, which avoids
+ *  the matrix-to-quaternion extractions and the quaternion-to-matrix conversion of the result.
+ */
+template<typename Left_, typename Right_>
+class get_multiplication_intermediate {
+ public:
+  typedef RotationQuaternion<typename Left_::Scalar> Intermediate;
+};
+
+template<typename LeftPrimType_, typename RightPrimType_>
+class get_multiplication_intermediate<RotationMatrix<LeftPrimType_>, RotationMatrix<RightPrimType_>> {
+ public:
+  typedef RotationMatrix<LeftPrimType_> Intermediate;
+};
+
+template<typename LeftPrimType_, typename RightPrimType_>
+class get_multiplication_intermediate<RotationMatrix<LeftPrimType_>, RotationQuaternion<RightPrimType_>> {
+ public:
+  typedef RotationMatrix<LeftPrimType_> Intermediate;
+};
+
 /*! \brief Multiplication of two rotations with different parameterizations
  */
 template<typename Left_, typename Right_>
 class MultiplicationTraits<RotationBase<Left_>, RotationBase<Right_> > {
  public:
-  //! Default multiplication of rotations converts the representations of the rotations to rotation quaternions and multiplies them
-  inline static Left_ mult(const RotationBase<Left_>& lhs, const RotationBase<Right_>& rhs) {
-      return Left_(RotationQuaternion<typename Left_::Scalar>(
-                  (RotationQuaternion<typename Left_::Scalar>(lhs.derived())).toImplementation() *
-                  (RotationQuaternion<typename Right_::Scalar>(rhs.derived())).toImplementation()
-                  ));
+  typedef typename get_multiplication_intermediate<Left_, Right_>::Intermediate Intermediate;
 
+  //! Default multiplication of rotations converts the representations of the rotations to the intermediate parameterization and multiplies them
+  inline static Left_ mult(const RotationBase<Left_>& lhs, const RotationBase<Right_>& rhs) {
+    KINDR_INSTRUMENT(MultiplicationRoundTrip);
+    return Left_(MultiplicationTraits<RotationBase<Intermediate>, RotationBase<Intermediate>>::mult(Intermediate(lhs.derived()), Intermediate(rhs.derived())));
   }
 };
 
@@ -88,13 +97,12 @@ class MultiplicationTraits<RotationBase<Left_>, RotationBase<Right_> > {
 template<typename LeftAndRight_>
 class MultiplicationTraits<RotationBase<LeftAndRight_>, RotationBase<LeftAndRight_> > {
  public:
+  typedef RotationQuaternion<typename LeftAndRight_::Scalar> Intermediate;
+
   //! Default multiplication of rotations converts the representations of the rotations to rotation quaternions and multiplies them
   inline static LeftAndRight_ mult(const RotationBase<LeftAndRight_>& lhs, const RotationBase<LeftAndRight_>& rhs) {
-      return LeftAndRight_(RotationQuaternion<typename LeftAndRight_::Scalar>(
-                          (RotationQuaternion<typename LeftAndRight_::Scalar>(lhs.derived())).toImplementation() *
-                          (RotationQuaternion<typename LeftAndRight_::Scalar>(rhs.derived())).toImplementation()
-                          ));
-
+    KINDR_INSTRUMENT(MultiplicationRoundTrip);
+    return LeftAndRight_(MultiplicationTraits<RotationBase<Intermediate>, RotationBase<Intermediate>>::mult(Intermediate(lhs.derived()), Intermediate(rhs.derived())));
   }
 };
 
@@ -116,21 +124,120 @@ class RotationTraits<RotationBase<Rotation_>> {
   inline static Vector_ rotate(const RotationBase<Rotation_>& rotation, const Vector_& vector){
     return static_cast<Vector_>(rotation.derived().rotate(vector.toImplementation()));
   }
+  //! Default inverse rotation operator multiplies the matrix with the transpose of the rotation matrix instead of inverting the rotation
+  template<typename get_matrix3X<Rotation_>::IndexType Cols>
+  inline static typename get_matrix3X<Rotation_>::template Matrix3X<Cols> inverseRotate(const RotationBase<Rotation_>& rotation, const typename internal::get_matrix3X<Rotation_>::template Matrix3X<Cols>& m){
+      return RotationMatrix<typename Rotation_::Scalar>(rotation.derived()).toImplementation().transpose()*m;
+  }
+  //! Default inverse rotation operator multiplies the vector with the transpose of the rotation matrix instead of inverting the rotation
+  template<typename Vector_>
+  inline static Vector_ inverseRotate(const RotationBase<Rotation_>& rotation, const Vector_& vector){
+    return static_cast<Vector_>(rotation.derived().inverseRotate(vector.toImplementation()));
+  }
+
+};
+
+/*! \brief Rotation operator for parameterizations that can rotate a vector directly
+ *  \class DirectRotationTraits
+ *  (only for advanced users)
+ *
+ *  The rotation traits of a parameterization derive from this class and provide
+ *  inline static Vector3 rotateVector(const Rotation_& rotation, const Vector3& vector) and
+ *  inline static Vector3 inverseRotateVector(const Rotation_& rotation, const Vector3& vector).
+ *  Blocks with fewer than MinColsForMatrix_ columns are rotated column by column with these kernels,
+ *  larger blocks are multiplied with a rotation matrix (or its transpose) that is computed once.
+ */
+template<typename Rotation_, int MinColsForMatrix_>
+class DirectRotationTraits {
+ public:
+  //! Minimal number of columns for which a rotation matrix is computed
+  static constexpr int minColsForMatrix = MinColsForMatrix_;
+
+  template<typename get_matrix3X<Rotation_>::IndexType Cols>
+  inline static typename get_matrix3X<Rotation_>::template Matrix3X<Cols> rotate(const RotationBase<Rotation_>& rotation, const typename internal::get_matrix3X<Rotation_>::template Matrix3X<Cols>& m){
+    if (m.cols() < MinColsForMatrix_) {
+      typename get_matrix3X<Rotation_>::template Matrix3X<Cols> rotated(3, m.cols());
+      for (int i = 0; i < m.cols(); ++i) {
+        rotated.col(i) = RotationTraits<RotationBase<Rotation_>>::rotateVector(rotation.derived(), m.col(i));
+      }
+      return rotated;
+    }
+    return RotationMatrix<typename Rotation_::Scalar>(rotation.derived()).toImplementation()*m;
+  }
+
+  template<typename Vector_>
+  inline static Vector_ rotate(const RotationBase<Rotation_>& rotation, const Vector_& vector){
+    return static_cast<Vector_>(rotation.derived().rotate(vector.toImplementation()));
+  }
+
+  template<typename get_matrix3X<Rotation_>::IndexType Cols>
+  inline static typename get_matrix3X<Rotation_>::template Matrix3X<Cols> inverseRotate(const RotationBase<Rotation_>& rotation, const typename internal::get_matrix3X<Rotation_>::template Matrix3X<Cols>& m){
+    if (m.cols() < MinColsForMatrix_) {
+      typename get_matrix3X<Rotation_>::template Matrix3X<Cols> rotated(3, m.cols());
+      for (int i = 0; i < m.cols(); ++i) {
+        rotated.col(i) = RotationTraits<RotationBase<Rotation_>>::inverseRotateVector(rotation.derived(), m.col(i));
+      }
+      return rotated;
+    }
+    return RotationMatrix<typename Rotation_::Scalar>(rotation.derived()).toImplementation().transpose()*m;
+  }
 
+  template<typename Vector_>
+  inline static Vector_ inverseRotate(const RotationBase<Rotation_>& rotation, const Vector_& vector){
+    return static_cast<Vector_>(rotation.derived().inverseRotate(vector.toImplementation()));
+  }
 };
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Comparison Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
-/*! \brief Compares two rotations.
+/*! \brief Parameterization in which two rotations of different types are compared.
  *
+ *  The rotations are compared as rotation matrices if one of them is a rotation matrix, since the conversion to a
+ *  matrix is cheaper than the one from a matrix, and as rotation quaternions otherwise. Only the rotations which are
+ *  not already of this type are converted.
+ *  (only for advanced users)
+ */
+template<typename Left_, typename Right_>
+class ComparisonSpace {
+ public:
+  typedef typename Left_::Scalar Scalar;
+  typedef typename std::conditional<std::is_same<Left_, RotationMatrix<Scalar>>::value || std::is_same<Right_, RotationMatrix<typename Right_::Scalar>>::value,
+                                    RotationMatrix<Scalar>, RotationQuaternion<Scalar>>::type Rotation;
+
+  //! Returns the rotation itself if it is already of the type of the comparison
+  inline static const Rotation& get(const Rotation& rotation) {
+    return rotation;
+  }
+
+  //! Converts the rotation to the type of the comparison
+  template<typename Other_>
+  inline static Rotation get(const RotationBase<Other_>& rotation) {
+    return Rotation(rotation.derived());
+  }
+};
+
+/*! \brief Compares two rotations.
+ *  Rotations of the same type are compared coefficient-wise, rotations of different types in the parameterization
+ *  given by ComparisonSpace.
  */
 template<typename Left_, typename Right_>
 class ComparisonTraits<RotationBase<Left_>, RotationBase<Right_>> {
  public:
+  typedef ComparisonSpace<Left_, Right_> Space;
+  typedef typename Space::Rotation Rotation;
+
   inline static bool isEqual(const RotationBase<Left_>& left, const RotationBase<Right_>& right) {
-    return left.derived().toImplementation() == RotationBase<Left_>(right).derived().toImplementation();
+    return ComparisonTraits<RotationBase<Rotation>, RotationBase<Rotation>>::isEqual(Space::get(left.derived()), Space::get(right.derived()));
+  }
+};
+
+template<typename Rotation_>
+class ComparisonTraits<RotationBase<Rotation_>, RotationBase<Rotation_>> {
+ public:
+  inline static bool isEqual(const RotationBase<Rotation_>& left, const RotationBase<Rotation_>& right) {
+    return left.derived().toImplementation() == right.derived().toImplementation();
   }
 };
 
@@ -146,9 +253,11 @@ class MapTraits<RotationBase<Rotation_>> {
     return Rotation_(RotationVector<Scalar>(vector));
   }
 
+  /*! \brief Gets the unique rotation vector from the logarithmic map of the rotation quaternion, which is unique by construction.
+   */
   inline static typename internal::get_matrix3X<Rotation_>::template Matrix3X<1> get_logarithmic_map(const Rotation_& rotation) {
     typedef typename get_scalar<Rotation_>::Scalar Scalar;
-    return RotationVector<Scalar>(rotation).getUnique().toImplementation(); // unique is required
+    return MapTraits<RotationBase<RotationQuaternion<Scalar>>>::get_logarithmic_map(RotationQuaternion<Scalar>(rotation));
   }
 
 };
@@ -157,15 +266,21 @@ class MapTraits<RotationBase<Rotation_>> {
  * Box Operation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/*! \brief Box operations computed in the parameterization in which the rotations are multiplied (see get_multiplication_intermediate),
+ *  such that the intermediate concatenation is neither converted back to the parameterization of the left-hand side nor made unique again.
+ */
 template<typename Left_, typename Right_>
 class BoxOperationTraits<RotationBase<Left_>, RotationBase<Right_>> {
  public:
+  typedef typename get_multiplication_intermediate<Left_, Left_>::Intermediate Intermediate;
+
   inline static typename internal::get_matrix3X<Left_>::template Matrix3X<1> box_minus(const RotationBase<Left_>& lhs, const RotationBase<Right_>& rhs) {
-    return (lhs.derived()*rhs.derived().inverted()).logarithmicMap();
+    const Intermediate difference = Intermediate(lhs.derived())*Intermediate(rhs.derived()).inverted();
+    return MapTraits<RotationBase<Intermediate>>::get_logarithmic_map(difference);
   }
 
   inline static  Left_ box_plus(const RotationBase<Left_>& rotation, const typename internal::get_matrix3X<Left_>::template Matrix3X<1>& vector) {
-    return Left_(MapTraits<RotationBase<Left_>>::set_exponential_map(vector)*rotation.derived());
+    return Left_(MapTraits<RotationBase<Intermediate>>::set_exponential_map(vector)*Intermediate(rotation.derived()));
   }
 };
 
@@ -175,12 +290,86 @@ class BoxOperationTraits<RotationBase<Left_>, RotationBase<Right_>> {
  * SetFromVectors Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/*! \brief Minimal rotation, i.e. about the common normal, which rotates a unit vector a onto a unit vector b.
+ *  With d = a.b and c = a x b, the rotation is q = [1+d; c]/|[1+d; c]|, which is R = d*I + [c]x + c*c^T/(1+d)
+ *  for exact unit vectors. The quaternion is normalized with its norm instead of sqrt(2*(1+d)) and the matrix is
+ *  computed from the unnormalized quaternion with the homogeneous formula, which keeps both orthonormal if 1+d is
+ *  small and inaccurate.
+ *  If the vectors are antiparallel, the rotation by pi about a unit vector orthogonal to a is used.
+ *  Other parameterizations are converted from the rotation quaternion.
+ *  (only for advanced users)
+ */
+template<typename Rotation_>
+class UnitVectorsRotationTraits {
+ public:
+  template<typename PrimType_>
+  inline static Rotation_ get(const Eigen::Matrix<PrimType_, 3, 1>& a, const Eigen::Matrix<PrimType_, 3, 1>& b) {
+    return Rotation_(UnitVectorsRotationTraits<RotationQuaternion<PrimType_>>::get(a, b));
+  }
+};
+
+template<typename PrimType_>
+class UnitVectorsRotationTraits<RotationQuaternion<PrimType_>> {
+ public:
+  inline static RotationQuaternion<PrimType_> get(const Eigen::Matrix<PrimType_, 3, 1>& a, const Eigen::Matrix<PrimType_, 3, 1>& b) {
+    using std::sqrt;
+    const PrimType_ onePlusD = PrimType_(1) + a.dot(b);
+    if (KINDR_LIKELY(onePlusD > NumTraits<PrimType_>::dummy_precision())) {
+      const Eigen::Matrix<PrimType_, 3, 1> c = a.cross(b);
+      const PrimType_ factor = PrimType_(1)/sqrt(onePlusD*onePlusD + c.squaredNorm());
+      return RotationQuaternion<PrimType_>(onePlusD*factor, c.x()*factor, c.y()*factor, c.z()*factor);
+    }
+    const Eigen::Matrix<PrimType_, 3, 1> axis = a.unitOrthogonal();
+    return RotationQuaternion<PrimType_>(PrimType_(0), axis.x(), axis.y(), axis.z());
+  }
+};
+
+template<typename PrimType_>
+class UnitVectorsRotationTraits<RotationMatrix<PrimType_>> {
+ public:
+  inline static RotationMatrix<PrimType_> get(const Eigen::Matrix<PrimType_, 3, 1>& a, const Eigen::Matrix<PrimType_, 3, 1>& b) {
+    const PrimType_ onePlusD = PrimType_(1) + a.dot(b);
+    Eigen::Matrix<PrimType_, 3, 3> R;
+    if (KINDR_LIKELY(onePlusD > NumTraits<PrimType_>::dummy_precision())) {
+      // homogeneous in [1+d; c], i.e. orthonormal even if 1+d is inaccurate for nearly antiparallel vectors
+      const Eigen::Matrix<PrimType_, 3, 1> c = a.cross(b);
+      const PrimType_ cSquaredNorm = c.squaredNorm();
+      const PrimType_ k = PrimType_(2)/(onePlusD*onePlusD + cSquaredNorm);
+      const PrimType_ e = PrimType_(1) - k*cSquaredNorm;
+      const PrimType_ ks = k*onePlusD;
+      const Eigen::Matrix<PrimType_, 3, 1> kc = k*c;
+      const Eigen::Matrix<PrimType_, 3, 1> ksc = ks*c;
+      R(0,0) = e + kc.x()*c.x();        R(0,1) = kc.x()*c.y() - ksc.z(); R(0,2) = kc.x()*c.z() + ksc.y();
+      R(1,0) = kc.x()*c.y() + ksc.z(); R(1,1) = e + kc.y()*c.y();        R(1,2) = kc.y()*c.z() - ksc.x();
+      R(2,0) = kc.x()*c.z() - ksc.y(); R(2,1) = kc.y()*c.z() + ksc.x(); R(2,2) = e + kc.z()*c.z();
+    } else {
+      const Eigen::Matrix<PrimType_, 3, 1> axis = a.unitOrthogonal();
+      R.noalias() = PrimType_(2)*axis*axis.transpose();
+      R.diagonal().array() -= PrimType_(1);
+    }
+    // assigned in one piece, overwriting the default identity element-wise stalls the store forwarding
+    RotationMatrix<PrimType_> rotation;
+    rotation.toImplementation() = R;
+    return rotation;
+  }
+};
+
 template<typename Rotation_>
 class SetFromVectorsTraits<RotationBase<Rotation_>> {
  public:
+  /*! \brief Sets the minimal rotation from two unit vectors, see UnitVectorsRotationTraits.
+   */
+  template<typename PrimType_>
+  inline static void setFromUnitVectors(Rotation_& rot, const Eigen::Matrix<PrimType_, 3, 1>& v1, const Eigen::Matrix<PrimType_, 3, 1>& v2) {
+    using std::abs;
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, abs(v1.squaredNorm() - PrimType_(1)) < PrimType_(1e-2) && abs(v2.squaredNorm() - PrimType_(1)) < PrimType_(1e-2),
+                          "The vectors must have unit length.");
+    rot = UnitVectorsRotationTraits<Rotation_>::get(v1, v2);
+  }
+
   template<typename PrimType_>
   inline static void setFromVectors(Rotation_& rot, const Eigen::Matrix<PrimType_, 3, 1>& v1, const Eigen::Matrix<PrimType_, 3, 1>& v2) {
-    KINDR_ASSERT_TRUE(std::runtime_error,  v1.norm()*v2.norm() != static_cast<PrimType_>(0.0), "At least one vector has zero length.");
+    KINDR_ASSERT_TRUE_HOT(std::runtime_error, v1.norm()*v2.norm() != static_cast<PrimType_>(0.0), "At least one vector has zero length.");
 
     Eigen::Quaternion<PrimType_> eigenQuat;
     eigenQuat.setFromTwoVectors(v1, v2);
@@ -206,20 +395,47 @@ class SetFromVectorsTraits<RotationBase<Rotation_>> {
 
 /*! \brief Compute the disparity angle between two rotations.
  *
+ *  The rotations are converted to the parameterization given by ComparisonSpace, whose specialization computes the
+ *  disparity angle directly from the coefficients, e.g. from the distance of the rotation quaternions. This avoids the
+ *  concatenation and the conversion to angle-axis.
  */
 template<typename Left_, typename Right_>
 class DisparityAngleTraits<RotationBase<Left_>, RotationBase<Right_>> {
  public:
+  typedef typename Left_::Scalar Scalar;
+  typedef ComparisonSpace<Left_, Right_> Space;
+  typedef typename Space::Rotation Rotation;
+
   /*! \brief Gets the disparity angle between two rotations.
    *
    *  The disparity angle is defined as the angle of the angle-axis representation of the concatenation of
    *  the first rotation and the inverse of the second rotation. If the disparity angle is zero,
    *  the rotations are equal.
-   *  \returns disparity angle in [-pi,pi) @todo: is this range correct?
+   *  \returns disparity angle in [0,pi]
+   */
+  inline static Scalar compute(const RotationBase<Left_>& left, const RotationBase<Right_>& right) {
+    return DisparityAngleTraits<RotationBase<Rotation>, RotationBase<Rotation>>::compute(Space::get(left.derived()), Space::get(right.derived()));
+  }
+
+  /*! \brief Checks if the disparity angle between two rotations is smaller than or equal to a tolerance.
+   *  \returns true if the rotations are equal within the tolerance
+   */
+  inline static bool isNear(const RotationBase<Left_>& left, const RotationBase<Right_>& right, Scalar tol) {
+    return DisparityAngleTraits<RotationBase<Rotation>, RotationBase<Rotation>>::isNear(Space::get(left.derived()), Space::get(right.derived()), tol);
+  }
+
+  /*! \brief Gets the bound of the distance of the coefficients in the comparison space for a tolerance.
+   *  \returns bound for isNearWithBound()
+   */
+  inline static Scalar getNearnessBound(Scalar tol) {
+    return DisparityAngleTraits<RotationBase<Rotation>, RotationBase<Rotation>>::getNearnessBound(tol);
+  }
+
+  /*! \brief Checks if two rotations are equal within the tolerance of a bound of getNearnessBound().
+   *  \returns true if the rotations are equal within the tolerance
    */
-  inline static typename Left_::Scalar compute(const RotationBase<Left_>& left, const RotationBase<Right_>& right) {
-    typedef typename Left_::Scalar Scalar;
-    return std::abs(floatingPointModulo(AngleAxis<Scalar>(left.derived()*right.derived().inverted()).angle() + Scalar(M_PI), Scalar(2.0*M_PI))-M_PI);
+  inline static bool isNearWithBound(const RotationBase<Left_>& left, const RotationBase<Right_>& right, Scalar bound) {
+    return DisparityAngleTraits<RotationBase<Rotation>, RotationBase<Rotation>>::isNearWithBound(Space::get(left.derived()), Space::get(right.derived()), bound);
   }
 };
 
@@ -247,5 +463,7 @@ class RandomTraits<RotationBase<Rotation_>> {
 #include "kindr/rotations/RotationMatrix.hpp"
 #include "kindr/rotations/EulerAnglesZyx.hpp"
 #include "kindr/rotations/EulerAnglesXyz.hpp"
+#include "kindr/rotations/PreparedRotation.hpp"
+#include "kindr/rotations/RotationComposition.hpp"
 
 
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationQuaternionArray.hpp"
+
+namespace kindr {
+
+/*! \class RotationMeanAccumulator
+ *  \brief Accumulates weighted rotations of any parameterization and computes their chordal L2 mean.
+ *
+ *  The rotations are accumulated in the 4x4 matrix M = sum_i w_i*q_i*q_i^T. The mean is the eigenvector of M
+ *  with the largest eigenvalue (Markley et al., Averaging Quaternions, 2007), which minimizes the weighted sum of the
+ *  squared chordal distances of the rotation matrices and does not depend on the signs of the quaternions.
+ *  Neither adding rotations nor computing the mean allocates memory.
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationMeanAccumulator {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<PrimType_> Rotation;
+  typedef Eigen::Matrix<PrimType_, 4, 4> Matrix4;
+
+  /*! \brief Default constructor without rotations.
+   */
+  RotationMeanAccumulator()
+    : accumulator_(Matrix4::Zero()),
+      weightSum_(PrimType_(0)) {
+  }
+
+  /*! \brief Adds a weighted rotation.
+   *  \param rotation   rotation with any parameterization
+   *  \param weight     non-negative weight
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  RotationMeanAccumulator& add(const RotationBase<OtherDerived_>& rotation, Scalar weight = Scalar(1)) {
+    const Eigen::Matrix<PrimType_, 4, 1> q = Rotation(rotation.derived()).vector();
+    accumulator_.noalias() += weight*q*q.transpose();
+    weightSum_ += weight;
+    return *this;
+  }
+
+  /*! \brief Adds the rotations of another accumulator, e.g. the partial sum of another thread.
+   *  \param other   accumulator
+   *  \returns reference
+   */
+  RotationMeanAccumulator& operator +=(const RotationMeanAccumulator& other) {
+    accumulator_ += other.accumulator_;
+    weightSum_ += other.weightSum_;
+    return *this;
+  }
+
+  /*! \brief Removes all rotations.
+   *  \returns reference
+   */
+  RotationMeanAccumulator& setZero() {
+    accumulator_.setZero();
+    weightSum_ = PrimType_(0);
+    return *this;
+  }
+
+  /*! \brief Gets the sum of the weights.
+   *  \returns sum of weights
+   */
+  inline Scalar getWeightSum() const {
+    return weightSum_;
+  }
+
+  /*! \brief Gets the accumulated matrix sum_i w_i*q_i*q_i^T with q = [w; x; y; z].
+   *  \returns 4x4 matrix
+   */
+  inline const Matrix4& getAccumulator() const {
+    return accumulator_;
+  }
+
+  /*! \brief Computes the chordal L2 mean of the accumulated rotations.
+   *  \returns mean rotation with non-negative real part
+   */
+  Rotation getChordalMean() const {
+    KINDR_ASSERT_TRUE(std::runtime_error, weightSum_ > PrimType_(0), "The weights of the rotations must have a positive sum.");
+    const Eigen::SelfAdjointEigenSolver<Matrix4> solver(accumulator_);
+    // the eigenvalues are sorted in increasing order
+    const Eigen::Matrix<PrimType_, 4, 1> mean = solver.eigenvectors().col(3).normalized();
+    return Rotation(mean(0) < PrimType_(0) ? Eigen::Matrix<PrimType_, 4, 1>(-mean) : mean);
+  }
+
+ private:
+  Matrix4 accumulator_;
+  Scalar weightSum_;
+};
+
+
+namespace internal {
+
+//! Minimum number of rotations of a chunk that is handed to an executor
+enum { AveragingGrainSize = 4096 };
+
+//! Accumulates the weighted rotations, the chunks of an executor are accumulated separately and summed afterwards
+template<typename PrimType_, typename GetRotation_, typename GetWeight_, typename Executor_>
+RotationMeanAccumulator<PrimType_> accumulateRotations(int size, const GetRotation_& getRotation, const GetWeight_& getWeight, const Executor_& executor) {
+  RotationMeanAccumulator<PrimType_> accumulator;
+  std::mutex mutex;
+  executor.parallelFor(0, size, AveragingGrainSize, [&](int begin, int end) {
+    RotationMeanAccumulator<PrimType_> partial;
+    for (int i = begin; i < end; ++i) {
+      partial.add(getRotation(i), getWeight(i));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    accumulator += partial;
+  });
+  return accumulator;
+}
+
+/*! \brief Computes the weighted Karcher (geodesic L2) mean of a sequence of rotations by Gauss-Newton iterations.
+ *  mean <- mean [+] sum_i w_i*(q_i [-] mean)/sum_i w_i, starting from the chordal mean.
+ */
+template<typename PrimType_, typename GetRotation_, typename GetWeight_, typename Executor_>
+RotationQuaternion<PrimType_> getKarcherMean(int size, const GetRotation_& getRotation, const GetWeight_& getWeight,
+                                             PrimType_ tolerance, int maxIterations, const Executor_& executor) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  const RotationMeanAccumulator<PrimType_> accumulator = accumulateRotations<PrimType_>(size, getRotation, getWeight, executor);
+  RotationQuaternion<PrimType_> mean = accumulator.getChordalMean();
+  const PrimType_ weightSum = accumulator.getWeightSum();
+  std::mutex mutex;
+  for (int iteration = 0; iteration < maxIterations; ++iteration) {
+    Vector3 step = Vector3::Zero();
+    executor.parallelFor(0, size, AveragingGrainSize, [&](int begin, int end) {
+      Vector3 partial = Vector3::Zero();
+      for (int i = begin; i < end; ++i) {
+        partial += getWeight(i)*getRotation(i).boxMinus(mean);
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      step += partial;
+    });
+    step /= weightSum;
+    mean = mean.boxPlus(step);
+    if (step.norm() < tolerance) {
+      break;
+    }
+  }
+  return mean;
+}
+
+//! Return type of the functions that take an executor instead of the weights
+template<typename Executor_, typename Result_>
+using enable_if_executor = typename std::enable_if<!std::is_base_of<Eigen::EigenBase<Executor_>, Executor_>::value, Result_>;
+
+} // namespace internal
+
+
+/*! \brief Computes the chordal L2 mean of a batch of rotations, see RotationMeanAccumulator.
+ *  \param rotations   rotations
+ *  \param executor    executor distributing chunks of rotations to threads, see SerialExecutor
+ *  \returns mean rotation
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+typename internal::enable_if_executor<Executor_, RotationQuaternion<PrimType_>>::type
+getChordalMean(const RotationQuaternionArray<PrimType_>& rotations, const Executor_& executor = Executor_()) {
+  return internal::accumulateRotations<PrimType_>(rotations.size(), [&rotations](int i) { return rotations[i]; },
+                                                  [](int) { return PrimType_(1); }, executor).getChordalMean();
+}
+
+/*! \brief Computes the weighted chordal L2 mean of a batch of rotations, see RotationMeanAccumulator.
+ *  \param rotations   rotations
+ *  \param weights     non-negative weights, one per rotation
+ *  \param executor    executor distributing chunks of rotations to threads, see SerialExecutor
+ *  \returns mean rotation
+ */
+template<typename PrimType_, typename WeightsDerived_, typename Executor_ = SerialExecutor>
+RotationQuaternion<PrimType_> getChordalMean(const RotationQuaternionArray<PrimType_>& rotations, const Eigen::MatrixBase<WeightsDerived_>& weights,
+                                             const Executor_& executor = Executor_()) {
+  KINDR_ASSERT_TRUE(std::runtime_error, weights.size() == rotations.size(), "The number of weights and rotations must be equal.");
+  return internal::accumulateRotations<PrimType_>(rotations.size(), [&rotations](int i) { return rotations[i]; },
+                                                  [&weights](int i) { return PrimType_(weights(i)); }, executor).getChordalMean();
+}
+
+/*! \brief Computes the chordal L2 mean of rotations with any parameterization, see RotationMeanAccumulator.
+ *  \param rotations   rotations
+ *  \param executor    executor distributing chunks of rotations to threads, see SerialExecutor
+ *  \returns mean rotation
+ */
+template<typename Rotation_, typename Executor_ = SerialExecutor>
+RotationQuaternion<typename Rotation_::Scalar> getChordalMean(const std::vector<Rotation_>& rotations, const Executor_& executor = Executor_()) {
+  typedef typename Rotation_::Scalar Scalar;
+  return internal::accumulateRotations<Scalar>(static_cast<int>(rotations.size()), [&rotations](int i) -> const Rotation_& { return rotations[i]; },
+                                               [](int) { return Scalar(1); }, executor).getChordalMean();
+}
+
+/*! \brief Computes the Karcher (geodesic L2) mean of a batch of rotations.
+ *  The mean minimizes the sum of the squared rotation angles to the rotations. It is found by Gauss-Newton iterations
+ *  on the box operations starting from the chordal mean and is unique if all rotations lie within a ball of radius pi/2.
+ *  \param rotations       rotations
+ *  \param tolerance       norm of the last step
+ *  \param maxIterations   maximum number of iterations
+ *  \param executor        executor distributing chunks of rotations to threads, see SerialExecutor
+ *  \returns mean rotation
+ */
+template<typename PrimType_, typename Executor_ = SerialExecutor>
+RotationQuaternion<PrimType_> getKarcherMean(const RotationQuaternionArray<PrimType_>& rotations,
+                                             PrimType_ tolerance = internal::NumTraits<PrimType_>::dummy_precision(), int maxIterations = 10,
+                                             const Executor_& executor = Executor_()) {
+  return internal::getKarcherMean<PrimType_>(rotations.size(), [&rotations](int i) { return rotations[i]; },
+                                             [](int) { return PrimType_(1); }, tolerance, maxIterations, executor);
+}
+
+/*! \brief Computes the weighted Karcher (geodesic L2) mean of a batch of rotations.
+ *  \param rotations       rotations
+ *  \param weights         non-negative weights, one per rotation
+ *  \param tolerance       norm of the last step
+ *  \param maxIterations   maximum number of iterations
+ *  \param executor        executor distributing chunks of rotations to threads, see SerialExecutor
+ *  \returns mean rotation
+ */
+template<typename PrimType_, typename WeightsDerived_, typename Executor_ = SerialExecutor>
+RotationQuaternion<PrimType_> getKarcherMean(const RotationQuaternionArray<PrimType_>& rotations, const Eigen::MatrixBase<WeightsDerived_>& weights,
+                                             PrimType_ tolerance = internal::NumTraits<PrimType_>::dummy_precision(), int maxIterations = 10,
+                                             const Executor_& executor = Executor_()) {
+  KINDR_ASSERT_TRUE(std::runtime_error, weights.size() == rotations.size(), "The number of weights and rotations must be equal.");
+  return internal::getKarcherMean<PrimType_>(rotations.size(), [&rotations](int i) { return rotations[i]; },
+                                             [&weights](int i) { return PrimType_(weights(i)); }, tolerance, maxIterations, executor);
+}
+
+/*! \brief Computes the Karcher (geodesic L2) mean of rotations with any parameterization.
+ *  \param rotations       rotations
+ *  \param tolerance       norm of the last step
+ *  \param maxIterations   maximum number of iterations
+ *  \param executor        executor distributing chunks of rotations to threads, see SerialExecutor
+ *  \returns mean rotation
+ */
+template<typename Rotation_, typename Executor_ = SerialExecutor>
+RotationQuaternion<typename Rotation_::Scalar> getKarcherMean(const std::vector<Rotation_>& rotations,
+                                                              typename Rotation_::Scalar tolerance = internal::NumTraits<typename Rotation_::Scalar>::dummy_precision(),
+                                                              int maxIterations = 10, const Executor_& executor = Executor_()) {
+  typedef typename Rotation_::Scalar Scalar;
+  return internal::getKarcherMean<Scalar>(static_cast<int>(rotations.size()), [&rotations](int i) { return RotationQuaternion<Scalar>(rotations[i]); },
+                                          [](int) { return Scalar(1); }, tolerance, maxIterations, executor);
+}
+
+} // namespace kindr
@@ -29,11 +29,24 @@
 #pragma once
 
 #include "kindr/common/common.hpp"
+#include "kindr/common/ColumnTransformKernels.hpp"
+#include "kindr/common/Instrumentation.hpp"
 #include "kindr/quaternions/QuaternionBase.hpp"
 #include "kindr/vectors/VectorBase.hpp"
+#include "kindr/rotations/RotationJacobians.hpp"
 
 
 namespace kindr {
+
+template<typename PrimType_>
+class RotationMatrix;
+
+template<typename Rotation_>
+class PreparedRotation;
+
+template<typename... Rotations_>
+class RotationComposition;
+
 //! Generic rotation interface
 /*! \ingroup rotations
  */
@@ -68,6 +81,16 @@ class ConversionTraits {
   // inline static Dest_ convert(const Source_& );
 };
 
+/*! \brief Converts a rotation with the ConversionTraits.
+ *  The constructors and assignments of the rotations convert through this function, which is instrumented.
+ *  (only for advanced users)
+ */
+template<typename Dest_, typename Source_>
+inline Dest_ convertRotation(const Source_& source) {
+  KINDR_INSTRUMENT(Conversion);
+  return ConversionTraits<Dest_, Source_>::convert(source);
+}
+
 
 
 /*! \brief Rotation traits for rotating vectors and matrices
@@ -78,6 +101,7 @@ template<typename Rotation_>
 class RotationTraits {
  public:
 // inline static typename internal::get_matrix3X<Derived_>::type rotate(const Rotation_& r, const typename internal::get_vector3<Derived_>::type& );
+// inline static typename internal::get_matrix3X<Derived_>::type inverseRotate(const Rotation_& r, const typename internal::get_vector3<Derived_>::type& );
 };
 
 /*! \brief Traits for map operations
@@ -119,6 +143,7 @@ template<typename Left_, typename Right_>
 class DisparityAngleTraits {
  public:
   // inline static typename internal::get_scalar<Derived_>::Scalar compute(const Left_& left, const Right_& right);
+  // inline static bool isNear(const Left_& left, const Right_& right, typename internal::get_scalar<Derived_>::Scalar tol);
 };
 
 /*! \brief Fixes the rotation to get rid of numerical errors (e.g. normalize quaternion).
@@ -251,6 +276,16 @@ class RotationBase {
     return internal::MultiplicationTraits<RotationBase<Derived_>,RotationBase<OtherDerived_>>::mult(this->derived(), other.derived()); // todo: 1. ok? 2. may be optimized
   }
 
+  /*! \brief Concatenates this rotation with another one from the right, i.e. C = C*C2.
+   *  The concatenation is computed as by operator*() and assigned to this rotation.
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  Derived_& operator *=(const RotationBase<OtherDerived_>& other) {
+    this->derived() = internal::MultiplicationTraits<RotationBase<Derived_>,RotationBase<OtherDerived_>>::mult(this->derived(), other.derived());
+    return this->derived();
+  }
+
   /*! \brief Compares two rotations.
    *  \returns true if the rotations are exactly equal
    */
@@ -277,8 +312,7 @@ class RotationBase {
    */
   template<typename OtherDerived_>
   bool isNear(const RotationBase<OtherDerived_>& other, typename internal::get_scalar<Derived_>::Scalar tol) const {
-    const typename internal::get_scalar<Derived_>::Scalar angle = this->getDisparityAngle(other);
-    return (angle <= tol);
+    return internal::DisparityAngleTraits<RotationBase<Derived_>, RotationBase<OtherDerived_>>::isNear(this->derived(), other.derived(), tol);
   }
 
   /*! \brief Rotates a vector or a matrix column-wise.
@@ -295,7 +329,76 @@ class RotationBase {
    */
   template <typename internal::get_matrix3X<Derived_>::IndexType Cols>
   typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols> inverseRotate(const typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& matrix) const {
-    return internal::RotationTraits<RotationBase<Derived_>>::rotate(this->derived().inverted(), matrix); // todo: may be optimized
+    return internal::RotationTraits<RotationBase<Derived_>>::inverseRotate(this->derived(), matrix);
+  }
+
+  /*! \brief Rotates the columns of a large 3xN matrix, e.g. a point cloud, into a preallocated matrix.
+   *  The rotation is converted to a rotation matrix once and the columns are processed in chunks,
+   *  see internal::ColumnTransformKernels. The output may be the input itself.
+   *  \param vectors        3xN matrix
+   *  \param rotated        3xN matrix of rotated vectors
+   *  \param executor       executor distributing chunks of columns to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void rotateBatch(const Eigen::Ref<const Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, Eigen::Dynamic>>& vectors,
+                   Eigen::Ref<Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, Eigen::Dynamic>> rotated,
+                   const Executor_& executor = Executor_()) const {
+    typedef typename internal::get_scalar<Derived_>::Scalar Scalar;
+    typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+    internal::ColumnTransformKernels<Scalar>::transform(this->template rotate<3>(Matrix3(Matrix3::Identity())), Eigen::Matrix<Scalar, 3, 1>::Zero(),
+                                                        vectors, rotated, executor);
+  }
+
+  /*! \brief Rotates the columns of a large 3xN matrix in reverse into a preallocated matrix, see rotateBatch().
+   *  \param vectors        3xN matrix
+   *  \param rotated        3xN matrix of reverse rotated vectors
+   *  \param executor       executor distributing chunks of columns to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void inverseRotateBatch(const Eigen::Ref<const Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, Eigen::Dynamic>>& vectors,
+                          Eigen::Ref<Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, Eigen::Dynamic>> rotated,
+                          const Executor_& executor = Executor_()) const {
+    typedef typename internal::get_scalar<Derived_>::Scalar Scalar;
+    typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+    internal::ColumnTransformKernels<Scalar>::transform(this->template inverseRotate<3>(Matrix3(Matrix3::Identity())), Eigen::Matrix<Scalar, 3, 1>::Zero(),
+                                                        vectors, rotated, executor);
+  }
+
+  /*! \brief Rotates the columns of a 3xN matrix or a vector in place, see rotateBatch().
+   *  \param vectors    3xN matrix, overwritten by the rotated vectors
+   *  \param executor   executor distributing chunks of columns to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void rotateInPlace(Eigen::Ref<Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, Eigen::Dynamic>> vectors,
+                     const Executor_& executor = Executor_()) const {
+    rotateBatch(vectors, vectors, executor);
+  }
+
+  /*! \brief Rotates the columns of a 3xN matrix or a vector in reverse in place, see rotateBatch().
+   *  \param vectors    3xN matrix, overwritten by the reverse rotated vectors
+   *  \param executor   executor distributing chunks of columns to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void inverseRotateInPlace(Eigen::Ref<Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, Eigen::Dynamic>> vectors,
+                            const Executor_& executor = Executor_()) const {
+    inverseRotateBatch(vectors, vectors, executor);
+  }
+
+  /*! \brief Gets a handle which caches the rotation matrix of this rotation and its transpose.
+   *  Use it to rotate many vectors by the same rotation without converting the rotation in every call,
+   *  see PreparedRotation.
+   *  \returns prepared rotation
+   */
+  PreparedRotation<Derived_> prepared() const {
+    return PreparedRotation<Derived_>(this->derived());
+  }
+
+  /*! \brief Starts a lazy concatenation with this rotation as first factor, e.g. C_AB.lazy()*C_BC*C_CD,
+   *  which is only computed when it is assigned to a rotation, see RotationComposition.
+   *  \returns composition
+   */
+  RotationComposition<Derived_> lazy() const {
+    return RotationComposition<Derived_>(this->derived());
   }
 
   /*! \brief Rotates a vector.
@@ -311,7 +414,7 @@ class RotationBase {
    */
   template <typename Vector_>
   Vector_ inverseRotate(const Vector_& vector) const {
-    return internal::RotationTraits<RotationBase<Derived_>>::rotate(this->derived().inverted(), vector);
+    return internal::RotationTraits<RotationBase<Derived_>>::inverseRotate(this->derived(), vector);
   }
 
   /*! \brief Sets the rotation using an exponential map @todo avoid altering the rotation
@@ -343,6 +446,90 @@ class RotationBase {
     return internal::BoxOperationTraits<RotationBase<Derived_>, RotationBase<Derived_>>::box_plus(this->derived(), vector);
   }
 
+  /*! \brief Applies the box plus operation in place, i.e. C = exp(v)*C.
+   * \returns reference
+   */
+  Derived_& boxPlusInPlace(const typename internal::get_matrix3X<Derived_>::template Matrix3X<1>& vector) {
+    this->derived() = internal::BoxOperationTraits<RotationBase<Derived_>, RotationBase<Derived_>>::box_plus(this->derived(), vector);
+    return this->derived();
+  }
+
+  /* Jacobians in the perturbation convention of boxPlus, i.e. a rotation C is perturbed by exp(dv)*C.
+   */
+
+  /*! \brief Gets the Jacobian of the rotated vector C*v with respect to the rotation C.
+   *  \param vector  vector v
+   *  \returns -[C*v]x
+   */
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfRotate(const typename internal::get_matrix3X<Derived_>::template Matrix3X<1>& vector) const {
+    return -getSkewMatrixFromVector(Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 1>(this->rotate(vector)));
+  }
+
+  /*! \brief Gets the Jacobian of the inversely rotated vector C^T*v with respect to the rotation C.
+   *  \param vector  vector v
+   *  \returns C^T*[v]x
+   */
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfInverseRotate(const typename internal::get_matrix3X<Derived_>::template Matrix3X<1>& vector) const {
+    typedef typename internal::get_scalar<Derived_>::Scalar Scalar;
+    return RotationMatrix<Scalar>(this->derived()).matrix().transpose()*getSkewMatrixFromVector(Eigen::Matrix<Scalar, 3, 1>(vector));
+  }
+
+  /*! \brief Gets the Jacobian of the concatenation C*C2 with respect to this rotation C (left-hand side).
+   *  \returns identity
+   */
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfMultiplicationWrtLeft() const {
+    return Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3>::Identity();
+  }
+
+  /*! \brief Gets the Jacobian of the concatenation C*C2 with respect to the rotation C2 (right-hand side).
+   *  \returns rotation matrix of C
+   */
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfMultiplicationWrtRight() const {
+    return RotationMatrix<typename internal::get_scalar<Derived_>::Scalar>(this->derived()).matrix();
+  }
+
+  /*! \brief Gets the Jacobian of the logarithmic map log(C) with respect to this rotation C.
+   *  \returns J^-1(log(C)), see getJacobianOfLogarithmicMap()
+   */
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfLogarithmicMap() const {
+    return kindr::getJacobianOfLogarithmicMap(Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 1>(logarithmicMap()));
+  }
+
+  /*! \brief Gets the Jacobian of the box plus operation C.boxPlus(v) = exp(v)*C with respect to the vector v.
+   *  \param vector  vector v
+   *  \returns J(v), see getJacobianOfExponentialMap()
+   */
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfBoxPlusWrtVector(const typename internal::get_matrix3X<Derived_>::template Matrix3X<1>& vector) const {
+    return kindr::getJacobianOfExponentialMap(Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 1>(vector));
+  }
+
+  /*! \brief Gets the Jacobian of the box plus operation C.boxPlus(v) = exp(v)*C with respect to this rotation C.
+   *  \param vector  vector v
+   *  \returns rotation matrix of exp(v)
+   */
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfBoxPlusWrtRotation(const typename internal::get_matrix3X<Derived_>::template Matrix3X<1>& vector) const {
+    typedef typename internal::get_scalar<Derived_>::Scalar Scalar;
+    return RotationMatrix<Scalar>().exponentialMap(Eigen::Matrix<Scalar, 3, 1>(vector)).matrix();
+  }
+
+  /*! \brief Gets the Jacobian of the box minus operation C.boxMinus(C2) = log(C*C2^-1) with respect to this rotation C.
+   *  \param other  rotation C2
+   *  \returns J^-1(log(C*C2^-1))
+   */
+  template<typename OtherDerived_>
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfBoxMinusWrtLeft(const RotationBase<OtherDerived_>& other) const {
+    return kindr::getJacobianOfLogarithmicMap(Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 1>(boxMinus(other)));
+  }
+
+  /*! \brief Gets the Jacobian of the box minus operation C.boxMinus(C2) = log(C*C2^-1) with respect to the rotation C2.
+   *  \param other  rotation C2
+   *  \returns -Jr^-1(log(C*C2^-1))
+   */
+  template<typename OtherDerived_>
+  Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 3> getJacobianOfBoxMinusWrtRight(const RotationBase<OtherDerived_>& other) const {
+    return -kindr::getRightJacobianOfLogarithmicMap(Eigen::Matrix<typename internal::get_scalar<Derived_>::Scalar, 3, 1>(boxMinus(other)));
+  }
+
 
   /*! \brief Sets the rotation C_IB from two vectors such that I_v = C_IB*B_v i.e.
    * I_v = this->rotate(B_v).
@@ -353,13 +540,62 @@ class RotationBase {
     return *this;
   }
 
+  /*! \brief Sets the rotation C_IB from two unit vectors such that I_v = C_IB*B_v, i.e. I_v = this->rotate(B_v).
+   * The rotation is the minimal one, i.e. about B_v x I_v. Unlike setFromVectors(), the vectors are not normalized
+   * (their length is checked in debug mode) and the rotation quaternion or matrix is computed in closed form.
+   */
+  template <typename Vector_>
+  Derived_& setFromUnitVectors(const Vector_& B_v, const Vector_& I_v) {
+    internal::SetFromVectorsTraits<RotationBase<Derived_>>::setFromUnitVectors(this->derived(), B_v, I_v);
+    return *this;
+  }
+
   /*! \brief Fixes the rotation to get rid of numerical errors (e.g. normalize quaternion).
    */
   void fix() {
+    KINDR_INSTRUMENT(Fixing);
     internal::FixingTraits<Derived_>::fix(this->derived());
   }
 };
 
 
 
+/*! \class RotationNearness
+ *  \brief Compares pairs of rotations with one tolerance as RotationBase::isNear() does, but computes the bound of the
+ *  distance of their coefficients only once, such that the comparisons evaluate no trigonometric function, e.g.
+ *  \code{cpp}
+ *  const kindr::RotationNearness<kindr::RotationQuaternionD> isNear(1e-6);
+ *  for (int i = 0; i < n; ++i) {
+ *    converged = converged && isNear(previous[i], current[i]);
+ *  }
+ *  \endcode
+ *  \tparam Left_    type of the first rotation
+ *  \tparam Right_   type of the second rotation
+ *  \ingroup rotations
+ */
+template<typename Left_, typename Right_ = Left_>
+class RotationNearness {
+ public:
+  typedef typename internal::get_scalar<Left_>::Scalar Scalar;
+
+  /*! \brief Constructor.
+   *  \param tol   tolerance of the disparity angle
+   */
+  explicit RotationNearness(Scalar tol)
+    : bound_(Traits::getNearnessBound(tol)) {
+  }
+
+  /*! \brief Compares two rotations.
+   *  \returns true if the disparity angle of the rotations is within the tolerance
+   */
+  inline bool operator()(const RotationBase<Left_>& left, const RotationBase<Right_>& right) const {
+    return Traits::isNearWithBound(left.derived(), right.derived(), bound_);
+  }
+
+ private:
+  typedef internal::DisparityAngleTraits<RotationBase<Left_>, RotationBase<Right_>> Traits;
+
+  Scalar bound_;
+};
+
 } // namespace kindr
@@ -0,0 +1,765 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+//! Number of rotations below which a batch is not split
+enum { BatchConversionGrainSize = 4096 };
+
+//! Number of rotations processed at once by the kernels, their temporaries stay in the L1 cache
+enum { BatchConversionBlockSize = 128 };
+
+/*! \class RotationArrayTraits
+ *  \brief Structure-of-arrays layout of a rotation parameterization.
+ *
+ *  N rotations are stored in a row-major RowsxN matrix, one rotation per column, such that each coefficient of all
+ *  rotations is contiguous in memory:
+ *    RotationQuaternion: [w; x; y; z] (as RotationQuaternionArray)
+ *    RotationMatrix:     element (r,c) in row r+3*c (as RotationQuaternionArray::getRotationMatrices())
+ *    AngleAxis:          [angle; axis]
+ *    RotationVector:     [x; y; z]
+ *    EulerAnglesZyx:     [yaw; pitch; roll]
+ *    EulerAnglesXyz:     [roll; pitch; yaw]
+ *  (only for advanced users)
+ */
+template<typename Rotation_>
+class RotationArrayTraits {
+ public:
+//  enum { Rows = ... };
+//  template<typename Matrix_> inline static Rotation_ get(const Matrix_& matrix, int i);
+//  template<typename Matrix_> inline static void set(Matrix_& matrix, int i, const Rotation_& rotation);
+};
+
+template<typename PrimType_>
+class RotationArrayTraits<RotationQuaternion<PrimType_>> {
+ public:
+  enum { Rows = 4 };
+  typedef Eigen::Matrix<PrimType_, Rows, Eigen::Dynamic, Eigen::RowMajor> Matrix;
+  template<typename Matrix_>
+  inline static RotationQuaternion<PrimType_> get(const Matrix_& matrix, int i) {
+    return RotationQuaternion<PrimType_>(matrix(0, i), matrix(1, i), matrix(2, i), matrix(3, i));
+  }
+  template<typename Matrix_>
+  inline static void set(Matrix_& matrix, int i, const RotationQuaternion<PrimType_>& rotation) {
+    matrix(0, i) = rotation.w();
+    matrix(1, i) = rotation.x();
+    matrix(2, i) = rotation.y();
+    matrix(3, i) = rotation.z();
+  }
+};
+
+template<typename PrimType_>
+class RotationArrayTraits<RotationMatrix<PrimType_>> {
+ public:
+  enum { Rows = 9 };
+  typedef Eigen::Matrix<PrimType_, Rows, Eigen::Dynamic, Eigen::RowMajor> Matrix;
+  template<typename Matrix_>
+  inline static RotationMatrix<PrimType_> get(const Matrix_& matrix, int i) {
+    RotationMatrix<PrimType_> rotation;
+    for (int k = 0; k < Rows; ++k) {
+      rotation.toImplementation()(k) = matrix(k, i);
+    }
+    return rotation;
+  }
+  template<typename Matrix_>
+  inline static void set(Matrix_& matrix, int i, const RotationMatrix<PrimType_>& rotation) {
+    for (int k = 0; k < Rows; ++k) {
+      matrix(k, i) = rotation.toImplementation()(k);
+    }
+  }
+};
+
+template<typename PrimType_>
+class RotationArrayTraits<AngleAxis<PrimType_>> {
+ public:
+  enum { Rows = 4 };
+  typedef Eigen::Matrix<PrimType_, Rows, Eigen::Dynamic, Eigen::RowMajor> Matrix;
+  template<typename Matrix_>
+  inline static AngleAxis<PrimType_> get(const Matrix_& matrix, int i) {
+    return AngleAxis<PrimType_>(matrix(0, i), matrix(1, i), matrix(2, i), matrix(3, i));
+  }
+  template<typename Matrix_>
+  inline static void set(Matrix_& matrix, int i, const AngleAxis<PrimType_>& rotation) {
+    matrix(0, i) = rotation.angle();
+    matrix(1, i) = rotation.axis().x();
+    matrix(2, i) = rotation.axis().y();
+    matrix(3, i) = rotation.axis().z();
+  }
+};
+
+template<typename PrimType_>
+class RotationArrayTraits<RotationVector<PrimType_>> {
+ public:
+  enum { Rows = 3 };
+  typedef Eigen::Matrix<PrimType_, Rows, Eigen::Dynamic, Eigen::RowMajor> Matrix;
+  template<typename Matrix_>
+  inline static RotationVector<PrimType_> get(const Matrix_& matrix, int i) {
+    return RotationVector<PrimType_>(matrix(0, i), matrix(1, i), matrix(2, i));
+  }
+  template<typename Matrix_>
+  inline static void set(Matrix_& matrix, int i, const RotationVector<PrimType_>& rotation) {
+    matrix(0, i) = rotation.x();
+    matrix(1, i) = rotation.y();
+    matrix(2, i) = rotation.z();
+  }
+};
+
+template<typename PrimType_>
+class RotationArrayTraits<EulerAnglesZyx<PrimType_>> {
+ public:
+  enum { Rows = 3 };
+  typedef Eigen::Matrix<PrimType_, Rows, Eigen::Dynamic, Eigen::RowMajor> Matrix;
+  template<typename Matrix_>
+  inline static EulerAnglesZyx<PrimType_> get(const Matrix_& matrix, int i) {
+    return EulerAnglesZyx<PrimType_>(matrix(0, i), matrix(1, i), matrix(2, i));
+  }
+  template<typename Matrix_>
+  inline static void set(Matrix_& matrix, int i, const EulerAnglesZyx<PrimType_>& rotation) {
+    matrix(0, i) = rotation.yaw();
+    matrix(1, i) = rotation.pitch();
+    matrix(2, i) = rotation.roll();
+  }
+};
+
+template<typename PrimType_>
+class RotationArrayTraits<EulerAnglesXyz<PrimType_>> {
+ public:
+  enum { Rows = 3 };
+  typedef Eigen::Matrix<PrimType_, Rows, Eigen::Dynamic, Eigen::RowMajor> Matrix;
+  template<typename Matrix_>
+  inline static EulerAnglesXyz<PrimType_> get(const Matrix_& matrix, int i) {
+    return EulerAnglesXyz<PrimType_>(matrix(0, i), matrix(1, i), matrix(2, i));
+  }
+  template<typename Matrix_>
+  inline static void set(Matrix_& matrix, int i, const EulerAnglesXyz<PrimType_>& rotation) {
+    matrix(0, i) = rotation.roll();
+    matrix(1, i) = rotation.pitch();
+    matrix(2, i) = rotation.yaw();
+  }
+};
+
+//! Temporary row of a block of the conversion kernels
+template<typename PrimType_>
+using BatchConversionRow = Eigen::Array<PrimType_, 1, Eigen::Dynamic, Eigen::RowMajor, 1, BatchConversionBlockSize>;
+
+//! Temporary row of conditions of a block of the conversion kernels
+typedef Eigen::Array<bool, 1, Eigen::Dynamic, Eigen::RowMajor, 1, BatchConversionBlockSize> BatchConversionConditionRow;
+
+/*! \class ArrayConversionTraits
+ *  \brief Conversion of the columns [begin,end) of a structure-of-arrays batch, see RotationArrayTraits.
+ *
+ *  The default converts the rotations one by one with the ConversionTraits. The specializations evaluate a direct
+ *  formula as coefficient-wise expressions on the rows, which are vectorized by Eigen. If UseForStructureOfArrays is
+ *  true, the kernel is faster than the ConversionTraits on structure-of-arrays storage for the scalar type, see
+ *  StructureOfArraysConversionTraits. If UseForArrayOfStructures is true, it is faster even if the rotations have to
+ *  be copied to and from structure-of-arrays storage, see BatchConversionTraits.
+ *  (only for advanced users)
+ */
+template<typename Dest_, typename Source_>
+class ArrayConversionTraits {
+ public:
+  enum { UseForStructureOfArrays = 0 };
+  enum { UseForArrayOfStructures = 0 };
+
+  template<typename SourceMatrix_, typename DestMatrix_>
+  inline static void convert(const SourceMatrix_& sources, DestMatrix_& destinations, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      RotationArrayTraits<Dest_>::set(destinations, i, ConversionTraits<Dest_, Source_>::convert(RotationArrayTraits<Source_>::get(sources, i)));
+    }
+  }
+};
+
+/*! \brief Euler angles [yaw; pitch; roll] from the elements of rotation matrices as in getEulerAnglesZyxFromRotationMatrixElements().
+ */
+template<typename PrimType_, typename DestMatrix_>
+inline void setEulerAnglesZyxFromRotationMatrixElements(const BatchConversionRow<PrimType_>& r00, const BatchConversionRow<PrimType_>& r01,
+                                                        const BatchConversionRow<PrimType_>& r10, const BatchConversionRow<PrimType_>& r11,
+                                                        const BatchConversionRow<PrimType_>& r20, const BatchConversionRow<PrimType_>& r21,
+                                                        const BatchConversionRow<PrimType_>& r22, DestMatrix_& destinations, int start) {
+  typedef BatchConversionRow<PrimType_> Row;
+  const auto atan2 = [](PrimType_ y, PrimType_ x) { return std::atan2(y, x); };
+  const int length = static_cast<int>(r00.size());
+  const Row cosPitch = (r00*r00 + r10*r10).sqrt();
+  const BatchConversionConditionRow gimbalLock = cosPitch < getGimbalLockThreshold<PrimType_>();
+  destinations.row(0).segment(start, length).array() = gimbalLock.select((-r01).binaryExpr(r11, atan2), r10.binaryExpr(r00, atan2));
+  destinations.row(1).segment(start, length).array() = (-r20).binaryExpr(cosPitch, atan2);
+  destinations.row(2).segment(start, length).array() = gimbalLock.select(Row::Zero(length), r21.binaryExpr(r22, atan2));
+}
+
+/*! \brief Rotation matrices from rotation quaternions.
+ */
+template<typename PrimType_>
+class ArrayConversionTraits<RotationMatrix<PrimType_>, RotationQuaternion<PrimType_>> {
+ public:
+  //! For double, the kernel is faster or slower than the ConversionTraits depending on the placement of the rows in memory
+  enum { UseForStructureOfArrays = std::is_same<PrimType_, float>::value };
+  enum { UseForArrayOfStructures = 0 };
+
+  template<typename SourceMatrix_, typename DestMatrix_>
+  inline static void convert(const SourceMatrix_& sources, DestMatrix_& destinations, int begin, int end) {
+    const PrimType_ one = PrimType_(1);
+    const PrimType_ two = PrimType_(2);
+    const int length = end - begin;
+    const auto w = sources.row(0).segment(begin, length).array(), x = sources.row(1).segment(begin, length).array();
+    const auto y = sources.row(2).segment(begin, length).array(), z = sources.row(3).segment(begin, length).array();
+    destinations.row(0).segment(begin, length).array() = one - two*(y*y + z*z);
+    destinations.row(1).segment(begin, length).array() = two*(x*y + w*z);
+    destinations.row(2).segment(begin, length).array() = two*(x*z - w*y);
+    destinations.row(3).segment(begin, length).array() = two*(x*y - w*z);
+    destinations.row(4).segment(begin, length).array() = one - two*(x*x + z*z);
+    destinations.row(5).segment(begin, length).array() = two*(y*z + w*x);
+    destinations.row(6).segment(begin, length).array() = two*(x*z + w*y);
+    destinations.row(7).segment(begin, length).array() = two*(y*z - w*x);
+    destinations.row(8).segment(begin, length).array() = one - two*(x*x + y*y);
+  }
+};
+
+/*! \brief Rotation quaternions from rotation matrices.
+ *  The branches of Eigen::Quaternion (positive trace, otherwise the largest diagonal element) are chosen per column,
+ *  such that the results including their signs are equal to the ones of the ConversionTraits. The branches are blended
+ *  with exclusive 0/1 weights instead of Eigen's select(), which branches per coefficient and mispredicts for random rotations.
+ */
+template<typename PrimType_>
+class ArrayConversionTraits<RotationQuaternion<PrimType_>, RotationMatrix<PrimType_>> {
+ public:
+  //! For double, the four blended branches cost more than the branch of the ConversionTraits
+  enum { UseForStructureOfArrays = std::is_same<PrimType_, float>::value };
+  enum { UseForArrayOfStructures = 0 };
+
+  template<typename SourceMatrix_, typename DestMatrix_>
+  inline static void convert(const SourceMatrix_& sources, DestMatrix_& destinations, int begin, int end) {
+    typedef BatchConversionRow<PrimType_> Row;
+    const PrimType_ zero = PrimType_(0);
+    const PrimType_ one = PrimType_(1);
+    const PrimType_ half = PrimType_(0.5);
+    for (int start = begin; start < end; start += BatchConversionBlockSize) {
+      const int length = std::min<int>(BatchConversionBlockSize, end - start);
+      const auto r00 = sources.row(0).segment(start, length).array(), r10 = sources.row(1).segment(start, length).array();
+      const auto r20 = sources.row(2).segment(start, length).array(), r01 = sources.row(3).segment(start, length).array();
+      const auto r11 = sources.row(4).segment(start, length).array(), r21 = sources.row(5).segment(start, length).array();
+      const auto r02 = sources.row(6).segment(start, length).array(), r12 = sources.row(7).segment(start, length).array();
+      const auto r22 = sources.row(8).segment(start, length).array();
+      const Row trace = r00 + r11 + r22;
+      // weights of the branches w (positive trace), z (r22 largest), y (r11 largest) and x
+      const Row isW = (trace > zero).template cast<PrimType_>();
+      const Row isZ = (one - isW)*(r22 > r00.max(r11)).template cast<PrimType_>();
+      const Row isY = (one - isW - isZ)*(r11 > r00).template cast<PrimType_>();
+      const Row isX = one - isW - isZ - isY;
+      const Row root = (isW*(one + trace) + isX*(one + r00 - r11 - r22) + isY*(one + r11 - r22 - r00) + isZ*(one + r22 - r00 - r11)).sqrt();
+      const Row largest = half*root;
+      const Row factor = half/root;
+      const Row a = (r21 - r12)*factor, b = (r02 - r20)*factor, c = (r10 - r01)*factor;
+      const Row d = (r01 + r10)*factor, e = (r02 + r20)*factor, f = (r12 + r21)*factor;
+      destinations.row(0).segment(start, length).array() = isW*largest + isX*a + isY*b + isZ*c;
+      destinations.row(1).segment(start, length).array() = isW*a + isX*largest + isY*d + isZ*e;
+      destinations.row(2).segment(start, length).array() = isW*b + isX*d + isY*largest + isZ*f;
+      destinations.row(3).segment(start, length).array() = isW*c + isX*e + isY*f + isZ*largest;
+    }
+  }
+};
+
+/*! \brief Rotation quaternions from Euler angles with z-y-x convention, q = qz*qy*qx with the half angles.
+ *  Only for float, since Eigen vectorizes sin and cos only for float. For double, the ConversionTraits are faster.
+ */
+template<>
+class ArrayConversionTraits<RotationQuaternion<float>, EulerAnglesZyx<float>> {
+ public:
+  enum { UseForStructureOfArrays = 1 };
+  enum { UseForArrayOfStructures = 1 };
+
+  template<typename SourceMatrix_, typename DestMatrix_>
+  inline static void convert(const SourceMatrix_& sources, DestMatrix_& destinations, int begin, int end) {
+    typedef BatchConversionRow<float> Row;
+    for (int start = begin; start < end; start += BatchConversionBlockSize) {
+      const int length = std::min<int>(BatchConversionBlockSize, end - start);
+      const Row halfYaw = 0.5f*sources.row(0).segment(start, length).array();
+      const Row halfPitch = 0.5f*sources.row(1).segment(start, length).array();
+      const Row halfRoll = 0.5f*sources.row(2).segment(start, length).array();
+      const Row cz = halfYaw.cos(), sz = halfYaw.sin();
+      const Row cy = halfPitch.cos(), sy = halfPitch.sin();
+      const Row cx = halfRoll.cos(), sx = halfRoll.sin();
+      destinations.row(0).segment(start, length).array() = cz*cy*cx + sz*sy*sx;
+      destinations.row(1).segment(start, length).array() = cz*cy*sx - sz*sy*cx;
+      destinations.row(2).segment(start, length).array() = cz*sy*cx + sz*cy*sx;
+      destinations.row(3).segment(start, length).array() = sz*cy*cx - cz*sy*sx;
+    }
+  }
+};
+
+/*! \brief Euler angles with z-y-x convention from rotation quaternions, only the required elements of the rotation matrices are computed.
+ */
+template<typename PrimType_>
+class ArrayConversionTraits<EulerAnglesZyx<PrimType_>, RotationQuaternion<PrimType_>> {
+ public:
+  //! For double, the scalar atan2 dominates and the kernel is not faster than the ConversionTraits
+  enum { UseForStructureOfArrays = std::is_same<PrimType_, float>::value };
+  enum { UseForArrayOfStructures = 0 };
+
+  template<typename SourceMatrix_, typename DestMatrix_>
+  inline static void convert(const SourceMatrix_& sources, DestMatrix_& destinations, int begin, int end) {
+    typedef BatchConversionRow<PrimType_> Row;
+    const PrimType_ one = PrimType_(1);
+    const PrimType_ two = PrimType_(2);
+    for (int start = begin; start < end; start += BatchConversionBlockSize) {
+      const int length = std::min<int>(BatchConversionBlockSize, end - start);
+      const auto w = sources.row(0).segment(start, length).array(), x = sources.row(1).segment(start, length).array();
+      const auto y = sources.row(2).segment(start, length).array(), z = sources.row(3).segment(start, length).array();
+      setEulerAnglesZyxFromRotationMatrixElements<PrimType_>(Row(one - two*(y*y + z*z)), Row(two*(x*y - w*z)),
+                                                             Row(two*(x*y + w*z)), Row(one - two*(x*x + z*z)),
+                                                             Row(two*(x*z - w*y)), Row(two*(y*z + w*x)), Row(one - two*(x*x + y*y)),
+                                                             destinations, start);
+    }
+  }
+};
+
+/*! \brief Euler angles with z-y-x convention from rotation matrices.
+ */
+template<typename PrimType_>
+class ArrayConversionTraits<EulerAnglesZyx<PrimType_>, RotationMatrix<PrimType_>> {
+ public:
+  enum { UseForStructureOfArrays = 1 };
+  enum { UseForArrayOfStructures = 0 };
+
+  template<typename SourceMatrix_, typename DestMatrix_>
+  inline static void convert(const SourceMatrix_& sources, DestMatrix_& destinations, int begin, int end) {
+    typedef BatchConversionRow<PrimType_> Row;
+    for (int start = begin; start < end; start += BatchConversionBlockSize) {
+      const int length = std::min<int>(BatchConversionBlockSize, end - start);
+      setEulerAnglesZyxFromRotationMatrixElements<PrimType_>(Row(sources.row(0).segment(start, length)), Row(sources.row(3).segment(start, length)),
+                                                             Row(sources.row(1).segment(start, length)), Row(sources.row(4).segment(start, length)),
+                                                             Row(sources.row(2).segment(start, length)), Row(sources.row(5).segment(start, length)),
+                                                             Row(sources.row(8).segment(start, length)), destinations, start);
+    }
+  }
+};
+
+/*! \class StructureOfArraysConversionTraits
+ *  \brief Conversion of the columns [begin,end) of a structure-of-arrays batch, see RotationArrayTraits.
+ *
+ *  If ArrayConversionTraits<Dest_, Source_>::UseForStructureOfArrays is true, the columns are converted with the
+ *  kernel, otherwise they are converted one by one with the ConversionTraits.
+ *  (only for advanced users)
+ */
+template<typename Dest_, typename Source_, bool UseKernel_ = ArrayConversionTraits<Dest_, Source_>::UseForStructureOfArrays>
+class StructureOfArraysConversionTraits {
+ public:
+  template<typename SourceMatrix_, typename DestMatrix_>
+  inline static void convert(const SourceMatrix_& sources, DestMatrix_& destinations, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      RotationArrayTraits<Dest_>::set(destinations, i, ConversionTraits<Dest_, Source_>::convert(RotationArrayTraits<Source_>::get(sources, i)));
+    }
+  }
+};
+
+template<typename Dest_, typename Source_>
+class StructureOfArraysConversionTraits<Dest_, Source_, true> {
+ public:
+  template<typename SourceMatrix_, typename DestMatrix_>
+  inline static void convert(const SourceMatrix_& sources, DestMatrix_& destinations, int begin, int end) {
+    ArrayConversionTraits<Dest_, Source_>::convert(sources, destinations, begin, end);
+  }
+};
+
+/*! \class BatchConversionTraits
+ *  \brief Conversion of the elements [begin,end) of contiguous arrays of rotations.
+ *
+ *  If ArrayConversionTraits<Dest_, Source_>::UseForArrayOfStructures is true, the rotations are copied block by block to
+ *  structure-of-arrays storage on the stack and converted with the kernel, otherwise they are converted one by one
+ *  with the ConversionTraits, which are direct formulas for most pairs.
+ *  (only for advanced users)
+ */
+template<typename Dest_, typename Source_, bool UseKernel_ = ArrayConversionTraits<Dest_, Source_>::UseForArrayOfStructures>
+class BatchConversionTraits {
+ public:
+  inline static void convert(const Source_* sources, Dest_* destinations, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      destinations[i] = ConversionTraits<Dest_, Source_>::convert(sources[i]);
+    }
+  }
+};
+
+template<typename Dest_, typename Source_>
+class BatchConversionTraits<Dest_, Source_, true> {
+ public:
+  inline static void convert(const Source_* sources, Dest_* destinations, int begin, int end) {
+    typedef Eigen::Matrix<typename Source_::Scalar, RotationArrayTraits<Source_>::Rows, BatchConversionBlockSize, Eigen::RowMajor> SourceBlock;
+    typedef Eigen::Matrix<typename Dest_::Scalar, RotationArrayTraits<Dest_>::Rows, BatchConversionBlockSize, Eigen::RowMajor> DestBlock;
+    SourceBlock sourceBlock;
+    DestBlock destBlock;
+    for (int start = begin; start < end; start += BatchConversionBlockSize) {
+      const int length = std::min<int>(BatchConversionBlockSize, end - start);
+      for (int i = 0; i < length; ++i) {
+        RotationArrayTraits<Source_>::set(sourceBlock, i, sources[start + i]);
+      }
+      ArrayConversionTraits<Dest_, Source_>::convert(sourceBlock, destBlock, 0, length);
+      for (int i = 0; i < length; ++i) {
+        destinations[start + i] = RotationArrayTraits<Dest_>::get(destBlock, i);
+      }
+    }
+  }
+};
+
+/*! \class ArrayFromUnitVectorsTraits
+ *  \brief Minimal rotations between the columns [begin,end) of two row-major 3xN matrices of unit vectors, see UnitVectorsRotationTraits.
+ *
+ *  The default computes the rotations one by one. The specializations for rotation quaternions and rotation matrices
+ *  evaluate the closed form as coefficient-wise expressions on the rows and fix the few antiparallel pairs afterwards.
+ *  (only for advanced users)
+ */
+template<typename Dest_>
+class ArrayFromUnitVectorsTraits {
+ public:
+  template<typename FromMatrix_, typename ToMatrix_, typename DestMatrix_>
+  inline static void set(const FromMatrix_& from, const ToMatrix_& to, DestMatrix_& destinations, int begin, int end) {
+    typedef Eigen::Matrix<typename Dest_::Scalar, 3, 1> Vector3;
+    for (int i = begin; i < end; ++i) {
+      RotationArrayTraits<Dest_>::set(destinations, i, UnitVectorsRotationTraits<Dest_>::get(Vector3(from.col(i)), Vector3(to.col(i))));
+    }
+  }
+};
+
+/*! \brief Computes 1+a.b and a x b of a block of unit vector pairs and fixes the antiparallel pairs with the single rotation traits.
+ */
+template<typename Dest_, typename FromMatrix_, typename ToMatrix_, typename DestMatrix_, typename Kernel_>
+inline void setFromUnitVectorsBlockwise(const FromMatrix_& from, const ToMatrix_& to, DestMatrix_& destinations, int begin, int end, const Kernel_& kernel) {
+  typedef typename Dest_::Scalar PrimType_;
+  typedef BatchConversionRow<PrimType_> Row;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  for (int start = begin; start < end; start += BatchConversionBlockSize) {
+    const int length = std::min<int>(BatchConversionBlockSize, end - start);
+    const auto ax = from.row(0).segment(start, length).array(), ay = from.row(1).segment(start, length).array();
+    const auto az = from.row(2).segment(start, length).array();
+    const auto bx = to.row(0).segment(start, length).array(), by = to.row(1).segment(start, length).array();
+    const auto bz = to.row(2).segment(start, length).array();
+    const Row onePlusD = PrimType_(1) + ax*bx + ay*by + az*bz;
+    const Row cx = ay*bz - az*by, cy = az*bx - ax*bz, cz = ax*by - ay*bx;
+    kernel(onePlusD, cx, cy, cz, start, length);
+    const BatchConversionConditionRow antiparallel = onePlusD <= NumTraits<PrimType_>::dummy_precision();
+    if (KINDR_UNLIKELY(antiparallel.any())) {
+      for (int i = 0; i < length; ++i) {
+        if (antiparallel(i)) {
+          RotationArrayTraits<Dest_>::set(destinations, start + i,
+                                          UnitVectorsRotationTraits<Dest_>::get(Vector3(from.col(start + i)), Vector3(to.col(start + i))));
+        }
+      }
+    }
+  }
+}
+
+/*! \brief Rotation quaternions q = [1+d; c]/|[1+d; c]|.
+ */
+template<typename PrimType_>
+class ArrayFromUnitVectorsTraits<RotationQuaternion<PrimType_>> {
+ public:
+  template<typename FromMatrix_, typename ToMatrix_, typename DestMatrix_>
+  inline static void set(const FromMatrix_& from, const ToMatrix_& to, DestMatrix_& destinations, int begin, int end) {
+    typedef BatchConversionRow<PrimType_> Row;
+    setFromUnitVectorsBlockwise<RotationQuaternion<PrimType_>>(from, to, destinations, begin, end,
+        [&destinations](const Row& onePlusD, const Row& cx, const Row& cy, const Row& cz, int start, int length) {
+      const Row factor = (onePlusD*onePlusD + cx*cx + cy*cy + cz*cz).rsqrt();
+      destinations.row(0).segment(start, length).array() = onePlusD*factor;
+      destinations.row(1).segment(start, length).array() = cx*factor;
+      destinations.row(2).segment(start, length).array() = cy*factor;
+      destinations.row(3).segment(start, length).array() = cz*factor;
+    });
+  }
+};
+
+/*! \brief Rotation matrices R = d*I + [c]x + c*c^T/(1+d), computed from the unnormalized quaternion [1+d; c]
+ *  with the homogeneous formula, see UnitVectorsRotationTraits.
+ */
+template<typename PrimType_>
+class ArrayFromUnitVectorsTraits<RotationMatrix<PrimType_>> {
+ public:
+  template<typename FromMatrix_, typename ToMatrix_, typename DestMatrix_>
+  inline static void set(const FromMatrix_& from, const ToMatrix_& to, DestMatrix_& destinations, int begin, int end) {
+    typedef BatchConversionRow<PrimType_> Row;
+    setFromUnitVectorsBlockwise<RotationMatrix<PrimType_>>(from, to, destinations, begin, end,
+        [&destinations](const Row& onePlusD, const Row& cx, const Row& cy, const Row& cz, int start, int length) {
+      const Row cSquaredNorm = cx*cx + cy*cy + cz*cz;
+      const Row k = PrimType_(2)/(onePlusD*onePlusD + cSquaredNorm);
+      const Row e = PrimType_(1) - k*cSquaredNorm;
+      const Row ks = k*onePlusD;
+      const Row kx = k*cx, ky = k*cy, kz = k*cz;
+      const Row ksx = ks*cx, ksy = ks*cy, ksz = ks*cz;
+      destinations.row(0).segment(start, length).array() = e + kx*cx;
+      destinations.row(1).segment(start, length).array() = ksz + kx*cy;
+      destinations.row(2).segment(start, length).array() = kx*cz - ksy;
+      destinations.row(3).segment(start, length).array() = kx*cy - ksz;
+      destinations.row(4).segment(start, length).array() = e + ky*cy;
+      destinations.row(5).segment(start, length).array() = ksx + ky*cz;
+      destinations.row(6).segment(start, length).array() = ksy + kx*cz;
+      destinations.row(7).segment(start, length).array() = ky*cz - ksx;
+      destinations.row(8).segment(start, length).array() = e + kz*cz;
+    });
+  }
+};
+
+} // namespace internal
+
+/*! \brief Converts an array of rotations to another parameterization.
+ *
+ *  The Euler angles z-y-x of float are converted to quaternions on blocks of rotations with vectorized sine and cosine,
+ *  all other pairs with the ConversionTraits of the single rotations. Example:
+ *  \code{cpp}
+ *  kindr::convert(matrices.data(), eulerAngles.data(), static_cast<int>(matrices.size()));
+ *  \endcode
+ *
+ *  \param sources        array of rotations
+ *  \param destinations   array of at least size rotations, the converted rotations are written here
+ *  \param size           number of rotations
+ *  \param executor       executor on which the rotations are split, see Executor.hpp
+ */
+template<typename Dest_, typename Source_, typename Executor_ = SerialExecutor>
+void convert(const Source_* sources, Dest_* destinations, int size, const Executor_& executor = Executor_()) {
+  executor.parallelFor(0, size, internal::BatchConversionGrainSize, [sources, destinations](int begin, int end) {
+    internal::BatchConversionTraits<Dest_, Source_>::convert(sources, destinations, begin, end);
+  });
+}
+
+/*! \brief Converts a vector of rotations to another parameterization.
+ *  \param sources        vector of rotations
+ *  \param destinations   vector which is resized to the number of sources, the converted rotations are written here
+ *  \param executor       executor on which the rotations are split, see Executor.hpp
+ */
+template<typename Dest_, typename DestAllocator_, typename Source_, typename SourceAllocator_, typename Executor_ = SerialExecutor>
+void convert(const std::vector<Source_, SourceAllocator_>& sources, std::vector<Dest_, DestAllocator_>& destinations, const Executor_& executor = Executor_()) {
+  destinations.resize(sources.size());
+  convert(sources.data(), destinations.data(), static_cast<int>(sources.size()), executor);
+}
+
+/*! \brief Converts rotations stored in structure-of-arrays layout to another parameterization.
+ *
+ *  Each column of the matrices holds one rotation, see internal::RotationArrayTraits for the order of the coefficients.
+ *  Quaternions and rotation matrices are converted into each other and to Euler angles z-y-x with vectorized expressions
+ *  on the rows where this is faster for the scalar type, see internal::ArrayConversionTraits, all other pairs with the
+ *  ConversionTraits of the single rotations.
+ *  A RotationQuaternionArray can be passed with toImplementation(). Example:
+ *  \code{cpp}
+ *  Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor> yawPitchRoll(3, quaternions.size());
+ *  kindr::convert<kindr::EulerAnglesZyxD, kindr::RotationQuaternionD>(quaternions.toImplementation(), yawPitchRoll);
+ *  \endcode
+ *
+ *  \tparam Dest_         parameterization of the destinations
+ *  \tparam Source_       parameterization of the sources
+ *  \param sources        row-major matrix of rotations
+ *  \param destinations   row-major matrix with the same number of columns, the converted rotations are written here
+ *  \param executor       executor on which the rotations are split, see Executor.hpp
+ */
+template<typename Dest_, typename Source_, typename Executor_ = SerialExecutor>
+void convert(const Eigen::Ref<const typename internal::RotationArrayTraits<Source_>::Matrix>& sources,
+             Eigen::Ref<typename internal::RotationArrayTraits<Dest_>::Matrix> destinations,
+             const Executor_& executor = Executor_()) {
+  KINDR_ASSERT_TRUE(std::runtime_error, destinations.cols() == sources.cols(), "The number of destinations must be equal to the number of sources.");
+  executor.parallelFor(0, static_cast<int>(sources.cols()), internal::BatchConversionGrainSize, [&sources, &destinations](int begin, int end) {
+    internal::StructureOfArraysConversionTraits<Dest_, Source_>::convert(sources, destinations, begin, end);
+  });
+}
+
+namespace internal {
+
+/*! \brief Unique Euler angles of the columns [begin,end) as in EulerAnglesZyx::getUnique() and EulerAnglesXyz::getUnique().
+ *  The five cases of the pitch are blended with exclusive 0/1 weights instead of branches. At the gimbal lock, the
+ *  third angle is added to the first with the sign of the pitch for x-y-z and with the opposite sign for z-y-x.
+ */
+template<typename EulerAngles_>
+inline void setUniqueEulerAngles(Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>& angles, int begin, int end) {
+  typedef typename EulerAngles_::Scalar PrimType_;
+  typedef BatchConversionRow<PrimType_> Row;
+  const PrimType_ lockSign = std::is_same<EulerAngles_, EulerAnglesZyx<PrimType_>>::value ? PrimType_(-1) : PrimType_(1);
+  const PrimType_ one = PrimType_(1);
+  const PrimType_ pi = PrimType_(M_PI);
+  const PrimType_ halfPi = PrimType_(M_PI/2);
+  const PrimType_ tol = PrimType_(1e-3);
+  for (int start = begin; start < end; start += BatchConversionBlockSize) {
+    const int length = std::min<int>(BatchConversionBlockSize, end - start);
+    const Row first = wrapPosNegPIArray(angles.row(0).segment(start, length).array());
+    const Row second = wrapPosNegPIArray(angles.row(1).segment(start, length).array());
+    const Row third = wrapPosNegPIArray(angles.row(2).segment(start, length).array());
+    const Row isBelow = (second < -halfPi - tol).template cast<PrimType_>();
+    const Row isAbove = (second > halfPi + tol).template cast<PrimType_>();
+    const Row isFlipped = isBelow + isAbove;
+    const Row isLockedBelow = ((second + halfPi).abs() <= tol).template cast<PrimType_>();
+    const Row isLockedAbove = ((second - halfPi).abs() <= tol).template cast<PrimType_>();
+    // flipped: +pi for negative angles, -pi otherwise
+    const Row firstFlipped = first + pi*(one - PrimType_(2)*(first >= PrimType_(0)).template cast<PrimType_>());
+    const Row thirdFlipped = third + pi*(one - PrimType_(2)*(third >= PrimType_(0)).template cast<PrimType_>());
+    const Row isKept = one - isFlipped;
+    angles.row(0).segment(start, length).array() = isKept*first + isFlipped*firstFlipped + lockSign*(isLockedAbove - isLockedBelow)*third;
+    angles.row(1).segment(start, length).array() = isKept*second + isFlipped*(pi*(isAbove - isBelow) - second);
+    angles.row(2).segment(start, length).array() = (isKept - isLockedBelow - isLockedAbove)*third + isFlipped*thirdFlipped;
+  }
+}
+
+} // namespace internal
+
+/*! \brief Sets Euler angles to their unique form, with angles in [-pi,pi),[-pi/2,pi/2),[-pi,pi).
+ *
+ *  This is the batched version of EulerAnglesZyx::getUnique() and EulerAnglesXyz::getUnique(), evaluated with
+ *  vectorized expressions on the rows. Example:
+ *  \code{cpp}
+ *  kindr::setUniqueEulerAngles<kindr::EulerAnglesZyxD>(yawPitchRoll);
+ *  \endcode
+ *  \tparam EulerAngles_   EulerAnglesZyx or EulerAnglesXyz
+ *  \param angles         row-major 3xN matrix of Euler angles, see internal::RotationArrayTraits, modified in place
+ *  \param executor       executor on which the angles are split, see Executor.hpp
+ */
+template<typename EulerAngles_, typename Executor_ = SerialExecutor>
+void setUniqueEulerAngles(Eigen::Matrix<typename EulerAngles_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>& angles, const Executor_& executor = Executor_()) {
+  static_assert(std::is_same<EulerAngles_, EulerAnglesZyx<typename EulerAngles_::Scalar>>::value || std::is_same<EulerAngles_, EulerAnglesXyz<typename EulerAngles_::Scalar>>::value,
+                "The angles must be Euler angles.");
+  executor.parallelFor(0, static_cast<int>(angles.cols()), internal::BatchConversionGrainSize, [&angles](int begin, int end) {
+    internal::setUniqueEulerAngles<EulerAngles_>(angles, begin, end);
+  });
+}
+
+/*! \brief Makes a sequence of Euler angles continuous, e.g. to plot or differentiate a trajectory.
+ *
+ *  Each set of angles is replaced by the equivalent one, i.e. either (a, b, c) or (a+pi, pi-b, c+pi) shifted by
+ *  multiples of 2*pi, which is closest to its predecessor. The first set is kept. This holds for both Euler angles z-y-x
+ *  [yaw; pitch; roll] and x-y-z [roll; pitch; yaw], the pitch may therefore leave [-pi/2, pi/2] to stay continuous.
+ *  \param angles   row-major 3xN matrix of Euler angles, see internal::RotationArrayTraits, modified in place
+ */
+template<typename PrimType_>
+void unwrapEulerAngles(Eigen::Matrix<PrimType_, 3, Eigen::Dynamic, Eigen::RowMajor>& angles) {
+  typedef Eigen::Array<PrimType_, 3, 1> Array3;
+  const PrimType_ pi = PrimType_(M_PI);
+  const PrimType_ twoPi = PrimType_(2.0*M_PI);
+  for (int i = 1; i < angles.cols(); ++i) {
+    const Array3 previous = angles.col(i - 1).array();
+    Array3 angle = angles.col(i).array();
+    Array3 flipped(angle(0) + pi, pi - angle(1), angle(2) + pi);
+    angle += twoPi*((previous - angle)/twoPi).round();
+    flipped += twoPi*((previous - flipped)/twoPi).round();
+    angles.col(i) = ((flipped - previous).matrix().squaredNorm() < (angle - previous).matrix().squaredNorm() ? flipped : angle).matrix();
+  }
+}
+
+/*! \brief Converts a sequence of rotations stored in structure-of-arrays layout to continuous Euler angles.
+ *
+ *  The rotations are converted as with convert() and made continuous with unwrapEulerAngles(). Example:
+ *  \code{cpp}
+ *  Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor> yawPitchRoll(3, quaternions.size());
+ *  kindr::convertToContinuousEulerAngles<kindr::EulerAnglesZyxD, kindr::RotationQuaternionD>(quaternions.toImplementation(), yawPitchRoll);
+ *  \endcode
+ *
+ *  \tparam Dest_         EulerAnglesZyx or EulerAnglesXyz
+ *  \tparam Source_       parameterization of the sources
+ *  \param sources        row-major matrix of rotations, ordered in time
+ *  \param destinations   row-major 3xN matrix with the same number of columns, the Euler angles are written here
+ *  \param executor       executor on which the conversion is split, see Executor.hpp
+ */
+template<typename Dest_, typename Source_, typename Executor_ = SerialExecutor>
+void convertToContinuousEulerAngles(const Eigen::Ref<const typename internal::RotationArrayTraits<Source_>::Matrix>& sources,
+                                    typename internal::RotationArrayTraits<Dest_>::Matrix& destinations,
+                                    const Executor_& executor = Executor_()) {
+  static_assert(std::is_same<Dest_, EulerAnglesZyx<typename Dest_::Scalar>>::value || std::is_same<Dest_, EulerAnglesXyz<typename Dest_::Scalar>>::value,
+                "The destinations must be Euler angles.");
+  convert<Dest_, Source_>(sources, destinations, executor);
+  unwrapEulerAngles(destinations);
+}
+
+/*! \brief Converts a sequence of rotations to continuous Euler angles, see convertToContinuousEulerAngles().
+ *  \param sources        array of rotations, ordered in time
+ *  \param size           number of rotations
+ *  \param destinations   row-major 3xN matrix which is resized to the number of rotations, the Euler angles are written here
+ */
+template<typename Dest_, typename Source_>
+void convertToContinuousEulerAngles(const Source_* sources, int size, typename internal::RotationArrayTraits<Dest_>::Matrix& destinations) {
+  static_assert(std::is_same<Dest_, EulerAnglesZyx<typename Dest_::Scalar>>::value || std::is_same<Dest_, EulerAnglesXyz<typename Dest_::Scalar>>::value,
+                "The destinations must be Euler angles.");
+  destinations.resize(3, size);
+  for (int i = 0; i < size; ++i) {
+    internal::RotationArrayTraits<Dest_>::set(destinations, i, internal::ConversionTraits<Dest_, Source_>::convert(sources[i]));
+  }
+  unwrapEulerAngles(destinations);
+}
+
+/*! \brief Sets the minimal rotations which rotate unit vectors onto unit vectors, i.e. to.col(i) = R_i*from.col(i).
+ *
+ *  This is the batched version of RotationBase::setFromUnitVectors(). The rotations are written in structure-of-arrays
+ *  layout, see internal::RotationArrayTraits. Rotation quaternions and rotation matrices are computed in closed form with
+ *  vectorized expressions on the rows, all other parameterizations are converted from rotation quaternions. Example:
+ *  \code{cpp}
+ *  kindr::RotationQuaternionArrayD rotations(normals.cols());
+ *  kindr::setFromUnitVectors<kindr::RotationQuaternionD>(normals, targets, rotations.toImplementation());
+ *  \endcode
+ *
+ *  \tparam Dest_         parameterization of the rotations
+ *  \param from           row-major 3xN matrix of unit vectors
+ *  \param to             row-major 3xN matrix of unit vectors
+ *  \param destinations   row-major matrix with N columns, the rotations are written here
+ *  \param executor       executor on which the rotations are split, see Executor.hpp
+ */
+template<typename Dest_, typename Executor_ = SerialExecutor>
+void setFromUnitVectors(const Eigen::Ref<const Eigen::Matrix<typename Dest_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>>& from,
+                        const Eigen::Ref<const Eigen::Matrix<typename Dest_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>>& to,
+                        Eigen::Ref<typename internal::RotationArrayTraits<Dest_>::Matrix> destinations,
+                        const Executor_& executor = Executor_()) {
+  KINDR_ASSERT_TRUE(std::runtime_error, to.cols() == from.cols(), "The number of target vectors must be equal to the number of source vectors.");
+  KINDR_ASSERT_TRUE(std::runtime_error, destinations.cols() == from.cols(), "The number of destinations must be equal to the number of vectors.");
+  executor.parallelFor(0, static_cast<int>(from.cols()), internal::BatchConversionGrainSize, [&from, &to, &destinations](int begin, int end) {
+    internal::ArrayFromUnitVectorsTraits<Dest_>::set(from, to, destinations, begin, end);
+  });
+}
+
+/*! \brief Sets the minimal rotations which rotate unit vectors onto the same unit vector, i.e. to = R_i*from.col(i),
+ *  e.g. to align measured normals or gravity directions with the z-axis.
+ *  \param from           row-major 3xN matrix of unit vectors
+ *  \param to             unit vector
+ *  \param destinations   row-major matrix with N columns, the rotations are written here
+ *  \param executor       executor on which the rotations are split, see Executor.hpp
+ */
+template<typename Dest_, typename Executor_ = SerialExecutor>
+void setFromUnitVectorsToVector(const Eigen::Ref<const Eigen::Matrix<typename Dest_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>>& from,
+                                const Eigen::Matrix<typename Dest_::Scalar, 3, 1>& to,
+                                Eigen::Ref<typename internal::RotationArrayTraits<Dest_>::Matrix> destinations,
+                                const Executor_& executor = Executor_()) {
+  KINDR_ASSERT_TRUE(std::runtime_error, destinations.cols() == from.cols(), "The number of destinations must be equal to the number of vectors.");
+  executor.parallelFor(0, static_cast<int>(from.cols()), internal::BatchConversionGrainSize, [&from, &to, &destinations](int begin, int end) {
+    internal::ArrayFromUnitVectorsTraits<Dest_>::set(from, to.rowwise().replicate(end), destinations, begin, end);
+  });
+}
+
+} // namespace kindr
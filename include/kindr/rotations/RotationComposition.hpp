@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRight_ HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/vectors/Vector.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+namespace internal {
+
+/*! \brief Approximate number of floating-point operations of the operations of a rotation type.
+ *  Rotate is the cost of rotating a vector, Multiply of concatenating two rotations of the type, ToMatrix and
+ *  ToQuaternion of the conversions. The default is for the parameterizations which are converted with trigonometric
+ *  functions in every operation, e.g. angle-axis and Euler angles.
+ */
+template<typename Rotation_>
+struct RotationOperationCost {
+  enum { Rotate = 60, Multiply = 120, ToMatrix = 40, ToQuaternion = 40 };
+};
+
+template<typename PrimType_>
+struct RotationOperationCost<RotationQuaternion<PrimType_>> {
+  enum { Rotate = 30, Multiply = 28, ToMatrix = 25, ToQuaternion = 0 };
+};
+
+template<typename PrimType_>
+struct RotationOperationCost<RotationMatrix<PrimType_>> {
+  enum { Rotate = 15, Multiply = 45, ToMatrix = 0, ToQuaternion = 40 };
+};
+
+/*! \brief Gets the type in which the factors of a composition are concatenated before the product is converted to the
+ *  type of the result, which is a rotation matrix for rotation matrices and a rotation quaternion otherwise.
+ */
+template<typename Rotation_>
+struct get_composition_intermediate {
+  typedef RotationQuaternion<typename Rotation_::Scalar> Intermediate;
+  enum { Rotate = RotationOperationCost<Intermediate>::Rotate, Multiply = RotationOperationCost<Intermediate>::Multiply };
+  template<typename Factor_>
+  struct Conversion {
+    enum { Cost = RotationOperationCost<Factor_>::ToQuaternion };
+  };
+};
+
+template<typename PrimType_>
+struct get_composition_intermediate<RotationMatrix<PrimType_>> {
+  typedef RotationMatrix<PrimType_> Intermediate;
+  enum { Rotate = RotationOperationCost<Intermediate>::Rotate, Multiply = RotationOperationCost<Intermediate>::Multiply };
+  template<typename Factor_>
+  struct Conversion {
+    enum { Cost = RotationOperationCost<Factor_>::ToMatrix };
+  };
+};
+
+/*! \brief Cost of rotating vectors by the factors of a composition (Sequential), and of converting the factors to the
+ *  intermediate type of a result type (conversion).
+ */
+template<typename Result_, typename... Rotations_>
+struct CompositionCost {
+  enum { Sequential = 0, Conversion = 0 };
+};
+
+template<typename Result_, typename First_, typename... Rest_>
+struct CompositionCost<Result_, First_, Rest_...> {
+  enum { Sequential = RotationOperationCost<First_>::Rotate + CompositionCost<Result_, Rest_...>::Sequential,
+         Conversion = get_composition_intermediate<Result_>::template Conversion<First_>::Cost + CompositionCost<Result_, Rest_...>::Conversion };
+};
+
+/*! \brief Gets the number of columns of a vector or a matrix, which is 1 for vectors with a physical type.
+ *  Value is the number at compile time, which may be Eigen::Dynamic.
+ */
+template<typename Vector_, typename Enable_ = void>
+struct get_columns {
+  enum { Value = 1 };
+  static int get(const Vector_& /*vector*/) {
+    return 1;
+  }
+};
+
+template<typename Vector_>
+struct get_columns<Vector_, typename std::enable_if<std::is_base_of<Eigen::EigenBase<Vector_>, Vector_>::value>::type> {
+  enum { Value = Vector_::ColsAtCompileTime };
+  static int get(const Vector_& vector) {
+    return static_cast<int>(vector.cols());
+  }
+};
+
+} // namespace internal
+
+
+/*! \class RotationComposition
+ *  \brief Lazy concatenation C_1*C_2*...*C_n of rotations, e.g. C_AB.lazy()*C_BC*C_CD.
+ *
+ *  The product of rotations with operator*() computes every intermediate rotation, and converts between the
+ *  parameterizations in every step if the factors have different types. The composition only stores the factors.
+ *  A vector is either rotated by the factors from right to left, or by the product, whichever needs fewer operations
+ *  according to internal::RotationOperationCost, see getEvaluation(). The choice is made at compile time for vectors and
+ *  fixed-size matrices, and from the number of columns for dynamic matrices. The product is only computed when the
+ *  composition is assigned to a rotation or evaluated with eval(). The factors are then converted once and concatenated
+ *  in a quaternion or a rotation matrix, and the product is converted to the type of the result once.
+ *
+ *  The factors are stored by value, so the composition stays valid after the rotations it was built from are gone.
+ *  \tparam Rotations_  types of the factors
+ *  \ingroup rotations
+ */
+template<typename... Rotations_>
+class RotationComposition {
+ public:
+  typedef std::tuple<Rotations_...> Factors;
+  typedef typename std::tuple_element<0, Factors>::type First;
+  typedef typename First::Scalar Scalar;
+  typedef RotationMatrix<Scalar> Matrix;
+
+  //! Number of factors
+  enum { Size = sizeof...(Rotations_) };
+
+  /*! \brief Constructor.
+   *  \param rotations   factors
+   */
+  explicit RotationComposition(const Rotations_&... rotations)
+    : factors_(rotations...) {
+  }
+
+  /*! \brief Constructor.
+   *  \param factors   tuple of factors
+   */
+  explicit RotationComposition(const Factors& factors)
+    : factors_(factors) {
+  }
+
+  //! \returns the factors
+  inline const Factors& getFactors() const {
+    return factors_;
+  }
+
+  /*! \brief Appends a rotation.
+   *  \returns the composition this*other
+   */
+  template<typename OtherDerived_>
+  RotationComposition<Rotations_..., OtherDerived_> operator *(const RotationBase<OtherDerived_>& other) const {
+    return RotationComposition<Rotations_..., OtherDerived_>(std::tuple_cat(factors_, std::tuple<OtherDerived_>(other.derived())));
+  }
+
+  /*! \brief Appends the factors of another composition.
+   *  \returns the composition this*other
+   */
+  template<typename... OtherRotations_>
+  RotationComposition<Rotations_..., OtherRotations_...> operator *(const RotationComposition<OtherRotations_...>& other) const {
+    return RotationComposition<Rotations_..., OtherRotations_...>(std::tuple_cat(factors_, other.getFactors()));
+  }
+
+  /*! \brief Computes the product in a rotation type.
+   *  The factors are concatenated in the intermediate type of the result, see internal::get_composition_intermediate,
+   *  and the product is converted to the result once.
+   *  \returns the product
+   */
+  template<typename Rotation_>
+  Rotation_ eval() const {
+    typedef typename internal::get_composition_intermediate<Rotation_>::Intermediate Intermediate;
+    return Rotation_(Intermediate(multiplyFrom<Intermediate>(toIntermediate<Intermediate>(std::get<0>(factors_),
+        std::is_same<Intermediate, First>()).toImplementation(), std::integral_constant<int, 1>())));
+  }
+
+  /*! \brief Computes the product in the type of the first factor, as operator*() of the rotations.
+   *  \returns the product
+   */
+  First eval() const {
+    return eval<First>();
+  }
+
+  /*! \brief Computes the product on assignment to a rotation.
+   *  \returns the product
+   */
+  template<typename Rotation_, typename = typename std::enable_if<std::is_base_of<RotationBase<Rotation_>, Rotation_>::value>::type>
+  operator Rotation_() const {
+    return eval<Rotation_>();
+  }
+
+  //! Ways of rotating vectors
+  enum class Evaluation {
+    Sequential,  ///< by the factors from right to left
+    Product,     ///< by the product in the intermediate type of the first factor
+    Matrix       ///< by the rotation matrix of the product
+  };
+
+  /*! \brief Gets the way of rotating vectors with the fewest operations.
+   *  \param columns   number of vectors
+   *  \returns evaluation
+   */
+  static constexpr Evaluation getEvaluation(int columns) {
+    return (getSequentialCost(columns) <= getProductCost<First>(columns) && getSequentialCost(columns) <= getProductCost<Matrix>(columns)) ?
+        Evaluation::Sequential : (getProductCost<First>(columns) <= getProductCost<Matrix>(columns) ? Evaluation::Product : Evaluation::Matrix);
+  }
+
+  /*! \brief Rotates a vector or the columns of a matrix, which may be an Eigen expression, e.g. 2*v, by the product.
+   *  \returns the evaluated rotated 3xN matrix
+   */
+  template<typename OtherDerived_>
+  Eigen::Matrix<Scalar, 3, OtherDerived_::ColsAtCompileTime> rotate(const Eigen::MatrixBase<OtherDerived_>& matrix) const {
+    return rotateEvaluated(Eigen::Matrix<Scalar, 3, OtherDerived_::ColsAtCompileTime>(matrix));
+  }
+
+  /*! \brief Rotates a vector with a physical type, e.g. a Position, by the product.
+   *  \returns the rotated vector of the same type
+   */
+  template<enum PhysicalType PhysicalType_>
+  Vector<PhysicalType_, Scalar, 3> rotate(const Vector<PhysicalType_, Scalar, 3>& vector) const {
+    return rotateEvaluated(vector);
+  }
+
+  /*! \brief Rotates a vector or the columns of a matrix, which may be an Eigen expression, by the inverse of the product.
+   *  \returns the evaluated reverse rotated 3xN matrix
+   */
+  template<typename OtherDerived_>
+  Eigen::Matrix<Scalar, 3, OtherDerived_::ColsAtCompileTime> inverseRotate(const Eigen::MatrixBase<OtherDerived_>& matrix) const {
+    return inverseRotateEvaluated(Eigen::Matrix<Scalar, 3, OtherDerived_::ColsAtCompileTime>(matrix));
+  }
+
+  /*! \brief Rotates a vector with a physical type by the inverse of the product.
+   *  \returns the reverse rotated vector of the same type
+   */
+  template<enum PhysicalType PhysicalType_>
+  Vector<PhysicalType_, Scalar, 3> inverseRotate(const Vector<PhysicalType_, Scalar, 3>& vector) const {
+    return inverseRotateEvaluated(vector);
+  }
+
+ private:
+  //! Rotates an evaluated vector or matrix in the cheapest way, see getEvaluation()
+  template<typename Vector_>
+  Vector_ rotateEvaluated(const Vector_& vector) const {
+    switch (getEvaluation(getColumns(vector))) {
+      case Evaluation::Sequential:
+        return rotateFrom(vector, std::integral_constant<int, 0>());
+      case Evaluation::Product:
+        return eval<typename internal::get_composition_intermediate<First>::Intermediate>().rotate(vector);
+      default:
+        return eval<Matrix>().rotate(vector);
+    }
+  }
+
+  //! Rotates an evaluated vector or matrix by the inverse of the product in the cheapest way
+  template<typename Vector_>
+  Vector_ inverseRotateEvaluated(const Vector_& vector) const {
+    switch (getEvaluation(getColumns(vector))) {
+      case Evaluation::Sequential:
+        return inverseRotateFrom(vector, std::integral_constant<int, 0>());
+      case Evaluation::Product:
+        return eval<typename internal::get_composition_intermediate<First>::Intermediate>().inverseRotate(vector);
+      default:
+        return eval<Matrix>().inverseRotate(vector);
+    }
+  }
+
+  static constexpr int getSequentialCost(int columns) {
+    return columns*int(internal::CompositionCost<First, Rotations_...>::Sequential);
+  }
+
+  //! Cost of concatenating the factors in the intermediate type of a result type and rotating the vectors by the product
+  template<typename Result_>
+  static constexpr int getProductCost(int columns) {
+    return int(internal::CompositionCost<Result_, Rotations_...>::Conversion) + (int(Size) - 1)*int(internal::get_composition_intermediate<Result_>::Multiply) +
+        columns*int(internal::get_composition_intermediate<Result_>::Rotate);
+  }
+
+  //! Number of vectors, known at compile time unless the matrix has a dynamic number of columns
+  template<typename Vector_>
+  static int getColumns(const Vector_& vector) {
+    typedef internal::get_columns<Vector_> Columns;
+    return (int(Columns::Value) == int(Eigen::Dynamic)) ? Columns::get(vector) : int(Columns::Value);
+  }
+
+  //! Rotates by the factors Index_, ..., Size-1 from right to left
+  template<typename Vector_, int Index_>
+  Vector_ rotateFrom(const Vector_& vector, std::integral_constant<int, Index_>) const {
+    return std::get<Index_>(factors_).rotate(rotateFrom(vector, std::integral_constant<int, Index_ + 1>()));
+  }
+
+  template<typename Vector_>
+  Vector_ rotateFrom(const Vector_& vector, std::integral_constant<int, Size>) const {
+    return vector;
+  }
+
+  //! Rotates by the inverses of the factors Index_, ..., Size-1 from left to right
+  template<typename Vector_, int Index_>
+  Vector_ inverseRotateFrom(const Vector_& vector, std::integral_constant<int, Index_>) const {
+    return inverseRotateFrom(std::get<Index_>(factors_).inverseRotate(vector), std::integral_constant<int, Index_ + 1>());
+  }
+
+  template<typename Vector_>
+  Vector_ inverseRotateFrom(const Vector_& vector, std::integral_constant<int, Size>) const {
+    return vector;
+  }
+
+  //! Concatenates the factors Index_, ..., Size-1 to the implementation of a product in the intermediate type from the right
+  template<typename Intermediate_, int Index_, typename std::enable_if<(Index_ < Size), int>::type = 0>
+  typename Intermediate_::Implementation multiplyFrom(const typename Intermediate_::Implementation& product, std::integral_constant<int, Index_>) const {
+    return multiplyFrom<Intermediate_>(typename Intermediate_::Implementation(product*toIntermediate<Intermediate_>(std::get<Index_>(factors_),
+        std::is_same<Intermediate_, typename std::tuple_element<Index_, Factors>::type>()).toImplementation()), std::integral_constant<int, Index_ + 1>());
+  }
+
+  template<typename Intermediate_, int Index_, typename std::enable_if<(Index_ == Size), int>::type = 0>
+  typename Intermediate_::Implementation multiplyFrom(const typename Intermediate_::Implementation& product, std::integral_constant<int, Index_>) const {
+    return product;
+  }
+
+  template<typename Intermediate_, typename Rotation_>
+  static Intermediate_ toIntermediate(const Rotation_& rotation, std::false_type) {
+    return Intermediate_(rotation);
+  }
+
+  template<typename Intermediate_>
+  static const Intermediate_& toIntermediate(const Intermediate_& rotation, std::true_type) {
+    return rotation;
+  }
+
+  Factors factors_;
+};
+
+} // namespace kindr
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+#include "kindr/math/ConstexprMath.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+template<typename PrimType_>
+class RotationMatrixConstant;
+
+/*! \class RotationQuaternionConstant
+ *  \brief Rotation quaternion which can be constructed and converted at compile time.
+ *
+ *  The rotations of kindr store Eigen objects, which cannot be created in constant expressions. This literal type
+ *  holds the coefficients of a rotation quaternion, such that fixed rotations, e.g. the mounting of a sensor, can be
+ *  computed from Euler angles or an angle-axis and converted to a rotation matrix when the program is compiled:
+ *
+ *    constexpr RotationQuaternionConstant<double> mount = RotationQuaternionConstant<double>::fromEulerAnglesZyx(M_PI/2, 0.0, 0.0);
+ *
+ *  The conversions to the rotations of kindr at runtime only copy the coefficients. The conversion to Euler angles
+ *  needs atan2 and is only available at runtime.
+ *
+ *  \tparam PrimType_  the primitive type of the coefficients (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationQuaternionConstant {
+ public:
+  typedef PrimType_ Scalar;
+
+  /*! \brief Constructor using four scalars of a unit quaternion.
+   *  \param w   real part
+   *  \param x   first imaginary coefficient
+   *  \param y   second imaginary coefficient
+   *  \param z   third imaginary coefficient
+   */
+  constexpr RotationQuaternionConstant(Scalar w, Scalar x, Scalar y, Scalar z)
+    : w_(w), x_(x), y_(y), z_(z) {
+  }
+
+  /*! \brief Gets the identity rotation.
+   *  \returns identity
+   */
+  static constexpr RotationQuaternionConstant Identity() {
+    return RotationQuaternionConstant(static_cast<Scalar>(1), static_cast<Scalar>(0), static_cast<Scalar>(0), static_cast<Scalar>(0));
+  }
+
+  /*! \brief Gets the rotation by an angle about an axis, which does not need to be normalized.
+   *  \param angle   angle in radians
+   *  \param x       first coordinate of the axis
+   *  \param y       second coordinate of the axis
+   *  \param z       third coordinate of the axis
+   *  \returns rotation
+   */
+  static constexpr RotationQuaternionConstant fromAngleAxis(Scalar angle, Scalar x, Scalar y, Scalar z) {
+    return fromScaledAxis(internal::constexprCos(angle/2), internal::constexprSin(angle/2)/internal::constexprSqrt(x*x + y*y + z*z), x, y, z);
+  }
+
+  /*! \brief Gets the rotation from Euler angles with z-y-x convention, see EulerAnglesZyx.
+   *  \param yaw     first rotation angle around Z axis
+   *  \param pitch   second rotation angle around Y' axis
+   *  \param roll    third rotation angle around X'' axis
+   *  \returns rotation
+   */
+  static constexpr RotationQuaternionConstant fromEulerAnglesZyx(Scalar yaw, Scalar pitch, Scalar roll) {
+    return fromScaledAxis(internal::constexprCos(yaw/2), internal::constexprSin(yaw/2), 0, 0, 1)
+         * fromScaledAxis(internal::constexprCos(pitch/2), internal::constexprSin(pitch/2), 0, 1, 0)
+         * fromScaledAxis(internal::constexprCos(roll/2), internal::constexprSin(roll/2), 1, 0, 0);
+  }
+
+  constexpr Scalar w() const {
+    return w_;
+  }
+
+  constexpr Scalar x() const {
+    return x_;
+  }
+
+  constexpr Scalar y() const {
+    return y_;
+  }
+
+  constexpr Scalar z() const {
+    return z_;
+  }
+
+  /*! \brief Concatenates two rotations.
+   *  \param other   other rotation
+   *  \returns concatenation
+   */
+  constexpr RotationQuaternionConstant operator*(const RotationQuaternionConstant& other) const {
+    return RotationQuaternionConstant(w_*other.w_ - x_*other.x_ - y_*other.y_ - z_*other.z_,
+                                      w_*other.x_ + x_*other.w_ + y_*other.z_ - z_*other.y_,
+                                      w_*other.y_ - x_*other.z_ + y_*other.w_ + z_*other.x_,
+                                      w_*other.z_ + x_*other.y_ - y_*other.x_ + z_*other.w_);
+  }
+
+  /*! \brief Gets the inverse rotation.
+   *  \returns conjugated quaternion
+   */
+  constexpr RotationQuaternionConstant inverted() const {
+    return RotationQuaternionConstant(w_, -x_, -y_, -z_);
+  }
+
+  /*! \brief Gets the unique form with non-negative real part.
+   *  \returns quaternion with non-negative real part
+   */
+  constexpr RotationQuaternionConstant getUnique() const {
+    return w_ < static_cast<Scalar>(0) ? RotationQuaternionConstant(-w_, -x_, -y_, -z_) : *this;
+  }
+
+  /*! \brief Converts the rotation to a rotation matrix at compile time.
+   *  \returns rotation matrix
+   */
+  constexpr RotationMatrixConstant<Scalar> toRotationMatrix() const;
+
+  /*! \brief Gets the rotation quaternion.
+   *  \returns rotation quaternion
+   */
+  RotationQuaternion<Scalar> getRotationQuaternion() const {
+    return RotationQuaternion<Scalar>(w_, x_, y_, z_);
+  }
+
+  /*! \brief Gets the rotation matrix.
+   *  \returns rotation matrix
+   */
+  RotationMatrix<Scalar> getRotationMatrix() const {
+    return toRotationMatrix().getRotationMatrix();
+  }
+
+  /*! \brief Gets the Euler angles with z-y-x convention (at runtime).
+   *  \returns Euler angles
+   */
+  EulerAnglesZyx<Scalar> getEulerAnglesZyx() const {
+    return EulerAnglesZyx<Scalar>(getRotationQuaternion());
+  }
+
+ private:
+  static constexpr RotationQuaternionConstant fromScaledAxis(Scalar cosHalfAngle, Scalar scale, Scalar x, Scalar y, Scalar z) {
+    return RotationQuaternionConstant(cosHalfAngle, scale*x, scale*y, scale*z);
+  }
+
+  Scalar w_;
+  Scalar x_;
+  Scalar y_;
+  Scalar z_;
+};
+
+/*! \class RotationMatrixConstant
+ *  \brief Rotation matrix which can be constructed and converted at compile time, see RotationQuaternionConstant.
+ *
+ *  \tparam PrimType_  the primitive type of the entries (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationMatrixConstant {
+ public:
+  typedef PrimType_ Scalar;
+
+  /*! \brief Constructor using nine scalars of an orthonormal matrix.
+   *  \param r11     entry in row 1, col 1
+   *  \param r12     entry in row 1, col 2
+   *  \param r13     entry in row 1, col 3
+   *  \param r21     entry in row 2, col 1
+   *  \param r22     entry in row 2, col 2
+   *  \param r23     entry in row 2, col 3
+   *  \param r31     entry in row 3, col 1
+   *  \param r32     entry in row 3, col 2
+   *  \param r33     entry in row 3, col 3
+   */
+  constexpr RotationMatrixConstant(Scalar r11, Scalar r12, Scalar r13,
+                                   Scalar r21, Scalar r22, Scalar r23,
+                                   Scalar r31, Scalar r32, Scalar r33)
+    : entries_{r11, r12, r13, r21, r22, r23, r31, r32, r33} {
+  }
+
+  /*! \brief Gets the identity rotation.
+   *  \returns identity
+   */
+  static constexpr RotationMatrixConstant Identity() {
+    return RotationMatrixConstant(1, 0, 0, 0, 1, 0, 0, 0, 1);
+  }
+
+  /*! \brief Gets an entry.
+   *  \param row   row index (0, 1 or 2)
+   *  \param col   column index (0, 1 or 2)
+   *  \returns entry
+   */
+  constexpr Scalar operator()(int row, int col) const {
+    return entries_[3*row + col];
+  }
+
+  /*! \brief Concatenates two rotations.
+   *  \param other   other rotation
+   *  \returns matrix product
+   */
+  constexpr RotationMatrixConstant operator*(const RotationMatrixConstant& other) const {
+    return RotationMatrixConstant(product(other, 0, 0), product(other, 0, 1), product(other, 0, 2),
+                                  product(other, 1, 0), product(other, 1, 1), product(other, 1, 2),
+                                  product(other, 2, 0), product(other, 2, 1), product(other, 2, 2));
+  }
+
+  /*! \brief Gets the inverse rotation.
+   *  \returns transposed matrix
+   */
+  constexpr RotationMatrixConstant inverted() const {
+    return RotationMatrixConstant((*this)(0, 0), (*this)(1, 0), (*this)(2, 0),
+                                  (*this)(0, 1), (*this)(1, 1), (*this)(2, 1),
+                                  (*this)(0, 2), (*this)(1, 2), (*this)(2, 2));
+  }
+
+  /*! \brief Converts the rotation to a rotation quaternion at compile time.
+   *  The quaternion is extracted from the largest of the trace and the diagonal entries (Shepperd's method).
+   *  \returns rotation quaternion with non-negative real part
+   */
+  constexpr RotationQuaternionConstant<Scalar> toRotationQuaternion() const {
+    return (trace() >= (*this)(0, 0) && trace() >= (*this)(1, 1) && trace() >= (*this)(2, 2)) ?
+             fromTrace(2*internal::constexprSqrt(1 + trace()))
+         : ((*this)(0, 0) >= (*this)(1, 1) && (*this)(0, 0) >= (*this)(2, 2)) ?
+             fromFirstDiagonal(2*internal::constexprSqrt(1 + (*this)(0, 0) - (*this)(1, 1) - (*this)(2, 2))).getUnique()
+         : ((*this)(1, 1) >= (*this)(2, 2)) ?
+             fromSecondDiagonal(2*internal::constexprSqrt(1 + (*this)(1, 1) - (*this)(0, 0) - (*this)(2, 2))).getUnique()
+         : fromThirdDiagonal(2*internal::constexprSqrt(1 + (*this)(2, 2) - (*this)(0, 0) - (*this)(1, 1))).getUnique();
+  }
+
+  /*! \brief Gets the rotation matrix.
+   *  \returns rotation matrix
+   */
+  RotationMatrix<Scalar> getRotationMatrix() const {
+    return RotationMatrix<Scalar>((*this)(0, 0), (*this)(0, 1), (*this)(0, 2),
+                                  (*this)(1, 0), (*this)(1, 1), (*this)(1, 2),
+                                  (*this)(2, 0), (*this)(2, 1), (*this)(2, 2));
+  }
+
+  /*! \brief Gets the rotation quaternion.
+   *  \returns rotation quaternion
+   */
+  RotationQuaternion<Scalar> getRotationQuaternion() const {
+    return toRotationQuaternion().getRotationQuaternion();
+  }
+
+  /*! \brief Gets the Euler angles with z-y-x convention (at runtime).
+   *  \returns Euler angles
+   */
+  EulerAnglesZyx<Scalar> getEulerAnglesZyx() const {
+    return EulerAnglesZyx<Scalar>(getRotationMatrix());
+  }
+
+ private:
+  constexpr Scalar product(const RotationMatrixConstant& other, int row, int col) const {
+    return (*this)(row, 0)*other(0, col) + (*this)(row, 1)*other(1, col) + (*this)(row, 2)*other(2, col);
+  }
+
+  constexpr Scalar trace() const {
+    return (*this)(0, 0) + (*this)(1, 1) + (*this)(2, 2);
+  }
+
+  //! s = 4w
+  constexpr RotationQuaternionConstant<Scalar> fromTrace(Scalar s) const {
+    return RotationQuaternionConstant<Scalar>(s/4, ((*this)(2, 1) - (*this)(1, 2))/s, ((*this)(0, 2) - (*this)(2, 0))/s, ((*this)(1, 0) - (*this)(0, 1))/s);
+  }
+
+  //! s = 4x
+  constexpr RotationQuaternionConstant<Scalar> fromFirstDiagonal(Scalar s) const {
+    return RotationQuaternionConstant<Scalar>(((*this)(2, 1) - (*this)(1, 2))/s, s/4, ((*this)(0, 1) + (*this)(1, 0))/s, ((*this)(0, 2) + (*this)(2, 0))/s);
+  }
+
+  //! s = 4y
+  constexpr RotationQuaternionConstant<Scalar> fromSecondDiagonal(Scalar s) const {
+    return RotationQuaternionConstant<Scalar>(((*this)(0, 2) - (*this)(2, 0))/s, ((*this)(0, 1) + (*this)(1, 0))/s, s/4, ((*this)(1, 2) + (*this)(2, 1))/s);
+  }
+
+  //! s = 4z
+  constexpr RotationQuaternionConstant<Scalar> fromThirdDiagonal(Scalar s) const {
+    return RotationQuaternionConstant<Scalar>(((*this)(1, 0) - (*this)(0, 1))/s, ((*this)(0, 2) + (*this)(2, 0))/s, ((*this)(1, 2) + (*this)(2, 1))/s, s/4);
+  }
+
+  //! Row-major entries
+  Scalar entries_[9];
+};
+
+template<typename PrimType_>
+constexpr RotationMatrixConstant<PrimType_> RotationQuaternionConstant<PrimType_>::toRotationMatrix() const {
+  return RotationMatrixConstant<PrimType_>(1 - 2*(y_*y_ + z_*z_), 2*(x_*y_ - w_*z_), 2*(x_*z_ + w_*y_),
+                                           2*(x_*y_ + w_*z_), 1 - 2*(x_*x_ + z_*z_), 2*(y_*z_ - w_*x_),
+                                           2*(x_*z_ - w_*y_), 2*(y_*z_ + w_*x_), 1 - 2*(x_*x_ + y_*y_));
+}
+
+//! \brief Rotation quaternion constant with primitive type double
+typedef RotationQuaternionConstant<double> RotationQuaternionConstantD;
+//! \brief Rotation quaternion constant with primitive type float
+typedef RotationQuaternionConstant<float> RotationQuaternionConstantF;
+//! \brief Rotation matrix constant with primitive type double
+typedef RotationMatrixConstant<double> RotationMatrixConstantD;
+//! \brief Rotation matrix constant with primitive type float
+typedef RotationMatrixConstant<float> RotationMatrixConstantF;
+
+} // namespace kindr
@@ -85,4 +85,134 @@ class RotationConversion {
   }
 };
 
+
+/*! \class RotationAdapter
+ *  \brief Adapter traits between kindr rotations and the rotation types of other libraries.
+ *
+ *  A specialization for an external rotation type defines the kindr rotation with the same parameterization and
+ *  converts between both by copying the coefficients, i.e. without intermediate rotation quaternions:
+ *
+ *    typedef ... KindrRotation;
+ *    inline static void toKindr(KindrRotation& rotation, const External_& external);
+ *    inline static void fromKindr(External_& external, const KindrRotation& rotation);
+ *
+ *  Specializations for Eigen are provided below, the ones for ROS messages and tf2 in RotationConversionRos.hpp.
+ *  Use the free functions toKindr() and fromKindr() instead of the traits.
+ */
+template<typename External_>
+class RotationAdapter {
+ public:
+  // typedef ... KindrRotation;
+  // inline static void toKindr(KindrRotation& rotation, const External_& external);
+  // inline static void fromKindr(External_& external, const KindrRotation& rotation);
+};
+
+namespace internal {
+
+//! Passes a rotation with the requested parameterization through without copying it
+template<typename Rotation_>
+inline const Rotation_& getAdapterRotation(const Rotation_& rotation) {
+  return rotation;
+}
+
+//! Converts a rotation with another parameterization
+template<typename Rotation_, typename OtherDerived_>
+inline Rotation_ getAdapterRotation(const RotationBase<OtherDerived_>& rotation) {
+  return Rotation_(rotation.derived());
+}
+
+} // namespace internal
+
+/*! \brief Converts a rotation of another library to kindr.
+ *  \param external   rotation with a specialization of RotationAdapter
+ *  \returns the kindr rotation with the same parameterization
+ */
+template<typename External_>
+inline typename RotationAdapter<External_>::KindrRotation toKindr(const External_& external) {
+  typename RotationAdapter<External_>::KindrRotation rotation;
+  RotationAdapter<External_>::toKindr(rotation, external);
+  return rotation;
+}
+
+/*! \brief Converts a kindr rotation to a rotation of another library.
+ *  The coefficients are copied directly if the kindr rotation has the parameterization of the adapter, otherwise
+ *  it is converted to this parameterization first.
+ *  \param external   rotation with a specialization of RotationAdapter
+ *  \param rotation   kindr rotation
+ */
+template<typename External_, typename Derived_>
+inline void fromKindr(External_& external, const RotationBase<Derived_>& rotation) {
+  typedef typename RotationAdapter<External_>::KindrRotation KindrRotation;
+  RotationAdapter<External_>::fromKindr(external, internal::getAdapterRotation<KindrRotation>(rotation.derived()));
+}
+
+/*! \brief Converts a kindr rotation to a rotation of another library.
+ *  \param rotation   kindr rotation
+ *  \returns rotation with a specialization of RotationAdapter
+ */
+template<typename External_, typename Derived_>
+inline External_ fromKindr(const RotationBase<Derived_>& rotation) {
+  External_ external;
+  fromKindr(external, rotation);
+  return external;
+}
+
+/*! \brief Reinterprets an Eigen quaternion as kindr rotation quaternion without copying it.
+ *  Both store the coefficients in the order x, y, z, w.
+ *  \param quaternion   Eigen quaternion
+ *  \returns view of the quaternion
+ */
+template<typename PrimType_>
+inline RotationQuaternionMap<PrimType_> mapAsKindr(Eigen::Quaternion<PrimType_>& quaternion) {
+  return RotationQuaternionMap<PrimType_>(quaternion.coeffs().data());
+}
+
+/*! \brief Reinterprets a constant Eigen quaternion as read-only kindr rotation quaternion without copying it.
+ *  \param quaternion   Eigen quaternion
+ *  \returns read-only view of the quaternion
+ */
+template<typename PrimType_>
+inline RotationQuaternionMap<const PrimType_> mapAsKindr(const Eigen::Quaternion<PrimType_>& quaternion) {
+  return RotationQuaternionMap<const PrimType_>(quaternion.coeffs().data());
+}
+
+//! Eigen quaternion, the implementation of RotationQuaternion
+template<typename PrimType_>
+class RotationAdapter<Eigen::Quaternion<PrimType_>> {
+ public:
+  typedef RotationQuaternion<PrimType_> KindrRotation;
+  inline static void toKindr(KindrRotation& rotation, const Eigen::Quaternion<PrimType_>& external) {
+    rotation.toImplementation() = external;
+  }
+  inline static void fromKindr(Eigen::Quaternion<PrimType_>& external, const KindrRotation& rotation) {
+    external = rotation.toImplementation();
+  }
+};
+
+//! Eigen 3x3 matrix, the implementation of RotationMatrix
+template<typename PrimType_>
+class RotationAdapter<Eigen::Matrix<PrimType_, 3, 3>> {
+ public:
+  typedef RotationMatrix<PrimType_> KindrRotation;
+  inline static void toKindr(KindrRotation& rotation, const Eigen::Matrix<PrimType_, 3, 3>& external) {
+    rotation.toImplementation() = external;
+  }
+  inline static void fromKindr(Eigen::Matrix<PrimType_, 3, 3>& external, const KindrRotation& rotation) {
+    external = rotation.toImplementation();
+  }
+};
+
+//! Eigen angle-axis, the implementation of AngleAxis
+template<typename PrimType_>
+class RotationAdapter<Eigen::AngleAxis<PrimType_>> {
+ public:
+  typedef AngleAxis<PrimType_> KindrRotation;
+  inline static void toKindr(KindrRotation& rotation, const Eigen::AngleAxis<PrimType_>& external) {
+    rotation.toImplementation() = external;
+  }
+  inline static void fromKindr(Eigen::AngleAxis<PrimType_>& external, const KindrRotation& rotation) {
+    external = rotation.toImplementation();
+  }
+};
+
 } // namespace
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <geometry_msgs/Quaternion.h>
+#include <tf2/LinearMath/Matrix3x3.h>
+#include <tf2/LinearMath/Quaternion.h>
+
+#include "kindr/rotations/RotationConversion.hpp"
+
+/* Adapters between kindr rotations and the rotation types of ROS (geometry_msgs) and tf2.
+ * All of them use the Hamilton convention of kindr, the coefficients are copied directly.
+ * This header is not part of kindr/Core since it requires the ROS packages geometry_msgs and tf2.
+ */
+
+namespace kindr {
+
+//! geometry_msgs/Quaternion
+template<>
+class RotationAdapter<geometry_msgs::Quaternion> {
+ public:
+  typedef RotationQuaternion<double> KindrRotation;
+  inline static void toKindr(KindrRotation& rotation, const geometry_msgs::Quaternion& external) {
+    rotation.toImplementation().coeffs() << external.x, external.y, external.z, external.w;
+  }
+  inline static void fromKindr(geometry_msgs::Quaternion& external, const KindrRotation& rotation) {
+    external.x = rotation.x();
+    external.y = rotation.y();
+    external.z = rotation.z();
+    external.w = rotation.w();
+  }
+};
+
+//! tf2::Quaternion
+template<>
+class RotationAdapter<tf2::Quaternion> {
+ public:
+  typedef RotationQuaternion<tf2Scalar> KindrRotation;
+  inline static void toKindr(KindrRotation& rotation, const tf2::Quaternion& external) {
+    rotation.toImplementation().coeffs() << external.x(), external.y(), external.z(), external.w();
+  }
+  inline static void fromKindr(tf2::Quaternion& external, const KindrRotation& rotation) {
+    external.setValue(rotation.x(), rotation.y(), rotation.z(), rotation.w());
+  }
+};
+
+//! tf2::Matrix3x3
+template<>
+class RotationAdapter<tf2::Matrix3x3> {
+ public:
+  typedef RotationMatrix<tf2Scalar> KindrRotation;
+  inline static void toKindr(KindrRotation& rotation, const tf2::Matrix3x3& external) {
+    rotation.toImplementation() << external[0][0], external[0][1], external[0][2],
+                                   external[1][0], external[1][1], external[1][2],
+                                   external[2][0], external[2][1], external[2][2];
+  }
+  inline static void fromKindr(tf2::Matrix3x3& external, const KindrRotation& rotation) {
+    const Eigen::Matrix<tf2Scalar, 3, 3>& matrix = rotation.toImplementation();
+    external.setValue(matrix(0,0), matrix(0,1), matrix(0,2),
+                      matrix(1,0), matrix(1,1), matrix(1,2),
+                      matrix(2,0), matrix(2,1), matrix(2,2));
+  }
+};
+
+} // namespace kindr
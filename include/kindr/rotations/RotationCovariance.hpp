@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/RotationJacobians.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationBatchConversion.hpp"
+
+namespace kindr {
+
+/* Propagation of covariances through rotations.
+ * The uncertainty of a rotation C is a perturbation dv ~ N(0, P) in the convention of RotationBase::boxPlus, i.e. the
+ * true rotation is exp(dv)*C with dv expressed in the frame C maps to. The covariances are propagated to first order
+ * with the analytic Jacobians, and the uncertainties of different arguments are assumed to be uncorrelated. The upper
+ * triangles of the results are mirrored, such that the results are exactly symmetric.
+ *
+ * The batched functions store symmetric 3x3 covariances in packed form, one per column of a row-major 6xN matrix with
+ * the upper triangle [xx; xy; xz; yy; yz; zz], see packCovariance(). Only the 6 independent elements are propagated,
+ * i.e. a 6x6 instead of a 9x9 map per covariance.
+ */
+
+namespace internal {
+
+//! Number of covariances below which a batch is not split
+enum { CovarianceBatchGrainSize = 2048 };
+
+//! Row-major 6xN matrix of packed symmetric 3x3 matrices
+template<typename PrimType_>
+using PackedCovarianceMatrix = Eigen::Matrix<PrimType_, 6, Eigen::Dynamic, Eigen::RowMajor>;
+
+/*! \brief Gets the symmetric product A*P*A^T of a matrix A and a symmetric matrix P.
+ *  The product is evaluated with fixed-size kernels and its upper triangle is mirrored, such that the result is
+ *  exactly symmetric.
+ */
+template<typename PrimType_, int Rows_, int Cols_>
+inline Eigen::Matrix<PrimType_, Rows_, Rows_> getSymmetricProduct(const Eigen::Matrix<PrimType_, Rows_, Cols_>& a,
+                                                                   const Eigen::Matrix<PrimType_, Cols_, Cols_>& p) {
+  const Eigen::Matrix<PrimType_, Cols_, Rows_> pa = p*a.transpose();
+  Eigen::Matrix<PrimType_, Rows_, Rows_> product;
+  product.noalias() = a*pa;
+  product.template triangularView<Eigen::StrictlyLower>() = product.transpose();
+  return product;
+}
+
+/*! \brief Gets the 6x6 matrix which maps a packed symmetric matrix P to the packed A*P*A^T.
+ *  The off-diagonal elements of P appear twice in the product, their coefficients are summed.
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 6, 6> getPackedSandwichMatrix(const Eigen::Matrix<PrimType_, 3, 3>& a) {
+  static const int rows[6] = {0, 0, 0, 1, 1, 2};
+  static const int cols[6] = {0, 1, 2, 1, 2, 2};
+  Eigen::Matrix<PrimType_, 6, 6> matrix;
+  for (int m = 0; m < 6; ++m) {
+    const int i = rows[m], j = cols[m];
+    for (int n = 0; n < 6; ++n) {
+      const int k = rows[n], l = cols[n];
+      matrix(m, n) = (k == l) ? a(i, k)*a(j, k) : a(i, k)*a(j, l) + a(i, l)*a(j, k);
+    }
+  }
+  return matrix;
+}
+
+/*! \brief Gets the 6x6 matrix which maps the monomials packed(y*y^T) of a vector y to the packed [y]x*P*[y]x^T of a
+ *  symmetric matrix P.
+ *  With [y]x = sum_k y_k*[e_k]x, the coefficient of y_k*y_l is [e_k]x*P*[e_l]x^T + [e_l]x*P*[e_k]x^T for k < l.
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 6, 6> getPackedSkewSandwichMatrix(const Eigen::Matrix<PrimType_, 3, 3>& p) {
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  static const int rows[6] = {0, 0, 0, 1, 1, 2};
+  static const int cols[6] = {0, 1, 2, 1, 2, 2};
+  Matrix3 skewMatrices[3];
+  for (int k = 0; k < 3; ++k) {
+    skewMatrices[k] = getSkewMatrixFromVector(Eigen::Matrix<PrimType_, 3, 1>(Eigen::Matrix<PrimType_, 3, 1>::Unit(k)));
+  }
+  Eigen::Matrix<PrimType_, 6, 6> matrix;
+  for (int n = 0; n < 6; ++n) {
+    const int k = rows[n], l = cols[n];
+    Matrix3 coefficient = skewMatrices[k]*p*skewMatrices[l].transpose();
+    if (k != l) {
+      coefficient += coefficient.transpose().eval();
+    }
+    for (int m = 0; m < 6; ++m) {
+      matrix(m, n) = coefficient(rows[m], cols[m]);
+    }
+  }
+  return matrix;
+}
+
+/*! \brief Sets the monomials packed(y*y^T) of the columns [0,length) of a block of vectors.
+ */
+template<typename Vectors_, typename Monomials_>
+inline void setPackedMonomials(const Vectors_& vectors, Monomials_& monomials, int length) {
+  const auto y0 = vectors.row(0).head(length).array();
+  const auto y1 = vectors.row(1).head(length).array();
+  const auto y2 = vectors.row(2).head(length).array();
+  monomials.row(0).head(length).array() = y0*y0;
+  monomials.row(1).head(length).array() = y0*y1;
+  monomials.row(2).head(length).array() = y0*y2;
+  monomials.row(3).head(length).array() = y1*y1;
+  monomials.row(4).head(length).array() = y1*y2;
+  monomials.row(5).head(length).array() = y2*y2;
+}
+
+} // namespace internal
+
+/*! \brief Gets the packed form [xx; xy; xz; yy; yz; zz] of a symmetric 3x3 matrix.
+ *  \param covariance   symmetric matrix, only the upper triangle is read
+ *  \returns packed matrix
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 6, 1> packCovariance(const Eigen::Matrix<PrimType_, 3, 3>& covariance) {
+  Eigen::Matrix<PrimType_, 6, 1> packed;
+  packed << covariance(0, 0), covariance(0, 1), covariance(0, 2), covariance(1, 1), covariance(1, 2), covariance(2, 2);
+  return packed;
+}
+
+/*! \brief Gets the symmetric 3x3 matrix from its packed form, see packCovariance().
+ *  \param packed   packed matrix
+ *  \returns symmetric matrix
+ */
+template<typename Derived_>
+inline Eigen::Matrix<typename Derived_::Scalar, 3, 3> unpackCovariance(const Eigen::MatrixBase<Derived_>& packed) {
+  Eigen::Matrix<typename Derived_::Scalar, 3, 3> covariance;
+  covariance << packed(0), packed(1), packed(2),
+                packed(1), packed(3), packed(4),
+                packed(2), packed(4), packed(5);
+  return covariance;
+}
+
+/*! \brief Gets the covariance C*P*C^T of a vector or a perturbation after it has been rotated by C, e.g. to express
+ *  the covariance of a measurement in the frame B in the frame I.
+ *  \param rotation     rotation C
+ *  \param covariance   symmetric 3x3 covariance P
+ *  \returns rotated covariance
+ */
+template<typename Rotation_>
+inline Eigen::Matrix<typename Rotation_::Scalar, 3, 3> getRotatedCovariance(const RotationBase<Rotation_>& rotation,
+                                                                              const Eigen::Matrix<typename Rotation_::Scalar, 3, 3>& covariance) {
+  typedef typename Rotation_::Scalar Scalar;
+  return internal::getSymmetricProduct<Scalar, 3, 3>(RotationMatrix<Scalar>(rotation.derived()).toImplementation(), covariance);
+}
+
+/*! \brief Gets the covariance of the inverse of an uncertain rotation.
+ *  (exp(dv)*C)^-1 = exp(-C^T*dv)*C^-1, hence the covariance is C^T*P*C.
+ *  \param rotation     rotation C
+ *  \param covariance   covariance P of the perturbation of C
+ *  \returns covariance of the perturbation of C^-1
+ */
+template<typename Rotation_>
+inline Eigen::Matrix<typename Rotation_::Scalar, 3, 3> getInvertedCovariance(const RotationBase<Rotation_>& rotation,
+                                                                               const Eigen::Matrix<typename Rotation_::Scalar, 3, 3>& covariance) {
+  typedef typename Rotation_::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 3> transposed = RotationMatrix<Scalar>(rotation.derived()).toImplementation().transpose();
+  return internal::getSymmetricProduct<Scalar, 3, 3>(transposed, covariance);
+}
+
+/*! \brief Gets the covariance of the concatenation C1*C2 of two uncertain rotations.
+ *  exp(dv1)*C1*exp(dv2)*C2 = exp(dv1 + C1*dv2)*C1*C2 to first order, hence the covariance is P1 + C1*P2*C1^T.
+ *  \param rotation1      rotation C1
+ *  \param covariance1    covariance P1 of the perturbation of C1
+ *  \param covariance2    covariance P2 of the perturbation of C2
+ *  \returns covariance of the perturbation of C1*C2
+ */
+template<typename Rotation_>
+inline Eigen::Matrix<typename Rotation_::Scalar, 3, 3> getComposedCovariance(const RotationBase<Rotation_>& rotation1,
+                                                                               const Eigen::Matrix<typename Rotation_::Scalar, 3, 3>& covariance1,
+                                                                               const Eigen::Matrix<typename Rotation_::Scalar, 3, 3>& covariance2) {
+  return covariance1 + getRotatedCovariance(rotation1, covariance2);
+}
+
+/*! \brief Gets the covariance of the box plus C.boxPlus(v) = exp(v)*C of an uncertain rotation and an uncertain vector.
+ *  exp(v + dw)*exp(dv)*C = exp(J(v)*dw + exp(v)*dv)*exp(v)*C to first order with the Jacobian J(v) of the
+ *  exponential map, hence the covariance is exp(v)*P*exp(v)^T + J(v)*Pv*J(v)^T.
+ *  \param covariance         covariance P of the perturbation of C
+ *  \param vector             rotation vector v
+ *  \param vectorCovariance   covariance Pv of v
+ *  \returns covariance of the perturbation of exp(v)*C
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 3, 3> getBoxPlusCovariance(const Eigen::Matrix<PrimType_, 3, 3>& covariance,
+                                                            const Eigen::Matrix<PrimType_, 3, 1>& vector,
+                                                            const Eigen::Matrix<PrimType_, 3, 3>& vectorCovariance) {
+  const Eigen::Matrix<PrimType_, 3, 3> rotationMatrix = RotationMatrix<PrimType_>().exponentialMap(vector).toImplementation();
+  return internal::getSymmetricProduct<PrimType_, 3, 3>(rotationMatrix, covariance)
+      + internal::getSymmetricProduct<PrimType_, 3, 3>(getJacobianOfExponentialMap(vector), vectorCovariance);
+}
+
+/*! \brief Gets the covariance of a vector y = C*x rotated by an uncertain rotation.
+ *  exp(dv)*C*(x + dx) = y - [y]x*dv + C*dx to first order, hence the covariance is [y]x*P*[y]x^T + C*Px*C^T.
+ *  \param rotation           rotation C
+ *  \param covariance         covariance P of the perturbation of C
+ *  \param vector             vector x
+ *  \param vectorCovariance   covariance Px of x
+ *  \returns covariance of C*x
+ */
+template<typename Rotation_>
+inline Eigen::Matrix<typename Rotation_::Scalar, 3, 3> getRotatedVectorCovariance(const RotationBase<Rotation_>& rotation,
+                                                                                    const Eigen::Matrix<typename Rotation_::Scalar, 3, 3>& covariance,
+                                                                                    const Eigen::Matrix<typename Rotation_::Scalar, 3, 1>& vector,
+                                                                                    const Eigen::Matrix<typename Rotation_::Scalar, 3, 3>& vectorCovariance) {
+  typedef typename Rotation_::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 3> rotationMatrix = RotationMatrix<Scalar>(rotation.derived()).toImplementation();
+  const Eigen::Matrix<Scalar, 3, 1> rotated = rotationMatrix*vector;
+  return internal::getSymmetricProduct<Scalar, 3, 3>(getSkewMatrixFromVector(rotated), covariance)
+      + internal::getSymmetricProduct<Scalar, 3, 3>(rotationMatrix, vectorCovariance);
+}
+
+/*! \brief Rotates many packed covariances, i.e. computes C*P_i*C^T for all columns.
+ *
+ *  The packed covariances are mapped by a single 6x6 matrix, which uses the symmetry of P_i, see packCovariance().
+ *  \param rotation     rotation C
+ *  \param covariances  row-major 6xN matrix of packed covariances
+ *  \param rotated      row-major 6xN matrix, the rotated covariances are written here
+ *  \param executor     executor on which the covariances are split, see Executor.hpp
+ */
+template<typename Rotation_, typename Executor_ = SerialExecutor>
+void rotateCovariances(const RotationBase<Rotation_>& rotation,
+                       const Eigen::Ref<const internal::PackedCovarianceMatrix<typename Rotation_::Scalar>>& covariances,
+                       Eigen::Ref<internal::PackedCovarianceMatrix<typename Rotation_::Scalar>> rotated,
+                       const Executor_& executor = Executor_()) {
+  typedef typename Rotation_::Scalar Scalar;
+  KINDR_ASSERT_TRUE(std::runtime_error, rotated.cols() == covariances.cols(), "The number of rotated covariances must be equal to the number of covariances.");
+  const Eigen::Matrix<Scalar, 6, 6> sandwich = internal::getPackedSandwichMatrix<Scalar>(RotationMatrix<Scalar>(rotation.derived()).toImplementation());
+  executor.parallelFor(0, static_cast<int>(covariances.cols()), internal::CovarianceBatchGrainSize, [&](int begin, int end) {
+    rotated.middleCols(begin, end - begin).noalias() = sandwich*covariances.middleCols(begin, end - begin);
+  });
+}
+
+/*! \brief Rotates many uncertain vectors by an uncertain rotation, see getRotatedVectorCovariance().
+ *
+ *  Per vector, the packed covariance [y]x*P*[y]x^T + C*Px*C^T is the product of a 6x12 matrix, which depends only on
+ *  C and P, with the monomials packed(y*y^T) and the packed covariance Px.
+ *  \param rotation             rotation C
+ *  \param covariance           covariance P of the perturbation of C
+ *  \param vectors              row-major 3xN matrix of vectors x
+ *  \param vectorCovariances    row-major 6xN matrix of packed covariances of the vectors
+ *  \param rotatedVectors       row-major 3xN matrix, the rotated vectors C*x are written here
+ *  \param rotatedCovariances   row-major 6xN matrix, the packed covariances of the rotated vectors are written here
+ *  \param executor             executor on which the vectors are split, see Executor.hpp
+ */
+template<typename Rotation_, typename Executor_ = SerialExecutor>
+void rotateVectorsWithCovariance(const RotationBase<Rotation_>& rotation,
+                                 const Eigen::Matrix<typename Rotation_::Scalar, 3, 3>& covariance,
+                                 const Eigen::Ref<const Eigen::Matrix<typename Rotation_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>>& vectors,
+                                 const Eigen::Ref<const internal::PackedCovarianceMatrix<typename Rotation_::Scalar>>& vectorCovariances,
+                                 Eigen::Ref<Eigen::Matrix<typename Rotation_::Scalar, 3, Eigen::Dynamic, Eigen::RowMajor>> rotatedVectors,
+                                 Eigen::Ref<internal::PackedCovarianceMatrix<typename Rotation_::Scalar>> rotatedCovariances,
+                                 const Executor_& executor = Executor_()) {
+  typedef typename Rotation_::Scalar Scalar;
+  enum { BlockSize = internal::BatchConversionBlockSize };
+  KINDR_ASSERT_TRUE(std::runtime_error, vectorCovariances.cols() == vectors.cols(), "The number of covariances must be equal to the number of vectors.");
+  KINDR_ASSERT_TRUE(std::runtime_error, rotatedVectors.cols() == vectors.cols() && rotatedCovariances.cols() == vectors.cols(),
+                    "The number of rotated vectors and covariances must be equal to the number of vectors.");
+  const Eigen::Matrix<Scalar, 3, 3> rotationMatrix = RotationMatrix<Scalar>(rotation.derived()).toImplementation();
+  Eigen::Matrix<Scalar, 6, 12> coefficients;
+  coefficients << internal::getPackedSkewSandwichMatrix<Scalar>(covariance), internal::getPackedSandwichMatrix<Scalar>(rotationMatrix);
+  executor.parallelFor(0, static_cast<int>(vectors.cols()), internal::CovarianceBatchGrainSize, [&](int begin, int end) {
+    Eigen::Matrix<Scalar, 12, Eigen::Dynamic, Eigen::RowMajor, 12, BlockSize> terms;
+    for (int start = begin; start < end; start += BlockSize) {
+      const int length = std::min<int>(BlockSize, end - start);
+      terms.resize(12, length);
+      rotatedVectors.middleCols(start, length).noalias() = rotationMatrix*vectors.middleCols(start, length);
+      auto monomials = terms.template topRows<6>();
+      internal::setPackedMonomials(rotatedVectors.middleCols(start, length), monomials, length);
+      terms.template bottomRows<6>() = vectorCovariances.middleCols(start, length);
+      rotatedCovariances.middleCols(start, length).noalias() = coefficients*terms;
+    }
+  });
+}
+
+} // namespace kindr
@@ -30,6 +30,7 @@
 
 #include "kindr/math/LinearAlgebra.hpp"
 #include "kindr/rotations/RotationBase.hpp"
+#include "kindr/rotations/RotationJacobians.hpp"
 
 namespace kindr {
 
@@ -53,22 +54,6 @@ template<typename PrimType_>
 class EulerAnglesXyzDiff;
 
 
-/*!
- * \brief Gets the 3x3 Jacobian of the exponential map.
- * \param   vector 3x1-matrix
- * \return  matrix  (3x3-matrix)
- */
-template<typename PrimType_>
-inline static Eigen::Matrix<PrimType_, 3, 3> getJacobianOfExponentialMap(const Eigen::Matrix<PrimType_, 3, 1>& vector) {
-  const PrimType_ norm = vector.norm();
-  const Eigen::Matrix<PrimType_, 3, 3> skewMatrix = getSkewMatrixFromVector(vector);
-  if (norm < 1.0e-4) {
-    return Eigen::Matrix<PrimType_, 3, 3>::Identity() + 0.5*skewMatrix;
-  }
-  return Eigen::Matrix<PrimType_, 3, 3>::Identity() + (PrimType_(1.0) - cos(norm))/(norm*norm)*skewMatrix + (norm - sin(norm))/(norm*norm*norm)*(skewMatrix*skewMatrix);
-}
-
-
 } // namespace kindr
 
 
@@ -78,5 +63,7 @@ inline static Eigen::Matrix<PrimType_, 3, 3> getJacobianOfExponentialMap(const E
 #include "kindr/rotations/RotationMatrixDiff.hpp"
 #include "kindr/rotations/EulerAnglesZyxDiff.hpp"
 #include "kindr/rotations/EulerAnglesXyzDiff.hpp"
+#include "kindr/rotations/EulerAnglesZyxDDiff.hpp"
+#include "kindr/rotations/EulerAnglesXyzDDiff.hpp"
 
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+/* Declares the rotations and their time derivatives together with the typedefs for double and float without including
+ * Eigen and the implementations, such that headers which only refer to these types do not need kindr/Core.
+ */
+
+namespace kindr {
+
+template<typename PrimType_>
+class AngleAxis;
+
+template<typename PrimType_>
+class RotationVector;
+
+template<typename PrimType_>
+class RotationQuaternion;
+
+template<typename PrimType_>
+class RotationMatrix;
+
+template<typename PrimType_>
+class EulerAnglesZyx;
+
+template<typename PrimType_>
+class EulerAnglesXyz;
+
+template<typename Rotation_>
+class PreparedRotation;
+
+template<typename... Rotations_>
+class RotationComposition;
+
+template<typename PrimType_>
+class LocalAngularVelocity;
+
+template<typename PrimType_>
+class GlobalAngularVelocity;
+
+template<typename PrimType_>
+class RotationQuaternionDiff;
+
+template<typename PrimType_>
+class RotationMatrixDiff;
+
+template<typename PrimType_>
+class EulerAnglesZyxDiff;
+
+template<typename PrimType_>
+class EulerAnglesXyzDiff;
+
+//! \brief Angle-axis with primitive type double
+typedef AngleAxis<double> AngleAxisD;
+//! \brief Angle-axis with primitive type float
+typedef AngleAxis<float> AngleAxisF;
+//! \brief Rotation vector with primitive type double
+typedef RotationVector<double> RotationVectorD;
+//! \brief Rotation vector with primitive type float
+typedef RotationVector<float> RotationVectorF;
+//! \brief Rotation quaternion with primitive type double
+typedef RotationQuaternion<double> RotationQuaternionD;
+//! \brief Rotation quaternion with primitive type float
+typedef RotationQuaternion<float> RotationQuaternionF;
+//! \brief Rotation matrix with primitive type double
+typedef RotationMatrix<double> RotationMatrixD;
+//! \brief Rotation matrix with primitive type float
+typedef RotationMatrix<float> RotationMatrixF;
+//! \brief Euler angles with z-y-x convention and primitive type double
+typedef EulerAnglesZyx<double> EulerAnglesZyxD;
+//! \brief Euler angles with z-y-x convention and primitive type float
+typedef EulerAnglesZyx<float> EulerAnglesZyxF;
+//! \brief Euler angles with x-y-z convention and primitive type double
+typedef EulerAnglesXyz<double> EulerAnglesXyzD;
+//! \brief Euler angles with x-y-z convention and primitive type float
+typedef EulerAnglesXyz<float> EulerAnglesXyzF;
+
+//! \brief Local angular velocity with primitive type double
+typedef LocalAngularVelocity<double> LocalAngularVelocityD;
+//! \brief Local angular velocity with primitive type float
+typedef LocalAngularVelocity<float> LocalAngularVelocityF;
+//! \brief Global angular velocity with primitive type double
+typedef GlobalAngularVelocity<double> GlobalAngularVelocityD;
+//! \brief Global angular velocity with primitive type float
+typedef GlobalAngularVelocity<float> GlobalAngularVelocityF;
+//! \brief Time derivative of a rotation quaternion with primitive type double
+typedef RotationQuaternionDiff<double> RotationQuaternionDiffD;
+//! \brief Time derivative of a rotation quaternion with primitive type float
+typedef RotationQuaternionDiff<float> RotationQuaternionDiffF;
+//! \brief Time derivative of a rotation matrix with primitive type double
+typedef RotationMatrixDiff<double> RotationMatrixDiffD;
+//! \brief Time derivative of a rotation matrix with primitive type float
+typedef RotationMatrixDiff<float> RotationMatrixDiffF;
+//! \brief Time derivative of Euler angles with z-y-x convention and primitive type double
+typedef EulerAnglesZyxDiff<double> EulerAnglesZyxDiffD;
+//! \brief Time derivative of Euler angles with z-y-x convention and primitive type float
+typedef EulerAnglesZyxDiff<float> EulerAnglesZyxDiffF;
+//! \brief Time derivative of Euler angles with x-y-z convention and primitive type double
+typedef EulerAnglesXyzDiff<double> EulerAnglesXyzDiffD;
+//! \brief Time derivative of Euler angles with x-y-z convention and primitive type float
+typedef EulerAnglesXyzDiff<float> EulerAnglesXyzDiffF;
+
+} // namespace kindr
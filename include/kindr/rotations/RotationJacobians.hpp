@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+
+namespace kindr {
+
+/* Jacobians of the exponential and logarithmic map of SO(3).
+ * The Jacobians follow the perturbation convention of RotationBase::boxPlus, i.e. a rotation C is perturbed by exp(dv)*C.
+ * With this convention the (left) Jacobian J(v) of the exponential map satisfies exp(v + dv) = exp(J(v)*dv)*exp(v)
+ * and the right Jacobian Jr(v) = J(-v) satisfies exp(v + dv) = exp(v)*exp(Jr(v)*dv).
+ */
+
+/*!
+ * \brief Gets the 3x3 Jacobian of the exponential map.
+ *  J(v) = I + (1-cos(a))/a^2*[v]x + (a-sin(a))/a^3*[v]x^2 with a = |v|
+ * \param   vector 3x1-matrix
+ * \return  matrix  (3x3-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 3> getJacobianOfExponentialMap(const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  using std::sin;
+  using std::cos;
+  const PrimType_ norm = vector.norm();
+  const Eigen::Matrix<PrimType_, 3, 3> skewMatrix = getSkewMatrixFromVector(vector);
+  if (norm < PrimType_(1.0e-4)) {
+    return Eigen::Matrix<PrimType_, 3, 3>::Identity() + PrimType_(0.5)*skewMatrix;
+  }
+  return Eigen::Matrix<PrimType_, 3, 3>::Identity() + (PrimType_(1.0) - cos(norm))/(norm*norm)*skewMatrix + (norm - sin(norm))/(norm*norm*norm)*(skewMatrix*skewMatrix);
+}
+
+/*!
+ * \brief Gets the 3x3 right Jacobian of the exponential map.
+ *  Jr(v) = J(-v)
+ * \param   vector 3x1-matrix
+ * \return  matrix  (3x3-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 3> getRightJacobianOfExponentialMap(const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  return getJacobianOfExponentialMap<PrimType_>(-vector);
+}
+
+/*!
+ * \brief Gets the 3x3 Jacobian of the logarithmic map, i.e. the inverse of the Jacobian of the exponential map.
+ *  log(exp(dv)*exp(v)) = v + J^-1(v)*dv with J^-1(v) = I - 1/2*[v]x + (1/a^2 - (1+cos(a))/(2*a*sin(a)))*[v]x^2 and a = |v|
+ * \param   vector 3x1-matrix, the logarithmic map of the rotation (norm in [0,pi))
+ * \return  matrix  (3x3-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 3> getJacobianOfLogarithmicMap(const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  using std::cos;
+  using std::sin;
+  const PrimType_ norm = vector.norm();
+  const Eigen::Matrix<PrimType_, 3, 3> skewMatrix = getSkewMatrixFromVector(vector);
+  PrimType_ factor;
+  if (internal::isLessThenEpsilons4thRoot(norm)) {
+    factor = PrimType_(1.0/12.0) + vector.squaredNorm()*PrimType_(1.0/720.0);
+  }
+  else {
+    factor = PrimType_(1.0)/(norm*norm) - (PrimType_(1.0) + cos(norm))/(PrimType_(2.0)*norm*sin(norm));
+  }
+  return Eigen::Matrix<PrimType_, 3, 3>::Identity() - PrimType_(0.5)*skewMatrix + factor*(skewMatrix*skewMatrix);
+}
+
+/*!
+ * \brief Gets the 3x3 right Jacobian of the logarithmic map, i.e. the inverse of the right Jacobian of the exponential map.
+ *  log(exp(v)*exp(dv)) = v + Jr^-1(v)*dv with Jr^-1(v) = J^-1(-v)
+ * \param   vector 3x1-matrix, the logarithmic map of the rotation (norm in [0,pi))
+ * \return  matrix  (3x3-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 3> getRightJacobianOfLogarithmicMap(const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  return getJacobianOfLogarithmicMap<PrimType_>(-vector);
+}
+
+} // namespace kindr
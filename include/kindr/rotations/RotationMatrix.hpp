@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include <Eigen/Geometry>
 
@@ -57,6 +59,8 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    */
   typedef Eigen::Matrix<PrimType_, 3, 3> Base;
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   /*! \brief The implementation type.
    *  The implementation type is always an Eigen object.
    */
@@ -68,7 +72,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
 
   /*! \brief Default constructor using identity rotation.
    */
-  RotationMatrix()
+  KINDR_DEVICE_FUNC RotationMatrix()
     : Base(Base::Identity()) {
   }
 
@@ -98,7 +102,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    *  In debug mode, an assertion is thrown if the rotation vector has not unit length.
    *  \param other   Eigen::Matrix<PrimType_,3,3>
    */
-  explicit RotationMatrix(const Base& other)
+  KINDR_DEVICE_FUNC explicit RotationMatrix(const Base& other)
   // : Base(other)
   {
 
@@ -115,7 +119,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
   inline explicit RotationMatrix(const RotationBase<OtherDerived_>& other)
   // : Base(internal::ConversionTraits<RotationMatrix, OtherDerived_>::convert(other.derived()).toImplementation())
   {
-    this->toImplementation() = internal::ConversionTraits<RotationMatrix, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<RotationMatrix, OtherDerived_>(other.derived()).toImplementation();
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -124,7 +128,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    */
   template<typename OtherDerived_>
   RotationMatrix& operator =(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<RotationMatrix, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<RotationMatrix, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -134,7 +138,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    */
   template<typename OtherDerived_>
   RotationMatrix& operator ()(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<RotationMatrix, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<RotationMatrix, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -151,7 +155,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    *  \returns reference
    */
   RotationMatrix& invert() {
-    *this = this->inverted();
+    this->toImplementation().transposeInPlace();
     return *this;
   }
 
@@ -182,21 +186,21 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
   /*! \brief Cast to the implementation type.
    *  \returns the implementation for direct manipulation (recommended only for advanced users)
    */
-  inline Implementation& toImplementation() {
+  KINDR_DEVICE_FUNC inline Implementation& toImplementation() {
     return static_cast<Implementation&>(*this);
   }
 
   /*! \brief Cast to the implementation type.
    *  \returns the implementation for direct manipulation (recommended only for advanced users)
    */
-  inline const Implementation& toImplementation() const {
+  KINDR_DEVICE_FUNC inline const Implementation& toImplementation() const {
     return static_cast<const Implementation&>(*this);
   }
 
   /*! \brief Reading access to the rotation matrix.
    *  \returns rotation matrix (matrix) with reading access
    */
-  inline Implementation matrix() const {
+  KINDR_DEVICE_FUNC inline Implementation matrix() const {
       return this->toImplementation();
   }
 
@@ -230,6 +234,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    *  \returns copy of the matrix rotation which is unique
    */
   RotationMatrix getUnique() const {
+    KINDR_INSTRUMENT(Unique);
     return *this;
   }
 
@@ -247,6 +252,12 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    */
   using RotationBase<RotationMatrix<PrimType_>>::operator*; // otherwise ambiguous RotationBase and Eigen
 
+  /*! \brief In-place concatenation operator.
+   *  This is explicitly specified, because Eigen::Matrix provides also an operator*=.
+   *  \returns reference
+   */
+  using RotationBase<RotationMatrix<PrimType_>>::operator*=; // otherwise ambiguous RotationBase and Eigen
+
   /*! \brief Equivalence operator.
    *  This is explicitly specified, because Eigen::Matrix provides also an operator==.
    *  \returns true if two rotations are similar.
@@ -367,10 +378,79 @@ class MultiplicationTraits<RotationBase<RotationMatrix<PrimType_>>, RotationBase
 };
 
 
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Map Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class MapTraits<RotationBase<RotationMatrix<PrimType_>>> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+
+  /*! \brief Gets the rotation matrix from a rotation vector without the rotation vector detour.
+   *  The half-angle quaternion and its conversion to a matrix are cheaper than the Rodrigues formula R = I + sin(a)/a*[v]x + (1-cos(a))/a^2*[v]x^2.
+   */
+  KINDR_DEVICE_FUNC inline static RotationMatrix<PrimType_> set_exponential_map(const Vector3& vector) {
+    RotationMatrix<PrimType_> matrix;
+    matrix.toImplementation() = MapTraits<RotationBase<RotationQuaternion<PrimType_>>>::set_exponential_map(vector).toImplementation().toRotationMatrix();
+    return matrix;
+  }
+
+  /*! \brief Gets the unique rotation vector (norm in [0,pi]) of the rotation matrix.
+   *  For angles below pi/2, the rotation vector is computed from the skew-symmetric part s = sin(a)*n of the matrix,
+   *  v = a/sin(a)*s with a = atan2(|s|, (trace-1)/2). Otherwise, the well-conditioned conversion to a quaternion is used.
+   */
+  inline static Vector3 get_logarithmic_map(const RotationMatrix<PrimType_>& rotation) {
+    using std::atan2;
+    const Matrix3& R = rotation.toImplementation();
+    const PrimType_ cosAngle = PrimType_(0.5)*(R.trace() - PrimType_(1));
+    if (cosAngle <= PrimType_(0)) {
+      return MapTraits<RotationBase<RotationQuaternion<PrimType_>>>::get_logarithmic_map(RotationQuaternion<PrimType_>(rotation));
+    }
+    const Vector3 skew(PrimType_(0.5)*(R(2,1) - R(1,2)), PrimType_(0.5)*(R(0,2) - R(2,0)), PrimType_(0.5)*(R(1,0) - R(0,1)));
+    const PrimType_ sinAngle = skew.norm();
+    PrimType_ factor;
+    if (isLessThenEpsilons4thRoot(sinAngle)) {
+      // a/sin(a) = 1 + sin(a)^2/6 + O(sin(a)^4)
+      factor = PrimType_(1) + skew.squaredNorm()/PrimType_(6);
+    }
+    else {
+      factor = atan2(sinAngle, cosAngle)/sinAngle;
+    }
+    return factor*skew;
+  }
+};
+
+
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Rotation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class RotationTraits<RotationBase<RotationMatrix<PrimType_>>> {
+ public:
+  //! Multiplies the stored matrix with the vectors without copying the rotation
+  template<typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols> rotate(const RotationBase<RotationMatrix<PrimType_>>& rotation, const typename internal::get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& m){
+    return rotation.derived().toImplementation()*m;
+  }
+
+  template<typename Vector_>
+  inline static Vector_ rotate(const RotationBase<RotationMatrix<PrimType_>>& rotation, const Vector_& vector){
+    return static_cast<Vector_>(rotation.derived().rotate(vector.toImplementation()));
+  }
+
+  //! Multiplies the transpose of the stored matrix with the vectors without materializing the inverse
+  template<typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols> inverseRotate(const RotationBase<RotationMatrix<PrimType_>>& rotation, const typename internal::get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& m){
+    return rotation.derived().toImplementation().transpose()*m;
+  }
+
+  template<typename Vector_>
+  inline static Vector_ inverseRotate(const RotationBase<RotationMatrix<PrimType_>>& rotation, const Vector_& vector){
+    return static_cast<Vector_>(rotation.derived().inverseRotate(vector.toImplementation()));
+  }
+};
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Comparison Traits
@@ -382,6 +462,55 @@ class MultiplicationTraits<RotationBase<RotationMatrix<PrimType_>>, RotationBase
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
 
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Disparity Angle Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class DisparityAngleTraits<RotationBase<RotationMatrix<PrimType_>>, RotationBase<RotationMatrix<PrimType_>>> {
+ public:
+  /*! \brief Gets the disparity angle directly from the matrix coefficients.
+   *  The squared Frobenius distance of the matrices is 8*sin^2(angle/2) = 4*(1-cos(angle)), which avoids both the
+   *  matrix product and the inaccurate acos of the trace formula for small angles.
+   *  \returns disparity angle in [0,pi]
+   */
+  inline static PrimType_ compute(const RotationBase<RotationMatrix<PrimType_>>& left, const RotationBase<RotationMatrix<PrimType_>>& right) {
+    using std::atan2;
+    using std::sqrt;
+    const PrimType_ sinHalfAngleSquared = std::min(PrimType_(0.125)*(left.derived().toImplementation() - right.derived().toImplementation()).squaredNorm(), PrimType_(1));
+    return PrimType_(2)*atan2(sqrt(sinHalfAngleSquared), sqrt(PrimType_(1) - sinHalfAngleSquared));
+  }
+
+  /*! \brief Gets the bound 8*sin^2(tol/2) of the squared Frobenius distance for a tolerance, see isNearWithBound().
+   *  \returns bound, negative for a negative tolerance
+   */
+  inline static PrimType_ getNearnessBound(PrimType_ tol) {
+    if (tol < PrimType_(0)) {
+      return PrimType_(-1);
+    }
+    if (tol >= PrimType_(M_PI)) {
+      // the squared Frobenius distance of two rotation matrices is at most 8
+      return std::numeric_limits<PrimType_>::infinity();
+    }
+    using std::sin;
+    const PrimType_ sinHalfTol = sin(PrimType_(0.5)*tol);
+    return PrimType_(8)*sinHalfTol*sinHalfTol;
+  }
+
+  /*! \brief Compares the squared Frobenius distance with a bound of getNearnessBound() instead of computing the disparity angle.
+   *  \returns true if the rotations are equal within the tolerance of the bound
+   */
+  inline static bool isNearWithBound(const RotationBase<RotationMatrix<PrimType_>>& left, const RotationBase<RotationMatrix<PrimType_>>& right, PrimType_ bound) {
+    return (left.derived().toImplementation() - right.derived().toImplementation()).squaredNorm() <= bound;
+  }
+
+  /*! \brief Compares the squared Frobenius distance with 8*sin^2(tol/2) instead of computing the disparity angle.
+   *  \returns true if the rotations are equal within the tolerance
+   */
+  inline static bool isNear(const RotationBase<RotationMatrix<PrimType_>>& left, const RotationBase<RotationMatrix<PrimType_>>& right, PrimType_ tol) {
+    return isNearWithBound(left, right, getNearnessBound(tol));
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Fixing Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
@@ -55,6 +55,8 @@ class RotationMatrixDiff : public RotationDiffBase<RotationMatrixDiff<PrimType_>
   typedef Eigen::Matrix<PrimType_, 3, 3> Base;
 
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   /*! \brief The implementation type.
    *  The implementation type is always an Eigen object.
    */
@@ -178,7 +180,14 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<RotationMatrixDiff<PrimType_>, LocalAngularVelocity<PrimType_>, RotationMatrix<PrimType_>> {
  public:
   inline static RotationMatrixDiff<PrimType_> convert(const RotationMatrix<PrimType_>& rotationMatrix, const LocalAngularVelocity<PrimType_>& angularVelocity) {
-    return RotationMatrixDiff<PrimType_>(rotationMatrix.matrix()*getSkewMatrixFromVector(angularVelocity.vector()));
+    // R*[w]x column by column, i.e. R*(w x e_i), without the skew matrix product
+    const Eigen::Matrix<PrimType_, 3, 3>& matrix = rotationMatrix.toImplementation();
+    const Eigen::Matrix<PrimType_, 3, 1>& w = angularVelocity.vector();
+    Eigen::Matrix<PrimType_, 3, 3> matrixDiff;
+    matrixDiff.col(0) = w.z()*matrix.col(1) - w.y()*matrix.col(2);
+    matrixDiff.col(1) = w.x()*matrix.col(2) - w.z()*matrix.col(0);
+    matrixDiff.col(2) = w.y()*matrix.col(0) - w.x()*matrix.col(1);
+    return RotationMatrixDiff<PrimType_>(matrixDiff);
   }
 };
 
@@ -186,7 +195,14 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<RotationMatrixDiff<PrimType_>, GlobalAngularVelocity<PrimType_>, RotationMatrix<PrimType_>> {
  public:
   inline static RotationMatrixDiff<PrimType_> convert(const RotationMatrix<PrimType_>& rotationMatrix, const GlobalAngularVelocity<PrimType_>& angularVelocity) {
-    return RotationMatrixDiff<PrimType_>(getSkewMatrixFromVector(angularVelocity.vector())*rotationMatrix.matrix());
+    // [w]x*R column by column, i.e. w x R_i, without the skew matrix product
+    const Eigen::Matrix<PrimType_, 3, 3>& matrix = rotationMatrix.toImplementation();
+    const Eigen::Matrix<PrimType_, 3, 1>& w = angularVelocity.vector();
+    Eigen::Matrix<PrimType_, 3, 3> matrixDiff;
+    matrixDiff.col(0) = w.cross(matrix.col(0));
+    matrixDiff.col(1) = w.cross(matrix.col(1));
+    matrixDiff.col(2) = w.cross(matrix.col(2));
+    return RotationMatrixDiff<PrimType_>(matrixDiff);
   }
 };
 
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 #include <Eigen/Geometry>
@@ -62,6 +63,8 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    */
   Base rotationQuaternion_;
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   /*! \brief The implementation type.
    *  The implementation type is always an Eigen object.
    */
@@ -80,7 +83,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
 
   /*! \brief Default constructor using identity rotation.
    */
-  RotationQuaternion()
+  KINDR_DEVICE_FUNC RotationQuaternion()
     : rotationQuaternion_(Implementation::Identity()) {
   }
 
@@ -91,7 +94,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    *  \param y     third entry of the quaternion = n2*sin(phi/2)
    *  \param z     fourth entry of the quaternion = n3*sin(phi/2)
    */
-  RotationQuaternion(Scalar w, Scalar x, Scalar y, Scalar z)
+  KINDR_DEVICE_FUNC RotationQuaternion(Scalar w, Scalar x, Scalar y, Scalar z)
     : rotationQuaternion_(w,x,y,z) {
     KINDR_ASSERT_SCALAR_NEAR_DBG(std::runtime_error, rotationQuaternion_.norm(), static_cast<Scalar>(1), static_cast<Scalar>(1e-2), "Input quaternion has not unit length.");
   }
@@ -119,7 +122,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    *  In debug mode, an assertion is thrown if the quaternion has not unit length.
    *  \param other   Eigen::Quaternion<PrimType_>
    */
-  explicit RotationQuaternion(const Implementation& other)
+  KINDR_DEVICE_FUNC explicit RotationQuaternion(const Implementation& other)
     : rotationQuaternion_(other.w(), other.x(), other.y(), other.z()) {
     KINDR_ASSERT_SCALAR_NEAR_DBG(std::runtime_error, rotationQuaternion_.norm(), static_cast<Scalar>(1), static_cast<Scalar>(1e-2), "Input quaternion has not unit length.");
   }
@@ -138,38 +141,38 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    */
   template<typename OtherDerived_>
   inline explicit RotationQuaternion(const RotationBase<OtherDerived_>& other)
-    : rotationQuaternion_(internal::ConversionTraits<RotationQuaternion, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    : rotationQuaternion_(internal::convertRotation<RotationQuaternion, OtherDerived_>(other.derived()).toImplementation()) {
   }
 
-  inline Scalar w() const {
+  KINDR_DEVICE_FUNC inline Scalar w() const {
     return rotationQuaternion_.w();
   }
 
-  inline Scalar x() const {
+  KINDR_DEVICE_FUNC inline Scalar x() const {
     return rotationQuaternion_.x();
   }
 
-  inline Scalar y() const {
+  KINDR_DEVICE_FUNC inline Scalar y() const {
     return rotationQuaternion_.y();
   }
 
-  inline Scalar z() const {
+  KINDR_DEVICE_FUNC inline Scalar z() const {
     return rotationQuaternion_.z();
   }
 
-  inline Scalar& w() {
+  KINDR_DEVICE_FUNC inline Scalar& w() {
     return rotationQuaternion_.w();
   }
 
-  inline Scalar& x() {
+  KINDR_DEVICE_FUNC inline Scalar& x() {
     return rotationQuaternion_.x();
   }
 
-  inline Scalar& y() {
+  KINDR_DEVICE_FUNC inline Scalar& y() {
     return rotationQuaternion_.y();
   }
 
-  inline Scalar& z() {
+  KINDR_DEVICE_FUNC inline Scalar& z() {
     return rotationQuaternion_.z();
   }
 
@@ -204,22 +207,22 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
   /*! \brief Cast to the implementation type.
    *  \returns the implementation for direct manipulation (recommended only for advanced users)
    */
-  inline Implementation& toImplementation() {
+  KINDR_DEVICE_FUNC inline Implementation& toImplementation() {
     return toUnitQuaternion().toImplementation();
   }
 
   /*! \brief Cast to the implementation type.
    *  \returns the implementation for direct manipulation (recommended only for advanced users)
    */
-  inline const Implementation& toImplementation() const {
+  KINDR_DEVICE_FUNC inline const Implementation& toImplementation() const {
     return toUnitQuaternion().toImplementation();
   }
 
-  Base& toUnitQuaternion() {
+  KINDR_DEVICE_FUNC Base& toUnitQuaternion() {
      return static_cast<Base&>(rotationQuaternion_);
    }
 
-  const Base& toUnitQuaternion() const {
+  KINDR_DEVICE_FUNC const Base& toUnitQuaternion() const {
      return static_cast<const Base&>(rotationQuaternion_);
    }
 
@@ -239,7 +242,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    */
   template<typename OtherDerived_>
   RotationQuaternion& operator =(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<RotationQuaternion, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<RotationQuaternion, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -281,7 +284,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    */
   template<typename OtherDerived_>
   RotationQuaternion& operator ()(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<RotationQuaternion, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<RotationQuaternion, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -296,7 +299,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    *  \returns reference
    */
   RotationQuaternion& invert() {
-    *this = inverted();
+    this->toImplementation().vec() = -this->toImplementation().vec();
     return *this;
   }
 
@@ -315,6 +318,34 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
     return *this;
   }
 
+  /*! \brief Concatenates the inverse of this rotation with another rotation.
+   *  The inverse of a unit quaternion is its conjugate, which is folded into the product.
+   *  \returns this->inverted()*other
+   */
+  RotationQuaternion conjugateMultiply(const RotationQuaternion& other) const {
+    RotationQuaternion result;
+    result.toImplementation() = quat_internal::FusedMultiplicationTraits<Implementation>::conjugateMultiply(rotationQuaternion_.toImplementation(), other.rotationQuaternion_.toImplementation());
+    return result;
+  }
+
+  /*! \brief Concatenates this rotation with the inverse of another rotation.
+   *  The inverse of a unit quaternion is its conjugate, which is folded into the product.
+   *  \returns (*this)*other.inverted()
+   */
+  RotationQuaternion multiplyConjugate(const RotationQuaternion& other) const {
+    RotationQuaternion result;
+    result.toImplementation() = quat_internal::FusedMultiplicationTraits<Implementation>::multiplyConjugate(rotationQuaternion_.toImplementation(), other.rotationQuaternion_.toImplementation());
+    return result;
+  }
+
+  /*! \brief Computes the sandwich product q*p*q^-1 of a quaternion p with this rotation.
+   *  \returns the sandwiched quaternion, which has the type of p
+   */
+  template<typename OtherDerived_>
+  OtherDerived_ sandwich(const QuaternionBase<OtherDerived_>& other) const {
+    return rotationQuaternion_.sandwich(other);
+  }
+
   /*! \brief Sets the rotation to identity.
    *  \returns reference
    */
@@ -331,6 +362,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    *  \returns copy of the quaternion rotation which is unique
    */
   RotationQuaternion getUnique() const {
+    KINDR_INSTRUMENT(Unique);
     if(this->w() > 0) {
       return *this;
     } else if (this->w() < 0){
@@ -459,6 +491,73 @@ typedef RotationQuaternion<double> RotationQuaternionD;
 typedef RotationQuaternion<float> RotationQuaternionF;
 
 
+/*! \class RotationQuaternionAccumulator
+ *  \brief Concatenates a long chain of rotations in a wider primitive type.
+ *
+ *  Each factor is promoted to AccumulatorPrimType_ before it is multiplied onto the running product,
+ *  which is only rounded to PrimType_ when it is read. This keeps single-precision pipelines free of
+ *  the round-off drift that builds up when thousands of float quaternions are concatenated.
+ *
+ *  \tparam PrimType_ primitive type of the rotations that are concatenated and returned
+ *  \tparam AccumulatorPrimType_ primitive type of the running product
+ *  \ingroup rotations
+ */
+template<typename PrimType_, typename AccumulatorPrimType_ = double>
+class RotationQuaternionAccumulator {
+ public:
+  //! the rotation type that is concatenated and returned
+  typedef RotationQuaternion<PrimType_> Rotation;
+  //! the rotation type of the running product
+  typedef RotationQuaternion<AccumulatorPrimType_> AccumulatorRotation;
+
+  /*! \brief Default constructor starting from the identity rotation.
+   */
+  RotationQuaternionAccumulator() {
+  }
+
+  /*! \brief Constructor starting from a rotation.
+   *  \param rotation   first rotation of the chain
+   */
+  template<typename OtherDerived_>
+  explicit RotationQuaternionAccumulator(const RotationBase<OtherDerived_>& rotation)
+    : product_(rotation.derived()) {
+  }
+
+  /*! \brief Concatenates a rotation onto the right of the running product.
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  RotationQuaternionAccumulator& operator*=(const RotationBase<OtherDerived_>& rotation) {
+    product_ = product_*AccumulatorRotation(rotation.derived());
+    return *this;
+  }
+
+  /*! \brief Resets the running product to identity.
+   *  \returns reference
+   */
+  RotationQuaternionAccumulator& setIdentity() {
+    product_.setIdentity();
+    return *this;
+  }
+
+  /*! \brief Gets the running product in the wide primitive type.
+   */
+  const AccumulatorRotation& getAccumulatedRotation() const {
+    return product_;
+  }
+
+  /*! \brief Gets the running product rounded to PrimType_ and renormalized.
+   */
+  Rotation getRotation() const {
+    const Eigen::Matrix<AccumulatorPrimType_, 4, 1> normalized = product_.vector().normalized();
+    return Rotation(normalized.template cast<PrimType_>());
+  }
+
+ private:
+  AccumulatorRotation product_;
+};
+
+
 namespace internal {
 
 template<typename PrimType_>
@@ -488,13 +587,6 @@ class ConversionTraits<RotationQuaternion<DestPrimType_>, AngleAxis<SourcePrimTy
   }
 };
 
-
-template <typename Scalar_ = double>
-inline bool isLessThenEpsilons4thRoot(Scalar_ x){
-  static const Scalar_ epsilon4thRoot = pow(std::numeric_limits<Scalar_>::epsilon(), 1.0/4.0);
-  return x < epsilon4thRoot;
-}
-
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<RotationQuaternion<DestPrimType_>, RotationVector<SourcePrimType_>> {
  public:
@@ -515,21 +607,26 @@ class ConversionTraits<RotationQuaternion<DestPrimType_>, RotationVector<SourceP
 //    return RotationQuaternion<DestPrimType_>(real, imaginary);
 
 
+    using std::cos;
+    using std::sin;
     Scalar theta = (Scalar)rotationVector.toImplementation().norm();
 
-    // na is 1/theta sin(theta/2)
+    // na is 1/theta sin(theta/2), the series use the squared norm whose derivative is defined at zero
     Scalar na;
+    Scalar ct;
     if(isLessThenEpsilons4thRoot(theta))
     {
+        const Scalar thetaSquared = (Scalar)rotationVector.toImplementation().squaredNorm();
         const Scalar one_over_48 = Scalar(1.0/48.0);
-        na = Scalar(0.5) - (theta * theta) * one_over_48;
+        na = Scalar(0.5) - thetaSquared * one_over_48;
+        ct = Scalar(1.0) - thetaSquared * Scalar(0.125);
     }
     else
     {
-        na = sin(theta*0.5) / theta;
+        na = sin(theta*Scalar(0.5)) / theta;
+        ct = cos(theta*Scalar(0.5));
     }
     Imaginary axis = rotationVector.toImplementation().template cast<Scalar>()*na;
-    Scalar ct = cos(theta*0.5);
     return RotationQuaternion<DestPrimType_>(ct, axis[0],axis[1],axis[2]);
 //    return Eigen::Vector4d(axis[0],axis[1],axis[2],ct);
 
@@ -578,9 +675,96 @@ class ConversionTraits<RotationQuaternion<DestPrimType_>, EulerAnglesZyx<SourceP
  * Multiplication Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/*! \brief Multiplication of two rotation quaternions
+ */
+template<typename PrimType_>
+class MultiplicationTraits<RotationBase<RotationQuaternion<PrimType_>>, RotationBase<RotationQuaternion<PrimType_>>> {
+ public:
+  inline static RotationQuaternion<PrimType_> mult(const RotationQuaternion<PrimType_>& lhs, const RotationQuaternion<PrimType_>& rhs) {
+    RotationQuaternion<PrimType_> result;
+    result.toImplementation() = lhs.toImplementation() * rhs.toImplementation();
+    return result;
+  }
+};
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Map Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class MapTraits<RotationBase<RotationQuaternion<PrimType_>>> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  /*! \brief Gets the rotation quaternion from a rotation vector without the rotation vector detour.
+   *  q = [cos(a/2); sin(a/2)/a*v] with a = |v|
+   */
+  KINDR_DEVICE_FUNC inline static RotationQuaternion<PrimType_> set_exponential_map(const Vector3& vector) {
+    using std::cos;
+    using std::sin;
+    const PrimType_ theta = vector.norm();
+    // na is 1/theta sin(theta/2), the series use the squared norm whose derivative is defined at zero
+    PrimType_ na;
+    PrimType_ ct;
+    if (isLessThenEpsilons4thRoot(theta)) {
+      const PrimType_ thetaSquared = vector.squaredNorm();
+      na = PrimType_(0.5) - thetaSquared*PrimType_(1.0/48.0);
+      ct = PrimType_(1.0) - thetaSquared*PrimType_(0.125);
+    }
+    else {
+      na = sin(PrimType_(0.5)*theta)/theta;
+      ct = cos(PrimType_(0.5)*theta);
+    }
+    return RotationQuaternion<PrimType_>(ct, na*vector(0), na*vector(1), na*vector(2));
+  }
+
+  /*! \brief Gets the unique rotation vector (norm in [0,pi]) of the rotation quaternion.
+   *  v = 2*atan2(|q|, w)/|q|*q for the quaternion with w >= 0, where w is the real and q the imaginary part
+   */
+  KINDR_DEVICE_FUNC inline static Vector3 get_logarithmic_map(const RotationQuaternion<PrimType_>& rotation) {
+    using std::atan2;
+    // the quaternion with positive real part yields the unique rotation vector
+    const PrimType_ sign = (rotation.w() < PrimType_(0)) ? PrimType_(-1) : PrimType_(1);
+    const PrimType_ w = sign*rotation.w();
+    const Vector3 imaginary(sign*rotation.x(), sign*rotation.y(), sign*rotation.z());
+    const PrimType_ imaginaryNorm = imaginary.norm();
+    PrimType_ factor;
+    if (isLessThenEpsilons4thRoot(imaginaryNorm)) {
+      // atan2(n, w)/n = 1/w*(1 - n^2/(3*w^2)) + O(n^4)
+      factor = PrimType_(2)/w*(PrimType_(1) - imaginary.squaredNorm()/(PrimType_(3)*w*w));
+    }
+    else {
+      factor = PrimType_(2)*atan2(imaginaryNorm, w)/imaginaryNorm;
+    }
+    return factor*imaginary;
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Rotation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class RotationTraits<RotationBase<RotationQuaternion<PrimType_>>> : public DirectRotationTraits<RotationQuaternion<PrimType_>, 2> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  /*! \brief Rotates a vector without computing the rotation matrix.
+   *  v' = v + w*t + q x t with t = 2*(q x v), where w is the real and q the imaginary part
+   */
+  KINDR_DEVICE_FUNC inline static Vector3 rotateVector(const RotationQuaternion<PrimType_>& rotation, const Vector3& vector) {
+    const Vector3 imaginary(rotation.x(), rotation.y(), rotation.z());
+    const Vector3 t = PrimType_(2.0)*imaginary.cross(vector);
+    return vector + rotation.w()*t + imaginary.cross(t);
+  }
+
+  /*! \brief Rotates a vector by the conjugate quaternion without computing the inverse rotation.
+   *  v' = v - w*t + q x t with t = 2*(q x v)
+   */
+  KINDR_DEVICE_FUNC inline static Vector3 inverseRotateVector(const RotationQuaternion<PrimType_>& rotation, const Vector3& vector) {
+    const Vector3 imaginary(rotation.x(), rotation.y(), rotation.z());
+    const Vector3 t = PrimType_(2.0)*imaginary.cross(vector);
+    return vector - rotation.w()*t + imaginary.cross(t);
+  }
+};
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Comparison Traits
@@ -596,6 +780,59 @@ class ComparisonTraits<RotationBase<RotationQuaternion<PrimType_>>, RotationBase
    }
 };
 
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Disparity Angle Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class DisparityAngleTraits<RotationBase<RotationQuaternion<PrimType_>>, RotationBase<RotationQuaternion<PrimType_>>> {
+ public:
+  /*! \brief Gets the disparity angle directly from the quaternion coefficients.
+   *  The chord between q1 and the closer of +-q2 has the length 2*sin(angle/4), which stays accurate for small angles
+   *  unlike 2*acos(|<q1,q2>|).
+   *  \returns disparity angle in [0,pi]
+   */
+  inline static PrimType_ compute(const RotationBase<RotationQuaternion<PrimType_>>& left, const RotationBase<RotationQuaternion<PrimType_>>& right) {
+    using std::asin;
+    const auto& q1 = left.derived().toImplementation().coeffs();
+    const auto& q2 = right.derived().toImplementation().coeffs();
+    const PrimType_ chord = (q1.dot(q2) < PrimType_(0)) ? (q1 + q2).norm() : (q1 - q2).norm();
+    return PrimType_(4)*asin(std::min(PrimType_(0.5)*chord, PrimType_(1)));
+  }
+
+  /*! \brief Gets the bound 4*sin^2(tol/4) of the squared chord for a tolerance, see isNearWithBound().
+   *  \returns bound, negative for a negative tolerance
+   */
+  inline static PrimType_ getNearnessBound(PrimType_ tol) {
+    if (tol < PrimType_(0)) {
+      return PrimType_(-1);
+    }
+    if (tol >= PrimType_(M_PI)) {
+      // the squared chord to the closer of +-q2 is at most 2
+      return PrimType_(4);
+    }
+    using std::sin;
+    const PrimType_ sinQuarterTol = sin(PrimType_(0.25)*tol);
+    return PrimType_(4)*sinQuarterTol*sinQuarterTol;
+  }
+
+  /*! \brief Compares the squared chord with a bound of getNearnessBound() instead of computing the disparity angle.
+   *  \returns true if the rotations are equal within the tolerance of the bound
+   */
+  inline static bool isNearWithBound(const RotationBase<RotationQuaternion<PrimType_>>& left, const RotationBase<RotationQuaternion<PrimType_>>& right, PrimType_ bound) {
+    const auto& q1 = left.derived().toImplementation().coeffs();
+    const auto& q2 = right.derived().toImplementation().coeffs();
+    const PrimType_ chordSquared = (q1.dot(q2) < PrimType_(0)) ? (q1 + q2).squaredNorm() : (q1 - q2).squaredNorm();
+    return chordSquared <= bound;
+  }
+
+  /*! \brief Compares the chord with 2*sin(tol/4) instead of computing the disparity angle.
+   *  \returns true if the rotations are equal within the tolerance
+   */
+  inline static bool isNear(const RotationBase<RotationQuaternion<PrimType_>>& left, const RotationBase<RotationQuaternion<PrimType_>>& right, PrimType_ tol) {
+    return isNearWithBound(left, right, getNearnessBound(tol));
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Fixing Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationQuaternionArrayKernels.hpp"
+#include "kindr/vectors/VectorArray.hpp"
+
+namespace kindr {
+
+/*! \class RotationQuaternionArray
+ *  \brief Batch of rotation quaternions stored in structure-of-arrays layout.
+ *
+ *  The components of N unit quaternions are stored in a row-major 4xN matrix with the rows [w; x; y; z],
+ *  i.e. each component of all quaternions is contiguous in memory. Concatenation, rotation and normalization use the explicitly
+ *  vectorized kernels of internal::QuaternionArrayKernels, the remaining operations are written as coefficient-wise expressions
+ *  on the rows, which are vectorized by Eigen. All operations are equivalent to applying the corresponding operation
+ *  of RotationQuaternion to every quaternion of the batch.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationQuaternionArray {
+ public:
+  /*! \brief The implementation type.
+   *  The implementation type is always an Eigen object.
+   */
+  typedef Eigen::Matrix<PrimType_, 4, Eigen::Dynamic, Eigen::RowMajor> Implementation;
+
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  /*! \brief The type of a single rotation of the batch.
+   */
+  typedef RotationQuaternion<PrimType_> Element;
+
+  /*! \brief Batch of 3D vectors (e.g. rotation vectors), one vector per column.
+   */
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic, Eigen::RowMajor> Matrix3X;
+
+  /*! \brief Batch of rotation matrices, the element (r,c) of each matrix is stored in row r+3*c.
+   */
+  typedef Eigen::Matrix<PrimType_, 9, Eigen::Dynamic, Eigen::RowMajor> Matrix9X;
+
+  /*! \brief Default constructor creating an empty batch.
+   */
+  RotationQuaternionArray()
+    : quaternions_(4, 0) {
+  }
+
+  /*! \brief Constructor creating a batch of identity rotations.
+   *  \param size   number of rotations
+   */
+  explicit RotationQuaternionArray(int size)
+    : quaternions_(4, size) {
+    setIdentity();
+  }
+
+  /*! \brief Constructor using a 4xN Eigen matrix with the rows [w; x; y; z].
+   *  In debug mode, an assertion is thrown if a quaternion has not unit length.
+   *  \param other   Eigen matrix expression with four rows
+   */
+  template<typename OtherDerived_>
+  explicit RotationQuaternionArray(const Eigen::MatrixBase<OtherDerived_>& other)
+    : quaternions_(other) {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, ((quaternions_.colwise().norm().array() - Scalar(1)).abs() < Scalar(1e-2)).all(), "Input quaternion has not unit length.");
+  }
+
+  /*! \brief Constructor using a std::vector of rotations.
+   *  \param rotations   rotations
+   */
+  explicit RotationQuaternionArray(const std::vector<Element>& rotations)
+    : quaternions_(4, rotations.size()) {
+    for (int i = 0; i < size(); ++i) {
+      set(i, rotations[i]);
+    }
+  }
+
+  /*! \brief Constructor using a batch with another primitive type.
+   *  \param other   RotationQuaternionArray<OtherPrimType_>
+   */
+  template<typename OtherPrimType_>
+  explicit RotationQuaternionArray(const RotationQuaternionArray<OtherPrimType_>& other)
+    : quaternions_(other.toImplementation().template cast<PrimType_>()) {
+  }
+
+  /*! \brief Gets a batch of identity rotations.
+   *  \param size   number of rotations
+   *  \returns batch of identity rotations
+   */
+  static RotationQuaternionArray Identity(int size) {
+    return RotationQuaternionArray(size);
+  }
+
+  /*! \brief Sets all rotations to identity.
+   *  \returns reference
+   */
+  RotationQuaternionArray& setIdentity() {
+    quaternions_.row(0).setOnes();
+    quaternions_.template bottomRows<3>().setZero();
+    return *this;
+  }
+
+  /*! \brief Gets the number of rotations.
+   *  \returns number of rotations
+   */
+  inline int size() const {
+    return static_cast<int>(quaternions_.cols());
+  }
+
+  /*! \brief Resizes the batch. The content is undefined afterwards.
+   *  \param size   number of rotations
+   */
+  inline void resize(int size) {
+    quaternions_.resize(4, size);
+  }
+
+  /*! \brief Gets the i-th rotation.
+   *  \returns rotation
+   */
+  inline Element operator [](int i) const {
+    return Element(quaternions_(0,i), quaternions_(1,i), quaternions_(2,i), quaternions_(3,i));
+  }
+
+  /*! \brief Sets the i-th rotation.
+   *  \param i   index
+   *  \param rotation   rotation with any parameterization
+   */
+  template<typename OtherDerived_>
+  inline void set(int i, const RotationBase<OtherDerived_>& rotation) {
+    const Element quaternion(rotation.derived());
+    quaternions_(0,i) = quaternion.w();
+    quaternions_(1,i) = quaternion.x();
+    quaternions_(2,i) = quaternion.y();
+    quaternions_(3,i) = quaternion.z();
+  }
+
+  inline typename Implementation::ConstRowXpr w() const {
+    return quaternions_.row(0);
+  }
+
+  inline typename Implementation::ConstRowXpr x() const {
+    return quaternions_.row(1);
+  }
+
+  inline typename Implementation::ConstRowXpr y() const {
+    return quaternions_.row(2);
+  }
+
+  inline typename Implementation::ConstRowXpr z() const {
+    return quaternions_.row(3);
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline Implementation& toImplementation() {
+    return quaternions_;
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline const Implementation& toImplementation() const {
+    return quaternions_;
+  }
+
+  /*! \brief Gets the rotations as std::vector.
+   *  \returns rotations
+   */
+  std::vector<Element> toStdVector() const {
+    std::vector<Element> rotations;
+    rotations.reserve(size());
+    for (int i = 0; i < size(); ++i) {
+      rotations.push_back((*this)[i]);
+    }
+    return rotations;
+  }
+
+  /*! \brief Returns the inverse of all rotations.
+   *  \returns the inverse of the rotations
+   */
+  RotationQuaternionArray inverted() const {
+    RotationQuaternionArray result(*this);
+    result.invert();
+    return result;
+  }
+
+  /*! \brief Inverts all rotations.
+   *  \returns reference
+   */
+  RotationQuaternionArray& invert() {
+    quaternions_.template bottomRows<3>() *= Scalar(-1);
+    return *this;
+  }
+
+  /*! \brief Normalizes all quaternions to unit length.
+   *  \param executor   executor distributing chunks of rotations to threads, see SerialExecutor
+   *  \returns reference
+   */
+  template<typename Executor_ = SerialExecutor>
+  RotationQuaternionArray& fix(const Executor_& executor = Executor_()) {
+    Scalar* quaternions = quaternions_.data();
+    const int stride = size();
+    executor.parallelFor(0, size(), GrainSize, [quaternions, stride](int begin, int end) {
+      internal::QuaternionArrayKernels<PrimType_>::normalize(quaternions, stride, begin, end);
+    });
+    return *this;
+  }
+
+  /*! \brief Concatenates the rotations pairwise (Hamilton product).
+   *  \param other   batch of the same size
+   *  \returns the concatenation lhs[i]*rhs[i] of the rotations
+   */
+  RotationQuaternionArray operator *(const RotationQuaternionArray& other) const {
+    RotationQuaternionArray result;
+    multiply(other, result);
+    return result;
+  }
+
+  /*! \brief Concatenates every rotation of the batch with the same rotation.
+   *  \param other   rotation
+   *  \returns the concatenation lhs[i]*rhs of the rotations
+   */
+  template<typename OtherDerived_>
+  RotationQuaternionArray operator *(const RotationBase<OtherDerived_>& other) const {
+    const Element quaternion(other.derived());
+    RotationQuaternionArray result;
+    result.resize(size());
+    for (int start = 0; start < size(); start += BlockSize) {
+      const int length = std::min<int>(BlockSize, size() - start);
+      multiplyBlock(start, length,
+                    quaternions_.row(0).segment(start, length).array(), quaternions_.row(1).segment(start, length).array(),
+                    quaternions_.row(2).segment(start, length).array(), quaternions_.row(3).segment(start, length).array(),
+                    quaternion.w(), quaternion.x(), quaternion.y(), quaternion.z(), result);
+    }
+    return result;
+  }
+
+  /*! \brief Concatenates the rotations pairwise (Hamilton product) without allocating memory if the result has the correct size.
+   *  The result may be one of the operands.
+   *  \param other      batch of the same size
+   *  \param result     the concatenation this[i]*other[i] of the rotations
+   *  \param executor   executor distributing chunks of rotations to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void multiply(const RotationQuaternionArray& other, RotationQuaternionArray& result, const Executor_& executor = Executor_()) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, size() == other.size(), "The batches have different sizes.");
+    result.resize(size());
+    const Scalar* lhs = quaternions_.data();
+    const Scalar* rhs = other.quaternions_.data();
+    Scalar* product = result.quaternions_.data();
+    const int stride = size();
+    executor.parallelFor(0, size(), GrainSize, [lhs, rhs, product, stride](int begin, int end) {
+      internal::QuaternionArrayKernels<PrimType_>::multiply(lhs, rhs, product, stride, begin, end);
+    });
+  }
+
+  /*! \brief Rotates the vectors pairwise, i.e. the i-th vector by the i-th rotation.
+   *  \param vectors   3xN matrix expression with N equal to the size of the batch
+   *  \returns the rotated vectors
+   */
+  template<typename OtherDerived_>
+  Matrix3X rotate(const Eigen::MatrixBase<OtherDerived_>& vectors) const {
+    Matrix3X rotated;
+    rotate(vectors, rotated, Scalar(1));
+    return rotated;
+  }
+
+  /*! \brief Rotates the vectors pairwise, i.e. the i-th vector by the i-th rotation.
+   *  \param vectors   batch of vectors with the same size
+   *  \returns the rotated vectors
+   */
+  template<enum PhysicalType PhysicalType_>
+  VectorArray<PhysicalType_, PrimType_> rotate(const VectorArray<PhysicalType_, PrimType_>& vectors) const {
+    VectorArray<PhysicalType_, PrimType_> rotated;
+    rotate(vectors.toImplementation(), rotated.toImplementation(), Scalar(1));
+    return rotated;
+  }
+
+  /*! \brief Rotates the vectors pairwise without allocating memory if the result has the correct size.
+   *  The result may be the input.
+   *  \param vectors    batch of vectors with the same size
+   *  \param rotated    the rotated vectors
+   *  \param executor   executor distributing chunks of vectors to threads, see SerialExecutor
+   */
+  template<enum PhysicalType PhysicalType_, typename Executor_ = SerialExecutor>
+  void rotate(const VectorArray<PhysicalType_, PrimType_>& vectors, VectorArray<PhysicalType_, PrimType_>& rotated, const Executor_& executor = Executor_()) const {
+    rotate(vectors.toImplementation(), rotated.toImplementation(), Scalar(1), executor);
+  }
+
+  /*! \brief Rotates the vectors pairwise with the inverse rotations.
+   *  \param vectors   3xN matrix expression with N equal to the size of the batch
+   *  \returns the rotated vectors
+   */
+  template<typename OtherDerived_>
+  Matrix3X inverseRotate(const Eigen::MatrixBase<OtherDerived_>& vectors) const {
+    Matrix3X rotated;
+    rotate(vectors, rotated, Scalar(-1));
+    return rotated;
+  }
+
+  /*! \brief Rotates the vectors pairwise with the inverse rotations.
+   *  \param vectors   batch of vectors with the same size
+   *  \returns the rotated vectors
+   */
+  template<enum PhysicalType PhysicalType_>
+  VectorArray<PhysicalType_, PrimType_> inverseRotate(const VectorArray<PhysicalType_, PrimType_>& vectors) const {
+    VectorArray<PhysicalType_, PrimType_> rotated;
+    rotate(vectors.toImplementation(), rotated.toImplementation(), Scalar(-1));
+    return rotated;
+  }
+
+  /*! \brief Rotates the vectors pairwise with the inverse rotations without allocating memory if the result has the correct size.
+   *  The result may be the input.
+   *  \param vectors    batch of vectors with the same size
+   *  \param rotated    the rotated vectors
+   *  \param executor   executor distributing chunks of vectors to threads, see SerialExecutor
+   */
+  template<enum PhysicalType PhysicalType_, typename Executor_ = SerialExecutor>
+  void inverseRotate(const VectorArray<PhysicalType_, PrimType_>& vectors, VectorArray<PhysicalType_, PrimType_>& rotated, const Executor_& executor = Executor_()) const {
+    rotate(vectors.toImplementation(), rotated.toImplementation(), Scalar(-1), executor);
+  }
+
+  /*! \brief Gets the rotations from rotation vectors (exponential map).
+   *  \param vectors   3xN matrix expression of rotation vectors
+   *  \returns batch of rotations
+   */
+  template<typename OtherDerived_>
+  static RotationQuaternionArray exponentialMap(const Eigen::MatrixBase<OtherDerived_>& vectors) {
+    using std::pow;
+    KINDR_ASSERT_TRUE(std::runtime_error, vectors.rows() == 3, "The rotation vectors must have three rows.");
+    const Scalar epsilon4thRoot = pow(std::numeric_limits<Scalar>::epsilon(), Scalar(1.0/4.0));
+    const int size = static_cast<int>(vectors.cols());
+    RotationQuaternionArray result;
+    result.resize(size);
+    for (int start = 0; start < size; start += BlockSize) {
+      const int length = std::min<int>(BlockSize, size - start);
+      const BlockRow vx = vectors.row(0).segment(start, length).array();
+      const BlockRow vy = vectors.row(1).segment(start, length).array();
+      const BlockRow vz = vectors.row(2).segment(start, length).array();
+      const BlockRow thetaSquared = vx*vx + vy*vy + vz*vz;
+      const BlockRow theta = thetaSquared.sqrt();
+      // na is 1/theta sin(theta/2)
+      const BlockRow na = (theta < epsilon4thRoot).select(Scalar(0.5) - thetaSquared*Scalar(1.0/48.0), (theta*Scalar(0.5)).sin()/theta);
+      result.quaternions_.row(0).segment(start, length).array() = (theta*Scalar(0.5)).cos();
+      result.quaternions_.row(1).segment(start, length).array() = vx*na;
+      result.quaternions_.row(2).segment(start, length).array() = vy*na;
+      result.quaternions_.row(3).segment(start, length).array() = vz*na;
+    }
+    return result;
+  }
+
+  /*! \brief Gets the rotation vectors of all rotations (logarithmic map).
+   *  The rotation vectors are unique, i.e. their norms are in [0,pi].
+   *  \returns 3xN matrix of rotation vectors
+   */
+  Matrix3X logarithmicMap() const {
+    Matrix3X vectors(3, size());
+    for (int start = 0; start < size(); start += BlockSize) {
+      const int length = std::min<int>(BlockSize, size() - start);
+      const auto w = quaternions_.row(0).segment(start, length).array();
+      const auto x = quaternions_.row(1).segment(start, length).array();
+      const auto y = quaternions_.row(2).segment(start, length).array();
+      const auto z = quaternions_.row(3).segment(start, length).array();
+      // use the quaternion with positive real part to get the unique rotation vector
+      const BlockRow sign = (w < Scalar(0)).select(BlockRow::Constant(length, Scalar(-1)), BlockRow::Constant(length, Scalar(1)));
+      const BlockRow positiveW = w*sign;
+      const BlockRow imaginaryNorm = (x*x + y*y + z*z).sqrt();
+      const BlockRow angle = imaginaryNorm.binaryExpr(positiveW, [](Scalar a, Scalar b) { return std::atan2(a, b); });
+      const BlockRow factor = (Scalar(1) - positiveW*positiveW < internal::NumTraits<Scalar>::dummy_precision()).select(
+          BlockRow::Constant(length, Scalar(2)), Scalar(2)*angle/imaginaryNorm)*sign;
+      vectors.row(0).segment(start, length).array() = x*factor;
+      vectors.row(1).segment(start, length).array() = y*factor;
+      vectors.row(2).segment(start, length).array() = z*factor;
+    }
+    return vectors;
+  }
+
+  /*! \brief Applies the box plus operation to every rotation.
+   *  \param vectors   3xN matrix expression of rotation vectors
+   *  \returns exp(vectors[i])*this[i]
+   */
+  template<typename OtherDerived_>
+  RotationQuaternionArray boxPlus(const Eigen::MatrixBase<OtherDerived_>& vectors) const {
+    RotationQuaternionArray result = exponentialMap(vectors);
+    result.multiply(*this, result);
+    return result;
+  }
+
+  /*! \brief Applies the box minus operation pairwise.
+   *  \param other   batch of the same size
+   *  \returns log(this[i]*other[i]^-1)
+   */
+  Matrix3X boxMinus(const RotationQuaternionArray& other) const {
+    RotationQuaternionArray difference = other.inverted();
+    multiply(difference, difference);
+    return difference.logarithmicMap();
+  }
+
+  /*! \brief Gets the rotation matrices of all rotations.
+   *  \returns 9xN matrix, the element (r,c) of each rotation matrix is stored in row r+3*c
+   */
+  Matrix9X getRotationMatrices() const {
+    Matrix9X matrices;
+    getRotationMatrices(matrices);
+    return matrices;
+  }
+
+  /*! \brief Gets the rotation matrices of all rotations without allocating memory if the result has the correct size.
+   *  \param matrices   9xN matrix, the element (r,c) of each rotation matrix is stored in row r+3*c
+   *  \param executor   executor distributing chunks of rotations to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void getRotationMatrices(Matrix9X& matrices, const Executor_& executor = Executor_()) const {
+    matrices.resize(9, size());
+    executor.parallelFor(0, size(), GrainSize, [this, &matrices](int begin, int end) {
+      const int length = end - begin;
+      const auto w = quaternions_.row(0).segment(begin, length).array(), x = quaternions_.row(1).segment(begin, length).array();
+      const auto y = quaternions_.row(2).segment(begin, length).array(), z = quaternions_.row(3).segment(begin, length).array();
+      const Scalar one = Scalar(1);
+      const Scalar two = Scalar(2);
+      matrices.row(0).segment(begin, length).array() = one - two*(y*y + z*z);
+      matrices.row(1).segment(begin, length).array() = two*(x*y + w*z);
+      matrices.row(2).segment(begin, length).array() = two*(x*z - w*y);
+      matrices.row(3).segment(begin, length).array() = two*(x*y - w*z);
+      matrices.row(4).segment(begin, length).array() = one - two*(x*x + z*z);
+      matrices.row(5).segment(begin, length).array() = two*(y*z + w*x);
+      matrices.row(6).segment(begin, length).array() = two*(x*z + w*y);
+      matrices.row(7).segment(begin, length).array() = two*(y*z - w*x);
+      matrices.row(8).segment(begin, length).array() = one - two*(x*x + y*y);
+    });
+  }
+
+ private:
+  /*! \brief Number of columns that are processed at once.
+   *  The temporaries of a block are allocated on the stack and stay in the L1 cache.
+   */
+  enum { BlockSize = 128 };
+
+  /*! \brief Minimum number of columns of a chunk that is handed to an executor.
+   */
+  enum { GrainSize = 64*BlockSize };
+
+  /*! \brief Temporary row of a block.
+   */
+  typedef Eigen::Array<PrimType_, 1, Eigen::Dynamic, Eigen::RowMajor, 1, BlockSize> BlockRow;
+
+  //! Hamilton product of a block, the operands are evaluated before the result is written (the result may alias an operand)
+  template<typename W1_, typename X1_, typename Y1_, typename Z1_, typename W2_, typename X2_, typename Y2_, typename Z2_>
+  static void multiplyBlock(int start, int length, const W1_& w1, const X1_& x1, const Y1_& y1, const Z1_& z1,
+                            const W2_& w2, const X2_& x2, const Y2_& y2, const Z2_& z2, RotationQuaternionArray& result) {
+    const BlockRow w = w1*w2 - x1*x2 - y1*y2 - z1*z2;
+    const BlockRow x = w1*x2 + x1*w2 + y1*z2 - z1*y2;
+    const BlockRow y = w1*y2 - x1*z2 + y1*w2 + z1*x2;
+    const BlockRow z = w1*z2 + x1*y2 - y1*x2 + z1*w2;
+    result.quaternions_.row(0).segment(start, length).array() = w;
+    result.quaternions_.row(1).segment(start, length).array() = x;
+    result.quaternions_.row(2).segment(start, length).array() = y;
+    result.quaternions_.row(3).segment(start, length).array() = z;
+  }
+
+  //! Rotates the vectors pairwise, the imaginary part of the quaternions is scaled by imaginarySign (-1 for the inverse rotation)
+  template<typename Executor_ = SerialExecutor>
+  void rotate(const Matrix3X& vectors, Matrix3X& rotated, Scalar imaginarySign, const Executor_& executor = Executor_()) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, vectors.cols() == size(), "The number of vectors must be equal to the size of the batch.");
+    rotated.resize(3, size());
+    const Scalar* quaternions = quaternions_.data();
+    const Scalar* input = vectors.data();
+    Scalar* output = rotated.data();
+    const int stride = size();
+    executor.parallelFor(0, size(), GrainSize, [quaternions, input, output, stride, imaginarySign](int begin, int end) {
+      internal::QuaternionArrayKernels<PrimType_>::rotate(quaternions, input, output, stride, begin, end, imaginarySign);
+    });
+  }
+
+  //! Evaluates a matrix expression to contiguous rows before rotating it
+  template<typename OtherDerived_>
+  void rotate(const Eigen::MatrixBase<OtherDerived_>& vectors, Matrix3X& rotated, Scalar imaginarySign) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, vectors.rows() == 3, "The vectors must be a 3xN matrix.");
+    rotate(Matrix3X(vectors), rotated, imaginarySign);
+  }
+
+  Implementation quaternions_;
+};
+
+typedef RotationQuaternionArray<double> RotationQuaternionArrayD;
+typedef RotationQuaternionArray<float> RotationQuaternionArrayF;
+
+} // namespace kindr
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#pragma once
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+namespace kindr {
+namespace internal {
+
+/*! \class QuaternionArrayKernels
+ *  \brief Kernels of RotationQuaternionArray operating on the rows of structure-of-arrays storage.
+ *
+ *  All kernels work on row-major matrices with contiguous rows, e.g. a 4xN matrix of quaternions with the rows [w; x; y; z]
+ *  or a 3xN matrix of vectors. The row stride is the number of columns N and the columns [begin,end) are processed.
+ *  Every column is read completely before it is written, such that the result may be one of the operands.
+ *
+ *  The scalar kernels (Vectorize_ = false) evaluate the same formulas as the corresponding operations of RotationQuaternion.
+ *  The vectorized kernels (Vectorize_ = true) evaluate the same formulas on packets of Eigen::internal::packet_traits<PrimType_>,
+ *  i.e. on 2, 4 or 8 columns at once depending on the instruction set Eigen was compiled for (SSE, AVX, AVX512, NEON, ...),
+ *  and use the scalar kernels for the remaining columns.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \tparam Vectorize_ true if explicit vector instructions are used
+ */
+template<typename PrimType_, bool Vectorize_ = (Eigen::internal::packet_traits<PrimType_>::Vectorizable && Eigen::internal::packet_traits<PrimType_>::size > 1)>
+class QuaternionArrayKernels {
+ public:
+  typedef PrimType_ Scalar;
+
+  /*! \brief Hamilton product result[i] = lhs[i]*rhs[i].
+   */
+  static void multiply(const Scalar* lhs, const Scalar* rhs, Scalar* result, int stride, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      const Scalar w1 = lhs[i], x1 = lhs[stride + i], y1 = lhs[2*stride + i], z1 = lhs[3*stride + i];
+      const Scalar w2 = rhs[i], x2 = rhs[stride + i], y2 = rhs[2*stride + i], z2 = rhs[3*stride + i];
+      result[i]            = w1*w2 - x1*x2 - y1*y2 - z1*z2;
+      result[stride + i]   = w1*x2 + x1*w2 + y1*z2 - z1*y2;
+      result[2*stride + i] = w1*y2 - x1*z2 + y1*w2 + z1*x2;
+      result[3*stride + i] = w1*z2 + x1*y2 - y1*x2 + z1*w2;
+    }
+  }
+
+  /*! \brief Rotation of the vectors by the quaternions, the imaginary parts are scaled by imaginarySign (-1 for the inverse rotation).
+   */
+  static void rotate(const Scalar* quaternions, const Scalar* vectors, Scalar* rotated, int stride, int begin, int end, Scalar imaginarySign) {
+    for (int i = begin; i < end; ++i) {
+      const Scalar w = quaternions[i];
+      const Scalar ux = imaginarySign*quaternions[stride + i], uy = imaginarySign*quaternions[2*stride + i], uz = imaginarySign*quaternions[3*stride + i];
+      const Scalar vx = vectors[i], vy = vectors[stride + i], vz = vectors[2*stride + i];
+      // v' = v + w*t + u x t with t = 2*(u x v)
+      const Scalar tx = Scalar(2)*(uy*vz - uz*vy);
+      const Scalar ty = Scalar(2)*(uz*vx - ux*vz);
+      const Scalar tz = Scalar(2)*(ux*vy - uy*vx);
+      rotated[i]            = vx + w*tx + uy*tz - uz*ty;
+      rotated[stride + i]   = vy + w*ty + uz*tx - ux*tz;
+      rotated[2*stride + i] = vz + w*tz + ux*ty - uy*tx;
+    }
+  }
+
+  /*! \brief Normalization of the quaternions to unit length.
+   */
+  static void normalize(Scalar* quaternions, int stride, int begin, int end) {
+    using std::sqrt;
+    for (int i = begin; i < end; ++i) {
+      const Scalar w = quaternions[i], x = quaternions[stride + i], y = quaternions[2*stride + i], z = quaternions[3*stride + i];
+      const Scalar inverseNorm = Scalar(1)/sqrt((w*w + x*x) + (y*y + z*z));
+      quaternions[i]            = w*inverseNorm;
+      quaternions[stride + i]   = x*inverseNorm;
+      quaternions[2*stride + i] = y*inverseNorm;
+      quaternions[3*stride + i] = z*inverseNorm;
+    }
+  }
+};
+
+template<typename PrimType_>
+class QuaternionArrayKernels<PrimType_, true> {
+ public:
+  typedef PrimType_ Scalar;
+  typedef typename Eigen::internal::packet_traits<PrimType_>::type Packet;
+  typedef QuaternionArrayKernels<PrimType_, false> ScalarKernels;
+  enum { PacketSize = Eigen::internal::packet_traits<PrimType_>::size };
+
+  /*! \brief Hamilton product result[i] = lhs[i]*rhs[i].
+   */
+  static void multiply(const Scalar* lhs, const Scalar* rhs, Scalar* result, int stride, int begin, int end) {
+    using namespace Eigen::internal;
+    int i = begin;
+    for (; i + PacketSize <= end; i += PacketSize) {
+      const Packet w1 = ploadu<Packet>(lhs + i), x1 = ploadu<Packet>(lhs + stride + i);
+      const Packet y1 = ploadu<Packet>(lhs + 2*stride + i), z1 = ploadu<Packet>(lhs + 3*stride + i);
+      const Packet w2 = ploadu<Packet>(rhs + i), x2 = ploadu<Packet>(rhs + stride + i);
+      const Packet y2 = ploadu<Packet>(rhs + 2*stride + i), z2 = ploadu<Packet>(rhs + 3*stride + i);
+      pstoreu(result + i,            psub(psub(psub(pmul(w1, w2), pmul(x1, x2)), pmul(y1, y2)), pmul(z1, z2)));
+      pstoreu(result + stride + i,   psub(padd(padd(pmul(w1, x2), pmul(x1, w2)), pmul(y1, z2)), pmul(z1, y2)));
+      pstoreu(result + 2*stride + i, padd(padd(psub(pmul(w1, y2), pmul(x1, z2)), pmul(y1, w2)), pmul(z1, x2)));
+      pstoreu(result + 3*stride + i, padd(psub(padd(pmul(w1, z2), pmul(x1, y2)), pmul(y1, x2)), pmul(z1, w2)));
+    }
+    ScalarKernels::multiply(lhs, rhs, result, stride, i, end);
+  }
+
+  /*! \brief Rotation of the vectors by the quaternions, the imaginary parts are scaled by imaginarySign (-1 for the inverse rotation).
+   */
+  static void rotate(const Scalar* quaternions, const Scalar* vectors, Scalar* rotated, int stride, int begin, int end, Scalar imaginarySign) {
+    using namespace Eigen::internal;
+    const Packet sign = pset1<Packet>(imaginarySign);
+    const Packet two = pset1<Packet>(Scalar(2));
+    int i = begin;
+    for (; i + PacketSize <= end; i += PacketSize) {
+      const Packet w = ploadu<Packet>(quaternions + i);
+      const Packet ux = pmul(sign, ploadu<Packet>(quaternions + stride + i));
+      const Packet uy = pmul(sign, ploadu<Packet>(quaternions + 2*stride + i));
+      const Packet uz = pmul(sign, ploadu<Packet>(quaternions + 3*stride + i));
+      const Packet vx = ploadu<Packet>(vectors + i), vy = ploadu<Packet>(vectors + stride + i), vz = ploadu<Packet>(vectors + 2*stride + i);
+      // v' = v + w*t + u x t with t = 2*(u x v)
+      const Packet tx = pmul(two, psub(pmul(uy, vz), pmul(uz, vy)));
+      const Packet ty = pmul(two, psub(pmul(uz, vx), pmul(ux, vz)));
+      const Packet tz = pmul(two, psub(pmul(ux, vy), pmul(uy, vx)));
+      pstoreu(rotated + i,            psub(padd(padd(vx, pmul(w, tx)), pmul(uy, tz)), pmul(uz, ty)));
+      pstoreu(rotated + stride + i,   psub(padd(padd(vy, pmul(w, ty)), pmul(uz, tx)), pmul(ux, tz)));
+      pstoreu(rotated + 2*stride + i, psub(padd(padd(vz, pmul(w, tz)), pmul(ux, ty)), pmul(uy, tx)));
+    }
+    ScalarKernels::rotate(quaternions, vectors, rotated, stride, i, end, imaginarySign);
+  }
+
+  /*! \brief Normalization of the quaternions to unit length.
+   */
+  static void normalize(Scalar* quaternions, int stride, int begin, int end) {
+    using namespace Eigen::internal;
+    const Packet one = pset1<Packet>(Scalar(1));
+    int i = begin;
+    for (; i + PacketSize <= end; i += PacketSize) {
+      const Packet w = ploadu<Packet>(quaternions + i), x = ploadu<Packet>(quaternions + stride + i);
+      const Packet y = ploadu<Packet>(quaternions + 2*stride + i), z = ploadu<Packet>(quaternions + 3*stride + i);
+      const Packet inverseNorm = pdiv(one, psqrt(padd(padd(pmul(w, w), pmul(x, x)), padd(pmul(y, y), pmul(z, z)))));
+      pstoreu(quaternions + i,            pmul(w, inverseNorm));
+      pstoreu(quaternions + stride + i,   pmul(x, inverseNorm));
+      pstoreu(quaternions + 2*stride + i, pmul(y, inverseNorm));
+      pstoreu(quaternions + 3*stride + i, pmul(z, inverseNorm));
+    }
+    ScalarKernels::normalize(quaternions, stride, i, end);
+  }
+};
+
+} // namespace internal
+} // namespace kindr
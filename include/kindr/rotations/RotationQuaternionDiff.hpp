@@ -55,6 +55,8 @@ class RotationQuaternionDiff : public RotationDiffBase<RotationQuaternionDiff<Pr
   typedef Quaternion<PrimType_> Base;
 
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   /*! \brief The implementation type.
    *  The implementation type is always an Eigen object.
    */
@@ -193,7 +195,13 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<RotationQuaternionDiff<PrimType_>, LocalAngularVelocity<PrimType_>, RotationQuaternion<PrimType_>> {
  public:
   inline static RotationQuaternionDiff<PrimType_> convert(const RotationQuaternion<PrimType_>& rquat, const LocalAngularVelocity<PrimType_>& angularVelocity) {
-    return RotationQuaternionDiff<PrimType_>(Quaternion<PrimType_>(0.5*(rquat.getLocalQuaternionDiffMatrix().transpose()*angularVelocity.vector())));
+    // 0.5*HBar^T*w without building HBar, see RotationQuaternion::getLocalQuaternionDiffMatrix()
+    const Eigen::Matrix<PrimType_, 3, 1> halfAngularVelocity = PrimType_(0.5)*angularVelocity.vector();
+    return RotationQuaternionDiff<PrimType_>(
+        -rquat.x()*halfAngularVelocity.x() - rquat.y()*halfAngularVelocity.y() - rquat.z()*halfAngularVelocity.z(),
+         rquat.w()*halfAngularVelocity.x() - rquat.z()*halfAngularVelocity.y() + rquat.y()*halfAngularVelocity.z(),
+         rquat.z()*halfAngularVelocity.x() + rquat.w()*halfAngularVelocity.y() - rquat.x()*halfAngularVelocity.z(),
+        -rquat.y()*halfAngularVelocity.x() + rquat.x()*halfAngularVelocity.y() + rquat.w()*halfAngularVelocity.z());
   }
 };
 
@@ -201,7 +209,13 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<RotationQuaternionDiff<PrimType_>, GlobalAngularVelocity<PrimType_>, RotationQuaternion<PrimType_>> {
  public:
   inline static RotationQuaternionDiff<PrimType_> convert(const RotationQuaternion<PrimType_>& rquat, const GlobalAngularVelocity<PrimType_>& angularVelocity) {
-    return RotationQuaternionDiff<PrimType_>(Quaternion<PrimType_>(0.5*(rquat.getGlobalQuaternionDiffMatrix().transpose()*angularVelocity.vector())));
+    // 0.5*H^T*w without building H, see RotationQuaternion::getGlobalQuaternionDiffMatrix()
+    const Eigen::Matrix<PrimType_, 3, 1> halfAngularVelocity = PrimType_(0.5)*angularVelocity.vector();
+    return RotationQuaternionDiff<PrimType_>(
+        -rquat.x()*halfAngularVelocity.x() - rquat.y()*halfAngularVelocity.y() - rquat.z()*halfAngularVelocity.z(),
+         rquat.w()*halfAngularVelocity.x() + rquat.z()*halfAngularVelocity.y() - rquat.y()*halfAngularVelocity.z(),
+        -rquat.z()*halfAngularVelocity.x() + rquat.w()*halfAngularVelocity.y() + rquat.x()*halfAngularVelocity.z(),
+         rquat.y()*halfAngularVelocity.x() - rquat.x()*halfAngularVelocity.y() + rquat.w()*halfAngularVelocity.z());
   }
 };
 
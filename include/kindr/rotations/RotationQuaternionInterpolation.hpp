@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/Executor.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationQuaternionArray.hpp"
+
+namespace kindr {
+
+/*! \brief Spherical linear interpolation between two rotation quaternions along the shortest path.
+ *  q(t) = sin((1-t)*a)/sin(a)*q0 + sin(t*a)/sin(a)*q1 with cos(a) = |q0.q1|, which falls back to nlerp for small angles.
+ *  \param q0   rotation at t = 0
+ *  \param q1   rotation at t = 1
+ *  \param t    interpolation parameter in [0,1]
+ *  \returns interpolated rotation
+ */
+template<typename PrimType_>
+RotationQuaternion<PrimType_> slerp(const RotationQuaternion<PrimType_>& q0, const RotationQuaternion<PrimType_>& q1, PrimType_ t) {
+  using std::acos;
+  using std::sin;
+  typedef Eigen::Matrix<PrimType_, 4, 1> Vector4;
+  const Vector4 v0 = q0.vector();
+  Vector4 v1 = q1.vector();
+  PrimType_ cosAngle = v0.dot(v1);
+  if (cosAngle < PrimType_(0)) {
+    v1 = -v1;
+    cosAngle = -cosAngle;
+  }
+  PrimType_ c0, c1;
+  if (cosAngle > PrimType_(1) - internal::NumTraits<PrimType_>::dummy_precision()) {
+    c0 = PrimType_(1) - t;
+    c1 = t;
+  }
+  else {
+    const PrimType_ angle = acos(cosAngle);
+    const PrimType_ sinAngle = sin(angle);
+    c0 = sin((PrimType_(1) - t)*angle)/sinAngle;
+    c1 = sin(t*angle)/sinAngle;
+  }
+  const Vector4 result = (c0*v0 + c1*v1).normalized();
+  return RotationQuaternion<PrimType_>(result);
+}
+
+/*! \brief Normalized linear interpolation between two rotation quaternions along the shortest path.
+ *  The rotation moves with non-constant angular velocity, but is cheaper than slerp.
+ *  \param q0   rotation at t = 0
+ *  \param q1   rotation at t = 1
+ *  \param t    interpolation parameter in [0,1]
+ *  \returns interpolated rotation
+ */
+template<typename PrimType_>
+RotationQuaternion<PrimType_> nlerp(const RotationQuaternion<PrimType_>& q0, const RotationQuaternion<PrimType_>& q1, PrimType_ t) {
+  typedef Eigen::Matrix<PrimType_, 4, 1> Vector4;
+  const Vector4 v0 = q0.vector();
+  const Vector4 v1 = (v0.dot(q1.vector()) < PrimType_(0)) ? Vector4(-q1.vector()) : q1.vector();
+  const Vector4 result = ((PrimType_(1) - t)*v0 + t*v1).normalized();
+  return RotationQuaternion<PrimType_>(result);
+}
+
+/*! \brief Gets the squad control point of a knot from the rotation deltas to its neighbours.
+ *  s_i = exp((d_{i-1} - d_i)/4)*q_i with d_i = q_{i+1} [-] q_i
+ *  \param q             knot q_i
+ *  \param deltaBefore   d_{i-1}
+ *  \param deltaAfter    d_i
+ *  \returns control point
+ */
+template<typename PrimType_>
+RotationQuaternion<PrimType_> getSquadControlPoint(const RotationQuaternion<PrimType_>& q, const Eigen::Matrix<PrimType_, 3, 1>& deltaBefore,
+                                                   const Eigen::Matrix<PrimType_, 3, 1>& deltaAfter) {
+  return q.boxPlus(PrimType_(0.25)*(deltaBefore - deltaAfter));
+}
+
+/*! \brief Spherical quadrangle interpolation between two knots with their squad control points.
+ *  q(t) = slerp(slerp(q0, q1, t), slerp(s0, s1, t), 2*t*(1-t))
+ *  \param q0   knot at t = 0
+ *  \param q1   knot at t = 1
+ *  \param s0   control point of q0
+ *  \param s1   control point of q1
+ *  \param t    interpolation parameter in [0,1]
+ *  \returns interpolated rotation
+ */
+template<typename PrimType_>
+RotationQuaternion<PrimType_> squad(const RotationQuaternion<PrimType_>& q0, const RotationQuaternion<PrimType_>& q1,
+                                    const RotationQuaternion<PrimType_>& s0, const RotationQuaternion<PrimType_>& s1, PrimType_ t) {
+  return slerp(slerp(q0, q1, t), slerp(s0, s1, t), PrimType_(2)*t*(PrimType_(1) - t));
+}
+
+/*! \brief Evaluates a uniform cumulative cubic B-spline on rotations.
+ *  q(u) = exp(B3(u)*d3)*exp(B2(u)*d2)*exp(B1(u)*d1)*q_0 with the deltas d_j = q_j [-] q_{j-1} between the four control points
+ *  and the cumulative basis functions B1 = (5+3u-3u^2+u^3)/6, B2 = (1+3u+3u^2-2u^3)/6, B3 = u^3/6.
+ *  The spline is C2-continuous, but approximates the control points instead of passing through them.
+ *  \param q0       first control point
+ *  \param deltas   deltas [d1 d2 d3] between the control points
+ *  \param u        interpolation parameter in [0,1] between the second and the third control point
+ *  \returns interpolated rotation
+ */
+template<typename PrimType_>
+RotationQuaternion<PrimType_> getCumulativeBSpline(const RotationQuaternion<PrimType_>& q0, const Eigen::Matrix<PrimType_, 3, 3>& deltas, PrimType_ u) {
+  const PrimType_ u2 = u*u;
+  const PrimType_ u3 = u2*u;
+  const PrimType_ b1 = (PrimType_(5) + PrimType_(3)*u - PrimType_(3)*u2 + u3)/PrimType_(6);
+  const PrimType_ b2 = (PrimType_(1) + PrimType_(3)*u + PrimType_(3)*u2 - PrimType_(2)*u3)/PrimType_(6);
+  const PrimType_ b3 = u3/PrimType_(6);
+  return q0.boxPlus(b1*deltas.col(0)).boxPlus(b2*deltas.col(1)).boxPlus(b3*deltas.col(2));
+}
+
+
+/*! \class RotationQuaternionResampler
+ *  \brief Resamples a sorted sequence of timestamped rotations at sorted query times.
+ *
+ *  The deltas d_i = q_{i+1} [-] q_i between consecutive knots and the squad control points are computed once on
+ *  construction and are reused by all interpolation methods. A query is evaluated in the interval of the knots surrounding it, which is found
+ *  by a single merge pass over the sorted query and knot times. Queries outside the knot times are clamped.
+ *  With an executor, every chunk of queries starts its merge pass at the interval found by a binary search.
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationQuaternionResampler {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<PrimType_> Rotation;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> Matrix3X;
+
+  //! interpolation method between two knots
+  enum class Method {
+    //! shortest path with constant angular velocity
+    Slerp,
+    //! normalized linear interpolation of the quaternions
+    Nlerp,
+    //! spherical quadrangle interpolation, C1-continuous through the knots
+    Squad,
+    //! cumulative cubic B-spline with the knots as control points, C2-continuous
+    CumulativeBSpline
+  };
+
+  /*! \brief Constructor precomputing the deltas between the knots.
+   *  \param times       strictly increasing knot times
+   *  \param rotations   knot rotations
+   */
+  RotationQuaternionResampler(const std::vector<Scalar>& times, const std::vector<Rotation>& rotations)
+    : times_(times),
+      knots_(rotations),
+      deltas_(3, std::max(static_cast<int>(rotations.size()) - 1, 0)),
+      controlPoints_(rotations.size()) {
+    KINDR_ASSERT_TRUE(std::runtime_error, times_.size() == knots_.size(), "The number of knot times and knot rotations must be equal.");
+    KINDR_ASSERT_TRUE(std::runtime_error, !knots_.empty(), "At least one knot is required.");
+    for (int i = 0; i < deltas_.cols(); ++i) {
+      KINDR_ASSERT_TRUE(std::runtime_error, times_[i] < times_[i+1], "The knot times must be strictly increasing.");
+      deltas_.col(i) = knots_[i+1].boxMinus(knots_[i]);
+    }
+    for (int i = 0; i < static_cast<int>(knots_.size()); ++i) {
+      controlPoints_[i] = getSquadControlPoint(knots_[i], getDelta(i-1), getDelta(i));
+    }
+  }
+
+  /*! \brief Gets the deltas d_i = q_{i+1} [-] q_i between the knots.
+   *  \returns 3x(N-1) matrix
+   */
+  inline const Matrix3X& getDeltas() const {
+    return deltas_;
+  }
+
+  /*! \brief Resamples the rotation at sorted query times.
+   *  \param times      non-decreasing query times
+   *  \param method     interpolation method
+   *  \param result     rotations at the query times, resized to the number of queries
+   *  \param executor   executor distributing chunks of queries to threads, see SerialExecutor
+   */
+  template<typename Executor_ = SerialExecutor>
+  void resample(const std::vector<Scalar>& times, Method method, RotationQuaternionArray<Scalar>& result, const Executor_& executor = Executor_()) const {
+    result.resize(static_cast<int>(times.size()));
+    executor.parallelFor(0, static_cast<int>(times.size()), GrainSize, [this, &times, method, &result](int begin, int end) {
+      const int numberOfIntervals = static_cast<int>(deltas_.cols());
+      int interval = static_cast<int>(std::upper_bound(times_.begin(), times_.end(), times[begin]) - times_.begin()) - 1;
+      interval = std::min(std::max(interval, 0), std::max(numberOfIntervals - 1, 0));
+      for (int k = begin; k < end; ++k) {
+        KINDR_ASSERT_TRUE_DBG(std::runtime_error, k == 0 || times[k-1] <= times[k], "The query times must be sorted.");
+        if (numberOfIntervals == 0 || times[k] <= times_.front()) {
+          result.set(k, knots_.front());
+          continue;
+        }
+        if (times[k] >= times_.back()) {
+          result.set(k, knots_.back());
+          continue;
+        }
+        while (times_[interval+1] < times[k]) {
+          ++interval;
+        }
+        const Scalar t = (times[k] - times_[interval])/(times_[interval+1] - times_[interval]);
+        result.set(k, interpolate(interval, t, method));
+      }
+    });
+  }
+
+  /*! \brief Interpolates the rotation in an interval between two knots.
+   *  \param interval   index i of the interval [t_i, t_{i+1}]
+   *  \param t          interpolation parameter in [0,1]
+   *  \param method     interpolation method
+   *  \returns rotation
+   */
+  Rotation interpolate(int interval, Scalar t, Method method) const {
+    const Rotation& q0 = knots_[interval];
+    switch (method) {
+      case Method::Slerp:
+        return q0.boxPlus(t*deltas_.col(interval));
+      case Method::Nlerp:
+        return nlerp(q0, knots_[interval+1], t);
+      case Method::Squad:
+        return slerp(q0.boxPlus(t*deltas_.col(interval)), slerp(controlPoints_[interval], controlPoints_[interval+1], t), Scalar(2)*t*(Scalar(1) - t));
+      case Method::CumulativeBSpline:
+      default:
+        return getCumulativeBSpline(getKnot(interval-1), getBSplineDeltas(interval), t);
+    }
+  }
+
+ private:
+  //! delta between the knots i and i+1, zero outside the knots
+  inline Vector3 getDelta(int i) const {
+    return (i < 0 || i >= deltas_.cols()) ? Vector3(Vector3::Zero()) : Vector3(deltas_.col(i));
+  }
+
+  //! knot i clamped to the first and last knot
+  inline const Rotation& getKnot(int i) const {
+    return knots_[std::min(std::max(i, 0), static_cast<int>(knots_.size()) - 1)];
+  }
+
+  inline Eigen::Matrix<Scalar, 3, 3> getBSplineDeltas(int interval) const {
+    Eigen::Matrix<Scalar, 3, 3> deltas;
+    deltas << getDelta(interval-1), getDelta(interval), getDelta(interval+1);
+    return deltas;
+  }
+
+  //! Minimum number of queries of a chunk that is handed to an executor
+  enum { GrainSize = 4096 };
+
+  std::vector<Scalar> times_;
+  std::vector<Rotation> knots_;
+  Matrix3X deltas_;
+  std::vector<Rotation> controlPoints_;
+};
+
+} // namespace kindr
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class RotationQuaternionMap
+ * \brief View of a rotation quaternion stored in external memory.
+ *
+ * The map does not own its coefficients, but reads and writes them in place, e.g. in a message, a shared memory block
+ * or a log buffer. The coefficients are stored in the order x, y, z, w like Eigen::Quaternion and ROS messages,
+ * and may be strided. A map with a const primitive type (e.g. RotationQuaternionMap<const double>) is read-only.
+ * The rotation operations load the four coefficients and forward to RotationQuaternion, eval() returns the loaded rotation.
+ * \tparam PrimType_   Primitive type of the coefficients, optionally const.
+ * \tparam Stride_     Eigen stride between the coefficients.
+ * \ingroup rotations
+ */
+template<typename PrimType_, typename Stride_ = Eigen::InnerStride<1>>
+class RotationQuaternionMap {
+ public:
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef typename std::remove_const<PrimType_>::type Scalar;
+
+  /*! \brief The rotation type that is viewed.
+   */
+  typedef RotationQuaternion<Scalar> Rotation;
+
+  /*! \brief The implementation type.
+   *  The coefficients [x; y; z; w] in the viewed memory.
+   */
+  typedef Eigen::Map<typename std::conditional<std::is_const<PrimType_>::value, const Eigen::Matrix<Scalar, 4, 1>,
+                                               Eigen::Matrix<Scalar, 4, 1>>::type, Eigen::Unaligned, Stride_> Implementation;
+
+  /*! \brief Constructor using a pointer to the x-coefficient.
+   *  \param data     pointer to the coefficients [x, y, z, w]
+   *  \param stride   stride between the coefficients
+   */
+  explicit RotationQuaternionMap(PrimType_* data, const Stride_& stride = Stride_())
+    : map_(data, 4, 1, stride) {
+  }
+
+  /*! \brief Writes a rotation into the viewed memory.
+   *  \param other   rotation with any parameterization
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  RotationQuaternionMap& operator=(const RotationBase<OtherDerived_>& other) {
+    const Rotation rotation(other.derived());
+    map_ << rotation.x(), rotation.y(), rotation.z(), rotation.w();
+    return *this;
+  }
+
+  /*! \brief Copies the coefficients of another map into the viewed memory.
+   *  \param other   other map
+   *  \returns reference
+   */
+  RotationQuaternionMap& operator=(const RotationQuaternionMap& other) {
+    map_ = other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Loads the coefficients into a rotation quaternion.
+   *  \returns rotation quaternion
+   */
+  Rotation eval() const {
+    return Rotation(w(), x(), y(), z());
+  }
+
+  inline Scalar w() const {
+    return map_(3);
+  }
+
+  inline Scalar x() const {
+    return map_(0);
+  }
+
+  inline Scalar y() const {
+    return map_(1);
+  }
+
+  inline Scalar z() const {
+    return map_(2);
+  }
+
+  /*! \brief Norm of the viewed quaternion.
+   *  \returns norm
+   */
+  Scalar norm() const {
+    return map_.norm();
+  }
+
+  /*! \brief Sets the viewed rotation to identity.
+   *  \returns reference
+   */
+  RotationQuaternionMap& setIdentity() {
+    map_ << Scalar(0), Scalar(0), Scalar(0), Scalar(1);
+    return *this;
+  }
+
+  /*! \brief Inverts the viewed rotation in place by conjugating the quaternion.
+   *  \returns reference
+   */
+  RotationQuaternionMap& invert() {
+    map_.template head<3>() = -map_.template head<3>();
+    return *this;
+  }
+
+  /*! \brief Normalizes the viewed quaternion in place.
+   */
+  void fix() {
+    map_ /= map_.norm();
+  }
+
+  /*! \brief Returns the inverse of the viewed rotation.
+   *  \returns inverse rotation
+   */
+  Rotation inverted() const {
+    return Rotation(w(), -x(), -y(), -z());
+  }
+
+  /*! \brief Concatenates the viewed rotation with another rotation.
+   *  \param other   other rotation
+   *  \returns concatenation
+   */
+  template<typename OtherDerived_>
+  Rotation operator*(const RotationBase<OtherDerived_>& other) const {
+    return eval()*Rotation(other.derived());
+  }
+
+  /*! \brief Rotates a vector or a 3xN matrix.
+   *  \param vector   vector
+   *  \returns rotated vector
+   */
+  template<typename Vector_>
+  Vector_ rotate(const Vector_& vector) const {
+    return eval().rotate(vector);
+  }
+
+  /*! \brief Rotates a vector or a 3xN matrix by the inverse rotation.
+   *  \param vector   vector
+   *  \returns rotated vector
+   */
+  template<typename Vector_>
+  Vector_ inverseRotate(const Vector_& vector) const {
+    return eval().inverseRotate(vector);
+  }
+
+  /*! \brief Gets the logarithmic map of the viewed rotation.
+   *  \returns rotation vector
+   */
+  Eigen::Matrix<Scalar, 3, 1> logarithmicMap() const {
+    return eval().logarithmicMap();
+  }
+
+  /*! \brief Applies the box plus operation.
+   *  \param vector   perturbation
+   *  \returns perturbed rotation
+   */
+  Rotation boxPlus(const Eigen::Matrix<Scalar, 3, 1>& vector) const {
+    return eval().boxPlus(vector);
+  }
+
+  /*! \brief Applies the box minus operation.
+   *  \param other   other rotation
+   *  \returns difference
+   */
+  template<typename OtherDerived_>
+  Eigen::Matrix<Scalar, 3, 1> boxMinus(const RotationBase<OtherDerived_>& other) const {
+    return eval().boxMinus(other.derived());
+  }
+
+  /*! \brief Gets the disparity angle to another rotation.
+   *  \param other   other rotation
+   *  \returns disparity angle in [0,pi]
+   */
+  template<typename OtherDerived_>
+  Scalar getDisparityAngle(const RotationBase<OtherDerived_>& other) const {
+    return eval().getDisparityAngle(other.derived());
+  }
+
+  /*! \brief Compares the viewed rotation with another rotation within a tolerance.
+   *  \param other   other rotation
+   *  \param tol     tolerance on the disparity angle
+   *  \returns true if similar
+   */
+  template<typename OtherDerived_>
+  bool isNear(const RotationBase<OtherDerived_>& other, Scalar tol) const {
+    return eval().isNear(other.derived(), tol);
+  }
+
+  /*! \brief Gets the pointer to the viewed x-coefficient.
+   *  \returns pointer
+   */
+  inline PrimType_* data() {
+    return map_.data();
+  }
+
+  /*! \brief Gets the read-only pointer to the viewed x-coefficient.
+   *  \returns pointer
+   */
+  inline const PrimType_* data() const {
+    return map_.data();
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline Implementation& toImplementation() {
+    return map_;
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline const Implementation& toImplementation() const {
+    return map_;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const RotationQuaternionMap& rquat) {
+    out << rquat.eval();
+    return out;
+  }
+
+ private:
+  Implementation map_;
+};
+
+//! \brief View of a quaternion rotation with double primitive type
+typedef RotationQuaternionMap<double> RotationQuaternionMapD;
+//! \brief View of a quaternion rotation with float primitive type
+typedef RotationQuaternionMap<float> RotationQuaternionMapF;
+
+} // namespace kindr
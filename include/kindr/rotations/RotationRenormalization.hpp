@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/RotationQuaternion.hpp"
+#include "kindr/rotations/RotationMatrix.hpp"
+
+namespace kindr {
+
+//! Renormalization of a rotation after a number of compositions, see RenormalizingRotation
+enum class RenormalizationPolicy {
+  //! the rotation is never renormalized and drifts from the rotation group
+  Never,
+  //! the rotation is projected onto the rotation group, i.e. the quaternion is normalized with a sqrt and a division
+  Exact,
+  //! first-order correction q*(3 - |q|^2)/2 without sqrt and division, which keeps a small error bounded
+  FirstOrder
+};
+
+namespace internal {
+
+/*! \class RenormalizationTraits
+ *  \brief Renormalization of a rotation which drifted due to rounding errors.
+ *  Only specialized for the parameterizations with redundant coefficients, i.e. quaternions and rotation matrices.
+ *  (only for advanced users)
+ */
+template<typename Rotation_>
+class RenormalizationTraits {
+ public:
+  // inline static void renormalize(Rotation_& rotation);
+  // inline static void renormalizeFirstOrder(Rotation_& rotation);
+  // inline static typename Rotation_::Scalar getError(const Rotation_& rotation);
+};
+
+template<typename PrimType_>
+class RenormalizationTraits<RotationQuaternion<PrimType_>> {
+ public:
+  inline static void renormalize(RotationQuaternion<PrimType_>& rotation) {
+    rotation.toImplementation().normalize();
+  }
+
+  //! One Newton step towards |q| = 1, which maps |q|^2 = 1 + e to 1 + O(e^2)
+  inline static void renormalizeFirstOrder(RotationQuaternion<PrimType_>& rotation) {
+    Eigen::Quaternion<PrimType_>& q = rotation.toImplementation();
+    q.coeffs() *= (PrimType_(3) - q.squaredNorm())*PrimType_(0.5);
+  }
+
+  //! \returns ||q|^2 - 1|
+  inline static PrimType_ getError(const RotationQuaternion<PrimType_>& rotation) {
+    using std::abs;
+    return abs(rotation.toImplementation().squaredNorm() - PrimType_(1));
+  }
+};
+
+template<typename PrimType_>
+class RenormalizationTraits<RotationMatrix<PrimType_>> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+
+  //! Gram-Schmidt orthonormalization of the first two columns, the third column is their cross product
+  inline static void renormalize(RotationMatrix<PrimType_>& rotation) {
+    Matrix3& R = rotation.toImplementation();
+    R.col(0).normalize();
+    R.col(1) -= R.col(0).dot(R.col(1))*R.col(0);
+    R.col(1).normalize();
+    R.col(2) = R.col(0).cross(R.col(1));
+  }
+
+  //! One Newton step of the polar decomposition R*(3*I - R^T*R)/2 without sqrt and division
+  inline static void renormalizeFirstOrder(RotationMatrix<PrimType_>& rotation) {
+    Matrix3& R = rotation.toImplementation();
+    const Matrix3 correction = PrimType_(1.5)*Matrix3::Identity() - PrimType_(0.5)*R.transpose()*R;
+    R = (R*correction).eval();
+  }
+
+  //! \returns ||R^T*R - I||_max
+  inline static PrimType_ getError(const RotationMatrix<PrimType_>& rotation) {
+    const Matrix3& R = rotation.toImplementation();
+    return (R.transpose()*R - Matrix3::Identity()).cwiseAbs().maxCoeff();
+  }
+};
+
+} // namespace internal
+
+
+/*! \class RenormalizingRotation
+ *  \brief Composes a long chain of rotations and renormalizes the result according to a policy.
+ *
+ *  The composition of quaternions and rotation matrices never renormalizes, such that the rounding errors accumulate
+ *  over long chains, e.g. in the integration of angular velocities. This class counts the compositions and applies
+ *  the renormalization of the policy every period compositions:
+ *   - Never: no correction, the error grows linearly with the number of compositions.
+ *   - Exact: normalization of the quaternion (sqrt and division) or Gram-Schmidt orthonormalization of the matrix.
+ *   - FirstOrder: one Newton step towards the rotation group with multiplications only, which squares a small error.
+ *     Applied after every composition, it keeps the error at the rounding level.
+ *  See benchmark/rotations/RenormalizationBenchmark.cpp for the trade-off between the accuracy and the throughput.
+ * \tparam Rotation_ RotationQuaternion or RotationMatrix
+ * \ingroup rotations
+ */
+template<typename Rotation_>
+class RenormalizingRotation {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+
+  /*! \brief Constructor.
+   *  \param rotation   initial rotation
+   *  \param policy     renormalization policy
+   *  \param period     number of compositions after which the rotation is renormalized
+   */
+  explicit RenormalizingRotation(const Rotation_& rotation = Rotation_(),
+                                 RenormalizationPolicy policy = RenormalizationPolicy::FirstOrder, int period = 1)
+    : rotation_(rotation),
+      policy_(policy),
+      period_(period),
+      count_(0) {
+    KINDR_ASSERT_TRUE(std::runtime_error, period > 0, "The renormalization period must be positive.");
+  }
+
+  /*! \brief Composes the rotation with another one from the right, i.e. r = r*other.
+   *  \param other   rotation
+   *  \returns reference
+   */
+  inline RenormalizingRotation& operator *=(const Rotation_& other) {
+    rotation_ = rotation_*other;
+    countComposition();
+    return *this;
+  }
+
+  /*! \brief Composes the rotation with another one from the left, i.e. r = other*r.
+   *  \param other   rotation
+   *  \returns reference
+   */
+  inline RenormalizingRotation& preMultiply(const Rotation_& other) {
+    rotation_ = other*rotation_;
+    countComposition();
+    return *this;
+  }
+
+  /*! \brief Renormalizes the rotation exactly and restarts the period, independently of the policy.
+   */
+  inline void renormalize() {
+    internal::RenormalizationTraits<Rotation_>::renormalize(rotation_);
+    count_ = 0;
+  }
+
+  //! \returns the rotation
+  inline const Rotation_& getRotation() const {
+    return rotation_;
+  }
+
+  //! \returns the distance of the coefficients from the rotation group, ||q|^2 - 1| or ||R^T*R - I||_max
+  inline Scalar getNormalizationError() const {
+    return internal::RenormalizationTraits<Rotation_>::getError(rotation_);
+  }
+
+  //! \returns the policy
+  inline RenormalizationPolicy getPolicy() const {
+    return policy_;
+  }
+
+  //! \returns the number of compositions between two renormalizations
+  inline int getPeriod() const {
+    return period_;
+  }
+
+ protected:
+  inline void countComposition() {
+    if (policy_ == RenormalizationPolicy::Never || ++count_ < period_) {
+      return;
+    }
+    count_ = 0;
+    if (policy_ == RenormalizationPolicy::Exact) {
+      internal::RenormalizationTraits<Rotation_>::renormalize(rotation_);
+    }
+    else {
+      internal::RenormalizationTraits<Rotation_>::renormalizeFirstOrder(rotation_);
+    }
+  }
+
+  Rotation_ rotation_;
+  RenormalizationPolicy policy_;
+  int period_;
+  int count_;
+};
+
+} // namespace kindr
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <random>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationQuaternionArray.hpp"
+
+namespace kindr {
+
+/*! \class RotationSampler
+ *  \brief Draws random rotations from the uniform distribution on SO(3) and from Gaussians on the manifold.
+ *
+ *  Uniform rotations are sampled with the method of Shoemake (Uniform Random Rotations, Graphics Gems III, 1992),
+ *  which needs three uniform numbers per rotation. Gaussian rotations are mean [+] v with v ~ N(0, diag(sigma^2)),
+ *  i.e. exp(v)*mean with the perturbation in the global frame as in boxPlus.
+ *
+ *  The random number engine is owned by the sampler and can be any standard engine, e.g. std::minstd_rand for speed.
+ *  A sampler is not thread-safe. For parallel sampling, each thread creates its own sampler with the same seed and
+ *  a different stream index and fills a disjoint range [begin, end) of the batch.
+ *
+ *  \ingroup rotations
+ */
+template<typename PrimType_, typename Engine_ = std::mt19937>
+class RotationSampler {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Engine_ Engine;
+  typedef RotationQuaternion<PrimType_> Rotation;
+  typedef RotationQuaternionArray<PrimType_> RotationArray;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  /*! \brief Constructor seeding the engine with a seed and a stream index.
+   *  \param seed     seed shared by all streams
+   *  \param stream   index of the stream, e.g. the thread index
+   */
+  explicit RotationSampler(unsigned int seed = 0u, unsigned int stream = 0u)
+    : uniform_(PrimType_(0), PrimType_(1)),
+      normal_(PrimType_(0), PrimType_(1)) {
+    std::seed_seq sequence{seed, stream};
+    engine_.seed(sequence);
+  }
+
+  /*! \brief Constructor using a caller-provided engine.
+   *  \param engine   seeded random number engine
+   */
+  explicit RotationSampler(const Engine_& engine)
+    : engine_(engine),
+      uniform_(PrimType_(0), PrimType_(1)),
+      normal_(PrimType_(0), PrimType_(1)) {
+  }
+
+  /*! \brief Gets the random number engine.
+   *  \returns reference to the engine
+   */
+  inline Engine_& getEngine() {
+    return engine_;
+  }
+
+  /*! \brief Draws a rotation from the uniform distribution on SO(3).
+   *  \returns random rotation
+   */
+  Rotation sampleUniform() {
+    const PrimType_ u1 = uniform_(engine_);
+    const PrimType_ angle2 = PrimType_(2.0*M_PI)*uniform_(engine_);
+    const PrimType_ angle3 = PrimType_(2.0*M_PI)*uniform_(engine_);
+    const PrimType_ r1 = std::sqrt(PrimType_(1) - u1);
+    const PrimType_ r2 = std::sqrt(u1);
+    return Rotation(r2*std::cos(angle3), r1*std::sin(angle2), r1*std::cos(angle2), r2*std::sin(angle3));
+  }
+
+  /*! \brief Fills the rotations [begin, end) of a batch with uniform random rotations.
+   *  \param rotations   batch
+   *  \param begin       first index
+   *  \param end         index past the last rotation, -1 for the size of the batch
+   */
+  void sampleUniform(RotationArray& rotations, int begin = 0, int end = -1) {
+    end = checkRange(rotations, begin, end);
+    for (int i = begin; i < end; ++i) {
+      rotations.set(i, sampleUniform());
+    }
+  }
+
+  /*! \brief Draws a perturbation vector v ~ N(0, diag(sigma^2)).
+   *  \param standardDeviations   standard deviations sigma of the three components
+   *  \returns random rotation vector
+   */
+  Vector3 samplePerturbation(const Vector3& standardDeviations) {
+    const PrimType_ vx = normal_(engine_);
+    const PrimType_ vy = normal_(engine_);
+    const PrimType_ vz = normal_(engine_);
+    return Vector3(vx, vy, vz).cwiseProduct(standardDeviations);
+  }
+
+  /*! \brief Draws a rotation from a Gaussian on the manifold.
+   *  \param mean                 mean rotation
+   *  \param standardDeviations   standard deviations of the perturbation
+   *  \returns mean [+] v with v ~ N(0, diag(sigma^2))
+   */
+  template<typename OtherDerived_>
+  Rotation sampleGaussian(const RotationBase<OtherDerived_>& mean, const Vector3& standardDeviations) {
+    return Rotation(mean.derived()).boxPlus(samplePerturbation(standardDeviations));
+  }
+
+  /*! \brief Fills the rotations [begin, end) of a batch with draws from a Gaussian on the manifold.
+   *  \param mean                 mean rotation
+   *  \param standardDeviations   standard deviations of the perturbation
+   *  \param rotations            batch
+   *  \param begin                first index
+   *  \param end                  index past the last rotation, -1 for the size of the batch
+   */
+  template<typename OtherDerived_>
+  void sampleGaussian(const RotationBase<OtherDerived_>& mean, const Vector3& standardDeviations, RotationArray& rotations, int begin = 0, int end = -1) {
+    end = checkRange(rotations, begin, end);
+    const Rotation meanQuaternion(mean.derived());
+    for (int i = begin; i < end; ++i) {
+      rotations.set(i, meanQuaternion.boxPlus(samplePerturbation(standardDeviations)));
+    }
+  }
+
+  /*! \brief Perturbs the rotations [begin, end) of a batch in place, e.g. for the diffusion step of a particle filter.
+   *  \param standardDeviations   standard deviations of the perturbation
+   *  \param rotations            batch, rotations[i] <- rotations[i] [+] v_i
+   *  \param begin                first index
+   *  \param end                  index past the last rotation, -1 for the size of the batch
+   */
+  void perturb(const Vector3& standardDeviations, RotationArray& rotations, int begin = 0, int end = -1) {
+    end = checkRange(rotations, begin, end);
+    for (int i = begin; i < end; ++i) {
+      rotations.set(i, rotations[i].boxPlus(samplePerturbation(standardDeviations)));
+    }
+  }
+
+ private:
+  static int checkRange(const RotationArray& rotations, int begin, int end) {
+    if (end < 0) {
+      end = rotations.size();
+    }
+    KINDR_ASSERT_TRUE(std::runtime_error, 0 <= begin && begin <= end && end <= rotations.size(), "The range [" << begin << ", " << end << ") exceeds the batch of size " << rotations.size() << ".");
+    return end;
+  }
+
+  Engine_ engine_;
+  std::uniform_real_distribution<PrimType_> uniform_;
+  std::normal_distribution<PrimType_> normal_;
+};
+
+} // namespace kindr
@@ -109,7 +109,7 @@ class RotationVector : public RotationBase<RotationVector<PrimType_>> {
    */
   template<typename OtherDerived_>
   inline explicit RotationVector(const RotationBase<OtherDerived_>& other)
-    : vector_(internal::ConversionTraits<RotationVector, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    : vector_(internal::convertRotation<RotationVector, OtherDerived_>(other.derived()).toImplementation()) {
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -118,7 +118,7 @@ class RotationVector : public RotationBase<RotationVector<PrimType_>> {
    */
   template<typename OtherDerived_>
   RotationVector& operator =(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<RotationVector, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<RotationVector, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -128,7 +128,7 @@ class RotationVector : public RotationBase<RotationVector<PrimType_>> {
    */
   template<typename OtherDerived_>
   RotationVector& operator ()(const RotationBase<OtherDerived_>& other) {
-    this->toImplementation() = internal::ConversionTraits<RotationVector, OtherDerived_>::convert(other.derived()).toImplementation();
+    this->toImplementation() = internal::convertRotation<RotationVector, OtherDerived_>(other.derived()).toImplementation();
     return *this;
   }
 
@@ -235,6 +235,10 @@ class RotationVector : public RotationBase<RotationVector<PrimType_>> {
    *  \returns copy of the rotation vector which is unique
    */
   RotationVector getUnique() const {
+    KINDR_INSTRUMENT(Unique);
+    if (vector_.squaredNorm() < PrimType_(M_PI*M_PI)) {
+      return *this; // already unique, avoids the conversion to angle-axis
+    }
     AngleAxis<PrimType_> angleAxis(*this);
     RotationVector rotationVector(angleAxis.getUnique());
     return rotationVector;
@@ -324,7 +328,7 @@ class ConversionTraits<RotationVector<DestPrimType_>, RotationQuaternion<SourceP
     const DestPrimType_ imaginaryVectorNormSquared = DestPrimType_(1.0)-q.real()*q.real();
 
     if (imaginaryVectorNormSquared < internal::NumTraits<SourcePrimType_>::dummy_precision()) {
-      if (q.real() > 0.0) {
+      if (q.real() > SourcePrimType_(0)) {
         return RotationVector<DestPrimType_>(DestPrimType_(2.0)*q.imaginary().template cast<DestPrimType_>());
       }
       else {
@@ -359,10 +363,72 @@ class ConversionTraits<RotationVector<DestPrimType_>, RotationMatrix<SourcePrimT
  * Multiplication Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Map Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class MapTraits<RotationBase<RotationVector<PrimType_>>> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  inline static RotationVector<PrimType_> set_exponential_map(const Vector3& vector) {
+    return RotationVector<PrimType_>(vector);
+  }
+
+  /*! \brief Gets the unique rotation vector, which is the rotation vector itself if its norm is below pi.
+   */
+  inline static Vector3 get_logarithmic_map(const RotationVector<PrimType_>& rotation) {
+    return rotation.getUnique().toImplementation();
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Rotation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class RotationTraits<RotationBase<RotationVector<PrimType_>>> : public DirectRotationTraits<RotationVector<PrimType_>, 2> {
+ public:
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  /*! \brief Rotates a vector with Rodrigues' formula without computing the rotation matrix.
+   *  v' = v + sin(a)/a*(r x v) + (1-cos(a))/a^2*(r x (r x v)) with a = |r|
+   */
+  inline static Vector3 rotateVector(const RotationVector<PrimType_>& rotation, const Vector3& vector) {
+    PrimType_ sinc;
+    PrimType_ cosc;
+    getRodriguesCoefficients(rotation, sinc, cosc);
+    const Vector3 cross = rotation.toImplementation().cross(vector);
+    return vector + sinc*cross + cosc*rotation.toImplementation().cross(cross);
+  }
+
+  /*! \brief Rotates a vector by the negative rotation vector without computing the inverse rotation.
+   *  v' = v - sin(a)/a*(r x v) + (1-cos(a))/a^2*(r x (r x v)) with a = |r|
+   */
+  inline static Vector3 inverseRotateVector(const RotationVector<PrimType_>& rotation, const Vector3& vector) {
+    PrimType_ sinc;
+    PrimType_ cosc;
+    getRodriguesCoefficients(rotation, sinc, cosc);
+    const Vector3 cross = rotation.toImplementation().cross(vector);
+    return vector - sinc*cross + cosc*rotation.toImplementation().cross(cross);
+  }
 
+ private:
+  //! Computes sin(a)/a and (1-cos(a))/a^2 with a Taylor expansion for small angles
+  inline static void getRodriguesCoefficients(const RotationVector<PrimType_>& rotation, PrimType_& sinc, PrimType_& cosc) {
+    using std::cos;
+    using std::sin;
+    const PrimType_ angle = rotation.toImplementation().norm();
+    if (isLessThenEpsilons4thRoot(angle)) {
+      const PrimType_ angleSquared = rotation.toImplementation().squaredNorm();
+      sinc = PrimType_(1.0) - angleSquared/PrimType_(6.0);
+      cosc = PrimType_(0.5) - angleSquared/PrimType_(24.0);
+    }
+    else {
+      sinc = sin(angle)/angle;
+      cosc = (PrimType_(1.0) - cos(angle))/(angle*angle);
+    }
+  }
+};
 
 } // namespace internal
 } // namespace kindr
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRight_ HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <limits>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/math/ConstexprMath.hpp"
+#include "kindr/math/Trigonometry.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+namespace internal {
+
+/*! \class TrigonometricConversionTraits
+ *  \brief Conversions between rotations which evaluate the trigonometric functions with a policy, e.g. FastTrigonometry.
+ *
+ *  Specialized for the conversions from and to Euler angles with z-y-x convention, angle-axis and rotation vectors,
+ *  whose cost is dominated by sin, cos and atan2. The case distinctions of the ConversionTraits are replaced by selects
+ *  and the thresholds are compile-time constants, such that the conversions neither branch on the data nor initialize
+ *  function-local statics. The other pairs are converted with the ConversionTraits.
+ *  (only for advanced users)
+ */
+template<typename Dest_, typename Source_, typename Trigonometry_>
+class TrigonometricConversionTraits {
+ public:
+  inline static Dest_ convert(const Source_& source) {
+    return convertRotation<Dest_, Source_>(source);
+  }
+};
+
+template<typename PrimType_>
+struct TrigonometricConversionConstants {
+  //! sqrt(epsilon), see getGimbalLockThreshold()
+  static constexpr PrimType_ GimbalLockThreshold = constexprSqrt(std::numeric_limits<PrimType_>::epsilon());
+  //! epsilon^(1/4), see isLessThenEpsilons4thRoot()
+  static constexpr PrimType_ Epsilon4thRoot = constexprSqrt(constexprSqrt(std::numeric_limits<PrimType_>::epsilon()));
+};
+
+template<typename PrimType_>
+constexpr PrimType_ TrigonometricConversionConstants<PrimType_>::GimbalLockThreshold;
+
+template<typename PrimType_>
+constexpr PrimType_ TrigonometricConversionConstants<PrimType_>::Epsilon4thRoot;
+
+/*! \brief Gets the Euler angles [yaw; pitch; roll] with z-y-x convention from the elements of a rotation matrix,
+ *  see getEulerAnglesZyxFromRotationMatrixElements().
+ */
+template<typename Trigonometry_, typename PrimType_>
+inline Eigen::Matrix<PrimType_, 3, 1> getEulerAnglesZyxFromRotationMatrixElements(PrimType_ r00, PrimType_ r01, PrimType_ r10, PrimType_ r11,
+                                                                                  PrimType_ r20, PrimType_ r21, PrimType_ r22) {
+  using std::sqrt;
+  const PrimType_ cosPitch = sqrt(r00*r00 + r10*r10);
+  const bool gimbalLock = cosPitch < TrigonometricConversionConstants<PrimType_>::GimbalLockThreshold;
+  return Eigen::Matrix<PrimType_, 3, 1>(Trigonometry_::atan2(gimbalLock ? -r01 : r10, gimbalLock ? r11 : r00),
+                                        Trigonometry_::atan2(-r20, cosPitch),
+                                        gimbalLock ? PrimType_(0) : Trigonometry_::atan2(r21, r22));
+}
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<RotationQuaternion<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static RotationQuaternion<DestPrimType_> convert(const EulerAnglesZyx<SourcePrimType_>& zyx) {
+    // q = qz*qy*qx with the half angles
+    const DestPrimType_ half = DestPrimType_(0.5);
+    DestPrimType_ sz, cz, sy, cy, sx, cx;
+    Trigonometry_::sincos(half*static_cast<DestPrimType_>(zyx.yaw()), sz, cz);
+    Trigonometry_::sincos(half*static_cast<DestPrimType_>(zyx.pitch()), sy, cy);
+    Trigonometry_::sincos(half*static_cast<DestPrimType_>(zyx.roll()), sx, cx);
+    return RotationQuaternion<DestPrimType_>(cz*cy*cx + sz*sy*sx, cz*cy*sx - sz*sy*cx, cz*sy*cx + sz*cy*sx, sz*cy*cx - cz*sy*sx);
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<RotationMatrix<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static RotationMatrix<DestPrimType_> convert(const EulerAnglesZyx<SourcePrimType_>& zyx) {
+    // R = Rz*Ry*Rx
+    DestPrimType_ sz, cz, sy, cy, sx, cx;
+    Trigonometry_::sincos(static_cast<DestPrimType_>(zyx.yaw()), sz, cz);
+    Trigonometry_::sincos(static_cast<DestPrimType_>(zyx.pitch()), sy, cy);
+    Trigonometry_::sincos(static_cast<DestPrimType_>(zyx.roll()), sx, cx);
+    return RotationMatrix<DestPrimType_>(cz*cy, cz*sy*sx - sz*cx, cz*sy*cx + sz*sx,
+                                         sz*cy, sz*sy*sx + cz*cx, sz*sy*cx - cz*sx,
+                                         -sy,   cy*sx,            cy*cx);
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<EulerAnglesZyx<DestPrimType_>, RotationQuaternion<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static EulerAnglesZyx<DestPrimType_> convert(const RotationQuaternion<SourcePrimType_>& q) {
+    // only the required elements of the rotation matrix are computed, with the homogeneous formulas of the diagonal,
+    // i.e. the matrix is scaled by |q|^2 instead of losing its orthogonality if the quaternion is not exactly unit,
+    // as after the approximate sine and cosine, and the angles do not depend on the scale
+    const DestPrimType_ two = DestPrimType_(2.0);
+    const DestPrimType_ w = static_cast<DestPrimType_>(q.w()), x = static_cast<DestPrimType_>(q.x());
+    const DestPrimType_ y = static_cast<DestPrimType_>(q.y()), z = static_cast<DestPrimType_>(q.z());
+    const DestPrimType_ ww = w*w, xx = x*x, yy = y*y, zz = z*z;
+    return EulerAnglesZyx<DestPrimType_>(getEulerAnglesZyxFromRotationMatrixElements<Trigonometry_, DestPrimType_>(
+        ww + xx - yy - zz, two*(x*y - w*z),
+        two*(x*y + w*z), ww - xx + yy - zz,
+        two*(x*z - w*y), two*(y*z + w*x), ww - xx - yy + zz));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<EulerAnglesZyx<DestPrimType_>, RotationMatrix<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static EulerAnglesZyx<DestPrimType_> convert(const RotationMatrix<SourcePrimType_>& R) {
+    const Eigen::Matrix<DestPrimType_, 3, 3> m = R.toImplementation().template cast<DestPrimType_>();
+    return EulerAnglesZyx<DestPrimType_>(getEulerAnglesZyxFromRotationMatrixElements<Trigonometry_, DestPrimType_>(
+        m(0,0), m(0,1), m(1,0), m(1,1), m(2,0), m(2,1), m(2,2)));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<RotationQuaternion<DestPrimType_>, AngleAxis<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static RotationQuaternion<DestPrimType_> convert(const AngleAxis<SourcePrimType_>& aa) {
+    DestPrimType_ sine, cosine;
+    Trigonometry_::sincos(DestPrimType_(0.5)*static_cast<DestPrimType_>(aa.angle()), sine, cosine);
+    return RotationQuaternion<DestPrimType_>(cosine, sine*aa.axis().template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<RotationQuaternion<DestPrimType_>, RotationVector<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static RotationQuaternion<DestPrimType_> convert(const RotationVector<SourcePrimType_>& rotationVector) {
+    // na is sin(theta/2)/theta, the series are used for small angles
+    const Eigen::Matrix<DestPrimType_, 3, 1> vector = rotationVector.toImplementation().template cast<DestPrimType_>();
+    const DestPrimType_ thetaSquared = vector.squaredNorm();
+    const DestPrimType_ theta = std::sqrt(thetaSquared);
+    const bool small = theta < TrigonometricConversionConstants<DestPrimType_>::Epsilon4thRoot;
+    DestPrimType_ sine, cosine;
+    Trigonometry_::sincos(DestPrimType_(0.5)*theta, sine, cosine);
+    const DestPrimType_ na = small ? DestPrimType_(0.5) - thetaSquared*DestPrimType_(1.0/48.0) : sine/(small ? DestPrimType_(1) : theta);
+    const DestPrimType_ ct = small ? DestPrimType_(1) - thetaSquared*DestPrimType_(0.125) : cosine;
+    return RotationQuaternion<DestPrimType_>(ct, na*vector);
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<AngleAxis<DestPrimType_>, RotationQuaternion<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static AngleAxis<DestPrimType_> convert(const RotationQuaternion<SourcePrimType_>& q) {
+    // as Eigen::AngleAxis, the angle is in [0, pi] and the axis is the x-axis for the identity
+    using std::abs;
+    const Eigen::Matrix<DestPrimType_, 3, 1> imaginary = q.imaginary().template cast<DestPrimType_>();
+    const DestPrimType_ w = static_cast<DestPrimType_>(q.real());
+    const DestPrimType_ norm = imaginary.norm();
+    const bool identity = !(norm > DestPrimType_(0));
+    const DestPrimType_ factor = (w < DestPrimType_(0) ? DestPrimType_(-1) : DestPrimType_(1))/(identity ? DestPrimType_(1) : norm);
+    return AngleAxis<DestPrimType_>(DestPrimType_(2)*Trigonometry_::atan2(norm, abs(w)),
+                                    identity ? Eigen::Matrix<DestPrimType_, 3, 1>::UnitX().eval() : (factor*imaginary).eval());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<RotationVector<DestPrimType_>, RotationQuaternion<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static RotationVector<DestPrimType_> convert(const RotationQuaternion<SourcePrimType_>& q) {
+    // 2*atan2(|v|, w)/|v|*v, which tends to 2*v for small imaginary parts
+    const Eigen::Matrix<DestPrimType_, 3, 1> imaginary = q.imaginary().template cast<DestPrimType_>();
+    const DestPrimType_ w = static_cast<DestPrimType_>(q.real());
+    const bool small = DestPrimType_(1) - w*w < Eigen::NumTraits<DestPrimType_>::dummy_precision();
+    const DestPrimType_ norm = imaginary.norm();
+    const DestPrimType_ factor = small ? (w > DestPrimType_(0) ? DestPrimType_(2) : DestPrimType_(-2))
+                                       : DestPrimType_(2)*Trigonometry_::atan2(norm, w)/(small ? DestPrimType_(1) : norm);
+    return RotationVector<DestPrimType_>(factor*imaginary);
+  }
+};
+
+/*! \brief Conversion through a rotation quaternion with the policy in both steps.
+ */
+template<typename Dest_, typename Source_, typename Trigonometry_>
+class TrigonometricConversionThroughQuaternion {
+ public:
+  inline static Dest_ convert(const Source_& source) {
+    typedef RotationQuaternion<typename Dest_::Scalar> Quaternion;
+    return TrigonometricConversionTraits<Dest_, Quaternion, Trigonometry_>::convert(
+        TrigonometricConversionTraits<Quaternion, Source_, Trigonometry_>::convert(source));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<EulerAnglesZyx<DestPrimType_>, AngleAxis<SourcePrimType_>, Trigonometry_>
+    : public TrigonometricConversionThroughQuaternion<EulerAnglesZyx<DestPrimType_>, AngleAxis<SourcePrimType_>, Trigonometry_> {};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<EulerAnglesZyx<DestPrimType_>, RotationVector<SourcePrimType_>, Trigonometry_>
+    : public TrigonometricConversionThroughQuaternion<EulerAnglesZyx<DestPrimType_>, RotationVector<SourcePrimType_>, Trigonometry_> {};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<AngleAxis<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>, Trigonometry_>
+    : public TrigonometricConversionThroughQuaternion<AngleAxis<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>, Trigonometry_> {};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<RotationVector<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>, Trigonometry_>
+    : public TrigonometricConversionThroughQuaternion<RotationVector<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>, Trigonometry_> {};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<RotationMatrix<DestPrimType_>, AngleAxis<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static RotationMatrix<DestPrimType_> convert(const AngleAxis<SourcePrimType_>& aa) {
+    return RotationMatrix<DestPrimType_>(TrigonometricConversionTraits<RotationQuaternion<DestPrimType_>, AngleAxis<SourcePrimType_>, Trigonometry_>::convert(aa));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, typename Trigonometry_>
+class TrigonometricConversionTraits<RotationMatrix<DestPrimType_>, RotationVector<SourcePrimType_>, Trigonometry_> {
+ public:
+  inline static RotationMatrix<DestPrimType_> convert(const RotationVector<SourcePrimType_>& rotationVector) {
+    return RotationMatrix<DestPrimType_>(TrigonometricConversionTraits<RotationQuaternion<DestPrimType_>, RotationVector<SourcePrimType_>, Trigonometry_>::convert(rotationVector));
+  }
+};
+
+template<typename Dest_, typename Trigonometry_, typename Source_>
+inline Dest_ convertRotationWithTrigonometry(const Source_& source, std::true_type /*isStandard*/) {
+  return convertRotation<Dest_, Source_>(source);
+}
+
+template<typename Dest_, typename Trigonometry_, typename Source_>
+inline Dest_ convertRotationWithTrigonometry(const Source_& source, std::false_type /*isStandard*/) {
+  KINDR_INSTRUMENT(Conversion);
+  return TrigonometricConversionTraits<Dest_, Source_, Trigonometry_>::convert(source);
+}
+
+} // namespace internal
+
+
+/*! \brief Converts a rotation with a policy for the trigonometric functions.
+ *
+ *  With the default StandardTrigonometry, the result is the same as of the constructors of the rotations. With
+ *  FastTrigonometry, the conversions from and to Euler angles with z-y-x convention, angle-axis and rotation vectors
+ *  use polynomial approximations with the error bounds documented there, see internal::TrigonometricConversionTraits.
+ *  For example, on a microcontroller:
+ *  \code{cpp}
+ *  const kindr::RotationQuaternionF orientation = kindr::convertRotation<kindr::RotationQuaternionF, kindr::FastTrigonometry>(eulerAnglesZyx);
+ *  \endcode
+ *  \tparam Dest_           parameterization of the result
+ *  \tparam Trigonometry_   StandardTrigonometry, FastTrigonometry or a type with the same static functions
+ *  \param source           rotation
+ *  \returns the converted rotation
+ */
+template<typename Dest_, typename Trigonometry_ = StandardTrigonometry, typename Source_>
+inline Dest_ convertRotation(const RotationBase<Source_>& source) {
+  return internal::convertRotationWithTrigonometry<Dest_, Trigonometry_, Source_>(source.derived(), std::is_same<Trigonometry_, StandardTrigonometry>());
+}
+
+} // namespace kindr
@@ -0,0 +1,723 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <Eigen/Core>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/phys_quant/Wrench.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Twist.hpp"
+#include "kindr/rotations/CompactRotations.hpp"
+#include "kindr/rotations/RotationQuaternionMap.hpp"
+#include "kindr/vectors/VectorMap.hpp"
+
+namespace kindr {
+
+/*! \brief Binary log format of timestamped poses, twists and wrenches.
+ *
+ * A log starts with a 16 byte header, followed by records of a fixed layout. Each record has a 16 byte header
+ * (type, quaternion encoding, channel, payload size, timestamp) and a payload of little-endian doubles:
+ *  - pose:   position [x y z], quaternion [x y z w] (56 bytes), or position and a packed quaternion (32 bytes)
+ *  - twist:  linear velocity [x y z], local angular velocity [x y z] (48 bytes)
+ *  - wrench: force [x y z], torque [x y z] (48 bytes)
+ * All payloads are multiples of 8 bytes, so doubles stay aligned in a memory mapped log.
+ */
+namespace binary_log {
+
+//! magic bytes at the start of a log
+static constexpr char Magic[4] = {'K', 'N', 'D', 'R'};
+//! version of the format written by BinaryLogWriter
+static constexpr std::uint16_t Version = 1;
+
+//! type of a record
+enum class RecordType : std::uint8_t {
+  Pose = 1,
+  Twist = 2,
+  Wrench = 3
+};
+
+//! encoding of the quaternion of a pose record
+enum class QuaternionEncoding : std::uint8_t {
+  //! four doubles [x y z w], the rotation can be viewed without a copy
+  Double = 0,
+  //! smallest three components with 20 bits each and the index of the largest component in 64 bits, ~1e-6 accuracy,
+  //! see CompactRotationQuaternion
+  SmallestThree64 = 1
+};
+
+//! header at the start of a log
+struct FileHeader {
+  char magic[4];
+  std::uint16_t version;
+  std::uint16_t endianness;
+  std::uint32_t reserved[2];
+};
+static_assert(sizeof(FileHeader) == 16, "binary_log::FileHeader must have 16 bytes");
+
+//! header of a record
+struct RecordHeader {
+  RecordType type;
+  QuaternionEncoding encoding;
+  std::uint16_t channel;
+  std::uint32_t payloadSize;
+  double timestamp;
+};
+static_assert(sizeof(RecordHeader) == 16, "binary_log::RecordHeader must have 16 bytes");
+
+//! value of FileHeader::endianness as written by a little-endian host
+static constexpr std::uint16_t LittleEndianMarker = 0x0102;
+
+/*! \brief Gets the size of the payload of a record.
+ *  \returns the size in bytes, or 0 if the type or the quaternion encoding is unknown
+ */
+inline std::uint32_t getPayloadSize(RecordType type, QuaternionEncoding encoding) {
+  switch (type) {
+    case RecordType::Pose:
+      if (encoding == QuaternionEncoding::Double) {
+        return 56u;
+      }
+      return (encoding == QuaternionEncoding::SmallestThree64) ? 32u : 0u;
+    case RecordType::Twist:
+    case RecordType::Wrench:
+      return 48u;
+    default:
+      return 0u;
+  }
+}
+
+/*! \brief Packs a unit quaternion [x y z w] into 64 bits with the code of CompactRotationQuaternion<20>.
+ */
+inline std::uint64_t packSmallestThree(const Eigen::Matrix<double, 4, 1>& xyzw) {
+  return CompactRotationQuaternion<20>::encode(xyzw(3), xyzw(0), xyzw(1), xyzw(2));
+}
+
+/*! \brief Unpacks a unit quaternion [x y z w] packed by packSmallestThree().
+ */
+inline Eigen::Matrix<double, 4, 1> unpackSmallestThree(std::uint64_t packed) {
+  double wxyz[4];
+  CompactRotationQuaternion<20>::decode(packed, wxyz);
+  return Eigen::Matrix<double, 4, 1>(wxyz[1], wxyz[2], wxyz[3], wxyz[0]);
+}
+
+/*! \brief Hints the operating system to read a range of a memory mapped log ahead, e.g. before a window is processed.
+ *  This is a no-op on other platforms and for memory which is not mapped from a file.
+ *  \param begin   first byte of the range
+ *  \param end     end of the range
+ */
+inline void prefetch(const char* begin, const char* end) {
+#if defined(__unix__) || defined(__APPLE__)
+  if (end <= begin) {
+    return;
+  }
+  static const std::uintptr_t PageSize = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+  const std::uintptr_t alignedBegin = reinterpret_cast<std::uintptr_t>(begin) & ~(PageSize - 1u);
+  ::madvise(reinterpret_cast<void*>(alignedBegin), reinterpret_cast<std::uintptr_t>(end) - alignedBegin, MADV_WILLNEED);
+#endif
+}
+
+} // namespace binary_log
+
+
+/*! \class BinaryLogWriter
+ * \brief Streams timestamped poses, twists and wrenches in the binary log format to an output stream.
+ *
+ * The file header is written on construction. The stream should be opened in binary mode.
+ */
+class BinaryLogWriter {
+ public:
+  /*! \brief Constructor writing the file header.
+   *  \param stream   output stream in binary mode
+   */
+  explicit BinaryLogWriter(std::ostream& stream)
+    : stream_(stream) {
+    KINDR_ASSERT_TRUE(std::runtime_error, isLittleEndian(), "The binary log format requires a little-endian host.");
+    binary_log::FileHeader header;
+    std::memcpy(header.magic, binary_log::Magic, sizeof(header.magic));
+    header.version = binary_log::Version;
+    header.endianness = binary_log::LittleEndianMarker;
+    header.reserved[0] = 0;
+    header.reserved[1] = 0;
+    stream_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+
+  /*! \brief Writes a pose.
+   *  \param channel     channel of the record
+   *  \param timestamp   timestamp of the record
+   *  \param pose        pose
+   *  \param encoding    encoding of the quaternion
+   */
+  void write(std::uint16_t channel, double timestamp, const HomTransformQuatD& pose,
+             binary_log::QuaternionEncoding encoding = binary_log::QuaternionEncoding::Double) {
+    const RotationQuaternionD& rotation = pose.getRotation();
+    const Eigen::Matrix<double, 4, 1> xyzw(rotation.x(), rotation.y(), rotation.z(), rotation.w());
+    if (encoding == binary_log::QuaternionEncoding::Double) {
+      Eigen::Matrix<double, 7, 1> payload;
+      payload << pose.getPosition().toImplementation(), xyzw;
+      writeRecord(binary_log::RecordType::Pose, encoding, channel, timestamp, payload.data(), sizeof(double)*7);
+    }
+    else {
+      Eigen::Matrix<double, 4, 1> payload;
+      payload.head<3>() = pose.getPosition().toImplementation();
+      const std::uint64_t packed = binary_log::packSmallestThree(xyzw);
+      std::memcpy(payload.data() + 3, &packed, sizeof(packed));
+      writeRecord(binary_log::RecordType::Pose, encoding, channel, timestamp, payload.data(), sizeof(double)*4);
+    }
+  }
+
+  /*! \brief Writes a twist.
+   *  \param channel     channel of the record
+   *  \param timestamp   timestamp of the record
+   *  \param twist       twist
+   */
+  void write(std::uint16_t channel, double timestamp, const TwistLinearVelocityLocalAngularVelocityD& twist) {
+    Eigen::Matrix<double, 6, 1> payload;
+    payload << twist.getTranslationalVelocity().toImplementation(), twist.getRotationalVelocity().toImplementation();
+    writeRecord(binary_log::RecordType::Twist, binary_log::QuaternionEncoding::Double, channel, timestamp, payload.data(), sizeof(double)*6);
+  }
+
+  /*! \brief Writes a wrench.
+   *  \param channel     channel of the record
+   *  \param timestamp   timestamp of the record
+   *  \param wrench      wrench
+   */
+  void write(std::uint16_t channel, double timestamp, const WrenchD& wrench) {
+    Eigen::Matrix<double, 6, 1> payload;
+    payload << wrench.getForce().toImplementation(), wrench.getTorque().toImplementation();
+    writeRecord(binary_log::RecordType::Wrench, binary_log::QuaternionEncoding::Double, channel, timestamp, payload.data(), sizeof(double)*6);
+  }
+
+ private:
+  static bool isLittleEndian() {
+    const std::uint16_t value = 1;
+    char firstByte;
+    std::memcpy(&firstByte, &value, 1);
+    return firstByte == 1;
+  }
+
+  void writeRecord(binary_log::RecordType type, binary_log::QuaternionEncoding encoding, std::uint16_t channel, double timestamp,
+                   const double* payload, std::uint32_t payloadSize) {
+    binary_log::RecordHeader header;
+    header.type = type;
+    header.encoding = encoding;
+    header.channel = channel;
+    header.payloadSize = payloadSize;
+    header.timestamp = timestamp;
+    stream_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream_.write(reinterpret_cast<const char*>(payload), payloadSize);
+  }
+
+  std::ostream& stream_;
+};
+
+
+/*! \class BinaryLogRecord
+ * \brief View of a record in a binary log.
+ *
+ * The vectors of a record are returned as maps into the log memory, which requires the payload to be aligned to 8
+ * bytes, e.g. a log read from the start of a memory mapped file. The rotation of a pose is viewed in place if it was
+ * written with QuaternionEncoding::Double and is decoded otherwise. The header and the poses, twists and wrenches
+ * returned by value are copied from the log, so they can be read at any alignment.
+ */
+class BinaryLogRecord {
+ public:
+  /*! \brief Constructor using a pointer to the record header.
+   *  \param data   pointer to the record header, must stay valid while the record is used
+   */
+  explicit BinaryLogRecord(const char* data = nullptr)
+    : data_(data) {
+  }
+
+  inline binary_log::RecordType getType() const {
+    return getHeader().type;
+  }
+
+  inline std::uint16_t getChannel() const {
+    return getHeader().channel;
+  }
+
+  inline double getTimestamp() const {
+    return getHeader().timestamp;
+  }
+
+  //! \returns the size of the payload in bytes
+  inline std::uint32_t getPayloadSize() const {
+    return getHeader().payloadSize;
+  }
+
+  //! \returns pointer to the record header in the log
+  inline const char* getData() const {
+    return data_;
+  }
+
+  //! \returns the position of a pose record
+  VectorMap<const Position3D> getPosition() const {
+    assertType(binary_log::RecordType::Pose);
+    return VectorMap<const Position3D>(getPayload());
+  }
+
+  //! \returns the rotation of a pose record, loaded or decoded
+  RotationQuaternionD getRotation() const {
+    assertType(binary_log::RecordType::Pose);
+    Eigen::Matrix<double, 4, 1> xyzw;
+    if (getHeader().encoding == binary_log::QuaternionEncoding::Double) {
+      xyzw = loadPayload<4>(3);
+    } else {
+      std::uint64_t packed;
+      std::memcpy(&packed, data_ + sizeof(binary_log::RecordHeader) + 3*sizeof(double), sizeof(packed));
+      xyzw = binary_log::unpackSmallestThree(packed);
+    }
+    return RotationQuaternionD(xyzw(3), xyzw(0), xyzw(1), xyzw(2));
+  }
+
+  //! \returns the rotation of a pose record written with QuaternionEncoding::Double, viewed in place
+  RotationQuaternionMap<const double> getRotationMap() const {
+    assertType(binary_log::RecordType::Pose);
+    KINDR_ASSERT_TRUE(std::runtime_error, getHeader().encoding == binary_log::QuaternionEncoding::Double, "The quaternion of the record is packed and cannot be viewed in place.");
+    return RotationQuaternionMap<const double>(getPayload() + 3);
+  }
+
+  //! \returns the pose of a pose record
+  HomTransformQuatD getPose() const {
+    assertType(binary_log::RecordType::Pose);
+    return HomTransformQuatD(Position3D(loadPayload<3>(0)), getRotation());
+  }
+
+  //! \returns the linear velocity of a twist record
+  VectorMap<const Velocity3D> getLinearVelocity() const {
+    assertType(binary_log::RecordType::Twist);
+    return VectorMap<const Velocity3D>(getPayload());
+  }
+
+  //! \returns the local angular velocity of a twist record
+  VectorMap<const LocalAngularVelocityD> getLocalAngularVelocity() const {
+    assertType(binary_log::RecordType::Twist);
+    return VectorMap<const LocalAngularVelocityD>(getPayload() + 3);
+  }
+
+  //! \returns the twist of a twist record
+  TwistLinearVelocityLocalAngularVelocityD getTwist() const {
+    assertType(binary_log::RecordType::Twist);
+    const Eigen::Matrix<double, 6, 1> payload = loadPayload<6>(0);
+    return TwistLinearVelocityLocalAngularVelocityD(Velocity3D(payload.head<3>()), LocalAngularVelocityD(payload.tail<3>()));
+  }
+
+  //! \returns the force of a wrench record
+  VectorMap<const Force3D> getForce() const {
+    assertType(binary_log::RecordType::Wrench);
+    return VectorMap<const Force3D>(getPayload());
+  }
+
+  //! \returns the torque of a wrench record
+  VectorMap<const Torque3D> getTorque() const {
+    assertType(binary_log::RecordType::Wrench);
+    return VectorMap<const Torque3D>(getPayload() + 3);
+  }
+
+  //! \returns the wrench of a wrench record
+  WrenchD getWrench() const {
+    assertType(binary_log::RecordType::Wrench);
+    const Eigen::Matrix<double, 6, 1> payload = loadPayload<6>(0);
+    return WrenchD(Force3D(payload.head<3>()), Torque3D(payload.tail<3>()));
+  }
+
+ private:
+  inline binary_log::RecordHeader getHeader() const {
+    binary_log::RecordHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    return header;
+  }
+
+  //! \returns the payload for the maps, which throws if it is not aligned to 8 bytes
+  inline const double* getPayload() const {
+    const char* payload = data_ + sizeof(binary_log::RecordHeader);
+    KINDR_ASSERT_TRUE(std::runtime_error, reinterpret_cast<std::uintptr_t>(payload) % alignof(double) == 0u,
+                      "The payload of the record is not aligned to " << alignof(double) << " bytes and cannot be viewed in place.");
+    return reinterpret_cast<const double*>(payload);
+  }
+
+  //! \returns Size_ doubles of the payload from the index on, copied at any alignment
+  template<int Size_>
+  inline Eigen::Matrix<double, Size_, 1> loadPayload(int index) const {
+    Eigen::Matrix<double, Size_, 1> values;
+    std::memcpy(values.data(), data_ + sizeof(binary_log::RecordHeader) + index*sizeof(double), sizeof(double)*Size_);
+    return values;
+  }
+
+  inline void assertType(binary_log::RecordType type) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, getHeader().type == type, "The record has another type.");
+  }
+
+  const char* data_;
+};
+
+
+/*! \class BinaryLogReader
+ * \brief Reads the records of a binary log from memory, e.g. a memory mapped file, without copying them.
+ */
+class BinaryLogReader {
+ public:
+  /*! \brief Constructor validating the file header.
+   *  \param data   pointer to the log, must stay valid while the reader and its records are used
+   *  \param size   size of the log in bytes
+   */
+  BinaryLogReader(const char* data, std::size_t size)
+    : data_(data),
+      size_(size),
+      offset_(sizeof(binary_log::FileHeader)) {
+    KINDR_ASSERT_TRUE(std::runtime_error, size_ >= sizeof(binary_log::FileHeader), "The binary log has no header.");
+    binary_log::FileHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    KINDR_ASSERT_TRUE(std::runtime_error, std::memcmp(header.magic, binary_log::Magic, sizeof(header.magic)) == 0, "The data is not a binary log.");
+    KINDR_ASSERT_TRUE(std::runtime_error, header.version >= 1u && header.version <= binary_log::Version, "The binary log version " << header.version << " is not supported.");
+    KINDR_ASSERT_TRUE(std::runtime_error, header.endianness == binary_log::LittleEndianMarker, "The binary log has another endianness.");
+  }
+
+  /*! \brief Reads the next record.
+   *  Throws a std::runtime_error if the type, the quaternion encoding or the payload size of the record header is
+   *  invalid, i.e. if the log is corrupted. The reader is not advanced in this case.
+   *  \param record   view of the next record
+   *  \returns false if the end of the log is reached
+   */
+  bool read(BinaryLogRecord& record) {
+    if (offset_ + sizeof(binary_log::RecordHeader) > size_) {
+      return false;
+    }
+    binary_log::RecordHeader header;
+    std::memcpy(&header, data_ + offset_, sizeof(header));
+    const std::uint32_t payloadSize = binary_log::getPayloadSize(header.type, header.encoding);
+    KINDR_ASSERT_TRUE(std::runtime_error, payloadSize != 0u, "The record at byte " << offset_ << " has the unknown type "
+                      << static_cast<int>(header.type) << " or quaternion encoding " << static_cast<int>(header.encoding) << ".");
+    KINDR_ASSERT_TRUE(std::runtime_error, header.payloadSize == payloadSize, "The record at byte " << offset_ << " has a payload of "
+                      << header.payloadSize << " bytes instead of " << payloadSize << ".");
+    if (offset_ + sizeof(header) + header.payloadSize > size_) {
+      return false;  // truncated record at the end of a log that is still written
+    }
+    record = BinaryLogRecord(data_ + offset_);
+    offset_ += sizeof(header) + header.payloadSize;
+    return true;
+  }
+
+  /*! \brief Restarts reading at the first record.
+   */
+  void reset() {
+    offset_ = sizeof(binary_log::FileHeader);
+  }
+
+ private:
+  const char* data_;
+  std::size_t size_;
+  std::size_t offset_;
+};
+
+class BinaryLogWindow;
+
+/*! \class BinaryLogChannel
+ * \brief Index of the records of one channel of a binary log, see BinaryLogIndex.
+ *
+ * The offsets and the timestamps of the records are stored in contiguous arrays, such that a record is found by its
+ * number or by a binary search over the timestamps without touching the log. The timestamps must not decrease.
+ */
+class BinaryLogChannel {
+ public:
+  BinaryLogChannel()
+    : data_(nullptr),
+      channel_(0) {
+  }
+
+  inline std::uint16_t getChannel() const {
+    return channel_;
+  }
+
+  //! \returns the number of records of the channel
+  inline int size() const {
+    return static_cast<int>(offsets_.size());
+  }
+
+  //! \returns a view of the i-th record
+  inline BinaryLogRecord operator [](int i) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, i >= 0 && i < size(), "The record index is out of range.");
+    return BinaryLogRecord(data_ + offsets_[i]);
+  }
+
+  //! \returns the timestamp of the i-th record
+  inline double getTimestamp(int i) const {
+    KINDR_ASSERT_TRUE_DBG(std::runtime_error, i >= 0 && i < size(), "The record index is out of range.");
+    return timestamps_[i];
+  }
+
+  /*! \brief Finds the first record at or after a time.
+   *  \param time   time
+   *  \returns index of the record, size() if all records are earlier
+   */
+  inline int findIndex(double time) const {
+    return static_cast<int>(std::lower_bound(timestamps_.begin(), timestamps_.end(), time) - timestamps_.begin());
+  }
+
+  /*! \brief Finds the last record at or before a time, i.e. the latest sample which is known at this time.
+   *  \param time   time
+   *  \returns index of the record, -1 if all records are later
+   */
+  inline int findLatestIndex(double time) const {
+    return static_cast<int>(std::upper_bound(timestamps_.begin(), timestamps_.end(), time) - timestamps_.begin()) - 1;
+  }
+
+  /*! \brief Gets the records in a time interval.
+   *  \param beginTime   start of the interval
+   *  \param endTime     end of the interval, excluded
+   *  \returns window of the records
+   */
+  BinaryLogWindow getWindow(double beginTime, double endTime) const;
+
+  /*! \brief Hints the operating system to read the records [begin, end) ahead, see binary_log::prefetch().
+   *  \param begin   index of the first record
+   *  \param end     index after the last record
+   */
+  void prefetch(int begin, int end) const {
+    if (begin < end) {
+      KINDR_ASSERT_TRUE_DBG(std::runtime_error, begin >= 0 && end <= size(), "The record indices are out of range.");
+      const char* last = data_ + offsets_[end-1];
+      binary_log::prefetch(data_ + offsets_[begin], last + sizeof(binary_log::RecordHeader) + BinaryLogRecord(last).getPayloadSize());
+    }
+  }
+
+ private:
+  friend class BinaryLogIndex;
+
+  const char* data_;
+  std::uint16_t channel_;
+  std::vector<std::size_t> offsets_;
+  std::vector<double> timestamps_;
+};
+
+
+/*! \class BinaryLogWindow
+ * \brief Consecutive records [begin, end) of a channel of a binary log, e.g. the samples within a time interval.
+ */
+class BinaryLogWindow {
+ public:
+  /*! \brief Constructor.
+   *  \param channel   indexed channel, must stay valid while the window is used
+   *  \param begin     index of the first record
+   *  \param end       index after the last record
+   */
+  BinaryLogWindow(const BinaryLogChannel& channel, int begin, int end)
+    : channel_(&channel),
+      begin_(begin),
+      end_(end) {
+    KINDR_ASSERT_TRUE(std::runtime_error, 0 <= begin && begin <= end && end <= channel.size(), "The window is out of range.");
+  }
+
+  //! \returns the number of records of the window
+  inline int size() const {
+    return end_ - begin_;
+  }
+
+  inline bool empty() const {
+    return begin_ == end_;
+  }
+
+  //! \returns index of the first record in the channel
+  inline int getBeginIndex() const {
+    return begin_;
+  }
+
+  //! \returns index after the last record in the channel
+  inline int getEndIndex() const {
+    return end_;
+  }
+
+  //! \returns a view of the i-th record of the window
+  inline BinaryLogRecord operator [](int i) const {
+    return (*channel_)[begin_ + i];
+  }
+
+  //! \returns the timestamp of the i-th record of the window
+  inline double getTimestamp(int i) const {
+    return channel_->getTimestamp(begin_ + i);
+  }
+
+  //! \brief Hints the operating system to read the records of the window ahead.
+  inline void prefetch() const {
+    channel_->prefetch(begin_, end_);
+  }
+
+ private:
+  const BinaryLogChannel* channel_;
+  int begin_;
+  int end_;
+};
+
+inline BinaryLogWindow BinaryLogChannel::getWindow(double beginTime, double endTime) const {
+  const int begin = findIndex(beginTime);
+  return BinaryLogWindow(*this, begin, std::max(begin, findIndex(endTime)));
+}
+
+
+/*! \class BinaryLogIndex
+ * \brief Index of the records of a binary log by channel for random access by number and time.
+ *
+ * The index is built in one pass over the record headers, the payloads are neither read nor copied. It needs 16
+ * bytes per record, i.e. less than a quarter of the size of a log of poses.
+ */
+class BinaryLogIndex {
+ public:
+  /*! \brief Constructor indexing a log.
+   *  \param data   pointer to the log, must stay valid while the index and its records are used
+   *  \param size   size of the log in bytes
+   */
+  BinaryLogIndex(const char* data, std::size_t size) {
+    BinaryLogReader reader(data, size);
+    BinaryLogRecord record;
+    BinaryLogChannel* channel = nullptr;
+    while (reader.read(record)) {
+      // consecutive records are often of the same channel
+      if (channel == nullptr || channel->channel_ != record.getChannel()) {
+        channel = &channels_[record.getChannel()];
+        channel->data_ = data;
+        channel->channel_ = record.getChannel();
+      }
+      KINDR_ASSERT_TRUE(std::runtime_error, channel->timestamps_.empty() || channel->timestamps_.back() <= record.getTimestamp(),
+                        "The timestamps of channel " << record.getChannel() << " decrease.");
+      channel->offsets_.push_back(static_cast<std::size_t>(record.getData() - data));
+      channel->timestamps_.push_back(record.getTimestamp());
+    }
+  }
+
+  //! \returns true if the log contains records of a channel
+  inline bool hasChannel(std::uint16_t channel) const {
+    return channels_.count(channel) > 0;
+  }
+
+  //! \returns the indexed records of a channel
+  const BinaryLogChannel& getChannel(std::uint16_t channel) const {
+    const std::map<std::uint16_t, BinaryLogChannel>::const_iterator it = channels_.find(channel);
+    KINDR_ASSERT_TRUE(std::runtime_error, it != channels_.end(), "The binary log has no records of channel " << channel << ".");
+    return it->second;
+  }
+
+  //! \returns the channels of the log in ascending order
+  std::vector<std::uint16_t> getChannels() const {
+    std::vector<std::uint16_t> channels;
+    for (const auto& channel : channels_) {
+      channels.push_back(channel.first);
+    }
+    return channels;
+  }
+
+ private:
+  std::map<std::uint16_t, BinaryLogChannel> channels_;
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+/*! \class BinaryLogFile
+ * \brief Memory maps a binary log file read-only and reads its records without copies.
+ */
+class BinaryLogFile {
+ public:
+  //! Expected access pattern, see advise()
+  enum class AccessPattern {
+    Normal,
+    Sequential,
+    Random
+  };
+
+  /*! \brief Constructor mapping a file.
+   *  \param fileName   name of the log file
+   */
+  explicit BinaryLogFile(const std::string& fileName)
+    : data_(nullptr),
+      size_(0) {
+    const int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    KINDR_ASSERT_TRUE(std::runtime_error, fileDescriptor >= 0, "The binary log " << fileName << " cannot be opened.");
+    struct stat status;
+    if (::fstat(fileDescriptor, &status) == 0 && status.st_size > 0) {
+      size_ = static_cast<std::size_t>(status.st_size);
+      void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+      data_ = (data == MAP_FAILED) ? nullptr : static_cast<const char*>(data);
+    }
+    ::close(fileDescriptor);
+    KINDR_ASSERT_TRUE(std::runtime_error, data_ != nullptr, "The binary log " << fileName << " cannot be mapped.");
+  }
+
+  BinaryLogFile(const BinaryLogFile&) = delete;
+  BinaryLogFile& operator=(const BinaryLogFile&) = delete;
+
+  ~BinaryLogFile() {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+
+  /*! \brief Gets a reader of the mapped log.
+   *  \returns reader, valid while the file is mapped
+   */
+  BinaryLogReader getReader() const {
+    return BinaryLogReader(data_, size_);
+  }
+
+  /*! \brief Indexes the mapped log by channel.
+   *  \returns index, valid while the file is mapped
+   */
+  BinaryLogIndex getIndex() const {
+    return BinaryLogIndex(data_, size_);
+  }
+
+  /*! \brief Hints the operating system how the log will be read, e.g. Sequential for reading ahead aggressively
+   *  when the whole log is streamed and Random when only a few windows are read.
+   *  \param pattern   access pattern
+   */
+  void advise(AccessPattern pattern) const {
+    const int advice = (pattern == AccessPattern::Sequential) ? MADV_SEQUENTIAL : (pattern == AccessPattern::Random) ? MADV_RANDOM : MADV_NORMAL;
+    ::madvise(const_cast<char*>(data_), size_, advice);
+  }
+
+ private:
+  const char* data_;
+  std::size_t size_;
+};
+#endif
+
+} // namespace kindr
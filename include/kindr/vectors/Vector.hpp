@@ -31,6 +31,8 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+#include <utility>
+
 #include "kindr/common/common.hpp"
 #include "kindr/common/assert_macros_eigen.hpp"
 #include "kindr/vectors/VectorBase.hpp"
@@ -38,6 +40,12 @@
 
 namespace kindr {
 
+template<typename Vector_, typename Expression_>
+class VectorExpression;
+
+template<typename Vector_>
+class VectorNoAlias;
+
 /*! \class Vector
  * \brief Vector in n-dimensional-space.
  *
@@ -79,7 +87,7 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
   /*! \brief Default constructor for static sized vectors which initializes all components with zero.
    */
   template<int DimensionCopy_ = Dimension_>
-  Vector(typename std::enable_if<DimensionCopy_ != DynamicDimension>::type* = nullptr)
+  KINDR_DEVICE_FUNC Vector(typename std::enable_if<DimensionCopy_ != DynamicDimension>::type* = nullptr)
     : Implementation(Implementation::Zero()) {
   }
 
@@ -90,6 +98,14 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
     : Implementation() {
   }
 
+  /*! \brief Constructor for dynamic sized vectors which allocates the coordinates once and initializes them with zero.
+   *  \param size   number of coordinates
+   */
+  template<int DimensionCopy_ = Dimension_>
+  explicit Vector(int size, typename std::enable_if<DimensionCopy_ == DynamicDimension>::type* = nullptr)
+    : Implementation(Implementation::Zero(size)) {
+  }
+
   /*! \brief Constructor using other vector with generic type.
    *  \param other   Vector<OtherPhysicalType_, OtherPrimType_, Dimension_>
    */
@@ -109,10 +125,28 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
   /*! \brief Constructor using Eigen::Matrix.
    *  \param other   Eigen::Matrix<PrimType_,Dimension_,1>
    */
-  explicit Vector(const Implementation& other)
+  KINDR_DEVICE_FUNC explicit Vector(const Implementation& other)
+    : Implementation(other) {
+  }
+
+  /*! \brief Constructor using an Eigen expression.
+   *  The expression is evaluated directly into the coordinates. The arithmetic operators construct their results
+   *  with it, such that they compile to the same code as the Eigen expression without a temporary Implementation.
+   *  \param other   Eigen expression with Dimension_ rows
+   */
+  template<typename OtherDerived_>
+  explicit Vector(const Eigen::MatrixBase<OtherDerived_>& other)
     : Implementation(other) {
   }
 
+  /*! \brief Constructor evaluating a lazy vector expression of the same physical type in a single pass.
+   *  \param expression   VectorExpression<Vector, Expression_>
+   */
+  template<typename Expression_>
+  Vector(const VectorExpression<Vector<PhysicalType_, PrimType_, Dimension_>, Expression_>& expression)
+    : Implementation(expression.toImplementation()) {
+  }
+
   /*! \brief Constructor using three scalars.
    *  \param x x-Component
    *  \param y y-Component
@@ -299,14 +333,14 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
   /*! \brief Cast to the implementation type.
    *  \returns the implementation (recommended only for advanced users)
    */
-  inline Implementation& toImplementation() {
+  KINDR_DEVICE_FUNC inline Implementation& toImplementation() {
     return static_cast<Implementation&>(*this);
   }
 
   /*! \brief Cast to the implementation type.
    *  \returns the implementation (recommended only for advanced users)
    */
-  inline const Implementation& toImplementation() const {
+  KINDR_DEVICE_FUNC inline const Implementation& toImplementation() const {
     return static_cast<const Implementation&>(*this);
   }
 
@@ -324,6 +358,21 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
     return static_cast<const Implementation&>(*this);
   }
 
+  /*! \brief Number of coordinates.
+   *  \returns size
+   */
+  inline int size() const {
+    return static_cast<int>(this->toImplementation().size());
+  }
+
+  /*! \brief Resizes a dynamic sized vector. The coordinates are reallocated only if the size changes.
+   *  \param size   number of coordinates
+   */
+  template<int DimensionCopy_ = Dimension_>
+  void resize(int size, typename std::enable_if<DimensionCopy_ == DynamicDimension>::type* = nullptr) {
+    this->toImplementation().resize(size);
+  }
+
   /*! \brief Assignment operator.
    * \param other   other vector
    * \returns reference
@@ -333,6 +382,37 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
     return *this;
   }
 
+  /*! \brief Assignment of a lazy vector expression of the same physical type, evaluated in a single pass.
+   * \param expression   vector expression
+   * \returns reference
+   */
+  template<typename Expression_>
+  Vector<PhysicalType_, PrimType_, Dimension_> & operator=(const VectorExpression<Vector<PhysicalType_, PrimType_, Dimension_>, Expression_>& expression) {
+    this->toImplementation() = expression.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Gets a lazy expression referring to the coordinates of this vector.
+   *  Arithmetic on the expression keeps the physical type checks, but is only evaluated
+   *  when it is assigned to a vector, so a+b*2-c runs in one loop without temporaries.
+   *  The vector must outlive the expression.
+   * \returns lazy expression
+   */
+  VectorExpression<Vector<PhysicalType_, PrimType_, Dimension_>, Eigen::Map<const Implementation>> lazy() const {
+    return VectorExpression<Vector<PhysicalType_, PrimType_, Dimension_>, Eigen::Map<const Implementation>>(
+        Eigen::Map<const Implementation>(this->toImplementation().data(), this->toImplementation().size()));
+  }
+
+  /*! \brief Gets a proxy which assigns vectors and lazy expressions without checking for aliasing.
+   *  The coordinates are written directly without an intermediate copy and, for dynamic sized vectors, without
+   *  reallocation if the size does not change, e.g. result.noalias() = a.lazy() + b.lazy()*dt.
+   *  The result must not be an operand of the assigned expression.
+   * \returns proxy
+   */
+  VectorNoAlias<Vector<PhysicalType_, PrimType_, Dimension_>> noalias() {
+    return VectorNoAlias<Vector<PhysicalType_, PrimType_, Dimension_>>(*this);
+  }
+
   /*! \brief Addition of two vectors.
    * \param other   other vector
    * \returns sum
@@ -405,6 +485,25 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
     return *this;
   }
 
+  /*! \brief Adds a scaled vector in place, i.e. this += other*factor, in a single pass without a temporary.
+   * \param other    other vector
+   * \param factor   factor
+   * \returns reference
+   */
+  Vector<PhysicalType_, PrimType_, Dimension_>& addInPlace(const Vector<PhysicalType_, PrimType_, Dimension_>& other, Scalar factor = Scalar(1)) {
+    this->toImplementation() += factor*other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Scales the vector in place.
+   * \param factor   factor
+   * \returns reference
+   */
+  Vector<PhysicalType_, PrimType_, Dimension_>& scaleInPlace(Scalar factor) {
+    this->toImplementation() *= factor;
+    return *this;
+  }
+
   /*! \brief Negation of a vector.
    * \returns negative vector
    */
@@ -434,7 +533,7 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
    * \returns true if similar within tolerance
    */
   bool isSimilarTo(const Vector<PhysicalType_, PrimType_, Dimension_>& other, Scalar tol) const {
-    if((*this - other).abs().max() < tol) {
+    if((this->toImplementation() - other.toImplementation()).cwiseAbs().maxCoeff() < tol) {
       return true;
     } else {
       return false;
@@ -580,6 +679,242 @@ Vector<PhysicalType_, PrimType_, Dimension_> operator*(PrimTypeFactor_ factor, c
 }
 
 
+/*! \class VectorExpression
+ * \brief Lazy arithmetic expression of typed vectors.
+ *
+ * The expression wraps an Eigen expression and carries the kindr vector type it evaluates to. Sums and differences
+ * only compile for vectors of the same physical type and elementwise products and quotients take their result
+ * type from MultiplicationReturnTypeTrait and DivisionReturnTypeTrait, while Eigen fuses the arithmetic into a
+ * single loop when the expression is assigned to a vector. Expressions are created with Vector::lazy().
+ * \tparam Vector_        Vector type the expression evaluates to.
+ * \tparam Expression_    Eigen expression type.
+ * \ingroup vectors
+ */
+template<typename Vector_, typename Expression_>
+class VectorExpression {
+ public:
+  /*! \brief The implementation type.
+   */
+  typedef Expression_ Implementation;
+
+  /*! \brief The vector type the expression evaluates to.
+   */
+  typedef Vector_ VectorType;
+
+  /*! \brief The primitive type of the coordinates.
+   */
+  typedef typename Vector_::Scalar Scalar;
+
+  /*! \brief The Eigen expression referring to the coordinates of a vector.
+   */
+  typedef Eigen::Map<const typename Vector_::Implementation> LeafExpression;
+
+  /*! \brief Constructor using an Eigen expression.
+   *  \param expression   Eigen expression
+   */
+  explicit VectorExpression(const Expression_& expression)
+    : expression_(expression) {
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the Eigen expression (recommended only for advanced users)
+   */
+  inline const Expression_& toImplementation() const {
+    return expression_;
+  }
+
+  /*! \brief Evaluates the expression.
+   *  \returns vector
+   */
+  Vector_ eval() const {
+    return Vector_(*this);
+  }
+
+  /*! \brief Addition of two expressions of the same physical type.
+   * \param other   other expression
+   * \returns lazy sum
+   */
+  template<typename OtherExpression_>
+  VectorExpression<Vector_, decltype(std::declval<const Expression_&>() + std::declval<const OtherExpression_&>())>
+  operator+(const VectorExpression<Vector_, OtherExpression_>& other) const {
+    return VectorExpression<Vector_, decltype(std::declval<const Expression_&>() + std::declval<const OtherExpression_&>())>(expression_ + other.toImplementation());
+  }
+
+  /*! \brief Addition of a vector of the same physical type.
+   * \param other   other vector
+   * \returns lazy sum
+   */
+  VectorExpression<Vector_, decltype(std::declval<const Expression_&>() + std::declval<const LeafExpression&>())>
+  operator+(const Vector_& other) const {
+    return *this + other.lazy();
+  }
+
+  /*! \brief Subtraction of two expressions of the same physical type.
+   * \param other   other expression
+   * \returns lazy difference
+   */
+  template<typename OtherExpression_>
+  VectorExpression<Vector_, decltype(std::declval<const Expression_&>() - std::declval<const OtherExpression_&>())>
+  operator-(const VectorExpression<Vector_, OtherExpression_>& other) const {
+    return VectorExpression<Vector_, decltype(std::declval<const Expression_&>() - std::declval<const OtherExpression_&>())>(expression_ - other.toImplementation());
+  }
+
+  /*! \brief Subtraction of a vector of the same physical type.
+   * \param other   other vector
+   * \returns lazy difference
+   */
+  VectorExpression<Vector_, decltype(std::declval<const Expression_&>() - std::declval<const LeafExpression&>())>
+  operator-(const Vector_& other) const {
+    return *this - other.lazy();
+  }
+
+  /*! \brief Negation of the expression.
+   * \returns lazy negative
+   */
+  VectorExpression<Vector_, decltype(-std::declval<const Expression_&>())> operator-() const {
+    return VectorExpression<Vector_, decltype(-std::declval<const Expression_&>())>(-expression_);
+  }
+
+  /*! \brief Multiplies the expression with a scalar.
+   * \param factor   factor
+   * \returns lazy product
+   */
+  VectorExpression<Vector_, decltype(std::declval<const Expression_&>()*std::declval<Scalar>())> operator*(Scalar factor) const {
+    return VectorExpression<Vector_, decltype(std::declval<const Expression_&>()*std::declval<Scalar>())>(expression_*factor);
+  }
+
+  /*! \brief Divides the expression by a scalar.
+   * \param divisor   divisor
+   * \returns lazy quotient
+   */
+  VectorExpression<Vector_, decltype(std::declval<const Expression_&>()/std::declval<Scalar>())> operator/(Scalar divisor) const {
+    return VectorExpression<Vector_, decltype(std::declval<const Expression_&>()/std::declval<Scalar>())>(expression_/divisor);
+  }
+
+  /*! \brief Elementwise product with another expression.
+   *  \param other   other expression
+   *  \returns lazy elementwise product with the physical type of the product
+   */
+  template<typename OtherVector_, typename OtherExpression_>
+  VectorExpression<typename internal::MultiplicationReturnTypeTrait<Vector_, OtherVector_>::ReturnType,
+                   decltype(std::declval<const Expression_&>().cwiseProduct(std::declval<const OtherExpression_&>()))>
+  elementwiseMultiplication(const VectorExpression<OtherVector_, OtherExpression_>& other) const {
+    return VectorExpression<typename internal::MultiplicationReturnTypeTrait<Vector_, OtherVector_>::ReturnType,
+                            decltype(std::declval<const Expression_&>().cwiseProduct(std::declval<const OtherExpression_&>()))>(expression_.cwiseProduct(other.toImplementation()));
+  }
+
+  /*! \brief Elementwise division by another expression.
+   *  \param other   other expression
+   *  \returns lazy elementwise quotient with the physical type of the quotient
+   */
+  template<typename OtherVector_, typename OtherExpression_>
+  VectorExpression<typename internal::DivisionReturnTypeTrait<Vector_, OtherVector_>::ReturnType,
+                   decltype(std::declval<const Expression_&>().cwiseQuotient(std::declval<const OtherExpression_&>()))>
+  elementwiseDivision(const VectorExpression<OtherVector_, OtherExpression_>& other) const {
+    return VectorExpression<typename internal::DivisionReturnTypeTrait<Vector_, OtherVector_>::ReturnType,
+                            decltype(std::declval<const Expression_&>().cwiseQuotient(std::declval<const OtherExpression_&>()))>(expression_.cwiseQuotient(other.toImplementation()));
+  }
+
+  /*! \brief Norm of the expression, evaluated without a temporary vector.
+   *  \returns norm.
+   */
+  Scalar norm() const {
+    return expression_.norm();
+  }
+
+  /*! \brief Squared norm of the expression, evaluated without a temporary vector.
+   *  \returns squared norm.
+   */
+  Scalar squaredNorm() const {
+    return expression_.squaredNorm();
+  }
+
+  /*! \brief Sum of the components, evaluated without a temporary vector.
+   *  \returns sum.
+   */
+  Scalar sum() const {
+    return expression_.sum();
+  }
+
+ private:
+  //! Eigen expression, leaves refer to the coordinates of the vectors
+  Expression_ expression_;
+};
+
+
+/*! \brief Multiplies an expression with a scalar.
+ * \param factor   factor
+ * \returns lazy product
+ */
+template<typename Vector_, typename Expression_>
+auto operator*(typename Vector_::Scalar factor, const VectorExpression<Vector_, Expression_>& expression) -> decltype(expression*factor) {
+  return expression*factor;
+}
+
+
+/*! \class VectorNoAlias
+ * \brief Proxy returned by Vector::noalias() which assigns to the coordinates of a vector without aliasing checks.
+ *
+ * Only vectors and expressions evaluating to the same vector type can be assigned, so the physical type checks
+ * are kept.
+ * \tparam Vector_   Vector type.
+ * \ingroup vectors
+ */
+template<typename Vector_>
+class VectorNoAlias {
+ public:
+  /*! \brief Constructor.
+   *  \param vector   vector to assign to
+   */
+  explicit VectorNoAlias(Vector_& vector)
+    : vector_(vector) {
+  }
+
+  /*! \brief Assigns a lazy expression.
+   * \param expression   vector expression
+   * \returns reference to the vector
+   */
+  template<typename Expression_>
+  Vector_& operator=(const VectorExpression<Vector_, Expression_>& expression) {
+    vector_.toImplementation().noalias() = expression.toImplementation();
+    return vector_;
+  }
+
+  /*! \brief Adds a lazy expression.
+   * \param expression   vector expression
+   * \returns reference to the vector
+   */
+  template<typename Expression_>
+  Vector_& operator+=(const VectorExpression<Vector_, Expression_>& expression) {
+    vector_.toImplementation().noalias() += expression.toImplementation();
+    return vector_;
+  }
+
+  /*! \brief Subtracts a lazy expression.
+   * \param expression   vector expression
+   * \returns reference to the vector
+   */
+  template<typename Expression_>
+  Vector_& operator-=(const VectorExpression<Vector_, Expression_>& expression) {
+    vector_.toImplementation().noalias() -= expression.toImplementation();
+    return vector_;
+  }
+
+  /*! \brief Assigns a vector.
+   * \param other   other vector
+   * \returns reference to the vector
+   */
+  Vector_& operator=(const Vector_& other) {
+    vector_.toImplementation().noalias() = other.toImplementation();
+    return vector_;
+  }
+
+ private:
+  //! Vector to assign to
+  Vector_& vector_;
+};
+
+
 namespace internal {
 
 /*! \brief Gets the primitive type of the vector
@@ -599,23 +934,31 @@ class get_dimension<Vector<PhysicalType_, PrimType_, Dimension_>> {
 };
 
 /*! \brief Gets the return type of a multiplication
+ *  The physical type follows from the exponents of the base dimensions, see PhysicalTypeExponents.
+ *  It is Typeless if no physical type has the exponents of the product.
  */
 template<enum PhysicalType PhysicalType1_, enum PhysicalType PhysicalType2_, typename PrimType_, int Dimension_>
 class MultiplicationReturnTypeTrait<Vector<PhysicalType1_, PrimType_, Dimension_>, Vector<PhysicalType2_, PrimType_, Dimension_>>
 {
  public:
-  typedef Vector<PhysicalType::Typeless, PrimType_, Dimension_> ReturnType;
+  typedef Vector<PhysicalTypeProduct<PhysicalType1_, PhysicalType2_>::Type, PrimType_, Dimension_> ReturnType;
 };
 
-/*! \brief Gets the return type of a multiplication
+/*! \brief Gets the return type of a division
+ *  The physical type follows from the exponents of the base dimensions, see PhysicalTypeExponents.
+ *  It is Typeless if no physical type has the exponents of the quotient.
  */
 template<enum PhysicalType PhysicalType1_, enum PhysicalType PhysicalType2_, typename PrimType_, int Dimension_>
 class DivisionReturnTypeTrait<Vector<PhysicalType1_, PrimType_, Dimension_>, Vector<PhysicalType2_, PrimType_, Dimension_>>
 {
  public:
-  typedef Vector<PhysicalType::Typeless, PrimType_, Dimension_> ReturnType;
+  typedef Vector<PhysicalTypeQuotient<PhysicalType1_, PhysicalType2_>::Type, PrimType_, Dimension_> ReturnType;
 };
 
+/* The following specializations are only needed where the result differs from the exponent algebra, i.e. where an
+ * angle is dropped as in Position*AngularVelocity = Velocity, or where the algebra has no physical type.
+ */
+
 /*! \brief Specializes multiplication and division traits for the triple (factor1 != factor2)
  */
 #define KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(FACTOR1, FACTOR2, PRODUCT) \
@@ -660,46 +1003,14 @@ class DivisionReturnTypeTrait<Vector<PhysicalType1_, PrimType_, Dimension_>, Vec
       typedef Vector<PhysicalType::FACTOR1AND2, PrimType_, Dimension_> ReturnType; \
     };
 
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_B(Typeless, Typeless)
-
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Time, Time)
-
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Jerk, Jerk)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Acceleration, Acceleration)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Velocity, Velocity)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Position, Position) // Position/Position = Typeless
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Force, Force)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Momentum, Momentum)
-
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, AngularJerk, AngularJerk)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, AngularAcceleration, AngularAcceleration)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, AngularVelocity, AngularVelocity)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Angle, Angle)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, Torque, Torque)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Typeless, AngularMomentum, AngularMomentum)
-
+// Angles are dropped from the products of positions with angular quantities
 KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Position, AngularJerk, Jerk)
 KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Position, AngularAcceleration, Acceleration)
 KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Position, AngularVelocity, Velocity)
 //KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Position, Angle, Position) // Position/Position = Angle -> ambiguous, explicit cast to Angle if needed
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Position, Force, Torque)
+KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Position, Force, Torque) // the exponents would yield Energy
 KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Position, Momentum, AngularMomentum)
 
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Time, Jerk, Acceleration)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Time, Acceleration, Velocity)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Time, Velocity, Position)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Time, Force, Momentum)
-
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Time, AngularJerk, AngularAcceleration)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Time, AngularAcceleration, AngularVelocity)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Time, AngularVelocity, Angle)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Time, Torque, AngularMomentum)
-
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Mass, Acceleration, Force)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Mass, Velocity, Momentum)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Inertia, AngularAcceleration, Torque)
-KINDR_SPECIALIZE_PHYS_QUANT_RETURN_TYPE_A(Inertia, AngularVelocity, AngularMomentum)
-
 
 
 } // namespace internal
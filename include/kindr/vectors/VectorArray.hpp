@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/phys_quant/PhysicalType.hpp"
+#include "kindr/vectors/Vector.hpp"
+
+namespace kindr {
+
+/*! \class VectorArray
+ * \brief Batch of 3D vectors stored in structure-of-arrays layout.
+ *
+ * The coordinates of N vectors are stored in a row-major 3xN matrix, i.e. all x-coordinates, all y-coordinates
+ * and all z-coordinates are contiguous in memory. Operations on the rows are coefficient-wise and can be vectorized by Eigen.
+ * \tparam PhysicalType_    Physical type of the vectors.
+ * \tparam PrimType_        Primitive type of the coordinates.
+ * \ingroup vectors
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_>
+class VectorArray {
+ public:
+  /*! \brief The implementation type.
+   *
+   *  The implementation type is always an Eigen object.
+   */
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic, Eigen::RowMajor> Implementation;
+
+  /*! \brief The primitive type of the coordinates.
+   */
+  typedef PrimType_ Scalar;
+
+  /*! \brief The type of a single vector of the batch.
+   */
+  typedef Vector<PhysicalType_, PrimType_, 3> Element;
+
+  /*! \brief Default constructor creating an empty batch.
+   */
+  VectorArray()
+    : vectors_(3, 0) {
+  }
+
+  /*! \brief Constructor creating a batch of zero vectors.
+   *  \param size   number of vectors
+   */
+  explicit VectorArray(int size)
+    : vectors_(Implementation::Zero(3, size)) {
+  }
+
+  /*! \brief Constructor using a 3xN Eigen matrix (each column is a vector).
+   *  \param other   Eigen matrix expression with three rows
+   */
+  template<typename OtherDerived_>
+  explicit VectorArray(const Eigen::MatrixBase<OtherDerived_>& other)
+    : vectors_(other) {
+  }
+
+  /*! \brief Constructor using a std::vector of vectors.
+   *  \param vectors   vectors
+   */
+  explicit VectorArray(const std::vector<Element>& vectors)
+    : vectors_(3, vectors.size()) {
+    for (int i = 0; i < size(); ++i) {
+      vectors_.col(i) = vectors[i].toImplementation();
+    }
+  }
+
+  /*! \brief Constructor using a batch with another primitive type.
+   *  \param other   VectorArray<PhysicalType_, OtherPrimType_>
+   */
+  template<typename OtherPrimType_>
+  explicit VectorArray(const VectorArray<PhysicalType_, OtherPrimType_>& other)
+    : vectors_(other.toImplementation().template cast<PrimType_>()) {
+  }
+
+  /*! \brief Gets the number of vectors.
+   *  \returns number of vectors
+   */
+  inline int size() const {
+    return static_cast<int>(vectors_.cols());
+  }
+
+  /*! \brief Resizes the batch. The content is undefined afterwards.
+   *  \param size   number of vectors
+   */
+  inline void resize(int size) {
+    vectors_.resize(3, size);
+  }
+
+  /*! \brief Sets all vectors to zero.
+   *  \returns reference
+   */
+  VectorArray& setZero() {
+    vectors_.setZero();
+    return *this;
+  }
+
+  /*! \brief Gets the i-th vector.
+   *  \returns vector
+   */
+  inline Element operator [](int i) const {
+    return Element(vectors_.col(i));
+  }
+
+  /*! \brief Sets the i-th vector.
+   *  \param i   index
+   *  \param vector   vector
+   */
+  inline void set(int i, const Element& vector) {
+    vectors_.col(i) = vector.toImplementation();
+  }
+
+  /*! \brief Gets the x-coordinates of all vectors.
+   */
+  inline typename Implementation::RowXpr x() {
+    return vectors_.row(0);
+  }
+
+  /*! \brief Gets the x-coordinates of all vectors.
+   */
+  inline typename Implementation::ConstRowXpr x() const {
+    return vectors_.row(0);
+  }
+
+  /*! \brief Gets the y-coordinates of all vectors.
+   */
+  inline typename Implementation::RowXpr y() {
+    return vectors_.row(1);
+  }
+
+  /*! \brief Gets the y-coordinates of all vectors.
+   */
+  inline typename Implementation::ConstRowXpr y() const {
+    return vectors_.row(1);
+  }
+
+  /*! \brief Gets the z-coordinates of all vectors.
+   */
+  inline typename Implementation::RowXpr z() {
+    return vectors_.row(2);
+  }
+
+  /*! \brief Gets the z-coordinates of all vectors.
+   */
+  inline typename Implementation::ConstRowXpr z() const {
+    return vectors_.row(2);
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline Implementation& toImplementation() {
+    return vectors_;
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline const Implementation& toImplementation() const {
+    return vectors_;
+  }
+
+  /*! \brief Gets the vectors as std::vector.
+   *  \returns vectors
+   */
+  std::vector<Element> toStdVector() const {
+    std::vector<Element> vectors;
+    vectors.reserve(size());
+    for (int i = 0; i < size(); ++i) {
+      vectors.push_back((*this)[i]);
+    }
+    return vectors;
+  }
+
+  /*! \brief Addition of two batches of the same size.
+   *  \returns sum
+   */
+  VectorArray operator +(const VectorArray& other) const {
+    return VectorArray(vectors_ + other.vectors_);
+  }
+
+  /*! \brief Subtraction of two batches of the same size.
+   *  \returns difference
+   */
+  VectorArray operator -(const VectorArray& other) const {
+    return VectorArray(vectors_ - other.vectors_);
+  }
+
+  /*! \brief Adds the same vector to all vectors of the batch.
+   *  \returns sum
+   */
+  VectorArray operator +(const Element& other) const {
+    return VectorArray(vectors_.colwise() + other.toImplementation());
+  }
+
+  /*! \brief Subtracts the same vector from all vectors of the batch.
+   *  \returns difference
+   */
+  VectorArray operator -(const Element& other) const {
+    return VectorArray(vectors_.colwise() - other.toImplementation());
+  }
+
+  /*! \brief Multiplication of all vectors with a scalar.
+   *  \returns product
+   */
+  VectorArray operator *(PrimType_ factor) const {
+    return VectorArray(vectors_*factor);
+  }
+
+  /*! \brief Division of all vectors by a scalar.
+   *  \returns quotient
+   */
+  VectorArray operator /(PrimType_ divisor) const {
+    return VectorArray(vectors_/divisor);
+  }
+
+  /*! \brief Addition and assignment of a batch of the same size.
+   *  \returns reference
+   */
+  VectorArray& operator +=(const VectorArray& other) {
+    vectors_ += other.vectors_;
+    return *this;
+  }
+
+  /*! \brief Subtraction and assignment of a batch of the same size.
+   *  \returns reference
+   */
+  VectorArray& operator -=(const VectorArray& other) {
+    vectors_ -= other.vectors_;
+    return *this;
+  }
+
+  /*! \brief Gets the norms of all vectors.
+   *  \returns row vector with the norms
+   */
+  Eigen::Matrix<PrimType_, 1, Eigen::Dynamic> norm() const {
+    return vectors_.colwise().norm();
+  }
+
+ private:
+  Implementation vectors_;
+};
+
+//! \brief Batch of 3D position vectors
+template <typename PrimType_>
+using PositionArray = VectorArray<PhysicalType::Position, PrimType_>;
+//! \brief Batch of 3D position vectors with primitive type double
+typedef PositionArray<double> PositionArrayD;
+//! \brief Batch of 3D position vectors with primitive type float
+typedef PositionArray<float> PositionArrayF;
+
+//! \brief Batch of 3D velocity vectors
+template <typename PrimType_>
+using VelocityArray = VectorArray<PhysicalType::Velocity, PrimType_>;
+//! \brief Batch of 3D velocity vectors with primitive type double
+typedef VelocityArray<double> VelocityArrayD;
+//! \brief Batch of 3D velocity vectors with primitive type float
+typedef VelocityArray<float> VelocityArrayF;
+
+//! \brief Batch of 3D acceleration vectors
+template <typename PrimType_>
+using AccelerationArray = VectorArray<PhysicalType::Acceleration, PrimType_>;
+//! \brief Batch of 3D acceleration vectors with primitive type double
+typedef AccelerationArray<double> AccelerationArrayD;
+//! \brief Batch of 3D acceleration vectors with primitive type float
+typedef AccelerationArray<float> AccelerationArrayF;
+
+//! \brief Batch of 3D force vectors
+template <typename PrimType_>
+using ForceArray = VectorArray<PhysicalType::Force, PrimType_>;
+//! \brief Batch of 3D force vectors with primitive type double
+typedef ForceArray<double> ForceArrayD;
+//! \brief Batch of 3D force vectors with primitive type float
+typedef ForceArray<float> ForceArrayF;
+
+//! \brief Batch of 3D torque vectors
+template <typename PrimType_>
+using TorqueArray = VectorArray<PhysicalType::Torque, PrimType_>;
+//! \brief Batch of 3D torque vectors with primitive type double
+typedef TorqueArray<double> TorqueArrayD;
+//! \brief Batch of 3D torque vectors with primitive type float
+typedef TorqueArray<float> TorqueArrayF;
+
+} // namespace kindr
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/vectors/Vector.hpp"
+
+namespace kindr {
+
+/*! \class VectorMap
+ * \brief View of a vector stored in external memory.
+ *
+ * The map does not own its coordinates, but reads and writes them in place, e.g. in a message, a shared memory block
+ * or a log buffer. The coordinates may be strided. A map of a const type (e.g. VectorMap<const Position3D>) is read-only.
+ * Operations that are not provided by the map are available on the vector returned by eval(), which loads the coordinates.
+ * \tparam Vector_   Vector type that is viewed, e.g. Position3D or LocalAngularVelocityPD.
+ * \tparam Stride_   Eigen stride between the coordinates.
+ * \ingroup vectors
+ */
+template<typename Vector_, typename Stride_ = Eigen::InnerStride<1>>
+class VectorMap {
+  static_assert(std::remove_const<Vector_>::type::Implementation::RowsAtCompileTime != Eigen::Dynamic, "VectorMap: fixed dimension expected");
+ public:
+  /*! \brief The vector type that is viewed.
+   */
+  typedef typename std::remove_const<Vector_>::type VectorType;
+
+  /*! \brief The primitive type of the coordinates.
+   */
+  typedef typename VectorType::Scalar Scalar;
+
+  /*! \brief The implementation type.
+   *
+   *  The implementation type is always an Eigen object.
+   */
+  typedef Eigen::Map<typename std::conditional<std::is_const<Vector_>::value, const typename VectorType::Implementation,
+                                               typename VectorType::Implementation>::type, Eigen::Unaligned, Stride_> Implementation;
+
+  /*! \brief The pointer type of the viewed memory.
+   */
+  typedef typename std::conditional<std::is_const<Vector_>::value, const Scalar*, Scalar*>::type PointerType;
+
+  /*! \brief Constructor using a pointer to the first coordinate.
+   *  \param data     pointer to the first coordinate
+   *  \param stride   stride between the coordinates
+   */
+  explicit VectorMap(PointerType data, const Stride_& stride = Stride_())
+    : map_(data, VectorType::Implementation::RowsAtCompileTime, 1, stride),
+      stride_(stride) {
+  }
+
+  /*! \brief Writes a vector into the viewed memory.
+   *  \param other   vector
+   *  \returns reference
+   */
+  VectorMap& operator=(const VectorType& other) {
+    map_ = other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Copies the coordinates of another map into the viewed memory.
+   *  \param other   other map
+   *  \returns reference
+   */
+  VectorMap& operator=(const VectorMap& other) {
+    map_ = other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Loads the coordinates into a vector.
+   *  \returns vector
+   */
+  VectorType eval() const {
+    return VectorType(typename VectorType::Implementation(map_));
+  }
+
+  /*! \brief Gets a lazy expression referring to the viewed coordinates, see Vector::lazy().
+   *  \returns lazy expression
+   */
+  VectorExpression<VectorType, Eigen::Map<const typename VectorType::Implementation, Eigen::Unaligned, Stride_>> lazy() const {
+    return VectorExpression<VectorType, Eigen::Map<const typename VectorType::Implementation, Eigen::Unaligned, Stride_>>(
+        Eigen::Map<const typename VectorType::Implementation, Eigen::Unaligned, Stride_>(map_.data(), map_.rows(), 1, stride_));
+  }
+
+  /*! \brief Addition and assignment of a vector in place.
+   * \param other   other vector
+   * \returns reference
+   */
+  VectorMap& operator+=(const VectorType& other) {
+    map_ += other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Subtraction and assignment of a vector in place.
+   * \param other   other vector
+   * \returns reference
+   */
+  VectorMap& operator-=(const VectorType& other) {
+    map_ -= other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Multiplication with a scalar in place.
+   * \param factor   factor
+   * \returns reference
+   */
+  VectorMap& operator*=(Scalar factor) {
+    map_ *= factor;
+    return *this;
+  }
+
+  /*! \brief Division by a scalar in place.
+   * \param divisor   divisor
+   * \returns reference
+   */
+  VectorMap& operator/=(Scalar divisor) {
+    map_ /= divisor;
+    return *this;
+  }
+
+  /*! \brief Addition of a vector.
+   * \param other   other vector
+   * \returns sum
+   */
+  VectorType operator+(const VectorType& other) const {
+    return VectorType(typename VectorType::Implementation(map_ + other.toImplementation()));
+  }
+
+  /*! \brief Subtraction of a vector.
+   * \param other   other vector
+   * \returns difference
+   */
+  VectorType operator-(const VectorType& other) const {
+    return VectorType(typename VectorType::Implementation(map_ - other.toImplementation()));
+  }
+
+  /*! \brief Sets all viewed coordinates to zero.
+   * \returns reference
+   */
+  VectorMap& setZero() {
+    map_.setZero();
+    return *this;
+  }
+
+  /*! \brief Get/set values.
+   */
+  inline auto operator()(int i) const -> decltype(std::declval<const Implementation&>()(i)) {
+    return map_(i);
+  }
+
+  /*! \brief Get/set values.
+   */
+  inline auto operator()(int i) -> decltype(std::declval<Implementation&>()(i)) {
+    return map_(i);
+  }
+
+  /*! \brief Norm of the viewed vector.
+   *  \returns norm.
+   */
+  Scalar norm() const {
+    return map_.norm();
+  }
+
+  /*! \brief Squared norm of the viewed vector.
+   *  \returns squared norm.
+   */
+  Scalar squaredNorm() const {
+    return map_.squaredNorm();
+  }
+
+  /*! \brief Gets the pointer to the first viewed coordinate.
+   *  \returns pointer
+   */
+  inline PointerType data() const {
+    return map_.data();
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline Implementation& toImplementation() {
+    return map_;
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline const Implementation& toImplementation() const {
+    return map_;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const VectorMap& vector) {
+    out << vector.toImplementation().transpose();
+    return out;
+  }
+
+ private:
+  Implementation map_;
+  Stride_ stride_;
+};
+
+//! \brief View of a position stored in external memory
+template<typename PrimType_, int Dimension_, typename Stride_ = Eigen::InnerStride<1>>
+using PositionMap = VectorMap<Position<PrimType_, Dimension_>, Stride_>;
+//! \brief View of a velocity stored in external memory
+template<typename PrimType_, int Dimension_, typename Stride_ = Eigen::InnerStride<1>>
+using VelocityMap = VectorMap<Velocity<PrimType_, Dimension_>, Stride_>;
+//! \brief View of a force stored in external memory
+template<typename PrimType_, int Dimension_, typename Stride_ = Eigen::InnerStride<1>>
+using ForceMap = VectorMap<Force<PrimType_, Dimension_>, Stride_>;
+//! \brief View of a torque stored in external memory
+template<typename PrimType_, int Dimension_, typename Stride_ = Eigen::InnerStride<1>>
+using TorqueMap = VectorMap<Torque<PrimType_, Dimension_>, Stride_>;
+
+//! \brief View of a 3D-position with primitive type double
+typedef PositionMap<double, 3> Position3DMap;
+//! \brief View of a 3D-position with primitive type float
+typedef PositionMap<float, 3> Position3FMap;
+
+} // namespace kindr
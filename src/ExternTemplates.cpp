@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include "kindr/Core"
+
+/* Explicit instantiation definitions of the templates declared in kindr/common/ExternTemplates.hpp.
+ */
+
+#define KINDR_INSTANTIATE_CLASS(Class_, PrimType_) template class Class_<PrimType_>;
+#define KINDR_INSTANTIATE_VECTOR(PhysicalType_, PrimType_) template class Vector<PhysicalType::PhysicalType_, PrimType_, 3>;
+#define KINDR_INSTANTIATE_POSE(Rotation_, PrimType_) template class HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, Rotation_<PrimType_>>;
+#define KINDR_INSTANTIATE_CONVERSION(Dest_, Source_, PrimType_) template class internal::ConversionTraits<Dest_<PrimType_>, Source_<PrimType_>>;
+
+namespace kindr {
+KINDR_FOR_EACH_PRECOMPILED_INSTANTIATION(KINDR_INSTANTIATE_CLASS, KINDR_INSTANTIATE_VECTOR, KINDR_INSTANTIATE_POSE, KINDR_INSTANTIATE_CONVERSION)
+} // namespace kindr
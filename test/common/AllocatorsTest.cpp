@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <cstdint>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <kindr/Core>
+
+template<typename T>
+static bool isAligned(const T* pointer) {
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignof(T) == 0;
+}
+
+// Types with a private Eigen base or an aligned member can be allocated with new
+TEST(AllocatorsTest, AlignedOperatorNew) {
+  std::unique_ptr<kindr::RotationQuaternionD> rotationQuaternion(new kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.1, 0.2, 0.3)));
+  std::unique_ptr<kindr::RotationMatrixD> rotationMatrix(new kindr::RotationMatrixD(*rotationQuaternion));
+  std::unique_ptr<kindr::QuaternionD> quaternion(new kindr::QuaternionD(1.0, 2.0, 3.0, 4.0));
+  std::unique_ptr<kindr::RotationQuaternionDiffD> rotationQuaternionDiff(new kindr::RotationQuaternionDiffD());
+  std::unique_ptr<kindr::RotationMatrixDiffD> rotationMatrixDiff(new kindr::RotationMatrixDiffD());
+  std::unique_ptr<kindr::TwistLocalD> twist(new kindr::TwistLocalD());
+  std::unique_ptr<kindr::HomTransformQuatD[]> poses(new kindr::HomTransformQuatD[3]);
+  EXPECT_TRUE(isAligned(rotationQuaternion.get()));
+  EXPECT_TRUE(isAligned(quaternion.get()));
+  EXPECT_TRUE(isAligned(&poses[1]));
+  EXPECT_TRUE(rotationMatrix->isNear(*rotationQuaternion, 1e-12));
+}
+
+TEST(AllocatorsTest, AlignedContainers) {
+  kindr::AlignedVector<kindr::HomTransformQuatD> poses;
+  kindr::AlignedMap<int, kindr::RotationQuaternionD> rotations;
+  for (int i = 0; i < 100; ++i) {
+    poses.push_back(kindr::HomTransformQuatD(kindr::Position3D(i, 0.0, 0.0), kindr::RotationQuaternionD()));
+    rotations[i] = kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.01*i, 0.0, 0.0));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(isAligned(&poses[i].getRotation()));
+    EXPECT_TRUE(isAligned(&rotations[i]));
+    EXPECT_EQ(double(i), poses[i].getPosition().x());
+  }
+}
+
+TEST(AllocatorsTest, MonotonicArena) {
+  kindr::MonotonicArena arena(256);
+  EXPECT_EQ(256u, arena.getCapacity());
+
+  // Allocations are aligned and do not overlap
+  char* first = static_cast<char*>(arena.allocate(3, 1));
+  char* second = static_cast<char*>(arena.allocate(40, 32));
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(second) % 32);
+  EXPECT_GE(second, first + 3);
+
+  // The arena grows if a block is exhausted and merges the blocks on reset
+  arena.allocate(1000, 16);
+  EXPECT_EQ(2, arena.getNumBlocks());
+  const std::size_t capacity = arena.getCapacity();
+  arena.reset();
+  EXPECT_EQ(1, arena.getNumBlocks());
+  EXPECT_EQ(capacity, arena.getCapacity());
+
+  // The same cycle does not grow the arena anymore
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    arena.allocate(3, 1);
+    arena.allocate(40, 32);
+    arena.allocate(1000, 16);
+    EXPECT_EQ(1, arena.getNumBlocks());
+    arena.reset();
+  }
+}
+
+TEST(AllocatorsTest, ArenaContainers) {
+  kindr::MonotonicArena arena(1024);
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    const kindr::ArenaAllocator<kindr::RotationQuaternionD> rotationAllocator(arena);
+    const kindr::ArenaAllocator<std::pair<const int, kindr::HomTransformQuatD>> poseAllocator(arena);
+    kindr::ArenaVector<kindr::RotationQuaternionD> rotations(rotationAllocator);
+    kindr::ArenaMap<int, kindr::HomTransformQuatD> poses(std::less<int>(), poseAllocator);
+    for (int i = 0; i < 50; ++i) {
+      rotations.push_back(kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.02*i, 0.0, 0.0)));
+      poses[i] = kindr::HomTransformQuatD(kindr::Position3D(i, 0.0, 0.0), rotations.back());
+    }
+    for (int i = 0; i < 50; ++i) {
+      EXPECT_TRUE(isAligned(&rotations[i]));
+      EXPECT_TRUE(isAligned(&poses[i]));
+      EXPECT_NEAR(0.02*i, kindr::EulerAnglesZyxD(poses[i].getRotation()).yaw(), 1e-12);
+    }
+    if (cycle > 0) {
+      EXPECT_EQ(1, arena.getNumBlocks());
+    }
+    rotations.clear();
+    rotations.shrink_to_fit();
+    poses.clear();
+    arena.reset();
+  }
+}
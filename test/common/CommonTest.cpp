@@ -29,6 +29,7 @@
 
 #include <gtest/gtest.h>
 #include <kindr/common/common.hpp>
+#include <kindr/common/assert_macros.hpp>
 
 TEST (CommonTest, wrapPosNegPI) {
 
@@ -41,3 +42,74 @@ TEST (CommonTest, wrapPosNegPI) {
   double angle2 = kindr::wrapPosNegPI(-2.0*M_PI+h2);
   EXPECT_NEAR(h2 , angle2, 1.0e-10);
 }
+
+static double inverseWithHotAssert(double value) {
+  KINDR_ASSERT_TRUE_HOT(std::runtime_error, value != 0.0, "Value " << value << " is zero.");
+  return 1.0/value;
+}
+
+TEST (CommonTest, assertTrueHot) {
+  EXPECT_EQ(0.5, inverseWithHotAssert(2.0));
+#ifndef KINDR_NO_EXCEPTIONS
+  try {
+    inverseWithHotAssert(0.0);
+    FAIL() << "No exception was thrown.";
+  } catch (const std::runtime_error& e) {
+    const std::string message(e.what());
+    EXPECT_NE(std::string::npos, message.find("inverseWithHotAssert"));
+    EXPECT_NE(std::string::npos, message.find("Value 0 is zero."));
+  }
+#endif
+}
+
+//! Expects a wrapped angle in [x1..x2) which is equal to the scalar result up to the period
+template<typename T>
+static void expectWrapped(T expected, T actual, T x1, T x2, T tol, int i) {
+  EXPECT_LE(x1, actual) << "angle " << i;
+  EXPECT_GT(x2, actual) << "angle " << i;
+  const T difference = std::abs(expected - actual);
+  EXPECT_NEAR(0, std::min(difference, x2 - x1 - difference), tol) << "angle " << i;
+}
+
+TEST (CommonTest, wrapArray) {
+  // boundary cases of floatingPointModulo() and random angles
+  Eigen::ArrayXd angles = 20.0*Eigen::ArrayXd::Random(200);
+  angles.head(8) << 2.0*M_PI - 1.0e-8, -2.0*M_PI + 1.0e-8, -1.0e-16, 1.0e-16, M_PI, -M_PI, 106.81415022205296, -106.81415022205296;
+
+  const Eigen::ArrayXd posNegPi = kindr::wrapPosNegPIArray(angles);
+  const Eigen::ArrayXd twoPi = kindr::wrapTwoPIArray(angles);
+  const Eigen::ArrayXd range = kindr::wrapAngleArray(angles, -1.0, 5.0);
+  const Eigen::ArrayXd modulo = kindr::floatingPointModuloArray(angles, 3.0);
+  for (int i = 0; i < angles.size(); ++i) {
+    expectWrapped(kindr::wrapPosNegPI(angles(i)), posNegPi(i), -M_PI, M_PI, 1.0e-12, i);
+    expectWrapped(kindr::wrapTwoPI(angles(i)), twoPi(i), 0.0, 2.0*M_PI, 1.0e-12, i);
+    expectWrapped(kindr::wrapAngle(angles(i), -1.0, 5.0), range(i), -1.0, 5.0, 1.0e-12, i);
+    expectWrapped(kindr::floatingPointModulo(angles(i), 3.0), modulo(i), 0.0, 3.0, 1.0e-12, i);
+  }
+
+  const Eigen::ArrayXf anglesF = angles.cast<float>();
+  const Eigen::ArrayXf posNegPiF = kindr::wrapPosNegPIArray(anglesF);
+  for (int i = 0; i < anglesF.size(); ++i) {
+    expectWrapped(kindr::wrapPosNegPI(anglesF(i)), posNegPiF(i), float(-M_PI), float(M_PI), 1.0e-5f, i);
+  }
+}
+
+TEST (CommonTest, unwrapArray) {
+  // a yaw angle turning three times, logged wrapped to [-pi,pi)
+  const int size = 1000;
+  const Eigen::ArrayXd continuous = Eigen::ArrayXd::LinSpaced(size, -3.0, 3.0 + 6.0*M_PI) + 0.1*Eigen::ArrayXd::Random(size);
+  const Eigen::ArrayXd unwrapped = kindr::unwrapAngleArray(kindr::wrapPosNegPIArray(continuous));
+  const double offset = unwrapped(0) - continuous(0);
+  for (int i = 0; i < size; ++i) {
+    EXPECT_NEAR(continuous(i) + offset, unwrapped(i), 1.0e-9) << "angle " << i;
+  }
+
+  // rows of a row-major matrix
+  Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor> angles(3, size);
+  angles.row(1) = kindr::wrapPosNegPIArray(continuous.transpose()).matrix();
+  angles.row(1) = kindr::unwrapAngleArray(angles.row(1).array()).matrix();
+  EXPECT_TRUE(angles.row(1).transpose().isApprox(unwrapped.matrix()));
+
+  EXPECT_EQ(0, kindr::unwrapAngleArray(Eigen::ArrayXd()).size());
+  EXPECT_EQ(1.0, kindr::unwrapAngleArray(Eigen::ArrayXd::Constant(1, 1.0))(0));
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <kindr/common/Executor.hpp>
+
+// Every item is visited exactly once and the chunks respect the grain size
+template<typename Executor_>
+void checkParallelFor(const Executor_& executor, int begin, int end, int grainSize) {
+  std::vector<std::atomic<int>> visits(end);
+  for (std::atomic<int>& visit : visits) {
+    visit = 0;
+  }
+  std::atomic<int> numShortChunks(0);
+  executor.parallelFor(begin, end, grainSize, [&](int chunkBegin, int chunkEnd) {
+    ASSERT_LE(begin, chunkBegin);
+    ASSERT_LT(chunkBegin, chunkEnd);
+    ASSERT_LE(chunkEnd, end);
+    if (chunkEnd - chunkBegin < grainSize) {
+      ++numShortChunks;
+    }
+    for (int i = chunkBegin; i < chunkEnd; ++i) {
+      ++visits[i];
+    }
+  });
+  for (int i = 0; i < end; ++i) {
+    EXPECT_EQ(i < begin ? 0 : 1, visits[i].load()) << "item " << i;
+  }
+  EXPECT_LE(numShortChunks.load(), 1);
+}
+
+TEST(ExecutorTest, testSerialExecutor) {
+  const kindr::SerialExecutor executor;
+  checkParallelFor(executor, 0, 1000, 64);
+  checkParallelFor(executor, 10, 11, 64);
+  checkParallelFor(executor, 5, 5, 64);
+}
+
+TEST(ExecutorTest, testThreadPoolExecutor) {
+  const kindr::ThreadPoolExecutor executor(4);
+  EXPECT_EQ(4, executor.getNumThreads());
+  checkParallelFor(executor, 0, 100000, 64);
+  checkParallelFor(executor, 3, 1001, 1000);
+  checkParallelFor(executor, 0, 10, 1);
+  checkParallelFor(executor, 5, 5, 64);
+
+  // nested calls from within a chunk
+  std::atomic<int> sum(0);
+  executor.parallelFor(0, 16, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      executor.parallelFor(0, 100, 10, [&](int innerBegin, int innerEnd) {
+        sum += innerEnd - innerBegin;
+      });
+    }
+  });
+  EXPECT_EQ(1600, sum.load());
+
+  // a single thread runs everything on the calling thread
+  const kindr::ThreadPoolExecutor serialPool(1);
+  checkParallelFor(serialPool, 0, 1000, 64);
+}
+
+#ifdef _OPENMP
+TEST(ExecutorTest, testOpenMpExecutor) {
+  const kindr::OpenMpExecutor executor;
+  checkParallelFor(executor, 0, 100000, 64);
+  checkParallelFor(executor, 3, 1001, 1000);
+}
+#endif
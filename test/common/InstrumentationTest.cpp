@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <kindr/Core>
+
+namespace rot = kindr;
+
+namespace {
+std::vector<std::string> hookCalls;
+
+void recordRoundTrips(rot::InstrumentedOperation operation, const char* function) {
+  if (operation == rot::InstrumentedOperation::MultiplicationRoundTrip) {
+    hookCalls.push_back(function);
+  }
+}
+}
+
+TEST(InstrumentationTest, testCounters) {
+  ASSERT_TRUE(rot::isInstrumentationEnabled());
+  rot::resetThreadInstrumentationCounters();
+  const rot::EulerAnglesZyxD eulerAngles(0.3, -0.2, 0.1);
+  const rot::InstrumentationCounters start = rot::getThreadInstrumentationCounters();
+
+  // Two conversions to quaternions and one back
+  const rot::EulerAnglesZyxD product = eulerAngles*eulerAngles;
+  rot::RotationQuaternionD quaternion(product);
+  quaternion.fix();
+  const rot::RotationQuaternionD unique = quaternion.getUnique();
+  rot::RotationMatrixD matrix;
+  matrix = unique;
+
+  const rot::InstrumentationCounters cycle = rot::getThreadInstrumentationCounters() - start;
+  EXPECT_EQ(1u, cycle.getCount(rot::InstrumentedOperation::MultiplicationRoundTrip));
+  EXPECT_EQ(5u, cycle.getCount(rot::InstrumentedOperation::Conversion));
+  EXPECT_EQ(1u, cycle.getCount(rot::InstrumentedOperation::Fixing));
+  EXPECT_EQ(1u, cycle.getCount(rot::InstrumentedOperation::Unique));
+#ifdef KINDR_ENABLE_INSTRUMENTATION_TIMING
+  // The round trip includes its conversions
+  EXPECT_GT(cycle.getTicks(rot::InstrumentedOperation::MultiplicationRoundTrip), 0u);
+#else
+  EXPECT_EQ(0u, cycle.getTicks(rot::InstrumentedOperation::MultiplicationRoundTrip));
+#endif
+
+  rot::resetThreadInstrumentationCounters();
+  EXPECT_EQ(0u, rot::getThreadInstrumentationCounters().getCount(rot::InstrumentedOperation::Conversion));
+}
+
+TEST(InstrumentationTest, testHook) {
+  hookCalls.clear();
+  rot::setThreadInstrumentationHook(&recordRoundTrips);
+  const rot::AngleAxisD angleAxis(0.3, 0.0, 0.0, 1.0);
+  const rot::RotationVectorD rotationVector(0.1, 0.2, 0.3);
+  const rot::AngleAxisD product = angleAxis*rotationVector;
+  rot::setThreadInstrumentationHook(nullptr);
+  const rot::AngleAxisD other = angleAxis*rotationVector;
+  ASSERT_TRUE(product.isNear(other, 1e-12));
+  ASSERT_EQ(1u, hookCalls.size());
+  EXPECT_NE(std::string::npos, hookCalls[0].find("AngleAxis")) << hookCalls[0];
+  EXPECT_NE(std::string::npos, hookCalls[0].find("RotationVector")) << hookCalls[0];
+}
+
+TEST(InstrumentationTest, testThreadLocal) {
+  rot::resetThreadInstrumentationCounters();
+  std::uint64_t otherCount = 0;
+  std::thread thread([&otherCount]() {
+    for (int i = 0; i < 10; ++i) {
+      rot::RotationQuaternionD quaternion(rot::EulerAnglesZyxD(0.1*i, 0.0, 0.0));
+      quaternion.fix();
+    }
+    otherCount = rot::getThreadInstrumentationCounters().getCount(rot::InstrumentedOperation::Fixing);
+  });
+  thread.join();
+  EXPECT_EQ(10u, otherCount);
+  EXPECT_EQ(0u, rot::getThreadInstrumentationCounters().getCount(rot::InstrumentedOperation::Fixing));
+}
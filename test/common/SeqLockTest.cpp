@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <kindr/common/SeqLock.hpp>
+#include <kindr/common/gtest_eigen.hpp>
+
+typedef std::pair<kindr::HomTransformQuatD, kindr::TwistLocalD> PoseAndTwist;
+
+// Pose and twist whose coefficients all follow from i, such that a torn copy is detected
+static PoseAndTwist getState(int i) {
+  const double a = 0.001*i;
+  return PoseAndTwist(kindr::HomTransformQuatD(kindr::Position3D(a, 2.0*a, 3.0*a), kindr::RotationQuaternionD(kindr::AngleAxisD(a, 0.0, 0.0, 1.0))),
+                      kindr::TwistLocalD(Eigen::Vector3d(a, -a, 0.5*a), Eigen::Vector3d(-2.0*a, a, a)));
+}
+
+static bool isConsistent(const PoseAndTwist& state) {
+  const PoseAndTwist expected = getState(static_cast<int>(std::lround(1000.0*state.first.getPosition().x())));
+  return state.first.getPosition().toImplementation() == expected.first.getPosition().toImplementation()
+      && state.first.getRotation().toImplementation().coeffs() == expected.first.getRotation().toImplementation().coeffs()
+      && state.second.getVector() == expected.second.getVector();
+}
+
+TEST(SeqLockTest, testStoreLoad)
+{
+  kindr::SeqLock<PoseAndTwist> lock(getState(3));
+  ASSERT_EQ(0u, lock.getVersion());
+  ASSERT_TRUE(isConsistent(lock.load()));
+  KINDR_ASSERT_DOUBLE_MX_EQ(getState(3).first.getPosition().toImplementation(), lock.load().first.getPosition().toImplementation(), 1e-12, "initial");
+
+  lock.store(getState(7));
+  PoseAndTwist state;
+  ASSERT_EQ(1u, lock.load(state));
+  ASSERT_TRUE(state.first.getRotation().isNear(getState(7).first.getRotation(), 1e-12));
+  KINDR_ASSERT_DOUBLE_MX_EQ(getState(7).second.getVector(), state.second.getVector(), 1e-12, "twist");
+  ASSERT_TRUE(lock.tryLoad(state));
+  ASSERT_TRUE(isConsistent(state));
+
+  kindr::SeqLock<kindr::WrenchD> wrenchLock;
+  wrenchLock.store(kindr::WrenchD(Eigen::Vector3d(1.0, 2.0, 3.0), Eigen::Vector3d(4.0, 5.0, 6.0)));
+  KINDR_ASSERT_DOUBLE_MX_EQ((Eigen::Matrix<double, 6, 1>() << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0).finished(), wrenchLock.load().getVector(), 1e-12, "wrench");
+}
+
+TEST(SeqLockTest, testConcurrentReaders)
+{
+  // Readers never see a torn state while the writer publishes continuously
+  kindr::SeqLock<PoseAndTwist> lock(getState(0));
+  std::atomic<bool> done(false);
+  std::atomic<int> numTorn(0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r) {
+    readers.emplace_back([&]() {
+      std::uint64_t lastVersion = 0;
+      while (!done.load()) {
+        PoseAndTwist state;
+        const std::uint64_t version = lock.load(state);
+        if (!isConsistent(state) || version < lastVersion) {
+          ++numTorn;
+        }
+        lastVersion = version;
+      }
+    });
+  }
+  for (int i = 1; i <= 20000; ++i) {
+    lock.store(getState(i % 1000));
+  }
+  done = true;
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(0, numTorn.load());
+  ASSERT_EQ(20000u, lock.getVersion());
+}
@@ -91,4 +91,117 @@ TEST (ColPseudoInverseTest, testVector) {
 
   KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pinvA, expectedPinvA, 2e-3, 0, "");
 	KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pinvAd, expectedPinvAd, 2e-3, 0, "");
-}
\ No newline at end of file
+}
+
+template<typename Matrix_>
+static Matrix_ getContactJacobian() {
+  Matrix_ jacobian;
+  for (int i = 0; i < jacobian.rows(); ++i) {
+    for (int j = 0; j < jacobian.cols(); ++j) {
+      jacobian(i, j) = std::sin(1.0 + 0.7*i + 1.3*j*j) + (i == j ? 1.0 : 0.0);
+    }
+  }
+  return jacobian;
+}
+
+template<typename Matrix_, kindr::PseudoInverseMethod Method_>
+static void testWorkspace(const Matrix_& a, double tolerance) {
+  typedef Eigen::Matrix<double, Matrix_::ColsAtCompileTime, Matrix_::RowsAtCompileTime> Inverse;
+  Eigen::MatrixXd ad = a;
+  Eigen::MatrixXd expectedPinvA;
+  kindr::pseudoInverse(ad, expectedPinvA);
+
+  kindr::PseudoInverseWorkspace<Matrix_, Method_> workspace;
+  Inverse pinvA;
+  bool isSuccessful = false;
+  Eigen::internal::set_is_malloc_allowed(Method_ == kindr::PseudoInverseMethod::BdcSvd);
+  for (int i = 0; i < 3; ++i) {
+    isSuccessful = kindr::pseudoInverse(a, pinvA, workspace);
+  }
+  Eigen::internal::set_is_malloc_allowed(true);
+  ASSERT_TRUE(isSuccessful);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pinvA, Inverse(expectedPinvA), tolerance, 0, "");
+
+  // Dynamic size workspace
+  kindr::PseudoInverseWorkspace<Eigen::MatrixXd, Method_> dynamicWorkspace(a.rows(), a.cols());
+  Eigen::MatrixXd pinvAd;
+  ASSERT_TRUE(dynamicWorkspace.compute(ad, pinvAd));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pinvAd, expectedPinvA, tolerance, 0, "");
+}
+
+template<typename Matrix_>
+static void testAllMethods() {
+  const Matrix_ a = getContactJacobian<Matrix_>();
+  testWorkspace<Matrix_, kindr::PseudoInverseMethod::JacobiSvd>(a, 1e-10);
+  testWorkspace<Matrix_, kindr::PseudoInverseMethod::BdcSvd>(a, 1e-10);
+  testWorkspace<Matrix_, kindr::PseudoInverseMethod::CompleteOrthogonalDecomposition>(a, 1e-10);
+  testWorkspace<Matrix_, kindr::PseudoInverseMethod::ClosedForm>(a, 1e-8);
+  testWorkspace<Matrix_, kindr::PseudoInverseMethod::DampedLeastSquares>(a, 1e-8);
+}
+
+TEST (PseudoInverseWorkspaceTest, testMethods) {
+  testAllMethods<Eigen::Matrix3d>();
+  testAllMethods<Eigen::Matrix<double, 6, 6>>();
+  testAllMethods<Eigen::Matrix<double, 3, 6>>();
+  testAllMethods<Eigen::Matrix<double, 6, 3>>();
+  testAllMethods<Eigen::Matrix<double, 6, 12>>();
+}
+
+TEST (PseudoInverseWorkspaceTest, testFixedSizeDoesNotAllocate) {
+  const Eigen::Matrix<double, 3, 6> a = getContactJacobian<Eigen::Matrix<double, 3, 6>>();
+  Eigen::Matrix<double, 6, 3> pinvA;
+  Eigen::internal::set_is_malloc_allowed(false);
+  kindr::pseudoInverse(a, pinvA);
+  Eigen::internal::set_is_malloc_allowed(true);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(a*pinvA, Eigen::Matrix3d::Identity(), 1e-10, 0, "");
+}
+
+TEST (PseudoInverseWorkspaceTest, testRankDeficient) {
+  // The third row is the sum of the first two
+  Eigen::Matrix<double, 3, 6> a = getContactJacobian<Eigen::Matrix<double, 3, 6>>();
+  a.row(2) = a.row(0) + a.row(1);
+  Eigen::Matrix<double, 6, 3> expectedPinvA;
+  kindr::pseudoInverse(a, expectedPinvA, 1e-10);
+
+  Eigen::Matrix<double, 6, 3> pinvA;
+  kindr::PseudoInverseWorkspace<Eigen::Matrix<double, 3, 6>, kindr::PseudoInverseMethod::CompleteOrthogonalDecomposition> codWorkspace;
+  codWorkspace.setEpsilon(1e-10);
+  ASSERT_TRUE(codWorkspace.compute(a, pinvA));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pinvA, expectedPinvA, 1e-8, 0, "");
+
+  kindr::PseudoInverseWorkspace<Eigen::Matrix<double, 3, 6>, kindr::PseudoInverseMethod::ClosedForm> closedFormWorkspace;
+  EXPECT_FALSE(closedFormWorkspace.compute(a, pinvA));
+  kindr::PseudoInverseWorkspace<Eigen::Matrix3d, kindr::PseudoInverseMethod::ClosedForm> squareWorkspace;
+  Eigen::Matrix3d pinvSquare;
+  EXPECT_FALSE(squareWorkspace.compute(a.leftCols<3>(), pinvSquare));
+}
+
+TEST (PseudoInverseWorkspaceTest, testIllConditionedWithLargeCholeskyDiagonal) {
+  // The Kahan matrix is its own Cholesky factor with a mildly decaying diagonal, but it is numerically singular
+  const int n = 60;
+  const double c = 0.6;
+  const double s = 0.8;
+  Eigen::MatrixXd a = Eigen::MatrixXd::Zero(n, n);
+  for (int i = 0; i < n; ++i) {
+    a(i, i) = std::pow(s, i);
+    for (int j = i + 1; j < n; ++j) {
+      a(i, j) = -c*std::pow(s, i);
+    }
+  }
+  Eigen::MatrixXd pinvA;
+  kindr::PseudoInverseWorkspace<Eigen::MatrixXd, kindr::PseudoInverseMethod::ClosedForm> workspace;
+  EXPECT_FALSE(workspace.compute(a, pinvA));
+}
+
+TEST (PseudoInverseWorkspaceTest, testDampedLeastSquares) {
+  // The damped inverse stays bounded at a singularity
+  Eigen::Matrix<double, 3, 6> a = getContactJacobian<Eigen::Matrix<double, 3, 6>>();
+  a.row(2) = a.row(0) + a.row(1);
+  kindr::PseudoInverseWorkspace<Eigen::Matrix<double, 3, 6>, kindr::PseudoInverseMethod::DampedLeastSquares> workspace;
+  workspace.setDamping(0.1);
+  EXPECT_EQ(0.1, workspace.getDamping());
+  Eigen::Matrix<double, 6, 3> pinvA;
+  ASSERT_TRUE(workspace.compute(a, pinvA));
+  const Eigen::Matrix<double, 6, 3> expectedPinvA = a.transpose()*(a*a.transpose() + 0.01*Eigen::Matrix3d::Identity()).inverse();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pinvA, expectedPinvA, 1e-10, 0, "");
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+/* Helpers of the performance guards, which compare the time per call of an operation against a reference operation
+ * measured in the same process. Only ratios are asserted, such that the bounds hold on any machine, and both times are
+ * recorded as properties of the test in the XML output of gtest. The environment variable KINDR_PERF_TOLERANCE
+ * scales all bounds, e.g. on a loaded CI machine.
+ */
+
+namespace kindr_perf {
+
+//! Keeps the compiler from optimizing away a value which is never read.
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+//! \returns the factor by which all bounds are scaled
+inline double getTolerance() {
+  const char* tolerance = std::getenv("KINDR_PERF_TOLERANCE");
+  return tolerance == nullptr ? 1.0 : std::atof(tolerance);
+}
+
+/*! \brief Measures the minimum time per call of two operations in nanoseconds.
+ *  The operations are timed alternately in several repetitions, such that both see the same load of the machine,
+ *  and the minimum filters out interruptions.
+ */
+template<typename Candidate_, typename Reference_>
+void measure(const Candidate_& candidate, const Reference_& reference, int iterations, double& candidateTime, double& referenceTime,
+             int repetitions = 21) {
+  typedef std::chrono::steady_clock Clock;
+  candidateTime = std::numeric_limits<double>::max();
+  referenceTime = std::numeric_limits<double>::max();
+  for (int r = 0; r < repetitions; ++r) {
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      candidate();
+    }
+    candidateTime = std::min(candidateTime, std::chrono::duration<double, std::nano>(Clock::now() - start).count()/iterations);
+    start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      reference();
+    }
+    referenceTime = std::min(referenceTime, std::chrono::duration<double, std::nano>(Clock::now() - start).count()/iterations);
+  }
+}
+
+/*! \brief Checks that the candidate operation takes at most factor times as long as the reference operation.
+ *  Both times are recorded as <name>Ns and <name>ReferenceNs in the XML output.
+ *  \param name         name of the guarded operation
+ *  \param candidate    operation to guard
+ *  \param reference    operation of comparison
+ *  \param factor       maximum ratio of the times, < 1 to require a speedup
+ *  \param iterations   calls per timed repetition
+ */
+template<typename Candidate_, typename Reference_>
+::testing::AssertionResult isAtMostTimesSlower(const std::string& name, const Candidate_& candidate, const Reference_& reference,
+                                               double factor, int iterations) {
+  double candidateTime, referenceTime;
+  measure(candidate, reference, iterations, candidateTime, referenceTime);
+  ::testing::Test::RecordProperty(name + "Ns", std::to_string(candidateTime));
+  ::testing::Test::RecordProperty(name + "ReferenceNs", std::to_string(referenceTime));
+  const double bound = factor*getTolerance();
+  if (candidateTime <= bound*referenceTime) {
+    return ::testing::AssertionSuccess();
+  }
+  return ::testing::AssertionFailure() << name << " takes " << candidateTime << " ns, which is " << candidateTime/referenceTime
+      << " times the " << referenceTime << " ns of the reference, but at most " << bound << " times are allowed.";
+}
+
+} // namespace kindr_perf
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "PerformanceTest.hpp"
+
+/* Performance guards of the poses, see PerformanceTest.hpp. The bounds are about twice the ratios measured with
+ * -O2 -DNDEBUG on x86-64.
+ */
+
+//! Adjoint matrix of a pose acting on [v; w]
+static Eigen::Matrix<double, 6, 6> getAdjointMatrix(const kindr::HomTransformQuatD& pose) {
+  const Eigen::Matrix3d rotationMatrix = kindr::RotationMatrixD(pose.getRotation()).matrix();
+  Eigen::Matrix<double, 6, 6> adjoint = Eigen::Matrix<double, 6, 6>::Zero();
+  adjoint.topLeftCorner<3,3>() = rotationMatrix;
+  adjoint.topRightCorner<3,3>() = kindr::getSkewMatrixFromVector(pose.getPosition().toImplementation())*rotationMatrix;
+  adjoint.bottomRightCorner<3,3>() = rotationMatrix;
+  return adjoint;
+}
+
+TEST(PosePerformanceTest, testTransformTwist)
+{
+  const kindr::HomTransformQuatD pose(kindr::Position3D(1.0, -0.5, 0.2), kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.3, -0.2, 0.5)));
+  const kindr::TwistLocalD twist(Eigen::Vector3d(0.4, -0.1, 0.7), Eigen::Vector3d(0.2, 0.3, -0.5));
+  const Eigen::Matrix<double, 6, 1> vector = twist.getVector();
+  kindr::TwistLocalD result;
+  Eigen::Matrix<double, 6, 1> resultVector;
+  EXPECT_TRUE(kindr_perf::isAtMostTimesSlower("transformTwist",
+      [&]() { kindr_perf::doNotOptimize(pose); kindr_perf::doNotOptimize(twist); result = kindr::transformTwist(pose, twist); kindr_perf::doNotOptimize(result); },
+      [&]() { kindr_perf::doNotOptimize(pose); kindr_perf::doNotOptimize(vector); resultVector = getAdjointMatrix(pose)*vector; kindr_perf::doNotOptimize(resultVector); },
+      1.6, 10000));
+}
+
+TEST(PosePerformanceTest, testRotateJacobian)
+{
+  const kindr::RotationQuaternionD rotation(kindr::EulerAnglesZyxD(0.3, -0.2, 0.5));
+  Eigen::Matrix<double, 6, Eigen::Dynamic> jacobian = Eigen::Matrix<double, 6, Eigen::Dynamic>::Random(6, 1000);
+  EXPECT_TRUE(kindr_perf::isAtMostTimesSlower("rotateJacobian",
+      [&]() { kindr_perf::doNotOptimize(rotation); kindr::rotateTwistsToGlobal(rotation, jacobian); kindr_perf::doNotOptimize(jacobian.data()); },
+      [&]() {
+        kindr_perf::doNotOptimize(rotation);
+        Eigen::Matrix<double, 6, 6> rotation6 = Eigen::Matrix<double, 6, 6>::Zero();
+        rotation6.topLeftCorner<3,3>() = kindr::RotationMatrixD(rotation).matrix();
+        rotation6.bottomRightCorner<3,3>() = rotation6.topLeftCorner<3,3>();
+        jacobian = rotation6*jacobian;
+        kindr_perf::doNotOptimize(jacobian.data());
+      },
+      1.5, 50));
+}
+
+TEST(PosePerformanceTest, testTransformBatch)
+{
+  // measured about 0.8, the translation is added in the same pass as the product
+  const kindr::HomTransformQuatD pose(kindr::Position3D(1.0, -0.5, 0.2), kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.3, -0.2, 0.5)));
+  const Eigen::Matrix3d rotationMatrix = kindr::RotationMatrixD(pose.getRotation()).matrix();
+  const Eigen::Vector3d translation = pose.getPosition().toImplementation();
+  const Eigen::Matrix3Xd positions = Eigen::Matrix3Xd::Random(3, 1000);
+  Eigen::Matrix3Xd transformed(3, positions.cols());
+  EXPECT_TRUE(kindr_perf::isAtMostTimesSlower("transformBatch",
+      [&]() { pose.transformBatch(positions, transformed); kindr_perf::doNotOptimize(transformed.data()); },
+      [&]() {
+        kindr_perf::doNotOptimize(rotationMatrix);
+        transformed.noalias() = (rotationMatrix*positions).colwise() + translation;
+        kindr_perf::doNotOptimize(transformed.data());
+      },
+      1.2, 20));
+}
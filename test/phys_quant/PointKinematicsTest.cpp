@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2017, Christian Gehring
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/phys_quant/PointKinematics.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename PrimType_>
+struct PointKinematicsTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  kindr::Velocity<Scalar, 3> velocity;
+  kindr::Acceleration<Scalar, 3> acceleration;
+  kindr::LocalAngularVelocity<Scalar> angularVelocity;
+  kindr::AngularAcceleration<Scalar, 3> angularAcceleration;
+  kindr::PositionArray<Scalar> positions;
+  kindr::VelocityArray<Scalar> relativeVelocities;
+  kindr::AccelerationArray<Scalar> relativeAccelerations;
+
+  PointKinematicsTest()
+    : velocity(0.4, -1.2, 0.3),
+      acceleration(-0.5, 0.2, 9.81),
+      angularVelocity(0.7, -0.2, 1.1),
+      angularAcceleration(-0.3, 0.8, 0.1) {
+  }
+
+  void setPoints(int size) {
+    positions.toImplementation().setRandom(3, size);
+    relativeVelocities.toImplementation().setRandom(3, size);
+    relativeAccelerations.toImplementation().setRandom(3, size);
+  }
+
+  Vector3 w() const {
+    return angularVelocity.toImplementation();
+  }
+
+  Vector3 dw() const {
+    return angularAcceleration.toImplementation();
+  }
+};
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+TYPED_TEST_CASE(PointKinematicsTest, PrimTypes);
+
+TYPED_TEST(PointKinematicsTest, testTransportVelocities)
+{
+  typedef typename TestFixture::Vector3 Vector3;
+  for (int size : {4, 300}) {
+    this->setPoints(size);
+    kindr::VelocityArray<typename TestFixture::Scalar> velocities, movingVelocities;
+    kindr::transportVelocities(this->velocity, this->angularVelocity, this->positions, velocities);
+    kindr::transportVelocities(this->velocity, this->angularVelocity, this->positions, this->relativeVelocities, movingVelocities);
+    ASSERT_EQ(size, velocities.size());
+    ASSERT_EQ(size, movingVelocities.size());
+    for (int i = 0; i < size; ++i) {
+      const Vector3 r = this->positions[i].toImplementation();
+      const Vector3 expected = this->velocity.toImplementation() + this->w().cross(r);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, velocities[i].toImplementation(), this->tol, this->tol, "fixed point");
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector3(expected + this->relativeVelocities[i].toImplementation()),
+                                        movingVelocities[i].toImplementation(), this->tol, this->tol, "moving point");
+    }
+  }
+}
+
+TYPED_TEST(PointKinematicsTest, testTransportAccelerations)
+{
+  typedef typename TestFixture::Vector3 Vector3;
+  for (int size : {4, 300}) {
+    this->setPoints(size);
+    kindr::AccelerationArray<typename TestFixture::Scalar> accelerations, movingAccelerations;
+    kindr::transportAccelerations(this->acceleration, this->angularVelocity, this->angularAcceleration, this->positions, accelerations);
+    kindr::transportAccelerations(this->acceleration, this->angularVelocity, this->angularAcceleration, this->positions,
+                                  this->relativeVelocities, this->relativeAccelerations, movingAccelerations);
+    ASSERT_EQ(size, accelerations.size());
+    ASSERT_EQ(size, movingAccelerations.size());
+    for (int i = 0; i < size; ++i) {
+      const Vector3 r = this->positions[i].toImplementation();
+      const Vector3 expected = this->acceleration.toImplementation() + this->dw().cross(r) + this->w().cross(this->w().cross(r));
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, accelerations[i].toImplementation(), this->tol, this->tol, "fixed point");
+      const Vector3 coriolis = 2*this->w().cross(this->relativeVelocities[i].toImplementation());
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector3(expected + coriolis + this->relativeAccelerations[i].toImplementation()),
+                                        movingAccelerations[i].toImplementation(), this->tol, this->tol, "moving point");
+    }
+  }
+}
+
+TEST(PointKinematicsDoubleTest, testFiniteDifferences)
+{
+  // Body rotating about a fixed axis with a non-constant rate and a point moving on the body, all expressed in the world frame
+  typedef Eigen::Vector3d Vector3;
+  const Vector3 axis = Vector3(0.3, -0.5, 0.8).normalized();
+  const Vector3 p0(0.1, 0.2, -0.3), v0(0.5, -0.4, 0.2), a0(-0.1, 0.3, 0.6);
+  const Vector3 s0(0.6, -0.2, 0.4), ds(0.3, 0.1, -0.5), dds(-0.2, 0.4, 0.1);
+  const double t = 0.4;
+  auto angle = [](double time) { return 0.8*time + 0.6*time*time; };
+  auto rotation = [&](double time) { return kindr::RotationMatrixD(kindr::AngleAxisD(angle(time), axis)); };
+  auto bodyPoint = [&](double time) { return Vector3(s0 + ds*time + 0.5*dds*time*time); };
+  auto pointPosition = [&](double time) {
+    return Vector3(p0 + v0*time + 0.5*a0*time*time + rotation(time).rotate(bodyPoint(time)));
+  };
+
+  const kindr::RotationMatrixD rotationT = rotation(t);
+  kindr::PositionArrayD positions(1);
+  positions.set(0, kindr::Position3D(rotationT.rotate(bodyPoint(t))));
+  kindr::VelocityArrayD relativeVelocities(1);
+  relativeVelocities.set(0, kindr::Velocity3D(rotationT.rotate(Vector3(ds + dds*t))));
+  kindr::AccelerationArrayD relativeAccelerations(1);
+  relativeAccelerations.set(0, kindr::Acceleration3D(rotationT.rotate(dds)));
+  const kindr::GlobalAngularVelocityD angularVelocity(axis*(0.8 + 1.2*t));
+  const kindr::AngularAcceleration3D angularAcceleration(axis*1.2);
+
+  kindr::VelocityArrayD velocities;
+  kindr::transportVelocities(kindr::Velocity3D(v0 + a0*t), angularVelocity, positions, relativeVelocities, velocities);
+  kindr::AccelerationArrayD accelerations;
+  kindr::transportAccelerations(kindr::Acceleration3D(a0), angularVelocity, angularAcceleration, positions,
+                                relativeVelocities, relativeAccelerations, accelerations);
+
+  const double h = 1e-4;
+  const Vector3 velocity = (pointPosition(t + h) - pointPosition(t - h))/(2*h);
+  const Vector3 acceleration = (pointPosition(t + h) - 2*pointPosition(t) + pointPosition(t - h))/(h*h);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(velocity, velocities[0].toImplementation(), 1e-6, 1e-6, "velocity");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(acceleration, accelerations[0].toImplementation(), 1e-5, 1e-5, "acceleration");
+}
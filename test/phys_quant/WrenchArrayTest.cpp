@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2017, Christian Gehring
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/phys_quant/WrenchArray.hpp"
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/SpatialAlgebra.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename PrimType_>
+struct WrenchArrayTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::Wrench6<Scalar> Wrench;
+  typedef kindr::WrenchArray<Scalar> WrenchArray;
+  typedef kindr::HomTransformQuat<Scalar> Pose;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-4) : Scalar(1e-10);
+
+  kindr::PositionArray<Scalar> positions;
+  kindr::RotationQuaternionArray<Scalar> rotations;
+  WrenchArray contactWrenches;
+
+  //! Sets random contact frames and wrenches
+  void setContacts(int size) {
+    positions.toImplementation().setRandom(3, size);
+    rotations.resize(size);
+    contactWrenches.resize(size);
+    contactWrenches.getForces().toImplementation().setRandom();
+    contactWrenches.getTorques().toImplementation().setRandom();
+    for (int i = 0; i < size; ++i) {
+      rotations.set(i, kindr::RotationQuaternion<Scalar>().setRandom());
+    }
+  }
+
+  //! \returns the pose of the i-th contact frame in the base frame
+  Pose getContactPose(int i) const {
+    return Pose(typename Pose::Position(positions[i]), rotations[i]);
+  }
+};
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+TYPED_TEST_CASE(WrenchArrayTest, PrimTypes);
+
+TYPED_TEST(WrenchArrayTest, testAccessors)
+{
+  typedef typename TestFixture::Wrench Wrench;
+  typedef typename TestFixture::Vector3 Vector3;
+  typename TestFixture::WrenchArray wrenches(3);
+  ASSERT_EQ(3, wrenches.size());
+  KINDR_ASSERT_DOUBLE_MX_EQ(Vector3::Zero(), wrenches.getSum().getForce().toImplementation(), 1e-6, "zero");
+  const Wrench wrench(Vector3(1.0, 2.0, 3.0), Vector3(-1.0, 0.5, 0.2));
+  wrenches.set(1, wrench);
+  wrenches.set(2, wrench);
+  KINDR_ASSERT_DOUBLE_MX_EQ(wrench.getVector(), wrenches[1].getVector(), 1e-6, "element");
+  KINDR_ASSERT_DOUBLE_MX_EQ((2*wrench.getVector()).eval(), wrenches.getSum().getVector(), 1e-6, "sum");
+}
+
+TYPED_TEST(WrenchArrayTest, testTransformContactWrenches)
+{
+  typedef typename TestFixture::Wrench Wrench;
+  // A typical number of contacts and a large array, both transformed contact by contact in a single pass
+  for (int size : {6, 300}) {
+    this->setContacts(size);
+    typename TestFixture::WrenchArray baseWrenches;
+    const Wrench netWrench = kindr::transformContactWrenches(this->positions, this->rotations, this->contactWrenches, baseWrenches);
+    ASSERT_EQ(size, baseWrenches.size());
+    Wrench expectedNetWrench;
+    for (int i = 0; i < size; ++i) {
+      const Wrench expected = kindr::transformWrench(this->getContactPose(i), this->contactWrenches[i]);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getVector(), baseWrenches[i].getVector(), this->tol, this->tol, "base wrench");
+      expectedNetWrench += expected;
+    }
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedNetWrench.getVector(), netWrench.getVector(), this->tol*size, this->tol, "net wrench");
+  }
+}
+
+TYPED_TEST(WrenchArrayTest, testTransformContactForces)
+{
+  typedef typename TestFixture::Wrench Wrench;
+  typedef typename TestFixture::Vector3 Vector3;
+  this->setContacts(4);
+  typename TestFixture::WrenchArray baseWrenches;
+  const Wrench netWrench = kindr::transformContactForces(this->positions, this->rotations, this->contactWrenches.getForces(), baseWrenches);
+  Wrench expectedNetWrench;
+  for (int i = 0; i < 4; ++i) {
+    const Wrench expected = kindr::transformWrench(this->getContactPose(i), Wrench(this->contactWrenches[i].getForce().toImplementation(), Vector3::Zero()));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getVector(), baseWrenches[i].getVector(), this->tol, this->tol, "base wrench");
+    expectedNetWrench += expected;
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedNetWrench.getVector(), netWrench.getVector(), this->tol, this->tol, "net wrench");
+}
@@ -253,3 +253,21 @@ TYPED_TEST(WrenchTest, math)
   KINDR_ASSERT_DOUBLE_MX_EQ(torque1DivideByScalar.toImplementation(), wrenchDivideAssign.getTorque().toImplementation(), Scalar(0.5), "divide and assign");
 
 }
+
+TYPED_TEST(WrenchTest, vectorMap)
+{
+  typedef typename TestFixture::Wrench Wrench;
+  typedef typename TestFixture::Force Force;
+  typedef typename TestFixture::Torque Torque;
+
+  // the map views the force and the torque of the wrench
+  Wrench wrench(Force(0.1, 0.2, 0.3), Torque(1.1, 2.2, 3.3));
+  EXPECT_EQ(wrench.getVector(), typename Wrench::Vector6(wrench.getVectorMap()));
+  wrench.getVectorMap()(1) = 0.5;
+  wrench.getVectorMap().template tail<3>().setZero();
+  EXPECT_EQ(wrench.getForce().y(), 0.5);
+  EXPECT_EQ(wrench.getTorque().toImplementation(), Torque::Zero().toImplementation());
+
+  const Wrench& constWrench = wrench;
+  EXPECT_EQ(wrench.getForce().toImplementation().data(), constWrench.getVectorMap().data());
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+typedef ::testing::Types<
+    std::pair<kindr::CachedHomTransformQuatD, kindr::HomTransformQuatD>,
+    std::pair<kindr::CachedHomTransformQuatF, kindr::HomTransformQuatF>,
+    std::pair<kindr::CachedHomTransformMatrixD, kindr::HomTransformMatrixD>,
+    std::pair<kindr::CachedHomTransformMatrixF, kindr::HomTransformMatrixF>
+> Types;
+
+template <typename PosePair_>
+struct CachedHomogeneousTransformationTest: public ::testing::Test {
+  typedef typename PosePair_::first_type Pose;
+  typedef typename PosePair_::second_type UncachedPose;
+  typedef typename Pose::Scalar Scalar;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  Position positionAToBInA = Position(1.0,2.0,3.0);
+  Rotation rotationBToA = Rotation(kindr::EulerAnglesZyx<Scalar>(0.5, -0.9, 1.2));
+  Pose poseBToA = Pose(positionAToBInA, rotationBToA);
+  UncachedPose uncachedPoseBToA = UncachedPose(positionAToBInA, rotationBToA);
+};
+
+TYPED_TEST_CASE(CachedHomogeneousTransformationTest, Types);
+
+
+TYPED_TEST(CachedHomogeneousTransformationTest, testTransformationMatrix)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::UncachedPose UncachedPose;
+
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.getTransformationMatrix(), this->poseBToA.getTransformationMatrix(), 1e-5, 1e-4, "matrix");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.getTransformationMatrixCompact(), this->poseBToA.getTransformationMatrixCompact(), 1e-5, 1e-4, "compact");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.getTransformationMatrix().template topRows<3>(), this->uncachedPoseBToA.getTransformationMatrixCompact(), 1e-5, 1e-4, "uncached compact");
+
+  // Repeated queries return the same storage
+  EXPECT_EQ(&this->poseBToA.getTransformationMatrix(), &this->poseBToA.getTransformationMatrix());
+
+  // Conversion from and to the uncached pose
+  const Pose converted(this->uncachedPoseBToA);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.getTransformationMatrix(), converted.getTransformationMatrix(), 1e-5, 1e-4, "converted");
+  const UncachedPose convertedBack(converted);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.getTransformationMatrix(), convertedBack.getTransformationMatrix(), 1e-5, 1e-4, "converted back");
+
+  Pose identity(this->poseBToA);
+  identity.setIdentity();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Pose::TransformationMatrix::Identity(), identity.getTransformationMatrix(), 1e-5, 1e-4, "identity");
+}
+
+TYPED_TEST(CachedHomogeneousTransformationTest, testInvalidation)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::UncachedPose UncachedPose;
+
+  this->poseBToA.getTransformationMatrix();
+  this->poseBToA.getPosition() = Position(-1.0, 0.5, 2.0);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->poseBToA.getPosition().toImplementation(), this->poseBToA.getTranslation(), 1e-5, 1e-4, "position");
+
+  this->poseBToA.getRotation() = Rotation(kindr::EulerAnglesZyx<Scalar>(-0.3, 0.2, 0.1));
+  const UncachedPose expected(this->poseBToA.getPosition(), this->poseBToA.getRotation());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getTransformationMatrix(), this->poseBToA.getTransformationMatrix(), 1e-5, 1e-4, "rotation");
+}
+
+TYPED_TEST(CachedHomogeneousTransformationTest, testConstQueries)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::UncachedPose UncachedPose;
+
+  // The constructor computes the matrix, so a const pose can be queried without writing to it
+  const Pose& constPose = this->poseBToA;
+  EXPECT_TRUE(constPose.isTransformationMatrixValid());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.getTransformationMatrix(), constPose.getTransformationMatrix(), 1e-5, 1e-4, "constructed");
+
+  // The setters update the matrix
+  const Position position(-1.0, 0.5, 2.0);
+  const Rotation rotation(kindr::EulerAnglesZyx<Scalar>(-0.3, 0.2, 0.1));
+  this->poseBToA.setPosition(position).setRotation(rotation);
+  EXPECT_TRUE(constPose.isTransformationMatrixValid());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(UncachedPose(position, rotation).getTransformationMatrix(), constPose.getTransformationMatrix(), 1e-5, 1e-4, "set");
+
+  // A const query of an invalidated matrix throws, but transformations still use the current rotation
+  this->poseBToA.getRotation() = Rotation(kindr::EulerAnglesZyx<Scalar>(0.5, -0.9, 1.2));
+  EXPECT_FALSE(constPose.isTransformationMatrixValid());
+  EXPECT_THROW(constPose.getTransformationMatrix(), std::runtime_error);
+  const Position positionInB(0.5, 0.4, -5.4);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(UncachedPose(position, this->poseBToA.getRotation()).transform(positionInB).toImplementation(),
+                                    constPose.transform(positionInB).toImplementation(), 1e-5, 1e-4, "invalidated transform");
+  this->poseBToA.getTransformationMatrix();
+  EXPECT_TRUE(constPose.isTransformationMatrixValid());
+}
+
+TYPED_TEST(CachedHomogeneousTransformationTest, testInPlace)
+{
+  typedef typename TestFixture::UncachedPose UncachedPose;
+
+  // the in-place operations replace the cached transformation matrix
+  this->poseBToA.getTransformationMatrix();
+  this->poseBToA *= this->poseBToA;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(UncachedPose(this->uncachedPoseBToA*this->uncachedPoseBToA).getTransformationMatrix(),
+                                    this->poseBToA.getTransformationMatrix(), 1e-5, 1e-4, "operator*=");
+  this->poseBToA.invert();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(UncachedPose(this->uncachedPoseBToA*this->uncachedPoseBToA).getTransformationMatrix().inverse(),
+                                    this->poseBToA.getTransformationMatrix(), 1e-5, 1e-4, "invert");
+}
+
+TYPED_TEST(CachedHomogeneousTransformationTest, testTransform)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Matrix3X Matrix3X;
+
+  const Position positionInB(0.5, 0.4, -5.4);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.transform(positionInB).toImplementation(),
+                                    this->poseBToA.transform(positionInB).toImplementation(), 1e-5, 1e-4, "transform");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.inverseTransform(positionInB).toImplementation(),
+                                    this->poseBToA.inverseTransform(positionInB).toImplementation(), 1e-5, 1e-4, "inverseTransform");
+
+  const Matrix3X positions = Matrix3X::Random(3, 50);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.transform(positions), this->poseBToA.transform(positions), 1e-5, 1e-4, "batch transform");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->uncachedPoseBToA.inverseTransform(positions), this->poseBToA.inverseTransform(positions), 1e-5, 1e-4, "batch inverseTransform");
+
+  const Pose poseCToB(Position(-0.3, 0.8, 0.1), typename TestFixture::Rotation(kindr::EulerAnglesZyx<typename TestFixture::Scalar>(0.2, 0.4, -0.1)));
+  const typename TestFixture::UncachedPose uncachedPoseCToB(poseCToB);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->uncachedPoseBToA*uncachedPoseCToB).getTransformationMatrix(),
+                                    (this->poseBToA*poseCToB).getTransformationMatrix(), 1e-5, 1e-4, "concatenation");
+}
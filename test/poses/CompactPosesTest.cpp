@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+TEST(CompactPositionTest, testEncoding)
+{
+  EXPECT_EQ(6u, sizeof(kindr::CompactPosition));
+  const kindr::Position3D tileOrigin(1000.0, -2000.0, 30.0);
+  const double range = 16.0;
+  const Eigen::Matrix3Xd offsets = range*Eigen::Matrix3Xd::Random(3, 1000);
+  kindr::PositionArrayD positions(offsets.colwise() + tileOrigin.toImplementation());
+
+  for (int i = 0; i < positions.size(); ++i) {
+    const kindr::CompactPosition compact(positions[i], tileOrigin);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(positions[i].toImplementation(), compact.getPosition(tileOrigin).toImplementation(),
+                                      kindr::CompactPosition::getMaxError(range), 0.0, "position");
+  }
+  EXPECT_THROW(kindr::CompactPosition(kindr::Position3D(1e5, 0.0, 0.0), kindr::Position3D()), std::runtime_error);
+
+  // Batch
+  std::vector<kindr::CompactPosition> compact;
+  kindr::encode(positions, tileOrigin, compact);
+  kindr::PositionArrayD decoded;
+  kindr::decode(compact, tileOrigin, decoded, kindr::ThreadPoolExecutor(2));
+  ASSERT_EQ(positions.size(), decoded.size());
+  for (int i = 0; i < positions.size(); ++i) {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(compact[i].getPosition(tileOrigin).toImplementation(), decoded[i].toImplementation(), 1e-12, 0.0, "batch");
+  }
+
+  // the range is checked before the chunks are distributed
+  kindr::PositionArrayD outOfRange = positions;
+  outOfRange.set(positions.size() - 1, kindr::Position3D(0.0, -1e5, 0.0));
+  EXPECT_THROW(kindr::encode(outOfRange, tileOrigin, compact, kindr::ThreadPoolExecutor(2)), std::runtime_error);
+}
+
+TEST(CompactPoseTest, testEncoding)
+{
+  EXPECT_EQ(12u, sizeof(kindr::CompactPose));
+  const kindr::Position3D tileOrigin(-50.0, 20.0, 0.0);
+  for (int i = 0; i < 100; ++i) {
+    kindr::RotationQuaternionD rotation;
+    rotation.setRandom();
+    const kindr::HomTransformQuatD pose(kindr::Position3D(tileOrigin.toImplementation() + Eigen::Vector3d::Random()), rotation);
+    const kindr::CompactPose compact(pose, tileOrigin);
+    const kindr::HomTransformQuatD decoded = compact.getPose<kindr::HomTransformQuatD>(tileOrigin);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.getPosition().toImplementation(), decoded.getPosition().toImplementation(),
+                                      kindr::CompactPosition::getMaxError(1.0), 0.0, "position");
+    EXPECT_LT(decoded.getRotation().getDisparityAngle(pose.getRotation()), kindr::CompactRotationQuaternion48::getMaxAngleError());
+    const kindr::HomTransformMatrixD decodedMatrix = compact.getPose<kindr::HomTransformMatrixD>(tileOrigin);
+    EXPECT_TRUE(decodedMatrix.getRotation().isNear(decoded.getRotation(), 1e-12));
+  }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/poses/DeviceKinematics.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+// The device functions are compiled for the host here and must agree with the member functions.
+
+template <typename Pose_>
+class DeviceKinematicsTest : public ::testing::Test {
+ public:
+  typedef Pose_ Pose;
+  typedef typename Pose_::Scalar Scalar;
+  typedef typename Pose_::Rotation Rotation;
+  typedef kindr::Position<Scalar, 3> Position;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  Pose pose;
+  Position position;
+
+  DeviceKinematicsTest()
+    : pose(Position(Scalar(1.0), Scalar(-0.5), Scalar(2.0)), Rotation(kindr::EulerAnglesZyx<Scalar>(0.8, -0.3, 0.5))),
+      position(Scalar(0.3), Scalar(-1.5), Scalar(0.6)) {
+  }
+};
+
+typedef ::testing::Types<
+    kindr::HomTransformQuatD,
+    kindr::HomTransformQuatF,
+    kindr::HomTransformMatrixD,
+    kindr::HomTransformMatrixF
+> Types;
+
+TYPED_TEST_CASE(DeviceKinematicsTest, Types);
+
+TYPED_TEST(DeviceKinematicsTest, testRotateAndTransform)
+{
+  typedef typename TestFixture::Vector3 Vector3;
+  const Vector3 vector = this->position.toImplementation();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->pose.getRotation().rotate(vector), kindr::device::rotate(this->pose.getRotation(), vector), this->tol, this->tol, "rotate");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->pose.getRotation().inverseRotate(vector), kindr::device::inverseRotate(this->pose.getRotation(), vector), this->tol, this->tol, "inverseRotate");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->pose.transform(this->position).toImplementation(), kindr::device::transform(this->pose, this->position).toImplementation(), this->tol, this->tol, "transform");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->pose.inverseTransform(this->position).toImplementation(), kindr::device::inverseTransform(this->pose, this->position).toImplementation(), this->tol, this->tol, "inverseTransform");
+}
+
+TYPED_TEST(DeviceKinematicsTest, testMaps)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Vector3 Vector3;
+  const Vector3 small(Scalar(1e-5), Scalar(-2e-5), Scalar(0.5e-5));
+  for (const Vector3& vector : {Vector3(Scalar(0.4), Scalar(-0.9), Scalar(1.3)), small, Vector3(Scalar(3.0), Scalar(0.1), Scalar(0.0))}) {
+    const Rotation rotation = kindr::device::exponentialMap<Rotation>(vector);
+    ASSERT_TRUE(rotation.isNear(Rotation().exponentialMap(vector), this->tol));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotation.logarithmicMap(), kindr::device::logarithmicMap(rotation), this->tol, 1e-4, "logarithmicMap");
+  }
+}
+
+TYPED_TEST(DeviceKinematicsTest, testTransformPosition)
+{
+  typedef typename TestFixture::Matrix3X Matrix3X;
+  const Matrix3X positions = Matrix3X::Random(3, 100);
+  Matrix3X transformed(3, positions.cols());
+  for (int i = 0; i < positions.cols(); ++i) {
+    kindr::device::transformPosition(this->pose, positions.data(), transformed.data(), i);
+  }
+  Matrix3X expected(3, positions.cols());
+  this->pose.transform(positions, expected);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, transformed, this->tol, this->tol, "transformPosition");
+}
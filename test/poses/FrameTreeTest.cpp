@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename Pose_>
+struct FrameTreeTest: public ::testing::Test {
+  typedef Pose_ Pose;
+  typedef typename Pose::Scalar Scalar;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+  typedef kindr::FrameTree<Pose> Tree;
+
+  Tree tree;
+  std::vector<Pose> poses;
+
+  Pose getPose(int i) const {
+    return Pose(Position(0.1*i, -0.3, 0.2+0.01*i), Rotation(kindr::EulerAnglesZyx<Scalar>(0.2*i, -0.1, 0.05*i)));
+  }
+
+  FrameTreeTest() {
+    // Two branches from the root with a sub-branch
+    poses.push_back(Pose());
+    for (int i = 1; i < 12; ++i) {
+      const int parent = (i == 1 || i == 6) ? 0 : (i == 9 ? 3 : i-1);
+      poses.push_back(getPose(i));
+      tree.addFrame(parent, poses.back());
+    }
+  }
+
+  //! Composes the pose of a frame with respect to the root from the edges
+  Pose getReferencePoseToRoot(int frame) const {
+    Pose pose;
+    for (int i = frame; i != Tree::RootFrame; i = tree.getParent(i)) {
+      pose = poses[i]*pose;
+    }
+    return pose;
+  }
+
+  void checkTree(const std::string& message) {
+    for (int a = 0; a < tree.getNumFrames(); ++a) {
+      const Pose poseAToRoot = getReferencePoseToRoot(a);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(poseAToRoot.getTransformationMatrix(), tree.getPoseToRoot(a).getTransformationMatrix(), 1e-5, 1e-4, message);
+      for (int b = 0; b < tree.getNumFrames(); ++b) {
+        const Pose poseBToRoot = getReferencePoseToRoot(b);
+        const Position positionInB(0.3, -0.2, 0.5);
+        const Position expectedPositionInA = poseAToRoot.inverseTransform(poseBToRoot.transform(positionInB));
+        KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedPositionInA.toImplementation(), tree.getPose(a, b).transform(positionInB).toImplementation(), 1e-5, 1e-4, message);
+      }
+    }
+  }
+};
+
+typedef ::testing::Types<
+    kindr::HomTransformQuatD,
+    kindr::HomTransformQuatF,
+    kindr::HomTransformMatrixD,
+    kindr::CachedHomTransformQuatD
+> Types;
+
+TYPED_TEST_CASE(FrameTreeTest, Types);
+
+
+TYPED_TEST(FrameTreeTest, testStructure)
+{
+  EXPECT_EQ(12, this->tree.getNumFrames());
+  EXPECT_EQ(-1, this->tree.getParent(0));
+  EXPECT_EQ(3, this->tree.getParent(9));
+  ASSERT_EQ(2u, this->tree.getChildren(0).size());
+  EXPECT_EQ(6, this->tree.getChildren(0)[1]);
+  EXPECT_THROW(this->tree.getPoseToRoot(12), std::runtime_error);
+  EXPECT_THROW(this->tree.setPoseToParent(0, this->getPose(1)), std::runtime_error);
+}
+
+TYPED_TEST(FrameTreeTest, testPoses)
+{
+  this->checkTree("initial");
+}
+
+TYPED_TEST(FrameTreeTest, testInvalidation)
+{
+  this->checkTree("initial");
+
+  // Change an inner edge, the branch to frame 9 and leaves
+  const int frames[] = {3, 9, 11, 1, 3};
+  for (int frame : frames) {
+    this->poses[frame] = this->getPose(frame+5);
+    this->tree.setPoseToParent(frame, this->poses[frame]);
+    this->checkTree("after change");
+  }
+
+  // Change edges without querying in between, and add a frame below an invalid frame
+  this->poses[2] = this->getPose(20);
+  this->tree.setPoseToParent(2, this->poses[2]);
+  this->poses[4] = this->getPose(21);
+  this->tree.setPoseToParent(4, this->poses[4]);
+  this->poses.push_back(this->getPose(22));
+  this->tree.addFrame(4, this->poses.back());
+  this->checkTree("after multiple changes");
+}
@@ -164,6 +164,86 @@ TYPED_TEST(HomogeneousTransformationTest, testTransformAndInverseTransform)
   EXPECT_NEAR(positionInB.z(), positionInBNew.z(), 1.0e-6);
 }
 
+TYPED_TEST(HomogeneousTransformationTest, testBatchTransform)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+  Pose poseBToA(Position(1.0,2.0,3.0), Rotation(kindr::EulerAnglesZyx<Scalar>(0.5, -0.9, 1.2)));
+
+  // Several tiles of the column kernels and a partial tile
+  const int size = 2*kindr::internal::ColumnTransformKernels<Scalar>::TileSize + 89;
+  const Matrix3X positionsInB = Matrix3X::Random(3, size);
+  const Matrix3X positionsInA = poseBToA.transform(positionsInB);
+  const Matrix3X positionsInBNew = poseBToA.inverseTransform(positionsInA);
+  ASSERT_EQ(positionsInB.cols(), positionsInA.cols());
+  for (int i = 0; i < positionsInB.cols(); ++i) {
+    const Position expectedPositionInA = poseBToA.transform(Position(positionsInB.col(i)));
+    const Position expectedPositionInB = poseBToA.inverseTransform(Position(positionsInA.col(i)));
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_NEAR(expectedPositionInA(j), positionsInA(j,i), 1.0e-5);
+      EXPECT_NEAR(expectedPositionInB(j), positionsInBNew(j,i), 1.0e-5);
+      EXPECT_NEAR(positionsInB(j,i), positionsInBNew(j,i), 1.0e-5);
+    }
+  }
+
+  // In-place transformation of a column block
+  Matrix3X positions = positionsInB;
+  poseBToA.transform(positions.middleCols(100, 300), positions.middleCols(100, 300));
+  EXPECT_TRUE(positions.leftCols(100).isApprox(positionsInB.leftCols(100)));
+  EXPECT_TRUE(positions.middleCols(100, 300).isApprox(positionsInA.middleCols(100, 300)));
+  EXPECT_TRUE(positions.rightCols(201).isApprox(positionsInB.rightCols(201)));
+  poseBToA.inverseTransform(positions, positions);
+  EXPECT_TRUE(positions.middleCols(100, 300).isApprox(positionsInB.middleCols(100, 300), 1.0e-5));
+}
+
+TYPED_TEST(HomogeneousTransformationTest, testBatchTransformWithExecutor)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+  Pose poseBToA(Position(1.0,2.0,3.0), Rotation(kindr::EulerAnglesZyx<Scalar>(0.5, -0.9, 1.2)));
+
+  const Matrix3X positionsInB = Matrix3X::Random(3, 5001);
+  const Matrix3X expectedPositionsInA = poseBToA.transform(positionsInB);
+  const kindr::ThreadPoolExecutor executor(4);
+
+  // threads
+  Matrix3X positionsInA(3, positionsInB.cols());
+  poseBToA.transformBatch(positionsInB, positionsInA, executor);
+  EXPECT_TRUE(positionsInA.isApprox(expectedPositionsInA, 1.0e-5));
+
+  // in place and on an unaligned column block
+  Matrix3X positions = positionsInB;
+  poseBToA.transformBatch(positions.middleCols(1, 4000), positions.middleCols(1, 4000), executor);
+  EXPECT_TRUE(positions.col(0).isApprox(positionsInB.col(0)));
+  EXPECT_TRUE(positions.middleCols(1, 4000).isApprox(expectedPositionsInA.middleCols(1, 4000), 1.0e-5));
+  EXPECT_TRUE(positions.rightCols(1000).isApprox(positionsInB.rightCols(1000)));
+  poseBToA.inverseTransformBatch(positions.middleCols(1, 4000), positions.middleCols(1, 4000), executor);
+  EXPECT_TRUE(positions.isApprox(positionsInB, 1.0e-5));
+
+  // columns with a stride of six scalars
+  Eigen::Matrix<Scalar, 6, Eigen::Dynamic> stacked(6, positionsInB.cols());
+  stacked.template topRows<3>() = positionsInB;
+  stacked.template bottomRows<3>().setZero();
+  poseBToA.transformBatch(stacked.template topRows<3>(), stacked.template bottomRows<3>());
+  EXPECT_TRUE(stacked.template bottomRows<3>().isApprox(expectedPositionsInA, 1.0e-5));
+
+  // rotation only
+  Matrix3X rotated(3, positionsInB.cols());
+  poseBToA.getRotation().rotateBatch(positionsInB, rotated, executor);
+  for (int i = 0; i < positionsInB.cols(); i += 97) {
+    const Position expectedRotated = poseBToA.getRotation().rotate(Position(positionsInB.col(i)));
+    EXPECT_TRUE(rotated.col(i).isApprox(expectedRotated.toImplementation(), 1.0e-5));
+  }
+  poseBToA.getRotation().inverseRotateBatch(rotated, rotated, kindr::SerialExecutor());
+  EXPECT_TRUE(rotated.isApprox(positionsInB, 1.0e-5));
+}
+
 TYPED_TEST(HomogeneousTransformationTest, testConcatenation)
 {
   typedef typename TestFixture::Pose Pose;
@@ -190,6 +270,43 @@ TYPED_TEST(HomogeneousTransformationTest, testConcatenation)
 }
 
 
+TYPED_TEST(HomogeneousTransformationTest, testInPlace)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+  typedef Eigen::Matrix<Scalar, 6, 1> Vector6;
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-4) : Scalar(1e-10);
+  const Pose poseBToA(Position(0.5, -0.8, 1.3), Rotation(kindr::EulerAnglesZyx<Scalar>(0.4, 0.6, -2.5)));
+  const Pose poseCToB(Position(5.7, 1.3, -5.1), Rotation(kindr::EulerAnglesZyx<Scalar>(-0.9, 2.1, 7.9)));
+
+  Pose pose = poseBToA;
+  Pose& reference = (pose *= poseCToB);
+  ASSERT_EQ(&pose, &reference);
+  ASSERT_TRUE(pose.boxMinus(poseBToA*poseCToB).norm() < tol);
+
+  // T*T^-1 = T^-1*T = I
+  pose = poseBToA;
+  pose.invert();
+  ASSERT_TRUE((poseBToA*pose).logarithmicMap().norm() < tol);
+  ASSERT_TRUE((pose*poseBToA).logarithmicMap().norm() < tol);
+
+  Vector6 vector;
+  vector << 0.1, -0.2, 0.3, 0.2, -0.1, 0.4;
+  pose = poseBToA;
+  pose.boxPlusInPlace(vector);
+  ASSERT_TRUE(pose.boxMinus(poseBToA.boxPlus(vector)).norm() < tol);
+
+  const Matrix3X positions = Matrix3X::Random(3, 50);
+  Matrix3X transformed = positions;
+  poseBToA.transformInPlace(transformed);
+  ASSERT_TRUE((poseBToA.transform(positions) - transformed).norm() < tol);
+  poseBToA.inverseTransformInPlace(transformed);
+  ASSERT_TRUE((positions - transformed).norm() < tol);
+}
+
 TYPED_TEST(HomogeneousTransformationTest, testGenericRotateVectorCompilable)
 {
   typedef typename TestFixture::Pose Pose;
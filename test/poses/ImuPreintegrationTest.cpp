@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/ImuPreintegration.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+struct ImuPreintegrationTest : public ::testing::Test {
+  typedef Eigen::Matrix<double, 3, Eigen::Dynamic> Matrix3X;
+
+  const double dt = 0.005;
+  Matrix3X angularVelocities;
+  Matrix3X accelerations;
+
+  ImuPreintegrationTest() : angularVelocities(3, 200), accelerations(3, 200) {
+    for (int i = 0; i < angularVelocities.cols(); ++i) {
+      angularVelocities.col(i) << 0.3 + std::sin(0.05*i), -0.8*std::cos(0.03*i), 1.5;
+      accelerations.col(i) << 0.5*std::cos(0.02*i), 9.81 + 0.1*std::sin(0.1*i), -0.3;
+    }
+  }
+};
+
+TEST_F(ImuPreintegrationTest, testConstantMotion) {
+  const kindr::LocalAngularVelocityD angularVelocity(0.4, -0.2, 0.7);
+  const kindr::Acceleration3D acceleration(1.0, 2.0, -3.0);
+
+  // A constant rotation rate integrates to the exponential map
+  kindr::ImuPreintegratorD rotating;
+  for (int i = 0; i < 100; ++i) {
+    rotating.integrate(angularVelocity, kindr::Acceleration3D(), dt);
+  }
+  const kindr::RotationQuaternionD expectedRotation = kindr::RotationQuaternionD().exponentialMap(angularVelocity.vector()*0.5);
+  EXPECT_NEAR(rotating.getDeltaTime(), 0.5, 1e-12);
+  EXPECT_NEAR(rotating.getDeltaRotation().getDisparityAngle(expectedRotation), 0.0, 1e-10);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotating.getDeltaVelocity().toImplementation(), Eigen::Vector3d::Zero(), 1e-12, 0, "velocity");
+
+  // A constant acceleration without rotation integrates to a parabola
+  kindr::ImuPreintegratorD accelerating;
+  for (int i = 0; i < 100; ++i) {
+    accelerating.integrate(kindr::LocalAngularVelocityD(), acceleration, dt);
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(accelerating.getDeltaVelocity().toImplementation(), Eigen::Vector3d(acceleration.toImplementation()*0.5), 1e-12, 0, "velocity");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(accelerating.getDeltaPosition().toImplementation(), Eigen::Vector3d(acceleration.toImplementation()*0.125), 1e-12, 0, "position");
+}
+
+TEST_F(ImuPreintegrationTest, testBatchAgreesWithSamples) {
+  const kindr::LocalAngularVelocityD gyroscopeBias(0.01, -0.02, 0.03);
+  const kindr::Acceleration3D accelerometerBias(0.1, 0.05, -0.2);
+  kindr::ImuPreintegratorD batch(gyroscopeBias, accelerometerBias);
+  kindr::ImuPreintegratorD samples(gyroscopeBias, accelerometerBias);
+  batch.integrate(angularVelocities, accelerations, dt);
+  for (int i = 0; i < angularVelocities.cols(); ++i) {
+    samples.integrate(kindr::LocalAngularVelocityD(Eigen::Vector3d(angularVelocities.col(i))), kindr::Acceleration3D(Eigen::Vector3d(accelerations.col(i))), dt);
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(batch.getDeltaRotationMatrix(), samples.getDeltaRotationMatrix(), 1e-14, 0, "rotation");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(batch.getDeltaPosition().toImplementation(), samples.getDeltaPosition().toImplementation(), 1e-14, 0, "position");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(batch.getPositionJacobianGyroscopeBias(), samples.getPositionJacobianGyroscopeBias(), 1e-14, 0, "jacobian");
+
+  // The rotation stays orthonormal
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Eigen::Matrix3d(batch.getDeltaRotationMatrix()*batch.getDeltaRotationMatrix().transpose()), Eigen::Matrix3d::Identity(), 1e-13, 0, "orthonormal");
+
+  Matrix3X tooFewAccelerations(3, angularVelocities.cols() - 1);
+  EXPECT_THROW(batch.integrate(angularVelocities, tooFewAccelerations, dt), std::runtime_error);
+}
+
+TEST_F(ImuPreintegrationTest, testBiasCorrection) {
+  const kindr::LocalAngularVelocityD gyroscopeBias(0.01, -0.02, 0.03);
+  const kindr::Acceleration3D accelerometerBias(0.1, 0.05, -0.2);
+  const kindr::LocalAngularVelocityD gyroscopeBiasChange(2e-4, 1e-4, -3e-4);
+  const kindr::Acceleration3D accelerometerBiasChange(-1e-3, 2e-3, 1e-3);
+  const kindr::LocalAngularVelocityD newGyroscopeBias(gyroscopeBias.vector() + gyroscopeBiasChange.vector());
+  const kindr::Acceleration3D newAccelerometerBias = accelerometerBias + accelerometerBiasChange;
+
+  kindr::ImuPreintegratorD linearized(gyroscopeBias, accelerometerBias);
+  kindr::ImuPreintegratorD reintegrated(newGyroscopeBias, newAccelerometerBias);
+  linearized.integrate(angularVelocities, accelerations, dt);
+  reintegrated.integrate(angularVelocities, accelerations, dt);
+
+  // The first-order correction removes the error up to second order in the bias change
+  const double uncorrectedRotationError = linearized.getDeltaRotation().getDisparityAngle(reintegrated.getDeltaRotation());
+  const double rotationError = linearized.getDeltaRotation(newGyroscopeBias).getDisparityAngle(reintegrated.getDeltaRotation());
+  const double uncorrectedVelocityError = (linearized.getDeltaVelocity() - reintegrated.getDeltaVelocity()).norm();
+  const double velocityError = (linearized.getDeltaVelocity(newGyroscopeBias, newAccelerometerBias) - reintegrated.getDeltaVelocity()).norm();
+  const double uncorrectedPositionError = (linearized.getDeltaPosition() - reintegrated.getDeltaPosition()).norm();
+  const double positionError = (linearized.getDeltaPosition(newGyroscopeBias, newAccelerometerBias) - reintegrated.getDeltaPosition()).norm();
+  EXPECT_GT(uncorrectedRotationError, 1e-4);
+  EXPECT_GT(uncorrectedVelocityError, 1e-3);
+  EXPECT_GT(uncorrectedPositionError, 1e-4);
+  EXPECT_LT(rotationError, 1e-2*uncorrectedRotationError);
+  EXPECT_LT(velocityError, 1e-2*uncorrectedVelocityError);
+  EXPECT_LT(positionError, 1e-2*uncorrectedPositionError);
+}
+
+TEST_F(ImuPreintegrationTest, testSmallAndLargeRotationIncrements) {
+  // Increments just below and above the threshold of the Taylor series agree with the exponential map
+  for (const double angle : {1e-6, 1.0e-2, 1.1e-2, 0.5}) {
+    const kindr::LocalAngularVelocityD angularVelocity(Eigen::Vector3d(angle/dt*Eigen::Vector3d(1.0, -2.0, 2.0)/3.0));
+    kindr::ImuPreintegratorD preintegrator;
+    preintegrator.integrate(angularVelocity, kindr::Acceleration3D(), dt);
+    const kindr::RotationMatrixD expectedRotation = kindr::RotationMatrixD().exponentialMap(Eigen::Vector3d(angularVelocity.vector()*dt));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(preintegrator.getDeltaRotationMatrix(), expectedRotation.matrix(), 1e-15, 0, "angle " << angle);
+  }
+}
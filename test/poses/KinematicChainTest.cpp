@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename Chain_>
+struct KinematicChainTest: public ::testing::Test {
+  typedef Chain_ Chain;
+  typedef typename Chain::Scalar Scalar;
+  typedef typename Chain::Pose Pose;
+  typedef typename Chain::Vector3 Vector3;
+  typedef typename Chain::JointType JointType;
+  typedef kindr::HomTransformQuat<Scalar> ReferencePose;
+  enum { NumJoints = Chain::NumJoints };
+
+  std::vector<ReferencePose> linkTransforms;
+  std::vector<Vector3> axes;
+  std::vector<JointType> types;
+  Chain chain;
+
+  KinematicChainTest() {
+    for (int i = 0; i < NumJoints; ++i) {
+      linkTransforms.push_back(ReferencePose(typename ReferencePose::Position(0.1*i, -0.2, 0.3+0.05*i),
+                                             typename ReferencePose::Rotation(kindr::EulerAnglesZyx<Scalar>(0.3*i, -0.2, 0.1*i))));
+      axes.push_back(Vector3(0.2*i, 1.0, -0.5));
+      types.push_back(i % 3 == 2 ? JointType::Prismatic : JointType::Revolute);
+      chain.setLink(i, linkTransforms[i], axes[i], types[i]);
+    }
+  }
+
+  //! Evaluates the chain by concatenation of poses
+  ReferencePose getReferenceTransform(const typename Chain::JointPositions& jointPositions, int index) const {
+    ReferencePose transform;
+    for (int i = 0; i <= index; ++i) {
+      ReferencePose joint;
+      if (types[i] == JointType::Revolute) {
+        joint = ReferencePose(typename ReferencePose::Position(), typename ReferencePose::Rotation(kindr::AngleAxis<Scalar>(jointPositions(i), axes[i].normalized())));
+      } else {
+        joint = ReferencePose(typename ReferencePose::Position(jointPositions(i)*axes[i].normalized()), typename ReferencePose::Rotation());
+      }
+      transform = transform*linkTransforms[i]*joint;
+    }
+    return transform;
+  }
+};
+
+typedef ::testing::Types<
+    kindr::KinematicChain<double, 1>,
+    kindr::KinematicChain<double, 6>,
+    kindr::KinematicChain<float, 6>,
+    kindr::KinematicChain<double, 12>
+> Types;
+
+TYPED_TEST_CASE(KinematicChainTest, Types);
+
+
+TYPED_TEST(KinematicChainTest, testPrefixTransforms)
+{
+  typedef typename TestFixture::Chain Chain;
+  typename Chain::JointPositions jointPositions;
+  jointPositions.setLinSpaced(-1.2, 2.1);
+  this->chain.setJointPositions(jointPositions);
+
+  for (int i = 0; i < TestFixture::NumJoints; ++i) {
+    const typename TestFixture::ReferencePose expected = this->getReferenceTransform(jointPositions, i);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getTransformationMatrix(), this->chain.getTransform(i).getTransformationMatrix(), 1e-5, 1e-4, "prefix transform");
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->getReferenceTransform(jointPositions, TestFixture::NumJoints-1).getTransformationMatrix(),
+                                    this->chain.getEndEffectorTransform().getTransformationMatrix(), 1e-5, 1e-4, "end-effector transform");
+}
+
+TYPED_TEST(KinematicChainTest, testSingleJointUpdate)
+{
+  typedef typename TestFixture::Chain Chain;
+  typename Chain::JointPositions jointPositions;
+  jointPositions.setLinSpaced(0.4, -0.7);
+  this->chain.setJointPositions(jointPositions);
+
+  // Update each joint individually and compare to a full evaluation
+  for (int i = 0; i < TestFixture::NumJoints; ++i) {
+    jointPositions(i) += 0.3;
+    this->chain.setJointPosition(i, jointPositions(i));
+    Chain reference(this->chain);
+    reference.setJointPositions(jointPositions);
+    for (int j = 0; j < TestFixture::NumJoints; ++j) {
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(reference.getRotationMatrix(j), this->chain.getRotationMatrix(j), 1e-6, 1e-5, "rotation");
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(reference.getTranslation(j), this->chain.getTranslation(j), 1e-6, 1e-5, "translation");
+    }
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->getReferenceTransform(jointPositions, TestFixture::NumJoints-1).getTransformationMatrix(),
+                                    this->chain.getEndEffectorTransform().getTransformationMatrix(), 1e-5, 1e-4, "end-effector transform");
+}
+
+TEST(KinematicChainTest, testDefaultChain)
+{
+  kindr::KinematicChain<double, 3> chain;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Eigen::Matrix4d::Identity(), chain.getEndEffectorTransform().getTransformationMatrix(), 1e-12, 1e-12, "identity");
+  chain.setJointPositions(Eigen::Vector3d(0.5, 0.25, 0.25));
+  const kindr::RotationMatrixD expected(kindr::AngleAxisD(1.0, 0.0, 0.0, 1.0));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.matrix(), chain.getRotationMatrix(2), 1e-12, 1e-12, "rotation about z");
+  EXPECT_THROW(chain.setJointPosition(3, 0.0), std::runtime_error);
+}
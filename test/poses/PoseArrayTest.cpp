@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/PoseArray.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename PrimType_>
+struct PoseArrayTest: public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::PoseArray<Scalar> PoseArray;
+  typedef typename PoseArray::Element Pose;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  PoseArray getRandomPoses(int size) const {
+    PoseArray poses(size);
+    for (int i = 0; i < size; ++i) {
+      kindr::RotationQuaternion<Scalar> rotation;
+      rotation.setRandom();
+      poses.set(i, Pose(kindr::Position<Scalar, 3>(Eigen::Matrix<Scalar, 3, 1>::Random()), rotation));
+    }
+    return poses;
+  }
+
+  void expectNear(const Pose& expected, const Pose& actual, const std::string& message) const {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getTransformationMatrix(), actual.getTransformationMatrix(), tol, tol, message);
+  }
+};
+
+typedef ::testing::Types<
+    double,
+    float
+> Types;
+
+TYPED_TEST_CASE(PoseArrayTest, Types);
+
+TYPED_TEST(PoseArrayTest, testConstructors)
+{
+  typedef typename TestFixture::PoseArray PoseArray;
+  typedef typename TestFixture::Pose Pose;
+  const PoseArray identities(3);
+  ASSERT_EQ(identities.size(), 3);
+  this->expectNear(Pose(), identities[2], "identity");
+
+  const PoseArray poses = this->getRandomPoses(5);
+  std::vector<Pose> vector;
+  for (int i = 0; i < poses.size(); ++i) {
+    vector.push_back(poses[i]);
+  }
+  const PoseArray copy(vector);
+  const PoseArray fromArrays(poses.getPositions(), poses.getRotations());
+  for (int i = 0; i < poses.size(); ++i) {
+    this->expectNear(poses[i], copy[i], "std::vector");
+    this->expectNear(poses[i], fromArrays[i], "arrays");
+  }
+  ASSERT_THROW(PoseArray(poses.getPositions(), identities.getRotations()), std::runtime_error);
+}
+
+TYPED_TEST(PoseArrayTest, testComposition)
+{
+  typedef typename TestFixture::PoseArray PoseArray;
+  const PoseArray lhs = this->getRandomPoses(300);
+  const PoseArray rhs = this->getRandomPoses(300);
+
+  const PoseArray product = lhs*rhs;
+  PoseArray inverses = lhs;
+  inverses.invert(kindr::ThreadPoolExecutor(2));
+  for (int i = 0; i < lhs.size(); ++i) {
+    this->expectNear(lhs[i]*rhs[i], product[i], "multiply");
+    this->expectNear(lhs[i].inverted(), inverses[i], "invert");
+  }
+
+  // the result may be the right operand
+  PoseArray result = rhs;
+  lhs.multiply(result, result, kindr::ThreadPoolExecutor(2));
+  for (int i = 0; i < lhs.size(); ++i) {
+    this->expectNear(product[i], result[i], "multiply in place");
+  }
+  ASSERT_THROW(result.multiply(rhs, result), std::runtime_error);
+}
+
+TYPED_TEST(PoseArrayTest, testRelativePoses)
+{
+  typedef typename TestFixture::PoseArray PoseArray;
+  const PoseArray poses = this->getRandomPoses(10);
+  const Eigen::VectorXi first = (Eigen::VectorXi(4) << 0, 2, 5, 9).finished();
+  const Eigen::VectorXi second = (Eigen::VectorXi(4) << 1, 7, 5, 3).finished();
+
+  PoseArray gathered;
+  poses.gather(second, gathered);
+  PoseArray relative;
+  poses.getRelativePoses(first, second, relative);
+  ASSERT_EQ(relative.size(), 4);
+  for (int k = 0; k < first.size(); ++k) {
+    this->expectNear(poses[second(k)], gathered[k], "gather");
+    this->expectNear(poses[first(k)].inverted()*poses[second(k)], relative[k], "relative");
+  }
+}
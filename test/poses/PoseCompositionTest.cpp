@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    kindr::HomTransformQuatD,
+    kindr::HomTransformQuatF,
+    kindr::HomTransformMatrixD,
+    kindr::HomTransformMatrixF
+> Types;
+
+template <typename PoseImplementation>
+struct PoseCompositionTest: public ::testing::Test {
+  typedef PoseImplementation Pose;
+  typedef typename Pose::Scalar Scalar;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  Pose poseAB = Pose(Position(1.0, 2.0, 3.0), Rotation(kindr::EulerAnglesZyx<Scalar>(0.5, 1.2, -1.7)));
+  Pose poseBC = Pose(Position(-0.5, 0.2, 1.0), Rotation(kindr::EulerAnglesZyx<Scalar>(-0.3, 0.4, 0.9)));
+  Pose poseCD = Pose(Position(0.3, -1.5, 0.7), Rotation(kindr::EulerAnglesZyx<Scalar>(1.1, -0.2, 0.6)));
+};
+
+TYPED_TEST_CASE(PoseCompositionTest, Types);
+
+TYPED_TEST(PoseCompositionTest, testComposition)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  const Pose expected = this->poseAB*this->poseBC*this->poseCD;
+  const auto composition = this->poseAB.lazy()*this->poseBC*this->poseCD;
+
+  // the product is computed on assignment
+  const Pose product = composition;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getPosition().toImplementation(), product.getPosition().toImplementation(), this->tol, this->tol, "position");
+  ASSERT_TRUE(expected.getRotation().isNear(product.getRotation(), this->tol));
+  const kindr::HomTransformMatrix<Scalar> matrix = composition;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getTransformationMatrix(), matrix.getTransformationMatrix(), this->tol, this->tol, "matrix");
+
+  // positions are transformed by the factors
+  const Position position(0.4, -0.8, 1.3);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.transform(position).toImplementation(), composition.transform(position).toImplementation(), this->tol, this->tol, "transform");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.inverseTransform(position).toImplementation(), composition.inverseTransform(position).toImplementation(), this->tol, this->tol, "inverseTransform");
+  const Matrix3X positions = Matrix3X::Random(3, 20);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.transform(positions), composition.transform(positions), this->tol, this->tol, "transform batch");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.inverseTransform(positions), composition.inverseTransform(positions), this->tol, this->tol, "inverseTransform batch");
+
+  // compositions are concatenated
+  const Pose nested = (this->poseAB.lazy()*this->poseBC)*this->poseCD.lazy();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getPosition().toImplementation(), nested.getPosition().toImplementation(), this->tol, this->tol, "nested");
+}
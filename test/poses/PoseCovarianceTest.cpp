@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/PoseCovariance.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef kindr::HomTransformQuatD Pose;
+typedef Pose::Position Position;
+typedef Pose::Rotation Rotation;
+typedef Eigen::Matrix<double, 6, 1> Vector6;
+typedef Eigen::Matrix<double, 12, 1> Vector12;
+typedef Eigen::Matrix<double, 3, 3> Matrix3;
+typedef Eigen::Matrix<double, 6, 6> Matrix6;
+typedef Eigen::Matrix<double, 12, 12> Matrix12;
+typedef Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor> Matrix3X;
+typedef Eigen::Matrix<double, 6, Eigen::Dynamic, Eigen::RowMajor> Matrix6X;
+
+static Pose getPose(int i) {
+  return Pose(Position(0.1*i, -0.3 + 0.02*i, 0.2), Rotation(kindr::EulerAnglesZyx<double>(0.3*i, -0.1 + 0.07*i, 0.05*i)));
+}
+
+static Pose getInverse(const Pose& pose) {
+  const Rotation inverse = pose.getRotation().inverted();
+  return Pose(Position(-inverse.rotate(pose.getPosition().toImplementation())), inverse);
+}
+
+template<int Size_>
+static Eigen::Matrix<double, Size_, Size_> getRandomCovariance() {
+  typedef Eigen::Matrix<double, Size_, Size_> Matrix;
+  const Matrix factor = Matrix::Random();
+  const Matrix covariance = factor*factor.transpose() + 0.1*Matrix::Identity();
+  return 0.5*(covariance + covariance.transpose());
+}
+
+static Matrix12 getBlockDiagonal(const Matrix6& covariance1, const Matrix6& covariance2) {
+  Matrix12 covariance = Matrix12::Zero();
+  covariance.topLeftCorner<6, 6>() = covariance1;
+  covariance.bottomRightCorner<6, 6>() = covariance2;
+  return covariance;
+}
+
+//! Central differences of a function of a 12D perturbation
+template<int Rows_, typename Function_>
+static Eigen::Matrix<double, Rows_, 12> getNumericalJacobian(const Function_& function) {
+  const double h = 1e-6;
+  Eigen::Matrix<double, Rows_, 12> jacobian;
+  for (int k = 0; k < 12; ++k) {
+    jacobian.col(k) = (function(Vector12(h*Vector12::Unit(k))) - function(Vector12(-h*Vector12::Unit(k))))/(2.0*h);
+  }
+  return jacobian;
+}
+
+TEST(PoseCovarianceTest, TransformedAndInverted) {
+  const Pose pose = getPose(3);
+  const Matrix6 covariance = getRandomCovariance<6>();
+  const Matrix6 adjoint = kindr::getAdjointMatrix(pose);
+  const Matrix6 transformed = kindr::getTransformedCovariance(pose, covariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6(adjoint*covariance*adjoint.transpose()), transformed, 1e-12, 1e-12, "transformed");
+  ASSERT_TRUE(transformed == transformed.transpose());
+
+  // (exp(d)*T)^-1 = exp(J*d)*T^-1
+  const Eigen::Matrix<double, 6, 12> jacobian = getNumericalJacobian<6>([&](const Vector12& d) {
+    return Vector6(getInverse(pose.boxPlus(d.head<6>())).boxMinus(getInverse(pose)));
+  });
+  const Matrix6 inverted = kindr::getInvertedCovariance(pose, covariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6(jacobian.leftCols<6>()*covariance*jacobian.leftCols<6>().transpose()), inverted, 1e-8, 1e-8, "inverted");
+  ASSERT_TRUE(inverted == inverted.transpose());
+}
+
+TEST(PoseCovarianceTest, Composed) {
+  const Pose pose1 = getPose(3);
+  const Pose pose2 = getPose(-5);
+  const Matrix6 covariance1 = getRandomCovariance<6>();
+  const Matrix6 covariance2 = getRandomCovariance<6>();
+  // exp(d1)*T1*exp(d2)*T2 = exp(J*[d1; d2])*T1*T2
+  const Pose composition = pose1*pose2;
+  const Eigen::Matrix<double, 6, 12> jacobian = getNumericalJacobian<6>([&](const Vector12& d) {
+    return Vector6(Pose(pose1.boxPlus(d.head<6>())*pose2.boxPlus(d.tail<6>())).boxMinus(composition));
+  });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6(jacobian*getBlockDiagonal(covariance1, covariance2)*jacobian.transpose()),
+                                    kindr::getComposedCovariance(pose1, covariance1, covariance2), 1e-8, 1e-8, "composed");
+}
+
+TEST(PoseCovarianceTest, BoxPlus) {
+  const Pose pose = getPose(2);
+  const Matrix6 covariance = getRandomCovariance<6>();
+  const Matrix6 vectorCovariance = getRandomCovariance<6>();
+  Vector6 vector;
+  vector << 0.4, -0.7, 1.1, 0.6, -0.9, 0.5;
+  const Pose result = pose.boxPlus(vector);
+  const Eigen::Matrix<double, 6, 12> jacobian = getNumericalJacobian<6>([&](const Vector12& d) {
+    return Vector6(Pose(pose.boxPlus(d.head<6>())).boxPlus(Vector6(vector + d.tail<6>())).boxMinus(result));
+  });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6(jacobian*getBlockDiagonal(covariance, vectorCovariance)*jacobian.transpose()),
+                                    kindr::getBoxPlusCovariance(covariance, vector, vectorCovariance), 1e-8, 1e-8, "boxPlus");
+}
+
+TEST(PoseCovarianceTest, TransformedPosition) {
+  const Pose pose = getPose(4);
+  const Matrix6 covariance = getRandomCovariance<6>();
+  const Matrix3 positionCovariance = getRandomCovariance<3>();
+  const Eigen::Vector3d position(1.5, -0.4, 2.0);
+  const Eigen::Vector3d transformed = pose.transform(Position(position)).toImplementation();
+  const Eigen::Matrix<double, 3, 12> jacobian = getNumericalJacobian<3>([&](const Vector12& d) {
+    return Eigen::Vector3d(Pose(pose.boxPlus(d.head<6>())).transform(Position(position + d.segment<3>(6))).toImplementation() - transformed);
+  });
+  Matrix12 jointCovariance = Matrix12::Zero();
+  jointCovariance.topLeftCorner<6, 6>() = covariance;
+  jointCovariance.block<3, 3>(6, 6) = positionCovariance;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3(jacobian*jointCovariance*jacobian.transpose()),
+                                    kindr::getTransformedPositionCovariance(pose, covariance, position, positionCovariance), 1e-8, 1e-8, "transformed position");
+}
+
+TEST(PoseCovarianceTest, TransformedPositionBatch) {
+  // two full chunks of the executor and a remainder
+  const int size = 2*kindr::internal::CovarianceBatchGrainSize + 300;
+  const Pose pose = getPose(4);
+  const Matrix6 covariance = getRandomCovariance<6>();
+  const Matrix3X positions = 5.0*Matrix3X::Random(3, size);
+  Matrix6X positionCovariances(6, size);
+  for (int i = 0; i < size; ++i) {
+    positionCovariances.col(i) = kindr::packCovariance(getRandomCovariance<3>());
+  }
+
+  Matrix3X transformedPositions(3, size);
+  Matrix6X transformedCovariances(6, size);
+  kindr::transformPositionsWithCovariance(pose, covariance, positions, positionCovariances, transformedPositions, transformedCovariances);
+  for (int i = 0; i < size; ++i) {
+    const Eigen::Vector3d position = positions.col(i);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.transform(Position(position)).toImplementation(), Eigen::Vector3d(transformedPositions.col(i)), 1e-12, 1e-12, "positions");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::getTransformedPositionCovariance(pose, covariance, position, kindr::unpackCovariance(positionCovariances.col(i))),
+                                      kindr::unpackCovariance(transformedCovariances.col(i)), 1e-10, 1e-12, "covariances");
+  }
+
+  // the executor only changes how the positions are split
+  Matrix6X threadedCovariances(6, size);
+  kindr::transformPositionsWithCovariance(pose, covariance, positions, positionCovariances, transformedPositions, threadedCovariances, kindr::ThreadPoolExecutor(2));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(transformedCovariances, threadedCovariances, 1e-12, 1e-12, "executor");
+}
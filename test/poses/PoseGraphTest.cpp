@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/PoseGraph.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef kindr::HomTransformQuatD Pose;
+typedef Pose::Position Position;
+typedef Pose::Rotation Rotation;
+typedef Eigen::Matrix<double, 6, 1> Vector6;
+typedef Eigen::Matrix<double, 6, 6> Matrix6;
+typedef kindr::AlignedVector<Pose> Poses;
+typedef kindr::PoseGraphEdge<Pose> Edge;
+typedef kindr::AlignedVector<Edge> Edges;
+
+static Pose getPose(int i) {
+  return Pose(Position(0.1*i, -0.3 + 0.02*i, 0.2), Rotation(kindr::EulerAnglesZyx<double>(0.3*i, -0.1 + 0.07*i, 0.05*i)));
+}
+
+static Pose getExponentialMap(const Vector6& vector) {
+  return Pose().exponentialMap(vector);
+}
+
+TEST(PoseJacobiansTest, JacobianOfExponentialMap) {
+  const double h = 1e-6;
+  // Rotation angles below and above the switch to the series of the coupling block
+  for (const double angle : {0.0, 1e-3, 0.3, 0.6, 2.5}) {
+    Vector6 vector;
+    vector << 0.4, -0.7, 1.1, Eigen::Vector3d(0.6, -0.3, 0.74).normalized()*angle;
+    const Matrix6 jacobian = kindr::getJacobianOfExponentialMap(vector);
+    const Matrix6 inverseJacobian = kindr::getJacobianOfLogarithmicMap(vector);
+    Matrix6 numericalJacobian;
+    for (int k = 0; k < 6; ++k) {
+      // exp(x + d) = exp(J*d)*exp(x)
+      numericalJacobian.col(k) = getExponentialMap(vector + h*Vector6::Unit(k)).boxMinus(getExponentialMap(vector - h*Vector6::Unit(k)))/(2.0*h);
+    }
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalJacobian, jacobian, 1e-7, 1e-6, "exponential map");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6::Identity(), Matrix6(inverseJacobian*jacobian), 1e-12, 1e-12, "logarithmic map");
+  }
+}
+
+TEST(PoseJacobiansTest, AdjointMatrix) {
+  const Pose pose = getPose(3);
+  Vector6 vector;
+  vector << 0.2, -0.1, 0.3, 0.1, 0.4, -0.2;
+  // T*exp(d)*T^-1 = exp(Ad_T*d)
+  const Pose conjugated = pose*getExponentialMap(vector)*Pose(getPose(3).exponentialMap(-pose.logarithmicMap()));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector6(kindr::getAdjointMatrix(pose)*vector), conjugated.logarithmicMap(), 1e-10, 1e-10, "adjoint");
+}
+
+TEST(PoseGraphTest, RelativePoseError) {
+  const double h = 1e-6;
+  const Pose first = getPose(2);
+  const Pose second = getPose(5);
+  const Pose measurement = Pose(Position(0.25, -0.1, 0.05), Rotation(kindr::EulerAnglesZyx<double>(0.8, 0.2, 0.1)));
+
+  // The error is boxMinus(T_i^-1*T_j, T_ij)
+  const Pose relative(Position(first.getRotation().inverseRotate(second.getPosition() - first.getPosition())),
+                      first.getRotation().inverted()*second.getRotation());
+  const Vector6 error = kindr::getRelativePoseError(first, second, measurement);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(relative.boxMinus(measurement), error, 1e-12, 1e-12, "error");
+
+  Matrix6 jacobianFirst, jacobianSecond;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(error, kindr::getRelativePoseError(first, second, measurement, jacobianFirst, jacobianSecond), 1e-12, 1e-12, "error");
+  Matrix6 numericalJacobianFirst, numericalJacobianSecond;
+  for (int k = 0; k < 6; ++k) {
+    const Vector6 d = h*Vector6::Unit(k);
+    numericalJacobianFirst.col(k) = (kindr::getRelativePoseError(first.boxPlus(d), second, measurement)
+        - kindr::getRelativePoseError(first.boxPlus(-d), second, measurement))/(2.0*h);
+    numericalJacobianSecond.col(k) = (kindr::getRelativePoseError(first, second.boxPlus(d), measurement)
+        - kindr::getRelativePoseError(first, second.boxPlus(-d), measurement))/(2.0*h);
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalJacobianFirst, jacobianFirst, 1e-7, 1e-6, "first Jacobian");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalJacobianSecond, jacobianSecond, 1e-7, 1e-6, "second Jacobian");
+}
+
+TEST(PoseGraphTest, RelativePoseErrorAtAngleOfPi) {
+  // The error rotation is the rotation by pi about the x-axis, its quaternion has the real part 0
+  const Pose first;
+  const Pose second(Position(0.3, -0.5, 0.2), Rotation(0.0, 1.0, 0.0, 0.0));
+  const Pose measurement;
+  Matrix6 jacobianFirst, jacobianSecond;
+  const Vector6 error = kindr::getRelativePoseError(first, second, measurement, jacobianFirst, jacobianSecond);
+  ASSERT_TRUE(error.allFinite());
+  ASSERT_TRUE(jacobianFirst.allFinite());
+  ASSERT_TRUE(jacobianSecond.allFinite());
+
+  // J^-1(w) = I - 1/2*[w]x + 1/pi^2*[w]x^2 at the angle pi
+  const Eigen::Vector3d w = error.tail<3>();
+  const Eigen::Vector3d t = second.getPosition().toImplementation();
+  ASSERT_NEAR(M_PI, w.norm(), 1e-12);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Eigen::Vector3d(t - 0.5*w.cross(t) + w.cross(w.cross(t))/(M_PI*M_PI)), Eigen::Vector3d(error.head<3>()), 1e-12, 1e-12, "error");
+}
+
+TEST(PoseGraphTest, RelativePoseErrors) {
+  // A chain with loop closures, large enough to be split on the executor
+  Poses poses;
+  for (int i = 0; i < 400; ++i) {
+    poses.push_back(getPose(i));
+  }
+  Edges edges;
+  for (int i = 0; i + 1 < static_cast<int>(poses.size()); ++i) {
+    edges.push_back(Edge(i, i+1, Pose(Position(0.1, 0.02, 0.0), Rotation(kindr::EulerAnglesZyx<double>(0.3, 0.07, 0.05)))));
+    if (i % 7 == 0 && i >= 50) {
+      edges.push_back(Edge(i, i-50, Pose(Position(-5.0, -1.0, 0.1), Rotation(kindr::EulerAnglesZyx<double>(0.2, 0.5, -0.3)))));
+    }
+  }
+  const int numEdges = static_cast<int>(edges.size());
+
+  Eigen::Matrix<double, 6, Eigen::Dynamic> errors(6, numEdges);
+  Eigen::Matrix<double, 6, Eigen::Dynamic> jacobiansFirst(6, 6*numEdges), jacobiansSecond(6, 6*numEdges);
+  kindr::getRelativePoseErrors(poses, edges, errors, jacobiansFirst, jacobiansSecond);
+  for (int e = 0; e < numEdges; ++e) {
+    Matrix6 jacobianFirst, jacobianSecond;
+    const Vector6 error = kindr::getRelativePoseError(poses[edges[e].getFirst()], poses[edges[e].getSecond()], edges[e].getMeasurement(), jacobianFirst, jacobianSecond);
+    ASSERT_TRUE(error == errors.col(e));
+    ASSERT_TRUE(jacobianFirst == jacobiansFirst.middleCols<6>(6*e));
+    ASSERT_TRUE(jacobianSecond == jacobiansSecond.middleCols<6>(6*e));
+  }
+
+  Eigen::Matrix<double, 6, Eigen::Dynamic> errorsOnly(6, numEdges);
+  kindr::getRelativePoseErrors(poses, edges, errorsOnly);
+  EXPECT_TRUE(errors == errorsOnly);
+
+  kindr::ThreadPoolExecutor executor(4);
+  Eigen::Matrix<double, 6, Eigen::Dynamic> parallelErrors(6, numEdges);
+  Eigen::Matrix<double, 6, Eigen::Dynamic> parallelJacobiansFirst(6, 6*numEdges), parallelJacobiansSecond(6, 6*numEdges);
+  kindr::getRelativePoseErrors(poses, edges, parallelErrors, parallelJacobiansFirst, parallelJacobiansSecond, executor);
+  EXPECT_TRUE(errors == parallelErrors);
+  EXPECT_TRUE(jacobiansFirst == parallelJacobiansFirst);
+  EXPECT_TRUE(jacobiansSecond == parallelJacobiansSecond);
+
+  // Invalid node indices and output sizes are rejected before any edge is evaluated
+  Edges invalidEdges(1, Edge(0, static_cast<int>(poses.size()), Pose()));
+  Eigen::Matrix<double, 6, Eigen::Dynamic> invalidErrors(6, 1);
+  EXPECT_THROW(kindr::getRelativePoseErrors(poses, invalidEdges, invalidErrors), std::runtime_error);
+  EXPECT_THROW(kindr::getRelativePoseErrors(poses, edges, invalidErrors), std::runtime_error);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/Twist.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename Pose_>
+struct PoseMapsTest: public ::testing::Test {
+  typedef Pose_ Pose;
+  typedef typename Pose::Scalar Scalar;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+  typedef Eigen::Matrix<Scalar, 6, 1> Vector6;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 4, 4> Matrix4;
+
+  Pose pose;
+  std::vector<Vector6> vectors;
+
+  PoseMapsTest() : pose(Position(1.0, -2.0, 0.5), Rotation(kindr::EulerAnglesZyx<Scalar>(0.3, -0.2, 0.7))) {
+    const Vector3 translation(0.4, -0.3, 0.9);
+    const Vector3 axis = Vector3(0.2, -0.5, 0.8).normalized();
+    const Scalar angles[] = {0.0, 1e-7, 1e-3, 0.5, 2.0, 3.1};
+    for (Scalar angle : angles) {
+      Vector6 vector;
+      vector << translation, angle*axis;
+      vectors.push_back(vector);
+    }
+  }
+
+  //! Computes the exponential of the 4x4 twist matrix by its Taylor series
+  static Matrix4 getReferenceExponentialMap(const Vector6& vector) {
+    Matrix4 twistMatrix = Matrix4::Zero();
+    twistMatrix.template topLeftCorner<3,3>() = kindr::getSkewMatrixFromVector(Vector3(vector.template tail<3>()));
+    twistMatrix.template topRightCorner<3,1>() = vector.template head<3>();
+    Matrix4 exponential = Matrix4::Identity();
+    Matrix4 term = Matrix4::Identity();
+    for (int k = 1; k < 40; ++k) {
+      term = term*twistMatrix/Scalar(k);
+      exponential += term;
+    }
+    return exponential;
+  }
+};
+
+typedef ::testing::Types<
+    kindr::HomTransformQuatD,
+    kindr::HomTransformQuatF,
+    kindr::HomTransformMatrixD,
+    kindr::CachedHomTransformQuatD
+> Types;
+
+TYPED_TEST_CASE(PoseMapsTest, Types);
+
+
+TYPED_TEST(PoseMapsTest, testExponentialMap)
+{
+  typedef typename TestFixture::Pose Pose;
+  for (const auto& vector : this->vectors) {
+    const Pose pose = Pose().exponentialMap(vector);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->getReferenceExponentialMap(vector), pose.getTransformationMatrix(), 1e-5, 1e-4, "exponential map");
+  }
+}
+
+TYPED_TEST(PoseMapsTest, testLogarithmicMap)
+{
+  typedef typename TestFixture::Pose Pose;
+  for (const auto& vector : this->vectors) {
+    const Pose pose = Pose().exponentialMap(vector);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(vector, pose.logarithmicMap(), 1e-4, 1e-3, "logarithmic map");
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(TestFixture::Vector6::Zero(), Pose().logarithmicMap(), 1e-8, 1e-8, "identity");
+}
+
+TYPED_TEST(PoseMapsTest, testBoxOperations)
+{
+  typedef typename TestFixture::Pose Pose;
+  for (const auto& vector : this->vectors) {
+    // Global perturbation from the left
+    const Pose poseLeft = this->pose.boxPlus(vector);
+    const Pose expectedPoseLeft = Pose().exponentialMap(vector)*this->pose;
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedPoseLeft.getTransformationMatrix(), poseLeft.getTransformationMatrix(), 1e-5, 1e-4, "box plus");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(vector, poseLeft.boxMinus(this->pose), 1e-4, 1e-3, "box minus");
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(TestFixture::Vector6::Zero(), this->pose.boxMinus(this->pose), 1e-6, 1e-6, "box minus self");
+}
+
+TYPED_TEST(PoseMapsTest, testIntegrationWithTwist)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  const kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> twist(Vector3(0.4, -0.3, 0.9), Vector3(1.0, -2.0, 0.5));
+  const Scalar dt = 0.01;
+
+  // Local twist perturbs from the right
+  const Pose pose = this->pose.boxPlus(twist*dt);
+  const Pose expectedPose = this->pose*Pose().exponentialMap(twist.getVector()*dt);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedPose.getTransformationMatrix(), pose.getTransformationMatrix(), 1e-5, 1e-4, "twist");
+
+  // Integrating in many small segments is the same as integrating once
+  Pose integratedPose = this->pose;
+  for (int i = 0; i < 10; ++i) {
+    integratedPose = integratedPose.boxPlus(twist*Scalar(0.1*dt));
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedPose.getTransformationMatrix(), integratedPose.getTransformationMatrix(), 1e-5, 1e-4, "segments");
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/PoseTrajectory.hpp"
+#include "kindr/rotations/RotationQuaternionInterpolation.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename Pose_>
+struct PoseTrajectoryTest: public ::testing::Test {
+  typedef Pose_ Pose;
+  typedef typename Pose::Scalar Scalar;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+  typedef kindr::PoseTrajectory<Pose> Trajectory;
+  typedef typename Trajectory::Twist Twist;
+  typedef Eigen::Matrix<Scalar, 6, 1> Vector6;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-4) : Scalar(1e-10);
+
+  //! Samples at the times 0.1*i
+  Pose getPose(int i) const {
+    return Pose(Position(0.1*i, -0.3, 0.2+0.01*i), Rotation(kindr::EulerAnglesZyx<Scalar>(0.2*i, -0.1, 0.05*i)));
+  }
+
+  Twist getTwist(int i) const {
+    return Twist(Vector6(Vector6::Constant(Scalar(i))));
+  }
+
+  void fill(Trajectory& trajectory, int begin, int end) const {
+    for (int i = begin; i < end; ++i) {
+      trajectory.push(Scalar(0.1)*Scalar(i), getPose(i), getTwist(i));
+    }
+  }
+
+  void expectSample(Trajectory& trajectory, int i, const std::string& message) const {
+    const Scalar time = Scalar(0.1)*Scalar(i);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(getPose(i).getTransformationMatrix(), trajectory.getPose(time).getTransformationMatrix(), tol, tol, message);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(getTwist(i).getVector(), trajectory.getTwist(time).getVector(), tol, tol, message);
+  }
+};
+
+typedef ::testing::Types<
+    kindr::HomTransformQuatD,
+    kindr::HomTransformQuatF,
+    kindr::HomTransformMatrixD
+> Types;
+
+TYPED_TEST_CASE(PoseTrajectoryTest, Types);
+
+
+TYPED_TEST(PoseTrajectoryTest, testLookup)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Twist Twist;
+  typedef typename TestFixture::Rotation Rotation;
+
+  typename TestFixture::Trajectory trajectory(20);
+  EXPECT_TRUE(trajectory.empty());
+  EXPECT_THROW(trajectory.getPose(Scalar(0)), std::runtime_error);
+  this->fill(trajectory, 0, 10);
+  EXPECT_EQ(10, trajectory.size());
+  EXPECT_THROW(trajectory.push(Scalar(0.9), this->getPose(0)), std::runtime_error);
+  EXPECT_THROW(trajectory.getPose(Scalar(-0.01)), std::runtime_error);
+  EXPECT_THROW(trajectory.getPose(Scalar(0.91)), std::runtime_error);
+
+  // Samples in random and in sequential order
+  const int samples[] = {9, 0, 4, 3, 5, 8};
+  for (int i : samples) {
+    this->expectSample(trajectory, i, "sample");
+  }
+  for (int i = 0; i < 10; ++i) {
+    this->expectSample(trajectory, i, "sequential sample");
+  }
+
+  // Interpolation between the samples 3 and 4
+  const Scalar t = Scalar(0.25);
+  const Pose pose3 = this->getPose(3);
+  const Pose pose4 = this->getPose(4);
+  Pose pose;
+  Twist twist;
+  trajectory.lookup(Scalar(0.3) + t*Scalar(0.1), pose, twist);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(((Scalar(1) - t)*pose3.getPosition() + t*pose4.getPosition()).toImplementation(),
+                                    pose.getPosition().toImplementation(), this->tol, this->tol, "position");
+  ASSERT_TRUE(pose.getRotation().isNear(Rotation(kindr::slerp(kindr::RotationQuaternion<Scalar>(pose3.getRotation()),
+                                                              kindr::RotationQuaternion<Scalar>(pose4.getRotation()), t)), this->tol));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(TestFixture::Vector6::Constant(Scalar(3.25)), twist.getVector(), this->tol, this->tol, "twist");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.getTransformationMatrix(), trajectory.getPose(Scalar(0.325)).getTransformationMatrix(), this->tol, this->tol, "pose");
+}
+
+TYPED_TEST(PoseTrajectoryTest, testRingBuffer)
+{
+  typedef typename TestFixture::Scalar Scalar;
+
+  // The oldest samples are overwritten, and the lookups wrap around the end of the buffer
+  typename TestFixture::Trajectory trajectory(8);
+  this->fill(trajectory, 0, 13);
+  EXPECT_EQ(8, trajectory.size());
+  EXPECT_EQ(8, trajectory.getCapacity());
+  EXPECT_NEAR(Scalar(0.5), trajectory.getStartTime(), this->tol);
+  EXPECT_NEAR(Scalar(1.2), trajectory.getEndTime(), this->tol);
+  EXPECT_FALSE(trajectory.contains(Scalar(0.45)));
+  for (int i = 5; i < 13; ++i) {
+    this->expectSample(trajectory, i, "wrapped sample");
+    EXPECT_NEAR(Scalar(0.1)*Scalar(i), trajectory.getSampleTime(i - 5), this->tol);
+  }
+  this->expectSample(trajectory, 7, "wrapped sample");
+
+  // The newest sample at or before the time is kept
+  trajectory.evictBefore(Scalar(0.85));
+  EXPECT_EQ(5, trajectory.size());
+  EXPECT_NEAR(Scalar(0.8), trajectory.getStartTime(), this->tol);
+  this->expectSample(trajectory, 12, "after eviction");
+  this->expectSample(trajectory, 8, "after eviction");
+  trajectory.evictBefore(Scalar(0.5));
+  EXPECT_EQ(5, trajectory.size());
+  trajectory.evictBefore(Scalar(1.3));
+  EXPECT_EQ(1, trajectory.size());
+  EXPECT_NEAR(Scalar(1.2), trajectory.getStartTime(), this->tol);
+
+  trajectory.clear();
+  EXPECT_TRUE(trajectory.empty());
+  this->fill(trajectory, 20, 22);
+  this->expectSample(trajectory, 21, "after clear");
+}
+
+TYPED_TEST(PoseTrajectoryTest, testWindow)
+{
+  typedef typename TestFixture::Scalar Scalar;
+
+  typename TestFixture::Trajectory trajectory(100, Scalar(0.35));
+  this->fill(trajectory, 0, 20);
+  EXPECT_EQ(5, trajectory.size());
+  EXPECT_NEAR(Scalar(1.5), trajectory.getStartTime(), this->tol);
+  EXPECT_TRUE(trajectory.contains(Scalar(1.9) - Scalar(0.35)));
+  this->expectSample(trajectory, 16, "windowed sample");
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/RigidBodyTree.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename Tree_>
+struct RigidBodyTreeTest: public ::testing::Test {
+  typedef Tree_ Tree;
+  typedef typename Tree::Scalar Scalar;
+  typedef typename Tree::Vector3 Vector3;
+  typedef typename Tree::Matrix3 Matrix3;
+  typedef typename Tree::Vector6 Vector6;
+  typedef typename Tree::JointVector JointVector;
+  typedef typename Tree::JointType JointType;
+  typedef typename Tree::Inertia Inertia;
+  typedef typename Tree::Twist Twist;
+  typedef typename Tree::Wrench Wrench;
+  typedef kindr::HomTransformQuat<Scalar> ReferencePose;
+  enum { NumBodies = Tree::NumBodies };
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-3) : Scalar(1e-9);
+
+  std::vector<int> parents;
+  std::vector<ReferencePose> linkTransforms;
+  std::vector<Vector3> axes;
+  std::vector<JointType> types;
+  Tree tree;
+  Vector3 gravity = Vector3(0.5, -1.0, -9.81);
+  JointVector jointPositions;
+  JointVector jointVelocities;
+  JointVector jointAccelerations;
+  Twist baseTwist = Twist(Vector6((Vector6() << 0.3, -0.5, 1.1, 0.2, 0.7, -0.4).finished()));
+  Twist baseAcceleration = Twist(Vector6((Vector6() << -0.6, 0.1, 0.4, 0.9, -0.3, 0.5).finished()));
+
+  //! Branched tree with a new branch at the base or at an existing body at every third joint
+  RigidBodyTreeTest() {
+    for (int i = 0; i < NumBodies; ++i) {
+      parents.push_back(i % 3 == 0 ? i/3 - 1 : i - 1);
+      linkTransforms.push_back(ReferencePose(typename ReferencePose::Position(0.1*i, -0.2, 0.3+0.05*i),
+                                             typename ReferencePose::Rotation(kindr::EulerAnglesZyx<Scalar>(0.3*i, -0.2, 0.1*i))));
+      axes.push_back(Vector3(0.2*i, 1.0, -0.5));
+      types.push_back(i % 4 == 2 ? JointType::Prismatic : JointType::Revolute);
+      const Matrix3 rotationalInertia = Vector3(0.02 + 0.01*i, 0.03, 0.025).asDiagonal();
+      const Inertia inertia(Scalar(1.0 + 0.1*i), kindr::Position<Scalar, 3>(0.05, 0.1 - 0.02*i, 0.15), rotationalInertia);
+      tree.setBody(i, parents[i], linkTransforms[i], axes[i], types[i], inertia);
+    }
+    tree.setBaseInertia(Inertia(5.0, kindr::Position<Scalar, 3>(0.02, -0.01, 0.03), Matrix3(Vector3(0.2, 0.3, 0.4).asDiagonal())));
+    for (int i = 0; i < NumBodies; ++i) {
+      jointPositions(i) = Scalar(0.3*std::sin(1.0 + i));
+      jointVelocities(i) = Scalar(0.8*std::cos(2.0 + 3*i));
+      jointAccelerations(i) = Scalar(std::sin(3.0 + 2*i));
+    }
+    tree.setJointPositions(jointPositions);
+  }
+
+  //! \returns the poses of the bodies in the base frame by concatenation of the link transformations and the joints
+  std::vector<ReferencePose> getReferenceTransforms(const JointVector& positions) const {
+    std::vector<ReferencePose> transforms;
+    for (int i = 0; i < NumBodies; ++i) {
+      ReferencePose joint;
+      if (types[i] == JointType::Revolute) {
+        joint = ReferencePose(typename ReferencePose::Position(), typename ReferencePose::Rotation(kindr::AngleAxis<Scalar>(positions(i), axes[i].normalized())));
+      } else {
+        joint = ReferencePose(typename ReferencePose::Position(positions(i)*axes[i].normalized()), typename ReferencePose::Rotation());
+      }
+      transforms.push_back((parents[i] == Tree::Base ? ReferencePose() : transforms[parents[i]])*linkTransforms[i]*joint);
+    }
+    return transforms;
+  }
+
+  //! \returns the kinetic energy of the bodies with the body twists obtained by finite differences of their poses
+  Scalar getKineticEnergy(const JointVector& positions, const JointVector& velocities) const {
+    const Scalar h = 1e-6;
+    const std::vector<ReferencePose> transforms = getReferenceTransforms(positions);
+    const std::vector<ReferencePose> forward = getReferenceTransforms(positions + h*velocities);
+    const std::vector<ReferencePose> backward = getReferenceTransforms(positions - h*velocities);
+    Scalar energy = 0;
+    for (int i = 0; i < NumBodies; ++i) {
+      const Vector3 linearVelocity = transforms[i].getRotation().inverseRotate(
+          Vector3((forward[i].getPosition() - backward[i].getPosition()).toImplementation()/(2*h)));
+      const Vector3 angularVelocity = kindr::RotationVector<Scalar>(backward[i].getRotation().inverted()*forward[i].getRotation()).vector()/(2*h);
+      energy += tree.getInertia(i).getKineticEnergy(Twist(linearVelocity, angularVelocity));
+    }
+    return energy;
+  }
+
+  //! \returns the potential energy of the bodies in the gravitational field
+  Scalar getPotentialEnergy(const JointVector& positions) const {
+    const std::vector<ReferencePose> transforms = getReferenceTransforms(positions);
+    Scalar energy = 0;
+    for (int i = 0; i < NumBodies; ++i) {
+      energy -= tree.getInertia(i).getMass()*gravity.dot(transforms[i].transform(tree.getInertia(i).getCenterOfMass()).toImplementation());
+    }
+    return energy;
+  }
+
+  //! \returns the generalized momentum dT/dqd, which is exact for the quadratic kinetic energy
+  JointVector getGeneralizedMomentum(const JointVector& positions, const JointVector& velocities) const {
+    JointVector momentum;
+    for (int j = 0; j < NumBodies; ++j) {
+      const JointVector unit = JointVector::Unit(j);
+      momentum(j) = (getKineticEnergy(positions, velocities + unit) - getKineticEnergy(positions, velocities - unit))/2;
+    }
+    return momentum;
+  }
+};
+
+typedef ::testing::Types<
+    kindr::RigidBodyTree<double, 1>,
+    kindr::RigidBodyTree<double, 7>,
+    kindr::RigidBodyTree<float, 7>,
+    kindr::RigidBodyTree<double, 12>
+> Types;
+
+TYPED_TEST_CASE(RigidBodyTreeTest, Types);
+
+
+TYPED_TEST(RigidBodyTreeTest, testLocalTransforms)
+{
+  typedef typename TestFixture::ReferencePose ReferencePose;
+  const std::vector<ReferencePose> transforms = this->getReferenceTransforms(this->jointPositions);
+  for (int i = 0; i < TestFixture::NumBodies; ++i) {
+    const ReferencePose parent = this->parents[i] == TestFixture::Tree::Base ? ReferencePose() : transforms[this->parents[i]];
+    const ReferencePose local = parent.inverted()*transforms[i];
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(local.getTransformationMatrix(), this->tree.getLocalTransform(i).getTransformationMatrix(), this->tol, this->tol, "local transform");
+  }
+}
+
+TYPED_TEST(RigidBodyTreeTest, testForwardDynamicsFixedBase)
+{
+  typedef typename TestFixture::JointVector JointVector;
+  JointVector jointTorques, jointAccelerations;
+  this->tree.computeInverseDynamics(this->jointVelocities, this->jointAccelerations, this->gravity, jointTorques);
+  this->tree.computeForwardDynamics(this->jointVelocities, jointTorques, this->gravity, jointAccelerations);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->jointAccelerations, jointAccelerations, 10*this->tol, 10*this->tol, "joint accelerations");
+}
+
+TYPED_TEST(RigidBodyTreeTest, testForwardDynamicsFloatingBase)
+{
+  typedef typename TestFixture::JointVector JointVector;
+  typedef typename TestFixture::Twist Twist;
+  typedef typename TestFixture::Wrench Wrench;
+  const JointVector jointTorques = 2*this->jointAccelerations;
+  JointVector jointAccelerations, inverseJointTorques;
+  const Twist baseAcceleration = this->tree.computeForwardDynamics(this->baseTwist, this->jointVelocities, jointTorques, this->gravity, jointAccelerations);
+  const Wrench baseWrench = this->tree.computeInverseDynamics(this->baseTwist, baseAcceleration, this->jointVelocities, jointAccelerations, this->gravity, inverseJointTorques);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jointTorques, inverseJointTorques, 10*this->tol, 10*this->tol, "joint torques");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Wrench().getVector(), baseWrench.getVector(), 10*this->tol, 10*this->tol, "base wrench");
+}
+
+TYPED_TEST(RigidBodyTreeTest, testForwardDynamicsSingularInertia)
+{
+  typedef typename TestFixture::JointVector JointVector;
+  typedef typename TestFixture::Inertia Inertia;
+  JointVector jointAccelerations;
+  typename TestFixture::Tree masslessTree;
+  masslessTree.setJointPositions(this->jointPositions);
+  EXPECT_THROW(masslessTree.computeForwardDynamics(this->jointVelocities, JointVector::Zero(), this->gravity, jointAccelerations), std::runtime_error);
+
+  // A fixed base needs no base inertia, a floating base does
+  this->tree.setBaseInertia(Inertia());
+  EXPECT_NO_THROW(this->tree.computeForwardDynamics(this->jointVelocities, JointVector::Zero(), this->gravity, jointAccelerations));
+  EXPECT_THROW(this->tree.computeForwardDynamics(this->baseTwist, this->jointVelocities, JointVector::Zero(), this->gravity, jointAccelerations), std::runtime_error);
+}
+
+TYPED_TEST(RigidBodyTreeTest, testInverseDynamicsCompositeBody)
+{
+  // Without joint motion the tree moves like a single rigid body with the composite inertia
+  typedef typename TestFixture::ReferencePose ReferencePose;
+  typedef typename TestFixture::Inertia Inertia;
+  typedef typename TestFixture::Twist Twist;
+  typedef typename TestFixture::JointVector JointVector;
+  typedef typename TestFixture::Vector3 Vector3;
+  const std::vector<ReferencePose> transforms = this->getReferenceTransforms(this->jointPositions);
+  Inertia compositeInertia = this->tree.getBaseInertia();
+  for (int i = 0; i < TestFixture::NumBodies; ++i) {
+    compositeInertia += kindr::transformInertia(transforms[i], this->tree.getInertia(i));
+  }
+  JointVector jointTorques;
+  const typename TestFixture::Wrench baseWrench = this->tree.computeInverseDynamics(this->baseTwist, this->baseAcceleration, JointVector::Zero(),
+                                                                                    JointVector::Zero(), this->gravity, jointTorques);
+  const Twist acceleration(Vector3(this->baseAcceleration.getTranslationalVelocity().toImplementation() - this->gravity),
+                           this->baseAcceleration.getRotationalVelocity().toImplementation());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::getNetWrench(compositeInertia, this->baseTwist, acceleration).getVector(), baseWrench.getVector(),
+                                    10*this->tol, 10*this->tol, "base wrench");
+}
+
+typedef RigidBodyTreeTest<kindr::RigidBodyTree<double, 7>> RigidBodyTreeDoubleTest;
+
+TEST_F(RigidBodyTreeDoubleTest, testInverseDynamicsLagrange)
+{
+  // tau = d/dt dT/dqd - dT/dq + dV/dq with the energies of the reference kinematics and finite differences
+  const JointVector& q = jointPositions;
+  const JointVector& qd = jointVelocities;
+  const JointVector& qdd = jointAccelerations;
+  const double h = 1e-4;
+  const JointVector momentumRate = (getGeneralizedMomentum(q + h*qd, qd + h*qdd) - getGeneralizedMomentum(q - h*qd, qd - h*qdd))/(2*h);
+  JointVector expectedTorques;
+  for (int j = 0; j < NumBodies; ++j) {
+    const JointVector step = h*JointVector::Unit(j);
+    const double kineticEnergyGradient = (getKineticEnergy(q + step, qd) - getKineticEnergy(q - step, qd))/(2*h);
+    const double potentialEnergyGradient = (getPotentialEnergy(q + step) - getPotentialEnergy(q - step))/(2*h);
+    expectedTorques(j) = momentumRate(j) - kineticEnergyGradient + potentialEnergyGradient;
+  }
+  JointVector jointTorques;
+  tree.computeInverseDynamics(qd, qdd, gravity, jointTorques);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedTorques, jointTorques, 1e-5, 1e-5, "joint torques");
+}
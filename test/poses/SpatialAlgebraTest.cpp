@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/SpatialAlgebra.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename Pose_>
+struct SpatialAlgebraTest: public ::testing::Test {
+  typedef Pose_ Pose;
+  typedef typename Pose::Scalar Scalar;
+  typedef kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> Twist;
+  typedef kindr::Wrench6<Scalar> Wrench;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 6, 6> Matrix6;
+  typedef Eigen::Matrix<Scalar, 6, 1> Vector6;
+  typedef Eigen::Matrix<Scalar, 6, Eigen::Dynamic> Matrix6X;
+
+  Pose pose = Pose(typename Pose::Position(0.4, -1.2, 0.7), typename Pose::Rotation(kindr::EulerAnglesZyx<Scalar>(0.5, -0.9, 1.2)));
+  Twist twist = Twist(Vector6((Vector6() << 0.3, -0.5, 1.1, 0.2, 0.7, -0.4).finished()));
+  Twist otherTwist = Twist(Vector6((Vector6() << -0.6, 0.1, 0.4, 0.9, -0.3, 0.5).finished()));
+  Wrench wrench = Wrench(Vector6((Vector6() << 4.0, -1.0, 7.0, 0.2, 0.3, -0.5).finished()));
+
+  //! Adjoint matrix of the pose acting on [v; w]
+  Matrix6 getAdjoint() const {
+    const Matrix3 rotationMatrix = kindr::RotationMatrix<Scalar>(pose.getRotation()).matrix();
+    Matrix6 adjoint = Matrix6::Zero();
+    adjoint.template topLeftCorner<3,3>() = rotationMatrix;
+    adjoint.template topRightCorner<3,3>() = kindr::getSkewMatrixFromVector(pose.getPosition().toImplementation())*rotationMatrix;
+    adjoint.template bottomRightCorner<3,3>() = rotationMatrix;
+    return adjoint;
+  }
+
+  //! Spatial cross product matrix of a motion acting on [v; w]
+  static Matrix6 getCrossMotion(const Twist& twist) {
+    Matrix6 cross = Matrix6::Zero();
+    cross.template topLeftCorner<3,3>() = kindr::getSkewMatrixFromVector(twist.getRotationalVelocity().toImplementation());
+    cross.template topRightCorner<3,3>() = kindr::getSkewMatrixFromVector(twist.getTranslationalVelocity().toImplementation());
+    cross.template bottomRightCorner<3,3>() = cross.template topLeftCorner<3,3>();
+    return cross;
+  }
+};
+
+typedef ::testing::Types<
+    kindr::HomTransformQuatD,
+    kindr::HomTransformQuatF,
+    kindr::HomTransformMatrixD,
+    kindr::HomTransformMatrixF
+> Types;
+
+TYPED_TEST_CASE(SpatialAlgebraTest, Types);
+
+
+TYPED_TEST(SpatialAlgebraTest, testTransformTwist)
+{
+  typedef typename TestFixture::Vector6 Vector6;
+  const Vector6 expected = this->getAdjoint()*this->twist.getVector();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::transformTwist(this->pose, this->twist).getVector(), 1e-5, 1e-4, "transform");
+  const Vector6 expectedInverse = this->getAdjoint().inverse()*this->twist.getVector();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedInverse, kindr::inverseTransformTwist(this->pose, this->twist).getVector(), 1e-5, 1e-4, "inverse transform");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->twist.getVector(), kindr::inverseTransformTwist(this->pose, kindr::transformTwist(this->pose, this->twist)).getVector(), 1e-5, 1e-4, "round trip");
+}
+
+TYPED_TEST(SpatialAlgebraTest, testTransformWrench)
+{
+  typedef typename TestFixture::Vector6 Vector6;
+  // Wrenches [f; t] are dual to twists [v; w] and transform with the inverse transposed adjoint
+  const Vector6 expected = this->getAdjoint().inverse().transpose()*this->wrench.getVector();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::transformWrench(this->pose, this->wrench).getVector(), 1e-5, 1e-4, "transform");
+  const Vector6 expectedInverse = this->getAdjoint().transpose()*this->wrench.getVector();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedInverse, kindr::inverseTransformWrench(this->pose, this->wrench).getVector(), 1e-5, 1e-4, "inverse transform");
+
+  // The power is invariant under a change of frame
+  const typename TestFixture::Scalar power = this->twist.getVector().dot(this->wrench.getVector());
+  EXPECT_NEAR(power, kindr::transformTwist(this->pose, this->twist).getVector().dot(kindr::transformWrench(this->pose, this->wrench).getVector()), 1e-4);
+}
+
+TYPED_TEST(SpatialAlgebraTest, testCrossProducts)
+{
+  typedef typename TestFixture::Vector6 Vector6;
+  const Vector6 expectedMotion = TestFixture::getCrossMotion(this->twist)*this->otherTwist.getVector();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedMotion, kindr::crossMotion(this->twist, this->otherTwist).getVector(), 1e-5, 1e-4, "motion");
+
+  // The force cross product is the negative transposed motion cross product
+  const Vector6 expectedForce = -TestFixture::getCrossMotion(this->twist).transpose()*this->wrench.getVector();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedForce, kindr::crossForce(this->twist, this->wrench).getVector(), 1e-5, 1e-4, "force");
+}
+
+TYPED_TEST(SpatialAlgebraTest, testBatch)
+{
+  typedef typename TestFixture::Matrix6X Matrix6X;
+  typedef typename TestFixture::Twist Twist;
+  typedef typename TestFixture::Wrench Wrench;
+  const Matrix6X vectors = Matrix6X::Random(6, 7);
+  Matrix6X twists = vectors;
+  Matrix6X wrenches = vectors;
+  kindr::transformTwists(this->pose, twists, twists);
+  kindr::transformWrenches(this->pose, wrenches, wrenches);
+  for (int i = 0; i < vectors.cols(); ++i) {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::transformTwist(this->pose, Twist(typename Twist::Vector6(vectors.col(i)))).getVector(), twists.col(i), 1e-5, 1e-4, "twists");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::transformWrench(this->pose, Wrench(typename Wrench::Vector6(vectors.col(i)))).getVector(), wrenches.col(i), 1e-5, 1e-4, "wrenches");
+  }
+  kindr::inverseTransformTwists(this->pose, twists, twists);
+  kindr::inverseTransformWrenches(this->pose, wrenches, wrenches);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(vectors, twists, 1e-5, 1e-4, "twists round trip");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(vectors, wrenches, 1e-5, 1e-4, "wrenches round trip");
+}
+
+TYPED_TEST(SpatialAlgebraTest, testRotateJacobianBlocks)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Matrix6X Matrix6X;
+  typedef typename TestFixture::Matrix6 Matrix6;
+  const typename TestFixture::Pose::Rotation& rotation = this->pose.getRotation();
+  const typename TestFixture::Matrix3 rotationMatrix = kindr::RotationMatrix<Scalar>(rotation).matrix();
+  Matrix6X jacobian = Matrix6X::Random(6, 9);
+  jacobian.col(4).setZero();
+  const Matrix6X local = jacobian;
+
+  // Both blocks
+  Matrix6 rotation6 = Matrix6::Zero();
+  rotation6.template topLeftCorner<3,3>() = rotationMatrix;
+  rotation6.template bottomRightCorner<3,3>() = rotationMatrix;
+  kindr::rotateTwistsToGlobal(rotation, jacobian);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6X(rotation6*local), jacobian, 1e-5, 1e-4, "to global");
+  ASSERT_TRUE(jacobian.col(4).isZero());
+  kindr::rotateTwistsToLocal(rotation, jacobian);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(local, jacobian, 1e-5, 1e-4, "to local");
+
+  // Angular velocities only, consistent with Twist::getVector(rotation)
+  kindr::convertTwistsToLocalAngularVelocity(rotation, jacobian);
+  for (int i = 0; i < jacobian.cols(); ++i) {
+    const kindr::Twist<Scalar, kindr::Velocity<Scalar, 3>, kindr::GlobalAngularVelocity<Scalar>> twist(
+        kindr::Velocity<Scalar, 3>(local.template block<3,1>(0, i)), kindr::GlobalAngularVelocity<Scalar>(local.template block<3,1>(3, i)));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(twist.getVector(rotation), jacobian.col(i), 1e-5, 1e-4, "local angular velocity");
+  }
+  kindr::convertTwistsToGlobalAngularVelocity(rotation, jacobian);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(local, jacobian, 1e-5, 1e-4, "global angular velocity");
+
+  // Column blocks of a larger Jacobian
+  kindr::rotateTwistsToGlobal(rotation, jacobian.middleCols(2, 3));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6X(rotation6*local.middleCols(2, 3)), Matrix6X(jacobian.middleCols(2, 3)), 1e-5, 1e-4, "block");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6X(local.leftCols(2)), Matrix6X(jacobian.leftCols(2)), 1e-5, 1e-4, "untouched");
+}
+
+TEST(SpatialAlgebraTest, testKinematicChain)
+{
+  // Transfer the twist of the last link to the base with the prefix transformations of a chain
+  kindr::KinematicChain<double, 3> chain;
+  for (int i = 0; i < 3; ++i) {
+    chain.setLink(i, kindr::HomTransformQuatD(kindr::Position3D(0.2, 0.1*i, 0.3), kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.2*i, 0.3, -0.1))), Eigen::Vector3d(0.0, 1.0, 0.2*i));
+  }
+  chain.setJointPositions(Eigen::Vector3d(0.3, -0.6, 1.1));
+  const kindr::TwistLocalD twist(Eigen::Vector3d(0.1, 0.2, -0.3), Eigen::Vector3d(0.5, -0.1, 0.3));
+  const kindr::TwistLocalD expected = kindr::transformTwist(chain.getEndEffectorTransform(), twist);
+  const kindr::TwistLocalD transformed = kindr::transformTwist(chain.getRotationMatrix(2), chain.getTranslation(2), twist);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getVector(), transformed.getVector(), 1e-10, 1e-10, "chain");
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/SpatialInertia.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename Pose_>
+struct SpatialInertiaTest: public ::testing::Test {
+  typedef Pose_ Pose;
+  typedef typename Pose::Scalar Scalar;
+  typedef kindr::SpatialInertia<Scalar> Inertia;
+  typedef kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> Twist;
+  typedef kindr::Wrench6<Scalar> Wrench;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 6, 6> Matrix6;
+  typedef Eigen::Matrix<Scalar, 6, 1> Vector6;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-4) : Scalar(1e-10);
+
+  Pose pose = Pose(typename Pose::Position(0.4, -1.2, 0.7), typename Pose::Rotation(kindr::EulerAnglesZyx<Scalar>(0.5, -0.9, 1.2)));
+  Twist twist = Twist(Vector6((Vector6() << 0.3, -0.5, 1.1, 0.2, 0.7, -0.4).finished()));
+  Vector3 centerOfMass = Vector3(0.1, -0.3, 0.25);
+  Matrix3 rotationalInertiaAtCenterOfMass = (Matrix3() << 0.4, 0.02, -0.01,
+                                                          0.02, 0.3, 0.03,
+                                                          -0.01, 0.03, 0.2).finished();
+  Inertia inertia = Inertia(2.5, kindr::Position<Scalar, 3>(centerOfMass), rotationalInertiaAtCenterOfMass);
+
+  //! Motion transformation Ad_T^-1 from the frame A to the frame B of the pose acting on [v; w]
+  Matrix6 getInverseAdjoint() const {
+    const Matrix3 rotationMatrix = kindr::RotationMatrix<Scalar>(pose.getRotation()).matrix();
+    Matrix6 adjoint = Matrix6::Zero();
+    adjoint.template topLeftCorner<3,3>() = rotationMatrix.transpose();
+    adjoint.template topRightCorner<3,3>() = -rotationMatrix.transpose()*kindr::getSkewMatrixFromVector(pose.getPosition().toImplementation());
+    adjoint.template bottomRightCorner<3,3>() = rotationMatrix.transpose();
+    return adjoint;
+  }
+};
+
+typedef ::testing::Types<
+    kindr::HomTransformQuatD,
+    kindr::HomTransformQuatF,
+    kindr::HomTransformMatrixD
+> Types;
+
+TYPED_TEST_CASE(SpatialInertiaTest, Types);
+
+
+TYPED_TEST(SpatialInertiaTest, testMassProperties)
+{
+  typedef typename TestFixture::Inertia Inertia;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Matrix6 Matrix6;
+  const Inertia& inertia = this->inertia;
+  ASSERT_NEAR(2.5, inertia.getMass(), this->tol);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->centerOfMass, inertia.getCenterOfMass().toImplementation(), this->tol, this->tol, "center of mass");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotationalInertiaAtCenterOfMass, inertia.getRotationalInertiaAtCenterOfMass(), this->tol, this->tol, "inertia at center of mass");
+
+  // parallel axis theorem
+  const Matrix3 parallelAxis = 2.5*(this->centerOfMass.squaredNorm()*Matrix3::Identity() - this->centerOfMass*this->centerOfMass.transpose());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3(this->rotationalInertiaAtCenterOfMass + parallelAxis), inertia.getRotationalInertia(), this->tol, this->tol, "inertia at origin");
+
+  // symmetric positive definite 6x6 matrix
+  const Matrix6 matrix = inertia.getMatrix();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(matrix, Matrix6(matrix.transpose()), this->tol, this->tol, "symmetric");
+  ASSERT_GT(matrix.ldlt().vectorD().minCoeff(), 0);
+
+  const Inertia copy = Inertia::fromFirstMoment(inertia.getMass(), inertia.getFirstMoment(), inertia.getRotationalInertia());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(matrix, copy.getMatrix(), this->tol, this->tol, "compact form");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6(2*matrix), (inertia + copy).getMatrix(), this->tol, this->tol, "sum");
+  Inertia sum;
+  sum += inertia;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(matrix, sum.getMatrix(), this->tol, this->tol, "sum and assignment");
+}
+
+TYPED_TEST(SpatialInertiaTest, testMultiplication)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Vector6 Vector6;
+  const typename TestFixture::Wrench momentum = this->inertia*this->twist;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector6(this->inertia.getMatrix()*this->twist.getVector()), momentum.getVector(), this->tol, this->tol, "momentum");
+
+  // kinetic energy of the motion of the center of mass and about the center of mass
+  const Vector3& linearVelocity = this->twist.getTranslationalVelocity().toImplementation();
+  const Vector3& angularVelocity = this->twist.getRotationalVelocity().toImplementation();
+  const Vector3 velocityOfCenterOfMass = linearVelocity + angularVelocity.cross(this->centerOfMass);
+  const Scalar kineticEnergy = Scalar(0.5)*Scalar(2.5)*velocityOfCenterOfMass.squaredNorm()
+      + Scalar(0.5)*angularVelocity.dot(this->rotationalInertiaAtCenterOfMass*angularVelocity);
+  ASSERT_NEAR(kineticEnergy, this->inertia.getKineticEnergy(this->twist), this->tol);
+}
+
+TYPED_TEST(SpatialInertiaTest, testTransform)
+{
+  typedef typename TestFixture::Inertia Inertia;
+  typedef typename TestFixture::Matrix6 Matrix6;
+  const Matrix6 adjoint = this->getInverseAdjoint();
+  const Inertia transformed = kindr::transformInertia(this->pose, this->inertia);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix6(adjoint.transpose()*this->inertia.getMatrix()*adjoint), transformed.getMatrix(), this->tol, this->tol, "transform");
+
+  // the center of mass is transformed like a position
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->pose.transform(this->inertia.getCenterOfMass()).toImplementation(),
+                                    transformed.getCenterOfMass().toImplementation(), this->tol, this->tol, "center of mass");
+
+  // the momentum is transformed like a wrench
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::transformWrench(this->pose, this->inertia*this->twist).getVector(),
+                                    (transformed*kindr::transformTwist(this->pose, this->twist)).getVector(), this->tol, this->tol, "momentum");
+
+  const Inertia restored = kindr::inverseTransformInertia(this->pose, transformed);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->inertia.getMatrix(), restored.getMatrix(), this->tol, this->tol, "inverse transform");
+}
+
+TYPED_TEST(SpatialInertiaTest, testNewtonEuler)
+{
+  typedef typename TestFixture::Twist Twist;
+  typedef typename TestFixture::Wrench Wrench;
+  typedef typename TestFixture::Vector6 Vector6;
+  const Twist acceleration(Vector6((Vector6() << -0.6, 0.1, 0.4, 0.9, -0.3, 0.5).finished()));
+  const Wrench bias = kindr::getBiasWrench(this->inertia, this->twist);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::crossForce(this->twist, this->inertia*this->twist).getVector(), bias.getVector(), this->tol, this->tol, "bias");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector6(this->inertia.getMatrix()*acceleration.getVector() + bias.getVector()),
+                                    kindr::getNetWrench(this->inertia, this->twist, acceleration).getVector(), this->tol, this->tol, "net wrench");
+
+  // the power of the bias force vanishes
+  ASSERT_NEAR(0, bias.getVector().dot(this->twist.getVector()), this->tol);
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/TrajectoryMetrics.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+
+template <typename PrimType_>
+struct TrajectoryMetricsTest: public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::PoseArray<Scalar> PoseArray;
+  typedef typename PoseArray::Element Pose;
+  typedef kindr::Position<Scalar, 3> Position;
+  typedef kindr::RotationQuaternion<Scalar> Rotation;
+  typedef kindr::TrajectoryAlignment<Scalar> Alignment;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-3) : Scalar(1e-9);
+  const int size = 1000;
+
+  PoseArray reference;
+  Alignment alignment;
+
+  TrajectoryMetricsTest()
+    : reference(size),
+      alignment(Rotation(kindr::EulerAnglesZyx<Scalar>(0.7, -0.2, 0.3)), Position(1.0, -2.0, 0.5), Scalar(2.0)) {
+    // a helix
+    for (int i = 0; i < size; ++i) {
+      const Scalar t = Scalar(0.01)*Scalar(i);
+      reference.set(i, Pose(Position(std::cos(t), std::sin(t), Scalar(0.2)*t), Rotation(kindr::EulerAnglesZyx<Scalar>(t, Scalar(0.1)*std::sin(t), Scalar(0.0)))));
+    }
+  }
+
+  //! Expresses the reference trajectory in a frame in which it is aligned by the alignment
+  PoseArray getEstimate() const {
+    PoseArray estimate(size);
+    const Rotation inverseRotation = alignment.getRotation().inverted();
+    for (int i = 0; i < size; ++i) {
+      const Pose pose = reference[i];
+      estimate.set(i, Pose(Position(inverseRotation.rotate(pose.getPosition() - alignment.getTranslation())/alignment.getScale()),
+                           inverseRotation*pose.getRotation()));
+    }
+    return estimate;
+  }
+
+  void expectAlignment(const Alignment& expected, const Alignment& actual) const {
+    ASSERT_LT(expected.getRotation().getDisparityAngle(actual.getRotation()), tol);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getTranslation().toImplementation(), actual.getTranslation().toImplementation(), tol, tol, "translation");
+    ASSERT_NEAR(expected.getScale(), actual.getScale(), tol);
+  }
+};
+
+typedef ::testing::Types<
+    double,
+    float
+> Types;
+
+TYPED_TEST_CASE(TrajectoryMetricsTest, Types);
+
+TYPED_TEST(TrajectoryMetricsTest, testAlignment)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::PoseArray PoseArray;
+  typedef typename TestFixture::Alignment Alignment;
+  const PoseArray estimate = this->getEstimate();
+
+  // the alignment maps the estimate onto the reference
+  PoseArray aligned;
+  this->alignment.transform(estimate, aligned, kindr::ThreadPoolExecutor(2));
+  PoseArray restored;
+  this->alignment.inverted().transform(aligned, restored);
+  for (int i = 0; i < this->size; i += 97) {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(estimate[i].getTransformationMatrix(), restored[i].getTransformationMatrix(), this->tol, this->tol, "inverted");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->reference[i].getTransformationMatrix(), aligned[i].getTransformationMatrix(), this->tol, this->tol, "transform");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(aligned[i].getPosition().toImplementation(), this->alignment.transform(estimate[i].getPosition()).toImplementation(), this->tol, this->tol, "transform position");
+  }
+
+  this->expectAlignment(this->alignment, kindr::alignTrajectories(estimate, this->reference, kindr::AlignmentType::Similarity));
+  this->expectAlignment(this->alignment, kindr::alignTrajectories(estimate, this->reference, kindr::AlignmentType::Similarity, kindr::ThreadPoolExecutor(2)));
+
+  // a rigid alignment of a trajectory with metric scale
+  const Alignment rigid(this->alignment.getRotation(), this->alignment.getTranslation());
+  PoseArray rigidEstimate;
+  rigid.inverted().transform(this->reference, rigidEstimate);
+  this->expectAlignment(rigid, kindr::alignTrajectories(rigidEstimate, this->reference));
+  this->expectAlignment(Alignment(), kindr::alignTrajectories(this->reference, this->reference, kindr::AlignmentType::Similarity));
+
+  // a planar trajectory is aligned with a rotation and not with a reflection
+  kindr::PositionArray<Scalar> planar(this->reference.getPositions());
+  planar.toImplementation().row(2).setZero();
+  const Alignment planarAlignment = kindr::alignTrajectories(planar, planar);
+  ASSERT_LT(planarAlignment.getRotation().getDisparityAngle(kindr::RotationQuaternion<Scalar>()), this->tol);
+  ASSERT_THROW(kindr::alignTrajectories(planar, kindr::PositionArray<Scalar>(3)), std::runtime_error);
+}
+
+TYPED_TEST(TrajectoryMetricsTest, testAbsoluteTrajectoryError)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::PoseArray PoseArray;
+  typedef typename TestFixture::Pose Pose;
+  PoseArray estimate = this->getEstimate();
+
+  const kindr::TrajectoryError<Scalar> exact = kindr::computeAbsoluteTrajectoryError(estimate, this->reference, kindr::AlignmentType::Similarity);
+  ASSERT_EQ(exact.size(), this->size);
+  ASSERT_LT(exact.getTranslationStatistics().maximum, this->tol);
+  ASSERT_LT(exact.getRotationStatistics().maximum, this->tol);
+
+  // errors of single poses
+  const Pose offset(typename TestFixture::Position(0.0, 0.0, 0.25), kindr::RotationQuaternion<Scalar>(kindr::AngleAxis<Scalar>(0.1, 0.0, 1.0, 0.0)));
+  estimate.set(10, estimate[10]*offset);
+  const kindr::TrajectoryError<Scalar> error = kindr::computeAbsoluteTrajectoryError(estimate, this->reference, this->alignment, kindr::ThreadPoolExecutor(2));
+  for (int i = 0; i < this->size; ++i) {
+    const Pose aligned(this->alignment.transform(estimate[i].getPosition()), this->alignment.getRotation()*estimate[i].getRotation());
+    ASSERT_NEAR((aligned.getPosition() - this->reference[i].getPosition()).norm(), error.translationErrors(i), this->tol);
+    ASSERT_NEAR(aligned.getRotation().getDisparityAngle(this->reference[i].getRotation()), error.rotationErrors(i), this->tol);
+  }
+  ASSERT_NEAR(error.translationErrors(10), Scalar(0.5), this->tol);
+  ASSERT_NEAR(error.rotationErrors(10), Scalar(0.1), this->tol);
+  ASSERT_NEAR(error.getTranslationStatistics().rmse, Scalar(0.5)/std::sqrt(Scalar(this->size)), this->tol);
+}
+
+TYPED_TEST(TrajectoryMetricsTest, testRelativePoseError)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::PoseArray PoseArray;
+  typedef typename TestFixture::Pose Pose;
+  // the relative errors do not depend on the frame of the estimate
+  PoseArray estimate;
+  typename TestFixture::Alignment(this->alignment.getRotation(), this->alignment.getTranslation()).inverted().transform(this->reference, estimate);
+
+  const kindr::TrajectoryPairs pairs = kindr::TrajectoryPairs::fromSamples(this->size, 10, 5);
+  const kindr::TrajectoryError<Scalar> exact = kindr::computeRelativePoseError(estimate, this->reference, pairs);
+  ASSERT_EQ(exact.size(), pairs.size());
+  ASSERT_LT(exact.getTranslationStatistics().maximum, this->tol);
+  ASSERT_LT(exact.getRotationStatistics().maximum, this->tol);
+
+  // a drift of the estimate
+  const Pose drift(typename TestFixture::Position(0.001, 0.0, 0.0), kindr::RotationQuaternion<Scalar>(kindr::AngleAxis<Scalar>(0.002, 0.0, 0.0, 1.0)));
+  for (int i = 1; i < estimate.size(); ++i) {
+    estimate.set(i, estimate[i - 1]*drift*(this->reference[i - 1].inverted()*this->reference[i]));
+  }
+  const kindr::TrajectoryError<Scalar> error = kindr::computeRelativePoseError(estimate, this->reference, pairs, kindr::ThreadPoolExecutor(2));
+  for (int k = 0; k < pairs.size(); ++k) {
+    const int i = pairs.first(k), j = pairs.second(k);
+    const Pose expected = (this->reference[i].inverted()*this->reference[j]).inverted()*(estimate[i].inverted()*estimate[j]);
+    ASSERT_NEAR(expected.getPosition().norm(), error.translationErrors(k), this->tol);
+    ASSERT_NEAR(expected.getRotation().getDisparityAngle(kindr::RotationQuaternion<Scalar>()), error.rotationErrors(k), this->tol);
+  }
+  ASSERT_GT(error.getRotationStatistics().minimum, Scalar(0.01));
+}
+
+TEST(TrajectoryMetricsTest, testPairs)
+{
+  const kindr::TrajectoryPairs samples = kindr::TrajectoryPairs::fromSamples(10, 3, 2);
+  ASSERT_EQ(samples.first, (Eigen::VectorXi(4) << 0, 2, 4, 6).finished());
+  ASSERT_EQ(samples.second, (Eigen::VectorXi(4) << 3, 5, 7, 9).finished());
+  ASSERT_EQ(kindr::TrajectoryPairs::fromSamples(3, 3).size(), 0);
+
+  const Eigen::VectorXd times = (Eigen::VectorXd(6) << 0.0, 0.1, 0.25, 0.35, 0.5, 0.6).finished();
+  const kindr::TrajectoryPairs intervals = kindr::TrajectoryPairs::fromTimes(times, 0.2);
+  ASSERT_EQ(intervals.first, (Eigen::VectorXi(4) << 0, 1, 2, 3).finished());
+  ASSERT_EQ(intervals.second, (Eigen::VectorXi(4) << 2, 3, 4, 5).finished());
+
+  kindr::PositionArrayD positions(5);
+  positions.toImplementation().row(0) << 0.0, 1.0, 1.0, 3.0, 3.0;
+  positions.toImplementation().row(1) << 0.0, 0.0, 1.0, 1.0, 2.0;
+  const kindr::TrajectoryPairs segments = kindr::TrajectoryPairs::fromDistances(positions, 2.0);
+  ASSERT_EQ(segments.first, (Eigen::VectorXi(3) << 0, 1, 2).finished());
+  ASSERT_EQ(segments.second, (Eigen::VectorXi(3) << 2, 3, 3).finished());
+  ASSERT_THROW(kindr::TrajectoryPairs::fromSamples(10, 0), std::runtime_error);
+}
+
+TEST(TrajectoryMetricsTest, testStatistics)
+{
+  const kindr::TrajectoryErrorStatistics<double> statistics = kindr::TrajectoryErrorStatistics<double>::compute(Eigen::Vector4d(4.0, 1.0, 3.0, 0.0));
+  ASSERT_EQ(statistics.size, 4);
+  ASSERT_DOUBLE_EQ(statistics.rmse, std::sqrt(26.0/4.0));
+  ASSERT_DOUBLE_EQ(statistics.mean, 2.0);
+  ASSERT_DOUBLE_EQ(statistics.median, 2.0);
+  ASSERT_DOUBLE_EQ(statistics.standardDeviation, std::sqrt(10.0/4.0));
+  ASSERT_DOUBLE_EQ(statistics.minimum, 0.0);
+  ASSERT_DOUBLE_EQ(statistics.maximum, 4.0);
+  ASSERT_DOUBLE_EQ(kindr::TrajectoryErrorStatistics<double>::compute(Eigen::Vector3d(4.0, 1.0, 3.0)).median, 3.0);
+  ASSERT_EQ(kindr::TrajectoryErrorStatistics<double>::compute(Eigen::VectorXd()).size, 0);
+}
@@ -163,3 +163,22 @@ TYPED_TEST(TwistWithAngularVelocityTest, setters)
   EXPECT_EQ(6.0, twist2.getRotationalVelocity().y());
   EXPECT_EQ(7.0, twist2.getRotationalVelocity().z());
 }
+
+TYPED_TEST(TwistWithAngularVelocityTest, vectorMap)
+{
+  typedef typename TestFixture::Twist Twist;
+  typedef typename TestFixture::PositionDiff PositionDiff;
+  typedef typename TestFixture::RotationDiff RotationDiff;
+
+  // the map views the velocities of the twist
+  Twist twist(PositionDiff(1.0, 2.0, 3.0), RotationDiff(5.0, 6.0, 7.0));
+  EXPECT_EQ(twist.getVector(), typename Twist::Vector6(twist.getVectorMap()));
+  twist.getVectorMap()(2) = 4.0;
+  twist.getVectorMap().template tail<3>() *= 2.0;
+  EXPECT_EQ(4.0, twist.getTranslationalVelocity().z());
+  EXPECT_EQ(10.0, twist.getRotationalVelocity().x());
+  EXPECT_EQ(14.0, twist.getRotationalVelocity().z());
+
+  const Twist& constTwist = twist;
+  EXPECT_EQ(twist.getTranslationalVelocity().toImplementation().data(), constTwist.getVectorMap().data());
+}
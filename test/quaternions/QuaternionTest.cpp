@@ -188,6 +188,20 @@ TYPED_TEST (QuaternionsSingleTest, testQuaternionSingleMultiplication) {
   ASSERT_EQ(testQuat.z(),this->quat1.z());
 }
 
+// Testing of fused Quaternion products
+TYPED_TEST (QuaternionsSingleTest, testQuaternionSingleFusedMultiplication) {
+  typedef typename TestFixture::Quaternion Quaternion;
+  typedef typename TestFixture::QuaternionScalar QuaternionScalar;
+  const QuaternionScalar tol = 1e-3;
+
+  const Quaternion multConj = this->quat1.multiplyConjugate(this->quat2);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->quat1*this->quat2.conjugated()).vector(), multConj.vector(), tol, tol, "multiplyConjugate");
+  const Quaternion conjMult = this->quat1.conjugateMultiply(this->quat2);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->quat1.conjugated()*this->quat2).vector(), conjMult.vector(), tol, tol, "conjugateMultiply");
+  const Quaternion sandwich = this->quat1.sandwich(this->quat2);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->quat1*this->quat2*this->quat1.conjugated()).vector(), sandwich.vector(), tol, tol, "sandwich");
+}
+
 // Testing of Quaternion conjugation
 TYPED_TEST (QuaternionsSingleTest, testQuaternionSingleConjugation) {
   typedef typename TestFixture::Quaternion Quaternion;
@@ -476,6 +490,28 @@ TYPED_TEST (UnitQuaternionsSingleTest, testUnitQuaternionSingleMultiplication) {
   ASSERT_EQ(testQuat.z(),this->quat1.z());
 }
 
+// Testing of fused UnitQuaternion products
+TYPED_TEST (UnitQuaternionsSingleTest, testUnitQuaternionSingleFusedMultiplication) {
+  typedef typename TestFixture::UnitQuaternion UnitQuaternion;
+  typedef typename TestFixture::UnitQuaternionScalar UnitQuaternionScalar;
+  typedef quat::Quaternion<UnitQuaternionScalar> Quaternion;
+  const UnitQuaternionScalar tol = 1e-6;
+
+  const UnitQuaternion multConj = this->quat1.multiplyConjugate(this->quat2);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->quat1*this->quat2.inverted()).vector(), multConj.vector(), tol, tol, "multiplyConjugate");
+  const UnitQuaternion conjMult = this->quat1.conjugateMultiply(this->quat2);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->quat1.inverted()*this->quat2).vector(), conjMult.vector(), tol, tol, "conjugateMultiply");
+  const UnitQuaternion sandwich = this->quat1.sandwich(this->quat2);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->quat1*this->quat2*this->quat1.inverted()).vector(), sandwich.vector(), tol, tol, "sandwich");
+
+  // mixing with a generic quaternion yields a generic quaternion
+  const Quaternion generic(1.0, 2.0, 3.0, 4.0);
+  const Quaternion genericConjMult = this->quat2.conjugateMultiply(generic);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->quat2.inverted()*generic).vector(), genericConjMult.vector(), tol, tol, "generic conjugateMultiply");
+  const Quaternion genericSandwich = this->quat2.sandwich(generic);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->quat2*generic*this->quat2.inverted()).vector(), genericSandwich.vector(), tol, tol, "generic sandwich");
+}
+
 // Testing of UnitQuaternion conjugation
 TYPED_TEST (UnitQuaternionsSingleTest, testUnitQuaternionSingleConjugation) {
   typedef typename TestFixture::UnitQuaternion UnitQuaternion;
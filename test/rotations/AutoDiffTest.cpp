@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+namespace jet {
+
+/*! \brief Minimal forward-mode dual number modelled after ceres::Jet.
+ *  Construction from a double is explicit and the math functions are only found by argument-dependent lookup,
+ *  as for the AD types used in cost functions.
+ */
+template<int N>
+struct Jet {
+  typedef Eigen::Matrix<double, N, 1> Derivatives;
+  double a;
+  Derivatives v;
+
+  Jet() : a(0.0), v(Derivatives::Zero()) {}
+  explicit Jet(double value) : a(value), v(Derivatives::Zero()) {}
+  Jet(double value, int k) : a(value), v(Derivatives::Unit(k)) {}
+  Jet(double value, const Derivatives& derivatives) : a(value), v(derivatives) {}
+
+  Jet& operator+=(const Jet& y) { *this = *this + y; return *this; }
+  Jet& operator-=(const Jet& y) { *this = *this - y; return *this; }
+  Jet& operator*=(const Jet& y) { *this = *this * y; return *this; }
+  Jet& operator/=(const Jet& y) { *this = *this / y; return *this; }
+};
+
+template<int N> Jet<N> operator+(const Jet<N>& x) { return x; }
+template<int N> Jet<N> operator-(const Jet<N>& x) { return Jet<N>(-x.a, -x.v); }
+template<int N> Jet<N> operator+(const Jet<N>& x, const Jet<N>& y) { return Jet<N>(x.a + y.a, x.v + y.v); }
+template<int N> Jet<N> operator-(const Jet<N>& x, const Jet<N>& y) { return Jet<N>(x.a - y.a, x.v - y.v); }
+template<int N> Jet<N> operator*(const Jet<N>& x, const Jet<N>& y) { return Jet<N>(x.a*y.a, x.a*y.v + x.v*y.a); }
+template<int N> Jet<N> operator/(const Jet<N>& x, const Jet<N>& y) { return Jet<N>(x.a/y.a, (x.v - x.a/y.a*y.v)/y.a); }
+template<int N> Jet<N> operator+(const Jet<N>& x, double s) { return Jet<N>(x.a + s, x.v); }
+template<int N> Jet<N> operator+(double s, const Jet<N>& x) { return Jet<N>(x.a + s, x.v); }
+template<int N> Jet<N> operator-(const Jet<N>& x, double s) { return Jet<N>(x.a - s, x.v); }
+template<int N> Jet<N> operator-(double s, const Jet<N>& x) { return Jet<N>(s - x.a, -x.v); }
+template<int N> Jet<N> operator*(const Jet<N>& x, double s) { return Jet<N>(x.a*s, x.v*s); }
+template<int N> Jet<N> operator*(double s, const Jet<N>& x) { return Jet<N>(x.a*s, x.v*s); }
+template<int N> Jet<N> operator/(const Jet<N>& x, double s) { return Jet<N>(x.a/s, x.v/s); }
+template<int N> Jet<N> operator/(double s, const Jet<N>& x) { return Jet<N>(s/x.a, -s/(x.a*x.a)*x.v); }
+
+#define JET_COMPARISON(OP) \
+  template<int N> bool operator OP(const Jet<N>& x, const Jet<N>& y) { return x.a OP y.a; } \
+  template<int N> bool operator OP(const Jet<N>& x, double s) { return x.a OP s; } \
+  template<int N> bool operator OP(double s, const Jet<N>& x) { return s OP x.a; }
+JET_COMPARISON(<)
+JET_COMPARISON(<=)
+JET_COMPARISON(>)
+JET_COMPARISON(>=)
+JET_COMPARISON(==)
+JET_COMPARISON(!=)
+#undef JET_COMPARISON
+
+template<int N> Jet<N> abs(const Jet<N>& x) { return x.a < 0.0 ? -x : x; }
+template<int N> Jet<N> sqrt(const Jet<N>& x) { const double s = std::sqrt(x.a); return Jet<N>(s, x.v/(2.0*s)); }
+template<int N> Jet<N> sin(const Jet<N>& x) { return Jet<N>(std::sin(x.a), std::cos(x.a)*x.v); }
+template<int N> Jet<N> cos(const Jet<N>& x) { return Jet<N>(std::cos(x.a), -std::sin(x.a)*x.v); }
+template<int N> Jet<N> tan(const Jet<N>& x) { const double t = std::tan(x.a); return Jet<N>(t, (1.0 + t*t)*x.v); }
+template<int N> Jet<N> asin(const Jet<N>& x) { return Jet<N>(std::asin(x.a), x.v/std::sqrt(1.0 - x.a*x.a)); }
+template<int N> Jet<N> acos(const Jet<N>& x) { return Jet<N>(std::acos(x.a), -x.v/std::sqrt(1.0 - x.a*x.a)); }
+template<int N> Jet<N> atan2(const Jet<N>& y, const Jet<N>& x) { const double r = x.a*x.a + y.a*y.a; return Jet<N>(std::atan2(y.a, x.a), (x.a*y.v - y.a*x.v)/r); }
+template<int N> Jet<N> floor(const Jet<N>& x) { return Jet<N>(std::floor(x.a)); }
+template<int N> Jet<N> pow(const Jet<N>& x, double e) { return Jet<N>(std::pow(x.a, e), e*std::pow(x.a, e - 1.0)*x.v); }
+template<int N> Jet<N> exp(const Jet<N>& x) { const double e = std::exp(x.a); return Jet<N>(e, e*x.v); }
+template<int N> Jet<N> log(const Jet<N>& x) { return Jet<N>(std::log(x.a), x.v/x.a); }
+template<int N> bool isfinite(const Jet<N>& x) { return std::isfinite(x.a) && x.v.allFinite(); }
+template<int N> std::ostream& operator<<(std::ostream& out, const Jet<N>& x) { return out << "[" << x.a << " ; " << x.v.transpose() << "]"; }
+
+} // namespace jet
+
+namespace Eigen {
+
+template<int N>
+struct NumTraits<jet::Jet<N>> {
+  typedef jet::Jet<N> Real;
+  typedef jet::Jet<N> NonInteger;
+  typedef jet::Jet<N> Nested;
+  typedef jet::Jet<N> Literal;
+  enum {
+    IsComplex = 0,
+    IsInteger = 0,
+    IsSigned = 1,
+    RequireInitialization = 1,
+    ReadCost = 1,
+    AddCost = 1,
+    MulCost = 3,
+    HasFloatingPoint = 1,
+  };
+  static inline Real epsilon() { return Real(std::numeric_limits<double>::epsilon()); }
+  static inline Real dummy_precision() { return Real(1e-12); }
+  static inline Real highest() { return Real(std::numeric_limits<double>::max()); }
+  static inline Real lowest() { return Real(-std::numeric_limits<double>::max()); }
+  static inline int digits10() { return NumTraits<double>::digits10(); }
+};
+
+} // namespace Eigen
+
+typedef jet::Jet<3> Jet3;
+typedef Eigen::Matrix<Jet3, 3, 1> JetVector3;
+
+namespace {
+
+//! Rotation vector whose coordinates are the three AD variables.
+JetVector3 variables(const Eigen::Vector3d& value) {
+  return JetVector3(Jet3(value.x(), 0), Jet3(value.y(), 1), Jet3(value.z(), 2));
+}
+
+Eigen::Vector3d values(const JetVector3& vector) {
+  return Eigen::Vector3d(vector.x().a, vector.y().a, vector.z().a);
+}
+
+Eigen::Matrix3d jacobian(const JetVector3& vector) {
+  Eigen::Matrix3d jacobian;
+  for (int i = 0; i < 3; ++i) {
+    jacobian.row(i) = vector(i).v.transpose();
+  }
+  return jacobian;
+}
+
+//! Central differences of a function R^3 -> R^3.
+template<typename Function_>
+Eigen::Matrix3d numericalJacobian(const Function_& function, const Eigen::Vector3d& x) {
+  const double h = 1e-6;
+  Eigen::Matrix3d jacobian;
+  for (int i = 0; i < 3; ++i) {
+    jacobian.col(i) = (function(x + h*Eigen::Vector3d::Unit(i)) - function(x - h*Eigen::Vector3d::Unit(i)))/(2.0*h);
+  }
+  return jacobian;
+}
+
+} // namespace
+
+TEST(AutoDiffTest, testExponentialAndLogarithmicMap)
+{
+  const Eigen::Vector3d point(0.3, -1.2, 2.0);
+  const auto rotateDouble = [&point](const Eigen::Vector3d& x) -> Eigen::Vector3d {
+    return rot::RotationQuaternionD().exponentialMap(x).rotate(point);
+  };
+
+  // small angles take the series branches, which must keep exact derivatives
+  const Eigen::Vector3d rotationVectors[] = {Eigen::Vector3d(0.2, -0.5, 0.9), Eigen::Vector3d(1e-9, -2e-9, 1e-9), Eigen::Vector3d::Zero()};
+  for (const Eigen::Vector3d& x : rotationVectors) {
+    const rot::RotationQuaternion<Jet3> quaternion = rot::RotationQuaternion<Jet3>().exponentialMap(variables(x));
+    const JetVector3 rotated = quaternion.rotate(JetVector3(point.cast<Jet3>()));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotateDouble(x), values(rotated), 1e-12, 1e-12, "value");
+    ASSERT_TRUE(jacobian(rotated).allFinite());
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalJacobian(rotateDouble, x), jacobian(rotated), 1e-7, 1e-7, "jacobian");
+
+    const rot::RotationMatrix<Jet3> matrix = rot::RotationMatrix<Jet3>().exponentialMap(variables(x));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobian(rotated), jacobian(matrix.rotate(JetVector3(point.cast<Jet3>()))), 1e-9, 1e-9, "matrix");
+
+    const JetVector3 logarithm = quaternion.logarithmicMap();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(x, values(logarithm), 1e-12, 1e-12, "log value");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Eigen::Matrix3d::Identity(), jacobian(logarithm), 1e-7, 1e-7, "log jacobian");
+  }
+}
+
+TEST(AutoDiffTest, testConversions)
+{
+  const Eigen::Vector3d x(0.4, -0.7, 1.1);
+  const Eigen::Vector3d point(0.3, -1.2, 2.0);
+  const JetVector3 jetPoint = point.cast<Jet3>();
+  const rot::RotationVector<Jet3> rotationVector(variables(x));
+  const JetVector3 expected = rotationVector.rotate(jetPoint);
+
+  const rot::RotationQuaternion<Jet3> quaternion(rotationVector);
+  const rot::RotationMatrix<Jet3> matrix(quaternion);
+  const rot::AngleAxis<Jet3> angleAxis(matrix);
+  const rot::EulerAnglesZyx<Jet3> eulerAnglesZyx(angleAxis);
+  const rot::EulerAnglesXyz<Jet3> eulerAnglesXyz(eulerAnglesZyx);
+  const rot::RotationVector<Jet3> roundTrip(eulerAnglesXyz);
+
+  const JetVector3 rotatedPoints[] = {quaternion.rotate(jetPoint), matrix.rotate(jetPoint), angleAxis.rotate(jetPoint),
+                                      eulerAnglesZyx.rotate(jetPoint), eulerAnglesXyz.rotate(jetPoint), roundTrip.rotate(jetPoint)};
+  for (const JetVector3& rotated : rotatedPoints) {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(values(expected), values(rotated), 1e-12, 1e-12, "value");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobian(expected), jacobian(rotated), 1e-9, 1e-9, "jacobian");
+  }
+
+  // the disparity angle of a rotation to itself has the derivative zero, the one to the identity the norm of the rotation vector
+  const Jet3 disparity = quaternion.getDisparityAngle(rot::RotationQuaternion<Jet3>());
+  EXPECT_NEAR(x.norm(), disparity.a, 1e-12);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(x.normalized(), disparity.v, 1e-9, 1e-9, "disparity quaternion");
+  const Jet3 matrixDisparity = matrix.getDisparityAngle(rot::RotationMatrix<Jet3>());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(x.normalized(), matrixDisparity.v, 1e-9, 1e-9, "disparity matrix");
+  const Jet3 genericDisparity = eulerAnglesZyx.getDisparityAngle(rot::EulerAnglesZyx<Jet3>());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(x.normalized(), genericDisparity.v, 1e-9, 1e-9, "disparity generic");
+  ASSERT_TRUE(quaternion.isNear(matrix, Jet3(1e-9)));
+
+  // box operators
+  const JetVector3 difference = quaternion.boxPlus(JetVector3(Jet3(0.1), Jet3(0.2), Jet3(-0.1))).boxMinus(quaternion);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Eigen::Vector3d(0.1, 0.2, -0.1), values(difference), 1e-12, 1e-12, "boxMinus");
+}
+
+TEST(AutoDiffTest, testPose)
+{
+  typedef rot::HomogeneousTransformation<Jet3, rot::Position<Jet3, 3>, rot::RotationQuaternion<Jet3>> Pose;
+  const Eigen::Vector3d x(-0.2, 0.5, 0.3);
+  const Eigen::Vector3d point(1.0, 2.0, -0.5);
+  const Eigen::Vector3d translation(0.1, -0.3, 0.8);
+  const Pose pose(rot::Position<Jet3, 3>(JetVector3(translation.cast<Jet3>())), rot::RotationQuaternion<Jet3>(rot::RotationVector<Jet3>(variables(x))));
+  const rot::Position<Jet3, 3> transformed = pose.transform(rot::Position<Jet3, 3>(JetVector3(point.cast<Jet3>())));
+
+  const auto transformDouble = [&point, &translation](const Eigen::Vector3d& x) -> Eigen::Vector3d {
+    return rot::RotationVectorD(x).rotate(point) + translation;
+  };
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(transformDouble(x), values(transformed.toImplementation()), 1e-12, 1e-12, "value");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalJacobian(transformDouble, x), jacobian(transformed.toImplementation()), 1e-7, 1e-7, "jacobian");
+
+  const rot::Position<Jet3, 3> restored = pose.inverseTransform(transformed);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(point, values(restored.toImplementation()), 1e-12, 1e-12, "inverse value");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Eigen::Matrix3d::Zero(), jacobian(restored.toImplementation()), 1e-9, 1e-9, "inverse jacobian");
+
+  // the derivative of the exponential map of SE(3) at zero is the identity
+  Eigen::Matrix<Jet3, 6, 1> twist;
+  twist << JetVector3(Eigen::Vector3d::Zero().cast<Jet3>()), variables(Eigen::Vector3d::Zero());
+  const Pose exponential = pose.exponentialMap(twist);
+  const rot::Position<Jet3, 3> rotated = exponential.transform(rot::Position<Jet3, 3>(JetVector3(point.cast<Jet3>())));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(point, values(rotated.toImplementation()), 1e-12, 1e-12, "exponential value");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(-rot::getSkewMatrixFromVector(point), jacobian(rotated.toImplementation()), 1e-12, 1e-12, "exponential jacobian");
+}
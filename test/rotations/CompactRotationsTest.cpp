@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename Compact_>
+class CompactRotationQuaternionTest : public ::testing::Test {
+ public:
+  typedef Compact_ Compact;
+
+  std::vector<rot::RotationQuaternionD> rotations;
+
+  CompactRotationQuaternionTest() {
+    // Identity, half turns with the largest component in every position and random rotations
+    rotations.push_back(rot::RotationQuaternionD());
+    rotations.push_back(rot::RotationQuaternionD(0.0, 1.0, 0.0, 0.0));
+    rotations.push_back(rot::RotationQuaternionD(0.0, 0.0, -1.0, 0.0));
+    rotations.push_back(rot::RotationQuaternionD(0.0, 0.0, 0.0, 1.0));
+    rotations.push_back(rot::RotationQuaternionD(0.5, -0.5, 0.5, -0.5));
+    for (int i = 0; i < 2000; ++i) {
+      rot::RotationQuaternionD rotation;
+      rotation.setRandom();
+      rotations.push_back(rotation);
+    }
+  }
+};
+
+typedef ::testing::Types<
+    rot::CompactRotationQuaternion32,
+    rot::CompactRotationQuaternion48
+> CompactQuaternionTypes;
+
+TYPED_TEST_CASE(CompactRotationQuaternionTest, CompactQuaternionTypes);
+
+TYPED_TEST(CompactRotationQuaternionTest, testEncoding)
+{
+  typedef typename TestFixture::Compact Compact;
+  EXPECT_EQ(sizeof(std::uint16_t)*Compact::NumWords, sizeof(Compact));
+  EXPECT_EQ(Compact::BitsPerComponent == 10 ? 4u : 6u, sizeof(Compact));
+
+  // The identity and the half turns about the axes are exact
+  for (int i = 0; i < 4; ++i) {
+    const Compact compact(this->rotations[i]);
+    ASSERT_TRUE(compact.template getRotationQuaternion<double>().isNear(this->rotations[i], 1e-12));
+    EXPECT_EQ(compact, Compact::fromCode(compact.getCode()));
+  }
+
+  double maxError = 0.0;
+  for (const rot::RotationQuaternionD& rotation : this->rotations) {
+    const Compact compact(rotation);
+    const rot::RotationQuaternionD decoded = compact.template getRotationQuaternion<double>();
+    EXPECT_NEAR(1.0, decoded.toImplementation().norm(), 1e-12);
+    maxError = std::max(maxError, decoded.getDisparityAngle(rotation));
+    // Both signs of a quaternion have the same code
+    EXPECT_EQ(compact, Compact(rot::RotationQuaternionD(-rotation.w(), -rotation.x(), -rotation.y(), -rotation.z())));
+    // float
+    const rot::RotationQuaternionF rotationFloat(rotation.toImplementation().cast<float>());
+    const Compact compactFloat(rotationFloat);
+    ASSERT_TRUE(compactFloat.template getRotationQuaternion<float>().isNear(rotationFloat, float(Compact::getMaxAngleError()) + 1e-5f));
+  }
+  EXPECT_LT(maxError, Compact::getMaxAngleError());
+  EXPECT_GT(maxError, 0.1*Compact::getMaxAngleError());
+}
+
+TYPED_TEST(CompactRotationQuaternionTest, testBatch)
+{
+  typedef typename TestFixture::Compact Compact;
+  const rot::RotationQuaternionArrayD rotations(this->rotations);
+  std::vector<Compact> compact;
+  rot::encode(rotations, compact);
+  ASSERT_EQ(this->rotations.size(), compact.size());
+  rot::RotationQuaternionArrayD decoded;
+  rot::decode(compact, decoded, rot::ThreadPoolExecutor(2));
+  ASSERT_EQ(rotations.size(), decoded.size());
+  for (int i = 0; i < rotations.size(); ++i) {
+    EXPECT_EQ(Compact(this->rotations[i]), compact[i]);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(compact[i].template getRotationQuaternion<double>().vector(), decoded[i].vector(), 1e-15, 1e-15, "decode");
+  }
+  std::vector<Compact> compactParallel;
+  rot::encode(rotations, compactParallel, rot::ThreadPoolExecutor(3));
+  EXPECT_TRUE(compact == compactParallel);
+}
+
+
+TEST(CompactRotationVectorTest, testEncoding)
+{
+  EXPECT_EQ(6u, sizeof(rot::CompactRotationVector));
+  EXPECT_TRUE(rot::CompactRotationVector().getRotationVector<double>().isNear(rot::RotationVectorD(), 1e-15));
+
+  std::vector<rot::RotationQuaternionD> rotations;
+  rotations.push_back(rot::RotationQuaternionD(0.0, 1.0, 0.0, 0.0));
+  rotations.push_back(rot::RotationQuaternionD(rot::AngleAxisD(M_PI - 1e-6, 0.0, 0.6, -0.8)));
+  rotations.push_back(rot::RotationQuaternionD(rot::AngleAxisD(1e-7, 1.0, 0.0, 0.0)));
+  for (int i = 0; i < 2000; ++i) {
+    rot::RotationQuaternionD rotation;
+    rotation.setRandom();
+    rotations.push_back(rotation);
+  }
+  double maxError = 0.0;
+  for (const rot::RotationQuaternionD& rotation : rotations) {
+    const rot::CompactRotationVector compact(rotation);
+    maxError = std::max(maxError, rot::RotationQuaternionD(compact.getRotationVector<double>()).getDisparityAngle(rotation));
+    const rot::RotationQuaternionF rotationFloat(rotation.toImplementation().cast<float>());
+    const rot::CompactRotationVector compactFloat(rotationFloat);
+    ASSERT_TRUE(compactFloat.getRotationVector<float>().isNear(rotationFloat, float(rot::CompactRotationVector::getMaxAngleError()) + 1e-5f));
+  }
+  EXPECT_LT(maxError, rot::CompactRotationVector::getMaxAngleError());
+
+  // Batch
+  const rot::RotationQuaternionArrayD array(rotations);
+  std::vector<rot::CompactRotationVector> compact;
+  rot::encode(array, compact, rot::ThreadPoolExecutor(2));
+  rot::RotationQuaternionArrayD decoded;
+  rot::decode(compact, decoded);
+  ASSERT_EQ(array.size(), decoded.size());
+  for (int i = 0; i < array.size(); ++i) {
+    EXPECT_EQ(rot::CompactRotationVector(rotations[i]), compact[i]);
+    EXPECT_LT(decoded[i].getDisparityAngle(rotations[i]), rot::CompactRotationVector::getMaxAngleError());
+  }
+}
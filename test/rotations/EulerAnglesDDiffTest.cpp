@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename EulerAngles_, typename EulerAnglesDiff_, typename EulerAnglesDDiff_>
+struct EulerAnglesDDiffTypes {
+  typedef EulerAngles_ EulerAngles;
+  typedef EulerAnglesDiff_ EulerAnglesDiff;
+  typedef EulerAnglesDDiff_ EulerAnglesDDiff;
+};
+
+typedef ::testing::Types<
+    EulerAnglesDDiffTypes<kindr::EulerAnglesZyxD, kindr::EulerAnglesZyxDiffD, kindr::EulerAnglesZyxDDiffD>,
+    EulerAnglesDDiffTypes<kindr::EulerAnglesXyzD, kindr::EulerAnglesXyzDiffD, kindr::EulerAnglesXyzDDiffD>
+> EulerAnglesDDiffTypeList;
+
+template <typename Types_>
+struct EulerAnglesDDiffTest : public ::testing::Test {
+  typedef typename Types_::EulerAngles EulerAngles;
+  typedef typename Types_::EulerAnglesDiff EulerAnglesDiff;
+  typedef typename Types_::EulerAnglesDDiff EulerAnglesDDiff;
+
+  const Eigen::Vector3d angles = Eigen::Vector3d(0.4, -0.7, 1.9);
+  const Eigen::Vector3d diff = Eigen::Vector3d(0.8, -1.3, 0.6);
+  const Eigen::Vector3d ddiff = Eigen::Vector3d(-0.5, 2.1, 1.2);
+
+  //! Angular velocity along the trajectory angles + diff*t + 0.5*ddiff*t^2
+  Eigen::Vector3d getAngularVelocity(double t, bool isLocal) const {
+    const EulerAngles eulerAngles(Eigen::Vector3d(angles + diff*t + 0.5*ddiff*t*t));
+    const Eigen::Vector3d eulerAnglesDiff = diff + ddiff*t;
+    return isLocal ? eulerAngles.getRateMapping().getLocalAngularVelocity(eulerAnglesDiff)
+                   : eulerAngles.getRateMapping().getGlobalAngularVelocity(eulerAnglesDiff);
+  }
+};
+
+TYPED_TEST_CASE(EulerAnglesDDiffTest, EulerAnglesDDiffTypeList);
+
+TYPED_TEST(EulerAnglesDDiffTest, testAngularAccelerationAgreesWithFiniteDifferences) {
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  typedef typename TestFixture::EulerAnglesDiff EulerAnglesDiff;
+  typedef typename TestFixture::EulerAnglesDDiff EulerAnglesDDiff;
+  const EulerAngles eulerAngles(this->angles);
+  const EulerAnglesDiff eulerAnglesDiff(this->diff);
+  const EulerAnglesDDiff eulerAnglesDDiff(this->ddiff);
+  const double h = 1e-5;
+
+  const Eigen::Vector3d localAngularAcceleration = (this->getAngularVelocity(h, true) - this->getAngularVelocity(-h, true))/(2.0*h);
+  const Eigen::Vector3d globalAngularAcceleration = (this->getAngularVelocity(h, false) - this->getAngularVelocity(-h, false))/(2.0*h);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(eulerAnglesDDiff.getLocalAngularAcceleration(eulerAngles, eulerAnglesDiff).toImplementation(), localAngularAcceleration, 1e-7, 0, "local");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(eulerAnglesDDiff.getGlobalAngularAcceleration(eulerAngles, eulerAnglesDiff).toImplementation(), globalAngularAcceleration, 1e-7, 0, "global");
+
+  // The local angular acceleration is the inversely rotated global one
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(eulerAnglesDDiff.getLocalAngularAcceleration(eulerAngles, eulerAnglesDiff).toImplementation(),
+                                    eulerAngles.inverseRotate(eulerAnglesDDiff.getGlobalAngularAcceleration(eulerAngles, eulerAnglesDiff).toImplementation()), 1e-12, 0, "rotated");
+}
+
+TYPED_TEST(EulerAnglesDDiffTest, testDDiffFromAngularAcceleration) {
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  typedef typename TestFixture::EulerAnglesDiff EulerAnglesDiff;
+  typedef typename TestFixture::EulerAnglesDDiff EulerAnglesDDiff;
+  const EulerAngles eulerAngles(this->angles);
+  const EulerAnglesDiff eulerAnglesDiff(this->diff);
+  const EulerAnglesDDiff eulerAnglesDDiff(this->ddiff);
+
+  const EulerAnglesDDiff fromLocal = EulerAnglesDDiff::fromLocalAngularAcceleration(eulerAngles, eulerAnglesDiff,
+      eulerAnglesDDiff.getLocalAngularAcceleration(eulerAngles, eulerAnglesDiff));
+  const EulerAnglesDDiff fromGlobal = EulerAnglesDDiff::fromGlobalAngularAcceleration(eulerAngles, eulerAnglesDiff,
+      eulerAnglesDDiff.getGlobalAngularAcceleration(eulerAngles, eulerAnglesDiff));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(fromLocal.toImplementation(), this->ddiff, 1e-10, 0, "local");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(fromGlobal.toImplementation(), this->ddiff, 1e-10, 0, "global");
+
+  // Without a second derivative, the angular acceleration only stems from the changing mapping
+  const EulerAnglesDDiff zero;
+  const kindr::AngularAcceleration3D globalAngularAcceleration = zero.getGlobalAngularAcceleration(eulerAngles, eulerAnglesDiff);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(EulerAnglesDDiff::fromGlobalAngularAcceleration(eulerAngles, eulerAnglesDiff, globalAngularAcceleration).toImplementation(),
+                                    Eigen::Vector3d::Zero(), 1e-12, 0, "zero");
+}
+
+TEST(EulerAnglesDDiffTest, testAccessors) {
+  const kindr::EulerAnglesZyxDDiffD zyx(0.1, 0.2, 0.3);
+  EXPECT_EQ(0.1, zyx.yaw());
+  EXPECT_EQ(0.2, zyx.pitch());
+  EXPECT_EQ(0.3, zyx.roll());
+  EXPECT_EQ(0.3, zyx.x());
+
+  const kindr::EulerAnglesXyzDDiffD xyz(0.1, 0.2, 0.3);
+  EXPECT_EQ(0.1, xyz.roll());
+  EXPECT_EQ(0.2, xyz.pitch());
+  EXPECT_EQ(0.3, xyz.yaw());
+  EXPECT_EQ(0.3, xyz.z());
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/rotations/EulerAnglesRates.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    kindr::EulerAnglesZyxD,
+    kindr::EulerAnglesXyzD
+> EulerAnglesTypes;
+
+template <typename EulerAngles_>
+struct EulerAnglesRatesTest : public ::testing::Test {
+  typedef EulerAngles_ EulerAngles;
+  typedef Eigen::Matrix<double, 3, Eigen::Dynamic> Matrix3X;
+
+  Matrix3X eulerAngles;
+  Matrix3X rates;
+
+  EulerAnglesRatesTest() : eulerAngles(3, 2500), rates(3, 2500) {
+    for (int i = 0; i < eulerAngles.cols(); ++i) {
+      eulerAngles.col(i) << std::sin(0.37*i)*3.0, std::sin(0.11*i)*1.4, std::cos(0.23*i)*3.0;
+      rates.col(i) << std::cos(0.07*i), -0.5 + 0.001*i, std::sin(0.19*i);
+    }
+  }
+};
+
+TYPED_TEST_CASE(EulerAnglesRatesTest, EulerAnglesTypes);
+
+TYPED_TEST(EulerAnglesRatesTest, testMappingsAgreeWithMatrices) {
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  typedef typename EulerAngles::RateMapping RateMapping;
+  for (int i = 0; i < 50; ++i) {
+    const EulerAngles eulerAngles(this->eulerAngles.col(i));
+    const RateMapping rateMapping = eulerAngles.getRateMapping();
+    const Eigen::Vector3d rate = this->rates.col(i);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rateMapping.getLocalAngularVelocity(rate), Eigen::Vector3d(eulerAngles.getMappingFromDiffToLocalAngularVelocity()*rate), 1e-12, 0, "local");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rateMapping.getGlobalAngularVelocity(rate), Eigen::Vector3d(eulerAngles.getMappingFromDiffToGlobalAngularVelocity()*rate), 1e-12, 0, "global");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rateMapping.getDiffFromLocalAngularVelocity(rate), Eigen::Vector3d(eulerAngles.getMappingFromLocalAngularVelocityToDiff()*rate), 1e-12, 0, "local inverse");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rateMapping.getDiffFromGlobalAngularVelocity(rate), Eigen::Vector3d(eulerAngles.getMappingFromGlobalAngularVelocityToDiff()*rate), 1e-12, 0, "global inverse");
+
+    // The global angular velocity is the rotated local one
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rateMapping.getGlobalAngularVelocity(rate), eulerAngles.rotate(rateMapping.getLocalAngularVelocity(rate)), 1e-12, 0, "rotated");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rateMapping.getDiffFromLocalAngularVelocity(rateMapping.getLocalAngularVelocity(rate)), rate, 1e-10, 0, "local round trip");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rateMapping.getDiffFromGlobalAngularVelocity(rateMapping.getGlobalAngularVelocity(rate)), rate, 1e-10, 0, "global round trip");
+  }
+}
+
+TYPED_TEST(EulerAnglesRatesTest, testBatches) {
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  typedef typename TestFixture::Matrix3X Matrix3X;
+  const int numSamples = static_cast<int>(this->eulerAngles.cols());
+  Matrix3X localAngularVelocities(3, numSamples);
+  Matrix3X globalAngularVelocities(3, numSamples);
+  Matrix3X localDiffs(3, numSamples);
+  Matrix3X globalDiffs(3, numSamples);
+  const kindr::ThreadPoolExecutor executor(3);
+  kindr::getLocalAngularVelocitiesFromEulerAnglesDiffs<EulerAngles>(this->eulerAngles, this->rates, localAngularVelocities, executor);
+  kindr::getGlobalAngularVelocitiesFromEulerAnglesDiffs<EulerAngles>(this->eulerAngles, this->rates, globalAngularVelocities);
+  kindr::getEulerAnglesDiffsFromLocalAngularVelocities<EulerAngles>(this->eulerAngles, localAngularVelocities, localDiffs, executor);
+  kindr::getEulerAnglesDiffsFromGlobalAngularVelocities<EulerAngles>(this->eulerAngles, globalAngularVelocities, globalDiffs);
+
+  for (int i = 0; i < numSamples; i += 97) {
+    const EulerAngles eulerAngles(this->eulerAngles.col(i));
+    const Eigen::Vector3d rate = this->rates.col(i);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(localAngularVelocities.col(i), Eigen::Vector3d(eulerAngles.getMappingFromDiffToLocalAngularVelocity()*rate), 1e-12, 0, "local");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(globalAngularVelocities.col(i), Eigen::Vector3d(eulerAngles.getMappingFromDiffToGlobalAngularVelocity()*rate), 1e-12, 0, "global");
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(localDiffs, this->rates, 1e-8, 0, "local round trip");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(globalDiffs, this->rates, 1e-8, 0, "global round trip");
+
+  Matrix3X tooFewRates(3, numSamples - 1);
+  EXPECT_THROW(kindr::getLocalAngularVelocitiesFromEulerAnglesDiffs<EulerAngles>(this->eulerAngles, tooFewRates, localAngularVelocities), std::runtime_error);
+}
+
+TEST(EulerAnglesRatesTest, testDiffFromGlobalAngularVelocity) {
+  const kindr::GlobalAngularVelocityD angularVelocity(0.3, -1.2, 0.8);
+  const kindr::EulerAnglesZyxD eulerAnglesZyx(0.4, -0.7, 1.9);
+  const kindr::EulerAnglesZyxDiffD eulerAnglesZyxDiff(eulerAnglesZyx, angularVelocity);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::GlobalAngularVelocityD(eulerAnglesZyx, eulerAnglesZyxDiff).vector(), angularVelocity.vector(), 1e-10, 0, "zyx");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::LocalAngularVelocityD(eulerAnglesZyx, eulerAnglesZyxDiff).vector(), eulerAnglesZyx.inverseRotate(angularVelocity.vector()), 1e-10, 0, "zyx local");
+
+  const kindr::EulerAnglesXyzD eulerAnglesXyz(0.4, -0.7, 1.9);
+  const kindr::EulerAnglesXyzDiffD eulerAnglesXyzDiff(eulerAnglesXyz, angularVelocity);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::GlobalAngularVelocityD(eulerAnglesXyz, eulerAnglesXyzDiff).vector(), angularVelocity.vector(), 1e-10, 0, "xyz");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::LocalAngularVelocityD(eulerAnglesXyz, eulerAnglesXyzDiff).vector(), eulerAnglesXyz.inverseRotate(angularVelocity.vector()), 1e-10, 0, "xyz local");
+}
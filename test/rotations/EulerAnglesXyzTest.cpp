@@ -714,3 +714,30 @@ TYPED_TEST(EulerAnglesXyzSingleTest, testRotationMatrix)
   KINDR_ASSERT_DOUBLE_MX_EQ(rotMat, rotMatKindr.matrix(), Scalar(1.0e-3), "rotation matrix")
 }
 
+
+TYPED_TEST(EulerAnglesXyzSingleTest, testExtraction)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::EulerAnglesXyz EulerAnglesXyz;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef kindr::RotationMatrix<Scalar> RotationMatrix;
+
+  // Regular angles are recovered exactly
+  const EulerAnglesXyz rot(M_PI_4, 1.2, -0.8);
+  const EulerAnglesXyz rotFromQuaternion = EulerAnglesXyz(RotationQuaternion(rot));
+  const EulerAnglesXyz rotFromMatrix = EulerAnglesXyz(RotationMatrix(rot));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rot.toImplementation(), rotFromQuaternion.toImplementation(), 1.0e-4, 1.0e-4, "from quaternion");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rot.toImplementation(), rotFromMatrix.toImplementation(), 1.0e-4, 1.0e-4, "from rotation matrix");
+
+  // Gimbal lock: the rotation is preserved and yaw is set to zero
+  for (Scalar pitch : {Scalar(M_PI_2), Scalar(-M_PI_2)}) {
+    const EulerAnglesXyz rotGimbal(0.3, pitch, -0.5);
+    const EulerAnglesXyz rotGimbalFromQuaternion = EulerAnglesXyz(RotationQuaternion(rotGimbal));
+    const EulerAnglesXyz rotGimbalFromMatrix = EulerAnglesXyz(RotationMatrix(rotGimbal));
+    ASSERT_TRUE(RotationQuaternion(rotGimbalFromQuaternion).isNear(RotationQuaternion(rotGimbal), 1.0e-3)) << "from quaternion, pitch: " << pitch;
+    ASSERT_TRUE(RotationQuaternion(rotGimbalFromMatrix).isNear(RotationQuaternion(rotGimbal), 1.0e-3)) << "from rotation matrix, pitch: " << pitch;
+    ASSERT_NEAR(rotGimbalFromQuaternion.pitch(), pitch, 1.0e-3);
+    ASSERT_NEAR(rotGimbalFromQuaternion.yaw(), 0.0, 1.0e-6);
+    ASSERT_NEAR(rotGimbalFromMatrix.yaw(), 0.0, 1.0e-6);
+  }
+}
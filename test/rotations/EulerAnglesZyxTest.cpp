@@ -723,3 +723,30 @@ TYPED_TEST(EulerAnglesZyxSingleTest, testRotationMatrix)
   std::cout << "kindr: " << rotMatKindr.matrix() << "/n ours: " << rotMat << std::endl;
 }
 
+
+TYPED_TEST(EulerAnglesZyxSingleTest, testExtraction)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::EulerAnglesZyx EulerAnglesZyx;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef kindr::RotationMatrix<Scalar> RotationMatrix;
+
+  // Regular angles are recovered exactly
+  const EulerAnglesZyx rot(-0.8, 1.2, M_PI_4);
+  const EulerAnglesZyx rotFromQuaternion = EulerAnglesZyx(RotationQuaternion(rot));
+  const EulerAnglesZyx rotFromMatrix = EulerAnglesZyx(RotationMatrix(rot));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rot.toImplementation(), rotFromQuaternion.toImplementation(), 1.0e-4, 1.0e-4, "from quaternion");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rot.toImplementation(), rotFromMatrix.toImplementation(), 1.0e-4, 1.0e-4, "from rotation matrix");
+
+  // Gimbal lock: the rotation is preserved and roll is set to zero
+  for (Scalar pitch : {Scalar(M_PI_2), Scalar(-M_PI_2)}) {
+    const EulerAnglesZyx rotGimbal(0.3, pitch, -0.5);
+    const EulerAnglesZyx rotGimbalFromQuaternion = EulerAnglesZyx(RotationQuaternion(rotGimbal));
+    const EulerAnglesZyx rotGimbalFromMatrix = EulerAnglesZyx(RotationMatrix(rotGimbal));
+    ASSERT_TRUE(RotationQuaternion(rotGimbalFromQuaternion).isNear(RotationQuaternion(rotGimbal), 1.0e-3)) << "from quaternion, pitch: " << pitch;
+    ASSERT_TRUE(RotationQuaternion(rotGimbalFromMatrix).isNear(RotationQuaternion(rotGimbal), 1.0e-3)) << "from rotation matrix, pitch: " << pitch;
+    ASSERT_NEAR(rotGimbalFromQuaternion.pitch(), pitch, 1.0e-3);
+    ASSERT_NEAR(rotGimbalFromQuaternion.roll(), 0.0, 1.0e-6);
+    ASSERT_NEAR(rotGimbalFromMatrix.roll(), 0.0, 1.0e-6);
+  }
+}
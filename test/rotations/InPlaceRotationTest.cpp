@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename Rotation_>
+class InPlaceRotationTest : public ::testing::Test {
+ public:
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  Rotation rotation;
+  Rotation otherRotation;
+
+  InPlaceRotationTest()
+    : rotation(rot::EulerAnglesZyx<Scalar>(0.8, -0.3, 0.5)),
+      otherRotation(rot::EulerAnglesZyx<Scalar>(-1.2, 0.4, 2.1)) {
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationMatrixD,
+    rot::AngleAxisD,
+    rot::RotationVectorD,
+    rot::EulerAnglesZyxD,
+    rot::EulerAnglesXyzF
+> Types;
+
+TYPED_TEST_CASE(InPlaceRotationTest, Types);
+
+TYPED_TEST(InPlaceRotationTest, testMultiplyAndInvert)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  Rotation rotation = this->rotation;
+  Rotation& reference = (rotation *= this->otherRotation);
+  ASSERT_EQ(&rotation, &reference);
+  ASSERT_TRUE(rotation.isNear(this->rotation*this->otherRotation, this->tol));
+
+  // mixed parameterizations
+  rotation = this->rotation;
+  rotation *= rot::RotationQuaternion<typename TestFixture::Scalar>(this->otherRotation);
+  ASSERT_TRUE(rotation.isNear(this->rotation*this->otherRotation, this->tol));
+
+  rotation = this->rotation;
+  rotation.invert();
+  ASSERT_TRUE(rotation.isNear(this->rotation.inverted(), this->tol));
+}
+
+TYPED_TEST(InPlaceRotationTest, testBoxPlus)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Vector3 Vector3;
+  const Vector3 vector(0.2, -0.5, 0.3);
+  Rotation rotation = this->rotation;
+  Rotation& reference = rotation.boxPlusInPlace(vector);
+  ASSERT_EQ(&rotation, &reference);
+  ASSERT_TRUE(rotation.isNear(this->rotation.boxPlus(vector), this->tol));
+}
+
+TYPED_TEST(InPlaceRotationTest, testRotate)
+{
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3X Matrix3X;
+  Vector3 vector(1.0, -2.0, 0.5);
+  const Vector3 original = vector;
+  this->rotation.rotateInPlace(vector);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotation.rotate(original), vector, this->tol, this->tol, "rotateInPlace vector");
+  this->rotation.inverseRotateInPlace(vector);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(original, vector, this->tol, this->tol, "inverseRotateInPlace vector");
+
+  const Matrix3X batch = Matrix3X::Random(3, 300);
+  Matrix3X rotated = batch;
+  this->rotation.rotateInPlace(rotated, rot::ThreadPoolExecutor(2));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3X(rot::RotationMatrix<typename TestFixture::Scalar>(this->rotation).matrix()*batch), rotated, this->tol, this->tol, "rotateInPlace");
+  this->rotation.inverseRotateInPlace(rotated.leftCols(100));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3X(batch.leftCols(100)), Matrix3X(rotated.leftCols(100)), this->tol, this->tol, "inverseRotateInPlace block");
+}
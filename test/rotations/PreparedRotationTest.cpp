@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename Rotation_>
+class PreparedRotationTest : public ::testing::Test {
+ public:
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  Rotation rotation;
+  Vector3 vector;
+
+  PreparedRotationTest()
+    : rotation(rot::EulerAnglesZyx<Scalar>(0.8, -0.3, 0.5)),
+      vector(Scalar(1.0), Scalar(-2.0), Scalar(0.5)) {
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationMatrixD,
+    rot::AngleAxisD,
+    rot::RotationVectorD,
+    rot::EulerAnglesZyxD,
+    rot::EulerAnglesXyzF
+> Types;
+
+TYPED_TEST_CASE(PreparedRotationTest, Types);
+
+TYPED_TEST(PreparedRotationTest, testRotate)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Matrix3X Matrix3X;
+
+  const rot::PreparedRotation<typename TestFixture::Rotation> prepared = this->rotation.prepared();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotation.rotate(this->vector), prepared.rotate(this->vector), this->tol, this->tol, "rotate");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotation.inverseRotate(this->vector), prepared.inverseRotate(this->vector), this->tol, this->tol, "inverseRotate");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(prepared.matrix().transpose(), prepared.conjugateMatrix(), this->tol, this->tol, "conjugate");
+  ASSERT_TRUE(prepared.getRotationMatrix().isNear(this->rotation, this->tol));
+  ASSERT_TRUE(prepared.getRotation().isNear(this->rotation, this->tol));
+
+  // vectors keep their physical type
+  const rot::Position<Scalar, 3> position(this->vector);
+  const rot::Position<Scalar, 3> rotatedPosition = prepared.rotate(position);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotation.rotate(this->vector), rotatedPosition.toImplementation(), this->tol, this->tol, "rotate position");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(position.toImplementation(), prepared.inverseRotate(rotatedPosition).toImplementation(), this->tol, this->tol, "inverseRotate position");
+
+  // the inverse swaps the cached matrices
+  const rot::PreparedRotation<typename TestFixture::Rotation> inverse = prepared.inverted();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(prepared.inverseRotate(this->vector), inverse.rotate(this->vector), this->tol, this->tol, "inverted");
+  ASSERT_TRUE(inverse.getRotation().isNear(this->rotation.inverted(), this->tol));
+
+  // matrices and batches
+  const Eigen::Matrix<Scalar, 3, 4> matrix = Eigen::Matrix<Scalar, 3, 4>::Random();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotation.rotate(matrix), prepared.rotate(matrix), this->tol, this->tol, "rotate matrix");
+
+  // expressions are evaluated
+  const typename TestFixture::Vector3 rotatedExpression = prepared.rotate(Scalar(2)*this->vector);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(typename TestFixture::Vector3(Scalar(2)*prepared.rotate(this->vector)), rotatedExpression, this->tol, this->tol, "rotate expression");
+  const Eigen::Matrix<Scalar, 3, 4> restoredMatrix = prepared.inverseRotate(prepared.rotate(matrix.col(0).replicate(1, 4)));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(matrix.col(0).replicate(1, 4), restoredMatrix, this->tol, this->tol, "inverseRotate expression");
+  const Matrix3X batch = Matrix3X::Random(3, 300);
+  Matrix3X rotated(3, batch.cols());
+  prepared.rotateBatch(batch, rotated);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3X(prepared.matrix()*batch), rotated, this->tol, this->tol, "rotateBatch");
+  Matrix3X restored(3, batch.cols());
+  prepared.inverseRotateBatch(rotated, restored, rot::ThreadPoolExecutor(2));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(batch, restored, this->tol, this->tol, "inverseRotateBatch");
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationAveraging.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+class RotationAveragingTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef rot::RotationQuaternionArray<Scalar> RotationQuaternionArray;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const double tol = 1.0e-4;
+
+  RotationQuaternion center;
+  std::vector<RotationQuaternion> rotations;
+
+  RotationAveragingTest() {
+    center = RotationQuaternion(rot::EulerAnglesZyx<Scalar>(0.8, -0.3, 0.5));
+    // symmetric perturbations around the center with flipped signs of some quaternions
+    const Vector3 perturbations[3] = {Vector3(0.2, 0.0, 0.0), Vector3(0.0, -0.3, 0.1), Vector3(0.05, 0.1, -0.25)};
+    for (int i = 0; i < 3; ++i) {
+      rotations.push_back(center.boxPlus(perturbations[i]));
+      rotations.push_back(RotationQuaternion(-center.boxPlus(-perturbations[i]).vector()));
+    }
+  }
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+
+TYPED_TEST_CASE(RotationAveragingTest, PrimTypes);
+
+TYPED_TEST(RotationAveragingTest, testChordalMean)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+
+  const RotationQuaternionArray array(this->rotations);
+  const RotationQuaternion mean = rot::getChordalMean(array);
+  EXPECT_TRUE(mean.isNear(this->center, this->tol));
+  EXPECT_GE(mean.w(), Scalar(0));
+  EXPECT_TRUE(rot::getChordalMean(this->rotations).isNear(this->center, this->tol));
+
+  // other parameterizations
+  std::vector<rot::RotationMatrix<Scalar>> matrices;
+  for (const RotationQuaternion& rotation : this->rotations) {
+    matrices.push_back(rot::RotationMatrix<Scalar>(rotation));
+  }
+  EXPECT_TRUE(rot::getChordalMean(matrices).isNear(this->center, this->tol));
+
+  // weights select a single rotation
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 1> weights = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>::Zero(array.size());
+  weights(2) = Scalar(3);
+  EXPECT_TRUE(rot::getChordalMean(array, weights).isNear(this->rotations[2], this->tol));
+
+  // chunks of an executor
+  const rot::ThreadPoolExecutor executor(3);
+  RotationQuaternionArray many(3*rot::internal::AveragingGrainSize);
+  for (int i = 0; i < many.size(); ++i) {
+    many.set(i, this->rotations[i % this->rotations.size()]);
+  }
+  EXPECT_TRUE(rot::getChordalMean(many, executor).isNear(this->center, this->tol));
+  EXPECT_TRUE(rot::getKarcherMean(many, Scalar(1e-5), 10, executor).isNear(this->center, this->tol));
+
+  rot::RotationMeanAccumulator<Scalar> accumulator;
+  EXPECT_ANY_THROW(accumulator.getChordalMean());
+  accumulator.add(this->rotations[4], Scalar(0.5));
+  EXPECT_NEAR(accumulator.getWeightSum(), 0.5, this->tol);
+  EXPECT_TRUE(accumulator.getChordalMean().isNear(this->rotations[4], this->tol));
+  accumulator.setZero();
+  EXPECT_NEAR(accumulator.getWeightSum(), 0.0, this->tol);
+}
+
+TYPED_TEST(RotationAveragingTest, testKarcherMean)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename TestFixture::Vector3 Vector3;
+
+  const RotationQuaternionArray array(this->rotations);
+  const RotationQuaternion mean = rot::getKarcherMean(array);
+  EXPECT_TRUE(mean.isNear(this->center, this->tol));
+  EXPECT_TRUE(rot::getKarcherMean(this->rotations).isNear(this->center, this->tol));
+
+  // the mean is a zero of the summed geodesic errors
+  Vector3 error = Vector3::Zero();
+  for (int i = 0; i < array.size(); ++i) {
+    error += array[i].boxMinus(mean);
+  }
+  EXPECT_NEAR(error.norm(), 0.0, this->tol);
+
+  // weighted mean of two rotations lies on the geodesic
+  RotationQuaternionArray pair(2);
+  pair.set(0, this->rotations[0]);
+  pair.set(1, this->rotations[3]);
+  const Eigen::Matrix<Scalar, 2, 1> weights(1.0, 3.0);
+  const RotationQuaternion weightedMean = rot::getKarcherMean(pair, weights);
+  const RotationQuaternion expected = pair[0].boxPlus(Scalar(0.75)*pair[1].boxMinus(pair[0]));
+  EXPECT_TRUE(weightedMean.isNear(expected, this->tol));
+  EXPECT_ANY_THROW(rot::getKarcherMean(pair, Eigen::Matrix<Scalar, 3, 1>::Ones().eval()));
+}
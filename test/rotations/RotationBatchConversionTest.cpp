@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename Dest_, typename Source_>
+struct ConversionPair {
+  typedef Dest_ Dest;
+  typedef Source_ Source;
+};
+
+template <typename Pair_>
+class RotationBatchConversionTest : public ::testing::Test {
+ public:
+  typedef typename Pair_::Dest Dest;
+  typedef typename Pair_::Source Source;
+  typedef typename Source::Scalar Scalar;
+  typedef typename rot::internal::RotationArrayTraits<Source>::Matrix SourceMatrix;
+  typedef typename rot::internal::RotationArrayTraits<Dest>::Matrix DestMatrix;
+
+  const double tol = std::is_same<Scalar, float>::value ? 1e-5 : 1e-12;
+
+  rot::AlignedVector<Source> sources;
+
+  RotationBatchConversionTest() {
+    const Scalar halfPi = Scalar(M_PI/2.0);
+    // identity, half turns (all branches of the conversion to quaternions), gimbal lock and random rotations
+    sources.push_back(Source());
+    sources.push_back(Source(rot::EulerAnglesZyx<Scalar>(Scalar(M_PI), 0, 0)));
+    sources.push_back(Source(rot::EulerAnglesZyx<Scalar>(0, Scalar(M_PI), 0)));
+    sources.push_back(Source(rot::EulerAnglesZyx<Scalar>(0, 0, Scalar(M_PI))));
+    sources.push_back(Source(rot::EulerAnglesZyx<Scalar>(Scalar(0.3), halfPi, Scalar(-0.2))));
+    sources.push_back(Source(rot::EulerAnglesZyx<Scalar>(Scalar(0.3), -halfPi, Scalar(0.4))));
+    while (sources.size() < 300) {
+      sources.push_back(Source(rot::RotationQuaternion<Scalar>().setRandom()));
+    }
+  }
+
+  SourceMatrix getSourceMatrix(const rot::AlignedVector<Source>& rotations) const {
+    SourceMatrix matrix(static_cast<int>(SourceMatrix::RowsAtCompileTime), rotations.size());
+    for (int i = 0; i < static_cast<int>(rotations.size()); ++i) {
+      rot::internal::RotationArrayTraits<Source>::set(matrix, i, rotations[i]);
+    }
+    return matrix;
+  }
+
+  DestMatrix getDestMatrix(const rot::AlignedVector<Dest>& rotations) const {
+    DestMatrix matrix(static_cast<int>(DestMatrix::RowsAtCompileTime), rotations.size());
+    for (int i = 0; i < static_cast<int>(rotations.size()); ++i) {
+      rot::internal::RotationArrayTraits<Dest>::set(matrix, i, rotations[i]);
+    }
+    return matrix;
+  }
+
+  //! Conversion with the traits of the single rotations
+  rot::AlignedVector<Dest> getExpected(const rot::AlignedVector<Source>& rotations) const {
+    rot::AlignedVector<Dest> expected;
+    for (const Source& rotation : rotations) {
+      expected.push_back(Dest(rotation));
+    }
+    return expected;
+  }
+};
+
+typedef ::testing::Types<
+    ConversionPair<rot::RotationMatrixD, rot::RotationQuaternionD>,
+    ConversionPair<rot::RotationQuaternionD, rot::RotationMatrixD>,
+    ConversionPair<rot::RotationQuaternionD, rot::EulerAnglesZyxD>,
+    ConversionPair<rot::EulerAnglesZyxD, rot::RotationQuaternionD>,
+    ConversionPair<rot::EulerAnglesZyxD, rot::RotationMatrixD>,
+    ConversionPair<rot::RotationMatrixF, rot::RotationQuaternionF>,
+    ConversionPair<rot::RotationQuaternionF, rot::RotationMatrixF>,
+    ConversionPair<rot::RotationQuaternionF, rot::EulerAnglesZyxF>,
+    ConversionPair<rot::EulerAnglesZyxF, rot::RotationQuaternionF>,
+    ConversionPair<rot::EulerAnglesZyxF, rot::RotationMatrixF>,
+    ConversionPair<rot::EulerAnglesXyzD, rot::AngleAxisD>,
+    ConversionPair<rot::RotationQuaternionD, rot::RotationVectorD>,
+    ConversionPair<rot::AngleAxisF, rot::EulerAnglesXyzF>
+> Pairs;
+
+TYPED_TEST_CASE(RotationBatchConversionTest, Pairs);
+
+TYPED_TEST(RotationBatchConversionTest, testArrayOfStructures)
+{
+  typedef typename TestFixture::Dest Dest;
+  const rot::AlignedVector<Dest> expected = this->getExpected(this->sources);
+
+  rot::AlignedVector<Dest> destinations;
+  rot::convert(this->sources, destinations);
+  ASSERT_EQ(this->sources.size(), destinations.size());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->getDestMatrix(expected), this->getDestMatrix(destinations), this->tol, this->tol, "vector");
+
+  // a part of the array is converted on two threads
+  rot::AlignedVector<Dest> part(this->sources.size());
+  rot::convert(this->sources.data() + 1, part.data() + 1, static_cast<int>(this->sources.size()) - 2, rot::ThreadPoolExecutor(2));
+  for (int i = 1; i < static_cast<int>(this->sources.size()) - 1; ++i) {
+    ASSERT_TRUE(part[i].isNear(expected[i], this->tol)) << "rotation " << i;
+  }
+  ASSERT_TRUE(part.front().isNear(Dest(), this->tol));
+  ASSERT_TRUE(part.back().isNear(Dest(), this->tol));
+}
+
+TYPED_TEST(RotationBatchConversionTest, testStructureOfArrays)
+{
+  typedef typename TestFixture::Dest Dest;
+  typedef typename TestFixture::Source Source;
+  typedef typename TestFixture::DestMatrix DestMatrix;
+  const DestMatrix expected = this->getDestMatrix(this->getExpected(this->sources));
+
+  DestMatrix destinations(static_cast<int>(DestMatrix::RowsAtCompileTime), this->sources.size());
+  rot::convert<Dest, Source>(this->getSourceMatrix(this->sources), destinations);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, destinations, this->tol, this->tol, "serial");
+
+  destinations.setZero();
+  rot::convert<Dest, Source>(this->getSourceMatrix(this->sources), destinations, rot::ThreadPoolExecutor(3));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, destinations, this->tol, this->tol, "thread pool");
+}
+
+TEST(RotationBatchConversionTest, testRotationQuaternionArray)
+{
+  const Eigen::Matrix<double, 4, Eigen::Dynamic> coefficients = Eigen::Matrix<double, 4, Eigen::Dynamic>::Random(4, 200);
+  const rot::RotationQuaternionArrayD quaternions(coefficients.colwise().normalized());
+  Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor> yawPitchRoll(3, quaternions.size());
+  rot::convert<rot::EulerAnglesZyxD, rot::RotationQuaternionD>(quaternions.toImplementation(), yawPitchRoll);
+  for (int i = 0; i < quaternions.size(); ++i) {
+    ASSERT_TRUE(rot::EulerAnglesZyxD(yawPitchRoll(0, i), yawPitchRoll(1, i), yawPitchRoll(2, i)).isNear(quaternions[i], 1e-12));
+  }
+
+  rot::RotationQuaternionArrayD converted(quaternions.size());
+  rot::convert<rot::RotationQuaternionD, rot::EulerAnglesZyxD>(yawPitchRoll, converted.toImplementation());
+  for (int i = 0; i < quaternions.size(); ++i) {
+    ASSERT_TRUE(converted[i].isNear(quaternions[i], 1e-12));
+  }
+}
+
+template <typename Rotation_>
+class RotationFromUnitVectorsTest : public ::testing::Test {
+ public:
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic, Eigen::RowMajor> VectorMatrix;
+  typedef typename rot::internal::RotationArrayTraits<Rotation>::Matrix RotationMatrix;
+
+  const double tol = std::is_same<Scalar, float>::value ? 1e-4 : 1e-10;
+
+  VectorMatrix from;
+  VectorMatrix to;
+
+  RotationFromUnitVectorsTest() : from(3, 300), to(3, 300) {
+    // identical, antiparallel along the axes, antiparallel, nearly antiparallel and random vectors
+    from.setRandom();
+    from.colwise().normalize();
+    to.setRandom();
+    to.colwise().normalize();
+    to.col(0) = from.col(0);
+    for (int i = 0; i < 3; ++i) {
+      from.col(1 + i) = Vector3::Unit(i);
+      to.col(1 + i) = -Vector3::Unit(i);
+    }
+    to.col(4) = -from.col(4);
+    to.col(200) = -from.col(200);
+    // 1+d is about 5e-11 for double and 5e-5 for float, i.e. just above the antiparallel branch
+    const Scalar offset = std::is_same<Scalar, float>::value ? Scalar(1e-2) : Scalar(1e-5);
+    for (int i = 5; i < 10; ++i) {
+      const Vector3 a = from.col(i);
+      to.col(i) = (offset*a.unitOrthogonal() - a).normalized();
+    }
+  }
+
+  //! Checks that the rotation matrix of a rotation is orthonormal
+  template <typename OtherRotation_>
+  void checkOrthonormal(const OtherRotation_& rotation, const std::string& message) const {
+    const Eigen::Matrix<Scalar, 3, 3> matrix = rot::RotationMatrix<Scalar>(rotation).matrix();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((matrix.transpose()*matrix).eval(), (Eigen::Matrix<Scalar, 3, 3>::Identity()), this->tol, 0, message);
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationMatrixD,
+    rot::RotationQuaternionF,
+    rot::RotationMatrixF,
+    rot::AngleAxisD,
+    rot::EulerAnglesZyxD
+> FromUnitVectorsTypes;
+
+TYPED_TEST_CASE(RotationFromUnitVectorsTest, FromUnitVectorsTypes);
+
+TYPED_TEST(RotationFromUnitVectorsTest, testSetFromUnitVectors)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Vector3 Vector3;
+  for (int i = 0; i < this->from.cols(); ++i) {
+    const Vector3 from = this->from.col(i);
+    const Vector3 to = this->to.col(i);
+    Rotation rotation;
+    rotation.setFromUnitVectors(from, to);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(to, rotation.rotate(from), this->tol, this->tol, "rotate " + std::to_string(i));
+    this->checkOrthonormal(rotation, "orthonormal " + std::to_string(i));
+    // the minimal rotation keeps the common normal and agrees with setFromVectors()
+    if (to.dot(from) > -0.5) {
+      Rotation expected;
+      expected.setFromVectors(from, to);
+      ASSERT_TRUE(rotation.isNear(expected, this->tol)) << "rotation " << i;
+    }
+  }
+  Rotation identity;
+  identity.setFromUnitVectors(Vector3(this->from.col(0)), Vector3(this->from.col(0)));
+  ASSERT_TRUE(identity.isNear(Rotation(), this->tol));
+}
+
+TYPED_TEST(RotationFromUnitVectorsTest, testBatch)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+  RotationMatrix rotations(static_cast<int>(RotationMatrix::RowsAtCompileTime), this->from.cols());
+  rot::setFromUnitVectors<Rotation>(this->from, this->to, rotations);
+  RotationMatrix threaded(static_cast<int>(RotationMatrix::RowsAtCompileTime), this->from.cols());
+  rot::setFromUnitVectors<Rotation>(this->from, this->to, threaded, rot::ThreadPoolExecutor(3));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotations, threaded, this->tol, this->tol, "thread pool");
+  for (int i = 0; i < this->from.cols(); ++i) {
+    Rotation expected;
+    expected.setFromUnitVectors(Vector3(this->from.col(i)), Vector3(this->to.col(i)));
+    ASSERT_TRUE(rot::internal::RotationArrayTraits<Rotation>::get(rotations, i).isNear(expected, this->tol)) << "rotation " << i;
+    this->checkOrthonormal(rot::internal::RotationArrayTraits<Rotation>::get(rotations, i), "orthonormal " + std::to_string(i));
+  }
+
+  // constant target, e.g. the gravity direction
+  const Vector3 up = Vector3::UnitZ();
+  rot::setFromUnitVectorsToVector<Rotation>(this->from, up, rotations);
+  for (int i = 0; i < this->from.cols(); ++i) {
+    const Vector3 from = this->from.col(i);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(up, rot::internal::RotationArrayTraits<Rotation>::get(rotations, i).rotate(from), this->tol, this->tol, "up " + std::to_string(i));
+  }
+}
+
+template <typename EulerAngles_>
+class EulerAnglesArrayTest : public ::testing::Test {
+ public:
+  typedef EulerAngles_ EulerAngles;
+  typedef typename EulerAngles_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic, Eigen::RowMajor> AnglesMatrix;
+};
+
+typedef ::testing::Types<
+    rot::EulerAnglesZyxD,
+    rot::EulerAnglesXyzD,
+    rot::EulerAnglesZyxF
+> EulerAnglesTypes;
+
+TYPED_TEST_CASE(EulerAnglesArrayTest, EulerAnglesTypes);
+
+TYPED_TEST(EulerAnglesArrayTest, testSetUnique)
+{
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::AnglesMatrix AnglesMatrix;
+  // all cases of the pitch including the gimbal lock tolerance
+  AnglesMatrix angles = Scalar(10)*AnglesMatrix::Random(3, 300);
+  const Scalar halfPi = Scalar(M_PI/2);
+  const Scalar pitches[] = {-halfPi, halfPi, -halfPi + Scalar(5e-4), halfPi - Scalar(5e-4), halfPi + Scalar(0.1), -halfPi - Scalar(0.1), Scalar(2.5*M_PI)};
+  for (int i = 0; i < 7; ++i) {
+    angles(1, i) = pitches[i];
+  }
+  AnglesMatrix unique = angles;
+  rot::setUniqueEulerAngles<EulerAngles>(unique);
+  for (int i = 0; i < angles.cols(); ++i) {
+    const EulerAngles expected = EulerAngles(angles(0, i), angles(1, i), angles(2, i)).getUnique();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.toImplementation(), unique.col(i), 1e-5, 1e-5, "angles " + std::to_string(i));
+  }
+
+  AnglesMatrix threaded = angles;
+  rot::setUniqueEulerAngles<EulerAngles>(threaded, rot::ThreadPoolExecutor(2));
+  ASSERT_TRUE(threaded == unique);
+}
+
+TYPED_TEST(EulerAnglesArrayTest, testContinuous)
+{
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::AnglesMatrix AnglesMatrix;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  // a trajectory turning twice about the first axis and passing the gimbal lock
+  const int size = 500;
+  rot::AlignedVector<RotationQuaternion> rotations;
+  for (int i = 0; i < size; ++i) {
+    const Scalar t = Scalar(i)/Scalar(size - 1);
+    rotations.push_back(RotationQuaternion(EulerAngles(Scalar(4.0*M_PI)*t - Scalar(3), Scalar(0.5) + Scalar(2)*t, Scalar(0.3)*t)));
+  }
+
+  AnglesMatrix angles;
+  rot::convertToContinuousEulerAngles<EulerAngles>(rotations.data(), size, angles);
+  ASSERT_EQ(size, angles.cols());
+  typename rot::internal::RotationArrayTraits<RotationQuaternion>::Matrix quaternions(4, size);
+  for (int i = 0; i < size; ++i) {
+    rot::internal::RotationArrayTraits<RotationQuaternion>::set(quaternions, i, rotations[i]);
+  }
+  AnglesMatrix soaAngles(3, size);
+  rot::convertToContinuousEulerAngles<EulerAngles, RotationQuaternion>(quaternions, soaAngles);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(angles, soaAngles, 1e-4, 1e-4, "structure of arrays");
+
+  for (int i = 0; i < size; ++i) {
+    // same rotations, continuous angles
+    ASSERT_TRUE(EulerAngles(angles(0, i), angles(1, i), angles(2, i)).isNear(rotations[i], 1e-4)) << "rotation " << i;
+    if (i > 0) {
+      ASSERT_LT((angles.col(i) - angles.col(i - 1)).cwiseAbs().maxCoeff(), Scalar(0.1)) << "angles " << i;
+    }
+  }
+  // the pitch leaves [-pi/2,pi/2] instead of jumping
+  ASSERT_GT(angles.row(1).maxCoeff(), Scalar(M_PI/2));
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename Rotation_>
+class RotationCompositionTest : public ::testing::Test {
+ public:
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  Rotation rotationAB;
+  rot::RotationQuaternion<Scalar> rotationBC;
+  rot::RotationMatrix<Scalar> rotationCD;
+  Vector3 vector;
+
+  RotationCompositionTest()
+    : rotationAB(rot::EulerAnglesZyx<Scalar>(0.8, -0.3, 0.5)),
+      rotationBC(rot::EulerAnglesZyx<Scalar>(-0.2, 0.4, 1.1)),
+      rotationCD(rot::EulerAnglesZyx<Scalar>(1.5, 0.1, -0.7)),
+      vector(Scalar(1.0), Scalar(-2.0), Scalar(0.5)) {
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationMatrixD,
+    rot::AngleAxisD,
+    rot::RotationVectorD,
+    rot::EulerAnglesZyxD,
+    rot::EulerAnglesXyzF
+> Types;
+
+TYPED_TEST_CASE(RotationCompositionTest, Types);
+
+TYPED_TEST(RotationCompositionTest, testProduct)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+  const Rotation expected = this->rotationAB*this->rotationBC*this->rotationCD;
+  const auto composition = this->rotationAB.lazy()*this->rotationBC*this->rotationCD;
+  ASSERT_EQ(static_cast<int>(decltype(composition)::Size), 3);
+
+  // the product is computed on assignment in the type of the result
+  const Rotation product = composition;
+  ASSERT_TRUE(product.isNear(expected, this->tol));
+  ASSERT_TRUE(composition.eval().isNear(expected, this->tol));
+  const rot::RotationQuaternion<Scalar> quaternion = composition;
+  ASSERT_TRUE(quaternion.isNear(expected, this->tol));
+  rot::RotationMatrix<Scalar> matrix;
+  matrix = composition;
+  ASSERT_TRUE(matrix.isNear(expected, this->tol));
+
+  // compositions are concatenated
+  const Rotation nested = (this->rotationAB.lazy()*this->rotationBC)*(this->rotationCD.lazy()*this->rotationAB);
+  ASSERT_TRUE(nested.isNear(expected*this->rotationAB, this->tol));
+}
+
+TYPED_TEST(RotationCompositionTest, testRotate)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Matrix3X Matrix3X;
+  typedef typename TestFixture::Vector3 Vector3;
+  const auto composition = this->rotationAB.lazy()*this->rotationBC*this->rotationCD;
+  const typename TestFixture::Rotation expected = composition;
+
+  // a large batch is rotated by the product
+  typedef decltype(composition) Composition;
+  ASSERT_TRUE(Composition::getEvaluation(100) != Composition::Evaluation::Sequential);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.rotate(this->vector), composition.rotate(this->vector), this->tol, this->tol, "rotate");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.inverseRotate(this->vector), composition.inverseRotate(this->vector), this->tol, this->tol, "inverseRotate");
+  const Matrix3X batch = Matrix3X::Random(3, 100);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.rotate(batch), composition.rotate(batch), this->tol, this->tol, "rotate batch");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.inverseRotate(batch), composition.inverseRotate(batch), this->tol, this->tol, "inverseRotate batch");
+  const Matrix3X small = batch.leftCols(1);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.rotate(small), composition.rotate(small), this->tol, this->tol, "rotate small batch");
+
+  // vectors keep their physical type
+  const rot::Position<Scalar, 3> position(this->vector);
+  const rot::Position<Scalar, 3> rotated = composition.rotate(position);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector3(expected.rotate(this->vector)), rotated.toImplementation(), this->tol, this->tol, "rotate position");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(position.toImplementation(), composition.inverseRotate(rotated).toImplementation(), this->tol, this->tol, "inverseRotate position");
+
+  // expressions are evaluated
+  const Vector3 rotatedExpression = composition.rotate(Scalar(2)*this->vector);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector3(Scalar(2)*expected.rotate(this->vector)), rotatedExpression, this->tol, this->tol, "rotate expression");
+  const Matrix3X restored = composition.inverseRotate(composition.rotate(batch.leftCols(10)));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3X(batch.leftCols(10)), restored, this->tol, this->tol, "inverseRotate expression");
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+namespace {
+
+// Evaluated by the compiler, e.g. the mounting of a sensor yawed by 90 degrees.
+constexpr rot::RotationQuaternionConstantD mount = rot::RotationQuaternionConstantD::fromEulerAnglesZyx(M_PI/2.0, 0.0, 0.0);
+constexpr rot::RotationMatrixConstantD mountMatrix = mount.toRotationMatrix();
+static_assert(mountMatrix(0, 1) < -1.0 + 1e-12 && mountMatrix(1, 0) > 1.0 - 1e-12, "yaw of 90 degrees maps x to y");
+static_assert(mountMatrix(2, 2) > 1.0 - 1e-12, "yaw keeps the z-axis");
+static_assert((mount*mount.inverted()).w() > 1.0 - 1e-12, "concatenation with the inverse is the identity");
+static_assert((mountMatrix*mountMatrix.inverted())(1, 1) > 1.0 - 1e-12, "concatenation with the inverse is the identity");
+static_assert(mountMatrix.toRotationQuaternion().w() > 0.0, "unique quaternion");
+
+} // namespace
+
+template <typename PrimType_>
+class RotationConstantsTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+};
+
+typedef ::testing::Types<double, float> PrimTypes;
+
+TYPED_TEST_CASE(RotationConstantsTest, PrimTypes);
+
+TYPED_TEST(RotationConstantsTest, testConversions)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef rot::RotationQuaternionConstant<Scalar> QuaternionConstant;
+  typedef rot::RotationMatrixConstant<Scalar> MatrixConstant;
+
+  const Scalar angles[][3] = {{0.0, 0.0, 0.0}, {0.8, -0.3, 0.5}, {-2.9, 1.2, 3.0}, {3.1, -0.1, -2.0}, {M_PI/2.0, 0.0, M_PI}};
+  for (const auto& angle : angles) {
+    const rot::EulerAnglesZyx<Scalar> eulerAngles(angle[0], angle[1], angle[2]);
+    const QuaternionConstant quaternion = QuaternionConstant::fromEulerAnglesZyx(angle[0], angle[1], angle[2]);
+    ASSERT_TRUE(quaternion.getRotationQuaternion().isNear(rot::RotationQuaternion<Scalar>(eulerAngles), this->tol));
+    ASSERT_TRUE(quaternion.getRotationMatrix().isNear(rot::RotationMatrix<Scalar>(eulerAngles), this->tol));
+    ASSERT_TRUE(quaternion.getEulerAnglesZyx().isNear(eulerAngles, this->tol));
+
+    // matrix to quaternion covers all branches of Shepperd's method
+    const MatrixConstant matrix = quaternion.toRotationMatrix();
+    ASSERT_TRUE(matrix.getRotationQuaternion().isNear(quaternion.getRotationQuaternion(), this->tol));
+    ASSERT_TRUE(matrix.getEulerAnglesZyx().isNear(eulerAngles, this->tol));
+    ASSERT_TRUE((matrix*matrix.inverted()).getRotationMatrix().isNear(rot::RotationMatrix<Scalar>(), this->tol));
+  }
+
+  const QuaternionConstant angleAxis = QuaternionConstant::fromAngleAxis(0.7, 1.0, -2.0, 2.0);
+  const rot::AngleAxis<Scalar> expected(0.7, Scalar(1.0/3.0), Scalar(-2.0/3.0), Scalar(2.0/3.0));
+  ASSERT_TRUE(angleAxis.getRotationQuaternion().isNear(rot::RotationQuaternion<Scalar>(expected), this->tol));
+
+  const QuaternionConstant a = QuaternionConstant::fromEulerAnglesZyx(0.3, 0.2, -0.4);
+  const QuaternionConstant b = QuaternionConstant::fromAngleAxis(-1.1, 0.0, 1.0, 1.0);
+  ASSERT_TRUE((a*b).getRotationQuaternion().isNear(a.getRotationQuaternion()*b.getRotationQuaternion(), this->tol));
+  ASSERT_TRUE((a.toRotationMatrix()*b.toRotationMatrix()).getRotationMatrix().isNear(a.getRotationMatrix()*b.getRotationMatrix(), this->tol));
+  ASSERT_TRUE(a.inverted().getRotationQuaternion().isNear(a.getRotationQuaternion().inverted(), this->tol));
+}
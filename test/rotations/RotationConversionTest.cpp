@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationConversion.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+class RotationAdapterTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+
+  const double tol = 1.0e-6;
+  const RotationQuaternion rotation = RotationQuaternion(rot::EulerAnglesZyx<Scalar>(0.4, -0.7, 1.9));
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+
+TYPED_TEST_CASE(RotationAdapterTest, PrimTypes);
+
+TYPED_TEST(RotationAdapterTest, testEigenQuaternion)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+
+  const Eigen::Quaternion<Scalar> quaternion = rot::fromKindr<Eigen::Quaternion<Scalar>>(this->rotation);
+  KINDR_ASSERT_DOUBLE_MX_EQ(quaternion.coeffs(), this->rotation.toImplementation().coeffs(), 1e-4, "fromKindr");
+  const RotationQuaternion converted = rot::toKindr(quaternion);
+  ASSERT_TRUE(converted.isNear(this->rotation, this->tol));
+
+  // other parameterizations are converted first
+  Eigen::Quaternion<Scalar> fromMatrix;
+  rot::fromKindr(fromMatrix, rot::RotationMatrix<Scalar>(this->rotation));
+  ASSERT_TRUE(rot::toKindr(fromMatrix).isNear(this->rotation, 1e-4));
+
+  // views share the memory
+  Eigen::Quaternion<Scalar> shared = quaternion;
+  rot::RotationQuaternionMap<Scalar> map = rot::mapAsKindr(shared);
+  ASSERT_TRUE(map.isNear(this->rotation, this->tol));
+  map.invert();
+  ASSERT_TRUE(rot::toKindr(shared).isNear(this->rotation.inverted(), this->tol));
+  const Eigen::Quaternion<Scalar>& constShared = shared;
+  ASSERT_EQ(rot::mapAsKindr(constShared).data(), shared.coeffs().data());
+}
+
+TYPED_TEST(RotationAdapterTest, testEigenMatrixAndAngleAxis)
+{
+  typedef typename TestFixture::Scalar Scalar;
+
+  const Eigen::Matrix<Scalar, 3, 3> matrix = rot::fromKindr<Eigen::Matrix<Scalar, 3, 3>>(this->rotation);
+  KINDR_ASSERT_DOUBLE_MX_EQ(matrix, rot::RotationMatrix<Scalar>(this->rotation).matrix(), 1e-4, "fromKindr");
+  const rot::RotationMatrix<Scalar> rotationMatrix = rot::toKindr(matrix);
+  ASSERT_TRUE(rotationMatrix.isNear(this->rotation, 1e-4));
+
+  const Eigen::AngleAxis<Scalar> angleAxis = rot::fromKindr<Eigen::AngleAxis<Scalar>>(this->rotation);
+  const rot::AngleAxis<Scalar> kindrAngleAxis = rot::toKindr(angleAxis);
+  ASSERT_TRUE(kindrAngleAxis.isNear(this->rotation, 1e-4));
+  ASSERT_NEAR(kindrAngleAxis.angle(), angleAxis.angle(), this->tol);
+}
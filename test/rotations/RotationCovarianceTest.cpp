@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationCovariance.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+typedef Eigen::Matrix<double, 3, 3> Matrix3;
+typedef Eigen::Matrix<double, 3, 6> Matrix36;
+typedef Eigen::Matrix<double, 6, 6> Matrix6;
+typedef Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor> Matrix3X;
+typedef Eigen::Matrix<double, 6, Eigen::Dynamic, Eigen::RowMajor> Matrix6X;
+
+static Matrix3 getRandomCovariance() {
+  const Matrix3 factor = Matrix3::Random();
+  const Matrix3 covariance = factor*factor.transpose() + 0.1*Matrix3::Identity();
+  return 0.5*(covariance + covariance.transpose());
+}
+
+static Matrix6 getBlockDiagonal(const Matrix3& covariance1, const Matrix3& covariance2) {
+  Matrix6 covariance = Matrix6::Zero();
+  covariance.topLeftCorner<3, 3>() = covariance1;
+  covariance.bottomRightCorner<3, 3>() = covariance2;
+  return covariance;
+}
+
+//! Central differences of a function of a 6D perturbation
+template<typename Function_>
+static Matrix36 getNumericalJacobian(const Function_& function) {
+  const double h = 1e-6;
+  typedef Eigen::Matrix<double, 6, 1> Vector6;
+  Matrix36 jacobian;
+  for (int k = 0; k < 6; ++k) {
+    jacobian.col(k) = (function(Vector6(h*Vector6::Unit(k))) - function(Vector6(-h*Vector6::Unit(k))))/(2.0*h);
+  }
+  return jacobian;
+}
+
+template <typename Rotation_>
+class RotationCovarianceTest : public ::testing::Test {
+ public:
+  typedef Rotation_ Rotation;
+
+  Rotation rotation;
+  Rotation otherRotation;
+  Matrix3 covariance;
+  Matrix3 otherCovariance;
+
+  RotationCovarianceTest()
+    : rotation(rot::EulerAnglesZyxD(0.8, -0.3, 0.5)),
+      otherRotation(rot::EulerAnglesZyxD(-1.2, 0.4, 2.1)),
+      covariance(getRandomCovariance()),
+      otherCovariance(getRandomCovariance()) {
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationMatrixD,
+    rot::AngleAxisD,
+    rot::EulerAnglesZyxD
+> Types;
+
+TYPED_TEST_CASE(RotationCovarianceTest, Types);
+
+TYPED_TEST(RotationCovarianceTest, testRotatedAndInverted)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  const Matrix3 rotationMatrix = rot::RotationMatrixD(this->rotation).matrix();
+  const Matrix3 rotated = rot::getRotatedCovariance(this->rotation, this->covariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3(rotationMatrix*this->covariance*rotationMatrix.transpose()), rotated, 1e-12, 1e-12, "rotated");
+  ASSERT_TRUE(rotated == rotated.transpose());
+
+  // (exp(dv)*C)^-1 = exp(J*dv)*C^-1
+  const Matrix36 jacobian = getNumericalJacobian([this](const Eigen::Matrix<double, 6, 1>& d) {
+    return Eigen::Vector3d(Rotation(this->rotation.boxPlus(d.head<3>())).inverted().boxMinus(this->rotation.inverted()));
+  });
+  const Matrix3 inverted = rot::getInvertedCovariance(this->rotation, this->covariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3(jacobian.leftCols<3>()*this->covariance*jacobian.leftCols<3>().transpose()), inverted, 1e-8, 1e-8, "inverted");
+  ASSERT_TRUE(inverted == inverted.transpose());
+}
+
+TYPED_TEST(RotationCovarianceTest, testComposed)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  // exp(dv1)*C1*exp(dv2)*C2 = exp(J*[dv1; dv2])*C1*C2
+  const Rotation composition = this->rotation*this->otherRotation;
+  const Matrix36 jacobian = getNumericalJacobian([&](const Eigen::Matrix<double, 6, 1>& d) {
+    return Eigen::Vector3d(Rotation(this->rotation.boxPlus(d.head<3>())*this->otherRotation.boxPlus(d.tail<3>())).boxMinus(composition));
+  });
+  const Matrix6 jointCovariance = getBlockDiagonal(this->covariance, this->otherCovariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3(jacobian*jointCovariance*jacobian.transpose()),
+                                    rot::getComposedCovariance(this->rotation, this->covariance, this->otherCovariance), 1e-8, 1e-8, "composed");
+}
+
+TYPED_TEST(RotationCovarianceTest, testBoxPlus)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  // the rotation angle of exp(v) is large to test the Jacobian of the exponential map
+  const Eigen::Vector3d vector(0.9, -1.1, 0.4);
+  const Rotation result = this->rotation.boxPlus(vector);
+  const Matrix36 jacobian = getNumericalJacobian([&](const Eigen::Matrix<double, 6, 1>& d) {
+    return Eigen::Vector3d(Rotation(this->rotation.boxPlus(d.head<3>())).boxPlus(Eigen::Vector3d(vector + d.tail<3>())).boxMinus(result));
+  });
+  const Matrix6 jointCovariance = getBlockDiagonal(this->covariance, this->otherCovariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3(jacobian*jointCovariance*jacobian.transpose()),
+                                    rot::getBoxPlusCovariance(this->covariance, vector, this->otherCovariance), 1e-8, 1e-8, "boxPlus");
+}
+
+TYPED_TEST(RotationCovarianceTest, testRotatedVector)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  const Eigen::Vector3d vector(1.5, -0.4, 2.0);
+  const Eigen::Vector3d rotated = this->rotation.rotate(vector);
+  const Matrix36 jacobian = getNumericalJacobian([&](const Eigen::Matrix<double, 6, 1>& d) {
+    return Eigen::Vector3d(Rotation(this->rotation.boxPlus(d.head<3>())).rotate(Eigen::Vector3d(vector + d.tail<3>())) - rotated);
+  });
+  const Matrix6 jointCovariance = getBlockDiagonal(this->covariance, this->otherCovariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3(jacobian*jointCovariance*jacobian.transpose()),
+                                    rot::getRotatedVectorCovariance(this->rotation, this->covariance, vector, this->otherCovariance), 1e-8, 1e-8, "rotated vector");
+}
+
+TYPED_TEST(RotationCovarianceTest, testBatches)
+{
+  // two full chunks of the executor and a remainder
+  const int size = 2*rot::internal::CovarianceBatchGrainSize + 300;
+  const Matrix3X vectors = Matrix3X::Random(3, size);
+  Matrix6X covariances(6, size);
+  for (int i = 0; i < size; ++i) {
+    covariances.col(i) = rot::packCovariance(getRandomCovariance());
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->covariance, rot::unpackCovariance(rot::packCovariance(this->covariance)), 0.0, 0.0, "packing");
+
+  Matrix6X rotatedCovariances(6, size);
+  rot::rotateCovariances(this->rotation, covariances, rotatedCovariances);
+  Matrix3X rotatedVectors(3, size);
+  Matrix6X rotatedVectorCovariances(6, size);
+  rot::rotateVectorsWithCovariance(this->rotation, this->covariance, vectors, covariances, rotatedVectors, rotatedVectorCovariances);
+  for (int i = 0; i < size; ++i) {
+    const Eigen::Vector3d vector = vectors.col(i);
+    const Matrix3 vectorCovariance = rot::unpackCovariance(covariances.col(i));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rot::getRotatedCovariance(this->rotation, vectorCovariance),
+                                      rot::unpackCovariance(rotatedCovariances.col(i)), 1e-12, 1e-12, "rotateCovariances");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotation.rotate(vector), Eigen::Vector3d(rotatedVectors.col(i)), 1e-12, 1e-12, "rotateVectorsWithCovariance");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rot::getRotatedVectorCovariance(this->rotation, this->covariance, vector, vectorCovariance),
+                                      rot::unpackCovariance(rotatedVectorCovariances.col(i)), 1e-12, 1e-12, "rotateVectorsWithCovariance");
+  }
+
+  // the executor only changes how the columns are split
+  Matrix6X threadedCovariances(6, size);
+  rot::rotateCovariances(this->rotation, covariances, threadedCovariances, rot::ThreadPoolExecutor(2));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotatedCovariances, threadedCovariances, 1e-12, 1e-12, "rotateCovariances executor");
+  rot::rotateVectorsWithCovariance(this->rotation, this->covariance, vectors, covariances, rotatedVectors, threadedCovariances, rot::ThreadPoolExecutor(2));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotatedVectorCovariances, threadedCovariances, 1e-12, 1e-12, "executor");
+}
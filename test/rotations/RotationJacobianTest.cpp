@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename Rotation_>
+class RotationJacobianTest : public ::testing::Test {
+ public:
+  typedef Rotation_ Rotation;
+  typedef typename Rotation::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+
+  const Scalar delta = 1.0e-6;
+  const double tol = 1.0e-6;
+
+  const Rotation rotation = Rotation(rot::EulerAnglesZyx<Scalar>(0.3, -0.7, 1.2));
+  const Rotation otherRotation = Rotation(rot::EulerAnglesZyx<Scalar>(-1.1, 0.4, 0.2));
+  const Vector3 vector = Vector3(0.4, -1.3, 0.8);
+
+  //! Central differences of a function of a perturbation vector
+  template <typename Function_>
+  Matrix3 getNumericalJacobian(const Function_& function) const {
+    Matrix3 jacobian;
+    for (int i = 0; i < 3; ++i) {
+      const Vector3 perturbation = delta*Vector3::Unit(i);
+      jacobian.col(i) = (function(perturbation) - function(-perturbation))/(Scalar(2)*delta);
+    }
+    return jacobian;
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionPD,
+    rot::RotationMatrixPD,
+    rot::AngleAxisPD,
+    rot::RotationVectorPD,
+    rot::EulerAnglesZyxPD,
+    rot::EulerAnglesXyzPD
+> Rotations;
+
+TYPED_TEST_CASE(RotationJacobianTest, Rotations);
+
+TYPED_TEST(RotationJacobianTest, testExponentialAndLogarithmicMap) {
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Scalar Scalar;
+  const Vector3 smallVector = Scalar(1.0e-5)*this->vector;
+  for (const Vector3& vector : {this->vector, smallVector}) {
+    const typename TestFixture::Rotation expOfVector = typename TestFixture::Rotation().exponentialMap(vector);
+    const Matrix3 numericalLeft = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3(typename TestFixture::Rotation().exponentialMap(Vector3(vector + dv)).boxMinus(expOfVector)); });
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalLeft, rot::getJacobianOfExponentialMap(vector), this->tol, this->tol, "left Jacobian of exponential map");
+    const Matrix3 numericalRight = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3((expOfVector.inverted()*typename TestFixture::Rotation().exponentialMap(Vector3(vector + dv))).logarithmicMap()); });
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalRight, rot::getRightJacobianOfExponentialMap(vector), this->tol, this->tol, "right Jacobian of exponential map");
+
+    const Matrix3 numericalLog = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3(expOfVector.boxPlus(dv).logarithmicMap()); });
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalLog, rot::getJacobianOfLogarithmicMap(vector), this->tol, this->tol, "left Jacobian of logarithmic map");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalLog, expOfVector.getJacobianOfLogarithmicMap(), this->tol, this->tol, "Jacobian of logarithmic map");
+    const Matrix3 numericalLogRight = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3((expOfVector*typename TestFixture::Rotation().exponentialMap(dv)).logarithmicMap()); });
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalLogRight, rot::getRightJacobianOfLogarithmicMap(vector), this->tol, this->tol, "right Jacobian of logarithmic map");
+
+    const Matrix3 identity = rot::getJacobianOfExponentialMap(vector)*rot::getJacobianOfLogarithmicMap(vector);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Matrix3::Identity(), identity, this->tol, this->tol, "inverse");
+  }
+}
+
+TYPED_TEST(RotationJacobianTest, testRotate) {
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  const Matrix3 numerical = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3(this->rotation.boxPlus(dv).rotate(this->vector)); });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numerical, this->rotation.getJacobianOfRotate(this->vector), this->tol, this->tol, "rotate");
+  const Matrix3 numericalInverse = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3(this->rotation.boxPlus(dv).inverseRotate(this->vector)); });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalInverse, this->rotation.getJacobianOfInverseRotate(this->vector), this->tol, this->tol, "inverse rotate");
+}
+
+TYPED_TEST(RotationJacobianTest, testMultiplication) {
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  const typename TestFixture::Rotation product = this->rotation*this->otherRotation;
+  const Matrix3 numericalLeft = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3((this->rotation.boxPlus(dv)*this->otherRotation).boxMinus(product)); });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalLeft, this->rotation.getJacobianOfMultiplicationWrtLeft(), this->tol, this->tol, "left-hand side");
+  const Matrix3 numericalRight = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3((this->rotation*this->otherRotation.boxPlus(dv)).boxMinus(product)); });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalRight, this->rotation.getJacobianOfMultiplicationWrtRight(), this->tol, this->tol, "right-hand side");
+}
+
+TYPED_TEST(RotationJacobianTest, testBoxOperations) {
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  const typename TestFixture::Rotation boxPlus = this->rotation.boxPlus(this->vector);
+  const Matrix3 numericalPlusVector = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3(this->rotation.boxPlus(Vector3(this->vector + dv)).boxMinus(boxPlus)); });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalPlusVector, this->rotation.getJacobianOfBoxPlusWrtVector(this->vector), this->tol, this->tol, "box plus wrt vector");
+  const Matrix3 numericalPlusRotation = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3(this->rotation.boxPlus(dv).boxPlus(this->vector).boxMinus(boxPlus)); });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalPlusRotation, this->rotation.getJacobianOfBoxPlusWrtRotation(this->vector), this->tol, this->tol, "box plus wrt rotation");
+
+  const Matrix3 numericalMinusLeft = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3(this->rotation.boxPlus(dv).boxMinus(this->otherRotation)); });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalMinusLeft, this->rotation.getJacobianOfBoxMinusWrtLeft(this->otherRotation), this->tol, this->tol, "box minus wrt left");
+  const Matrix3 numericalMinusRight = this->getNumericalJacobian([&](const Vector3& dv) { return Vector3(this->rotation.boxMinus(this->otherRotation.boxPlus(dv))); });
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalMinusRight, this->rotation.getJacobianOfBoxMinusWrtRight(this->otherRotation), this->tol, this->tol, "box minus wrt right");
+}
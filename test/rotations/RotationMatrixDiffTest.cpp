@@ -260,3 +260,26 @@ TYPED_TEST(RotationMatrixDiffTest, testFiniteDifferenceInverse)
 }
 
 
+
+TYPED_TEST(RotationMatrixDiffTest, testConversionsAgreeWithSkewMatrices)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationDiff RotationDiff;
+  typedef typename TestFixture::RotationDiff::Matrix3x3 Matrix3;
+  typedef typename TestFixture::LocalAngularVelocity LocalAngularVelocity;
+  typedef rot::GlobalAngularVelocity<Scalar> GlobalAngularVelocity;
+
+  for (auto& rotation : this->rotations) {
+    for (auto& angularVelocity : this->angularVelocities) {
+      const Matrix3 skew = kindr::getSkewMatrixFromVector(angularVelocity.vector());
+      const RotationDiff localDiff(rotation, angularVelocity);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(localDiff.matrix(), Matrix3(rotation.matrix()*skew), 1e-5, 0, "local");
+      const GlobalAngularVelocity globalAngularVelocity(angularVelocity.vector());
+      const RotationDiff globalDiff(rotation, globalAngularVelocity);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(globalDiff.matrix(), Matrix3(skew*rotation.matrix()), 1e-5, 0, "global");
+
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(LocalAngularVelocity(rotation, localDiff).vector(), angularVelocity.vector(), 1e-5, 0, "local inverse");
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(GlobalAngularVelocity(rotation, globalDiff).vector(), angularVelocity.vector(), 1e-5, 0, "global inverse");
+    }
+  }
+}
@@ -900,3 +900,33 @@ TYPED_TEST(RotationMatrixRotationQuaternionPairTest, testInversion){
 
 
 
+
+// Test the direct disparity angle and the threshold-only comparison
+TYPED_TEST(RotationMatrixSingleTest, testDisparityAngle){
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector Vector;
+  typedef rot::AngleAxis<Scalar> AngleAxis;
+
+  const Scalar reference = std::abs(floatingPointModulo(AngleAxis(this->rotRotationMatrix1*this->rotRotationMatrix2.inverted()).angle() + Scalar(M_PI), Scalar(2.0*M_PI))-Scalar(M_PI));
+  ASSERT_NEAR(this->rotRotationMatrix1.getDisparityAngle(this->rotRotationMatrix2), reference, 1e-4);
+  ASSERT_NEAR(this->rotRotationMatrix1.getDisparityAngle(this->rotRotationMatrix1), 0.0, 1e-3);
+  ASSERT_NEAR(this->rotRotationMatrixIdentity.getDisparityAngle(this->rotRotationMatrixQuarterZ), M_PI/2.0, 1e-5);
+
+  const RotationMatrix rotSmall = this->rotRotationMatrixIdentity.boxPlus(Vector(Scalar(0), Scalar(1e-3), Scalar(0)));
+  ASSERT_NEAR(rotSmall.getDisparityAngle(this->rotRotationMatrixIdentity), 1e-3, 1e-5);
+  ASSERT_TRUE(rotSmall.isNear(this->rotRotationMatrixIdentity, Scalar(2e-3)));
+  ASSERT_FALSE(rotSmall.isNear(this->rotRotationMatrixIdentity, Scalar(0.5e-3)));
+
+  ASSERT_TRUE(this->rotRotationMatrixIdentity.isNear(this->rotRotationMatrixQuarterZ, Scalar(M_PI/2.0 + 1e-3)));
+  ASSERT_FALSE(this->rotRotationMatrixIdentity.isNear(this->rotRotationMatrixQuarterZ, Scalar(M_PI/2.0 - 1e-3)));
+  ASSERT_FALSE(this->rotRotationMatrix1.isNear(this->rotRotationMatrix1, Scalar(-1)));
+
+  // comparator with the precomputed bound
+  const rot::RotationNearness<RotationMatrix> isNear(Scalar(2e-3));
+  ASSERT_TRUE(isNear(rotSmall, this->rotRotationMatrixIdentity));
+  ASSERT_FALSE(isNear(this->rotRotationMatrixIdentity, this->rotRotationMatrixQuarterZ));
+  ASSERT_TRUE((rot::RotationNearness<RotationMatrix, rot::RotationQuaternion<Scalar>>(Scalar(2e-3))(rotSmall, rot::RotationQuaternion<Scalar>())));
+  ASSERT_TRUE(rot::RotationNearness<RotationMatrix>(Scalar(M_PI))(this->rotRotationMatrix1, this->rotRotationMatrix2));
+  ASSERT_FALSE(rot::RotationNearness<RotationMatrix>(Scalar(-1))(this->rotRotationMatrix1, this->rotRotationMatrix1));
+}
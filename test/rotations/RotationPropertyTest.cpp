@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/rotations/RotationBatchConversion.hpp"
+#include "RotationPropertyTest.hpp"
+
+namespace rot = kindr;
+
+/* Randomized property tests of the conversions and operators of all parameterizations against the quaternion path of
+ * Eigen, and of the batch conversions against the conversions of single rotations, see RotationPropertyTest.hpp.
+ */
+
+template <typename Rotation_>
+class RotationPropertyTest : public ::testing::Test {
+ public:
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef rot::RotationMatrix<Scalar> RotationMatrix;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef kindr_property::RotationCaseGenerator<Scalar> Generator;
+  typedef kindr_property::RotationSample<Scalar> Sample;
+
+  static constexpr bool IsEulerAngles = std::is_same<Rotation_, rot::EulerAnglesZyx<Scalar>>::value || std::is_same<Rotation_, rot::EulerAnglesXyz<Scalar>>::value;
+
+  // the Euler angles lose half of the digits at the gimbal lock
+  const double tol = (IsEulerAngles ? 10.0*std::sqrt(double(std::numeric_limits<Scalar>::epsilon())) : 100.0*std::numeric_limits<Scalar>::epsilon());
+  // getUnique() of Euler angles sets the third angle to zero within 1e-3 of the gimbal lock
+  const double uniqueTol = (IsEulerAngles ? 2e-3 : tol);
+
+  rot::ThreadPoolExecutor executor;
+
+  RotationPropertyTest()
+    : executor(kindr_property::getNumThreads()) {
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationMatrixD,
+    rot::AngleAxisD,
+    rot::RotationVectorD,
+    rot::EulerAnglesZyxD,
+    rot::EulerAnglesXyzD,
+    rot::RotationQuaternionF,
+    rot::RotationMatrixF,
+    rot::EulerAnglesZyxF
+> Types;
+
+TYPED_TEST_CASE(RotationPropertyTest, Types);
+
+TYPED_TEST(RotationPropertyTest, testOperators)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Generator Generator;
+  typedef typename TestFixture::Sample Sample;
+  using kindr_property::getDistance;
+
+  const double tol = this->tol;
+  const double uniqueTol = this->uniqueTol;
+  const kindr_property::PropertyReport report = kindr_property::checkProperties<typename TestFixture::Scalar>(
+      kindr_property::getNumSamples(), [tol, uniqueTol](Generator& generator, int numSamples, kindr_property::PropertyReport& report) {
+    for (int i = 0; i < numSamples; ++i) {
+      const Sample sample = generator.sample();
+      const Sample other = generator.sample();
+      const Vector3 vector = generator.sampleVector();
+      const auto describe = [&]() { return kindr_property::describe(sample) + " and " + kindr_property::describe(other); };
+      const RotationQuaternion& quaternion = sample.rotation;
+      const Rotation rotation(quaternion);
+      const Rotation otherRotation(other.rotation);
+
+      report.check("roundTrip", getDistance(RotationQuaternion(rotation), quaternion), tol, describe);
+      report.check("unique", getDistance(RotationQuaternion(rotation.getUnique()), quaternion), uniqueTol, describe);
+      report.check("matrix", getDistance(Matrix3(typename TestFixture::RotationMatrix(rotation).matrix()), Matrix3(quaternion.toImplementation().toRotationMatrix())), tol, describe);
+      report.check("rotate", getDistance(Vector3(rotation.rotate(vector)), Vector3(quaternion.toImplementation()*vector)), tol, describe);
+      report.check("inverseRotate", getDistance(Vector3(rotation.inverseRotate(vector)), Vector3(quaternion.toImplementation().conjugate()*vector)), tol, describe);
+      report.check("prepared", getDistance(Vector3(rotation.prepared().rotate(vector)), Vector3(quaternion.toImplementation()*vector)), tol, describe);
+      report.check("inverted", getDistance(RotationQuaternion(rotation.inverted()), RotationQuaternion(quaternion.toImplementation().conjugate())), tol, describe);
+      const RotationQuaternion product(quaternion.toImplementation()*other.rotation.toImplementation());
+      report.check("concatenate", getDistance(RotationQuaternion(rotation*otherRotation), product), tol, describe);
+      report.check("concatenateMixed", getDistance(RotationQuaternion(rotation*other.rotation), product), tol, describe);
+      report.check("boxPlusMinus", getDistance(RotationQuaternion(rotation.boxPlus(otherRotation.boxMinus(rotation))), other.rotation), tol, describe);
+      report.check("disparityAngle", rotation.getDisparityAngle(quaternion), 2.0*tol, describe);
+      report.check("isNear", rotation.isNear(quaternion, 2.0*tol) ? 0.0 : 1.0, 0.0, describe);
+    }
+  }, this->executor, kindr_property::getSeed());
+  report.record();
+  EXPECT_TRUE(report.isSuccess());
+}
+
+TYPED_TEST(RotationPropertyTest, testBatchConversion)
+{
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+  typedef typename TestFixture::Generator Generator;
+  typedef rot::internal::RotationArrayTraits<Rotation> Traits;
+  typedef rot::internal::RotationArrayTraits<RotationQuaternion> QuaternionTraits;
+  typedef rot::internal::RotationArrayTraits<RotationMatrix> MatrixTraits;
+  using kindr_property::getDistance;
+
+  const double tol = this->tol;
+  const kindr_property::PropertyReport report = kindr_property::checkProperties<typename TestFixture::Scalar>(
+      kindr_property::getNumSamples(), [tol](Generator& generator, int numSamples, kindr_property::PropertyReport& report) {
+    std::vector<kindr_property::RotationSample<typename TestFixture::Scalar>> samples;
+    typename QuaternionTraits::Matrix quaternions(static_cast<int>(QuaternionTraits::Rows), numSamples);
+    typename MatrixTraits::Matrix matrices(static_cast<int>(MatrixTraits::Rows), numSamples);
+    std::vector<RotationQuaternion> quaternionVector;
+    for (int i = 0; i < numSamples; ++i) {
+      samples.push_back(generator.sample());
+      quaternionVector.push_back(samples.back().rotation);
+      QuaternionTraits::set(quaternions, i, samples.back().rotation);
+      MatrixTraits::set(matrices, i, RotationMatrix(samples.back().rotation));
+    }
+
+    // structure of arrays from quaternions and matrices and back
+    typename Traits::Matrix fromQuaternions(static_cast<int>(Traits::Rows), numSamples);
+    typename Traits::Matrix fromMatrices(static_cast<int>(Traits::Rows), numSamples);
+    typename QuaternionTraits::Matrix backToQuaternions(static_cast<int>(QuaternionTraits::Rows), numSamples);
+    typename MatrixTraits::Matrix backToMatrices(static_cast<int>(MatrixTraits::Rows), numSamples);
+    rot::convert<Rotation, RotationQuaternion>(quaternions, fromQuaternions);
+    rot::convert<Rotation, RotationMatrix>(matrices, fromMatrices);
+    rot::convert<RotationQuaternion, Rotation>(fromQuaternions, backToQuaternions);
+    rot::convert<RotationMatrix, Rotation>(fromQuaternions, backToMatrices);
+
+    // array of structures
+    std::vector<Rotation> rotations;
+    rot::convert(quaternionVector, rotations);
+
+    for (int i = 0; i < numSamples; ++i) {
+      const auto describe = [&]() { return kindr_property::describe(samples[i]); };
+      const RotationQuaternion& quaternion = samples[i].rotation;
+      const Rotation reference(quaternion);
+      const Rotation batchRotation = Traits::get(fromQuaternions, i);
+      report.check("fromQuaternions", getDistance(RotationQuaternion(batchRotation), RotationQuaternion(reference)), tol, describe);
+      report.check("fromMatrices", getDistance(RotationQuaternion(Traits::get(fromMatrices, i)), RotationQuaternion(Rotation(RotationMatrix(quaternion)))), tol, describe);
+      report.check("toQuaternions", getDistance(QuaternionTraits::get(backToQuaternions, i), RotationQuaternion(batchRotation)), tol, describe);
+      report.check("toMatrices", getDistance(RotationQuaternion(MatrixTraits::get(backToMatrices, i)), RotationQuaternion(RotationMatrix(batchRotation))), tol, describe);
+      report.check("arrayOfStructures", getDistance(RotationQuaternion(rotations[i]), RotationQuaternion(reference)), tol, describe);
+    }
+  }, this->executor, kindr_property::getSeed());
+  report.record();
+  EXPECT_TRUE(report.isSuccess());
+}
+
+TEST(RotationPropertyHarnessTest, testDeterministic)
+{
+  // the samples only depend on the seed and the block, not on the executor
+  const auto properties = [](kindr_property::RotationCaseGenerator<double>& generator, int numSamples, kindr_property::PropertyReport& report) {
+    for (int i = 0; i < numSamples; ++i) {
+      const kindr_property::RotationSample<double> sample = generator.sample();
+      report.check("w", sample.rotation.w(), 2.0, []() { return std::string(); });
+      report.check("norm", std::abs(sample.rotation.vector().norm() - 1.0), 1e-12, []() { return std::string(); });
+    }
+  };
+  const kindr_property::PropertyReport serial = kindr_property::checkProperties<double>(5000, properties, rot::SerialExecutor(), 3u, 100);
+  const kindr_property::PropertyReport parallel = kindr_property::checkProperties<double>(5000, properties, rot::ThreadPoolExecutor(4), 3u, 100);
+  ASSERT_EQ(5000, serial.getNumSamples());
+  ASSERT_EQ(5000, parallel.getNumSamples());
+  ASSERT_EQ(2u, serial.getStatistics().size());
+  ASSERT_EQ(5000, serial.getStatistics()[0].numChecks);
+  ASSERT_EQ(serial.getStatistics()[0].maxError, parallel.getStatistics()[0].maxError);
+  ASSERT_TRUE(serial.isSuccess());
+
+  // failures are counted and described
+  const kindr_property::PropertyReport failing = kindr_property::checkProperties<double>(300, [](kindr_property::RotationCaseGenerator<double>& generator, int numSamples, kindr_property::PropertyReport& report) {
+    for (int i = 0; i < numSamples; ++i) {
+      const kindr_property::RotationSample<double> sample = generator.sample();
+      report.check("identity", kindr_property::getDistance(sample.rotation, kindr::RotationQuaternionD()), 0.5, [&]() { return kindr_property::describe(sample); });
+    }
+  }, rot::SerialExecutor());
+  ASSERT_FALSE(failing.isSuccess());
+  ASSERT_GT(failing.getStatistics()[0].numFailures, 0);
+  ASSERT_LT(failing.getStatistics()[0].numFailures, 300);
+  ASSERT_FALSE(failing.getStatistics()[0].firstFailure.empty());
+}
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/rotations/RotationSampling.hpp"
+
+/* Harness of the randomized property tests, which check conversions and operators of the rotations against a
+ * reference path on many random rotations. The rotations are drawn from a mix of cases, which includes the
+ * singularities of the parameterizations. The samples are split into blocks, and each block draws from its own
+ * random stream, such that the samples do not depend on the executor. The environment variables
+ * KINDR_PROPERTY_SAMPLES, KINDR_PROPERTY_THREADS and KINDR_PROPERTY_SEED set the number of samples, the number of
+ * threads and the seed, e.g. KINDR_PROPERTY_SAMPLES=10000000 for a run at scale.
+ */
+
+namespace kindr_property {
+
+//! Gets an integer from the environment variable name, or the default value if it is not set.
+inline long long getEnvironmentVariable(const char* name, long long defaultValue) {
+  const char* value = std::getenv(name);
+  return value == nullptr ? defaultValue : std::atoll(value);
+}
+
+//! \returns the number of samples of each property test
+inline long long getNumSamples() {
+  return std::max(1ll, getEnvironmentVariable("KINDR_PROPERTY_SAMPLES", 12000));
+}
+
+//! \returns the number of threads, 0 for the number of hardware threads
+inline int getNumThreads() {
+  return static_cast<int>(getEnvironmentVariable("KINDR_PROPERTY_THREADS", 0));
+}
+
+//! \returns the seed of the random streams
+inline unsigned int getSeed() {
+  return static_cast<unsigned int>(getEnvironmentVariable("KINDR_PROPERTY_SEED", 0));
+}
+
+//! Cases from which the random rotations are drawn in turn.
+enum class RotationCase {
+  Uniform,        //!< uniform on SO(3)
+  NearIdentity,   //!< angle in [0, 0.1] on a logarithmic scale
+  NearPi,         //!< angle in [pi - 0.1, pi] on a logarithmic scale
+  GimbalLockZyx,  //!< Euler angles z-y-x with the pitch close to +-pi/2
+  GimbalLockXyz,  //!< Euler angles x-y-z with the pitch close to +-pi/2
+  AxisAligned,    //!< Euler angles z-y-x which are multiples of pi/2
+  NumCases
+};
+
+inline const char* getName(RotationCase rotationCase) {
+  static const char* names[] = {"Uniform", "NearIdentity", "NearPi", "GimbalLockZyx", "GimbalLockXyz", "AxisAligned"};
+  return names[static_cast<int>(rotationCase)];
+}
+
+//! Random rotation with the case it was drawn from.
+template<typename PrimType_>
+struct RotationSample {
+  kindr::RotationQuaternion<PrimType_> rotation;
+  RotationCase rotationCase;
+};
+
+/*! \brief Draws the rotations of the property tests from the cases in turn.
+ *  The distance to a singularity is 10^-k with k uniform in [1, kMax], where 10^-kMax is about the square root of the
+ *  machine epsilon, and is zero for one sample in eight.
+ */
+template<typename PrimType_>
+class RotationCaseGenerator {
+ public:
+  typedef PrimType_ Scalar;
+  typedef kindr::RotationQuaternion<PrimType_> RotationQuaternion;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  RotationCaseGenerator(unsigned int seed, unsigned int stream)
+    : sampler_(seed, stream),
+      uniform_(0.0, 1.0),
+      nextCase_(stream % static_cast<int>(RotationCase::NumCases)) {
+  }
+
+  //! \returns the next random rotation
+  RotationSample<PrimType_> sample() {
+    const RotationCase rotationCase = static_cast<RotationCase>(nextCase_);
+    nextCase_ = (nextCase_ + 1) % static_cast<int>(RotationCase::NumCases);
+    return RotationSample<PrimType_>{sample(rotationCase), rotationCase};
+  }
+
+  //! \returns a random rotation of the case
+  RotationQuaternion sample(RotationCase rotationCase) {
+    const double halfPi = 0.5*M_PI;
+    switch (rotationCase) {
+      case RotationCase::NearIdentity:
+        return RotationQuaternion(kindr::AngleAxis<PrimType_>(Scalar(getDistance()), sampleAxis()));
+      case RotationCase::NearPi:
+        return RotationQuaternion(kindr::AngleAxis<PrimType_>(Scalar(M_PI - getDistance()), sampleAxis()));
+      case RotationCase::GimbalLockZyx:
+        return RotationQuaternion(kindr::EulerAnglesZyx<PrimType_>(sampleAngle(), getPitchNearGimbalLock(), sampleAngle()));
+      case RotationCase::GimbalLockXyz:
+        return RotationQuaternion(kindr::EulerAnglesXyz<PrimType_>(sampleAngle(), getPitchNearGimbalLock(), sampleAngle()));
+      case RotationCase::AxisAligned:
+        return RotationQuaternion(kindr::EulerAnglesZyx<PrimType_>(Scalar(halfPi*sampleInteger(4)), Scalar(halfPi*(sampleInteger(3) - 1)),
+                                                                   Scalar(halfPi*sampleInteger(4))));
+      default:
+        return sampler_.sampleUniform();
+    }
+  }
+
+  //! \returns a vector with standard normal components
+  Vector3 sampleVector() {
+    return sampler_.samplePerturbation(Vector3::Ones());
+  }
+
+ private:
+  Vector3 sampleAxis() {
+    Vector3 axis = sampleVector();
+    while (axis.norm() < Scalar(1e-3)) {
+      axis = sampleVector();
+    }
+    return axis.normalized();
+  }
+
+  Scalar sampleAngle() {
+    return Scalar(M_PI*(2.0*uniform_(sampler_.getEngine()) - 1.0));
+  }
+
+  int sampleInteger(int size) {
+    return std::min(size - 1, static_cast<int>(size*uniform_(sampler_.getEngine())));
+  }
+
+  double getDistance() {
+    const double maxExponent = -0.5*std::log10(std::numeric_limits<PrimType_>::epsilon());
+    const double u = uniform_(sampler_.getEngine());
+    return u < 0.125 ? 0.0 : std::pow(10.0, -1.0 - (maxExponent - 1.0)*(u - 0.125)/0.875);
+  }
+
+  Scalar getPitchNearGimbalLock() {
+    // both signs of the distance to cross the singularity
+    const double sign = uniform_(sampler_.getEngine()) < 0.5 ? -1.0 : 1.0;
+    const double distance = (uniform_(sampler_.getEngine()) < 0.5 ? -1.0 : 1.0)*getDistance();
+    return Scalar(sign*(0.5*M_PI - distance));
+  }
+
+  kindr::RotationSampler<PrimType_> sampler_;
+  std::uniform_real_distribution<double> uniform_;
+  int nextCase_;
+};
+
+//! \returns the distance of two unit quaternions up to the sign, about half the angle between the rotations
+template<typename PrimType_>
+inline double getDistance(const kindr::RotationQuaternion<PrimType_>& rotation, const kindr::RotationQuaternion<PrimType_>& reference) {
+  const Eigen::Matrix<PrimType_, 4, 1> a = rotation.vector();
+  const Eigen::Matrix<PrimType_, 4, 1> b = reference.vector();
+  return std::min((a - b).template cast<double>().norm(), (a + b).template cast<double>().norm());
+}
+
+//! \returns the distance of two vectors relative to the norm of the reference
+template<typename Vector_>
+inline double getDistance(const Eigen::MatrixBase<Vector_>& vector, const Eigen::MatrixBase<Vector_>& reference) {
+  return (vector - reference).template cast<double>().norm()/std::max(1.0, static_cast<double>(reference.norm()));
+}
+
+//! Statistics of one property.
+struct PropertyStatistics {
+  const char* name;
+  long long numChecks;
+  long long numFailures;
+  double maxError;
+  std::string firstFailure;
+};
+
+/*! \brief Collects the errors of the properties of a block of samples or of a whole run.
+ *  A check fails if the error exceeds the tolerance or is not a number. Only the first failure of a property is
+ *  described, the description is built lazily.
+ */
+class PropertyReport {
+ public:
+  PropertyReport()
+    : numSamples_(0),
+      seconds_(0.0) {
+  }
+
+  /*! \brief Checks the error of a property.
+   *  \param name       name of the property, a string literal
+   *  \param error      error of the property
+   *  \param tolerance  maximum error
+   *  \param describe   callable returning a description of the sample, called on the first failure
+   */
+  template<typename Describe_>
+  void check(const char* name, double error, double tolerance, const Describe_& describe) {
+    PropertyStatistics& statistics = getStatistics(name);
+    ++statistics.numChecks;
+    statistics.maxError = std::max(statistics.maxError, error);
+    if (!(error <= tolerance)) {
+      if (statistics.numFailures++ == 0) {
+        std::stringstream stream;
+        stream << "error " << error << " > " << tolerance << " for " << describe();
+        statistics.firstFailure = stream.str();
+      }
+    }
+  }
+
+  //! Adds the statistics of another report, e.g. of the next block.
+  void merge(const PropertyReport& other) {
+    numSamples_ += other.numSamples_;
+    for (const PropertyStatistics& otherStatistics : other.statistics_) {
+      PropertyStatistics& statistics = getStatistics(otherStatistics.name);
+      statistics.numChecks += otherStatistics.numChecks;
+      statistics.maxError = std::max(statistics.maxError, otherStatistics.maxError);
+      if (statistics.numFailures == 0) {
+        statistics.firstFailure = otherStatistics.firstFailure;
+      }
+      statistics.numFailures += otherStatistics.numFailures;
+    }
+  }
+
+  inline void addSamples(long long numSamples) {
+    numSamples_ += numSamples;
+  }
+
+  inline void setSeconds(double seconds) {
+    seconds_ = seconds;
+  }
+
+  inline long long getNumSamples() const {
+    return numSamples_;
+  }
+
+  inline double getSamplesPerSecond() const {
+    return seconds_ > 0.0 ? numSamples_/seconds_ : 0.0;
+  }
+
+  inline const std::vector<PropertyStatistics>& getStatistics() const {
+    return statistics_;
+  }
+
+  //! \returns success if no check failed, otherwise the first failure of each failed property
+  ::testing::AssertionResult isSuccess() const {
+    std::stringstream stream;
+    bool success = true;
+    for (const PropertyStatistics& statistics : statistics_) {
+      if (statistics.numFailures > 0) {
+        success = false;
+        stream << "\n" << statistics.name << ": " << statistics.numFailures << " of " << statistics.numChecks
+               << " checks failed, max error " << statistics.maxError << ", first: " << statistics.firstFailure;
+      }
+    }
+    return success ? ::testing::AssertionSuccess() : (::testing::AssertionFailure() << stream.str());
+  }
+
+  /*! \brief Records the throughput and the maximum errors as properties of the test in the XML output of gtest.
+   */
+  void record() const {
+    ::testing::Test::RecordProperty("samples", std::to_string(numSamples_));
+    ::testing::Test::RecordProperty("seconds", std::to_string(seconds_));
+    ::testing::Test::RecordProperty("samplesPerSecond", std::to_string(getSamplesPerSecond()));
+    for (const PropertyStatistics& statistics : statistics_) {
+      std::stringstream maxError;
+      maxError << statistics.maxError;
+      ::testing::Test::RecordProperty(std::string(statistics.name) + "MaxError", maxError.str());
+    }
+  }
+
+ private:
+  PropertyStatistics& getStatistics(const char* name) {
+    for (PropertyStatistics& statistics : statistics_) {
+      if (statistics.name == name || std::strcmp(statistics.name, name) == 0) {
+        return statistics;
+      }
+    }
+    statistics_.push_back(PropertyStatistics{name, 0, 0, 0.0, std::string()});
+    return statistics_.back();
+  }
+
+  std::vector<PropertyStatistics> statistics_;
+  long long numSamples_;
+  double seconds_;
+};
+
+/*! \brief Checks properties on random samples in parallel.
+ *  The samples are split into blocks of blockSize samples, and block b draws from the stream b of the seed. The
+ *  properties are called once per block as properties(generator, numSamples, report) and check their errors in the
+ *  report of the block. The reports of the blocks are merged in order.
+ *  \param numSamples   number of samples
+ *  \param properties   callable checking the properties of the samples of a block
+ *  \param executor     executor on which the blocks are split, see Executor.hpp
+ *  \param seed         seed of the random streams
+ *  \param blockSize    number of samples per block
+ *  \returns the merged report with the throughput
+ */
+template<typename PrimType_, typename Properties_, typename Executor_>
+PropertyReport checkProperties(long long numSamples, const Properties_& properties, const Executor_& executor,
+                               unsigned int seed = 0u, int blockSize = 1024) {
+  const int numBlocks = static_cast<int>((numSamples + blockSize - 1)/blockSize);
+  std::vector<PropertyReport> reports(numBlocks);
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  executor.parallelFor(0, numBlocks, 1, [&](int begin, int end) {
+    for (int block = begin; block < end; ++block) {
+      const int size = static_cast<int>(std::min<long long>(blockSize, numSamples - static_cast<long long>(block)*blockSize));
+      RotationCaseGenerator<PrimType_> generator(seed, static_cast<unsigned int>(block));
+      properties(generator, size, reports[block]);
+      reports[block].addSamples(size);
+    }
+  });
+  PropertyReport report;
+  for (const PropertyReport& blockReport : reports) {
+    report.merge(blockReport);
+  }
+  report.setSeconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  return report;
+}
+
+//! \returns a description of a sample for the failures
+template<typename PrimType_>
+inline std::string describe(const RotationSample<PrimType_>& sample) {
+  std::stringstream stream;
+  stream.precision(std::numeric_limits<PrimType_>::max_digits10);
+  stream << getName(sample.rotationCase) << " rotation " << sample.rotation;
+  return stream.str();
+}
+
+} // namespace kindr_property
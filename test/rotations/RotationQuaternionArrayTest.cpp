@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationQuaternionArray.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+class RotationQuaternionArrayTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef rot::RotationQuaternionArray<Scalar> RotationQuaternionArray;
+  typedef rot::PositionArray<Scalar> PositionArray;
+  typedef kindr::Position<Scalar, 3> Position;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const int size = 37;
+  const double tol = 1.0e-4;
+
+  RotationQuaternionArray rotations;
+  RotationQuaternionArray otherRotations;
+  std::vector<RotationQuaternion> rotationVector;
+  std::vector<RotationQuaternion> otherRotationVector;
+  PositionArray positions;
+
+  RotationQuaternionArrayTest() {
+    for (int i = 0; i < size; ++i) {
+      // cover the identity, small angles, generic angles and quaternions with negative real part
+      const Scalar scale = (i == 0) ? Scalar(0) : ((i < 4) ? Scalar(1.0e-5) : Scalar(1.0));
+      rotationVector.push_back(RotationQuaternion(rot::RotationVector<Scalar>(scale*Vector3::Random()*Scalar(3.0))));
+      otherRotationVector.push_back(RotationQuaternion(rot::RotationVector<Scalar>(Vector3::Random()*Scalar(3.0))));
+      if (i % 2 == 1) {
+        otherRotationVector.back().toImplementation().coeffs() *= Scalar(-1);
+      }
+    }
+    rotations = RotationQuaternionArray(rotationVector);
+    otherRotations = RotationQuaternionArray(otherRotationVector);
+    positions = PositionArray(Eigen::Matrix<Scalar, 3, Eigen::Dynamic>::Random(3, size));
+  }
+};
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+TYPED_TEST_CASE(RotationQuaternionArrayTest, PrimTypes);
+
+TYPED_TEST(RotationQuaternionArrayTest, testConstructors) {
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+
+  ASSERT_EQ(0, RotationQuaternionArray().size());
+
+  const RotationQuaternionArray identity = RotationQuaternionArray::Identity(5);
+  ASSERT_EQ(5, identity.size());
+  for (int i = 0; i < identity.size(); ++i) {
+    ASSERT_TRUE(identity[i].isNear(RotationQuaternion(), 1.0e-6));
+  }
+
+  ASSERT_EQ(this->size, this->rotations.size());
+  const std::vector<RotationQuaternion> rotationVector = this->rotations.toStdVector();
+  for (int i = 0; i < this->size; ++i) {
+    ASSERT_NEAR(this->rotationVector[i].w(), rotationVector[i].w(), 1.0e-6);
+    ASSERT_NEAR(this->rotationVector[i].x(), rotationVector[i].x(), 1.0e-6);
+    ASSERT_NEAR(this->rotationVector[i].y(), rotationVector[i].y(), 1.0e-6);
+    ASSERT_NEAR(this->rotationVector[i].z(), rotationVector[i].z(), 1.0e-6);
+  }
+
+  const rot::RotationQuaternionArray<double> castRotations(this->rotations);
+  ASSERT_NEAR(this->rotations[3].x(), castRotations[3].x(), 1.0e-6);
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testInverted) {
+  const typename TestFixture::RotationQuaternionArray inverted = this->rotations.inverted();
+  for (int i = 0; i < this->size; ++i) {
+    ASSERT_TRUE(inverted[i].isNear(this->rotationVector[i].inverted(), this->tol)) << "index " << i;
+  }
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testConcatenation) {
+  const typename TestFixture::RotationQuaternionArray product = this->rotations*this->otherRotations;
+  const typename TestFixture::RotationQuaternionArray productSingle = this->rotations*this->otherRotationVector[2];
+  for (int i = 0; i < this->size; ++i) {
+    ASSERT_TRUE(product[i].isNear(this->rotationVector[i]*this->otherRotationVector[i], this->tol)) << "index " << i;
+    ASSERT_TRUE(productSingle[i].isNear(this->rotationVector[i]*this->otherRotationVector[2], this->tol)) << "index " << i;
+  }
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testRotate) {
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::PositionArray PositionArray;
+  const PositionArray rotated = this->rotations.rotate(this->positions);
+  const PositionArray inverseRotated = this->rotations.inverseRotate(this->positions);
+  for (int i = 0; i < this->size; ++i) {
+    const Position expected = this->rotationVector[i].rotate(this->positions[i]);
+    const Position expectedInverse = this->rotationVector[i].inverseRotate(this->positions[i]);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.toImplementation(), rotated[i].toImplementation(), this->tol, this->tol, "rotate");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedInverse.toImplementation(), inverseRotated[i].toImplementation(), this->tol, this->tol, "inverse rotate");
+  }
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testMaps) {
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename TestFixture::Vector3 Vector3;
+  const typename RotationQuaternionArray::Matrix3X vectors = this->rotations.logarithmicMap();
+  const RotationQuaternionArray exponential = RotationQuaternionArray::exponentialMap(vectors);
+  for (int i = 0; i < this->size; ++i) {
+    const Vector3 expected = this->rotationVector[i].logarithmicMap();
+    const Vector3 vector = vectors.col(i);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, vector, this->tol, this->tol, "logarithmic map");
+    ASSERT_TRUE(exponential[i].isNear(this->rotationVector[i], this->tol)) << "index " << i;
+  }
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testBoxOperators) {
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename TestFixture::Vector3 Vector3;
+  const typename RotationQuaternionArray::Matrix3X difference = this->rotations.boxMinus(this->otherRotations);
+  const RotationQuaternionArray sum = this->otherRotations.boxPlus(difference);
+  for (int i = 0; i < this->size; ++i) {
+    const Vector3 expected = this->rotationVector[i].boxMinus(this->otherRotationVector[i]);
+    const Vector3 vector = difference.col(i);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, vector, this->tol, this->tol, "box minus");
+    ASSERT_TRUE(sum[i].isNear(this->rotationVector[i], this->tol)) << "index " << i;
+  }
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testConversions) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  const typename RotationQuaternionArray::Matrix9X matrices = this->rotations.getRotationMatrices();
+  for (int i = 0; i < this->size; ++i) {
+    const Matrix3 expected = rot::RotationMatrix<Scalar>(this->rotationVector[i]).matrix();
+    const Matrix3 matrix = Eigen::Map<const Matrix3>(Eigen::Matrix<Scalar, 9, 1>(matrices.col(i)).data());
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, matrix, this->tol, this->tol, "rotation matrix");
+  }
+
+  RotationQuaternionArray unnormalized = this->rotations;
+  unnormalized.toImplementation() *= Scalar(1.1);
+  unnormalized.fix();
+  for (int i = 0; i < this->size; ++i) {
+    ASSERT_TRUE(unnormalized[i].isNear(this->rotationVector[i], this->tol)) << "index " << i;
+  }
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testPositionArray) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::PositionArray PositionArray;
+  const Position offset(0.1, -0.2, 0.3);
+  const PositionArray shifted = (this->positions + offset)*Scalar(2);
+  const PositionArray difference = shifted - this->positions;
+  for (int i = 0; i < this->size; ++i) {
+    const Position expected = this->positions[i] + offset*Scalar(2);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.toImplementation(), difference[i].toImplementation(), this->tol, this->tol, "arithmetic");
+  }
+  ASSERT_EQ(this->size, static_cast<int>(this->positions.toStdVector().size()));
+  ASSERT_NEAR(this->positions[4].y(), this->positions.y()(4), 1.0e-6);
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testKernels) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename RotationQuaternionArray::Implementation Implementation;
+  typedef typename RotationQuaternionArray::Matrix3X Matrix3X;
+  typedef rot::internal::QuaternionArrayKernels<Scalar, false> ScalarKernels;
+  typedef rot::internal::QuaternionArrayKernels<Scalar, true> VectorizedKernels;
+  const int size = this->size;
+  const Implementation& lhs = this->rotations.toImplementation();
+  const Implementation& rhs = this->otherRotations.toImplementation();
+  const Matrix3X& vectors = this->positions.toImplementation();
+
+  Implementation productScalar(4, size), productVectorized(4, size);
+  ScalarKernels::multiply(lhs.data(), rhs.data(), productScalar.data(), size, 0, size);
+  VectorizedKernels::multiply(lhs.data(), rhs.data(), productVectorized.data(), size, 0, size);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(productScalar, productVectorized, this->tol, this->tol, "multiply");
+
+  Matrix3X rotatedScalar(3, size), rotatedVectorized(3, size);
+  ScalarKernels::rotate(lhs.data(), vectors.data(), rotatedScalar.data(), size, 0, size, Scalar(-1));
+  VectorizedKernels::rotate(lhs.data(), vectors.data(), rotatedVectorized.data(), size, 0, size, Scalar(-1));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotatedScalar, rotatedVectorized, this->tol, this->tol, "rotate");
+
+  Implementation normalizedScalar = Scalar(2)*lhs, normalizedVectorized = Scalar(2)*lhs;
+  ScalarKernels::normalize(normalizedScalar.data(), size, 0, size);
+  VectorizedKernels::normalize(normalizedVectorized.data(), size, 0, size);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(lhs, normalizedScalar, this->tol, this->tol, "normalize");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(lhs, normalizedVectorized, this->tol, this->tol, "normalize");
+
+  // the kernels may work in place
+  RotationQuaternionArray product = this->rotations;
+  product.multiply(this->otherRotations, product);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(productScalar, product.toImplementation(), this->tol, this->tol, "multiply in place");
+  typename TestFixture::PositionArray rotated = this->positions;
+  this->rotations.inverseRotate(rotated, rotated);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotatedScalar, rotated.toImplementation(), this->tol, this->tol, "rotate in place");
+}
+
+TYPED_TEST(RotationQuaternionArrayTest, testExecutor) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename TestFixture::PositionArray PositionArray;
+  const rot::ThreadPoolExecutor executor(3);
+
+  // large enough for several chunks
+  const int size = 50000;
+  RotationQuaternionArray rotations = RotationQuaternionArray::exponentialMap(Eigen::Matrix<Scalar, 3, Eigen::Dynamic>::Random(3, size));
+  RotationQuaternionArray otherRotations = RotationQuaternionArray::exponentialMap(Eigen::Matrix<Scalar, 3, Eigen::Dynamic>::Random(3, size));
+  const PositionArray positions(Eigen::Matrix<Scalar, 3, Eigen::Dynamic>::Random(3, size));
+
+  RotationQuaternionArray product;
+  rotations.multiply(otherRotations, product, executor);
+  EXPECT_TRUE(product.toImplementation().isApprox((rotations*otherRotations).toImplementation()));
+
+  PositionArray rotated;
+  rotations.rotate(positions, rotated, executor);
+  EXPECT_TRUE(rotated.toImplementation().isApprox(rotations.rotate(positions.toImplementation())));
+  rotations.inverseRotate(rotated, rotated, executor);
+  EXPECT_TRUE(rotated.toImplementation().isApprox(positions.toImplementation(), Scalar(this->tol)));
+
+  typename RotationQuaternionArray::Matrix9X matrices;
+  rotations.getRotationMatrices(matrices, executor);
+  EXPECT_TRUE(matrices.isApprox(rotations.getRotationMatrices()));
+
+  product.toImplementation() *= Scalar(2);
+  product.fix(executor);
+  EXPECT_TRUE(product.toImplementation().isApprox((rotations*otherRotations).toImplementation(), Scalar(this->tol)));
+}
@@ -221,3 +221,31 @@ TYPED_TEST(RotationQuaternionDiffTest, testFiniteDifference)
     }
   }
 }
+
+TYPED_TEST(RotationQuaternionDiffTest, testConversionsAgreeWithDiffMatrices)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationDiff RotationDiff;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Vector4 Vector4;
+  typedef rot::GlobalAngularVelocity<Scalar> GlobalAngularVelocity;
+  typedef typename TestFixture::LocalAngularVelocity LocalAngularVelocity;
+
+  for (auto rotation : this->rotations) {
+    for (auto angularVelocity : this->angularVelocities) {
+      const RotationDiff localDiff(rotation, angularVelocity);
+      const Vector4 localDiffExpected = Scalar(0.5)*rotation.getLocalQuaternionDiffMatrix().transpose()*angularVelocity.vector();
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(localDiff.vector(), localDiffExpected, 1e-5, 0, "local");
+
+      const GlobalAngularVelocity globalAngularVelocity(angularVelocity.vector());
+      const RotationDiff globalDiff(rotation, globalAngularVelocity);
+      const Vector4 globalDiffExpected = Scalar(0.5)*rotation.getGlobalQuaternionDiffMatrix().transpose()*globalAngularVelocity.vector();
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(globalDiff.vector(), globalDiffExpected, 1e-5, 0, "global");
+
+      const Vector3 localAngularVelocityExpected = Scalar(2.0)*rotation.getLocalQuaternionDiffMatrix()*localDiff.vector();
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(LocalAngularVelocity(rotation, localDiff).vector(), localAngularVelocityExpected, 1e-5, 0, "local inverse");
+      const Vector3 globalAngularVelocityExpected = Scalar(2.0)*rotation.getGlobalQuaternionDiffMatrix()*globalDiff.vector();
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(GlobalAngularVelocity(rotation, globalDiff).vector(), globalAngularVelocityExpected, 1e-5, 0, "global inverse");
+    }
+  }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationQuaternionInterpolation.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+class RotationQuaternionInterpolationTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef rot::RotationQuaternionResampler<Scalar> Resampler;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const double tol = 1.0e-4;
+
+  std::vector<Scalar> knotTimes;
+  std::vector<RotationQuaternion> knots;
+
+  RotationQuaternionInterpolationTest() {
+    knotTimes = {Scalar(0.0), Scalar(0.1), Scalar(0.3), Scalar(0.35), Scalar(0.6)};
+    knots.push_back(RotationQuaternion(rot::EulerAnglesZyx<Scalar>(0.0, 0.0, 0.0)));
+    knots.push_back(RotationQuaternion(rot::EulerAnglesZyx<Scalar>(0.4, -0.1, 0.2)));
+    knots.push_back(RotationQuaternion(rot::EulerAnglesZyx<Scalar>(1.2, 0.3, -0.2)));
+    // negative real part to check the shortest path
+    knots.push_back(RotationQuaternion(-rot::RotationQuaternion<Scalar>(rot::EulerAnglesZyx<Scalar>(1.5, 0.2, 0.1)).vector()));
+    knots.push_back(RotationQuaternion(rot::EulerAnglesZyx<Scalar>(2.5, -0.4, 0.6)));
+  }
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+TYPED_TEST_CASE(RotationQuaternionInterpolationTest, PrimTypes);
+
+TYPED_TEST(RotationQuaternionInterpolationTest, testSlerpAndNlerp)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  const RotationQuaternion& q0 = this->knots[2];
+  const RotationQuaternion& q1 = this->knots[3];
+
+  ASSERT_TRUE(rot::slerp(q0, q1, Scalar(0)).isNear(q0, this->tol));
+  ASSERT_TRUE(rot::slerp(q0, q1, Scalar(1)).isNear(q1, this->tol));
+  ASSERT_TRUE(rot::nlerp(q0, q1, Scalar(0)).isNear(q0, this->tol));
+  ASSERT_TRUE(rot::nlerp(q0, q1, Scalar(1)).isNear(q1, this->tol));
+
+  // slerp moves along the shortest path with constant angular velocity
+  const RotationQuaternion middle = rot::slerp(q0, q1, Scalar(0.5));
+  ASSERT_NEAR(middle.getDisparityAngle(q0), Scalar(0.5)*q1.getDisparityAngle(q0), this->tol);
+  ASSERT_NEAR(middle.getDisparityAngle(q1), Scalar(0.5)*q1.getDisparityAngle(q0), this->tol);
+  ASSERT_TRUE(rot::slerp(q0, q1, Scalar(0.3)).isNear(q0.boxPlus(Scalar(0.3)*q1.boxMinus(q0)), this->tol));
+  ASSERT_TRUE(rot::nlerp(q0, q1, Scalar(0.5)).isNear(middle, this->tol));
+
+  // identical rotations
+  ASSERT_TRUE(rot::slerp(q0, q0, Scalar(0.7)).isNear(q0, this->tol));
+}
+
+TYPED_TEST(RotationQuaternionInterpolationTest, testResampleThroughKnots)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Resampler Resampler;
+  const Resampler resampler(this->knotTimes, this->knots);
+  ASSERT_EQ(resampler.getDeltas().cols(), 4);
+
+  for (auto method : {Resampler::Method::Slerp, Resampler::Method::Nlerp, Resampler::Method::Squad}) {
+    rot::RotationQuaternionArray<Scalar> result;
+    resampler.resample(this->knotTimes, method, result);
+    ASSERT_EQ(result.size(), 5);
+    for (int i = 0; i < 5; ++i) {
+      ASSERT_TRUE(result[i].isNear(this->knots[i], this->tol)) << "knot " << i;
+    }
+  }
+
+  // queries between and outside the knots
+  const std::vector<Scalar> times = {Scalar(-1.0), Scalar(0.05), Scalar(0.2), Scalar(0.2), Scalar(0.5), Scalar(2.0)};
+  rot::RotationQuaternionArray<Scalar> result;
+  resampler.resample(times, Resampler::Method::Slerp, result);
+  ASSERT_TRUE(result[0].isNear(this->knots.front(), this->tol));
+  ASSERT_TRUE(result[1].isNear(rot::slerp(this->knots[0], this->knots[1], Scalar(0.5)), this->tol));
+  ASSERT_TRUE(result[2].isNear(rot::slerp(this->knots[1], this->knots[2], Scalar(0.5)), this->tol));
+  ASSERT_TRUE(result[3].isNear(result[2], this->tol));
+  ASSERT_TRUE(result[4].isNear(rot::slerp(this->knots[3], this->knots[4], Scalar(0.6)), this->tol));
+  ASSERT_TRUE(result[5].isNear(this->knots.back(), this->tol));
+
+  // chunks of an executor start at the right interval
+  std::vector<Scalar> manyTimes;
+  for (int k = 0; k < 20000; ++k) {
+    manyTimes.push_back(Scalar(-0.1) + Scalar(0.8)*Scalar(k)/Scalar(20000));
+  }
+  rot::RotationQuaternionArray<Scalar> serialResult;
+  rot::RotationQuaternionArray<Scalar> parallelResult;
+  resampler.resample(manyTimes, Resampler::Method::Squad, serialResult);
+  resampler.resample(manyTimes, Resampler::Method::Squad, parallelResult, rot::ThreadPoolExecutor(4));
+  ASSERT_TRUE(parallelResult.toImplementation().isApprox(serialResult.toImplementation()));
+}
+
+TYPED_TEST(RotationQuaternionInterpolationTest, testSmoothMethods)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Resampler Resampler;
+  const Resampler resampler(this->knotTimes, this->knots);
+
+  // squad and the B-spline are continuous across the knots
+  for (auto method : {Resampler::Method::Squad, Resampler::Method::CumulativeBSpline}) {
+    for (int interval = 0; interval < 3; ++interval) {
+      ASSERT_TRUE(resampler.interpolate(interval, Scalar(1), method).isNear(resampler.interpolate(interval+1, Scalar(0), method), this->tol));
+    }
+  }
+
+  // the B-spline of constant knots is constant
+  const std::vector<typename TestFixture::RotationQuaternion> constantKnots(5, this->knots[2]);
+  const Resampler constantResampler(this->knotTimes, constantKnots);
+  ASSERT_TRUE(constantResampler.interpolate(2, Scalar(0.3), Resampler::Method::CumulativeBSpline).isNear(this->knots[2], this->tol));
+}
+
+TEST(RotationQuaternionInterpolationTest, testInvalidKnots)
+{
+  typedef rot::RotationQuaternionResampler<double> Resampler;
+  const std::vector<rot::RotationQuaternionD> knots(2);
+  ASSERT_THROW(Resampler({0.0, 0.0}, knots), std::runtime_error);
+  ASSERT_THROW(Resampler({0.0}, knots), std::runtime_error);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationQuaternionMap.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+class RotationQuaternionMapTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const double tol = 1.0e-4;
+
+  // two quaternions interleaved with a 3-element record in between, i.e. [x y z w a b c] per record
+  Scalar buffer[14];
+  RotationQuaternion rotation1;
+  RotationQuaternion rotation2;
+
+  RotationQuaternionMapTest()
+    : rotation1(rot::EulerAnglesZyx<Scalar>(0.3, -0.2, 0.9)),
+      rotation2(rot::EulerAnglesZyx<Scalar>(-1.1, 0.4, 0.1)) {
+    for (int i = 0; i < 14; ++i) {
+      buffer[i] = Scalar(-7);
+    }
+    buffer[0] = rotation1.x(); buffer[1] = rotation1.y(); buffer[2] = rotation1.z(); buffer[3] = rotation1.w();
+    buffer[7] = rotation2.x(); buffer[8] = rotation2.y(); buffer[9] = rotation2.z(); buffer[10] = rotation2.w();
+  }
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+TYPED_TEST_CASE(RotationQuaternionMapTest, PrimTypes);
+
+TYPED_TEST(RotationQuaternionMapTest, testReadAndRotate)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  const rot::RotationQuaternionMap<const Scalar> map1(this->buffer);
+  const rot::RotationQuaternionMap<const Scalar> map2(this->buffer + 7);
+
+  ASSERT_TRUE(map1.eval().isNear(this->rotation1, this->tol));
+  const Vector3 vector(1.0, -2.0, 0.5);
+  ASSERT_TRUE((map1.rotate(vector) - this->rotation1.rotate(vector)).norm() < this->tol);
+  ASSERT_TRUE((map1.inverseRotate(vector) - this->rotation1.inverseRotate(vector)).norm() < this->tol);
+  ASSERT_TRUE((map1*this->rotation2).isNear(this->rotation1*this->rotation2, this->tol));
+  ASSERT_TRUE((map1*map2.eval()).isNear(this->rotation1*this->rotation2, this->tol));
+  ASSERT_TRUE(map1.inverted().isNear(this->rotation1.inverted(), this->tol));
+  ASSERT_TRUE((map1.boxMinus(this->rotation2) - this->rotation1.boxMinus(this->rotation2)).norm() < this->tol);
+  ASSERT_NEAR(map1.getDisparityAngle(this->rotation2), this->rotation1.getDisparityAngle(this->rotation2), this->tol);
+}
+
+TYPED_TEST(RotationQuaternionMapTest, testWriteInPlace)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  rot::RotationQuaternionMap<Scalar> map(this->buffer + 7);
+
+  map = rot::RotationMatrix<Scalar>(this->rotation1);
+  ASSERT_TRUE(map.eval().isNear(this->rotation1, this->tol));
+  map.invert();
+  ASSERT_TRUE(map.eval().isNear(this->rotation1.inverted(), this->tol));
+  map.setIdentity();
+  ASSERT_EQ(this->buffer[10], Scalar(1));
+  // the neighbouring records are untouched
+  ASSERT_EQ(this->buffer[6], Scalar(-7));
+  ASSERT_EQ(this->buffer[11], Scalar(-7));
+
+  // a const map only hands out read-only pointers
+  const rot::RotationQuaternionMap<Scalar>& constMap = map;
+  static_assert(std::is_same<decltype(constMap.data()), const Scalar*>::value, "The data of a const map must be read-only.");
+  static_assert(std::is_same<decltype(map.data()), Scalar*>::value, "The data of a map must be writable.");
+  ASSERT_EQ(constMap.data(), this->buffer + 7);
+}
+
+TYPED_TEST(RotationQuaternionMapTest, testStride)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  // two quaternions interleaved coefficient by coefficient: [x0 x1 y0 y1 z0 z1 w0 w1]
+  Scalar interleaved[8];
+  rot::RotationQuaternionMap<Scalar, Eigen::InnerStride<2>> map0(interleaved, Eigen::InnerStride<2>());
+  rot::RotationQuaternionMap<Scalar, Eigen::InnerStride<2>> map1(interleaved + 1, Eigen::InnerStride<2>());
+  map0 = this->rotation1;
+  map1 = this->rotation2;
+  ASSERT_EQ(interleaved[6], this->rotation1.w());
+  ASSERT_EQ(interleaved[7], this->rotation2.w());
+  ASSERT_TRUE(map0.eval().isNear(this->rotation1, this->tol));
+  ASSERT_TRUE(map1.eval().isNear(this->rotation2, this->tol));
+}
@@ -589,6 +589,27 @@ TYPED_TEST(RotationQuaternionSingleTest, testRotationQuaternionConcatenation){
   ASSERT_NEAR(rotQuat.getUnique().z(), this->rotQuatQuarterX.getUnique().z(),1e-6);
 }
 
+// Test fused concatenation with inverses
+TYPED_TEST(RotationQuaternionSingleTest, testRotationQuaternionFusedConcatenation){
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef quat::Quaternion<Scalar> Quaternion;
+
+  const RotationQuaternion conjMult = this->rotQuat2.conjugateMultiply(this->rotQuat1);
+  ASSERT_TRUE(conjMult.isNear(this->rotQuat2.inverted()*this->rotQuat1, 1e-6));
+  const RotationQuaternion multConj = this->rotQuat2.multiplyConjugate(this->rotQuat1);
+  ASSERT_TRUE(multConj.isNear(this->rotQuat2*this->rotQuat1.inverted(), 1e-6));
+  ASSERT_TRUE(this->rotQuat1.multiplyConjugate(this->rotQuat1).isNear(this->rotQuatIdentity, 1e-6));
+
+  // the sandwich of a pure quaternion matches the quaternion product
+  const Quaternion pure(0.0, this->vec.x(), this->vec.y(), this->vec.z());
+  const Quaternion sandwich = this->rotQuat2.sandwich(pure);
+  const Quaternion composed = this->rotQuat2.toUnitQuaternion()*pure*this->rotQuat2.toUnitQuaternion().conjugated();
+  ASSERT_NEAR(sandwich.w(), composed.w(), 1e-6);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(composed.vector(), sandwich.vector(), 1e-6, 1e-6, "sandwich");
+  ASSERT_NEAR(sandwich.vector().norm(), this->vec.norm(), 1e-5);
+}
+
 // Testing of special matrices
 TYPED_TEST (RotationQuaternionSingleTest, testRotationQuaternionSingleSpecialMatrices) {
   typedef typename TestFixture::RotationQuaternion RotationQuaternion;
@@ -943,3 +964,55 @@ TYPED_TEST(RotationQuaternionSingleTest, testGetRandom){
   ASSERT_TRUE(rotB.isNear(rotA, 1e-4));
   ASSERT_TRUE(!rotC.isNear(rotA, 1e-4));
 }
+
+TEST(RotationQuaternionAccumulatorTest, testLongFloatChain){
+  const int numberOfSteps = 10000;
+  const kindr::RotationQuaternionF step(kindr::AngleAxisF(0.001f, 1.0f/std::sqrt(3.0f)*Eigen::Vector3f::Ones()));
+
+  kindr::RotationQuaternionAccumulator<float> accumulator;
+  for (int i=0; i<numberOfSteps; i++) {
+    accumulator *= step;
+  }
+
+  const kindr::RotationQuaternionF expected(kindr::AngleAxisF(float(numberOfSteps)*0.001f, 1.0f/std::sqrt(3.0f)*Eigen::Vector3f::Ones()));
+  ASSERT_NEAR(accumulator.getRotation().norm(), 1.0f, 1e-6);
+  ASSERT_TRUE(accumulator.getRotation().isNear(expected, 1e-4)) << "accumulated: " << accumulator.getRotation() << " expected: " << expected;
+
+  accumulator.setIdentity();
+  ASSERT_TRUE(accumulator.getRotation().isNear(kindr::RotationQuaternionF(), 1e-6));
+}
+
+// Test the direct disparity angle and the threshold-only comparison
+TYPED_TEST(RotationQuaternionSingleTest, testDisparityAngle){
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector Vector;
+  typedef rot::AngleAxis<Scalar> AngleAxis;
+
+  const RotationQuaternion rotQuat2Negative(-this->rotQuat2.vector());
+  const Scalar reference = std::abs(floatingPointModulo(AngleAxis(this->rotQuat1*this->rotQuat2.inverted()).angle() + Scalar(M_PI), Scalar(2.0*M_PI))-Scalar(M_PI));
+  ASSERT_NEAR(this->rotQuat1.getDisparityAngle(this->rotQuat2), reference, 1e-4);
+  ASSERT_NEAR(this->rotQuat1.getDisparityAngle(rotQuat2Negative), reference, 1e-4);
+  ASSERT_NEAR(this->rotQuat2.getDisparityAngle(this->rotQuat2), 0.0, 1e-6);
+  ASSERT_NEAR(this->rotQuatIdentity.getDisparityAngle(this->rotQuatQuarterX), M_PI/2.0, 1e-5);
+
+  // small angles are resolved accurately
+  const RotationQuaternion rotQuatSmall = this->rotQuat2.boxPlus(Vector(Scalar(1e-4), Scalar(0), Scalar(0)));
+  ASSERT_NEAR(rotQuatSmall.getDisparityAngle(this->rotQuat2), 1e-4, 1e-6);
+  ASSERT_TRUE(rotQuatSmall.isNear(this->rotQuat2, Scalar(2e-4)));
+  ASSERT_FALSE(rotQuatSmall.isNear(this->rotQuat2, Scalar(0.5e-4)));
+
+  ASSERT_TRUE(this->rotQuat2.isNear(rotQuat2Negative, Scalar(1e-6)));
+  ASSERT_TRUE(this->rotQuatIdentity.isNear(this->rotQuatQuarterX, Scalar(M_PI/2.0 + 1e-3)));
+  ASSERT_FALSE(this->rotQuatIdentity.isNear(this->rotQuatQuarterX, Scalar(M_PI/2.0 - 1e-3)));
+  ASSERT_FALSE(this->rotQuat2.isNear(this->rotQuat2, Scalar(-1)));
+
+  // comparator with the precomputed bound
+  const rot::RotationNearness<RotationQuaternion> isNear(Scalar(2e-4));
+  ASSERT_TRUE(isNear(rotQuatSmall, this->rotQuat2));
+  ASSERT_TRUE(isNear(this->rotQuat2, rotQuat2Negative));
+  ASSERT_FALSE(isNear(this->rotQuatIdentity, this->rotQuatQuarterX));
+  ASSERT_TRUE((rot::RotationNearness<RotationQuaternion, AngleAxis>(Scalar(M_PI/2.0 + 1e-3))(this->rotQuatIdentity, AngleAxis(this->rotQuatQuarterX))));
+  ASSERT_TRUE(rot::RotationNearness<RotationQuaternion>(Scalar(M_PI))(this->rotQuat1, this->rotQuat2));
+  ASSERT_FALSE(rot::RotationNearness<RotationQuaternion>(Scalar(-1))(this->rotQuat2, this->rotQuat2));
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename Rotation_>
+class RotationRenormalizationTest : public ::testing::Test {
+ public:
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef rot::RenormalizingRotation<Rotation_> Renormalizing;
+
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-13);
+  const int numCompositions = 20000;
+
+  Rotation increment;
+  Rotation disturbed;
+
+  RotationRenormalizationTest()
+    : increment(rot::EulerAnglesZyx<Scalar>(0.011, -0.007, 0.013)),
+      disturbed(rot::EulerAnglesZyx<Scalar>(0.5, 0.2, -0.3)) {
+    // The same error as after many compositions
+    disturb(disturbed);
+  }
+
+  static void disturb(rot::RotationQuaternion<Scalar>& rotation) {
+    rotation.toImplementation().coeffs() *= Scalar(1.001);
+  }
+
+  static void disturb(rot::RotationMatrix<Scalar>& rotation) {
+    rotation.toImplementation() *= Scalar(1.001);
+  }
+
+  Renormalizing compose(rot::RenormalizationPolicy policy, int period) const {
+    Renormalizing renormalizing(Rotation(), policy, period);
+    for (int i = 0; i < numCompositions; ++i) {
+      renormalizing *= increment;
+    }
+    return renormalizing;
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationQuaternionF
+> QuaternionTypes;
+
+TYPED_TEST_CASE(RotationRenormalizationTest, QuaternionTypes);
+
+TYPED_TEST(RotationRenormalizationTest, testPolicies)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Renormalizing Renormalizing;
+
+  const Renormalizing never = this->compose(rot::RenormalizationPolicy::Never, 1);
+  const Renormalizing exact = this->compose(rot::RenormalizationPolicy::Exact, 1);
+  const Renormalizing periodic = this->compose(rot::RenormalizationPolicy::Exact, 100);
+  const Renormalizing firstOrder = this->compose(rot::RenormalizationPolicy::FirstOrder, 1);
+  EXPECT_LT(exact.getNormalizationError(), this->tol);
+  EXPECT_LT(periodic.getNormalizationError(), Scalar(100)*this->tol);
+  EXPECT_LT(firstOrder.getNormalizationError(), this->tol);
+  EXPECT_LT(firstOrder.getNormalizationError(), never.getNormalizationError());
+
+  // All policies compose the same rotation
+  ASSERT_TRUE(exact.getRotation().isNear(firstOrder.getRotation(), Scalar(100)*this->tol));
+  ASSERT_TRUE(exact.getRotation().isNear(periodic.getRotation(), Scalar(100)*this->tol));
+}
+
+TYPED_TEST(RotationRenormalizationTest, testCorrection)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Renormalizing Renormalizing;
+
+  // The first-order correction squares the error, the exact renormalization removes it
+  Renormalizing firstOrder(this->disturbed, rot::RenormalizationPolicy::FirstOrder);
+  const Scalar error = firstOrder.getNormalizationError();
+  firstOrder.preMultiply(Rotation());
+  EXPECT_LT(firstOrder.getNormalizationError(), Scalar(2)*error*error + this->tol);
+  Renormalizing never(this->disturbed, rot::RenormalizationPolicy::Never);
+  never.preMultiply(Rotation());
+  EXPECT_NEAR(error, never.getNormalizationError(), this->tol);
+  never.renormalize();
+  EXPECT_LT(never.getNormalizationError(), this->tol);
+  EXPECT_THROW(Renormalizing(Rotation(), rot::RenormalizationPolicy::Exact, 0), std::runtime_error);
+}
+
+
+template <typename Rotation_>
+class RotationMatrixRenormalizationTest : public RotationRenormalizationTest<Rotation_> {
+};
+
+typedef ::testing::Types<
+    rot::RotationMatrixD,
+    rot::RotationMatrixF
+> MatrixTypes;
+
+TYPED_TEST_CASE(RotationMatrixRenormalizationTest, MatrixTypes);
+
+TYPED_TEST(RotationMatrixRenormalizationTest, testPolicies)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Renormalizing Renormalizing;
+
+  const Renormalizing never = this->compose(rot::RenormalizationPolicy::Never, 1);
+  const Renormalizing exact = this->compose(rot::RenormalizationPolicy::Exact, 10);
+  const Renormalizing firstOrder = this->compose(rot::RenormalizationPolicy::FirstOrder, 1);
+  EXPECT_LT(exact.getNormalizationError(), Scalar(10)*this->tol);
+  EXPECT_LT(firstOrder.getNormalizationError(), Scalar(10)*this->tol);
+  EXPECT_LT(firstOrder.getNormalizationError(), never.getNormalizationError());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(exact.getRotation().matrix(), firstOrder.getRotation().matrix(), Scalar(100)*this->tol, Scalar(100)*this->tol, "policies");
+}
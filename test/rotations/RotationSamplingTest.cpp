@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationSampling.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+class RotationSamplingTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef rot::RotationQuaternionArray<Scalar> RotationQuaternionArray;
+  typedef rot::RotationSampler<Scalar, std::minstd_rand> Sampler;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const int numSamples = 20000;
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+
+TYPED_TEST_CASE(RotationSamplingTest, PrimTypes);
+
+TYPED_TEST(RotationSamplingTest, testUniform)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename TestFixture::Sampler Sampler;
+
+  Sampler sampler(42u);
+  RotationQuaternionArray rotations(this->numSamples);
+  sampler.sampleUniform(rotations);
+
+  // the second moment E[q*q^T] of the uniform distribution is I/4
+  Eigen::Matrix<double, 4, 4> moment = Eigen::Matrix<double, 4, 4>::Zero();
+  for (int i = 0; i < rotations.size(); ++i) {
+    const Eigen::Matrix<double, 4, 1> q = rotations[i].vector().template cast<double>();
+    ASSERT_NEAR(q.norm(), 1.0, 1e-5);
+    moment += q*q.transpose();
+  }
+  moment /= rotations.size();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((0.25*Eigen::Matrix<double, 4, 4>::Identity()).eval(), moment, 1.5e-2, 0.0, "uniform");
+
+  // the rotation angle has the density (1-cos(angle))/pi, i.e. a mean of pi/2 + 2/pi
+  double meanAngle = 0.0;
+  for (int i = 0; i < rotations.size(); ++i) {
+    meanAngle += rotations[i].getDisparityAngle(rot::RotationQuaternion<Scalar>());
+  }
+  meanAngle /= rotations.size();
+  EXPECT_NEAR(meanAngle, M_PI/2.0 + 2.0/M_PI, 2e-2);
+}
+
+TYPED_TEST(RotationSamplingTest, testStreams)
+{
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename TestFixture::Sampler Sampler;
+
+  // the same seed and stream reproduce the samples
+  RotationQuaternionArray first(10);
+  RotationQuaternionArray second(10);
+  Sampler(7u, 1u).sampleUniform(first);
+  Sampler(7u, 1u).sampleUniform(second);
+  EXPECT_TRUE(first.toImplementation().isApprox(second.toImplementation()));
+
+  // other streams are independent
+  Sampler(7u, 2u).sampleUniform(second);
+  EXPECT_FALSE(first.toImplementation().isApprox(second.toImplementation()));
+
+  // two streams fill disjoint ranges
+  RotationQuaternionArray rotations(10);
+  Sampler(7u, 1u).sampleUniform(rotations, 0, 5);
+  Sampler(7u, 2u).sampleUniform(rotations, 5);
+  EXPECT_TRUE(rotations.toImplementation().leftCols(5).isApprox(first.toImplementation().leftCols(5)));
+  EXPECT_TRUE(rotations.toImplementation().rightCols(5).isApprox(second.toImplementation().leftCols(5)));
+
+  Sampler sampler;
+  EXPECT_ANY_THROW(sampler.sampleUniform(rotations, 5, 11));
+  EXPECT_ANY_THROW(sampler.sampleUniform(rotations, 6, 5));
+
+  // caller-provided engine
+  std::minstd_rand engine(3u);
+  Sampler engineSampler(engine);
+  engineSampler.getEngine().discard(1);
+  engine.discard(1);
+  EXPECT_EQ(engineSampler.getEngine()(), engine());
+}
+
+TYPED_TEST(RotationSamplingTest, testGaussian)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationQuaternionArray RotationQuaternionArray;
+  typedef typename TestFixture::Sampler Sampler;
+  typedef typename TestFixture::Vector3 Vector3;
+
+  Sampler sampler(5u);
+  const RotationQuaternion mean(rot::EulerAnglesZyx<Scalar>(0.3, -0.8, 1.1));
+  const Vector3 standardDeviations(0.05, 0.1, 0.2);
+  RotationQuaternionArray rotations(this->numSamples);
+  sampler.sampleGaussian(mean, standardDeviations, rotations);
+
+  Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+  Eigen::Vector3d sumSquared = Eigen::Vector3d::Zero();
+  for (int i = 0; i < rotations.size(); ++i) {
+    const Eigen::Vector3d v = rotations[i].boxMinus(mean).template cast<double>();
+    sum += v;
+    sumSquared += v.cwiseProduct(v);
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Eigen::Vector3d::Zero().eval(), (sum/rotations.size()).eval(), 5e-3, 0.0, "gaussian mean");
+  const Eigen::Vector3d variance = sumSquared/rotations.size();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(standardDeviations.template cast<double>().eval(), variance.cwiseSqrt().eval(), 0.0, 0.05, "gaussian deviation");
+
+  // perturbing a batch in place moves every rotation by the drawn vector
+  RotationQuaternionArray perturbed(rotations);
+  sampler.perturb(Vector3::Zero(), perturbed);
+  EXPECT_TRUE(perturbed.toImplementation().isApprox(rotations.toImplementation(), Scalar(1e-5)));
+  sampler.perturb(standardDeviations, perturbed, 0, 1);
+  EXPECT_FALSE(perturbed[0].isNear(rotations[0], Scalar(1e-6)));
+  EXPECT_TRUE(perturbed[1].isNear(rotations[1], Scalar(1e-6)));
+}
@@ -31,6 +31,7 @@
 #include <string>
 
 #include "kindr/rotations/Rotation.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
 #include "kindr/common/assert_macros_eigen.hpp"
 
 
@@ -555,3 +556,215 @@ TYPED_TEST(ConcatenationTest, testBToA) {
 
 }
 
+
+
+template <typename RotationTestType_>
+struct RotateTest : public ::testing::Test{
+  typedef typename RotationTestType_::Rotation Rotation;
+  typedef typename RotationTestType_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  RotationTestType_ rotTest;
+  double tol = 1.0e-4;
+
+  template <int Cols_>
+  void checkRotate(const Rotation& rotation, const std::string& msg) {
+    const Matrix3 matrix = rot::RotationMatrix<Scalar>(rotation).matrix();
+    const Eigen::Matrix<Scalar, 3, Cols_> vectors = Eigen::Matrix<Scalar, 3, Cols_>::Random();
+    const Eigen::Matrix<Scalar, 3, Cols_> expected = matrix*vectors;
+    const Eigen::Matrix<Scalar, 3, Cols_> rotated = rotation.rotate(vectors);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotated, tol, tol, msg);
+  }
+
+  void checkRotate(const Rotation& rotation, const std::string& msg) {
+    checkRotate<1>(rotation, msg + " 1 column");
+    checkRotate<2>(rotation, msg + " 2 columns");
+    checkRotate<5>(rotation, msg + " 5 columns");
+
+    const Matrix3 matrix = rot::RotationMatrix<Scalar>(rotation).matrix();
+    for (int cols = 1; cols < 4; ++cols) {
+      const Eigen::Matrix<Scalar, 3, Eigen::Dynamic> vectors = Eigen::Matrix<Scalar, 3, Eigen::Dynamic>::Random(3, cols);
+      const Eigen::Matrix<Scalar, 3, Eigen::Dynamic> expected = matrix*vectors;
+      const Eigen::Matrix<Scalar, 3, Eigen::Dynamic> rotated = rotation.rotate(vectors);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotated, tol, tol, msg + " dynamic columns");
+    }
+
+    const kindr::Position<Scalar, 3> position(0.3, -1.5, 0.6);
+    const kindr::Position<Scalar, 3> rotatedPosition = rotation.rotate(position);
+    const Eigen::Matrix<Scalar, 3, 1> expectedPosition = matrix*position.toImplementation();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedPosition, rotatedPosition.toImplementation(), tol, tol, msg + " position");
+  }
+
+  template <int Cols_>
+  void checkInverseRotate(const Rotation& rotation, const std::string& msg) {
+    const Matrix3 matrix = rot::RotationMatrix<Scalar>(rotation).matrix();
+    const Eigen::Matrix<Scalar, 3, Cols_> vectors = Eigen::Matrix<Scalar, 3, Cols_>::Random();
+    const Eigen::Matrix<Scalar, 3, Cols_> expected = matrix.transpose()*vectors;
+    const Eigen::Matrix<Scalar, 3, Cols_> rotated = rotation.inverseRotate(vectors);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotated, tol, tol, msg);
+  }
+
+  void checkInverseRotate(const Rotation& rotation, const std::string& msg) {
+    checkInverseRotate<1>(rotation, msg + " 1 column");
+    checkInverseRotate<2>(rotation, msg + " 2 columns");
+    checkInverseRotate<5>(rotation, msg + " 5 columns");
+
+    const Matrix3 matrix = rot::RotationMatrix<Scalar>(rotation).matrix();
+    for (int cols = 1; cols < 4; ++cols) {
+      const Eigen::Matrix<Scalar, 3, Eigen::Dynamic> vectors = Eigen::Matrix<Scalar, 3, Eigen::Dynamic>::Random(3, cols);
+      const Eigen::Matrix<Scalar, 3, Eigen::Dynamic> expected = matrix.transpose()*vectors;
+      const Eigen::Matrix<Scalar, 3, Eigen::Dynamic> rotated = rotation.inverseRotate(vectors);
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotated, tol, tol, msg + " dynamic columns");
+    }
+
+    const kindr::Position<Scalar, 3> position(0.3, -1.5, 0.6);
+    const kindr::Position<Scalar, 3> rotatedPosition = rotation.inverseRotate(position);
+    const Eigen::Matrix<Scalar, 3, 1> expectedPosition = matrix.transpose()*position.toImplementation();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedPosition, rotatedPosition.toImplementation(), tol, tol, msg + " position");
+    const kindr::Position<Scalar, 3> roundTrip = rotation.rotate(rotation.inverseRotate(position));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(position.toImplementation(), roundTrip.toImplementation(), tol, tol, msg + " round trip");
+  }
+};
+
+typedef ::testing::Types<
+    RotationQuaternionTestType<rot::RotationQuaternionPF>,
+    RotationQuaternionTestType<rot::RotationQuaternionPD>,
+    RotationVectorTestType<rot::RotationVectorPF>,
+    RotationVectorTestType<rot::RotationVectorPD>,
+    AngleAxisTestType<rot::AngleAxisPF>,
+    AngleAxisTestType<rot::AngleAxisPD>,
+    RotationMatrixTestType<rot::RotationMatrixPF>,
+    RotationMatrixTestType<rot::RotationMatrixPD>,
+    EulerAnglesZyxTestType<rot::EulerAnglesZyxPF>,
+    EulerAnglesZyxTestType<rot::EulerAnglesZyxPD>,
+    EulerAnglesXyzTestType<rot::EulerAnglesXyzPF>,
+    EulerAnglesXyzTestType<rot::EulerAnglesXyzPD>
+> TypeRotations;
+
+TYPED_TEST_CASE(RotateTest, TypeRotations);
+
+TYPED_TEST(RotateTest, testRotate) {
+  this->checkRotate(this->rotTest.rotIdentity, "identity");
+  this->checkRotate(this->rotTest.rotQuarterX, "quarter x");
+  this->checkRotate(this->rotTest.rotQuarterY, "quarter y");
+  this->checkRotate(this->rotTest.rotQuarterZ, "quarter z");
+  this->checkRotate(this->rotTest.rotGeneric, "generic");
+  this->checkRotate(typename TestFixture::Rotation(rot::RotationVector<typename TestFixture::Scalar>(1.0e-5, -2.0e-5, 1.0e-5)), "small angle");
+}
+
+TYPED_TEST(RotateTest, testInverseRotate) {
+  this->checkInverseRotate(this->rotTest.rotIdentity, "identity");
+  this->checkInverseRotate(this->rotTest.rotQuarterX, "quarter x");
+  this->checkInverseRotate(this->rotTest.rotQuarterY, "quarter y");
+  this->checkInverseRotate(this->rotTest.rotQuarterZ, "quarter z");
+  this->checkInverseRotate(this->rotTest.rotGeneric, "generic");
+  this->checkInverseRotate(typename TestFixture::Rotation(rot::RotationVector<typename TestFixture::Scalar>(1.0e-5, -2.0e-5, 1.0e-5)), "small angle");
+}
+
+TYPED_TEST(RotateTest, testMultiplication) {
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  const Rotation rotA = this->rotTest.rotGeneric;
+  const Rotation rotB = this->rotTest.rotQuarterX*this->rotTest.rotQuarterY.inverted();
+  const Matrix3 expected = rot::RotationMatrix<Scalar>(rotA).matrix()*rot::RotationMatrix<Scalar>(rotB).matrix();
+
+  // Same parameterization
+  const Matrix3 product = rot::RotationMatrix<Scalar>(rotA*rotB).matrix();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, product, this->tol, this->tol, "same parameterization");
+
+  // Left-hand side is a rotation matrix
+  const Matrix3 productMatrixLeft = (rot::RotationMatrix<Scalar>(rotA)*rotB).matrix();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, productMatrixLeft, this->tol, this->tol, "rotation matrix on the left");
+
+  // Right-hand side is a rotation quaternion
+  const Matrix3 productQuaternionRight = rot::RotationMatrix<Scalar>(rotA*rot::RotationQuaternion<Scalar>(rotB)).matrix();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, productQuaternionRight, this->tol, this->tol, "rotation quaternion on the right");
+}
+
+TYPED_TEST(RotateTest, testMaps) {
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  const Vector3 axis = Vector3(0.3, -0.8, 0.5).normalized();
+  // identity, small angles (series expansions), angles below and above pi/2 and angles above pi (unique rotation vector)
+  const Scalar angles[] = {Scalar(0.0), Scalar(1.0e-7), Scalar(1.0e-3), Scalar(0.7), Scalar(2.0), Scalar(3.0), Scalar(4.0)};
+  Rotation rotation;
+  for (const Scalar angle : angles) {
+    const rot::RotationVector<Scalar> rotationVector(angle*axis);
+    const Matrix3 expectedMatrix = rot::RotationMatrix<Scalar>(rotationVector).matrix();
+    const Matrix3 matrix = rot::RotationMatrix<Scalar>(rotation.exponentialMap(rotationVector.vector())).matrix();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedMatrix, matrix, this->tol, this->tol, "exponential map");
+
+    const Vector3 expectedVector = rotationVector.getUnique().vector();
+    const Vector3 vector = Rotation(rotationVector).logarithmicMap();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedVector, vector, this->tol, this->tol, "logarithmic map");
+  }
+}
+
+template <typename RotationPair_>
+struct ComparisonTest : public ::testing::Test {
+  typedef typename RotationPair_::first_type RotationA;
+  typedef typename RotationPair_::second_type RotationB;
+  typedef typename RotationA::Scalar Scalar;
+  const double tol = std::is_same<Scalar, float>::value ? 1.0e-3 : 1.0e-8;
+
+  //! Disparity angle of the concatenation as defined in RotationBase::getDisparityAngle()
+  Scalar getExpectedDisparityAngle(const RotationA& rotA, const RotationB& rotB) const {
+    const rot::RotationQuaternion<Scalar> quatA(rotA);
+    const rot::RotationQuaternion<Scalar> quatB(rotB);
+    return std::abs(rot::wrapPosNegPI(rot::AngleAxis<Scalar>(quatA*quatB.inverted()).angle()));
+  }
+};
+
+typedef ::testing::Types<
+    std::pair<rot::RotationQuaternionD, rot::RotationMatrixD>,
+    std::pair<rot::RotationMatrixD, rot::RotationQuaternionD>,
+    std::pair<rot::RotationMatrixD, rot::EulerAnglesZyxD>,
+    std::pair<rot::EulerAnglesZyxD, rot::RotationQuaternionD>,
+    std::pair<rot::AngleAxisD, rot::RotationVectorD>,
+    std::pair<rot::EulerAnglesXyzD, rot::EulerAnglesXyzD>,
+    std::pair<rot::RotationVectorF, rot::RotationQuaternionF>,
+    std::pair<rot::RotationMatrixF, rot::AngleAxisF>
+> TypeComparisonPairs;
+
+TYPED_TEST_CASE(ComparisonTest, TypeComparisonPairs);
+
+TYPED_TEST(ComparisonTest, testDisparityAngle) {
+  typedef typename TestFixture::RotationA RotationA;
+  typedef typename TestFixture::RotationB RotationB;
+  typedef typename TestFixture::Scalar Scalar;
+  const RotationA rotA(rot::EulerAnglesZyx<Scalar>(0.4, -0.2, 1.1));
+  // small angles, angles close to pi and the double cover of the quaternions
+  const Scalar angles[] = {Scalar(0.0), Scalar(1.0e-3), Scalar(0.5), Scalar(2.0), Scalar(3.1), Scalar(3.5)};
+  for (const Scalar angle : angles) {
+    const RotationB rotB(rot::RotationQuaternion<Scalar>(rot::AngleAxis<Scalar>(angle, Scalar(0.6), Scalar(0.0), Scalar(0.8)))*rot::RotationQuaternion<Scalar>(rotA));
+    const Scalar expected = this->getExpectedDisparityAngle(rotA, rotB);
+    EXPECT_NEAR(expected, rotA.getDisparityAngle(rotB), this->tol) << "angle " << angle;
+    EXPECT_NEAR(expected, rotB.getDisparityAngle(rotA), this->tol) << "angle " << angle;
+    EXPECT_TRUE(rotA.isNear(rotB, expected + Scalar(this->tol))) << "angle " << angle;
+    EXPECT_TRUE(rotB.isNear(rotA, expected + Scalar(this->tol))) << "angle " << angle;
+    if (expected > Scalar(this->tol)) {
+      EXPECT_FALSE(rotA.isNear(rotB, expected - Scalar(this->tol))) << "angle " << angle;
+    }
+  }
+}
+
+TYPED_TEST(ComparisonTest, testEqual) {
+  typedef typename TestFixture::RotationA RotationA;
+  typedef typename TestFixture::RotationB RotationB;
+  typedef typename TestFixture::Scalar Scalar;
+  const RotationA rotA(rot::EulerAnglesZyx<Scalar>(0.4, -0.2, 1.1));
+  EXPECT_TRUE(rotA == rotA);
+  EXPECT_FALSE(rotA == RotationA(rot::EulerAnglesZyx<Scalar>(0.4, -0.2, 1.2)));
+  EXPECT_FALSE(rotA == RotationB(rot::EulerAnglesZyx<Scalar>(0.4, -0.2, 1.2)));
+}
+
+TEST(ComparisonTest, testEqualMatrixQuaternion) {
+  // the quaternion is converted to a rotation matrix for the comparison, as for the construction of the matrix
+  const rot::RotationQuaternionD quat(rot::EulerAnglesZyxD(0.4, -0.2, 1.1));
+  const rot::RotationMatrixD matrix(quat);
+  EXPECT_TRUE(matrix == quat);
+  EXPECT_TRUE(quat == matrix);
+  EXPECT_TRUE(matrix == rot::RotationQuaternionD(-quat.w(), -quat.x(), -quat.y(), -quat.z()));
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename Scalar_>
+class TrigonometricConversionTest : public ::testing::Test {
+ public:
+  typedef Scalar_ Scalar;
+  typedef rot::EulerAnglesZyx<Scalar> EulerAnglesZyx;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef rot::RotationMatrix<Scalar> RotationMatrix;
+  typedef rot::AngleAxis<Scalar> AngleAxis;
+  typedef rot::RotationVector<Scalar> RotationVector;
+
+  // bounds documented in FastTrigonometry
+  const double trigonometryTol = std::is_same<Scalar, float>::value ? 2e-7 : 3e-9;
+  const double atan2Tol = std::is_same<Scalar, float>::value ? 3e-7 : 1e-8;
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(2e-6) : Scalar(1e-7);
+
+  /*! \brief Gets the tolerance of the error of a round trip to Euler angles beyond the error of the constructors.
+   *  The sine, cosine and atan2 add their documented errors, and the rounding errors of the matrix elements are
+   *  amplified by 1/cos(pitch) close to the gimbal lock.
+   */
+  Scalar getRoundTripTol(const EulerAnglesZyx& zyx) const {
+    using std::abs;
+    using std::cos;
+    const Scalar cosPitch = std::max(abs(cos(zyx.pitch())), rot::internal::TrigonometricConversionConstants<Scalar>::GimbalLockThreshold);
+    return Scalar(2.0*(trigonometryTol + atan2Tol)) + Scalar(4)*std::numeric_limits<Scalar>::epsilon()/cosPitch;
+  }
+
+  std::vector<EulerAnglesZyx> rotations;
+
+  TrigonometricConversionTest() {
+    const Scalar halfPi = Scalar(0.5*M_PI);
+    rotations.push_back(EulerAnglesZyx());
+    rotations.push_back(EulerAnglesZyx(Scalar(0.3), Scalar(-0.2), Scalar(0.5)));
+    rotations.push_back(EulerAnglesZyx(Scalar(-2.9), Scalar(1.1), Scalar(3.0)));
+    rotations.push_back(EulerAnglesZyx(Scalar(1e-5), Scalar(-2e-5), Scalar(3e-5)));
+    rotations.push_back(EulerAnglesZyx(Scalar(0.7), halfPi, Scalar(0.0)));
+    rotations.push_back(EulerAnglesZyx(Scalar(-0.4), -halfPi, Scalar(0.0)));
+    for (int i = 0; i < 50; ++i) {
+      rotations.push_back(EulerAnglesZyx().setRandom());
+    }
+  }
+};
+
+typedef ::testing::Types<double, float> Types;
+
+TYPED_TEST_CASE(TrigonometricConversionTest, Types);
+
+TYPED_TEST(TrigonometricConversionTest, testFastTrigonometry)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  for (int i = -100000; i <= 100000; ++i) {
+    const Scalar angle = Scalar(i*1e-4*M_PI);
+    Scalar sine, cosine;
+    rot::FastTrigonometry::sincos(angle, sine, cosine);
+    ASSERT_NEAR(std::sin(double(angle)), double(sine), this->trigonometryTol) << "angle " << angle;
+    ASSERT_NEAR(std::cos(double(angle)), double(cosine), this->trigonometryTol) << "angle " << angle;
+    ASSERT_EQ(sine, rot::FastTrigonometry::sin(angle));
+    ASSERT_EQ(cosine, rot::FastTrigonometry::cos(angle));
+  }
+  for (const double angle : {1e4, -1e4, 5e3 + 0.1}) {
+    ASSERT_NEAR(std::sin(double(Scalar(angle))), double(rot::FastTrigonometry::sin(Scalar(angle))), this->trigonometryTol);
+  }
+
+  for (int i = 0; i <= 100000; ++i) {
+    const double angle = -M_PI + i*2e-5*M_PI;
+    for (const double radius : {1e-3, 1.0, 1e3}) {
+      const Scalar y = Scalar(radius*std::sin(angle)), x = Scalar(radius*std::cos(angle));
+      ASSERT_NEAR(std::atan2(double(y), double(x)), double(rot::FastTrigonometry::atan2(y, x)), this->atan2Tol) << "y " << y << " x " << x;
+    }
+  }
+  ASSERT_EQ(Scalar(0), rot::FastTrigonometry::atan2(Scalar(0), Scalar(0)));
+  ASSERT_NEAR(M_PI, double(rot::FastTrigonometry::atan2(Scalar(0), Scalar(-1))), this->atan2Tol);
+  ASSERT_NEAR(-M_PI, double(rot::FastTrigonometry::atan2(-Scalar(0), Scalar(-1))), this->atan2Tol);
+}
+
+TYPED_TEST(TrigonometricConversionTest, testStandardConversion)
+{
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+  for (const auto& zyx : this->rotations) {
+    // the default policy is the conversion of the constructors
+    ASSERT_EQ(RotationQuaternion(zyx).toImplementation().coeffs(), rot::convertRotation<RotationQuaternion>(zyx).toImplementation().coeffs());
+    ASSERT_EQ(RotationMatrix(zyx).toImplementation(), rot::convertRotation<RotationMatrix>(zyx).toImplementation());
+  }
+}
+
+TYPED_TEST(TrigonometricConversionTest, testFastConversion)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::EulerAnglesZyx EulerAnglesZyx;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+  typedef typename TestFixture::AngleAxis AngleAxis;
+  typedef typename TestFixture::RotationVector RotationVector;
+  typedef rot::FastTrigonometry Fast;
+  const Scalar tol = this->tol;
+
+  for (const auto& zyx : this->rotations) {
+    const RotationQuaternion quaternion(zyx);
+    const RotationMatrix matrix(zyx);
+    const AngleAxis angleAxis(zyx);
+    const RotationVector rotationVector(zyx);
+
+    // from Euler angles
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(quaternion.toImplementation().coeffs(), (rot::convertRotation<RotationQuaternion, Fast>(zyx).toImplementation().coeffs()), tol, tol, "quaternion");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(matrix.toImplementation(), (rot::convertRotation<RotationMatrix, Fast>(zyx).toImplementation()), tol, tol, "matrix");
+    ASSERT_TRUE((rot::convertRotation<AngleAxis, Fast>(zyx).isNear(angleAxis, tol)));
+    ASSERT_TRUE((rot::convertRotation<RotationVector, Fast>(zyx).isNear(rotationVector, tol)));
+
+    // to Euler angles, the angles are compared since they are unique with the gimbal lock convention
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(EulerAnglesZyx(quaternion).toImplementation(), (rot::convertRotation<EulerAnglesZyx, Fast>(quaternion).toImplementation()), tol, tol, "from quaternion");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(EulerAnglesZyx(matrix).toImplementation(), (rot::convertRotation<EulerAnglesZyx, Fast>(matrix).toImplementation()), tol, tol, "from matrix");
+    const Scalar roundTripTol = this->getRoundTripTol(zyx);
+    ASSERT_LE((rot::convertRotation<EulerAnglesZyx, Fast>(angleAxis).getDisparityAngle(zyx)), EulerAnglesZyx(angleAxis).getDisparityAngle(zyx) + roundTripTol);
+    ASSERT_LE((rot::convertRotation<EulerAnglesZyx, Fast>(rotationVector).getDisparityAngle(zyx)), EulerAnglesZyx(rotationVector).getDisparityAngle(zyx) + roundTripTol);
+
+    // angle-axis and rotation vectors
+    const AngleAxis fastAngleAxis = rot::convertRotation<AngleAxis, Fast>(quaternion);
+    ASSERT_NEAR(angleAxis.angle(), fastAngleAxis.angle(), tol);
+    ASSERT_TRUE(fastAngleAxis.isNear(angleAxis, tol));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(RotationVector(quaternion).toImplementation(), (rot::convertRotation<RotationVector, Fast>(quaternion).toImplementation()), tol, tol, "rotation vector");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(RotationQuaternion(rotationVector).toImplementation().coeffs(), (rot::convertRotation<RotationQuaternion, Fast>(rotationVector).toImplementation().coeffs()), tol, tol, "from rotation vector");
+    ASSERT_TRUE((rot::convertRotation<RotationQuaternion, Fast>(angleAxis).isNear(quaternion, tol)));
+    ASSERT_TRUE((rot::convertRotation<RotationMatrix, Fast>(angleAxis).isNear(matrix, tol)));
+    ASSERT_TRUE((rot::convertRotation<RotationMatrix, Fast>(rotationVector).isNear(matrix, tol)));
+
+    // pairs without trigonometric functions are converted with the ConversionTraits
+    ASSERT_EQ(RotationQuaternion(matrix).toImplementation().coeffs(), (rot::convertRotation<RotationQuaternion, Fast>(matrix).toImplementation().coeffs()));
+  }
+
+  // identity
+  const AngleAxis identity = rot::convertRotation<AngleAxis, Fast>(RotationQuaternion());
+  ASSERT_EQ(Scalar(0), identity.angle());
+  ASSERT_EQ(Scalar(1), identity.axis().norm());
+  ASSERT_TRUE((rot::convertRotation<RotationVector, Fast>(RotationQuaternion()).toImplementation().isZero()));
+}
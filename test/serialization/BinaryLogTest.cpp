@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/serialization/BinaryLog.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace {
+
+std::string writeLog() {
+  std::ostringstream stream(std::ios::binary);
+  kindr::BinaryLogWriter writer(stream);
+  const kindr::HomTransformQuatD pose(kindr::Position3D(1.0, 2.0, 3.0), kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.3, -0.4, 1.2)));
+  writer.write(3, 0.001, pose);
+  writer.write(4, 0.001, pose, kindr::binary_log::QuaternionEncoding::SmallestThree64);
+  writer.write(5, 0.002, kindr::TwistLinearVelocityLocalAngularVelocityD(Eigen::Vector3d(0.1, 0.2, 0.3), Eigen::Vector3d(-0.1, -0.2, -0.3)));
+  writer.write(6, 0.003, kindr::WrenchD(Eigen::Vector3d(1.0, 2.0, 3.0), Eigen::Vector3d(4.0, 5.0, 6.0)));
+  return stream.str();
+}
+
+std::string writeTrajectory() {
+  std::ostringstream stream(std::ios::binary);
+  kindr::BinaryLogWriter writer(stream);
+  for (int i = 0; i < 100; ++i) {
+    const double time = 0.01*i;
+    writer.write(1, time, kindr::HomTransformQuatD(kindr::Position3D(time, 0.0, 0.0), kindr::RotationQuaternionD(kindr::AngleAxisD(time, 0.0, 0.0, 1.0))));
+    if (i % 2 == 0) {
+      writer.write(2, time, kindr::WrenchD(Eigen::Vector3d(time, 0.0, 0.0), Eigen::Vector3d::Zero()));
+    }
+  }
+  return stream.str();
+}
+
+} // namespace
+
+TEST(BinaryLogTest, testRoundTrip)
+{
+  const std::string log = writeLog();
+  ASSERT_EQ(log.size(), 16u + (16u + 56u) + (16u + 32u) + (16u + 48u) + (16u + 48u));
+
+  const kindr::RotationQuaternionD rotation(kindr::EulerAnglesZyxD(0.3, -0.4, 1.2));
+  kindr::BinaryLogReader reader(log.data(), log.size());
+  kindr::BinaryLogRecord record;
+
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_TRUE(record.getType() == kindr::binary_log::RecordType::Pose);
+  ASSERT_EQ(record.getChannel(), 3);
+  ASSERT_EQ(record.getTimestamp(), 0.001);
+  ASSERT_EQ(record.getPosition().eval(), kindr::Position3D(1.0, 2.0, 3.0));
+  ASSERT_TRUE(record.getRotationMap().eval() == rotation);
+  // the views point into the log
+  ASSERT_EQ(reinterpret_cast<const char*>(record.getPosition().data()), log.data() + 32);
+
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_EQ(record.getChannel(), 4);
+  ASSERT_LT(record.getRotation().getDisparityAngle(rotation), 1.0e-5);
+  ASSERT_TRUE(record.getPose().getPosition() == kindr::Position3D(1.0, 2.0, 3.0));
+  ASSERT_THROW(record.getRotationMap(), std::runtime_error);
+
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_TRUE(record.getType() == kindr::binary_log::RecordType::Twist);
+  ASSERT_EQ(record.getLinearVelocity().eval(), kindr::Velocity3D(0.1, 0.2, 0.3));
+  KINDR_ASSERT_DOUBLE_MX_EQ(record.getTwist().getVector(), (Eigen::Matrix<double, 6, 1>() << 0.1, 0.2, 0.3, -0.1, -0.2, -0.3).finished(), 1e-12, "twist");
+  ASSERT_THROW(record.getForce(), std::runtime_error);
+
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_TRUE(record.getType() == kindr::binary_log::RecordType::Wrench);
+  ASSERT_EQ(record.getTorque().eval(), kindr::Torque3D(4.0, 5.0, 6.0));
+  KINDR_ASSERT_DOUBLE_MX_EQ(record.getWrench().getVector(), (Eigen::Matrix<double, 6, 1>() << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0).finished(), 1e-12, "wrench");
+
+  ASSERT_FALSE(reader.read(record));
+  reader.reset();
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_EQ(record.getChannel(), 3);
+}
+
+TEST(BinaryLogTest, testTruncatedAndInvalid)
+{
+  const std::string log = writeLog();
+  kindr::BinaryLogReader reader(log.data(), 16 + 16 + 56 + 20);
+  kindr::BinaryLogRecord record;
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_FALSE(reader.read(record));
+
+  std::string invalid = log;
+  invalid[0] = 'X';
+  ASSERT_THROW(kindr::BinaryLogReader(invalid.data(), invalid.size()), std::runtime_error);
+
+  // versions 0 and newer than the reader
+  for (const std::uint16_t version : {std::uint16_t(0), std::uint16_t(kindr::binary_log::Version + 1)}) {
+    invalid = log;
+    std::memcpy(&invalid[4], &version, sizeof(version));
+    ASSERT_THROW(kindr::BinaryLogReader(invalid.data(), invalid.size()), std::runtime_error);
+  }
+}
+
+TEST(BinaryLogTest, testUnaligned)
+{
+  // a log at an odd address is copied from, but cannot be viewed in place
+  const std::string log = writeLog();
+  std::vector<char> buffer(log.size() + 1);
+  std::memcpy(buffer.data() + 1, log.data(), log.size());
+  kindr::BinaryLogReader reader(buffer.data() + 1, log.size());
+  kindr::BinaryLogRecord record;
+
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_EQ(record.getChannel(), 3);
+  ASSERT_EQ(record.getTimestamp(), 0.001);
+  ASSERT_TRUE(record.getPose().getPosition() == kindr::Position3D(1.0, 2.0, 3.0));
+  ASSERT_TRUE(record.getRotation() == kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.3, -0.4, 1.2)));
+  ASSERT_THROW(record.getPosition(), std::runtime_error);
+  ASSERT_THROW(record.getRotationMap(), std::runtime_error);
+
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_LT(record.getRotation().getDisparityAngle(kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.3, -0.4, 1.2))), 1.0e-5);
+
+  ASSERT_TRUE(reader.read(record));
+  KINDR_ASSERT_DOUBLE_MX_EQ(record.getTwist().getVector(), (Eigen::Matrix<double, 6, 1>() << 0.1, 0.2, 0.3, -0.1, -0.2, -0.3).finished(), 1e-12, "twist");
+  ASSERT_THROW(record.getLinearVelocity(), std::runtime_error);
+
+  ASSERT_TRUE(reader.read(record));
+  KINDR_ASSERT_DOUBLE_MX_EQ(record.getWrench().getVector(), (Eigen::Matrix<double, 6, 1>() << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0).finished(), 1e-12, "wrench");
+  ASSERT_FALSE(reader.read(record));
+}
+
+TEST(BinaryLogTest, testCorruptedRecords)
+{
+  const std::string log = writeLog();
+  const std::size_t secondRecord = 16 + 16 + 56;
+  kindr::BinaryLogRecord record;
+
+  // payload size which does not match the type
+  std::string corrupted = log;
+  const std::uint32_t payloadSize = 48;
+  std::memcpy(&corrupted[secondRecord + 4], &payloadSize, sizeof(payloadSize));
+  kindr::BinaryLogReader reader(corrupted.data(), corrupted.size());
+  ASSERT_TRUE(reader.read(record));
+  ASSERT_THROW(reader.read(record), std::runtime_error);
+  // the reader is not advanced
+  ASSERT_THROW(reader.read(record), std::runtime_error);
+
+  // payload size which exceeds the log
+  corrupted = log;
+  const std::uint32_t hugePayloadSize = 0xFFFFFFF0u;
+  std::memcpy(&corrupted[secondRecord + 4], &hugePayloadSize, sizeof(hugePayloadSize));
+  kindr::BinaryLogReader hugeReader(corrupted.data(), corrupted.size());
+  ASSERT_TRUE(hugeReader.read(record));
+  ASSERT_THROW(hugeReader.read(record), std::runtime_error);
+
+  // unknown type and quaternion encoding
+  for (const std::size_t byte : {secondRecord, secondRecord + 1}) {
+    corrupted = log;
+    corrupted[byte] = 7;
+    kindr::BinaryLogReader unknownReader(corrupted.data(), corrupted.size());
+    ASSERT_TRUE(unknownReader.read(record));
+    ASSERT_THROW(unknownReader.read(record), std::runtime_error);
+  }
+
+  // the index is built with the reader
+  corrupted = log;
+  corrupted[secondRecord] = 0;
+  ASSERT_THROW(kindr::BinaryLogIndex(corrupted.data(), corrupted.size()), std::runtime_error);
+}
+
+TEST(BinaryLogTest, testSmallestThree)
+{
+  for (int i = 0; i < 100; ++i) {
+    kindr::RotationQuaternionD rotation;
+    rotation.setRandom();
+    const Eigen::Vector4d xyzw(rotation.x(), rotation.y(), rotation.z(), rotation.w());
+    const Eigen::Vector4d unpacked = kindr::binary_log::unpackSmallestThree(kindr::binary_log::packSmallestThree(xyzw));
+    ASSERT_LT(kindr::RotationQuaternionD(unpacked(3), unpacked(0), unpacked(1), unpacked(2)).getDisparityAngle(rotation), 1.0e-5);
+  }
+}
+
+TEST(BinaryLogTest, testIndex)
+{
+  const std::string log = writeTrajectory();
+  const kindr::BinaryLogIndex index(log.data(), log.size());
+  ASSERT_EQ(index.getChannels(), std::vector<std::uint16_t>({1, 2}));
+  ASSERT_FALSE(index.hasChannel(3));
+  ASSERT_THROW(index.getChannel(3), std::runtime_error);
+
+  const kindr::BinaryLogChannel& poses = index.getChannel(1);
+  const kindr::BinaryLogChannel& wrenches = index.getChannel(2);
+  ASSERT_EQ(poses.size(), 100);
+  ASSERT_EQ(wrenches.size(), 50);
+  ASSERT_EQ(poses[42].getTimestamp(), 0.42);
+  ASSERT_EQ(poses[42].getPosition().eval().x(), 0.42);
+  ASSERT_EQ(wrenches[21].getForce().eval().x(), 0.42);
+
+  // lookup by time
+  ASSERT_EQ(poses.findIndex(0.42), 42);
+  ASSERT_EQ(poses.findIndex(0.415), 42);
+  ASSERT_EQ(poses.findIndex(-1.0), 0);
+  ASSERT_EQ(poses.findIndex(2.0), 100);
+  ASSERT_EQ(wrenches.findLatestIndex(0.43), 21);
+  ASSERT_EQ(wrenches.findLatestIndex(-1.0), -1);
+
+  // windows
+  const kindr::BinaryLogWindow window = poses.getWindow(0.1, 0.2);
+  ASSERT_EQ(window.size(), 10);
+  ASSERT_EQ(window.getBeginIndex(), 10);
+  ASSERT_EQ(window.getTimestamp(0), 0.1);
+  ASSERT_EQ(window[9].getTimestamp(), poses.getTimestamp(19));
+  window.prefetch();
+  ASSERT_TRUE(poses.getWindow(0.2, 0.1).empty());
+  ASSERT_TRUE(poses.getWindow(5.0, 6.0).empty());
+  ASSERT_THROW(kindr::BinaryLogWindow(poses, 90, 101), std::runtime_error);
+}
+
+TEST(BinaryLogTest, testIndexDecreasingTimestamps)
+{
+  std::ostringstream stream(std::ios::binary);
+  kindr::BinaryLogWriter writer(stream);
+  writer.write(1, 0.2, kindr::WrenchD());
+  writer.write(2, 0.1, kindr::WrenchD());
+  writer.write(1, 0.1, kindr::WrenchD());
+  const std::string log = stream.str();
+  ASSERT_THROW(kindr::BinaryLogIndex(log.data(), log.size()), std::runtime_error);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(BinaryLogTest, testMappedFile)
+{
+  const std::string fileName = "kindr_binary_log_test.bin";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    const std::string log = writeLog();
+    file.write(log.data(), log.size());
+  }
+  {
+    kindr::BinaryLogFile file(fileName);
+    kindr::BinaryLogReader reader = file.getReader();
+    kindr::BinaryLogRecord record;
+    int numberOfRecords = 0;
+    while (reader.read(record)) {
+      ++numberOfRecords;
+    }
+    ASSERT_EQ(numberOfRecords, 4);
+
+    file.advise(kindr::BinaryLogFile::AccessPattern::Random);
+    const kindr::BinaryLogIndex index = file.getIndex();
+    ASSERT_EQ(index.getChannels().size(), 4u);
+    ASSERT_EQ(index.getChannel(6).getWindow(0.0, 1.0)[0].getTorque().eval(), kindr::Torque3D(4.0, 5.0, 6.0));
+  }
+  std::remove(fileName.c_str());
+}
+#endif
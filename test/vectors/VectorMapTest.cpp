@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/vectors/VectorMap.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+TEST(VectorMapTest, testReadWrite)
+{
+  // a log record [t px py pz vx vy vz]
+  double record[7] = {0.1, 1.0, 2.0, 3.0, -1.0, -2.0, -3.0};
+  kindr::Position3DMap position(record + 1);
+  const kindr::VectorMap<const kindr::Velocity3D> velocity(record + 4);
+
+  ASSERT_EQ(position.eval(), kindr::Position3D(1.0, 2.0, 3.0));
+  ASSERT_EQ(velocity.eval(), kindr::Velocity3D(-1.0, -2.0, -3.0));
+  ASSERT_NEAR(position.norm(), std::sqrt(14.0), 1e-12);
+
+  position += kindr::Position3D(velocity.eval().toImplementation()*record[0]);
+  ASSERT_NEAR(record[1], 0.9, 1e-12);
+  ASSERT_NEAR(record[3], 2.7, 1e-12);
+
+  position = kindr::Position3D(4.0, 5.0, 6.0);
+  ASSERT_EQ(record[2], 5.0);
+  position *= 2.0;
+  ASSERT_EQ(position(2), 12.0);
+  position(0) = 0.5;
+  ASSERT_EQ(record[1], 0.5);
+  ASSERT_EQ(record[0], 0.1);
+  ASSERT_EQ(record[4], -1.0);
+
+  const kindr::Position3D sum = position + kindr::Position3D(1.0, 1.0, 1.0);
+  ASSERT_EQ(sum, kindr::Position3D(1.5, 11.0, 13.0));
+}
+
+TEST(VectorMapTest, testStrideAndLazy)
+{
+  // structure of arrays with two positions: [x0 x1 y0 y1 z0 z1]
+  float soa[6] = {1.0f, 4.0f, 2.0f, 5.0f, 3.0f, 6.0f};
+  const kindr::PositionMap<float, 3, Eigen::InnerStride<2>> position0(soa, Eigen::InnerStride<2>());
+  const kindr::PositionMap<float, 3, Eigen::InnerStride<2>> position1(soa + 1, Eigen::InnerStride<2>());
+  ASSERT_EQ(position1.eval(), kindr::Position3F(4.0f, 5.0f, 6.0f));
+
+  const kindr::Position3F difference = position1.lazy() - position0.lazy()*2.0f;
+  ASSERT_EQ(difference, kindr::Position3F(2.0f, 1.0f, 0.0f));
+}
+
+TEST(VectorMapTest, testLocalAngularVelocity)
+{
+  double buffer[3] = {0.1, 0.2, 0.3};
+  kindr::LocalAngularVelocityMap<double> angularVelocity(buffer);
+  ASSERT_TRUE(angularVelocity.eval() == kindr::LocalAngularVelocityD(0.1, 0.2, 0.3));
+  angularVelocity = kindr::LocalAngularVelocityD(1.0, 2.0, 3.0);
+  ASSERT_EQ(buffer[2], 3.0);
+}
@@ -33,6 +33,7 @@
 #include <gtest/gtest.h>
 
 #include "kindr/vectors/Vector.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
 #include "kindr/rotations/Rotation.hpp"
 #include "kindr/common/gtest_eigen.hpp"
 
@@ -416,3 +417,124 @@ TYPED_TEST(VectorTest, projectOn)
   ASSERT_NEAR(this->vec3ProjectedOnVec1(3),result(3), 1e-6);
   ASSERT_NEAR(this->vec3ProjectedOnVec1(4),result(4), 1e-6);
 }
+
+TEST(VectorExpressionTest, lazyArithmetic)
+{
+  typedef kindr::Position3D Position;
+  typedef kindr::Velocity3D Velocity;
+  typedef kindr::Time3D Time;
+  const Position a(1.0, 2.0, 3.0);
+  const Position b(4.0, 5.0, 6.0);
+  const Position c(0.5, 0.5, 0.5);
+
+  const Position expected = a + b*2.0 - c;
+  Position result = a.lazy() + b.lazy()*2.0 - c.lazy();
+  ASSERT_TRUE(result.isSimilarTo(expected, 1e-12));
+
+  result = -(2.0*a.lazy() - b)/2.0;
+  ASSERT_TRUE(result.isSimilarTo(Position(1.0, 0.5, 0.0), 1e-12));
+  ASSERT_NEAR((a.lazy() - b.lazy()).norm(), (a - b).norm(), 1e-12);
+  ASSERT_NEAR((a.lazy() + b.lazy()).sum(), 21.0, 1e-12);
+
+  // the result type of elementwise operations follows the physical types
+  const Velocity velocity(1.0, 2.0, 4.0);
+  const Time time(2.0, 2.0, 2.0);
+  const Position distance = velocity.lazy().elementwiseMultiplication(time.lazy());
+  ASSERT_TRUE(distance.isSimilarTo(Position(2.0, 4.0, 8.0), 1e-12));
+  const Velocity velocity2 = distance.lazy().elementwiseDivision(time.lazy()).eval();
+  ASSERT_TRUE(velocity2.isSimilarTo(velocity, 1e-12));
+}
+
+TEST(VectorPhysicalTypeTest, exponentAlgebra)
+{
+  typedef kindr::Force3D Force;
+  typedef kindr::Velocity3D Velocity;
+  typedef kindr::Position3D Position;
+  typedef kindr::Time3D Time;
+  typedef kindr::Vector<kindr::PhysicalType::Energy, double, 3> Energy;
+  typedef kindr::Vector<kindr::PhysicalType::Power, double, 3> Power;
+  typedef kindr::Jerk3D Jerk;
+  typedef kindr::Acceleration3D Acceleration;
+  typedef kindr::Torque3D Torque;
+  typedef kindr::AngularVelocity3D AngularVelocity;
+
+  // products and quotients without specialized traits follow from the exponents of the base dimensions
+  static_assert(std::is_same<kindr::internal::MultiplicationReturnTypeTrait<Force, Velocity>::ReturnType, Power>::value, "Force*Velocity must be Power");
+  static_assert(std::is_same<kindr::internal::DivisionReturnTypeTrait<Energy, Time>::ReturnType, Power>::value, "Energy/Time must be Power");
+  static_assert(std::is_same<kindr::internal::DivisionReturnTypeTrait<Energy, Position>::ReturnType, Force>::value, "Energy/Position must be Force");
+  static_assert(std::is_same<kindr::internal::DivisionReturnTypeTrait<Acceleration, Time>::ReturnType, Jerk>::value, "Acceleration/Time must be Jerk");
+  static_assert(std::is_same<kindr::internal::MultiplicationReturnTypeTrait<Torque, AngularVelocity>::ReturnType, Power>::value, "Torque*AngularVelocity must be Power");
+  static_assert(std::is_same<kindr::internal::MultiplicationReturnTypeTrait<Position, Position>::ReturnType, kindr::Vector<kindr::PhysicalType::Typeless, double, 3>>::value, "Position*Position has no physical type");
+  static_assert(std::is_same<kindr::internal::DivisionReturnTypeTrait<Position, Position>::ReturnType, kindr::Vector<kindr::PhysicalType::Typeless, double, 3>>::value, "Position/Position must be Typeless");
+
+  // the specialized traits drop angles and take precedence
+  static_assert(std::is_same<kindr::internal::MultiplicationReturnTypeTrait<Position, Force>::ReturnType, Torque>::value, "Position*Force must be Torque");
+  static_assert(std::is_same<kindr::internal::MultiplicationReturnTypeTrait<Position, AngularVelocity>::ReturnType, Velocity>::value, "Position*AngularVelocity must be Velocity");
+
+  // typed vectors have no overhead in size
+  static_assert(sizeof(Velocity) == sizeof(Eigen::Vector3d), "Typed vectors must have the size of the Eigen vector");
+
+  const Force force(1.0, 2.0, 3.0);
+  const Velocity velocity(2.0, -1.0, 0.5);
+  const Power power = force.elementwiseMultiplication(velocity);
+  ASSERT_TRUE(power.isSimilarTo(Power(2.0, -2.0, 1.5), 1e-12));
+  const Force force2 = Energy(2.0, 4.0, 6.0).elementwiseDivision(Position(2.0, 2.0, 2.0));
+  ASSERT_TRUE(force2.isSimilarTo(force, 1e-12));
+
+  // vectors are constructed directly from Eigen expressions
+  const Eigen::Vector3d a(1.0, 2.0, 3.0);
+  const Position position(a + 2.0*a);
+  ASSERT_TRUE(position.isSimilarTo(Position(3.0, 6.0, 9.0), 1e-12));
+}
+
+TEST(VectorDynamicTest, inPlaceArithmetic)
+{
+  typedef kindr::Vector<kindr::PhysicalType::Position, double, Eigen::Dynamic> Position;
+  typedef kindr::Vector<kindr::PhysicalType::Velocity, double, Eigen::Dynamic> Velocity;
+  typedef kindr::Vector<kindr::PhysicalType::Time, double, Eigen::Dynamic> Time;
+  const int size = 18;
+  const double dt = 0.01;
+
+  Position position(size);
+  ASSERT_EQ(size, position.size());
+  ASSERT_EQ(0.0, position.norm());
+  Velocity velocity(size);
+  for (int i = 0; i < size; ++i) {
+    position(i) = i;
+    velocity(i) = 0.5*i - 2.0;
+  }
+  Position expected(size);
+  for (int i = 0; i < size; ++i) {
+    expected(i) = position(i) + dt*velocity(i);
+  }
+
+  // the coordinates are not reallocated by the in-place operations and the assignments without aliasing
+  const Position initial = position;
+  const double* data = position.toImplementation().data();
+  position.addInPlace(Position(velocity.toImplementation()*dt));
+  ASSERT_TRUE(position.isSimilarTo(expected, 1e-12));
+  position.addInPlace(initial, -1.0).scaleInPlace(2.0);
+  position.addInPlace(initial);
+  ASSERT_TRUE(position.isSimilarTo(Position(expected.toImplementation()*2.0 - initial.toImplementation()), 1e-12));
+
+  const Time time(Eigen::VectorXd::Constant(size, dt));
+  position.noalias() = initial.lazy() + velocity.lazy().elementwiseMultiplication(time.lazy());
+  ASSERT_TRUE(position.isSimilarTo(expected, 1e-12));
+  position.noalias() -= initial.lazy();
+  position.noalias() += initial.lazy();
+  ASSERT_TRUE(position.isSimilarTo(expected, 1e-12));
+  position.noalias() = initial;
+  ASSERT_TRUE(position.isSimilarTo(initial, 1e-12));
+  ASSERT_EQ(data, position.toImplementation().data());
+
+  position.resize(size);
+  ASSERT_EQ(data, position.toImplementation().data());
+  position.resize(2*size);
+  ASSERT_EQ(2*size, position.size());
+
+  // the arithmetic operators and elementwise operations keep the dynamic dimension
+  const Position sum = initial + initial*2.0 - initial;
+  ASSERT_TRUE(sum.isSimilarTo(initial*2.0, 1e-12));
+  const Position distance = velocity.elementwiseMultiplication(time);
+  ASSERT_TRUE((initial + distance).isSimilarTo(expected, 1e-12));
+}